@@ -165,6 +165,13 @@ CONF_Bool(compress_rowbatches, "true");
 // Compress ratio when shuffle row_batches in network, not in storage engine.
 // If ratio is less than this value, use uncompressed data instead.
 CONF_mDouble(rpc_compress_ratio_threshold, "1.1");
+// The network bandwidth per sender assumed when deciding whether encoding a column of the exchanged chunks is
+// worthwhile, see `transmission_encode_level`. A column is sent without encoding if it takes more time to encode
+// than the time saved on the network.
+CONF_mInt64(transmission_encode_bandwidth_mb, "1000");
+// The keys of a hash shuffle taking more than this ratio of the rows are reported as hot keys in the profile
+// of the exchange sender, along with the skew of the rows among the destinations. 0 disables the detection.
+CONF_mDouble(shuffle_hot_key_ratio, "0.01");
 // Serialize and deserialize each returned row batch.
 CONF_Bool(serialize_batch, "false");
 // Interval between profile reports; in seconds.
@@ -248,6 +255,13 @@ CONF_Int64(index_stream_cache_capacity, "10737418240");
 CONF_String(storage_page_cache_limit, "0");
 // whether to disable page cache feature in storage
 CONF_Bool(disable_storage_page_cache, "true");
+// Directory on a local disk used as the second tier of storage page cache, empty means disabled.
+// The pages evicted from memory are kept there and survive restarts.
+CONF_String(storage_page_disk_cache_path, "");
+// Max bytes of pages kept in storage_page_disk_cache_path.
+CONF_Int64(storage_page_disk_cache_capacity, "10737418240");
+// Max bytes of pages waiting to be written to the disk cache, more pages are dropped.
+CONF_mInt64(storage_page_disk_cache_write_buffer_bytes, "67108864");
 // whether to disable column pool
 CONF_Bool(disable_column_pool, "false");
 
@@ -275,6 +289,13 @@ CONF_mInt32(update_compaction_check_interval_seconds, "60");
 CONF_Int32(update_compaction_num_threads_per_disk, "1");
 CONF_Int32(update_compaction_per_tablet_min_interval_seconds, "120"); // 2min
 
+// Max memory usage of the in-memory L0 of a persistent index, L0 is flushed to an immutable index beyond it.
+CONF_mInt64(l0_max_mem_usage, "67108864");
+// Number of immutable indexes in a level of a persistent index to trigger merging them.
+CONF_mInt32(persistent_index_merge_threshold, "4");
+// False positive probability of the bloom filters of the shards of immutable indexes.
+CONF_mDouble(persistent_index_bloom_filter_fpp, "0.05");
+
 // if compaction of a tablet failed, this tablet should not be chosen to
 // compaction until this interval passes.
 CONF_mInt64(min_compaction_failure_interval_sec, "120"); // 2 min
@@ -328,6 +349,11 @@ CONF_mInt64(streaming_load_max_mb, "10240");
 // Therefore, it is necessary to limit the maximum number of
 // such data when using stream load to prevent excessive memory consumption.
 CONF_mInt64(streaming_load_max_batch_size_mb, "100");
+// The number of threads parsing the plain CSV file of a stream load, the file is split into blocks of
+// `streaming_load_parse_block_size` bytes at record boundaries, and the blocks are parsed at the same time.
+// 1 means parsing the file in one thread.
+CONF_mInt32(streaming_load_parse_parallelism, "4");
+CONF_mInt64(streaming_load_parse_block_size, "4194304");
 // The alive time of a TabletsChannel.
 // If the channel does not receive any data till this time,
 // the channel will be removed.
@@ -352,8 +378,21 @@ CONF_Int32(fragment_pool_queue_size, "2048");
 // CONF_Bool(cast, "true");
 
 // Spill to disk when query
+// Only the hash joins and the blocking aggregates with aggregate functions spill, the aggregates with only
+// group by columns (e.g. SELECT DISTINCT) keep their hash sets in memory.
 // Writable scratch directories, splitted by ";"
 CONF_String(query_scratch_dirs, "${STARROCKS_HOME}");
+// The number of partitions an operator splits its input into when spilling to disk.
+CONF_mInt32(spill_partition_num, "16");
+// An operator never spills if its hash table is smaller than this.
+CONF_mInt64(spill_operator_min_bytes, "67108864");
+// An operator always spills when its hash table grows larger than this.
+CONF_mInt64(spill_operator_max_bytes, "2147483648");
+// An operator spills when the memory usage of its query exceeds this ratio of the query mem limit.
+CONF_mDouble(spill_query_mem_limit_ratio, "0.8");
+// A spilled partition still too large to be restored into memory is repartitioned with another hash seed,
+// at most this many times, then the query fails for exceeding the memory limit.
+CONF_mInt32(spill_max_repartition_times, "3");
 
 // Control the number of disks on the machine.  If 0, this comes from the system settings.
 CONF_Int32(num_disks, "0");
@@ -439,6 +478,10 @@ CONF_Int32(memory_max_alignment, "16");
 
 // write buffer size before flush
 CONF_mInt64(write_buffer_size, "104857600");
+// Whether to index the keys of memtable of aggregate and unique keys tables by a hash table on insert,
+// so that a merge only sorts the distinct keys instead of all the buffered rows.
+// Each merge still sorts all the distinct keys and aggregates all the buffered rows again.
+CONF_mBool(enable_memtable_hash_aggregation, "false");
 
 // Following 2 configs limit the memory consumption of load process on a Backend.
 // eg: memory limit to 80% of mem limit config but up to 100GB(default)
@@ -523,6 +566,11 @@ CONF_mInt32(storage_flood_stage_usage_percent, "95"); // 95%
 CONF_mInt64(storage_flood_stage_left_capacity_bytes, "1073741824"); // 1GB
 // Number of thread for flushing memtable per store.
 CONF_Int32(flush_thread_num_per_store, "2");
+// Number of thread for loading the tablet and rowset metas per store at BE startup.
+CONF_Int32(load_tablet_thread_num_per_store, "8");
+// Whether to check the existence of the segment files of the loaded tablets in background after startup.
+// The tablets with missing files are reported as bad, so that FE will repair them by clone.
+CONF_Bool(verify_rowset_files_after_load, "true");
 
 // Config for tablet meta checkpoint.
 CONF_mInt32(tablet_meta_checkpoint_min_new_rowsets_num, "10");
@@ -570,6 +618,26 @@ CONF_Int32(late_materialization_ratio, "10");
 // `1000` will enable late materialization always select metric type.
 CONF_Int32(metric_late_materialization_ratio, "1000");
 
+// Whether to probe the join runtime filters in storage, including the ones arriving after the scan
+// has started, to prune the data pages by zone map and filter the rows before late materialization.
+CONF_mBool(enable_storage_runtime_filter, "true");
+
+// The number of chunks whose data pages are prefetched by coalesced reads when scanning a segment,
+// `0` will disable the prefetch.
+CONF_mInt32(column_page_prefetch_chunks, "4");
+// Adjacent pages separated by no more than this many bytes are read by one IO.
+CONF_mInt64(column_page_prefetch_max_gap_bytes, "65536");
+// Max bytes of pages prefetched for a segment at a time.
+CONF_mInt64(column_page_prefetch_max_bytes, "16777216");
+
+// Whether to evaluate the comparisons on integer columns on the encoded data pages, e.g. the bit-packed
+// deltas of frame of reference pages, to skip decoding the rows not matching.
+CONF_mBool(enable_encoded_predicate_evaluation, "true");
+
+// Number of bytes of each gram added to the ngram bloom filter index of newly written segments. Predicates
+// like `c LIKE '%substr%'` can use the index only if the substring is at least this long.
+CONF_mInt32(ngram_bloom_filter_index_gram_size, "3");
+
 // Max batched bytes for each transmit request.
 CONF_Int64(max_transmit_batched_bytes, "65536");
 
@@ -594,6 +662,11 @@ CONF_mInt16(storage_format_version, "2");
 // 1 for LZ4_NULL
 CONF_mInt16(null_encoding, "0");
 
+// IMPORTANT NOTE: the segments written with this config enabled can't be read by the BEs of old versions.
+// Whether to encode the new written FLOAT/DOUBLE columns with ALP encoding, which encodes each page with
+// ALP, Gorilla or plain coding, chosen by a sample of the page.
+CONF_mBool(enable_lightweight_float_encoding, "false");
+
 // Do pre-aggregate if effect great than the factor, factor range:[1-100].
 CONF_Int16(pre_aggregate_factor, "80");
 
@@ -628,12 +701,56 @@ CONF_Int64(pipeline_scan_thread_pool_thread_num, "0");
 CONF_Int64(pipeline_scan_thread_pool_queue_size, "102400");
 // The number of execution threads for pipeline engine.
 CONF_Int64(pipeline_exec_thread_pool_thread_num, "0");
+// If true, the execution threads of pipeline engine without resource group take drivers from their own
+// local queues and steal from the others when idle, instead of sharing one queue guarded by a global lock.
+CONF_Bool(enable_pipeline_work_stealing_driver_queue, "false");
+// If true, the drivers blocked on exchange, local exchange and join dependencies are parked by the poller
+// and woken up by the events they wait for, instead of being checked by the poller repeatedly.
+CONF_mBool(enable_pipeline_event_driven_poller, "true");
+// The interval at which the poller checks the parked drivers anyway, to handle the cancellation and
+// expiration of the queries.
+CONF_mInt64(pipeline_poller_parked_driver_check_interval_ms, "50");
+// If true, the tablets of olap scan are split into morsels by rowsets and segments, which are shared by
+// all the scan operators of a pipeline, so that the idle operators could take the remaining morsels.
+CONF_mBool(enable_pipeline_olap_scan_morsel_split, "true");
+// The approximate number of rows read by a split morsel of olap scan.
+CONF_mInt64(pipeline_olap_scan_morsel_split_rows, "1048576");
 // The buffer size of io task.
 CONF_Int64(pipeline_io_buffer_size, "64");
+// If true, the scan operators of a pipeline put the chunks read by io tasks into a bounded buffer shared
+// by all of them, so that an operator could output the chunks read for the others.
+CONF_mBool(enable_pipeline_shared_scan_chunk_buffer, "true");
+// The max bytes of the chunks buffered by the shared scan chunk buffers of a query, the scan operators
+// stop submitting io tasks when exceeded.
+CONF_mInt64(pipeline_scan_chunk_buffer_query_max_bytes, "2147483648");
+// Whether to cache the per-tablet partial aggregation results of olap scan fragments, and reuse them
+// in the later queries with the same plan.
+CONF_mBool(enable_query_cache, "false");
+// Fragments reading more tablets than this aren't cached, because each tablet is read by its own driver.
+CONF_mInt64(query_cache_max_tablets_per_fragment, "64");
+// The capacity of query cache in bytes.
+CONF_Int64(query_cache_capacity, "536870912");
 // The buffer size of SinkBuffer.
 CONF_Int64(pipeline_sink_buffer_size, "64");
 // The degree of parallelism of brpc.
 CONF_Int64(pipeline_sink_brpc_dop, "8");
+// Send the chunks to the fragment instances on the same backend in one RPC.
+// Only enable it after all the backends support the transmit_chunk_batch RPC.
+CONF_mBool(enable_pipeline_sink_rpc_coalescing, "false");
+// An RPC taking more than this is regarded as held by the back pressure of the receiver, and the next requests
+// to its fragment instances are sent in separate RPCs until they return faster, so that a slow receiver doesn't
+// hold back the other fragment instances batched with it.
+CONF_mInt64(pipeline_sink_rpc_back_pressure_ms, "100");
+// Build the hash table of broadcast join by all the pipeline drivers, each of which builds
+// the sub hash table of one hash partition of the build side.
+CONF_mBool(enable_pipeline_parallel_broadcast_join_build, "false");
+// The sub hash tables built in parallel are merged into one hash table, if the build side
+// has no more rows than this, since probing a single hash table is cheaper.
+CONF_mInt64(pipeline_parallel_join_build_merge_rows, "65536");
+// If true, the blocking aggregate whose input is not partitioned by the group by keys pre-aggregates
+// the input in every driver, and then merges the hash partitioned intermediate results in parallel,
+// instead of shuffling all the input rows by the group by keys before aggregating.
+CONF_mBool(enable_pipeline_agg_partitioned_merge, "false");
 
 // The bitmap serialize version.
 CONF_Int16(bitmap_serialize_version, "1");
@@ -658,6 +775,11 @@ CONF_Bool(use_hdfs_pread, "true");
 // default: true
 CONF_Bool(rewrite_partial_segment, "true");
 
+// if true, a partial update whose rows all exist in the tablet only writes the updated columns
+// into delta column files of the segments of the old rows, instead of rewriting full rows.
+// the delta columns are merged when reading and folded into new segments by compaction.
+CONF_mBool(enable_column_mode_partial_update, "false");
+
 // Properties to access object storage
 CONF_String(object_storage_access_key_id, "");
 CONF_String(object_storage_secret_access_key, "");
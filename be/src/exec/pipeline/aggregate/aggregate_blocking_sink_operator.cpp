@@ -20,10 +20,18 @@ void AggregateBlockingSinkOperator::close(RuntimeState* state) {
 void AggregateBlockingSinkOperator::set_finishing(RuntimeState* state) {
     _is_finished = true;
 
-    if (!_aggregator->is_none_group_by_exprs()) {
+    if (!_aggregator->is_none_group_by_exprs() && _aggregator->is_partitioned_merge()) {
+        COUNTER_SET(_aggregator->hash_table_size(), (int64_t)_aggregator->hash_map_variant().size());
+        // The groups are merged and output by the source operators after all the sink operators finish.
+        _aggregator->partition_hash_map_for_merge();
+        _mem_tracker->set(_aggregator->hash_map_variant().memory_usage() +
+                          _aggregator->mem_pool()->total_reserved_bytes() +
+                          _aggregator->partitioned_merge_memory_usage());
+    } else if (!_aggregator->is_none_group_by_exprs()) {
         COUNTER_SET(_aggregator->hash_table_size(), (int64_t)_aggregator->hash_map_variant().size());
-        // If hash map is empty, we don't need to return value
-        if (_aggregator->hash_map_variant().size() == 0) {
+        // If hash map is empty, we don't need to return value.
+        // But if the hash map has been spilled, the spilled rows still need to be restored.
+        if (_aggregator->hash_map_variant().size() == 0 && !_aggregator->has_spilled()) {
             _aggregator->set_ht_eos();
         }
 
@@ -97,6 +105,13 @@ Status AggregateBlockingSinkOperator::push_chunk(RuntimeState* state, const vect
     _aggregator->update_num_input_rows(chunk_size);
     RETURN_IF_ERROR(_aggregator->check_has_error());
 
+    // With limit, the hash map stops growing once it holds enough groups, so spilling is never needed.
+    if (_aggregator->is_spill_enabled() && !_aggregator->is_none_group_by_exprs() && !agg_group_by_with_limit) {
+        RETURN_IF_ERROR(_aggregator->try_spill_hash_map());
+        _mem_tracker->set(_aggregator->hash_map_variant().memory_usage() +
+                          _aggregator->mem_pool()->total_reserved_bytes());
+    }
+
     return Status::OK();
 }
 } // namespace starrocks::pipeline
@@ -7,7 +7,7 @@
 namespace starrocks::pipeline {
 
 bool AggregateBlockingSourceOperator::has_output() const {
-    return _aggregator->is_sink_complete() && !_aggregator->is_ht_eos();
+    return _aggregator->is_sink_complete() && _aggregator->is_partitioned_merge_ready() && !_aggregator->is_ht_eos();
 }
 
 bool AggregateBlockingSourceOperator::is_finished() const {
@@ -33,6 +33,12 @@ StatusOr<vectorized::ChunkPtr> AggregateBlockingSourceOperator::pull_chunk(Runti
         SCOPED_TIMER(_aggregator->get_results_timer());
         _aggregator->convert_to_chunk_no_groupby(&chunk);
     } else {
+        if (_aggregator->has_spilled()) {
+            RETURN_IF_ERROR(_aggregator->restore_spilled_partition_if_needed());
+        }
+        if (_aggregator->is_partitioned_merge()) {
+            RETURN_IF_ERROR(_aggregator->merge_partition_if_needed());
+        }
         if (false) {
         }
 #define HASH_MAP_METHOD(NAME)                                                                                     \
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "common/status.h"
+#include "exec/pipeline/observable.h"
 #include "runtime/runtime_state.h"
 
 namespace starrocks::pipeline {
@@ -54,9 +55,13 @@ public:
     // non-output operators to be finished early.
     bool is_finished() const { return _is_finished.load(std::memory_order_acquire); }
 
+    // Notified when the operators depending on this context become ready.
+    Observable& observable() { return _observable; }
+
 protected:
     std::atomic<int32_t> _num_running_operators = 0;
     std::atomic<bool> _is_finished = false;
+    Observable _observable;
 };
 
 } // namespace starrocks::pipeline
\ No newline at end of file
@@ -31,7 +31,11 @@ public:
         _build_chunks[sinker_id] = build_chunk;
     }
 
-    void finish_one_right_sinker() { _num_finished_right_sinkers.fetch_add(1, std::memory_order_release); }
+    void finish_one_right_sinker() {
+        if (_num_finished_right_sinkers.fetch_add(1, std::memory_order_release) + 1 == _num_right_sinkers) {
+            _observable.notify_observers();
+        }
+    }
 
     bool is_right_finished() const {
         return _num_finished_right_sinkers.load(std::memory_order_acquire) == _num_right_sinkers;
@@ -37,6 +37,8 @@ public:
 
     bool is_ready() const override { return _cross_join_context->is_right_finished(); }
 
+    std::vector<Observable*> observables() override { return {&_cross_join_context->observable()}; }
+
     bool has_output() const override {
         // The probe chunk has been pushed to this operator,
         // and isn't finished crossing join with build chunks.
@@ -327,6 +327,15 @@ Status ExchangeSinkOperator::prepare(RuntimeState* state) {
         _compress_type = CompressionTypePB::LZ4;
     }
     RETURN_IF_ERROR(get_block_compression_codec(_compress_type, &_compress_codec));
+    if (state->query_options().__isset.transmission_encode_level &&
+        state->query_options().transmission_encode_level != 0) {
+        _encode_context = std::make_unique<serde::EncodeContext>(state->query_options().transmission_encode_level);
+    }
+    if ((_part_type == TPartitionType::HASH_PARTITIONED ||
+         _part_type == TPartitionType::BUCKET_SHFFULE_HASH_PARTITIONED) &&
+        config::shuffle_hot_key_ratio > 0) {
+        _skew_detector = std::make_unique<ShuffleSkewDetector>(_channels.size(), _num_shuffles);
+    }
 
     std::string instances;
     for (const auto& channel : _channels) {
@@ -476,6 +485,9 @@ Status ExchangeSinkOperator::push_chunk(RuntimeState* state, const vectorized::C
                     column->crc32_hash(&_hash_values[0], 0, num_rows);
                 }
             }
+            if (_skew_detector != nullptr) {
+                _skew_detector->update(_hash_values.data(), num_rows);
+            }
 
             // Compute row indexes for each channel's each shuffle
             _channel_row_idx_start_points.assign(num_channels * _num_shuffles + 1, 0);
@@ -542,6 +554,9 @@ void ExchangeSinkOperator::set_finishing(RuntimeState* state) {
 }
 
 void ExchangeSinkOperator::close(RuntimeState* state) {
+    if (_skew_detector != nullptr) {
+        _skew_detector->report(_unique_metrics.get());
+    }
     Operator::close(state);
 }
 
@@ -552,12 +567,12 @@ Status ExchangeSinkOperator::serialize_chunk(const vectorized::Chunk* src, Chunk
         SCOPED_TIMER(_serialize_batch_timer);
         // We only serialize chunk meta for first chunk
         if (*is_first_chunk) {
-            StatusOr<ChunkPB> res = serde::ProtobufChunkSerde::serialize(*src);
+            StatusOr<ChunkPB> res = serde::ProtobufChunkSerde::serialize(*src, _encode_context.get());
             RETURN_IF_ERROR(res);
             res->Swap(dst);
             *is_first_chunk = false;
         } else {
-            StatusOr<ChunkPB> res = serde::ProtobufChunkSerde::serialize_without_meta(*src);
+            StatusOr<ChunkPB> res = serde::ProtobufChunkSerde::serialize_without_meta(*src, _encode_context.get());
             RETURN_IF_ERROR(res);
             res->Swap(dst);
         }
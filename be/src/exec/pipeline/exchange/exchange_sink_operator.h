@@ -14,6 +14,8 @@
 #include "exec/pipeline/operator.h"
 #include "gen_cpp/data.pb.h"
 #include "gen_cpp/internal_service.pb.h"
+#include "runtime/shuffle_skew_detector.h"
+#include "serde/encode_context.h"
 #include "util/raw_container.h"
 #include "util/runtime_profile.h"
 
@@ -51,6 +53,8 @@ public:
 
     bool pending_finish() const override;
 
+    std::vector<Observable*> observables() override { return {&_buffer->observable()}; }
+
     void set_finishing(RuntimeState* state) override;
 
     void set_cancelled(RuntimeState* state) override;
@@ -114,6 +118,10 @@ private:
 
     CompressionTypePB _compress_type = CompressionTypePB::NO_COMPRESSION;
     const BlockCompressionCodec* _compress_codec = nullptr;
+    // Choose the encodings of the columns, null if `transmission_encode_level` is 0.
+    std::unique_ptr<serde::EncodeContext> _encode_context;
+    // Detect the hot keys of the hash shuffle, null if `shuffle_hot_key_ratio` is 0.
+    std::unique_ptr<ShuffleSkewDetector> _skew_detector;
 
     RuntimeProfile::Counter* _serialize_batch_timer = nullptr;
     RuntimeProfile::Counter* _shuffle_hash_timer = nullptr;
@@ -24,6 +24,10 @@ bool ExchangeSourceOperator::is_finished() const {
     return _stream_recvr->is_finished();
 }
 
+std::vector<Observable*> ExchangeSourceOperator::observables() {
+    return {&_stream_recvr->observable()};
+}
+
 void ExchangeSourceOperator::set_finishing(RuntimeState* state) {
     _is_finishing = true;
     _stream_recvr->short_circuit_for_pipeline(_driver_sequence);
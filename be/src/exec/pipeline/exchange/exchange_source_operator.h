@@ -23,6 +23,8 @@ public:
 
     bool is_finished() const override;
 
+    std::vector<Observable*> observables() override;
+
     void set_finishing(RuntimeState* state) override;
 
     StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
@@ -46,6 +46,8 @@ public:
 
     bool need_input() const;
 
+    LocalExchangeMemoryManager* memory_manager() const { return _memory_manager.get(); }
+
     void increment_sink_number() { _sink_number++; }
 
     int32_t decrement_sink_number() { return _sink_number--; }
@@ -4,6 +4,8 @@
 
 #include <atomic>
 
+#include "exec/pipeline/observable.h"
+
 namespace starrocks::pipeline {
 // Manage the memory usage for local exchange
 // TODO(KKS): Should use the real chunk memory usage, not chunk row number
@@ -11,11 +13,20 @@ namespace starrocks::pipeline {
 class LocalExchangeMemoryManager {
 public:
     LocalExchangeMemoryManager(int32_t max_row_count) : _max_row_count(max_row_count) {}
-    void update_row_count(int32_t row_count) { _row_count += row_count; }
+    void update_row_count(int32_t row_count) {
+        int32_t prev_row_count = _row_count.fetch_add(row_count);
+        if (prev_row_count >= _max_row_count && prev_row_count + row_count < _max_row_count) {
+            _observable.notify_observers();
+        }
+    }
     bool is_full() const { return _row_count >= _max_row_count; }
 
+    // Notified when the memory manager becomes not full, or the sources are finished.
+    Observable& observable() { return _observable; }
+
 private:
     int32_t _max_row_count;
     std::atomic<int32_t> _row_count{0};
+    Observable _observable;
 };
 } // namespace starrocks::pipeline
\ No newline at end of file
@@ -43,10 +43,15 @@ public:
 
     void set_finished(RuntimeState* state) override;
     void set_finishing(RuntimeState* state) override {
-        std::lock_guard<std::mutex> l(_chunk_lock);
-        _is_finished = true;
+        {
+            std::lock_guard<std::mutex> l(_chunk_lock);
+            _is_finished = true;
+        }
+        _observable.notify_observers();
     }
 
+    std::vector<Observable*> observables() override { return {&_observable}; }
+
     StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
 
 private:
@@ -62,6 +67,8 @@ private:
     // TODO(KKS): make it lock free
     mutable std::mutex _chunk_lock;
     const std::shared_ptr<LocalExchangeMemoryManager>& _memory_manager;
+    // Notified when chunks are added or the sinks are finished.
+    Observable _observable;
 };
 
 class LocalExchangeSourceOperatorFactory final : public SourceOperatorFactory {
@@ -2,6 +2,11 @@
 
 #include "exec/pipeline/exchange/sink_buffer.h"
 
+#include <string>
+#include <unordered_map>
+
+#include "util/time.h"
+
 namespace starrocks::pipeline {
 
 SinkBuffer::SinkBuffer(FragmentContext* fragment_ctx, const std::vector<TPlanFragmentDestination>& destinations,
@@ -11,6 +16,7 @@ SinkBuffer::SinkBuffer(FragmentContext* fragment_ctx, const std::vector<TPlanFra
           _brpc_timeout_ms(std::min(3600, fragment_ctx->runtime_state()->query_options().query_timeout) * 1000),
           _is_dest_merge(is_dest_merge),
           _num_uncancelled_sinkers(num_sinkers) {
+    std::unordered_map<std::string, size_t> host_ids;
     for (const auto& dest : destinations) {
         const auto& instance_id = dest.fragment_instance_id;
         // instance_id.lo == -1 indicates that the destination is pseudo for bucket shuffle join.
@@ -32,11 +38,21 @@ SinkBuffer::SinkBuffer(FragmentContext* fragment_ctx, const std::vector<TPlanFra
             _num_finished_rpcs[instance_id.lo] = 0;
             _num_in_flight_rpcs[instance_id.lo] = 0;
             _mutexes[instance_id.lo] = std::make_unique<std::mutex>();
+            _is_back_pressured[instance_id.lo] = false;
 
             PUniqueId finst_id;
             finst_id.set_hi(instance_id.hi);
             finst_id.set_lo(instance_id.lo);
             _instance_id2finst_id[instance_id.lo] = std::move(finst_id);
+
+            const TNetworkAddress& address = dest.__isset.brpc_server ? dest.brpc_server : dest.server;
+            auto [host_it, inserted] =
+                    host_ids.emplace(address.hostname + ":" + std::to_string(address.port), _host_instances.size());
+            if (inserted) {
+                _host_instances.emplace_back();
+            }
+            _host_instances[host_it->second].push_back(instance_id);
+            _instance_host_ids[instance_id.lo] = host_it->second;
         }
     }
 
@@ -106,6 +122,7 @@ void SinkBuffer::cancel_one_sinker() {
     if (--_num_uncancelled_sinkers == 0) {
         _is_finishing = true;
     }
+    _observable.notify_observers();
 }
 
 void SinkBuffer::_process_send_window(const TUniqueId& instance_id, const int64_t sequence) {
@@ -128,11 +145,24 @@ void SinkBuffer::_try_to_send_rpc(const TUniqueId& instance_id) {
     DeferOp decrease_defer([this]() { --_num_sending_rpc; });
     ++_num_sending_rpc;
 
-    for (;;) {
-        if (_is_finishing) {
-            return;
-        }
+    if (_is_finishing) {
+        return;
+    }
+    std::vector<TransmitChunkInfo> requests(1);
+    if (!_pop_request_to_send(instance_id, &requests[0])) {
+        return;
+    }
+    // The popped requests of the other instances are sent before their mutexes are released,
+    // the same as the request of |instance_id|.
+    std::vector<std::unique_lock<std::mutex>> locks;
+    if (config::enable_pipeline_sink_rpc_coalescing && !_is_back_pressured[instance_id.lo]) {
+        _collect_requests_to_same_host(instance_id, &requests, &locks);
+    }
+    _send_rpc(requests);
+}
 
+bool SinkBuffer::_pop_request_to_send(const TUniqueId& instance_id, TransmitChunkInfo* request) {
+    for (;;) {
         auto& buffer = _buffers[instance_id.lo];
 
         bool too_much_brpc_process = false;
@@ -147,105 +177,151 @@ void SinkBuffer::_try_to_send_rpc(const TUniqueId& instance_id) {
             too_much_brpc_process = _num_in_flight_rpcs[instance_id.lo] >= config::pipeline_sink_brpc_dop;
         }
         if (buffer.empty() || too_much_brpc_process) {
-            return;
+            return false;
         }
 
-        TransmitChunkInfo request = buffer.front();
-        bool need_wait = false;
-        DeferOp pop_defer([&need_wait, &buffer]() {
-            if (need_wait) {
-                return;
-            }
-            buffer.pop();
-        });
-
         // The order of data transmiting in IO level may not be strictly the same as
         // the order of submitting data packets
         // But we must guarantee that first packet must be received first
         if (_num_finished_rpcs[instance_id.lo] == 0 && _num_in_flight_rpcs[instance_id.lo] > 0) {
-            need_wait = true;
-            return;
+            return false;
         }
-        if (request.params->eos()) {
-            DeferOp eos_defer([this, &instance_id, &need_wait]() {
-                if (need_wait) {
-                    return;
-                }
-                if (--_num_remaining_eos == 0) {
-                    _is_finishing = true;
-                }
-                --_num_sinkers[instance_id.lo];
-            });
+        TransmitChunkInfo& front = buffer.front();
+        if (front.params->eos()) {
             // Only the last eos is sent to ExchangeSourceOperator. it must be guaranteed that
             // eos is the last packet to send to finish the input stream of the corresponding of
             // ExchangeSourceOperator and eos is sent exactly-once.
+            bool skip_request = false;
             if (_num_sinkers[instance_id.lo] > 1) {
-                if (request.params->chunks_size() == 0) {
+                if (front.params->chunks_size() == 0) {
                     // Once the request is added to SinkBuffer, its ownership will also be transferred,
                     // so SinkBuffer needs to be responsible for the release of resources
-                    request.params->release_finst_id();
-                    continue;
+                    front.params->release_finst_id();
+                    skip_request = true;
                 } else {
-                    request.params->set_eos(false);
+                    front.params->set_eos(false);
                 }
             } else {
                 // The order of data transmiting in IO level may not be strictly the same as
                 // the order of submitting data packets
                 // But we must guarantee that eos packent must be the last packet
                 if (_num_in_flight_rpcs[instance_id.lo] > 0) {
-                    need_wait = true;
-                    return;
+                    return false;
                 }
             }
-        }
-
-        request.params->set_allocated_finst_id(&_instance_id2finst_id[instance_id.lo]);
-        request.params->set_sequence(_request_seqs[instance_id.lo]++);
-
-        auto* closure =
-                new DisposableClosure<PTransmitChunkResult, ClosureContext>({instance_id, request.params->sequence()});
-        closure->addFailedHandler([this](const ClosureContext& ctx) noexcept {
-            _is_finishing = true;
-            {
-                std::lock_guard<std::mutex> l(*_mutexes[ctx.instance_id.lo]);
-                ++_num_finished_rpcs[ctx.instance_id.lo];
-                --_num_in_flight_rpcs[ctx.instance_id.lo];
-            }
-            --_total_in_flight_rpc;
-            _fragment_ctx->cancel(Status::InternalError("transmit chunk rpc failed"));
-            LOG(WARNING) << "transmit chunk rpc failed";
-        });
-        closure->addSuccessHandler([this](const ClosureContext& ctx, const PTransmitChunkResult& result) noexcept {
-            Status status(result.status());
-            {
-                std::lock_guard<std::mutex> l(*_mutexes[ctx.instance_id.lo]);
-                ++_num_finished_rpcs[ctx.instance_id.lo];
-                --_num_in_flight_rpcs[ctx.instance_id.lo];
-            }
-            if (!status.ok()) {
+            if (--_num_remaining_eos == 0) {
                 _is_finishing = true;
-                _fragment_ctx->cancel(status);
-                LOG(WARNING) << "transmit chunk rpc failed, " << status.message();
-            } else {
-                std::lock_guard<std::mutex> l(*_mutexes[ctx.instance_id.lo]);
-                _process_send_window(ctx.instance_id, ctx.sequence);
-                _try_to_send_rpc(ctx.instance_id);
             }
-            --_total_in_flight_rpc;
-        });
+            --_num_sinkers[instance_id.lo];
+            if (skip_request) {
+                buffer.pop();
+                continue;
+            }
+        }
 
-        ++_total_in_flight_rpc;
+        *request = std::move(front);
+        buffer.pop();
+        request->params->set_allocated_finst_id(&_instance_id2finst_id[instance_id.lo]);
+        request->params->set_sequence(_request_seqs[instance_id.lo]++);
         ++_num_in_flight_rpcs[instance_id.lo];
+        return true;
+    }
+}
+
+void SinkBuffer::_collect_requests_to_same_host(const TUniqueId& instance_id, std::vector<TransmitChunkInfo>* requests,
+                                                std::vector<std::unique_lock<std::mutex>>* locks) {
+    size_t num_bytes = requests->front().attachment.size();
+    for (const TUniqueId& other_id : _host_instances[_instance_host_ids[instance_id.lo]]) {
+        if (num_bytes >= config::max_transmit_batched_bytes || _is_finishing) {
+            return;
+        }
+        if (other_id.lo == instance_id.lo) {
+            continue;
+        }
+        // The mutex of |instance_id| is held, wait for another one may lead to deadlock.
+        std::unique_lock<std::mutex> lock(*_mutexes[other_id.lo], std::try_to_lock);
+        if (!lock.owns_lock() || _is_back_pressured[other_id.lo]) {
+            continue;
+        }
+        TransmitChunkInfo request;
+        if (_pop_request_to_send(other_id, &request)) {
+            num_bytes += request.attachment.size();
+            requests->emplace_back(std::move(request));
+            locks->emplace_back(std::move(lock));
+        }
+    }
+}
+
+void SinkBuffer::_send_rpc(std::vector<TransmitChunkInfo>& requests) {
+    std::vector<ClosureContext> contexts;
+    contexts.reserve(requests.size());
+    for (const auto& request : requests) {
+        contexts.push_back({request.fragment_instance_id, request.params->sequence()});
+    }
+    auto* closure = new DisposableClosure<PTransmitChunkResult, std::vector<ClosureContext>>(contexts);
+    closure->addFailedHandler([this](const std::vector<ClosureContext>& ctxs) noexcept {
+        _is_finishing = true;
+        for (const auto& ctx : ctxs) {
+            std::lock_guard<std::mutex> l(*_mutexes[ctx.instance_id.lo]);
+            ++_num_finished_rpcs[ctx.instance_id.lo];
+            --_num_in_flight_rpcs[ctx.instance_id.lo];
+        }
+        _observable.notify_observers();
+        --_total_in_flight_rpc;
+        _fragment_ctx->cancel(Status::InternalError("transmit chunk rpc failed"));
+        LOG(WARNING) << "transmit chunk rpc failed";
+    });
+    closure->addSuccessHandler(
+            [this, send_ms = MonotonicMillis()](const std::vector<ClosureContext>& ctxs,
+                                                const PTransmitChunkResult& result) noexcept {
+                Status status(result.status());
+                // The receiver holds the RPC when its buffer is full. A batched RPC held by one of the receivers
+                // marks all of its instances, and the ones not back pressured are unmarked by their next RPC.
+                bool back_pressured = MonotonicMillis() - send_ms >= config::pipeline_sink_rpc_back_pressure_ms;
+                for (const auto& ctx : ctxs) {
+                    std::lock_guard<std::mutex> l(*_mutexes[ctx.instance_id.lo]);
+                    ++_num_finished_rpcs[ctx.instance_id.lo];
+                    --_num_in_flight_rpcs[ctx.instance_id.lo];
+                    _is_back_pressured[ctx.instance_id.lo] = back_pressured;
+                }
+                if (!status.ok()) {
+                    _is_finishing = true;
+                    _fragment_ctx->cancel(status);
+                    LOG(WARNING) << "transmit chunk rpc failed, " << status.message();
+                } else {
+                    for (const auto& ctx : ctxs) {
+                        std::lock_guard<std::mutex> l(*_mutexes[ctx.instance_id.lo]);
+                        _process_send_window(ctx.instance_id, ctx.sequence);
+                        _try_to_send_rpc(ctx.instance_id);
+                    }
+                }
+                // SinkBuffer may be destroyed once _total_in_flight_rpc decreases to zero,
+                // so notify the blocked sinkers before that.
+                _observable.notify_observers();
+                --_total_in_flight_rpc;
+            });
 
-        closure->cntl.Reset();
-        closure->cntl.set_timeout_ms(_brpc_timeout_ms);
-        closure->cntl.request_attachment().append(request.attachment);
-        request.brpc_stub->transmit_chunk(&closure->cntl, request.params.get(), &closure->result, closure);
+    ++_total_in_flight_rpc;
 
+    closure->cntl.Reset();
+    closure->cntl.set_timeout_ms(_brpc_timeout_ms);
+    if (requests.size() == 1) {
+        closure->cntl.request_attachment().append(requests[0].attachment);
+        requests[0].brpc_stub->transmit_chunk(&closure->cntl, requests[0].params.get(), &closure->result, closure);
+    } else {
+        // The receiver splits the attachment by the data sizes of the chunks of each request in order.
+        PTransmitChunkBatchParams batch_params;
+        for (const auto& request : requests) {
+            batch_params.add_requests()->CopyFrom(*request.params);
+            closure->cntl.request_attachment().append(request.attachment);
+        }
+        requests[0].brpc_stub->transmit_chunk_batch(&closure->cntl, &batch_params, &closure->result, closure);
+    }
+
+    for (auto& request : requests) {
         // Once the request is added to SinkBuffer, its ownership will also be transferred,
         // so SinkBuffer needs to be responsible for the release of resources
         request.params->release_finst_id();
-        return;
     }
 }
 } // namespace starrocks::pipeline
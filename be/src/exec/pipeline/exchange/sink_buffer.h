@@ -10,6 +10,7 @@
 #include <unordered_set>
 
 #include "column/chunk.h"
+#include "exec/pipeline/observable.h"
 #include "exec/pipeline/fragment_context.h"
 #include "gen_cpp/BackendService.h"
 #include "runtime/current_thread.h"
@@ -53,6 +54,9 @@ public:
     // the rest chunk request and EOS request needn't be sent anymore.
     void cancel_one_sinker();
 
+    // Notified when the in-flight RPCs complete, which makes room for the sinkers.
+    Observable& observable() { return _observable; }
+
 private:
     // Update the discontinuous acked window, here are the invariants:
     // all acks received with sequence from [0, _max_continuous_acked_seqs[x]]
@@ -60,6 +64,16 @@ private:
     // _discontinuous_acked_seqs[x] stored the received discontinuous acks
     void _process_send_window(const TUniqueId& instance_id, const int64_t sequence);
     void _try_to_send_rpc(const TUniqueId& instance_id);
+    // Pop the next request of |instance_id| which could be sent now, and assign its sequence.
+    // REQUIRES: the mutex of |instance_id| is held.
+    bool _pop_request_to_send(const TUniqueId& instance_id, TransmitChunkInfo* request);
+    // Pop the requests which could be sent now to the other instances on the same host as |instance_id|,
+    // the instances whose mutex is held by others or which are back pressured are skipped. The mutexes of the
+    // instances whose request is popped are added to |locks|.
+    void _collect_requests_to_same_host(const TUniqueId& instance_id, std::vector<TransmitChunkInfo>* requests,
+                                        std::vector<std::unique_lock<std::mutex>>* locks);
+    // Send |requests| to the same host in one RPC.
+    void _send_rpc(std::vector<TransmitChunkInfo>& requests);
 
     FragmentContext* _fragment_ctx;
     const MemTracker* _mem_tracker;
@@ -92,6 +106,12 @@ private:
     phmap::flat_hash_map<int64_t, int32_t> _num_finished_rpcs;
     phmap::flat_hash_map<int64_t, int32_t> _num_in_flight_rpcs;
     phmap::flat_hash_map<int64_t, std::unique_ptr<std::mutex>> _mutexes;
+    // The requests to the instances on the same host are sent in one RPC, see `_collect_requests_to_same_host`.
+    phmap::flat_hash_map<int64_t, size_t> _instance_host_ids;
+    std::vector<std::vector<TUniqueId>> _host_instances;
+    // Whether the last RPC to the instance took more than `pipeline_sink_rpc_back_pressure_ms`, the requests of
+    // such an instance are sent in separate RPCs.
+    phmap::flat_hash_map<int64_t, bool> _is_back_pressured;
 
     // True means that SinkBuffer needn't input chunk and send chunk anymore,
     // but there may be still in-flight RPC running.
@@ -106,6 +126,8 @@ private:
     std::atomic<bool> _is_finishing = false;
     std::atomic<int32_t> _num_sending_rpc = 0;
 
+    Observable _observable;
+
 }; // namespace starrocks::pipeline
 
 } // namespace starrocks::pipeline
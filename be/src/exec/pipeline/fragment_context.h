@@ -9,6 +9,7 @@
 #include "exec/pipeline/pipeline.h"
 #include "exec/pipeline/pipeline_driver.h"
 #include "exec/pipeline/pipeline_fwd.h"
+#include "exec/pipeline/query_cache/query_cache.h"
 #include "exec/pipeline/runtime_filter_types.h"
 #include "gen_cpp/FrontendService.h"
 #include "gen_cpp/HeartbeatService.h"
@@ -101,6 +102,17 @@ public:
 
     MorselQueueMap& morsel_queues() { return _morsel_queues; }
 
+    // Register |ctx| for both the scan node and the aggregation node of the cacheable fragment.
+    void set_query_cache_context(const QueryCacheContextPtr& ctx) {
+        _query_cache_contexts[ctx->scan_node_id()] = ctx;
+        _query_cache_contexts[ctx->agg_node_id()] = ctx;
+    }
+    // Return nullptr if the plan node isn't a part of a cacheable fragment.
+    QueryCacheContextPtr query_cache_context(int32_t plan_node_id) const {
+        auto it = _query_cache_contexts.find(plan_node_id);
+        return it == _query_cache_contexts.end() ? nullptr : it->second;
+    }
+
     Status prepare_all_pipelines() {
         for (auto& pipe : _pipelines) {
             RETURN_IF_ERROR(pipe->prepare(_runtime_state.get()));
@@ -151,6 +163,7 @@ private:
     // MorselQueue that is shared among drivers created from the same pipeline,
     // drivers contend for Morsels from MorselQueue.
     MorselQueueMap _morsel_queues;
+    std::unordered_map<int32_t, QueryCacheContextPtr> _query_cache_contexts;
     // when _num_root_drivers counts down to zero, means that all the root drivers are finished,
     // the fragment instance produces the entire result required, all the outstanding drivers
     // should finish computation.
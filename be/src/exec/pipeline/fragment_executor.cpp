@@ -3,7 +3,9 @@
 #include "exec/pipeline/fragment_executor.h"
 
 #include <unordered_map>
+#include <unordered_set>
 
+#include "common/config.h"
 #include "exec/exchange_node.h"
 #include "exec/pipeline/exchange/exchange_sink_operator.h"
 #include "exec/pipeline/exchange/local_exchange_source_operator.h"
@@ -11,11 +13,14 @@
 #include "exec/pipeline/exchange/sink_buffer.h"
 #include "exec/pipeline/fragment_context.h"
 #include "exec/pipeline/morsel.h"
+#include "exec/pipeline/olap_scan_operator.h"
 #include "exec/pipeline/pipeline_builder.h"
 #include "exec/pipeline/pipeline_driver_executor.h"
+#include "exec/pipeline/query_cache/query_cache.h"
 #include "exec/pipeline/result_sink_operator.h"
 #include "exec/pipeline/scan_operator.h"
 #include "exec/scan_node.h"
+#include "exec/vectorized/olap_scan_node.h"
 #include "exec/workgroup/work_group.h"
 #include "gen_cpp/doris_internal_service.pb.h"
 #include "gutil/casts.h"
@@ -203,11 +208,33 @@ Status FragmentExecutor::prepare(ExecEnv* exec_env, const TExecPlanFragmentParam
     plan->collect_scan_nodes(&scan_nodes);
 
     MorselQueueMap& morsel_queues = _fragment_ctx->morsel_queues();
+    // The morsel queues shared by all the drivers of the pipeline, instead of being split for each driver.
+    std::unordered_set<int32_t> shared_morsel_queue_ids;
+    const bool enable_morsel_split = config::enable_pipeline_olap_scan_morsel_split;
+    const int64_t morsel_split_rows = config::pipeline_olap_scan_morsel_split_rows;
+    // The result of a query cache depends on the global dicts, which may change across queries.
+    const bool enable_query_cache =
+            !request.fragment.__isset.query_global_dicts || request.fragment.query_global_dicts.empty();
     for (auto& i : scan_nodes) {
         ScanNode* scan_node = down_cast<ScanNode*>(i);
         const std::vector<TScanRangeParams>& scan_ranges =
                 FindWithDefault(params.per_node_scan_ranges, scan_node->id(), no_scan_ranges);
         Morsels morsels = convert_scan_range_to_morsel(scan_ranges, scan_node->id());
+        auto* olap_scan_node = dynamic_cast<vectorized::OlapScanNode*>(scan_node);
+        if (enable_query_cache && olap_scan_node != nullptr) {
+            ASSIGN_OR_RETURN(auto cache_ctx, QueryCacheContext::create(runtime_state, fragment.plan, *desc_tbl,
+                                                                       &morsels));
+            if (cache_ctx != nullptr) {
+                // The morsels are moved into the lanes, each of which is read by a driver.
+                _fragment_ctx->set_query_cache_context(cache_ctx);
+                morsel_queues.emplace(scan_node->id(), std::make_unique<MorselQueue>(Morsels{}));
+                continue;
+            }
+        }
+        if (enable_morsel_split && morsel_split_rows > 0 && olap_scan_node != nullptr) {
+            ASSIGN_OR_RETURN(morsels, split_olap_scan_morsels(olap_scan_node, std::move(morsels), morsel_split_rows));
+            shared_morsel_queue_ids.insert(scan_node->id());
+        }
         morsel_queues.emplace(scan_node->id(), std::make_unique<MorselQueue>(std::move(morsels)));
     }
 
@@ -250,7 +277,16 @@ Status FragmentExecutor::prepare(ExecEnv* exec_env, const TExecPlanFragmentParam
             if (morsel_queue->num_morsels() > 0) {
                 DCHECK(degree_of_parallelism <= morsel_queue->num_morsels());
             }
-            std::vector<MorselQueuePtr> morsel_queue_per_driver = morsel_queue->split_by_size(degree_of_parallelism);
+            // The scan operators take morsels from the shared queue until it is empty, so the fast ones read more
+            // morsels. Otherwise, each driver reads morsels from its own queue, split from the whole queue.
+            std::vector<MorselQueuePtr> morsel_queue_per_driver;
+            if (auto cache_ctx = _fragment_ctx->query_cache_context(source_id); cache_ctx != nullptr) {
+                morsel_queue_per_driver = cache_ctx->lane_morsel_queues();
+            } else if (shared_morsel_queue_ids.count(source_id) > 0) {
+                morsel_queue_per_driver.assign(degree_of_parallelism, morsel_queue);
+            } else {
+                morsel_queue_per_driver = morsel_queue->split_by_size(degree_of_parallelism);
+            }
             DCHECK(morsel_queue_per_driver.size() == degree_of_parallelism);
 
             if (is_root) {
@@ -11,13 +11,15 @@ HashJoinBuildOperator::HashJoinBuildOperator(OperatorFactory* factory, int32_t i
                                              int32_t plan_node_id, HashJoinerPtr join_builder,
                                              const std::vector<HashJoinerPtr>& read_only_join_probers,
                                              size_t driver_sequence, PartialRuntimeFilterMerger* partial_rf_merger,
-                                             const TJoinDistributionMode::type distribution_mode)
+                                             const TJoinDistributionMode::type distribution_mode,
+                                             HashJoinerFactory* hash_joiner_factory)
         : Operator(factory, id, name, plan_node_id),
           _join_builder(std::move(join_builder)),
           _read_only_join_probers(read_only_join_probers),
           _driver_sequence(driver_sequence),
           _partial_rf_merger(partial_rf_merger),
-          _distribution_mode(distribution_mode) {}
+          _distribution_mode(distribution_mode),
+          _hash_joiner_factory(hash_joiner_factory) {}
 
 Status HashJoinBuildOperator::push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) {
     return _join_builder->append_chunk_to_ht(state, chunk);
@@ -30,6 +32,14 @@ Status HashJoinBuildOperator::prepare(RuntimeState* state) {
     for (auto& read_only_join_prober : _read_only_join_probers) {
         read_only_join_prober->ref();
     }
+    if (_hash_joiner_factory->is_parallel_build()) {
+        // The sub hash tables of the other builders are referenced by the last finished builder.
+        for (auto& join_builder : _hash_joiner_factory->get_hash_joiners()) {
+            if (join_builder != _join_builder) {
+                join_builder->ref();
+            }
+        }
+    }
 
     RETURN_IF_ERROR(_join_builder->prepare_builder(state, _unique_metrics.get()));
 
@@ -39,6 +49,13 @@ void HashJoinBuildOperator::close(RuntimeState* state) {
     for (auto& read_only_join_prober : _read_only_join_probers) {
         read_only_join_prober->unref(state);
     }
+    if (_hash_joiner_factory->is_parallel_build()) {
+        for (auto& join_builder : _hash_joiner_factory->get_hash_joiners()) {
+            if (join_builder != _join_builder) {
+                join_builder->unref(state);
+            }
+        }
+    }
     _join_builder->unref(state);
 
     Operator::close(state);
@@ -55,8 +72,9 @@ void HashJoinBuildOperator::set_finishing(RuntimeState* state) {
     _join_builder->build_ht(state);
 
     size_t merger_index = _driver_sequence;
-    // Broadcast Join only has one build operator.
-    DCHECK(_distribution_mode != TJoinDistributionMode::BROADCAST || _driver_sequence == 0);
+    // Broadcast Join only has one build operator, unless it's built in parallel.
+    DCHECK(_distribution_mode != TJoinDistributionMode::BROADCAST || _hash_joiner_factory->is_parallel_build() ||
+           _driver_sequence == 0);
 
     _join_builder->create_runtime_filters(state);
 
@@ -80,6 +98,18 @@ void HashJoinBuildOperator::set_finishing(RuntimeState* state) {
                                                                    std::move(in_filters), std::move(bloom_filters)));
     }
 
+    if (_hash_joiner_factory->is_parallel_build()) {
+        // The probers could not start until all the sub hash tables are built.
+        if (_hash_joiner_factory->finish_parallel_build()) {
+            const auto& join_builders = _hash_joiner_factory->get_hash_joiners();
+            HashJoiner::share_parallel_built_hash_tables(state, join_builders);
+            for (auto& join_builder : join_builders) {
+                join_builder->enter_probe_phase();
+            }
+        }
+        return;
+    }
+
     for (auto& read_only_join_prober : _read_only_join_probers) {
         read_only_join_prober->reference_hash_table(_join_builder.get());
     }
@@ -112,7 +142,8 @@ OperatorPtr HashJoinBuildOperatorFactory::create(int32_t degree_of_parallelism,
     return std::make_shared<HashJoinBuildOperator>(this, _id, _name, _plan_node_id,
                                                    _hash_joiner_factory->create_builder(driver_sequence),
                                                    _hash_joiner_factory->get_read_only_probers(), driver_sequence,
-                                                   _partial_rf_merger.get(), _distribution_mode);
+                                                   _partial_rf_merger.get(), _distribution_mode,
+                                                   _hash_joiner_factory.get());
 }
 
 } // namespace pipeline
@@ -23,7 +23,7 @@ public:
     HashJoinBuildOperator(OperatorFactory* factory, int32_t id, const string& name, int32_t plan_node_id,
                           HashJoinerPtr join_builder, const std::vector<HashJoinerPtr>& only_probers,
                           size_t driver_sequence, PartialRuntimeFilterMerger* partial_rf_merger,
-                          TJoinDistributionMode::type distribution_mode);
+                          TJoinDistributionMode::type distribution_mode, HashJoinerFactory* hash_joiner_factory);
     ~HashJoinBuildOperator() override = default;
 
     Status prepare(RuntimeState* state) override;
@@ -55,6 +55,7 @@ private:
     bool _is_finished = false;
 
     const TJoinDistributionMode::type _distribution_mode;
+    HashJoinerFactory* _hash_joiner_factory;
 };
 
 class HashJoinBuildOperatorFactory final : public OperatorFactory {
@@ -31,6 +31,8 @@ public:
     void set_finished(RuntimeState* state) override;
 
     bool is_ready() const override;
+
+    std::vector<Observable*> observables() override { return {&_join_prober->observable()}; }
     std::string get_name() const override {
         return strings::Substitute("$0(HashJoiner=$1)", Operator::get_name(), _join_prober.get());
     }
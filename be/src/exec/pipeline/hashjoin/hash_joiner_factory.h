@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <vector>
 
@@ -18,7 +19,8 @@ using HashJoinerFactoryPtr = std::shared_ptr<HashJoinerFactory>;
 
 class HashJoinerFactory {
 public:
-    HashJoinerFactory(starrocks::vectorized::HashJoinerParam& param, int dop) : _param(param), _hash_joiners(dop) {}
+    HashJoinerFactory(starrocks::vectorized::HashJoinerParam& param, int dop)
+            : _param(param), _hash_joiners(dop), _num_unfinished_builders(dop) {}
 
     Status prepare(RuntimeState* state);
     void close(RuntimeState* state);
@@ -37,7 +39,7 @@ public:
     }
 
     HashJoinerPtr create_builder(int driver_sequence) {
-        if (_param._distribution_mode == TJoinDistributionMode::BROADCAST) {
+        if (_param._distribution_mode == TJoinDistributionMode::BROADCAST && !_param._is_parallel_build) {
             driver_sequence = BROADCAST_BUILD_DRIVER_SEQUENCE;
         }
         if (!_hash_joiners[driver_sequence]) {
@@ -49,12 +51,20 @@ public:
     }
 
     bool is_buildable(int driver_sequence) const {
-        return _param._distribution_mode != TJoinDistributionMode::BROADCAST ||
+        return _param._distribution_mode != TJoinDistributionMode::BROADCAST || _param._is_parallel_build ||
                driver_sequence == BROADCAST_BUILD_DRIVER_SEQUENCE;
     }
 
     const HashJoiners& get_read_only_probers() const { return _read_only_probers; }
 
+    // In the parallel build of broadcast join, every HashJoiner builds the sub hash table of one hash partition
+    // of the build side, and probes all the sub hash tables.
+    bool is_parallel_build() const { return _param._is_parallel_build; }
+    const HashJoiners& get_hash_joiners() const { return _hash_joiners; }
+    // Called by each HashJoinBuildOperator of the parallel build when its sub hash table is built,
+    // return true for the last one.
+    bool finish_parallel_build() { return _num_unfinished_builders.fetch_sub(1) == 1; }
+
 private:
     // Broadcast join need only create one hash table, because all the HashJoinProbeOperators
     // use the same hash table with their own different probe states.
@@ -63,6 +73,7 @@ private:
     starrocks::vectorized::HashJoinerParam _param;
     HashJoiners _hash_joiners;
     HashJoiners _read_only_probers;
+    std::atomic<int> _num_unfinished_builders;
 };
 
 } // namespace pipeline
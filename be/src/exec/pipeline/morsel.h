@@ -6,6 +6,7 @@
 
 #include "gen_cpp/InternalService_types.h"
 #include "storage/olap_common.h"
+#include "storage/vectorized/tablet_reader_params.h"
 
 namespace starrocks {
 namespace pipeline {
@@ -13,7 +14,8 @@ class Morsel;
 using MorselPtr = std::unique_ptr<Morsel>;
 using Morsels = std::vector<MorselPtr>;
 class MorselQueue;
-using MorselQueuePtr = std::unique_ptr<MorselQueue>;
+// MorselQueue may be shared by all the drivers of a pipeline.
+using MorselQueuePtr = std::shared_ptr<MorselQueue>;
 using MorselQueueMap = std::unordered_map<int32_t, MorselQueuePtr>;
 
 class Morsel {
@@ -32,14 +34,25 @@ public:
         _scan_range = std::make_unique<TScanRange>(scan_range.scan_range);
     }
 
+    ScanMorsel(int32_t plan_node_id, const TScanRange& scan_range, std::vector<vectorized::RowsetSplit> rowset_splits)
+            : Morsel(plan_node_id),
+              _scan_range(std::make_unique<TScanRange>(scan_range)),
+              _rowset_splits(std::move(rowset_splits)) {}
+
     TScanRange* get_scan_range() { return _scan_range.get(); }
 
     TInternalScanRange* get_olap_scan_range() { return &(_scan_range->internal_scan_range); }
 
     THdfsScanRange* get_hdfs_scan_range() { return &(_scan_range->hdfs_scan_range); }
 
+    // The parts of the tablet to read, which are captured when splitting the olap scan range.
+    // Empty means that the morsel isn't split, and the whole tablet is read.
+    const std::vector<vectorized::RowsetSplit>& rowset_splits() const { return _rowset_splits; }
+    bool has_rowset_splits() const { return !_rowset_splits.empty(); }
+
 private:
     std::unique_ptr<TScanRange> _scan_range;
+    std::vector<vectorized::RowsetSplit> _rowset_splits;
 };
 
 class MorselQueue {
@@ -0,0 +1,32 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "exec/pipeline/observable.h"
+
+#include <algorithm>
+
+#include "exec/pipeline/pipeline_driver.h"
+
+namespace starrocks::pipeline {
+
+void Observable::add_observer(PipelineDriver* driver) {
+    std::lock_guard<std::mutex> l(_mutex);
+    _observers.push_back(driver);
+}
+
+void Observable::remove_observer(PipelineDriver* driver) {
+    std::lock_guard<std::mutex> l(_mutex);
+    auto it = std::find(_observers.begin(), _observers.end(), driver);
+    if (it != _observers.end()) {
+        *it = _observers.back();
+        _observers.pop_back();
+    }
+}
+
+void Observable::notify_observers() {
+    std::lock_guard<std::mutex> l(_mutex);
+    for (auto* driver : _observers) {
+        driver->notify_event();
+    }
+}
+
+} // namespace starrocks::pipeline
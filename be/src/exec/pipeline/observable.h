@@ -0,0 +1,37 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <mutex>
+#include <vector>
+
+namespace starrocks::pipeline {
+
+class PipelineDriver;
+
+// Observable is owned by an object which blocked drivers wait on, such as DataStreamRecvr,
+// SinkBuffer, LocalExchangeMemoryManager and the contexts shared by join operators.
+// A driver registers itself as an observer, and the owner calls notify_observers() when
+// its state changes in a way that may unblock the observers, e.g. new chunks arrive, or
+// in-flight RPCs complete. PipelineDriverPoller parks drivers blocked on observables and
+// puts them back to the driver queue on notification, instead of spinning on them.
+class Observable {
+public:
+    Observable() = default;
+    ~Observable() = default;
+
+    Observable(const Observable&) = delete;
+    Observable& operator=(const Observable&) = delete;
+
+    void add_observer(PipelineDriver* driver);
+    // After remove_observer returns, |driver| will not be notified by this observable anymore.
+    void remove_observer(PipelineDriver* driver);
+
+    void notify_observers();
+
+private:
+    std::mutex _mutex;
+    std::vector<PipelineDriver*> _observers;
+};
+
+} // namespace starrocks::pipeline
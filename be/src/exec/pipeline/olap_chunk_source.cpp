@@ -93,6 +93,8 @@ void OlapChunkSource::_init_counter(RuntimeState* state) {
     _seg_init_timer = ADD_TIMER(_scan_profile, "SegmentInit");
     _bi_filter_timer = ADD_CHILD_TIMER(_scan_profile, "BitmapIndexFilter", "SegmentInit");
     _bi_filtered_counter = ADD_CHILD_COUNTER(_scan_profile, "BitmapIndexFilterRows", TUnit::UNIT, "SegmentInit");
+    _ii_filter_timer = ADD_CHILD_TIMER(_scan_profile, "InvertedIndexFilter", "SegmentInit");
+    _ii_filtered_counter = ADD_CHILD_COUNTER(_scan_profile, "InvertedIndexFilterRows", TUnit::UNIT, "SegmentInit");
     _bf_filtered_counter = ADD_CHILD_COUNTER(_scan_profile, "BloomFilterFilterRows", TUnit::UNIT, "SegmentInit");
     _zm_filtered_counter = ADD_CHILD_COUNTER(_scan_profile, "ZoneMapIndexFilterRows", TUnit::UNIT, "SegmentInit");
     _sk_filtered_counter = ADD_CHILD_COUNTER(_scan_profile, "ShortKeyFilterRows", TUnit::UNIT, "SegmentInit");
@@ -105,7 +107,10 @@ void OlapChunkSource::_init_counter(RuntimeState* state) {
     _block_seek_counter = ADD_CHILD_COUNTER(_scan_profile, "BlockSeekCount", TUnit::UNIT, "SegmentRead");
     _pred_filter_timer = ADD_CHILD_TIMER(_scan_profile, "PredFilter", "SegmentRead");
     _pred_filter_counter = ADD_CHILD_COUNTER(_scan_profile, "PredFilterRows", TUnit::UNIT, "SegmentRead");
+    _pred_filter_encoded_counter =
+            ADD_CHILD_COUNTER(_scan_profile, "PredFilterEncodedRows", TUnit::UNIT, "PredFilterRows");
     _del_vec_filter_counter = ADD_CHILD_COUNTER(_scan_profile, "DelVecFilterRows", TUnit::UNIT, "SegmentRead");
+    _rf_filter_counter = ADD_CHILD_COUNTER(_scan_profile, "RuntimeFilterRows", TUnit::UNIT, "SegmentRead");
     _chunk_copy_timer = ADD_CHILD_TIMER(_scan_profile, "ChunkCopy", "SegmentRead");
     _decompress_timer = ADD_CHILD_TIMER(_scan_profile, "DecompressT", "SegmentRead");
     _index_load_timer = ADD_CHILD_TIMER(_scan_profile, "IndexLoad", "SegmentRead");
@@ -113,6 +118,10 @@ void OlapChunkSource::_init_counter(RuntimeState* state) {
     _segments_read_count = ADD_CHILD_COUNTER(_scan_profile, "SegmentsReadCount", TUnit::UNIT, "SegmentRead");
     _total_columns_data_page_count =
             ADD_CHILD_COUNTER(_scan_profile, "TotalColumnsDataPageCount", TUnit::UNIT, "SegmentRead");
+    _prefetch_io_counter = ADD_CHILD_COUNTER(_scan_profile, "PrefetchIOCount", TUnit::UNIT, "SegmentRead");
+    _prefetch_io_saved_counter = ADD_CHILD_COUNTER(_scan_profile, "PrefetchIOSaved", TUnit::UNIT, "SegmentRead");
+    _prefetch_bytes_counter = ADD_CHILD_COUNTER(_scan_profile, "PrefetchBytes", TUnit::BYTES, "SegmentRead");
+    _prefetch_hit_bytes_counter = ADD_CHILD_COUNTER(_scan_profile, "PrefetchHitBytes", TUnit::BYTES, "SegmentRead");
 
     // IOTime
     _io_timer = ADD_TIMER(_scan_profile, "IOTime");
@@ -185,6 +194,14 @@ Status OlapChunkSource::_init_reader_params(const std::vector<OlapScanRange*>& k
         _predicate_free_pool.emplace_back(std::move(p));
     }
 
+    if (config::enable_storage_runtime_filter) {
+        _conjuncts_manager.get_runtime_filter_predicates(_tablet->tablet_schema(), *_params.global_dictmaps,
+                                                         &_runtime_filter_preds);
+        for (const auto& p : _runtime_filter_preds) {
+            _params.runtime_filter_preds.push_back(p.get());
+        }
+    }
+
     {
         vectorized::ConjunctivePredicatesRewriter not_pushdown_predicate_rewriter(_not_push_down_predicates,
                                                                                   *_params.global_dictmaps);
@@ -278,7 +295,13 @@ Status OlapChunkSource::_init_olap_reader(RuntimeState* runtime_state) {
     const TabletSchema& tablet_schema = _tablet->tablet_schema();
     starrocks::vectorized::Schema child_schema =
             ChunkHelper::convert_schema_to_format_v2(tablet_schema, reader_columns);
-    _reader = std::make_shared<TabletReader>(_tablet, Version(0, _version), std::move(child_schema));
+    auto* scan_morsel = down_cast<ScanMorsel*>(_morsel.get());
+    if (scan_morsel->has_rowset_splits()) {
+        _reader = std::make_shared<TabletReader>(_tablet, Version(0, _version), std::move(child_schema),
+                                                 scan_morsel->rowset_splits());
+    } else {
+        _reader = std::make_shared<TabletReader>(_tablet, Version(0, _version), std::move(child_schema));
+    }
     if (reader_columns.size() == scanner_columns.size()) {
         _prj_iter = _reader;
     } else {
@@ -450,6 +473,7 @@ void OlapChunkSource::close(RuntimeState* state) {
     _prj_iter->close();
     _reader.reset();
     _predicate_free_pool.clear();
+    _runtime_filter_preds.clear();
     _dict_optimize_parser.close(state);
 }
 
@@ -488,7 +512,9 @@ void OlapChunkSource::_update_counter() {
 
     COUNTER_UPDATE(_pred_filter_timer, _reader->stats().vec_cond_evaluate_ns);
     COUNTER_UPDATE(_pred_filter_counter, _reader->stats().rows_vec_cond_filtered);
+    COUNTER_UPDATE(_pred_filter_encoded_counter, _reader->stats().rows_encoded_pred_filtered);
     COUNTER_UPDATE(_del_vec_filter_counter, _reader->stats().rows_del_vec_filtered);
+    COUNTER_UPDATE(_rf_filter_counter, _reader->stats().rows_runtime_filter_filtered);
 
     COUNTER_UPDATE(_zm_filtered_counter, _reader->stats().rows_stats_filtered);
     COUNTER_UPDATE(_bf_filtered_counter, _reader->stats().rows_bf_filtered);
@@ -500,11 +526,18 @@ void OlapChunkSource::_update_counter() {
 
     COUNTER_UPDATE(_bi_filtered_counter, _reader->stats().rows_bitmap_index_filtered);
     COUNTER_UPDATE(_bi_filter_timer, _reader->stats().bitmap_index_filter_timer);
+    COUNTER_UPDATE(_ii_filtered_counter, _reader->stats().rows_inverted_index_filtered);
+    COUNTER_UPDATE(_ii_filter_timer, _reader->stats().inverted_index_filter_timer);
     COUNTER_UPDATE(_block_seek_counter, _reader->stats().block_seek_num);
 
     COUNTER_UPDATE(_rowsets_read_count, _reader->stats().rowsets_read_count);
     COUNTER_UPDATE(_segments_read_count, _reader->stats().segments_read_count);
     COUNTER_UPDATE(_total_columns_data_page_count, _reader->stats().total_columns_data_page_count);
+    COUNTER_UPDATE(_prefetch_io_counter, _reader->stats().prefetch_io_count);
+    COUNTER_UPDATE(_prefetch_io_saved_counter,
+                   _reader->stats().prefetch_hit_pages - _reader->stats().prefetch_io_count);
+    COUNTER_UPDATE(_prefetch_bytes_counter, _reader->stats().prefetch_bytes);
+    COUNTER_UPDATE(_prefetch_hit_bytes_counter, _reader->stats().prefetch_hit_bytes);
 
     COUNTER_SET(_pushdown_predicates_counter, (int64_t)_params.predicates.size());
 
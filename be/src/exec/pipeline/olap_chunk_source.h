@@ -106,6 +106,7 @@ private:
     // For release memory.
     using PredicatePtr = std::unique_ptr<vectorized::ColumnPredicate>;
     std::vector<PredicatePtr> _predicate_free_pool;
+    std::vector<std::unique_ptr<vectorized::RuntimeFilterPredicate>> _runtime_filter_preds;
 
     // slot descriptors for each one of |output_columns|.
     std::vector<SlotDescriptor*> _query_slots;
@@ -131,7 +132,9 @@ private:
     RuntimeProfile::Counter* _read_uncompressed_counter = nullptr;
     RuntimeProfile::Counter* _raw_rows_counter = nullptr;
     RuntimeProfile::Counter* _pred_filter_counter = nullptr;
+    RuntimeProfile::Counter* _pred_filter_encoded_counter = nullptr;
     RuntimeProfile::Counter* _del_vec_filter_counter = nullptr;
+    RuntimeProfile::Counter* _rf_filter_counter = nullptr;
     RuntimeProfile::Counter* _pred_filter_timer = nullptr;
     RuntimeProfile::Counter* _chunk_copy_timer = nullptr;
     RuntimeProfile::Counter* _seg_init_timer = nullptr;
@@ -148,10 +151,16 @@ private:
     RuntimeProfile::Counter* _cached_pages_num_counter = nullptr;
     RuntimeProfile::Counter* _bi_filtered_counter = nullptr;
     RuntimeProfile::Counter* _bi_filter_timer = nullptr;
+    RuntimeProfile::Counter* _ii_filtered_counter = nullptr;
+    RuntimeProfile::Counter* _ii_filter_timer = nullptr;
     RuntimeProfile::Counter* _pushdown_predicates_counter = nullptr;
     RuntimeProfile::Counter* _rowsets_read_count = nullptr;
     RuntimeProfile::Counter* _segments_read_count = nullptr;
     RuntimeProfile::Counter* _total_columns_data_page_count = nullptr;
+    RuntimeProfile::Counter* _prefetch_io_counter = nullptr;
+    RuntimeProfile::Counter* _prefetch_io_saved_counter = nullptr;
+    RuntimeProfile::Counter* _prefetch_bytes_counter = nullptr;
+    RuntimeProfile::Counter* _prefetch_hit_bytes_counter = nullptr;
 };
 } // namespace pipeline
 } // namespace starrocks
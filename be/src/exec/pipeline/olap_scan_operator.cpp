@@ -47,34 +47,45 @@ Status OlapScanOperator::do_prepare(RuntimeState*) {
 
 void OlapScanOperator::do_close(RuntimeState*) {}
 
+static StatusOr<TabletSharedPtr> get_tablet(const TInternalScanRange* scan_range) {
+    TTabletId tablet_id = scan_range->tablet_id;
+    std::string err;
+    TabletSharedPtr tablet = StorageEngine::instance()->tablet_manager()->get_tablet(tablet_id, true, &err);
+    if (!tablet) {
+        std::stringstream ss;
+        SchemaHash schema_hash = strtoul(scan_range->schema_hash.c_str(), nullptr, 10);
+        ss << "failed to get tablet. tablet_id=" << tablet_id << ", with schema_hash=" << schema_hash
+           << ", reason=" << err;
+        LOG(WARNING) << ss.str();
+        return Status::InternalError(ss.str());
+    }
+    return tablet;
+}
+
+Status capture_tablet_rowsets(const TInternalScanRange* scan_range, TabletSharedPtr* tablet,
+                              std::vector<RowsetSharedPtr>* rowsets) {
+    // Get version.
+    int64_t version = strtoul(scan_range->version.c_str(), nullptr, 10);
+
+    // Get tablet.
+    ASSIGN_OR_RETURN(*tablet, get_tablet(scan_range));
+
+    // Capture row sets of this version tablet.
+    std::shared_lock l((*tablet)->get_header_lock());
+    return (*tablet)->capture_consistent_rowsets(Version(0, version), rowsets);
+}
+
 Status OlapScanOperator::_capture_tablet_rowsets() {
     const auto& morsels = this->morsel_queue()->morsels();
     _tablet_rowsets.resize(morsels.size());
     for (int i = 0; i < morsels.size(); ++i) {
         ScanMorsel* scan_morsel = (ScanMorsel*)morsels[i].get();
-        auto* scan_range = scan_morsel->get_olap_scan_range();
-
-        // Get version.
-        int64_t version = strtoul(scan_range->version.c_str(), nullptr, 10);
-
-        // Get tablet.
-        TTabletId tablet_id = scan_range->tablet_id;
-        std::string err;
-        TabletSharedPtr tablet = StorageEngine::instance()->tablet_manager()->get_tablet(tablet_id, true, &err);
-        if (!tablet) {
-            std::stringstream ss;
-            SchemaHash schema_hash = strtoul(scan_range->schema_hash.c_str(), nullptr, 10);
-            ss << "failed to get tablet. tablet_id=" << tablet_id << ", with schema_hash=" << schema_hash
-               << ", reason=" << err;
-            LOG(WARNING) << ss.str();
-            return Status::InternalError(ss.str());
-        }
-
-        // Capture row sets of this version tablet.
-        {
-            std::shared_lock l(tablet->get_header_lock());
-            RETURN_IF_ERROR(tablet->capture_consistent_rowsets(Version(0, version), &_tablet_rowsets[i]));
+        // The rowsets of a split morsel are referenced by the morsel itself.
+        if (scan_morsel->has_rowset_splits()) {
+            continue;
         }
+        TabletSharedPtr tablet;
+        RETURN_IF_ERROR(capture_tablet_rowsets(scan_morsel->get_olap_scan_range(), &tablet, &_tablet_rowsets[i]));
     }
 
     return Status::OK();
@@ -85,4 +96,68 @@ ChunkSourcePtr OlapScanOperator::create_chunk_source(MorselPtr morsel) {
     return std::make_shared<OlapChunkSource>(std::move(morsel), this, olap_scan_node);
 }
 
+// ==================== split_olap_scan_morsels ====================
+
+StatusOr<Morsels> split_olap_scan_morsels(const vectorized::OlapScanNode* scan_node, Morsels morsels,
+                                          int64_t split_rows) {
+    DCHECK_GT(split_rows, 0);
+    // Rows of different segments are merged when reading the tablets of AGG_KEYS or UNIQUE_KEYS
+    // tables with aggregation, so these tablets cannot be split.
+    const bool skip_aggregation = scan_node->thrift_olap_scan_node().is_preaggregation;
+
+    Morsels split_morsels;
+    for (auto& morsel : morsels) {
+        auto* scan_morsel = down_cast<ScanMorsel*>(morsel.get());
+        TabletSharedPtr tablet;
+        std::vector<RowsetSharedPtr> rowsets;
+        RETURN_IF_ERROR(capture_tablet_rowsets(scan_morsel->get_olap_scan_range(), &tablet, &rowsets));
+        const KeysType keys_type = tablet->keys_type();
+        const bool can_split = keys_type == DUP_KEYS || keys_type == PRIMARY_KEYS || skip_aggregation;
+
+        const size_t num_prev_morsels = split_morsels.size();
+        std::vector<vectorized::RowsetSplit> splits;
+        int64_t num_split_rows = 0;
+        auto add_split_morsel = [&]() {
+            split_morsels.emplace_back(std::make_unique<ScanMorsel>(
+                    scan_morsel->get_plan_node_id(), *scan_morsel->get_scan_range(), std::move(splits)));
+            splits.clear();
+            num_split_rows = 0;
+        };
+
+        for (auto& rowset : rowsets) {
+            const auto num_segments = static_cast<uint32_t>(rowset->num_segments());
+            if (num_segments == 0) {
+                continue;
+            }
+            if (!can_split) {
+                splits.push_back({rowset, 0, num_segments});
+                continue;
+            }
+            // The segments of a rowset are assumed to have the same number of rows.
+            const int64_t segment_rows = std::max<int64_t>(1, rowset->num_rows() / num_segments);
+            uint32_t segment_begin = 0;
+            for (uint32_t i = 0; i < num_segments; ++i) {
+                num_split_rows += segment_rows;
+                if (num_split_rows >= split_rows) {
+                    splits.push_back({rowset, segment_begin, i + 1});
+                    segment_begin = i + 1;
+                    add_split_morsel();
+                }
+            }
+            if (segment_begin < num_segments) {
+                splits.push_back({rowset, segment_begin, num_segments});
+            }
+        }
+        if (!splits.empty()) {
+            add_split_morsel();
+        }
+
+        // Keep the original morsel for the tablet without any segment.
+        if (split_morsels.size() == num_prev_morsels) {
+            split_morsels.emplace_back(std::move(morsel));
+        }
+    }
+    return split_morsels;
+}
+
 } // namespace starrocks::pipeline
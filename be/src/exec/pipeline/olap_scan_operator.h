@@ -11,6 +11,10 @@ class ScanNode;
 class Rowset;
 using RowsetSharedPtr = std::shared_ptr<Rowset>;
 
+namespace vectorized {
+class OlapScanNode;
+}
+
 }; // namespace starrocks
 
 namespace starrocks::pipeline {
@@ -46,4 +50,14 @@ private:
     std::vector<std::vector<RowsetSharedPtr>> _tablet_rowsets;
 };
 
+// Capture the rowsets of the tablet of |scan_range| at the version to read.
+Status capture_tablet_rowsets(const TInternalScanRange* scan_range, TabletSharedPtr* tablet,
+                              std::vector<RowsetSharedPtr>* rowsets);
+
+// Split the morsels of |scan_node| by the rowsets and segments of their tablets, so that each morsel reads
+// about |split_rows| rows, and a large tablet could be read by multiple scan operators in parallel.
+// The rowsets are captured here and referenced by the result morsels, see ScanMorsel::rowset_splits().
+StatusOr<Morsels> split_olap_scan_morsels(const vectorized::OlapScanNode* scan_node, Morsels morsels,
+                                          int64_t split_rows);
+
 } // namespace starrocks::pipeline
@@ -19,6 +19,7 @@ class RuntimeState;
 using RuntimeFilterProbeCollector = starrocks::vectorized::RuntimeFilterProbeCollector;
 
 namespace pipeline {
+class Observable;
 class Operator;
 class OperatorFactory;
 using OperatorPtr = std::shared_ptr<Operator>;
@@ -93,6 +94,13 @@ public:
     // Only source and sink operator may return true, and other operators always return false.
     virtual bool pending_finish() const { return false; }
 
+    // observables returns the objects which notify their observers whenever the result of has_output(),
+    // need_input(), is_finished() or OperatorWithDependency::is_ready() of this operator may change.
+    // A driver blocked on an operator with observables is parked by PipelineDriverPoller and woken up
+    // by the notification, instead of being polled repeatedly.
+    // An empty result means the operator can only be polled.
+    virtual std::vector<Observable*> observables() { return {}; }
+
     // Pull chunk from this operator
     // Use shared_ptr, because in some cases (local broadcast exchange),
     // the chunk need to be shared
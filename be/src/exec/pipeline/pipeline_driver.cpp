@@ -3,10 +3,12 @@
 
 #include "exec/pipeline/pipeline_driver.h"
 
+#include <algorithm>
 #include <sstream>
 
 #include "column/chunk.h"
 #include "exec/pipeline/pipeline_driver_executor.h"
+#include "exec/pipeline/pipeline_driver_poller.h"
 #include "exec/pipeline/source_operator.h"
 #include "exec/workgroup/work_group.h"
 #include "runtime/exec_env.h"
@@ -298,6 +300,8 @@ void PipelineDriver::finalize(RuntimeState* runtime_state, DriverState state) {
     VLOG_ROW << "[Driver] finalize, driver=" << this;
     DCHECK(state == DriverState::FINISH || state == DriverState::CANCELED || state == DriverState::INTERNAL_ERROR);
 
+    // Observables may be destroyed along with the operators, so stop observing them before closing operators.
+    _unregister_observables();
     _close_operators(runtime_state);
 
     set_driver_state(state);
@@ -332,6 +336,47 @@ void PipelineDriver::finalize(RuntimeState* runtime_state, DriverState state) {
     }
 }
 
+void PipelineDriver::notify_event() {
+    _num_events.fetch_add(1);
+    if (auto* poller = _parked_poller.exchange(nullptr); poller != nullptr) {
+        poller->wake_up_driver(this);
+    }
+}
+
+void PipelineDriver::_register_observables() {
+    if (_is_observables_registered) {
+        return;
+    }
+    _is_observables_registered = true;
+
+    auto register_operator = [this](Operator* op) {
+        auto observables = op->observables();
+        for (auto* observable : observables) {
+            if (std::find(_observables.begin(), _observables.end(), observable) == _observables.end()) {
+                observable->add_observer(this);
+                _observables.emplace_back(observable);
+            }
+        }
+        return !observables.empty();
+    };
+    _is_source_observable = register_operator(source_operator());
+    _is_sink_observable = register_operator(sink_operator());
+    _is_dependencies_observable = true;
+    for (auto* dep : _dependencies) {
+        _is_dependencies_observable &= register_operator(dep);
+    }
+}
+
+void PipelineDriver::_unregister_observables() {
+    for (auto* observable : _observables) {
+        observable->remove_observer(this);
+    }
+    _observables.clear();
+    _is_source_observable = false;
+    _is_sink_observable = false;
+    _is_dependencies_observable = false;
+}
+
 void PipelineDriver::_update_overhead_timer() {
     int64_t overhead_time = _active_timer->value();
     RuntimeProfile* profile = _runtime_profile.get();
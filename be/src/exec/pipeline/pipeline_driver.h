@@ -9,6 +9,7 @@
 #include "common/statusor.h"
 #include "exec/pipeline/fragment_context.h"
 #include "exec/pipeline/morsel.h"
+#include "exec/pipeline/observable.h"
 #include "exec/pipeline/operator.h"
 #include "exec/pipeline/operator_with_dependency.h"
 #include "exec/pipeline/pipeline_fwd.h"
@@ -23,6 +24,7 @@ namespace starrocks {
 namespace pipeline {
 
 class PipelineDriver;
+class PipelineDriverPoller;
 using DriverPtr = std::shared_ptr<PipelineDriver>;
 using Drivers = std::vector<DriverPtr>;
 
@@ -334,6 +336,25 @@ public:
     // Check whether an operator can be short-circuited, when is_precondition_block() becomes false from true.
     void check_short_circuit();
 
+    // Called by the observables of the operators when their states change, see Operator::observables().
+    // It may be invoked by any thread, e.g. brpc threads that receive chunks.
+    void notify_event();
+    uint64_t num_events() const { return _num_events.load(); }
+    // Whether the driver blocked in current state will be notified by observables once it may be unblocked,
+    // so that PipelineDriverPoller needn't poll it.
+    bool is_blocked_by_observables() const {
+        switch (_state) {
+        case DriverState::INPUT_EMPTY:
+            return _is_source_observable;
+        case DriverState::OUTPUT_FULL:
+            return _is_sink_observable;
+        case DriverState::PRECONDITION_BLOCK:
+            return _is_dependencies_observable && _local_rf_holders.empty() && _global_rf_descriptors.empty();
+        default:
+            return false;
+        }
+    }
+
     bool is_root() const { return _is_root; }
 
     std::string to_readable_string() const;
@@ -360,6 +381,10 @@ private:
     void _mark_operator_cancelled(OperatorPtr& op, RuntimeState* runtime_state);
     void _mark_operator_closed(OperatorPtr& op, RuntimeState* runtime_state);
     void _close_operators(RuntimeState* runtime_state);
+    // Register this driver to the observables of its operators, it is called by PipelineDriverPoller
+    // the first time it parks the driver, and the observers are removed in finalize().
+    void _register_observables();
+    void _unregister_observables();
 
     // Update metrics when the driver yields.
     void _update_statistics(size_t total_chunks_moved, size_t total_rows_moved, size_t time_spent) {
@@ -405,6 +430,18 @@ private:
     // The index of QuerySharedDriverQueue{WithoutLock}._queues which this driver belongs to.
     size_t _driver_queue_level = 0;
 
+    // Observables of the operators this driver registered to.
+    std::vector<Observable*> _observables;
+    bool _is_observables_registered = false;
+    bool _is_source_observable = false;
+    bool _is_sink_observable = false;
+    bool _is_dependencies_observable = false;
+    // Increased by every notification, used by PipelineDriverPoller to detect events missed
+    // between checking the driver and parking it.
+    std::atomic<uint64_t> _num_events{0};
+    // The poller which parks this driver, nullptr if the driver isn't parked.
+    std::atomic<PipelineDriverPoller*> _parked_poller{nullptr};
+
     // metrics
     RuntimeProfile::Counter* _total_timer = nullptr;
     RuntimeProfile::Counter* _active_timer = nullptr;
@@ -2,17 +2,28 @@
 
 #include "exec/pipeline/pipeline_driver_executor.h"
 
+#include "common/config.h"
 #include "gutil/strings/substitute.h"
 #include "runtime/current_thread.h"
 #include "util/defer_op.h"
 
 namespace starrocks::pipeline {
 
+static std::unique_ptr<DriverQueue> create_driver_queue(bool enable_resource_group, int num_workers) {
+    if (enable_resource_group) {
+        // The workgroup with the minimum vruntime is picked among all the ready workgroups,
+        // which needs a global view, so the workgroups are always scheduled by one queue.
+        return std::make_unique<DriverQueueWithWorkGroup>();
+    }
+    if (config::enable_pipeline_work_stealing_driver_queue) {
+        return std::make_unique<WorkStealingDriverQueue>(std::max(1, num_workers));
+    }
+    return std::make_unique<QuerySharedDriverQueue>();
+}
+
 GlobalDriverExecutor::GlobalDriverExecutor(std::unique_ptr<ThreadPool> thread_pool, bool enable_resource_group)
         : _enable_resource_group(enable_resource_group),
-          _driver_queue(enable_resource_group
-                                ? std::unique_ptr<DriverQueue>(std::make_unique<DriverQueueWithWorkGroup>())
-                                : std::make_unique<QuerySharedDriverQueue>()),
+          _driver_queue(create_driver_queue(enable_resource_group, thread_pool->max_threads())),
           _thread_pool(std::move(thread_pool)),
           _blocked_driver_poller(new PipelineDriverPoller(_driver_queue.get())),
           _exec_state_reporter(new ExecStateReporter()) {}
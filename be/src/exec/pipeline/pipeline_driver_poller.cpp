@@ -3,6 +3,10 @@
 #include "pipeline_driver_poller.h"
 
 #include <chrono>
+
+#include "common/config.h"
+#include "util/time.h"
+
 namespace starrocks::pipeline {
 
 void PipelineDriverPoller::start() {
@@ -30,14 +34,31 @@ void PipelineDriverPoller::run_internal() {
     typeof(this->_blocked_drivers) local_blocked_drivers;
     int spin_count = 0;
     std::vector<DriverRawPtr> ready_drivers;
+    int64_t last_parked_check_ns = MonotonicNanos();
     while (!_is_shutdown.load(std::memory_order_acquire)) {
+        const bool enable_event_driven = config::enable_pipeline_event_driven_poller;
+        if (!_parked_drivers.empty()) {
+            const int64_t now = MonotonicNanos();
+            if (!enable_event_driven ||
+                now - last_parked_check_ns >= config::pipeline_poller_parked_driver_check_interval_ms * 1000000L) {
+                _unpark_all_drivers(local_blocked_drivers);
+                last_parked_check_ns = now;
+            }
+        }
+
         {
             std::unique_lock<std::mutex> lock(this->_mutex);
             local_blocked_drivers.splice(local_blocked_drivers.end(), _blocked_drivers);
+            _unpark_woken_drivers(local_blocked_drivers);
             if (local_blocked_drivers.empty() && _blocked_drivers.empty()) {
                 std::cv_status cv_status = std::cv_status::no_timeout;
-                while (!_is_shutdown.load(std::memory_order_acquire) && this->_blocked_drivers.empty()) {
+                while (!_is_shutdown.load(std::memory_order_acquire) && this->_blocked_drivers.empty() &&
+                       this->_woken_drivers.empty()) {
                     cv_status = _cond.wait_for(lock, std::chrono::milliseconds(10));
+                    // Parked drivers should be checked periodically.
+                    if (cv_status == std::cv_status::timeout && !_parked_drivers.empty()) {
+                        break;
+                    }
                 }
                 if (cv_status == std::cv_status::timeout) {
                     continue;
@@ -46,12 +67,16 @@ void PipelineDriverPoller::run_internal() {
                     break;
                 }
                 local_blocked_drivers.splice(local_blocked_drivers.end(), _blocked_drivers);
+                _unpark_woken_drivers(local_blocked_drivers);
             }
         }
 
         auto driver_it = local_blocked_drivers.begin();
         while (driver_it != local_blocked_drivers.end()) {
             auto* driver = *driver_it;
+            // Read the number of events before checking the driver, so that the events arriving
+            // during checking are not missed when parking the driver.
+            const uint64_t num_events = driver->num_events();
 
             if (driver->query_ctx()->is_expired()) {
                 // there are not any drivers belonging to a query context can make progress for an expiration period
@@ -105,6 +130,9 @@ void PipelineDriverPoller::run_internal() {
                 driver->set_driver_state(DriverState::READY);
                 remove_blocked_driver(local_blocked_drivers, driver_it);
                 ready_drivers.emplace_back(driver);
+            } else if (enable_event_driven && _try_park_driver(driver, num_events)) {
+                // The parked driver isn't unblocked yet, so its pending timer isn't updated.
+                local_blocked_drivers.erase(driver_it++);
             } else {
                 ++driver_it;
             }
@@ -147,4 +175,50 @@ void PipelineDriverPoller::remove_blocked_driver(DriverList& local_blocked_drive
     local_blocked_drivers.erase(driver_it++);
 }
 
+void PipelineDriverPoller::wake_up_driver(const DriverRawPtr driver) {
+    std::unique_lock<std::mutex> lock(this->_mutex);
+    this->_woken_drivers.push_back(driver);
+    this->_cond.notify_one();
+}
+
+bool PipelineDriverPoller::_try_park_driver(const DriverRawPtr driver, uint64_t num_events) {
+    if (!driver->_is_observables_registered) {
+        // The events arriving before registration are not counted, so the driver must be checked
+        // once more before parked.
+        driver->_register_observables();
+        return false;
+    }
+    if (!driver->is_blocked_by_observables()) {
+        return false;
+    }
+
+    driver->_parked_poller.store(this);
+    if (driver->num_events() != num_events && driver->_parked_poller.exchange(nullptr) != nullptr) {
+        // Some events arrive after checking the driver, check it again.
+        return false;
+    }
+    // If _parked_poller has been taken by notify_event(), the driver is woken up by
+    // _unpark_woken_drivers() in the next round.
+    _parked_drivers.insert(driver);
+    return true;
+}
+
+void PipelineDriverPoller::_unpark_woken_drivers(DriverList& local_blocked_drivers) {
+    for (auto* driver : _woken_drivers) {
+        // The driver may be unparked by _unpark_all_drivers() already.
+        if (_parked_drivers.erase(driver) > 0) {
+            local_blocked_drivers.push_back(driver);
+        }
+    }
+    _woken_drivers.clear();
+}
+
+void PipelineDriverPoller::_unpark_all_drivers(DriverList& local_blocked_drivers) {
+    for (auto* driver : _parked_drivers) {
+        driver->_parked_poller.store(nullptr);
+        local_blocked_drivers.push_back(driver);
+    }
+    _parked_drivers.clear();
+}
+
 } // namespace starrocks::pipeline
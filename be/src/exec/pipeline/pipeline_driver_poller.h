@@ -7,6 +7,8 @@
 #include <list>
 #include <memory>
 #include <mutex>
+#include <unordered_set>
+#include <vector>
 
 #include "pipeline_driver.h"
 #include "pipeline_driver_queue.h"
@@ -36,9 +38,19 @@ public:
     void add_blocked_driver(const DriverRawPtr driver);
     // remove blocked driver from poller
     void remove_blocked_driver(DriverList& local_blocked_drivers, DriverList::iterator& driver_it);
+    // wake up a parked driver, it is called by PipelineDriver::notify_event() from any thread.
+    void wake_up_driver(const DriverRawPtr driver);
 
 private:
     void run_internal();
+    // Park the driver blocked on observables, return false if the driver should be still polled.
+    // |num_events| is the number of events of the driver before checking whether it is blocked.
+    bool _try_park_driver(const DriverRawPtr driver, uint64_t num_events);
+    // Move the woken drivers from _parked_drivers to |local_blocked_drivers|, _mutex must be held.
+    void _unpark_woken_drivers(DriverList& local_blocked_drivers);
+    // Move all the parked drivers to |local_blocked_drivers|, so that the drivers of the canceled or
+    // expired queries could be handled even if no event arrives.
+    void _unpark_all_drivers(DriverList& local_blocked_drivers);
     PipelineDriverPoller(const PipelineDriverPoller&) = delete;
     PipelineDriverPoller& operator=(const PipelineDriverPoller&) = delete;
 
@@ -46,6 +58,10 @@ private:
     std::mutex _mutex;
     std::condition_variable _cond;
     DriverList _blocked_drivers;
+    // Drivers woken up by their observables, guarded by _mutex.
+    std::vector<DriverRawPtr> _woken_drivers;
+    // Drivers blocked on observables and not polled, only accessed by the polling thread.
+    std::unordered_set<DriverRawPtr> _parked_drivers;
     DriverQueue* _driver_queue;
     scoped_refptr<Thread> _polling_thread;
     std::atomic<bool> _is_polling_thread_initialized;
@@ -180,6 +180,136 @@ int QuerySharedDriverQueueWithoutLock::_compute_driver_level(const DriverRawPtr
     return QUEUE_SIZE - 1;
 }
 
+// The local queue of the executor thread which is running, -1 means the current thread isn't an executor thread.
+static thread_local int tls_local_queue_idx = -1;
+
+WorkStealingDriverQueue::WorkStealingDriverQueue(size_t num_local_queues) {
+    DCHECK_GT(num_local_queues, 0);
+    _local_queues.reserve(num_local_queues);
+    for (size_t i = 0; i < num_local_queues; ++i) {
+        _local_queues.emplace_back(std::make_unique<LocalQueue>());
+    }
+}
+
+void WorkStealingDriverQueue::close() {
+    std::lock_guard<std::mutex> lock(_idle_mutex);
+    _is_closed = true;
+    _idle_cv.notify_all();
+}
+
+void WorkStealingDriverQueue::put_back(const DriverRawPtr driver) {
+    _put_back(_next_queue_idx(), driver);
+}
+
+void WorkStealingDriverQueue::put_back(const std::vector<DriverRawPtr>& drivers) {
+    for (const auto driver : drivers) {
+        _put_back(_next_queue_idx(), driver);
+    }
+}
+
+void WorkStealingDriverQueue::put_back_from_executor(const DriverRawPtr driver) {
+    if (tls_local_queue_idx < 0) {
+        put_back(driver);
+        return;
+    }
+    _put_back(tls_local_queue_idx, driver);
+}
+
+void WorkStealingDriverQueue::put_back_from_executor(const std::vector<DriverRawPtr>& drivers) {
+    for (const auto driver : drivers) {
+        put_back_from_executor(driver);
+    }
+}
+
+StatusOr<DriverRawPtr> WorkStealingDriverQueue::take(int worker_id) {
+    const size_t self_idx = worker_id % _local_queues.size();
+    tls_local_queue_idx = self_idx;
+
+    while (true) {
+        if (_is_closed) {
+            return Status::Cancelled("Shutdown");
+        }
+
+        DriverRawPtr driver = _take_from(self_idx, true);
+        if (driver == nullptr) {
+            driver = _steal(self_idx);
+        }
+        if (driver != nullptr) {
+            return driver;
+        }
+
+        std::unique_lock<std::mutex> lock(_idle_mutex);
+        // _num_idle_workers must be increased before checking _num_drivers, and _put_back() increases _num_drivers
+        // before checking _num_idle_workers, so either this worker sees the new driver or it will be notified.
+        _num_idle_workers++;
+        while (_num_drivers.load() == 0 && !_is_closed) {
+            _idle_cv.wait(lock);
+        }
+        _num_idle_workers--;
+    }
+}
+
+void WorkStealingDriverQueue::update_statistics(const DriverRawPtr driver) {
+    // The driver is executed by the current executor thread, so the time is accounted to its local queue.
+    int queue_idx = tls_local_queue_idx >= 0 ? tls_local_queue_idx : 0;
+    _local_queues[queue_idx]->queue.update_statistics(driver);
+}
+
+void WorkStealingDriverQueue::_put_back(size_t queue_idx, const DriverRawPtr driver) {
+    auto& local_queue = *_local_queues[queue_idx];
+    {
+        std::lock_guard<std::mutex> lock(local_queue.mutex);
+        local_queue.queue.put_back(driver);
+        local_queue.num_drivers++;
+    }
+    _num_drivers++;
+
+    if (_num_idle_workers.load() > 0) {
+        std::lock_guard<std::mutex> lock(_idle_mutex);
+        _idle_cv.notify_one();
+    }
+}
+
+DriverRawPtr WorkStealingDriverQueue::_take_from(size_t queue_idx, bool wait_lock) {
+    auto& local_queue = *_local_queues[queue_idx];
+    if (local_queue.num_drivers.load() == 0) {
+        return nullptr;
+    }
+
+    std::unique_lock<std::mutex> lock(local_queue.mutex, std::defer_lock);
+    if (wait_lock) {
+        lock.lock();
+    } else if (!lock.try_lock()) {
+        return nullptr;
+    }
+    if (local_queue.queue.size() == 0) {
+        return nullptr;
+    }
+    // QuerySharedDriverQueueWithoutLock::take always returns a driver when it isn't empty.
+    DriverRawPtr driver = local_queue.queue.take(queue_idx).value();
+    local_queue.num_drivers--;
+    _num_drivers--;
+    return driver;
+}
+
+DriverRawPtr WorkStealingDriverQueue::_steal(size_t self_idx) {
+    const size_t num_queues = _local_queues.size();
+    // Try to lock the victims at first, to avoid contending with their owners. And if there are still ready
+    // drivers, wait for the locks at the second round.
+    for (bool wait_lock : {false, true}) {
+        for (size_t i = 1; i < num_queues; ++i) {
+            DriverRawPtr driver = _take_from((self_idx + i) % num_queues, wait_lock);
+            if (driver != nullptr) {
+                return driver;
+            }
+        }
+        if (_num_drivers.load() == 0) {
+            break;
+        }
+    }
+    return nullptr;
+}
+
 void DriverQueueWithWorkGroup::close() {
     std::lock_guard<std::mutex> lock(_global_mutex);
     _is_closed = true;
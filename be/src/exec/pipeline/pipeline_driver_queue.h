@@ -163,6 +163,63 @@ private:
     size_t _size = 0;
 };
 
+// WorkStealingDriverQueue spreads the ready drivers among the local queues of the executor threads,
+// instead of keeping them in one queue guarded by a global lock.
+// Each local queue is a multi-level feedback queue with the same levels and time slices as QuerySharedDriverQueue.
+// An executor thread puts the driver it yields back to its own local queue, and takes drivers from its own
+// local queue first. When the local queue is empty, it steals a driver from the other local queues,
+// and only waits when there is no ready driver in any local queue.
+class WorkStealingDriverQueue : public FactoryMethod<DriverQueue, WorkStealingDriverQueue> {
+    friend class FactoryMethod<DriverQueue, WorkStealingDriverQueue>;
+
+public:
+    // The worker |worker_id| owns the local queue |worker_id % num_local_queues|.
+    explicit WorkStealingDriverQueue(size_t num_local_queues);
+    ~WorkStealingDriverQueue() override = default;
+    void close() override;
+
+    // The drivers put back from the other threads, e.g. the poller, are distributed round-robin.
+    void put_back(const DriverRawPtr driver) override;
+    void put_back(const std::vector<DriverRawPtr>& drivers) override;
+    // The drivers put back from an executor thread go to the local queue of this thread.
+    void put_back_from_executor(const DriverRawPtr driver) override;
+    void put_back_from_executor(const std::vector<DriverRawPtr>& drivers) override;
+
+    // Return cancelled status, if the queue is closed.
+    StatusOr<DriverRawPtr> take(int worker_id) override;
+
+    void update_statistics(const DriverRawPtr driver) override;
+
+    size_t size() override { return _num_drivers.load(); }
+
+    size_t num_local_queues() const { return _local_queues.size(); }
+
+private:
+    struct LocalQueue {
+        std::mutex mutex;
+        QuerySharedDriverQueueWithoutLock queue;
+        // The same as queue.size(), but could be read without the lock.
+        std::atomic<size_t> num_drivers = 0;
+    };
+
+    void _put_back(size_t queue_idx, const DriverRawPtr driver);
+    // Return nullptr if the local queue is empty, or it is locked by others and |wait_lock| is false.
+    DriverRawPtr _take_from(size_t queue_idx, bool wait_lock);
+    DriverRawPtr _steal(size_t self_idx);
+    size_t _next_queue_idx() { return _next_round_robin_idx.fetch_add(1) % _local_queues.size(); }
+
+    std::vector<std::unique_ptr<LocalQueue>> _local_queues;
+    std::atomic<size_t> _next_round_robin_idx = 0;
+    // The number of drivers in all the local queues.
+    std::atomic<size_t> _num_drivers = 0;
+
+    // Only used to park and wake up the idle executor threads.
+    std::mutex _idle_mutex;
+    std::condition_variable _idle_cv;
+    std::atomic<int> _num_idle_workers = 0;
+    std::atomic<bool> _is_closed = false;
+};
+
 // DriverQueueWithWorkGroup contains two levels of queues.
 // The first level is the work group queue, and the second level is the driver queue in a work group.
 class DriverQueueWithWorkGroup : public FactoryMethod<DriverQueue, DriverQueueWithWorkGroup> {
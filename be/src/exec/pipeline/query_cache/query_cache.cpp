@@ -0,0 +1,287 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "exec/pipeline/query_cache/query_cache.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+#include "column/chunk.h"
+#include "common/config.h"
+#include "exec/pipeline/olap_scan_operator.h"
+#include "gen_cpp/PlanNodes_types.h"
+#include "gutil/casts.h"
+#include "runtime/current_thread.h"
+#include "runtime/descriptors.h"
+#include "runtime/exec_env.h"
+#include "runtime/runtime_state.h"
+#include "storage/rowset/rowset.h"
+#include "storage/tablet.h"
+#include "util/defer_op.h"
+#include "util/md5.h"
+#include "util/starrocks_metrics.h"
+#include "util/thrift_util.h"
+
+namespace starrocks::pipeline {
+
+// ==================== QueryCache ====================
+
+QueryCache* QueryCache::_s_instance = nullptr;
+
+void QueryCache::create_global_cache(MemTracker* mem_tracker, size_t capacity) {
+    if (_s_instance == nullptr) {
+        _s_instance = new QueryCache(mem_tracker, capacity);
+    }
+}
+
+void QueryCache::release_global_cache() {
+    if (_s_instance != nullptr) {
+        delete _s_instance;
+        _s_instance = nullptr;
+    }
+}
+
+QueryCache::QueryCache(MemTracker* mem_tracker, size_t capacity)
+        : _mem_tracker(mem_tracker), _capacity(capacity), _cache(new_lru_cache(capacity)) {
+    REGISTER_GAUGE_STARROCKS_METRIC(query_cache_usage_bytes, [this]() { return memory_usage(); });
+    REGISTER_GAUGE_STARROCKS_METRIC(query_cache_capacity_bytes, [this]() { return _capacity; });
+}
+
+QueryCache::~QueryCache() {
+    StarRocksMetrics::instance()->metrics()->deregister_hook("query_cache_usage_bytes");
+    StarRocksMetrics::instance()->metrics()->deregister_hook("query_cache_capacity_bytes");
+}
+
+std::string QueryCache::_encode_key(const std::string& digest, int64_t tablet_id) {
+    std::string key(digest);
+    key.append((const char*)&tablet_id, sizeof(tablet_id));
+    return key;
+}
+
+std::optional<QueryCacheValue> QueryCache::lookup(const std::string& digest, int64_t tablet_id) {
+    auto* handle = _cache->lookup(_encode_key(digest, tablet_id));
+    if (handle == nullptr) {
+        return {};
+    }
+    // The chunks are immutable, so it's safe to share them after the handle is released.
+    QueryCacheValue value = *reinterpret_cast<QueryCacheValue*>(_cache->value(handle));
+    _cache->release(handle);
+    return value;
+}
+
+void QueryCache::insert(const std::string& digest, int64_t tablet_id, QueryCacheValue value) {
+    size_t charge = 0;
+    for (const auto& chunk : value.chunks) {
+        charge += chunk->memory_usage();
+    }
+#ifndef BE_TEST
+    // The chunks are owned by the cache from now on.
+    tls_thread_status.mem_release(charge);
+    MemTracker* prev_tracker = tls_thread_status.set_mem_tracker(_mem_tracker);
+    tls_thread_status.mem_consume(charge);
+    DeferOp op([&] { tls_thread_status.set_mem_tracker(prev_tracker); });
+#endif
+
+    auto deleter = [](const starrocks::CacheKey& key, void* value) {
+#ifndef BE_TEST
+        MemTracker* prev_tracker =
+                tls_thread_status.set_mem_tracker(ExecEnv::GetInstance()->query_cache_mem_tracker());
+        DeferOp op([&] { tls_thread_status.set_mem_tracker(prev_tracker); });
+#endif
+        delete reinterpret_cast<QueryCacheValue*>(value);
+    };
+
+    auto* cache_value = new QueryCacheValue(std::move(value));
+    auto* handle = _cache->insert(_encode_key(digest, tablet_id), cache_value, charge, deleter);
+    _cache->release(handle);
+}
+
+// ==================== QueryCacheContext ====================
+
+static bool has_nondeterministic_function(const TExpr& expr) {
+    static const std::unordered_set<std::string> nondeterministic_functions = {
+            "rand",    "random",       "uuid",           "now",          "current_timestamp", "localtime",
+            "curdate", "current_date", "curtime",        "current_time", "utc_timestamp",     "localtimestamp",
+            "sleep",   "user",         "unix_timestamp", "database",     "connection_id",     "current_user"};
+    for (const auto& node : expr.nodes) {
+        if (node.__isset.fn && nondeterministic_functions.count(node.fn.name.function_name) > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool has_nondeterministic_function(const TPlanNode& node) {
+    std::vector<const TExpr*> exprs;
+    for (const auto& expr : node.conjuncts) {
+        exprs.push_back(&expr);
+    }
+    if (node.__isset.agg_node) {
+        for (const auto& expr : node.agg_node.grouping_exprs) {
+            exprs.push_back(&expr);
+        }
+        for (const auto& expr : node.agg_node.aggregate_functions) {
+            exprs.push_back(&expr);
+        }
+    }
+    if (node.__isset.project_node) {
+        for (const auto& [_, expr] : node.project_node.slot_map) {
+            exprs.push_back(&expr);
+        }
+        for (const auto& [_, expr] : node.project_node.common_slot_map) {
+            exprs.push_back(&expr);
+        }
+    }
+    return std::any_of(exprs.begin(), exprs.end(),
+                       [](const TExpr* expr) { return has_nondeterministic_function(*expr); });
+}
+
+// Return the index of the olap scan node in |plan|, if the plan is a first phase aggregation over
+// an olap scan, with only projects and filters in between. Otherwise, return -1.
+static int find_cacheable_scan_node(const TPlan& plan) {
+    const auto& nodes = plan.nodes;
+    if (nodes.size() < 2) {
+        return -1;
+    }
+    const auto& agg_node = nodes[0];
+    if (agg_node.node_type != TPlanNodeType::AGGREGATION_NODE || agg_node.agg_node.need_finalize ||
+        agg_node.agg_node.aggregate_functions.empty()) {
+        return -1;
+    }
+    // The nodes are in pre-order, so the plan is a chain if every node except the last has one child.
+    for (int i = 0; i < nodes.size(); ++i) {
+        const auto& node = nodes[i];
+        // The result depends on the runtime filters or the limit, besides the data of the tablet.
+        if (!node.probe_runtime_filters.empty() || node.limit != -1 || has_nondeterministic_function(node)) {
+            return -1;
+        }
+        if (i == nodes.size() - 1) {
+            return node.node_type == TPlanNodeType::OLAP_SCAN_NODE && node.num_children == 0 ? i : -1;
+        }
+        if (node.num_children != 1) {
+            return -1;
+        }
+        if (i > 0 && node.node_type != TPlanNodeType::PROJECT_NODE && node.node_type != TPlanNodeType::SELECT_NODE) {
+            return -1;
+        }
+    }
+    return -1;
+}
+
+static StatusOr<std::string> compute_plan_digest(RuntimeState* state, const TPlan& plan, const DescriptorTbl& desc_tbl,
+                                                 const TOlapScanNode& scan_node) {
+    Md5Digest digest;
+    ThriftSerializer serializer(true, 4096);
+    for (const auto& node : plan.nodes) {
+        TPlanNode copy = node;
+        uint8_t* buffer = nullptr;
+        uint32_t len = 0;
+        RETURN_IF_ERROR(serializer.serialize(&copy, &len, &buffer));
+        digest.update(buffer, len);
+    }
+    // The plan refers to the columns by slot ids, which are bound to the columns here.
+    const TupleDescriptor* tuple_desc = desc_tbl.get_tuple_descriptor(scan_node.tuple_id);
+    if (tuple_desc == nullptr) {
+        return Status::InternalError("failed to get tuple descriptor of olap scan node");
+    }
+    for (const auto* slot : tuple_desc->slots()) {
+        std::string slot_digest =
+                std::to_string(slot->id()) + ":" + slot->col_name() + ":" + slot->type().debug_string() + ";";
+        digest.update(slot_digest.data(), slot_digest.size());
+    }
+    digest.update(state->timezone().data(), state->timezone().size());
+    digest.digest();
+    return digest.hex();
+}
+
+// Return the rowsets of the tablet added after |cached_version|, or nothing if the cached result of
+// the tablet cannot be reused, e.g. the rows of the new rowsets are merged with the old ones when read.
+static StatusOr<std::optional<std::vector<vectorized::RowsetSplit>>> capture_delta_rowsets(
+        const TOlapScanNode& scan_node, const TInternalScanRange* scan_range, int64_t cached_version) {
+    TabletSharedPtr tablet;
+    std::vector<RowsetSharedPtr> rowsets;
+    RETURN_IF_ERROR(capture_tablet_rowsets(scan_range, &tablet, &rowsets));
+    const KeysType keys_type = tablet->keys_type();
+    if (keys_type != DUP_KEYS && (keys_type == PRIMARY_KEYS || !scan_node.is_preaggregation)) {
+        return std::nullopt;
+    }
+    std::vector<vectorized::RowsetSplit> splits;
+    for (auto& rowset : rowsets) {
+        if (rowset->end_version() <= cached_version) {
+            continue;
+        }
+        // The rowset is compacted across the cached version, or deletes the rows of the cached version.
+        if (rowset->start_version() <= cached_version || rowset->rowset_meta()->has_delete_predicate()) {
+            return std::nullopt;
+        }
+        const auto num_segments = static_cast<uint32_t>(rowset->num_segments());
+        if (num_segments > 0) {
+            splits.push_back({rowset, 0, num_segments});
+        }
+    }
+    return splits;
+}
+
+StatusOr<QueryCacheContextPtr> QueryCacheContext::create(RuntimeState* state, const TPlan& plan,
+                                                         const DescriptorTbl& desc_tbl, Morsels* morsels) {
+    if (!config::enable_query_cache || QueryCache::instance() == nullptr || morsels->empty() ||
+        morsels->size() > config::query_cache_max_tablets_per_fragment) {
+        return nullptr;
+    }
+    const int scan_index = find_cacheable_scan_node(plan);
+    if (scan_index < 0) {
+        return nullptr;
+    }
+    const auto& scan_node = plan.nodes[scan_index];
+    DCHECK_EQ(scan_node.node_id, (*morsels)[0]->get_plan_node_id());
+    ASSIGN_OR_RETURN(auto digest, compute_plan_digest(state, plan, desc_tbl, scan_node.olap_scan_node));
+
+    auto ctx = std::make_shared<QueryCacheContext>(std::move(digest), scan_node.node_id, plan.nodes[0].node_id);
+    for (auto& morsel : *morsels) {
+        RETURN_IF_ERROR(ctx->_add_lane(scan_node.olap_scan_node, std::move(morsel)));
+    }
+    morsels->clear();
+    return ctx;
+}
+
+Status QueryCacheContext::_add_lane(const TOlapScanNode& scan_node, MorselPtr morsel) {
+    auto* scan_morsel = down_cast<ScanMorsel*>(morsel.get());
+    const auto* scan_range = scan_morsel->get_olap_scan_range();
+
+    QueryCacheLane lane;
+    lane.tablet_id = scan_range->tablet_id;
+    lane.version = strtol(scan_range->version.c_str(), nullptr, 10);
+    lane.populate = true;
+
+    Morsels lane_morsels;
+    auto cached = QueryCache::instance()->lookup(_digest, lane.tablet_id);
+    if (cached.has_value() && cached->version == lane.version) {
+        lane.cached_chunks = std::move(cached->chunks);
+        lane.populate = false;
+        StarRocksMetrics::instance()->query_cache_hit_total.increment(1);
+    } else if (cached.has_value() && cached->version < lane.version) {
+        ASSIGN_OR_RETURN(auto delta_splits, capture_delta_rowsets(scan_node, scan_range, cached->version));
+        if (delta_splits.has_value()) {
+            // Only the new rowsets are read, and their result is output with the cached one.
+            lane.cached_chunks = std::move(cached->chunks);
+            if (!delta_splits->empty()) {
+                lane_morsels.emplace_back(std::make_unique<ScanMorsel>(
+                        morsel->get_plan_node_id(), *scan_morsel->get_scan_range(), std::move(*delta_splits)));
+            }
+            StarRocksMetrics::instance()->query_cache_partial_hit_total.increment(1);
+        } else {
+            lane_morsels.emplace_back(std::move(morsel));
+            StarRocksMetrics::instance()->query_cache_miss_total.increment(1);
+        }
+    } else {
+        // Don't replace the result cached by a query on a newer version.
+        lane.populate = !cached.has_value();
+        lane_morsels.emplace_back(std::move(morsel));
+        StarRocksMetrics::instance()->query_cache_miss_total.increment(1);
+    }
+
+    _lanes.emplace_back(std::move(lane));
+    _lane_morsel_queues.emplace_back(std::make_shared<MorselQueue>(std::move(lane_morsels)));
+    return Status::OK();
+}
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,114 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "column/vectorized_fwd.h"
+#include "common/statusor.h"
+#include "exec/pipeline/morsel.h"
+#include "storage/lru_cache.h"
+
+namespace starrocks {
+
+class DescriptorTbl;
+class MemTracker;
+class RuntimeState;
+class TOlapScanNode;
+class TPlan;
+
+namespace pipeline {
+
+// The partial aggregation result of a tablet at a version, which is cached by QueryCache.
+struct QueryCacheValue {
+    int64_t version = 0;
+    std::vector<vectorized::ChunkPtr> chunks;
+};
+
+// QueryCache is a per-BE LRU cache of the partial aggregation results of olap scan fragments.
+// An entry is keyed on (plan digest, tablet id), and records the version of the tablet it is
+// computed at, so a later query on a newer version could reuse it and only aggregate the
+// rowsets added after the cached version. The chunks are immutable once cached.
+class QueryCache {
+public:
+    // Create global instance of this class
+    static void create_global_cache(MemTracker* mem_tracker, size_t capacity);
+
+    static void release_global_cache();
+
+    // Return global instance.
+    // Client should call create_global_cache before.
+    static QueryCache* instance() { return _s_instance; }
+
+    QueryCache(MemTracker* mem_tracker, size_t capacity);
+    ~QueryCache();
+
+    std::optional<QueryCacheValue> lookup(const std::string& digest, int64_t tablet_id);
+
+    // Replace the cached result of |tablet_id|, if any.
+    void insert(const std::string& digest, int64_t tablet_id, QueryCacheValue value);
+
+    size_t memory_usage() const { return _cache->get_memory_usage(); }
+    size_t capacity() const { return _capacity; }
+
+private:
+    static std::string _encode_key(const std::string& digest, int64_t tablet_id);
+
+    static QueryCache* _s_instance;
+
+    MemTracker* _mem_tracker = nullptr;
+    const size_t _capacity;
+    std::unique_ptr<Cache> _cache;
+};
+
+// A lane is the part of a cacheable fragment that reads one tablet, and is executed by one driver of the
+// scan pipeline, so that the result of the driver's aggregator is the partial aggregation of the tablet.
+struct QueryCacheLane {
+    int64_t tablet_id = 0;
+    // The version read by the query.
+    int64_t version = 0;
+    // The cached result output before the result of the aggregator, which is empty if not hit.
+    std::vector<vectorized::ChunkPtr> cached_chunks;
+    // Whether the result of the lane is inserted into the cache, after all the chunks are output.
+    bool populate = false;
+};
+
+// QueryCacheContext is created for a fragment which is a first phase aggregation (whose result
+// is merged by the downstream fragment) over an olap scan, with only projects and filters in between.
+// It's shared by the scan node and the aggregation node of the fragment, see FragmentContext::query_cache_context.
+class QueryCacheContext {
+public:
+    // Return nullptr if the fragment isn't cacheable. Otherwise, the morsels of the scan node are moved into the
+    // lanes of the result, in which case the fragment reads the tablets one per driver.
+    static StatusOr<std::shared_ptr<QueryCacheContext>> create(RuntimeState* state, const TPlan& plan,
+                                                               const DescriptorTbl& desc_tbl, Morsels* morsels);
+
+    QueryCacheContext(std::string digest, int32_t scan_node_id, int32_t agg_node_id)
+            : _digest(std::move(digest)), _scan_node_id(scan_node_id), _agg_node_id(agg_node_id) {}
+
+    const std::string& digest() const { return _digest; }
+    int32_t scan_node_id() const { return _scan_node_id; }
+    int32_t agg_node_id() const { return _agg_node_id; }
+
+    size_t num_lanes() const { return _lanes.size(); }
+    QueryCacheLane& lane(size_t i) { return _lanes[i]; }
+    // The morsel queue of each lane, which is empty if the lane is fully served by the cache.
+    std::vector<MorselQueuePtr>& lane_morsel_queues() { return _lane_morsel_queues; }
+
+private:
+    Status _add_lane(const TOlapScanNode& scan_node, MorselPtr morsel);
+
+    const std::string _digest;
+    const int32_t _scan_node_id;
+    const int32_t _agg_node_id;
+    std::vector<QueryCacheLane> _lanes;
+    std::vector<MorselQueuePtr> _lane_morsel_queues;
+};
+
+using QueryCacheContextPtr = std::shared_ptr<QueryCacheContext>;
+
+} // namespace pipeline
+} // namespace starrocks
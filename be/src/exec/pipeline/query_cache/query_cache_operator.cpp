@@ -0,0 +1,70 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "exec/pipeline/query_cache/query_cache_operator.h"
+
+#include "column/chunk.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks::pipeline {
+
+Status QueryCacheOperator::prepare(RuntimeState* state) {
+    RETURN_IF_ERROR(Operator::prepare(state));
+    _num_cached_chunks_counter = ADD_COUNTER(_unique_metrics, "CachedChunks", TUnit::UNIT);
+    _num_result_chunks_counter = ADD_COUNTER(_unique_metrics, "ResultChunks", TUnit::UNIT);
+    COUNTER_SET(_num_cached_chunks_counter, (int64_t)_lane->cached_chunks.size());
+    _populate = _lane->populate;
+    for (const auto& chunk : _lane->cached_chunks) {
+        _result_bytes += chunk->memory_usage();
+    }
+    return Status::OK();
+}
+
+void QueryCacheOperator::set_finishing(RuntimeState* state) {
+    if (_is_finished) {
+        return;
+    }
+    _is_finished = true;
+    // All the result of the aggregator is received, unless the fragment is cancelled.
+    if (_populate && !state->is_cancelled()) {
+        QueryCacheValue value;
+        value.version = _lane->version;
+        value.chunks = _lane->cached_chunks;
+        value.chunks.insert(value.chunks.end(), _result_chunks.begin(), _result_chunks.end());
+        QueryCache::instance()->insert(_cache_ctx->digest(), _lane->tablet_id, std::move(value));
+    }
+    _result_chunks.clear();
+}
+
+void QueryCacheOperator::set_finished(RuntimeState* state) {
+    // The result is incomplete, e.g. a downstream operator has finished early.
+    _is_finished = true;
+    _cur_chunk = nullptr;
+    _num_output_cached_chunks = _lane->cached_chunks.size();
+    _result_chunks.clear();
+}
+
+StatusOr<vectorized::ChunkPtr> QueryCacheOperator::pull_chunk(RuntimeState* state) {
+    if (_num_output_cached_chunks < _lane->cached_chunks.size()) {
+        // The cached chunks are shared with other queries, so output copies of them.
+        vectorized::ChunkPtr chunk = _lane->cached_chunks[_num_output_cached_chunks++]->clone_unique();
+        return chunk;
+    }
+    return std::move(_cur_chunk);
+}
+
+Status QueryCacheOperator::push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) {
+    if (_populate && chunk->num_rows() > 0) {
+        _result_chunks.emplace_back(chunk->clone_unique());
+        _result_bytes += _result_chunks.back()->memory_usage();
+        COUNTER_UPDATE(_num_result_chunks_counter, 1);
+        // The result is too large to be worth caching.
+        if (_result_bytes > QueryCache::instance()->capacity() / 8) {
+            _populate = false;
+            _result_chunks.clear();
+        }
+    }
+    _cur_chunk = chunk;
+    return Status::OK();
+}
+
+} // namespace starrocks::pipeline
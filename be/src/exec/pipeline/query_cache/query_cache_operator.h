@@ -0,0 +1,72 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include "exec/pipeline/operator.h"
+#include "exec/pipeline/query_cache/query_cache.h"
+
+namespace starrocks::pipeline {
+
+// QueryCacheOperator follows the source operator of the aggregation of a cacheable fragment, in the driver
+// of a lane, see QueryCacheContext. It outputs the cached result of the lane, and passes through the result
+// of the aggregator, which are inserted into QueryCache together after the aggregator is finished.
+class QueryCacheOperator final : public Operator {
+public:
+    QueryCacheOperator(OperatorFactory* factory, int32_t id, int32_t plan_node_id, QueryCacheContextPtr cache_ctx,
+                       QueryCacheLane* lane)
+            : Operator(factory, id, "query_cache", plan_node_id), _cache_ctx(std::move(cache_ctx)), _lane(lane) {}
+
+    ~QueryCacheOperator() override = default;
+
+    Status prepare(RuntimeState* state) override;
+
+    bool has_output() const override {
+        return _cur_chunk != nullptr || _num_output_cached_chunks < _lane->cached_chunks.size();
+    }
+
+    bool need_input() const override { return !_is_finished && _cur_chunk == nullptr; }
+
+    bool is_finished() const override { return _is_finished && !has_output(); }
+
+    void set_finishing(RuntimeState* state) override;
+
+    void set_finished(RuntimeState* state) override;
+
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
+
+    Status push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) override;
+
+private:
+    QueryCacheContextPtr _cache_ctx;
+    QueryCacheLane* _lane;
+
+    bool _is_finished = false;
+    vectorized::ChunkPtr _cur_chunk = nullptr;
+    size_t _num_output_cached_chunks = 0;
+    bool _populate = false;
+    size_t _result_bytes = 0;
+    // The result of the aggregator, copied since the output chunks may be modified by the downstream.
+    std::vector<vectorized::ChunkPtr> _result_chunks;
+
+    RuntimeProfile::Counter* _num_cached_chunks_counter = nullptr;
+    RuntimeProfile::Counter* _num_result_chunks_counter = nullptr;
+};
+
+class QueryCacheOperatorFactory final : public OperatorFactory {
+public:
+    QueryCacheOperatorFactory(int32_t id, int32_t plan_node_id, QueryCacheContextPtr cache_ctx)
+            : OperatorFactory(id, "query_cache", plan_node_id), _cache_ctx(std::move(cache_ctx)) {}
+
+    ~QueryCacheOperatorFactory() override = default;
+
+    OperatorPtr create(int32_t degree_of_parallelism, int32_t driver_sequence) override {
+        DCHECK_EQ(degree_of_parallelism, _cache_ctx->num_lanes());
+        return std::make_shared<QueryCacheOperator>(this, _id, _plan_node_id, _cache_ctx,
+                                                    &_cache_ctx->lane(driver_sequence));
+    }
+
+private:
+    QueryCacheContextPtr _cache_ctx;
+};
+
+} // namespace starrocks::pipeline
@@ -71,9 +71,14 @@ public:
         return _desc_tbl;
     }
 
+    // The bytes of the chunks buffered by all the ScanChunkBuffers of this query.
+    std::atomic<int64_t>* scan_chunk_buffer_bytes() { return &_scan_chunk_buffer_bytes; }
+
 private:
     ExecEnv* _exec_env = nullptr;
     TUniqueId _query_id;
+    // Declared before _fragment_mgr, since it's updated by the ScanChunkBuffers destroyed with the fragments.
+    std::atomic<int64_t> _scan_chunk_buffer_bytes = 0;
     std::unique_ptr<FragmentContextManager> _fragment_mgr;
     size_t _total_fragments;
     std::atomic<size_t> _num_fragments;
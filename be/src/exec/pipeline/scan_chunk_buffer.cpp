@@ -0,0 +1,59 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "exec/pipeline/scan_chunk_buffer.h"
+
+#include "column/chunk.h"
+#include "common/logging.h"
+
+namespace starrocks::pipeline {
+
+ScanChunkBuffer::ScanChunkBuffer(size_t max_num_chunks, int64_t max_query_bytes, std::atomic<int64_t>* query_bytes)
+        : _max_num_chunks(max_num_chunks), _max_query_bytes(max_query_bytes), _query_bytes(query_bytes) {
+    DCHECK(_query_bytes != nullptr);
+}
+
+ScanChunkBuffer::~ScanChunkBuffer() {
+    // Release the bytes of the chunks left in the buffer, e.g. when the query is cancelled or reaches the limit.
+    _query_bytes->fetch_sub(_num_bytes.load());
+}
+
+void ScanChunkBuffer::put(vectorized::ChunkPtr chunk) {
+    const int64_t bytes = chunk->memory_usage();
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        _chunks.emplace_back(std::move(chunk), bytes);
+        _num_chunks.fetch_add(1, std::memory_order_release);
+        _num_bytes.fetch_add(bytes, std::memory_order_release);
+    }
+    _query_bytes->fetch_add(bytes);
+}
+
+bool ScanChunkBuffer::try_get(vectorized::ChunkPtr* chunk) {
+    int64_t bytes = 0;
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        if (_chunks.empty()) {
+            return false;
+        }
+        *chunk = std::move(_chunks.front().first);
+        bytes = _chunks.front().second;
+        _chunks.pop_front();
+        _num_chunks.fetch_sub(1, std::memory_order_release);
+        _num_bytes.fetch_sub(bytes, std::memory_order_release);
+    }
+    _query_bytes->fetch_sub(bytes);
+    return true;
+}
+
+bool ScanChunkBuffer::is_full() const {
+    const size_t num_chunks = _num_chunks.load(std::memory_order_acquire);
+    if (num_chunks >= _max_num_chunks) {
+        return true;
+    }
+    // An empty buffer is never full, otherwise the scan may never make progress when the chunks
+    // of the query are buffered by the other scans, e.g. the probe side of a join waiting for the
+    // build side.
+    return num_chunks > 0 && _query_bytes->load(std::memory_order_relaxed) >= _max_query_bytes;
+}
+
+} // namespace starrocks::pipeline
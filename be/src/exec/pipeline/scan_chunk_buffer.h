@@ -0,0 +1,54 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+#include "column/vectorized_fwd.h"
+
+namespace starrocks::pipeline {
+
+// ScanChunkBuffer is a bounded buffer of the chunks read by the io tasks of all the scan operators
+// created from the same ScanOperatorFactory. Any of the operators could output the buffered chunks,
+// so that the chunks read for one operator don't wait for it while the others are idle.
+//
+// The buffer is full if it contains |max_num_chunks| chunks, or it isn't empty and the chunks buffered
+// by all the ScanChunkBuffers of the query exceed |max_query_bytes| bytes. The scan operators don't
+// submit io tasks when the buffer is full, so the bound is exceeded by the running io tasks at most.
+class ScanChunkBuffer {
+public:
+    // |query_bytes| is the bytes of chunks buffered by the query, see QueryContext::scan_chunk_buffer_bytes().
+    ScanChunkBuffer(size_t max_num_chunks, int64_t max_query_bytes, std::atomic<int64_t>* query_bytes);
+    ~ScanChunkBuffer();
+
+    ScanChunkBuffer(const ScanChunkBuffer&) = delete;
+    ScanChunkBuffer& operator=(const ScanChunkBuffer&) = delete;
+
+    void put(vectorized::ChunkPtr chunk);
+
+    // Return false if the buffer is empty.
+    bool try_get(vectorized::ChunkPtr* chunk);
+
+    bool empty() const { return _num_chunks.load(std::memory_order_acquire) == 0; }
+    bool is_full() const;
+
+    size_t num_chunks() const { return _num_chunks.load(std::memory_order_acquire); }
+    int64_t num_bytes() const { return _num_bytes.load(std::memory_order_acquire); }
+
+private:
+    const size_t _max_num_chunks;
+    const int64_t _max_query_bytes;
+    std::atomic<int64_t>* _query_bytes;
+
+    std::mutex _mutex;
+    std::deque<std::pair<vectorized::ChunkPtr, int64_t>> _chunks;
+    std::atomic<size_t> _num_chunks = 0;
+    std::atomic<int64_t> _num_bytes = 0;
+};
+
+using ScanChunkBufferPtr = std::shared_ptr<ScanChunkBuffer>;
+
+} // namespace starrocks::pipeline
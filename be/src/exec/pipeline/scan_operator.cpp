@@ -5,6 +5,7 @@
 #include "column/chunk.h"
 #include "exec/pipeline/limit_operator.h"
 #include "exec/pipeline/pipeline_builder.h"
+#include "exec/pipeline/query_context.h"
 #include "exec/vectorized/olap_scan_node.h"
 #include "exec/workgroup/scan_executor.h"
 #include "exec/workgroup/work_group.h"
@@ -64,6 +65,10 @@ bool ScanOperator::has_output() const {
         return false;
     }
 
+    if (_shared_chunk_buffer != nullptr && !_shared_chunk_buffer->empty()) {
+        return true;
+    }
+
     for (const auto& chunk_source : _chunk_sources) {
         if (chunk_source != nullptr && chunk_source->has_output()) {
             return true;
@@ -109,6 +114,12 @@ bool ScanOperator::is_finished() const {
         return false;
     }
 
+    // The chunks left in the shared buffer may be read by any operator, which are output by
+    // the last unfinished one at least.
+    if (_shared_chunk_buffer != nullptr && !_shared_chunk_buffer->empty()) {
+        return false;
+    }
+
     for (const auto& chunk_source : _chunk_sources) {
         if (chunk_source != nullptr && (chunk_source->has_output() || chunk_source->has_next_chunk())) {
             return false;
@@ -130,6 +141,14 @@ StatusOr<vectorized::ChunkPtr> ScanOperator::pull_chunk(RuntimeState* state) {
         _workgroup->incr_period_ask_chunk_num(1);
     }
 
+    if (_shared_chunk_buffer != nullptr) {
+        vectorized::ChunkPtr chunk;
+        if (_shared_chunk_buffer->try_get(&chunk)) {
+            eval_runtime_bloom_filters(chunk.get());
+            return std::move(chunk);
+        }
+    }
+
     for (auto& chunk_source : _chunk_sources) {
         if (chunk_source != nullptr && chunk_source->has_output()) {
             auto&& chunk = chunk_source->get_next_chunk_from_buffer();
@@ -146,6 +165,10 @@ Status ScanOperator::_try_to_trigger_next_scan(RuntimeState* state) {
     if (_num_running_io_tasks >= MAX_IO_TASKS_PER_OP) {
         return Status::OK();
     }
+    // Back pressure, don't read more chunks until the shared buffer is consumed by the operators.
+    if (_shared_chunk_buffer != nullptr && _shared_chunk_buffer->is_full()) {
+        return Status::OK();
+    }
 
     // Firstly, find the picked-up morsel, whose can commit an io task.
     for (int i = 0; i < MAX_IO_TASKS_PER_OP; ++i) {
@@ -181,6 +204,7 @@ Status ScanOperator::_trigger_next_scan(RuntimeState* state, int chunk_source_in
                         _buffer_size, _is_finished, &num_read_chunks, worker_id, _workgroup);
                 // TODO (by laotan332): More detailed information is needed
                 _workgroup->incr_period_scaned_chunk_num(num_read_chunks);
+                _move_chunks_to_shared_buffer(chunk_source_index);
             }
 
             _num_running_io_tasks--;
@@ -194,6 +218,7 @@ Status ScanOperator::_trigger_next_scan(RuntimeState* state, int chunk_source_in
             {
                 SCOPED_THREAD_LOCAL_MEM_TRACKER_SETTER(state->instance_mem_tracker());
                 _chunk_sources[chunk_source_index]->buffer_next_batch_chunks_blocking(_buffer_size, _is_finished);
+                _move_chunks_to_shared_buffer(chunk_source_index);
             }
 
             _num_running_io_tasks--;
@@ -221,6 +246,19 @@ Status ScanOperator::_trigger_next_scan(RuntimeState* state, int chunk_source_in
     return Status::OK();
 }
 
+void ScanOperator::_move_chunks_to_shared_buffer(int chunk_source_index) {
+    if (_shared_chunk_buffer == nullptr) {
+        return;
+    }
+    auto& chunk_source = _chunk_sources[chunk_source_index];
+    while (chunk_source->has_output()) {
+        auto chunk = chunk_source->get_next_chunk_from_buffer();
+        if (chunk.ok() && chunk.value() != nullptr) {
+            _shared_chunk_buffer->put(std::move(chunk.value()));
+        }
+    }
+}
+
 void ScanOperator::set_workgroup(starrocks::workgroup::WorkGroupPtr wg) {
     _workgroup = wg;
 }
@@ -260,11 +298,23 @@ Status ScanOperatorFactory::prepare(RuntimeState* state) {
     RETURN_IF_ERROR(Expr::prepare(conjunct_ctxs, state));
     RETURN_IF_ERROR(Expr::open(conjunct_ctxs, state));
     RETURN_IF_ERROR(do_prepare(state));
+
+    const size_t dop = degree_of_parallelism();
+    if (_enable_shared_chunk_buffer && config::enable_pipeline_shared_scan_chunk_buffer && dop > 1 &&
+        state->query_ctx() != nullptr) {
+        _shared_chunk_buffer = std::make_shared<ScanChunkBuffer>(dop * config::pipeline_io_buffer_size,
+                                                                 config::pipeline_scan_chunk_buffer_query_max_bytes,
+                                                                 state->query_ctx()->scan_chunk_buffer_bytes());
+    }
     return Status::OK();
 }
 
 OperatorPtr ScanOperatorFactory::create(int32_t degree_of_parallelism, int32_t driver_sequence) {
-    return do_create(degree_of_parallelism, driver_sequence);
+    auto op = do_create(degree_of_parallelism, driver_sequence);
+    if (_shared_chunk_buffer != nullptr) {
+        down_cast<ScanOperator*>(op.get())->set_shared_chunk_buffer(_shared_chunk_buffer);
+    }
+    return op;
 }
 
 void ScanOperatorFactory::close(RuntimeState* state) {
@@ -290,8 +340,13 @@ pipeline::OpFactories decompose_scan_node_to_pipeline(std::shared_ptr<ScanOperat
     auto& morsel_queue = morsel_queues[source_id];
     // ScanOperator's degree_of_parallelism is not more than the number of morsels
     // If table is empty, then morsel size is zero and we still set degree of parallelism to 1
-    const auto degree_of_parallelism =
+    auto degree_of_parallelism =
             std::min<size_t>(std::max<size_t>(1, morsel_queue->num_morsels()), context->degree_of_parallelism());
+    // For a cacheable fragment, each tablet is read by its own driver, see QueryCacheContext.
+    if (auto cache_ctx = context->fragment_context()->query_cache_context(source_id); cache_ctx != nullptr) {
+        degree_of_parallelism = cache_ctx->num_lanes();
+        scan_operator->disable_shared_chunk_buffer();
+    }
     scan_operator->set_degree_of_parallelism(degree_of_parallelism);
     operators.emplace_back(std::move(scan_operator));
     size_t limit = scan_node->limit();
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "exec/pipeline/scan_chunk_buffer.h"
 #include "exec/pipeline/source_operator.h"
 #include "exec/workgroup/work_group_fwd.h"
 
@@ -34,6 +35,9 @@ public:
 
     void set_io_threads(PriorityThreadPool* io_threads) { _io_threads = io_threads; }
     void set_workgroup(workgroup::WorkGroupPtr wg);
+    // The chunks read by io tasks are put into |chunk_buffer| shared with the other scan operators
+    // of the pipeline, instead of the buffers of the chunk sources.
+    void set_shared_chunk_buffer(ScanChunkBufferPtr chunk_buffer) { _shared_chunk_buffer = std::move(chunk_buffer); }
 
     // interface for different scan node
     virtual Status do_prepare(RuntimeState* state) = 0;
@@ -53,6 +57,8 @@ private:
     Status _pickup_morsel(RuntimeState* state, int chunk_source_index);
     Status _trigger_next_scan(RuntimeState* state, int chunk_source_index);
     Status _try_to_trigger_next_scan(RuntimeState* state);
+    // Move the chunks read by the io task into the shared chunk buffer.
+    void _move_chunks_to_shared_buffer(int chunk_source_index);
 
     bool _is_finished = false;
 
@@ -61,6 +67,7 @@ private:
     std::atomic<int> _num_running_io_tasks = 0;
     std::vector<std::atomic<bool>> _is_io_task_running;
     std::vector<ChunkSourcePtr> _chunk_sources;
+    ScanChunkBufferPtr _shared_chunk_buffer = nullptr;
 
     workgroup::WorkGroupPtr _workgroup = nullptr;
 };
@@ -83,8 +90,14 @@ public:
     virtual void do_close(RuntimeState* state) = 0;
     virtual OperatorPtr do_create(int32_t dop, int32_t driver_sequence) = 0;
 
+    // Each operator must output only the chunks it reads itself, e.g. for the lanes of a query cache.
+    void disable_shared_chunk_buffer() { _enable_shared_chunk_buffer = false; }
+
 protected:
     ScanNode* _scan_node;
+    bool _enable_shared_chunk_buffer = true;
+    // Shared by all the operators created by this factory, see ScanOperator::set_shared_chunk_buffer().
+    ScanChunkBufferPtr _shared_chunk_buffer = nullptr;
 };
 
 pipeline::OpFactories decompose_scan_node_to_pipeline(std::shared_ptr<ScanOperatorFactory> factory, ScanNode* scan_node,
@@ -2,12 +2,14 @@
 
 #include "exec/vectorized/aggregate/aggregate_blocking_node.h"
 
+#include "common/config.h"
 #include "exec/pipeline/aggregate/aggregate_blocking_sink_operator.h"
 #include "exec/pipeline/aggregate/aggregate_blocking_source_operator.h"
 #include "exec/pipeline/exchange/exchange_source_operator.h"
 #include "exec/pipeline/limit_operator.h"
 #include "exec/pipeline/operator.h"
 #include "exec/pipeline/pipeline_builder.h"
+#include "exec/pipeline/query_cache/query_cache_operator.h"
 #include "exec/vectorized/aggregator.h"
 #include "runtime/current_thread.h"
 #include "simd/simd.h"
@@ -170,6 +172,7 @@ std::vector<std::shared_ptr<pipeline::OperatorFactory> > AggregateBlockingNode::
     using namespace pipeline;
     OpFactories operators_with_sink = _children[0]->decompose_to_pipeline(context);
     auto& agg_node = _tnode.agg_node;
+    bool use_partitioned_merge = false;
     if (agg_node.need_finalize) {
         // If finalize aggregate with group by clause, then it can be paralized
         if (agg_node.__isset.grouping_exprs && !_tnode.agg_node.grouping_exprs.empty()) {
@@ -189,6 +192,17 @@ std::vector<std::shared_ptr<pipeline::OperatorFactory> > AggregateBlockingNode::
                     need_local_shuffle = false;
                 }
             }
+            // 3. If the input is already processed by multiple drivers, each driver could pre-aggregate its input,
+            // and then merge the intermediate results partitioned by the group by keys in parallel, which avoids
+            // shuffling every input row. Spill and limit need the complete groups in one driver, so they
+            // still go through the local shuffle.
+            size_t input_dop =
+                    down_cast<SourceOperatorFactory*>(operators_with_sink[0].get())->degree_of_parallelism();
+            if (need_local_shuffle && config::enable_pipeline_agg_partitioned_merge && input_dop > 1 &&
+                !agg_node.aggregate_functions.empty() && limit() == -1 && !runtime_state()->enable_spill()) {
+                need_local_shuffle = false;
+                use_partitioned_merge = true;
+            }
             if (need_local_shuffle) {
                 std::vector<ExprContext*> group_by_expr_ctxs;
                 Expr::create_expr_trees(_pool, _tnode.agg_node.grouping_exprs, &group_by_expr_ctxs);
@@ -207,6 +221,9 @@ std::vector<std::shared_ptr<pipeline::OperatorFactory> > AggregateBlockingNode::
 
     // shared by sink operator and source operator
     AggregatorFactoryPtr aggregator_factory = std::make_shared<AggregatorFactory>(_tnode);
+    if (use_partitioned_merge) {
+        aggregator_factory->enable_partitioned_merge(degree_of_parallelism);
+    }
 
     // Create a shared RefCountedRuntimeFilterCollector
     auto&& rc_rf_probe_collector = std::make_shared<RcRfProbeCollector>(2, std::move(this->runtime_filter_collector()));
@@ -226,6 +243,11 @@ std::vector<std::shared_ptr<pipeline::OperatorFactory> > AggregateBlockingNode::
     // so operators_with_source's degree of parallelism must be equal with operators_with_sink's
     source_operator->set_degree_of_parallelism(degree_of_parallelism);
     operators_with_source.push_back(std::move(source_operator));
+    // The result of each driver is the partial aggregation of a tablet, which is cached, see QueryCacheContext.
+    if (auto cache_ctx = context->fragment_context()->query_cache_context(id()); cache_ctx != nullptr) {
+        operators_with_source.emplace_back(
+                std::make_shared<QueryCacheOperatorFactory>(context->next_operator_id(), id(), cache_ctx));
+    }
     if (limit() != -1) {
         operators_with_source.emplace_back(
                 std::make_shared<LimitOperatorFactory>(context->next_operator_id(), id(), limit()));
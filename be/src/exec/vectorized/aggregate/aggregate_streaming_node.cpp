@@ -7,6 +7,7 @@
 #include "exec/pipeline/limit_operator.h"
 #include "exec/pipeline/operator.h"
 #include "exec/pipeline/pipeline_builder.h"
+#include "exec/pipeline/query_cache/query_cache_operator.h"
 #include "runtime/current_thread.h"
 #include "simd/simd.h"
 
@@ -279,6 +280,11 @@ std::vector<std::shared_ptr<pipeline::OperatorFactory> > AggregateStreamingNode:
     // so operators_with_source's degree of parallelism must be equal with operators_with_sink's
     source_operator->set_degree_of_parallelism(degree_of_parallelism);
     operators_with_source.push_back(std::move(source_operator));
+    // The result of each driver is the partial aggregation of a tablet, which is cached, see QueryCacheContext.
+    if (auto cache_ctx = context->fragment_context()->query_cache_context(id()); cache_ctx != nullptr) {
+        operators_with_source.emplace_back(
+                std::make_shared<QueryCacheOperatorFactory>(context->next_operator_id(), id(), cache_ctx));
+    }
     if (limit() != -1) {
         operators_with_source.emplace_back(
                 std::make_shared<LimitOperatorFactory>(context->next_operator_id(), id(), limit()));
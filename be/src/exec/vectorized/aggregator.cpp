@@ -4,6 +4,7 @@
 
 #include <algorithm>
 
+#include "common/config.h"
 #include "common/status.h"
 #include "exprs/anyval_util.h"
 #include "gen_cpp/PlanNodes_types.h"
@@ -234,6 +235,20 @@ Status Aggregator::prepare(RuntimeState* state, ObjectPool* pool, RuntimeProfile
     _hash_table_size = ADD_COUNTER(_runtime_profile, "HashTableSize", TUnit::UNIT);
     _pass_through_row_count = ADD_COUNTER(_runtime_profile, "PassThroughRowCount", TUnit::UNIT);
 
+    _enable_spill = state->enable_spill();
+    if (_enable_spill) {
+        _spill_timer = ADD_TIMER(_runtime_profile, "SpillTime");
+        _spill_restore_timer = ADD_TIMER(_runtime_profile, "SpillRestoreTime");
+        _spill_times = ADD_COUNTER(_runtime_profile, "SpillTimes", TUnit::UNIT);
+        _spilled_rows = ADD_COUNTER(_runtime_profile, "SpilledRows", TUnit::UNIT);
+        _spilled_bytes = ADD_COUNTER(_runtime_profile, "SpilledBytes", TUnit::BYTES);
+    }
+    if (_partitioned_merge_ctx != nullptr) {
+        _partition_timer = ADD_TIMER(_runtime_profile, "PartitionTime");
+        _partition_merge_timer = ADD_TIMER(_runtime_profile, "PartitionMergeTime");
+        _partitioned_rows = ADD_COUNTER(_runtime_profile, "PartitionedRows", TUnit::UNIT);
+    }
+
     SCOPED_TIMER(_runtime_profile->total_time_counter());
 
     _intermediate_tuple_desc = state->desc_tbl().get_tuple_descriptor(_intermediate_tuple_id);
@@ -574,6 +589,302 @@ Status Aggregator::check_has_error() {
 
 #undef CONVERT_TO_TWO_LEVEL
 
+bool Aggregator::_should_spill() const {
+    int64_t ht_bytes = _hash_map_variant.memory_usage() + _mem_pool->total_reserved_bytes();
+    if (ht_bytes < config::spill_operator_min_bytes) {
+        return false;
+    }
+    if (ht_bytes >= config::spill_operator_max_bytes) {
+        return true;
+    }
+    MemTracker* query_tracker = _state->query_mem_tracker_ptr().get();
+    return query_tracker != nullptr && query_tracker->has_limit() &&
+           query_tracker->consumption() >= query_tracker->limit() * config::spill_query_mem_limit_ratio;
+}
+
+Status Aggregator::try_spill_hash_map() {
+    // The aggregate with only group by columns builds a hash set instead of the hash map, which is never spilled.
+    if (!_enable_spill || _group_by_expr_ctxs.empty() || _is_only_group_by_columns) {
+        return Status::OK();
+    }
+    if (!_should_spill()) {
+        return Status::OK();
+    }
+    return _spill_hash_map();
+}
+
+Status Aggregator::_spill_hash_map() {
+    SCOPED_TIMER(_spill_timer);
+    if (_spiller == nullptr) {
+        ASSIGN_OR_RETURN(_spiller, vectorized::PartitionedSpiller::create(_state, "agg",
+                                                                         std::max(1, config::spill_partition_num)));
+        _spill_prototype = _build_intermediate_chunk(_create_group_by_columns(), _create_serialize_agg_result_columns())
+                                   ->clone_empty();
+        // Once spilled, output starts from restoring the first partition.
+        _need_restore_partition = true;
+    }
+    RETURN_IF_ERROR(_spill_hash_map_into(_spiller.get()));
+    COUNTER_SET(_spilled_rows, _spiller->spilled_rows());
+    COUNTER_SET(_spilled_bytes, _spiller->spilled_bytes());
+    return Status::OK();
+}
+
+Status Aggregator::_spill_hash_map_into(vectorized::PartitionedSpiller* spiller) {
+    auto spill_chunk = [spiller](const vectorized::ChunkPtr& chunk, const vectorized::Columns& group_by_columns) {
+        return spiller->spill(*chunk, group_by_columns);
+    };
+    if (false) {
+    }
+#define HASH_MAP_METHOD(NAME)                                                                              \
+    else if (_hash_map_variant.type == vectorized::HashMapVariant::Type::NAME) {                           \
+        RETURN_IF_ERROR(_serialize_hash_map_rows(*_hash_map_variant.NAME, spill_chunk));                   \
+    }
+    APPLY_FOR_VARIANT_ALL(HASH_MAP_METHOD)
+#undef HASH_MAP_METHOD
+
+    _reset_hash_map();
+
+    COUNTER_UPDATE(_spill_times, 1);
+    return Status::OK();
+}
+
+void Aggregator::_reset_hash_map() {
+    if (false) {
+    }
+#define HASH_MAP_METHOD(NAME)                                                                             \
+    else if (_hash_map_variant.type == vectorized::HashMapVariant::Type::NAME) {                          \
+        _release_agg_memory<decltype(_hash_map_variant.NAME)::element_type>(_hash_map_variant.NAME.get()); \
+        _hash_map_variant.NAME.reset();                                                                   \
+    }
+    APPLY_FOR_VARIANT_ALL(HASH_MAP_METHOD)
+#undef HASH_MAP_METHOD
+
+    // Keys and agg states are all allocated from _mem_pool.
+    _mem_pool->free_all();
+    _init_agg_hash_variant(_hash_map_variant);
+}
+
+void Aggregator::_reset_hash_map_iterator() {
+    if (false) {
+    }
+#define HASH_MAP_METHOD(NAME)                                                  \
+    else if (_hash_map_variant.type == vectorized::HashMapVariant::Type::NAME) \
+            _it_hash = _hash_map_variant.NAME->hash_map.begin();
+    APPLY_FOR_VARIANT_ALL(HASH_MAP_METHOD)
+#undef HASH_MAP_METHOD
+}
+
+vectorized::ChunkPtr Aggregator::_build_intermediate_chunk(const vectorized::Columns& group_by_columns,
+                                                    const vectorized::Columns& agg_result_columns) {
+    vectorized::ChunkPtr chunk = std::make_shared<vectorized::Chunk>();
+    for (size_t i = 0; i < group_by_columns.size(); i++) {
+        chunk->append_column(group_by_columns[i], _intermediate_tuple_desc->slots()[i]->id());
+    }
+    for (size_t i = 0; i < agg_result_columns.size(); i++) {
+        size_t id = group_by_columns.size() + i;
+        chunk->append_column(agg_result_columns[i], _intermediate_tuple_desc->slots()[id]->id());
+    }
+    return chunk;
+}
+
+void Aggregator::_merge_intermediate_chunk(vectorized::Chunk* chunk) {
+    const size_t chunk_size = chunk->num_rows();
+    const size_t num_group_by_columns = _group_by_columns.size();
+    for (size_t i = 0; i < num_group_by_columns; i++) {
+        _group_by_columns[i] = chunk->get_column_by_index(i);
+    }
+
+    if (false) {
+    }
+#define HASH_MAP_METHOD(NAME)                                                  \
+    else if (_hash_map_variant.type == vectorized::HashMapVariant::Type::NAME) \
+            build_hash_map<decltype(_hash_map_variant.NAME)::element_type>(*_hash_map_variant.NAME, chunk_size);
+    APPLY_FOR_VARIANT_ALL(HASH_MAP_METHOD)
+#undef HASH_MAP_METHOD
+
+    // The agg columns are always intermediate results, so merge them no matter
+    // whether the function is a merge function in this phase.
+    for (size_t i = 0; i < _agg_fn_ctxs.size(); i++) {
+        _agg_functions[i]->merge_batch(_agg_fn_ctxs[i], chunk_size, _agg_states_offsets[i],
+                                       chunk->get_column_by_index(num_group_by_columns + i).get(),
+                                       _tmp_agg_states.data());
+    }
+    try_convert_to_two_level_map();
+}
+
+Status Aggregator::restore_spilled_partition_if_needed() {
+    if (!_need_restore_partition) {
+        return Status::OK();
+    }
+    DCHECK(_spiller != nullptr);
+    SCOPED_TIMER(_spill_restore_timer);
+    if (!_spiller->is_finished()) {
+        // All input has been consumed, spill the rows left in the hash map too,
+        // so that every group is located in exactly one partition.
+        RETURN_IF_ERROR(_spill_hash_map());
+        RETURN_IF_ERROR(_spiller->finish());
+    } else {
+        // Release the partition which has been output.
+        _reset_hash_map();
+    }
+    _need_restore_partition = false;
+
+    // Skip empty partitions, and the partitions repartitioned because they are too large.
+    while (_has_pending_spilled_partitions() && _hash_map_variant.size() == 0) {
+        vectorized::SpillFile* partition = nullptr;
+        size_t level = _repartition_spillers.size();
+        if (level == 0) {
+            partition = _spiller->partition(_restore_partition_idx++);
+        } else {
+            auto& [spiller, partition_idx] = _repartition_spillers.back();
+            partition = spiller->partition(partition_idx++);
+        }
+        RETURN_IF_ERROR(_restore_spilled_partition(partition, level));
+        // Release the repartition spillers whose partitions have all been restored.
+        while (!_repartition_spillers.empty() &&
+               _repartition_spillers.back().second >= _repartition_spillers.back().first->num_partitions()) {
+            _repartition_spillers.pop_back();
+        }
+    }
+
+    _reset_hash_map_iterator();
+    _is_ht_eos = _hash_map_variant.size() == 0;
+    COUNTER_UPDATE(_hash_table_size, (int64_t)_hash_map_variant.size());
+    return Status::OK();
+}
+
+Status Aggregator::_restore_spilled_partition(vectorized::SpillFile* partition, size_t level) {
+    std::unique_ptr<vectorized::PartitionedSpiller> repartition_spiller;
+    while (true) {
+        auto chunk_or = partition->read(*_spill_prototype);
+        if (chunk_or.status().is_end_of_file()) {
+            break;
+        }
+        RETURN_IF_ERROR(chunk_or.status());
+        vectorized::ChunkUniquePtr& chunk = chunk_or.value();
+        if (repartition_spiller != nullptr) {
+            // The hash map has been repartitioned, so are the rest of the rows of the partition.
+            const auto& columns = chunk->columns();
+            vectorized::Columns group_by_columns(columns.begin(), columns.begin() + _group_by_columns.size());
+            RETURN_IF_ERROR(repartition_spiller->spill(*chunk, group_by_columns));
+            continue;
+        }
+        TRY_CATCH_BAD_ALLOC(_merge_intermediate_chunk(chunk.get()));
+        RETURN_IF_ERROR(check_has_error());
+        if (!_should_spill()) {
+            continue;
+        }
+        if (static_cast<int64_t>(level) >= config::spill_max_repartition_times) {
+            return Status::MemoryLimitExceeded(
+                    strings::Substitute("spilled partition of aggregate is too large to be restored after "
+                                        "repartitioned $0 times, increase the memory limit or spill_partition_num",
+                                        level));
+        }
+        // With the seed of their spiller the rows of the partition fall into a single partition again,
+        // so they are split with a new seed.
+        ASSIGN_OR_RETURN(repartition_spiller, vectorized::PartitionedSpiller::create(
+                                                      _state, "agg", std::max(1, config::spill_partition_num),
+                                                      HashUtil::FNV_SEED + level + 1));
+        SCOPED_TIMER(_spill_timer);
+        RETURN_IF_ERROR(_spill_hash_map_into(repartition_spiller.get()));
+    }
+    RETURN_IF_ERROR(partition->remove());
+    if (repartition_spiller != nullptr) {
+        RETURN_IF_ERROR(repartition_spiller->finish());
+        _repartition_spillers.emplace_back(std::move(repartition_spiller), 0);
+    }
+    return Status::OK();
+}
+
+void Aggregator::partition_hash_map_for_merge() {
+    DCHECK(_partitioned_merge_ctx != nullptr);
+    Status status = _partition_hash_map();
+    _partitioned_merge_ctx->finish_sink(status);
+}
+
+Status Aggregator::_partition_hash_map() {
+    SCOPED_TIMER(_partition_timer);
+    _partition_row_indexes.resize(_partitioned_merge_ctx->num_partitions());
+    auto partition_chunk = [this](const vectorized::ChunkPtr& chunk, const vectorized::Columns& group_by_columns) {
+        _partition_intermediate_chunk(chunk, group_by_columns);
+        return Status::OK();
+    };
+    Status status;
+    if (false) {
+    }
+#define HASH_MAP_METHOD(NAME)                                                                             \
+    else if (_hash_map_variant.type == vectorized::HashMapVariant::Type::NAME) {                          \
+        TRY_CATCH_BAD_ALLOC(status = _serialize_hash_map_rows(*_hash_map_variant.NAME, partition_chunk)); \
+    }
+    APPLY_FOR_VARIANT_ALL(HASH_MAP_METHOD)
+#undef HASH_MAP_METHOD
+    RETURN_IF_ERROR(status);
+
+    _reset_hash_map();
+    return Status::OK();
+}
+
+void Aggregator::_partition_intermediate_chunk(const vectorized::ChunkPtr& chunk,
+                                               const vectorized::Columns& group_by_columns) {
+    const size_t num_rows = chunk->num_rows();
+    const size_t num_partitions = _partition_row_indexes.size();
+    COUNTER_UPDATE(_partitioned_rows, num_rows);
+    if (num_partitions == 1) {
+        _partitioned_merge_ctx->add_chunk(_driver_sequence, 0, chunk);
+        return;
+    }
+
+    vectorized::PartitionedSpiller::compute_partition_hash(group_by_columns, num_rows, &_partition_hash_values);
+    for (auto& indexes : _partition_row_indexes) {
+        indexes.clear();
+    }
+    for (uint32_t i = 0; i < num_rows; ++i) {
+        _partition_row_indexes[_partition_hash_values[i] % num_partitions].emplace_back(i);
+    }
+    for (size_t p = 0; p < num_partitions; ++p) {
+        const auto& indexes = _partition_row_indexes[p];
+        if (indexes.empty()) {
+            continue;
+        }
+        if (indexes.size() == num_rows) {
+            _partitioned_merge_ctx->add_chunk(_driver_sequence, p, chunk);
+            continue;
+        }
+        vectorized::ChunkPtr part = chunk->clone_empty(indexes.size());
+        part->append_selective(*chunk, indexes.data(), 0, indexes.size());
+        _partitioned_merge_ctx->add_chunk(_driver_sequence, p, std::move(part));
+    }
+}
+
+Status Aggregator::merge_partition_if_needed() {
+    if (_partitioned_merge_ctx == nullptr || _is_partition_merged) {
+        return Status::OK();
+    }
+    DCHECK(_partitioned_merge_ctx->is_all_sinks_finished());
+    _is_partition_merged = true;
+    RETURN_IF_ERROR(_partitioned_merge_ctx->status());
+
+    SCOPED_TIMER(_partition_merge_timer);
+    for (size_t sink = 0; sink < _partitioned_merge_ctx->num_partitions(); ++sink) {
+        auto& chunks = _partitioned_merge_ctx->chunks(sink, _driver_sequence);
+        for (auto& chunk : chunks) {
+            TRY_CATCH_BAD_ALLOC(_merge_intermediate_chunk(chunk.get()));
+            RETURN_IF_ERROR(check_has_error());
+            // Release the chunk as soon as it is merged.
+            _partitioned_merge_ctx->release(chunk->memory_usage());
+            chunk.reset();
+        }
+        chunks.clear();
+    }
+    _mem_tracker->set(_hash_map_variant.memory_usage() + _mem_pool->total_reserved_bytes() +
+                      _partitioned_merge_ctx->memory_usage());
+
+    _reset_hash_map_iterator();
+    _is_ht_eos = _hash_map_variant.size() == 0;
+    COUNTER_SET(_hash_table_size, (int64_t)_hash_map_variant.size());
+    return Status::OK();
+}
+
 // When need finalize, create column by result type
 // otherwise, create column by serde type
 vectorized::Columns Aggregator::_create_agg_result_columns() {
@@ -587,11 +898,17 @@ vectorized::Columns Aggregator::_create_agg_result_columns() {
             agg_result_columns[i]->reserve(_state->chunk_size());
         }
     } else {
-        for (size_t i = 0; i < _agg_fn_types.size(); ++i) {
-            agg_result_columns[i] = vectorized::ColumnHelper::create_column(_agg_fn_types[i].serde_type,
-                                                                            _agg_fn_types[i].has_nullable_child);
-            agg_result_columns[i]->reserve(_state->chunk_size());
-        }
+        agg_result_columns = _create_serialize_agg_result_columns();
+    }
+    return agg_result_columns;
+}
+
+vectorized::Columns Aggregator::_create_serialize_agg_result_columns() {
+    vectorized::Columns agg_result_columns(_agg_fn_types.size());
+    for (size_t i = 0; i < _agg_fn_types.size(); ++i) {
+        agg_result_columns[i] = vectorized::ColumnHelper::create_column(_agg_fn_types[i].serde_type,
+                                                                        _agg_fn_types[i].has_nullable_child);
+        agg_result_columns[i]->reserve(_state->chunk_size());
     }
     return agg_result_columns;
 }
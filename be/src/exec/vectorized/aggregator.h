@@ -12,6 +12,7 @@
 #include "column/vectorized_fwd.h"
 #include "exec/pipeline/context_with_dependency.h"
 #include "exec/vectorized/aggregate/agg_hash_variant.h"
+#include "exec/vectorized/spiller.h"
 #include "exprs/agg/aggregate_factory.h"
 #include "exprs/expr.h"
 #include "gutil/strings/substitute.h"
@@ -53,6 +54,61 @@ static const int STREAMING_HT_MIN_REDUCTION_SIZE =
 class Aggregator;
 using AggregatorPtr = std::shared_ptr<Aggregator>;
 
+// Shared by the drivers of a blocking aggregate whose input is not partitioned by the group by keys.
+// Instead of shuffling the input rows, each sink driver aggregates the rows it receives, and then
+// hash partitions the intermediate results of its hash map into one partition per driver.
+// After all the sink drivers finish, the i-th source driver merges the i-th partition of every
+// sink driver and finalizes it, so each group is merged by exactly one driver, in parallel.
+class AggPartitionedMergeContext {
+public:
+    explicit AggPartitionedMergeContext(size_t num_drivers)
+            : _chunks(num_drivers, std::vector<std::vector<vectorized::ChunkPtr>>(num_drivers)),
+              _num_unfinished_sinks(num_drivers) {}
+
+    size_t num_partitions() const { return _chunks.size(); }
+
+    // Only called by the sink driver |driver_sequence|, so no lock is needed.
+    void add_chunk(size_t driver_sequence, size_t partition, vectorized::ChunkPtr chunk) {
+        _bytes.fetch_add(chunk->memory_usage(), std::memory_order_relaxed);
+        _chunks[driver_sequence][partition].emplace_back(std::move(chunk));
+    }
+    // Called by the source drivers after the chunks of |bytes| are merged and released.
+    void release(int64_t bytes) { _bytes.fetch_sub(bytes, std::memory_order_relaxed); }
+    // The memory of the partitioned chunks not merged yet, which is no longer counted by any hash map.
+    int64_t memory_usage() const { return _bytes.load(std::memory_order_relaxed); }
+
+    // Called once by each sink driver after it partitions all its groups, with the result of partitioning.
+    void finish_sink(const Status& status) {
+        if (!status.ok()) {
+            std::lock_guard<std::mutex> l(_status_lock);
+            if (_status.ok()) {
+                _status = status;
+            }
+        }
+        _num_unfinished_sinks.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    bool is_all_sinks_finished() const { return _num_unfinished_sinks.load(std::memory_order_acquire) == 0; }
+
+    // The following methods could only be called after all the sink drivers finish.
+    Status status() {
+        std::lock_guard<std::mutex> l(_status_lock);
+        return _status;
+    }
+    std::vector<vectorized::ChunkPtr>& chunks(size_t driver_sequence, size_t partition) {
+        return _chunks[driver_sequence][partition];
+    }
+
+private:
+    // Indexed by [sink driver][partition]
+    std::vector<std::vector<std::vector<vectorized::ChunkPtr>>> _chunks;
+    std::atomic<size_t> _num_unfinished_sinks;
+    std::atomic<int64_t> _bytes{0};
+    std::mutex _status_lock;
+    Status _status;
+};
+using AggPartitionedMergeContextPtr = std::shared_ptr<AggPartitionedMergeContext>;
+
 // Component used to process aggregation including bloking aggregate and streaming aggregate
 // it contains common data struct and algorithm of aggregation
 class Aggregator final : public pipeline::ContextWithDependency {
@@ -141,6 +197,40 @@ public:
 
     Status check_has_error();
 
+    // Spill is only used by blocking aggregate with group by in pipeline engine.
+    // When the hash map grows too large, its rows are serialized as intermediate results and
+    // hash partitioned to local disk, then the hash map is cleared to take more input.
+    // After the sink is finished, the partitions are merged back into the hash map and
+    // output one after another, so memory is bounded by the size of a single partition.
+    // A partition too large to be merged back is repartitioned with another hash seed.
+    bool is_spill_enabled() const { return _enable_spill; }
+    bool has_spilled() const { return _spiller != nullptr; }
+    // Spill the hash map if it is too large.
+    Status try_spill_hash_map();
+    // Load the next spilled partition into the hash map, if the previous one has been output.
+    Status restore_spilled_partition_if_needed();
+
+    // Partitioned merge is only used by blocking aggregate with group by in pipeline engine,
+    // see AggPartitionedMergeContext. It must be set before prepare.
+    void set_partitioned_merge(AggPartitionedMergeContextPtr ctx, size_t driver_sequence) {
+        _partitioned_merge_ctx = std::move(ctx);
+        _driver_sequence = driver_sequence;
+    }
+    bool is_partitioned_merge() const { return _partitioned_merge_ctx != nullptr; }
+    int64_t partitioned_merge_memory_usage() const {
+        return _partitioned_merge_ctx == nullptr ? 0 : _partitioned_merge_ctx->memory_usage();
+    }
+    // Whether the partitions of all the sink drivers are ready to be merged.
+    bool is_partitioned_merge_ready() const {
+        return _partitioned_merge_ctx == nullptr || _partitioned_merge_ctx->is_all_sinks_finished();
+    }
+    // Called by the sink driver after all the input is consumed, the hash map is hash partitioned
+    // into the shared context and then released.
+    void partition_hash_map_for_merge();
+    // Called by the source driver, merge the partition of this driver from all the sink drivers into
+    // the hash map, it only takes effect at the first call.
+    Status merge_partition_if_needed();
+
 #ifdef NDEBUG
     static constexpr size_t two_level_memory_threshold = 33554432; // 32M, L3 Cache
     static constexpr size_t streaming_hash_table_size_threshold = 10000000;
@@ -253,6 +343,32 @@ private:
     RuntimeProfile::Counter* _pass_through_row_count{};
     RuntimeProfile::Counter* _expr_compute_timer{};
     RuntimeProfile::Counter* _expr_release_timer{};
+    RuntimeProfile::Counter* _spill_timer{};
+    RuntimeProfile::Counter* _spill_restore_timer{};
+    RuntimeProfile::Counter* _spill_times{};
+    RuntimeProfile::Counter* _spilled_rows{};
+    RuntimeProfile::Counter* _spilled_bytes{};
+
+    bool _enable_spill = false;
+    std::unique_ptr<vectorized::PartitionedSpiller> _spiller;
+    // Used to create the chunks read from spill files.
+    vectorized::ChunkUniquePtr _spill_prototype;
+    // The next spilled partition of _spiller to be restored.
+    size_t _restore_partition_idx = 0;
+    // The partitions too large to be restored are repartitioned into these spillers, along with the index of
+    // their next partition to be restored. The last one is restored first, the i'th one is repartitioned i+1 times.
+    std::vector<std::pair<std::unique_ptr<vectorized::PartitionedSpiller>, size_t>> _repartition_spillers;
+    bool _need_restore_partition = false;
+
+    RuntimeProfile::Counter* _partition_timer{};
+    RuntimeProfile::Counter* _partition_merge_timer{};
+    RuntimeProfile::Counter* _partitioned_rows{};
+
+    AggPartitionedMergeContextPtr _partitioned_merge_ctx;
+    size_t _driver_sequence = 0;
+    bool _is_partition_merged = false;
+    std::vector<uint32_t> _partition_hash_values;
+    std::vector<std::vector<uint32_t>> _partition_row_indexes;
 
 public:
     template <typename HashMapWithKey>
@@ -373,6 +489,12 @@ public:
 
         _it_hash = it;
 
+        if (_is_ht_eos && _has_pending_spilled_partitions()) {
+            // Current partition is drained, restore the next one before next output.
+            _is_ht_eos = false;
+            _need_restore_partition = true;
+        }
+
         vectorized::ChunkPtr _result_chunk = std::make_shared<vectorized::Chunk>();
         // For different agg phase, we should use different TupleDescriptor
         if (_needs_finalize) {
@@ -464,6 +586,8 @@ private:
 
     // Create new aggregate function result column by type
     vectorized::Columns _create_agg_result_columns();
+    // Create aggregate function result column by serde type
+    vectorized::Columns _create_serialize_agg_result_columns();
     vectorized::Columns _create_group_by_columns();
 
     void _serialize_to_chunk(vectorized::ConstAggDataPtr __restrict state,
@@ -478,6 +602,71 @@ private:
     template <typename HashVariantType>
     void _init_agg_hash_variant(HashVariantType& hash_variant);
 
+    bool _should_spill() const;
+    bool _has_pending_spilled_partitions() const {
+        return _spiller != nullptr &&
+               (!_repartition_spillers.empty() || _restore_partition_idx < _spiller->num_partitions());
+    }
+    // Spill all rows of the hash map and release it
+    Status _spill_hash_map();
+    Status _spill_hash_map_into(vectorized::PartitionedSpiller* spiller);
+    // Merge the rows of a spilled partition, which have been repartitioned |level| times, into the hash map.
+    // The rows are repartitioned once more if the hash map grows too large.
+    Status _restore_spilled_partition(vectorized::SpillFile* partition, size_t level);
+    // Destroy all agg states and reset the hash map to empty
+    void _reset_hash_map();
+    // Merge a chunk of intermediate results, read from spill file or partitioned by
+    // another driver, into the hash map
+    void _merge_intermediate_chunk(vectorized::Chunk* chunk);
+    void _reset_hash_map_iterator();
+    vectorized::ChunkPtr _build_intermediate_chunk(const vectorized::Columns& group_by_columns,
+                                                   const vectorized::Columns& agg_result_columns);
+    Status _partition_hash_map();
+    // Hash partition the rows of an intermediate chunk into the shared context
+    void _partition_intermediate_chunk(const vectorized::ChunkPtr& chunk, const vectorized::Columns& group_by_columns);
+
+    // Serialize all rows of the hash map into intermediate chunks, and pass each of them to
+    // |consumer| with its group by columns.
+    template <typename HashMapWithKey, typename Consumer>
+    Status _serialize_hash_map_rows(HashMapWithKey& hash_map_with_key, Consumer&& consumer) {
+        const int32_t chunk_size = _state->chunk_size();
+        auto it = hash_map_with_key.hash_map.begin();
+        auto end = hash_map_with_key.hash_map.end();
+        while (it != end) {
+            vectorized::Columns group_by_columns = _create_group_by_columns();
+            vectorized::Columns agg_result_columns = _create_serialize_agg_result_columns();
+            int32_t read_index = 0;
+            hash_map_with_key.results.resize(chunk_size);
+            while ((it != end) & (read_index < chunk_size)) {
+                hash_map_with_key.results[read_index] = it->first;
+                _tmp_agg_states[read_index] = it->second;
+                ++read_index;
+                ++it;
+            }
+            hash_map_with_key.insert_keys_to_columns(hash_map_with_key.results, group_by_columns, read_index);
+            for (size_t i = 0; i < _agg_fn_ctxs.size(); i++) {
+                _agg_functions[i]->batch_serialize(_agg_fn_ctxs[i], read_index, _tmp_agg_states,
+                                                   _agg_states_offsets[i], agg_result_columns[i].get());
+            }
+            auto chunk = _build_intermediate_chunk(group_by_columns, agg_result_columns);
+            RETURN_IF_ERROR(consumer(chunk, group_by_columns));
+        }
+
+        if constexpr (HashMapWithKey::has_single_null_key) {
+            if (hash_map_with_key.null_key_data != nullptr) {
+                vectorized::Columns group_by_columns = _create_group_by_columns();
+                vectorized::Columns agg_result_columns = _create_serialize_agg_result_columns();
+                DCHECK(group_by_columns.size() == 1);
+                DCHECK(group_by_columns[0]->is_nullable());
+                group_by_columns[0]->append_default();
+                _serialize_to_chunk(hash_map_with_key.null_key_data, agg_result_columns);
+                auto chunk = _build_intermediate_chunk(group_by_columns, agg_result_columns);
+                RETURN_IF_ERROR(consumer(chunk, group_by_columns));
+            }
+        }
+        return Status::OK();
+    }
+
     template <typename HashMapWithKey>
     void _release_agg_memory(HashMapWithKey* hash_map_with_key) {
         if (hash_map_with_key != nullptr) {
@@ -507,18 +696,27 @@ class AggregatorFactory {
 public:
     AggregatorFactory(const TPlanNode& tnode) : _tnode(tnode) {}
 
+    // Merge the intermediate results of |num_drivers| drivers by partitions, see AggPartitionedMergeContext.
+    void enable_partitioned_merge(size_t num_drivers) {
+        _partitioned_merge_ctx = std::make_shared<AggPartitionedMergeContext>(num_drivers);
+    }
+
     AggregatorPtr get_or_create(size_t id) {
         auto it = _aggregators.find(id);
         if (it != _aggregators.end()) {
             return it->second;
         }
         auto aggregator = std::make_shared<Aggregator>(_tnode);
+        if (_partitioned_merge_ctx != nullptr) {
+            aggregator->set_partitioned_merge(_partitioned_merge_ctx, id);
+        }
         _aggregators[id] = aggregator;
         return aggregator;
     }
 
 private:
     const TPlanNode& _tnode;
+    AggPartitionedMergeContextPtr _partitioned_merge_ctx;
     std::unordered_map<size_t, AggregatorPtr> _aggregators;
 };
 
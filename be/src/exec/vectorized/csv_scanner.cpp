@@ -118,12 +118,15 @@ StatusOr<ChunkPtr> CSVScanner::get_next() {
 
     do {
         if (_curr_reader == nullptr && ++_curr_file_index < _scan_range.ranges.size()) {
-            std::shared_ptr<SequentialFile> file;
+            std::shared_ptr<SequentialFile> file = _file;
             const TBrokerRangeDesc& range_desc = _scan_range.ranges[_curr_file_index];
-            Status st = create_sequential_file(range_desc, _scan_range.broker_addresses[0], _scan_range.params, &file);
-            if (!st.ok()) {
-                LOG(WARNING) << "Failed to create sequential files. status: " << st.to_string();
-                return st;
+            if (file == nullptr) {
+                Status st =
+                        create_sequential_file(range_desc, _scan_range.broker_addresses[0], _scan_range.params, &file);
+                if (!st.ok()) {
+                    LOG(WARNING) << "Failed to create sequential files. status: " << st.to_string();
+                    return st;
+                }
             }
 
             _curr_reader = std::make_unique<ScannerCSVReader>(file, _record_delimiter, _field_delimiter);
@@ -163,8 +166,6 @@ Status CSVScanner::_parse_csv(Chunk* chunk) {
     const int capacity = _state->chunk_size();
     DCHECK_EQ(0, chunk->num_rows());
     Status status;
-    CSVReader::Record record;
-    CSVReader::Fields fields;
 
     int num_columns = chunk->num_columns();
     _column_raw_ptrs.resize(num_columns);
@@ -175,58 +176,62 @@ Status CSVScanner::_parse_csv(Chunk* chunk) {
     csv::Converter::Options options{.invalid_field_as_null = !_strict_mode};
 
     for (size_t num_rows = chunk->num_rows(); num_rows < capacity; /**/) {
-        status = _curr_reader->next_record(&record);
+        status = _curr_reader->next_records(capacity - num_rows, &_records, &_fields, &_field_offsets);
         if (status.is_end_of_file()) {
             break;
         } else if (!status.ok()) {
             return status;
-        } else if (record.empty()) {
-            // always skip blank lines.
-            continue;
-        }
-
-        fields.clear();
-        _curr_reader->split_record(record, &fields);
-
-        if (fields.size() != _num_fields_in_csv) {
-            if (_counter->num_rows_filtered++ < 50) {
-                std::stringstream error_msg;
-                error_msg << "Value count does not match column count. "
-                          << "Expect " << _num_fields_in_csv << ", but got " << fields.size();
-                _report_error(record.to_string(), error_msg.str());
-            }
-            continue;
-        }
-        if (!validate_utf8(record.data, record.size)) {
-            if (_counter->num_rows_filtered++ < 50) {
-                _report_error(record.to_string(), "Invalid UTF-8 row");
-            }
-            continue;
         }
 
-        SCOPED_RAW_TIMER(&_counter->fill_ns);
-        bool has_error = false;
-        for (int j = 0, k = 0; j < _num_fields_in_csv; j++) {
-            auto slot = _src_slot_descriptors[j];
-            if (slot == nullptr) {
+        for (size_t i = 0; i < _records.size(); i++) {
+            const CSVReader::Record& record = _records[i];
+            if (record.empty()) {
+                // always skip blank lines.
                 continue;
             }
-            const Slice& field = fields[j];
-            options.type_desc = &(slot->type());
-            if (!_converters[k]->read_string(_column_raw_ptrs[k], field, options)) {
-                chunk->set_num_rows(num_rows);
+
+            const Slice* fields = _fields.data() + _field_offsets[i];
+            const size_t num_fields = _field_offsets[i + 1] - _field_offsets[i];
+            if (num_fields != _num_fields_in_csv) {
                 if (_counter->num_rows_filtered++ < 50) {
                     std::stringstream error_msg;
-                    error_msg << "Value '" << field.to_string() << "' is out of range. "
-                              << "The type of '" << slot->col_name() << "' is " << slot->type().debug_string();
+                    error_msg << "Value count does not match column count. "
+                              << "Expect " << _num_fields_in_csv << ", but got " << num_fields;
                     _report_error(record.to_string(), error_msg.str());
                 }
-                has_error = true;
-                break;
+                continue;
             }
-            k++;
+            if (!validate_utf8(record.data, record.size)) {
+                if (_counter->num_rows_filtered++ < 50) {
+                    _report_error(record.to_string(), "Invalid UTF-8 row");
+                }
+                continue;
+            }
+
+            SCOPED_RAW_TIMER(&_counter->fill_ns);
+            bool has_error = false;
+            for (int j = 0, k = 0; j < _num_fields_in_csv; j++) {
+                auto slot = _src_slot_descriptors[j];
+                if (slot == nullptr) {
+                    continue;
+                }
+                const Slice& field = fields[j];
+                options.type_desc = &(slot->type());
+                if (!_converters[k]->read_string(_column_raw_ptrs[k], field, options)) {
+                    chunk->set_num_rows(num_rows);
+                    if (_counter->num_rows_filtered++ < 50) {
+                        std::stringstream error_msg;
+                        error_msg << "Value '" << field.to_string() << "' is out of range. "
+                                  << "The type of '" << slot->col_name() << "' is " << slot->type().debug_string();
+                        _report_error(record.to_string(), error_msg.str());
+                    }
+                    has_error = true;
+                    break;
+                }
+                k++;
+            }
+            num_rows += !has_error;
         }
-        num_rows += !has_error;
     }
     return chunk->num_rows() > 0 ? Status::OK() : Status::EndOfFile("");
 }
@@ -284,6 +289,46 @@ ChunkPtr CSVScanner::_materialize(ChunkPtr& src_chunk) {
     return dest_chunk;
 }
 
+Status CSVBlockSplitter::next_block(std::string* block, int64_t* seq) {
+    std::lock_guard<std::mutex> l(_lock);
+    block->swap(_tail);
+    _tail.clear();
+    // The bytes at the front of |block| known to have no record delimiter.
+    size_t searched = 0;
+    while (!_eof) {
+        if (block->size() >= _block_size) {
+            const auto* d = static_cast<const char*>(
+                    memrchr(block->data() + searched, _record_delimiter, block->size() - searched));
+            if (d != nullptr) {
+                size_t n = d - block->data() + 1;
+                _tail.assign(block->data() + n, block->size() - n);
+                block->resize(n);
+                break;
+            }
+            searched = block->size();
+        }
+        size_t size = block->size();
+        size_t n = std::max<size_t>(_block_size > size ? _block_size - size : 0, 64 * 1024);
+        raw::stl_string_resize_uninitialized(block, size + n);
+        auto res = _file->read(block->data() + size, n);
+        if (res.status().is_end_of_file()) {
+            block->resize(size);
+            _eof = true;
+        } else if (!res.ok()) {
+            block->resize(size);
+            return res.status();
+        } else {
+            block->resize(size + *res);
+            _eof = (*res == 0);
+        }
+    }
+    if (block->empty()) {
+        return Status::EndOfFile("CSVBlockSplitter");
+    }
+    *seq = _next_seq++;
+    return Status::OK();
+}
+
 void CSVScanner::_report_error(const std::string& line, const std::string& err_msg) {
     _state->append_error_msg_to_file(line, err_msg);
 }
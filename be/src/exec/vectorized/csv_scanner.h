@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <mutex>
 #include <string_view>
 #include <utility>
 #include <vector>
@@ -29,6 +30,14 @@ public:
 
     void close() override{};
 
+    // Scans the records of |file| as the file of the first range from the next get_next(), instead of
+    // opening the file of the range. It's used to parse each block of a CSVBlockSplitter.
+    void set_file(std::shared_ptr<SequentialFile> file) {
+        _file = std::move(file);
+        _curr_file_index = -1;
+        _curr_reader = nullptr;
+    }
+
 private:
     class ScannerCSVReader : public CSVReader {
     public:
@@ -62,7 +71,35 @@ private:
     int _num_fields_in_csv = 0;
     int _curr_file_index = -1;
     CSVReaderPtr _curr_reader;
+    // The file set by set_file(), if any.
+    std::shared_ptr<SequentialFile> _file;
     std::vector<ConverterPtr> _converters;
+    // The records read from |_curr_reader| in a batch and their fields, see CSVReader::next_records().
+    CSVReader::Records _records;
+    CSVReader::Fields _fields;
+    std::vector<uint32_t> _field_offsets;
+};
+
+// CSVBlockSplitter reads a CSV file in blocks ending at a record delimiter, so that the blocks of one file
+// can be parsed by several threads. The blocks are about |block_size| bytes, unless a record is longer.
+// Thread-safe.
+class CSVBlockSplitter {
+public:
+    CSVBlockSplitter(std::shared_ptr<SequentialFile> file, char record_delimiter, size_t block_size)
+            : _file(std::move(file)), _record_delimiter(record_delimiter), _block_size(block_size) {}
+
+    // Reads the next block and its sequence number in the file, returns EndOfFile after the last block.
+    Status next_block(std::string* block, int64_t* seq);
+
+private:
+    std::mutex _lock;
+    std::shared_ptr<SequentialFile> _file;
+    const char _record_delimiter;
+    const size_t _block_size;
+    // The bytes read after the last record delimiter of the previous block.
+    std::string _tail;
+    bool _eof = false;
+    int64_t _next_seq = 0;
 };
 
 } // namespace starrocks::vectorized
@@ -6,15 +6,20 @@
 #include <sstream>
 
 #include "column/chunk.h"
+#include "common/config.h"
 #include "env/env.h"
 #include "env/env_broker.h"
+#include "env/env_memory.h"
+#include "env/env_stream_pipe.h"
 #include "exec/vectorized/csv_scanner.h"
 #include "exec/vectorized/json_scanner.h"
 #include "exec/vectorized/orc_scanner.h"
 #include "exec/vectorized/parquet_scanner.h"
 #include "exprs/expr.h"
+#include "gutil/casts.h"
 #include "runtime/current_thread.h"
 #include "runtime/runtime_state.h"
+#include "runtime/stream_load/load_stream_mgr.h"
 #include "util/defer_op.h"
 #include "util/runtime_profile.h"
 #include "util/thread.h"
@@ -78,6 +83,26 @@ Status FileScanNode::_start_scanners() {
     {
         std::unique_lock<std::mutex> l(_chunk_queue_lock);
 
+        if (_can_parse_in_parallel()) {
+            const TBrokerScanRange& scan_range = _scan_ranges[0].scan_range.broker_scan_range;
+            auto pipe = runtime_state()->exec_env()->load_stream_mgr()->get(scan_range.ranges[0].load_id);
+            if (pipe == nullptr) {
+                std::stringstream ss;
+                ss << "Invalid or outdated load id ";
+                scan_range.ranges[0].load_id.printTo(ss);
+                return Status::InternalError(ss.str());
+            }
+            _block_splitter = std::make_unique<CSVBlockSplitter>(std::make_shared<StreamPipeSequentialFile>(pipe),
+                                                                 scan_range.params.row_delimiter,
+                                                                 config::streaming_load_parse_block_size);
+            _num_running_scanners = std::max(config::streaming_load_parse_parallelism, 1);
+            for (int i = 0; i < _num_running_scanners; i++) {
+                _scanner_threads.emplace_back(&FileScanNode::_block_parse_worker, this);
+                Thread::set_thread_name(_scanner_threads.back(), "file_parser");
+            }
+            return Status::OK();
+        }
+
         _num_running_scanners = 1;
         _scanner_threads.emplace_back(&FileScanNode::_scanner_worker, this, 0, _scan_ranges.size());
         Thread::set_thread_name(_scanner_threads.back(), "file_scanner");
@@ -85,6 +110,17 @@ Status FileScanNode::_start_scanners() {
     return Status::OK();
 }
 
+bool FileScanNode::_can_parse_in_parallel() const {
+    if (config::streaming_load_parse_parallelism <= 1 || config::streaming_load_parse_block_size <= 0 ||
+        _scan_ranges.size() != 1) {
+        return false;
+    }
+    // The records of plain CSV can be found without parsing, while a JSON body is parsed as a whole.
+    const auto& ranges = _scan_ranges[0].scan_range.broker_scan_range.ranges;
+    return ranges.size() == 1 && ranges[0].file_type == TFileType::FILE_STREAM &&
+           ranges[0].format_type == TFileFormatType::FORMAT_CSV_PLAIN && ranges[0].start_offset == 0;
+}
+
 Status FileScanNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) {
     SCOPED_TIMER(_runtime_profile->total_time_counter());
     // check if CANCELLED.
@@ -167,6 +203,7 @@ Status FileScanNode::close(RuntimeState* state) {
     _scan_finished.store(true);
     _queue_writer_cond.notify_all();
     _queue_reader_cond.notify_all();
+    _block_order_cond.notify_all();
     for (auto& _scanner_thread : _scanner_threads) {
         _scanner_thread.join();
     }
@@ -234,39 +271,44 @@ Status FileScanNode::_scanner_scan(const TBrokerScanRange& scan_range, const std
 
         // Row batch has been filled, push this to the queue
         if (temp_chunk->num_rows() > 0) {
-            std::unique_lock<std::mutex> l(_chunk_queue_lock);
-            while (_process_status.ok() && !_scan_finished.load() && !runtime_state()->is_cancelled() &&
-                   // stop pushing more batch if
-                   // 1. too many batches in queue, or
-                   // 2. at least one batch in queue and memory exceed limit.
-                   (_chunk_queue.size() >= _max_queue_size ||
-                    (_cur_mem_usage >= _max_mem_usage && !_chunk_queue.empty()))) {
-                _queue_writer_cond.wait_for(l, std::chrono::seconds(1));
-            }
-            // Process already set failed, so we just return OK
-            if (!_process_status.ok()) {
+            bool stop = false;
+            RETURN_IF_ERROR(_push_chunk(std::move(temp_chunk), &stop));
+            if (stop) {
                 return Status::OK();
             }
-            // Scan already finished, just return
-            if (_scan_finished.load()) {
-                return Status::OK();
-            }
-            // Runtime state is canceled, just return cancel
-            if (runtime_state()->is_cancelled()) {
-                return Status::Cancelled("Cancelled FileScanNode::scanner_scan");
-            }
-            // Queue size Must be smaller than _max_queue_size
-            _cur_mem_usage += temp_chunk->memory_usage();
-            _chunk_queue.push_back(std::move(temp_chunk));
-
-            // Notify reader to
-            _queue_reader_cond.notify_one();
         }
     }
 
     return Status::OK();
 }
 
+Status FileScanNode::_push_chunk(ChunkPtr chunk, bool* stop) {
+    std::unique_lock<std::mutex> l(_chunk_queue_lock);
+    while (_process_status.ok() && !_scan_finished.load() && !runtime_state()->is_cancelled() &&
+           // stop pushing more batch if
+           // 1. too many batches in queue, or
+           // 2. at least one batch in queue and memory exceed limit.
+           (_chunk_queue.size() >= _max_queue_size || (_cur_mem_usage >= _max_mem_usage && !_chunk_queue.empty()))) {
+        _queue_writer_cond.wait_for(l, std::chrono::seconds(1));
+    }
+    // Process already set failed, or scan already finished, so we just return OK
+    if (!_process_status.ok() || _scan_finished.load()) {
+        *stop = true;
+        return Status::OK();
+    }
+    // Runtime state is canceled, just return cancel
+    if (runtime_state()->is_cancelled()) {
+        return Status::Cancelled("Cancelled FileScanNode::scanner_scan");
+    }
+    // Queue size Must be smaller than _max_queue_size
+    _cur_mem_usage += chunk->memory_usage();
+    _chunk_queue.push_back(std::move(chunk));
+
+    // Notify reader to
+    _queue_reader_cond.notify_one();
+    return Status::OK();
+}
+
 void FileScanNode::_scanner_worker(int start_idx, int length) {
     SCOPED_THREAD_LOCAL_MEM_TRACKER_SETTER(runtime_state()->instance_mem_tracker());
 
@@ -275,10 +317,10 @@ void FileScanNode::_scanner_worker(int start_idx, int length) {
     DeferOp close_exprs([this, &scanner_expr_ctxs] { Expr::close(scanner_expr_ctxs, runtime_state()); });
     auto status = Expr::clone_if_not_exists(_conjunct_ctxs, runtime_state(), &scanner_expr_ctxs);
 
+    ScannerCounter counter;
     if (!status.ok()) {
         LOG(WARNING) << "Clone conjuncts failed.";
     } else {
-        ScannerCounter counter;
         for (int i = 0; i < length; ++i) {
             const TBrokerScanRange& scan_range = _scan_ranges[start_idx + i].scan_range.broker_scan_range;
 
@@ -302,20 +344,94 @@ void FileScanNode::_scanner_worker(int start_idx, int length) {
                 break;
             }
         }
+    }
+    _finish_scanner_worker(status, counter);
+}
+
+void FileScanNode::_block_parse_worker() {
+    SCOPED_THREAD_LOCAL_MEM_TRACKER_SETTER(runtime_state()->instance_mem_tracker());
 
-        // Update stats
-        runtime_state()->update_num_rows_load_filtered(counter.num_rows_filtered);
-        runtime_state()->update_num_rows_load_unselected(counter.num_rows_unselected);
+    std::vector<ExprContext*> scanner_expr_ctxs;
+    DeferOp close_exprs([this, &scanner_expr_ctxs] { Expr::close(scanner_expr_ctxs, runtime_state()); });
+    auto status = Expr::clone_if_not_exists(_conjunct_ctxs, runtime_state(), &scanner_expr_ctxs);
+    ScannerCounter counter;
+    std::unique_ptr<FileScanner> scanner;
+    if (!status.ok()) {
+        LOG(WARNING) << "Clone conjuncts failed.";
+    } else {
+        scanner = _create_scanner(_scan_ranges[0].scan_range.broker_scan_range, &counter);
+        status = scanner->open();
+    }
 
-        COUNTER_UPDATE(_scanner_total_timer, counter.total_ns);
-        COUNTER_UPDATE(_scanner_fill_timer, counter.fill_ns);
-        COUNTER_UPDATE(_scanner_read_timer, counter.read_batch_ns);
-        COUNTER_UPDATE(_scanner_cast_chunk_timer, counter.cast_chunk_ns);
-        COUNTER_UPDATE(_scanner_materialize_timer, counter.materialize_ns);
-        COUNTER_UPDATE(_scanner_init_chunk_timer, counter.init_chunk_ns);
+    std::string block;
+    int64_t seq = 0;
+    std::vector<ChunkPtr> chunks;
+    while (status.ok() && (status = _block_splitter->next_block(&block, &seq)).ok()) {
+        // Parse the block without waiting for the previous blocks.
+        down_cast<CSVScanner*>(scanner.get())->set_file(std::make_shared<StringSequentialFile>(std::move(block)));
+        chunks.clear();
+        while (true) {
+            auto res = scanner->get_next();
+            if (!res.ok()) {
+                status = res.status();
+                break;
+            }
+            ChunkPtr chunk = std::move(res.value());
+            size_t before = chunk->num_rows();
+            eval_conjuncts(scanner_expr_ctxs, chunk.get());
+            counter.num_rows_unselected += (before - chunk->num_rows());
+            if (chunk->num_rows() > 0) {
+                chunks.emplace_back(std::move(chunk));
+            }
+        }
+        if (!status.is_end_of_file()) {
+            break;
+        }
+        status = Status::OK();
 
-        COUNTER_UPDATE(_scanner_file_reader_timer, counter.file_read_ns);
+        // Push the chunks after the chunks of the previous blocks.
+        {
+            std::unique_lock<std::mutex> l(_chunk_queue_lock);
+            while (_next_block_seq != seq && _process_status.ok() && !_scan_finished.load() &&
+                   !runtime_state()->is_cancelled()) {
+                _block_order_cond.wait_for(l, std::chrono::seconds(1));
+            }
+            if (_next_block_seq != seq) {
+                break;
+            }
+        }
+        bool stop = false;
+        for (size_t i = 0; status.ok() && !stop && i < chunks.size(); i++) {
+            status = _push_chunk(std::move(chunks[i]), &stop);
+        }
+        {
+            std::lock_guard<std::mutex> l(_chunk_queue_lock);
+            _next_block_seq++;
+        }
+        _block_order_cond.notify_all();
+        if (stop) {
+            break;
+        }
     }
+    if (!status.ok() && !status.is_end_of_file()) {
+        LOG(WARNING) << "FileScanNode block parser failed. status=" << status.get_error_msg();
+    }
+    _finish_scanner_worker(status, counter);
+}
+
+void FileScanNode::_finish_scanner_worker(const Status& status, const ScannerCounter& counter) {
+    // Update stats
+    runtime_state()->update_num_rows_load_filtered(counter.num_rows_filtered);
+    runtime_state()->update_num_rows_load_unselected(counter.num_rows_unselected);
+
+    COUNTER_UPDATE(_scanner_total_timer, counter.total_ns);
+    COUNTER_UPDATE(_scanner_fill_timer, counter.fill_ns);
+    COUNTER_UPDATE(_scanner_read_timer, counter.read_batch_ns);
+    COUNTER_UPDATE(_scanner_cast_chunk_timer, counter.cast_chunk_ns);
+    COUNTER_UPDATE(_scanner_materialize_timer, counter.materialize_ns);
+    COUNTER_UPDATE(_scanner_init_chunk_timer, counter.init_chunk_ns);
+
+    COUNTER_UPDATE(_scanner_file_reader_timer, counter.file_read_ns);
 
     // scanner is going to finish
     {
@@ -330,6 +446,7 @@ void FileScanNode::_scanner_worker(int start_idx, int length) {
     // If one scanner failed, others don't need scan any more
     if (!status.ok() && !status.is_end_of_file()) {
         _queue_writer_cond.notify_all();
+        _block_order_cond.notify_all();
     }
 }
 
@@ -21,6 +21,8 @@ struct ScannerCounter;
 
 namespace vectorized {
 
+class CSVBlockSplitter;
+
 class FileScanNode final : public ScanNode {
 public:
     FileScanNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs);
@@ -68,6 +70,19 @@ private:
     Status _scanner_scan(const TBrokerScanRange& scan_range, const std::vector<ExprContext*>& conjunct_ctxs,
                          ScannerCounter* counter);
 
+    // Whether the only file of this node is the plain CSV file of a stream load, which is split into blocks
+    // parsed by several workers.
+    bool _can_parse_in_parallel() const;
+
+    // One of the workers parsing the blocks of _block_splitter.
+    void _block_parse_worker();
+
+    // Push |chunk| to the queue, waiting while the queue is full. |*stop| is set to true if the scan should stop.
+    Status _push_chunk(ChunkPtr chunk, bool* stop);
+
+    // Report the counters and the status of a finished worker.
+    void _finish_scanner_worker(const Status& status, const ScannerCounter& counter);
+
     std::unique_ptr<FileScanner> _create_scanner(const TBrokerScanRange& scan_range, ScannerCounter* counter);
 
     TupleId _tuple_id;
@@ -93,6 +108,13 @@ private:
 
     std::vector<std::thread> _scanner_threads;
 
+    // Not null if the file is parsed by several _block_parse_worker.
+    std::unique_ptr<CSVBlockSplitter> _block_splitter;
+    // The sequence number of the block whose chunks are pushed to the queue next, the workers push the chunks of
+    // the blocks in order, so that the rows are loaded in the order of the file. Protected by _chunk_queue_lock.
+    int64_t _next_block_seq = 0;
+    std::condition_variable _block_order_cond;
+
     // Profile information
     RuntimeProfile::Counter* _wait_scanner_timer = nullptr;
     RuntimeProfile::Counter* _scanner_total_timer = nullptr;
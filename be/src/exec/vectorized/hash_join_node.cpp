@@ -9,6 +9,7 @@
 #include "column/column_helper.h"
 #include "column/fixed_length_column.h"
 #include "column/vectorized_fwd.h"
+#include "common/config.h"
 #include "exec/pipeline/exchange/exchange_source_operator.h"
 #include "exec/pipeline/hashjoin/hash_join_build_operator.h"
 #include "exec/pipeline/hashjoin/hash_join_probe_operator.h"
@@ -387,7 +388,24 @@ pipeline::OpFactories HashJoinNode::decompose_to_pipeline(pipeline::PipelineBuil
     auto lhs_operators = child(0)->decompose_to_pipeline(context);
     size_t num_right_partitions;
     size_t num_left_partitions;
-    if (_distribution_mode == TJoinDistributionMode::BROADCAST) {
+    // Only the join types which needn't post probe could be probed by multiple HashJoinProbeOperators
+    // against the sub hash tables, and null aware anti join needs to know whether the whole build side has null.
+    bool is_parallel_build = _distribution_mode == TJoinDistributionMode::BROADCAST &&
+                             config::enable_pipeline_parallel_broadcast_join_build &&
+                             context->degree_of_parallelism() > 1 &&
+                             (_join_type == TJoinOp::INNER_JOIN || _join_type == TJoinOp::LEFT_OUTER_JOIN ||
+                              _join_type == TJoinOp::LEFT_SEMI_JOIN || _join_type == TJoinOp::LEFT_ANTI_JOIN);
+    if (is_parallel_build) {
+        // Each HashJoinBuildOperator builds the sub hash table of one hash partition of the build side,
+        // and all the HashJoinProbeOperators probe all the sub hash tables.
+        num_right_partitions = context->degree_of_parallelism();
+        rhs_operators =
+                context->maybe_interpolate_local_shuffle_exchange(runtime_state(), rhs_operators, _build_expr_ctxs);
+
+        num_left_partitions = context->degree_of_parallelism();
+        lhs_operators = context->maybe_interpolate_local_passthrough_exchange(runtime_state(), lhs_operators,
+                                                                              num_left_partitions);
+    } else if (_distribution_mode == TJoinDistributionMode::BROADCAST) {
         num_right_partitions = 1;
         // Broadcast join need only create one hash table, because all the HashJoinProbeOperators
         // use the same hash table with their own different probe states.
@@ -469,6 +487,7 @@ pipeline::OpFactories HashJoinNode::decompose_to_pipeline(pipeline::PipelineBuil
                           _other_join_conjunct_ctxs, _conjunct_ctxs, child(1)->row_desc(), child(0)->row_desc(),
                           _row_descriptor, child(1)->type(), child(0)->type(), child(1)->conjunct_ctxs().empty(),
                           _build_runtime_filters, _output_slots, _distribution_mode);
+    param._is_parallel_build = is_parallel_build;
     auto hash_joiner_factory = std::make_shared<starrocks::pipeline::HashJoinerFactory>(param, num_left_partitions);
 
     // add placeholder into RuntimeFilterHub, HashJoinBuildOperator will generate runtime filters and fill it,
@@ -478,9 +497,15 @@ pipeline::OpFactories HashJoinNode::decompose_to_pipeline(pipeline::PipelineBuil
     // Create a shared RefCountedRuntimeFilterCollector
     auto&& rc_rf_probe_collector = std::make_shared<RcRfProbeCollector>(2, std::move(this->runtime_filter_collector()));
     // In default query engine, we only build one hash table for join right child.
-    // But for pipeline query engine, we will build `num_right_partitions` hash tables, so we need to enlarge the limit
-    std::unique_ptr<PartialRuntimeFilterMerger> partial_rf_merger = std::make_unique<PartialRuntimeFilterMerger>(
-            pool, _runtime_join_filter_pushdown_limit * num_right_partitions, num_right_partitions);
+    // But for pipeline query engine, we will build `num_right_partitions` hash tables, so we need to enlarge the limit.
+    // The sub hash tables built in parallel hold the same build side as the single one of broadcast join,
+    // so the limit applies to all of them.
+    size_t rf_limit = _runtime_join_filter_pushdown_limit;
+    if (!is_parallel_build) {
+        rf_limit *= num_right_partitions;
+    }
+    std::unique_ptr<PartialRuntimeFilterMerger> partial_rf_merger =
+            std::make_unique<PartialRuntimeFilterMerger>(pool, rf_limit, num_right_partitions);
 
     auto build_op = std::make_shared<HashJoinBuildOperatorFactory>(
             context->next_operator_id(), id(), hash_joiner_factory, std::move(partial_rf_merger), _distribution_mode);
@@ -9,18 +9,89 @@
 #include "column/column_helper.h"
 #include "column/fixed_length_column.h"
 #include "column/vectorized_fwd.h"
+#include "common/config.h"
 #include "exprs/expr.h"
 #include "exprs/vectorized/column_ref.h"
 #include "exprs/vectorized/in_const_predicate.hpp"
 #include "exprs/vectorized/runtime_filter_bank.h"
 #include "gutil/strings/substitute.h"
+#include "runtime/mem_tracker.h"
 #include "runtime/runtime_filter_worker.h"
 #include "simd/simd.h"
 #include "util/debug_util.h"
+#include "util/hash_util.hpp"
 #include "util/runtime_profile.h"
 
 namespace starrocks::vectorized {
 
+// All columns are spilled as nullable, so that all the spilled chunks have the same schema,
+// although the nullability of the input columns may vary from chunk to chunk.
+// The null indicator of each nullable tuple is spilled as a tuple column after the slot columns.
+static ChunkPtr create_spill_prototype(const RowDescriptor& row_desc) {
+    auto chunk = std::make_shared<Chunk>();
+    for (const auto& tuple_desc : row_desc.tuple_descriptors()) {
+        for (const auto& slot : tuple_desc->slots()) {
+            chunk->append_column(ColumnHelper::create_column(slot->type(), true), slot->id());
+        }
+    }
+    for (size_t i = 0; i < row_desc.tuple_descriptors().size(); ++i) {
+        if (row_desc.tuple_is_nullable(i)) {
+            chunk->append_tuple_column(BooleanColumn::create(), row_desc.tuple_descriptors()[i]->id());
+        }
+    }
+    return chunk;
+}
+
+static ChunkPtr to_spill_chunk(const Chunk& chunk, const RowDescriptor& row_desc, size_t offset, size_t count) {
+    auto spill_chunk = std::make_shared<Chunk>();
+    for (const auto& tuple_desc : row_desc.tuple_descriptors()) {
+        for (const auto& slot : tuple_desc->slots()) {
+            const ColumnPtr& column_in_chunk = chunk.get_column_by_slot_id(slot->id());
+            ColumnPtr src = ColumnHelper::unfold_const_column(slot->type(), chunk.num_rows(), column_in_chunk);
+            ColumnPtr column = ColumnHelper::create_column(slot->type(), true);
+            column->append(*src, offset, count);
+            spill_chunk->append_column(std::move(column), slot->id());
+        }
+    }
+    for (size_t i = 0; i < row_desc.tuple_descriptors().size(); ++i) {
+        if (!row_desc.tuple_is_nullable(i)) {
+            continue;
+        }
+        TupleId tuple_id = row_desc.tuple_descriptors()[i]->id();
+        ColumnPtr column;
+        if (chunk.is_tuple_exist(tuple_id)) {
+            column = BooleanColumn::create();
+            column->append(*chunk.get_tuple_column_by_id(tuple_id), offset, count);
+        } else {
+            // The chunk without tuple column has all its tuples present.
+            column = BooleanColumn::create(count, 1);
+        }
+        spill_chunk->append_tuple_column(column, tuple_id);
+    }
+    return spill_chunk;
+}
+
+// Restore the non-nullable columns turned into nullable by to_spill_chunk.
+static ChunkPtr from_spill_chunk(ChunkUniquePtr chunk, const RowDescriptor& row_desc) {
+    for (const auto& tuple_desc : row_desc.tuple_descriptors()) {
+        for (const auto& slot : tuple_desc->slots()) {
+            ColumnPtr& column = chunk->get_column_by_slot_id(slot->id());
+            if (!slot->is_nullable() && column->is_nullable() && !column->has_null()) {
+                column = down_cast<NullableColumn*>(column.get())->data_column();
+            }
+        }
+    }
+    return ChunkPtr(std::move(chunk));
+}
+
+static void update_spill_partition_counters(RuntimeProfile* runtime_profile, PartitionedSpiller* spiller) {
+    for (size_t i = 0; i < spiller->num_partitions(); ++i) {
+        auto* counter = ADD_CHILD_COUNTER(runtime_profile, strings::Substitute("Partition$0Bytes", i), TUnit::BYTES,
+                                          "SpilledBytes");
+        COUNTER_SET(counter, spiller->partition(i)->file_size());
+    }
+}
+
 HashJoiner::HashJoiner(const HashJoinerParam& param, const std::vector<HashJoinerPtr>& read_only_join_probers)
         : _hash_join_node(param._hash_join_node),
           _pool(param._pool),
@@ -39,7 +110,8 @@ HashJoiner::HashJoiner(const HashJoinerParam& param, const std::vector<HashJoine
           _output_slots(param._output_slots),
           _build_runtime_filters(param._build_runtime_filters),
           _is_buildable(param._is_buildable),
-          _read_only_join_probers(read_only_join_probers) {
+          _read_only_join_probers(read_only_join_probers),
+          _distribution_mode(param._distribution_mode) {
     _is_push_down = param._hash_join_node.is_push_down;
     if (_join_type == TJoinOp::LEFT_ANTI_JOIN && param._hash_join_node.is_rewritten_from_not_in) {
         _join_type = TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN;
@@ -73,6 +145,14 @@ Status HashJoiner::prepare_builder(RuntimeState* state, RuntimeProfile* runtime_
     _runtime_filter_num = ADD_COUNTER(runtime_profile, "RuntimeFilterNum", TUnit::UNIT);
     runtime_profile->add_info_string("JoinType", _get_join_type_str(_join_type));
 
+    _enable_spill = _is_spill_supported(state);
+    if (_enable_spill) {
+        _build_runtime_profile = runtime_profile;
+        _build_spill_timer = ADD_TIMER(runtime_profile, "SpillTime");
+        _spilled_build_rows = ADD_COUNTER(runtime_profile, "SpilledRows", TUnit::UNIT);
+        _spilled_build_bytes = ADD_COUNTER(runtime_profile, "SpilledBytes", TUnit::BYTES);
+    }
+
     HashTableParam param;
     _init_hash_table_param(&param);
     _ht.create(param);
@@ -99,6 +179,14 @@ Status HashJoiner::prepare_prober(RuntimeState* state, RuntimeProfile* runtime_p
     _other_join_conjunct_evaluate_timer = ADD_TIMER(runtime_profile, "OtherJoinConjunctEvaluateTime");
     _where_conjunct_evaluate_timer = ADD_TIMER(runtime_profile, "WhereConjunctEvaluateTime");
 
+    if (_is_spill_supported(state)) {
+        _probe_runtime_profile = runtime_profile;
+        _probe_spill_timer = ADD_TIMER(runtime_profile, "SpillTime");
+        _spill_restore_timer = ADD_TIMER(runtime_profile, "SpillRestoreTime");
+        _spilled_probe_rows = ADD_COUNTER(runtime_profile, "SpilledRows", TUnit::UNIT);
+        _spilled_probe_bytes = ADD_COUNTER(runtime_profile, "SpilledBytes", TUnit::BYTES);
+    }
+
     return Status::OK();
 }
 
@@ -140,6 +228,10 @@ Status HashJoiner::append_chunk_to_ht(RuntimeState* state, const ChunkPtr& chunk
     if (!chunk || chunk->is_empty()) {
         return Status::OK();
     }
+    if (is_spilled()) {
+        SCOPED_TIMER(_build_spill_timer);
+        return _spill_build_chunk(*chunk, 0, chunk->num_rows());
+    }
     if (UNLIKELY(_ht.get_row_count() + chunk->num_rows() >= UINT32_MAX)) {
         return Status::NotSupported(strings::Substitute("row count of right table in hash join > $0", UINT32_MAX));
     }
@@ -148,10 +240,21 @@ Status HashJoiner::append_chunk_to_ht(RuntimeState* state, const ChunkPtr& chunk
         SCOPED_TIMER(_copy_right_table_chunk_timer);
         RETURN_IF_ERROR(_ht.append_chunk(state, chunk));
     }
+    if (_enable_spill && _should_spill()) {
+        RETURN_IF_ERROR(_spill_hash_table(state));
+    }
     return Status::OK();
 }
 
 Status HashJoiner::build_ht(RuntimeState* state) {
+    if (_phase == HashJoinPhase::BUILD && is_spilled()) {
+        SCOPED_TIMER(_build_spill_timer);
+        _spill_status = _build_spiller->finish();
+        COUNTER_SET(_spilled_build_bytes, _build_spiller->spilled_bytes());
+        update_spill_partition_counters(_build_runtime_profile, _build_spiller.get());
+        return _spill_status;
+    }
+
     if (_phase == HashJoinPhase::BUILD) {
         RETURN_IF_ERROR(_build(state));
         COUNTER_SET(_build_buckets_counter, static_cast<int64_t>(_ht.get_bucket_size()));
@@ -184,17 +287,30 @@ bool HashJoiner::has_output() const {
     return false;
 }
 
-void HashJoiner::push_chunk(RuntimeState* state, ChunkPtr&& chunk) {
+Status HashJoiner::push_chunk(RuntimeState* state, ChunkPtr&& chunk) {
     DCHECK(chunk && !chunk->is_empty());
     DCHECK(!_probe_input_chunk);
 
+    if (is_spilled()) {
+        // The probe rows are joined partition by partition in POST_PROBE phase.
+        SCOPED_TIMER(_probe_spill_timer);
+        return _spill_probe_chunk(*chunk);
+    }
+
     _probe_input_chunk = std::move(chunk);
     _ht_has_remain = true;
     _prepare_probe_key_columns();
+    if (!_sub_hts.empty()) {
+        _partition_probe_chunk();
+    }
+    return Status::OK();
 }
 
 StatusOr<ChunkPtr> HashJoiner::pull_chunk(RuntimeState* state) {
     DCHECK(_phase != HashJoinPhase::BUILD);
+    if (is_spilled()) {
+        return _pull_spilled_output_chunk(state);
+    }
     return _pull_probe_output_chunk(state);
 }
 
@@ -206,13 +322,18 @@ StatusOr<ChunkPtr> HashJoiner::_pull_probe_output_chunk(RuntimeState* state) {
     if (_phase == HashJoinPhase::PROBE || _probe_input_chunk != nullptr) {
         DCHECK(_ht_has_remain && _probe_input_chunk);
 
-        RETURN_IF_ERROR(_ht.probe(state, _key_columns, &_probe_input_chunk, &chunk, &_ht_has_remain));
+        RETURN_IF_ERROR(_probe_ht->probe(state, _key_columns, &_probe_input_chunk, &chunk, &_ht_has_remain));
         if (!_ht_has_remain) {
             _probe_input_chunk = nullptr;
         }
 
         _filter_probe_output_chunk(chunk);
 
+        // Move to the next sub hash table after filtering, which may need the probe state of the current one.
+        if (_probe_input_chunk == nullptr && _partitioned_probe_chunk != nullptr) {
+            _next_probe_partition();
+        }
+
         return chunk;
     }
 
@@ -237,6 +358,9 @@ StatusOr<ChunkPtr> HashJoiner::_pull_probe_output_chunk(RuntimeState* state) {
 
 void HashJoiner::close(RuntimeState* state) {
     _ht.close();
+    _sub_hts.clear();
+    _build_spiller.reset();
+    _probe_spiller.reset();
 }
 
 Status HashJoiner::create_runtime_filters(RuntimeState* state) {
@@ -244,6 +368,17 @@ Status HashJoiner::create_runtime_filters(RuntimeState* state) {
         return Status::OK();
     }
 
+    if (is_spilled()) {
+        // The build rows are on disk and the hash table is built partition by partition later, so no filter
+        // covers all the build keys. Keeping the keys in memory would defeat the spilling, so both the local
+        // and the global filters are skipped, and their probers pass all the rows.
+        for (auto* rf_desc : _build_runtime_filters) {
+            rf_desc->set_is_pipeline(true);
+            _runtime_bloom_filter_build_params.emplace_back(false, nullptr, -1);
+        }
+        return Status::OK();
+    }
+
     uint64_t runtime_join_filter_pushdown_limit = 1024000;
     if (state->query_options().__isset.runtime_join_filter_pushdown_limit) {
         runtime_join_filter_pushdown_limit = state->query_options().runtime_join_filter_pushdown_limit;
@@ -277,6 +412,124 @@ void HashJoiner::reference_hash_table(HashJoiner* src_join_builder) {
     _build_column_count = src_join_builder->_build_column_count;
 }
 
+void HashJoiner::share_parallel_built_hash_tables(RuntimeState* state,
+                                                  const std::vector<HashJoinerPtr>& join_builders) {
+    DCHECK(!join_builders.empty());
+    size_t num_rows = 0;
+    for (const auto& join_builder : join_builders) {
+        num_rows += join_builder->_ht.get_row_count();
+    }
+
+    if (num_rows <= config::pipeline_parallel_join_build_merge_rows) {
+        HashJoiner* merged_builder = join_builders[0].get();
+        Status st = merged_builder->_merge_hash_tables(state, join_builders);
+        if (st.ok()) {
+            for (size_t i = 1; i < join_builders.size(); ++i) {
+                join_builders[i]->reference_hash_table(merged_builder);
+            }
+            return;
+        }
+        LOG(WARNING) << "Fail to merge the sub hash tables of hash join, probe them separately: " << st.to_string();
+    }
+
+    for (const auto& join_builder : join_builders) {
+        join_builder->_sub_hts.clear();
+        join_builder->_sub_hts.reserve(join_builders.size());
+        for (const auto& sub_builder : join_builders) {
+            JoinHashTable& sub_ht = join_builder->_sub_hts.emplace_back(sub_builder->_ht.clone_readable_table());
+            sub_ht.set_probe_profile(join_builder->_search_ht_timer, join_builder->_output_probe_column_timer,
+                                     join_builder->_output_tuple_column_timer);
+        }
+    }
+}
+
+Status HashJoiner::_merge_hash_tables(RuntimeState* state, const std::vector<HashJoinerPtr>& join_builders) {
+    JoinHashTable merged_ht;
+    HashTableParam param;
+    _init_hash_table_param(&param);
+    merged_ht.create(param);
+
+    for (const auto& join_builder : join_builders) {
+        const size_t num_rows = join_builder->_ht.get_row_count();
+        if (num_rows == 0) {
+            continue;
+        }
+        // Skip the first row reserved by the hash table.
+        const ChunkPtr& build_chunk = join_builder->_ht.get_build_chunk();
+        ChunkPtr chunk = build_chunk->clone_empty(num_rows);
+        chunk->append(*build_chunk, kHashJoinKeyColumnOffset, num_rows);
+        RETURN_IF_ERROR(merged_ht.append_chunk(state, chunk));
+    }
+
+    std::swap(_ht, merged_ht);
+    Status st = _build(state);
+    if (!st.ok()) {
+        std::swap(_ht, merged_ht);
+    }
+    return st;
+}
+
+void HashJoiner::_partition_probe_chunk() {
+    const size_t num_rows = _probe_input_chunk->num_rows();
+    const size_t num_partitions = _sub_hts.size();
+
+    _probe_partition_hashes.assign(num_rows, HashUtil::FNV_SEED);
+    for (const auto& column : _key_columns) {
+        column->fnv_hash(_probe_partition_hashes.data(), 0, num_rows);
+    }
+
+    _probe_partition_start_points.assign(num_partitions + 1, 0);
+    for (size_t i = 0; i < num_rows; ++i) {
+        _probe_partition_hashes[i] %= num_partitions;
+        _probe_partition_start_points[_probe_partition_hashes[i]]++;
+    }
+    for (size_t i = 1; i <= num_partitions; ++i) {
+        _probe_partition_start_points[i] += _probe_partition_start_points[i - 1];
+    }
+    _probe_partition_row_indexes.resize(num_rows);
+    for (int64_t i = num_rows - 1; i >= 0; --i) {
+        _probe_partition_row_indexes[--_probe_partition_start_points[_probe_partition_hashes[i]]] = i;
+    }
+
+    _partitioned_probe_chunk = std::move(_probe_input_chunk);
+    _partitioned_key_columns = std::move(_key_columns);
+    _probe_partition_idx = 0;
+    _next_probe_partition();
+}
+
+void HashJoiner::_next_probe_partition() {
+    _probe_input_chunk = nullptr;
+    while (_probe_partition_idx < _sub_hts.size()) {
+        const size_t partition = _probe_partition_idx++;
+        const uint32_t from = _probe_partition_start_points[partition];
+        const uint32_t size = _probe_partition_start_points[partition + 1] - from;
+        if (size == 0) {
+            continue;
+        }
+
+        _probe_ht = &_sub_hts[partition];
+        if (size == _partitioned_probe_chunk->num_rows()) {
+            _probe_input_chunk = std::move(_partitioned_probe_chunk);
+            _key_columns = std::move(_partitioned_key_columns);
+        } else {
+            _probe_input_chunk = _partitioned_probe_chunk->clone_empty(size);
+            _probe_input_chunk->append_selective(*_partitioned_probe_chunk, _probe_partition_row_indexes.data(), from,
+                                                 size);
+            _key_columns.resize(_partitioned_key_columns.size());
+            for (size_t i = 0; i < _key_columns.size(); ++i) {
+                _key_columns[i] = _partitioned_key_columns[i]->clone_empty();
+                _key_columns[i]->append_selective(*_partitioned_key_columns[i], _probe_partition_row_indexes.data(),
+                                                  from, size);
+            }
+        }
+        _ht_has_remain = true;
+        return;
+    }
+
+    _partitioned_probe_chunk = nullptr;
+    _partitioned_key_columns.clear();
+}
+
 void HashJoiner::set_builder_finished() {
     set_finished();
     for (auto& prober : _read_only_join_probers) {
@@ -323,6 +576,172 @@ Status HashJoiner::_build(RuntimeState* state) {
     return Status::OK();
 }
 
+bool HashJoiner::_is_spill_supported(RuntimeState* state) const {
+    // Broadcast join shares one hash table among all the probers, and null aware anti join needs to know
+    // whether there is null in the whole build side, so neither of them could be partitioned.
+    return state->enable_spill() && _distribution_mode != TJoinDistributionMode::BROADCAST &&
+           _join_type != TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN && _join_type != TJoinOp::CROSS_JOIN;
+}
+
+bool HashJoiner::_should_spill() {
+    int64_t ht_bytes = _ht.mem_usage();
+    if (ht_bytes < config::spill_operator_min_bytes) {
+        return false;
+    }
+    if (ht_bytes >= config::spill_operator_max_bytes) {
+        return true;
+    }
+    MemTracker* query_tracker = _runtime_state->query_mem_tracker_ptr().get();
+    return query_tracker != nullptr && query_tracker->has_limit() &&
+           query_tracker->consumption() >= query_tracker->limit() * config::spill_query_mem_limit_ratio;
+}
+
+Status HashJoiner::_spill_hash_table(RuntimeState* state) {
+    SCOPED_TIMER(_build_spill_timer);
+    size_t num_partitions = std::max(1, config::spill_partition_num);
+    ASSIGN_OR_RETURN(_build_spiller, PartitionedSpiller::create(state, "join_build", num_partitions));
+    ASSIGN_OR_RETURN(_probe_spiller, PartitionedSpiller::create(state, "join_probe", num_partitions));
+    _build_spill_prototype = create_spill_prototype(_build_row_descriptor);
+    _probe_spill_prototype = create_spill_prototype(_probe_row_descriptor);
+
+    // Move the rows buffered in the hash table to the spill files, the first row is reserved by the hash table.
+    const ChunkPtr& build_chunk = _ht.get_build_chunk();
+    const size_t end = _ht.get_row_count() + kHashJoinKeyColumnOffset;
+    for (size_t offset = kHashJoinKeyColumnOffset; offset < end; offset += state->chunk_size()) {
+        size_t count = std::min<size_t>(state->chunk_size(), end - offset);
+        RETURN_IF_ERROR(_spill_build_chunk(*build_chunk, offset, count));
+    }
+
+    _ht.close();
+    HashTableParam param;
+    _init_hash_table_param(&param);
+    _ht.create(param);
+    return Status::OK();
+}
+
+Status HashJoiner::_spill_build_chunk(const Chunk& chunk, size_t offset, size_t count) {
+    ChunkPtr spill_chunk = to_spill_chunk(chunk, _build_row_descriptor, offset, count);
+    _prepare_key_columns(_spill_key_columns, spill_chunk, _build_expr_ctxs);
+    RETURN_IF_ERROR(_build_spiller->spill(*spill_chunk, _spill_key_columns));
+    COUNTER_SET(_spilled_build_rows, _build_spiller->spilled_rows());
+    return Status::OK();
+}
+
+Status HashJoiner::_spill_probe_chunk(const Chunk& chunk) {
+    ChunkPtr spill_chunk = to_spill_chunk(chunk, _probe_row_descriptor, 0, chunk.num_rows());
+    _prepare_key_columns(_spill_key_columns, spill_chunk, _probe_expr_ctxs);
+    RETURN_IF_ERROR(_probe_spiller->spill(*spill_chunk, _spill_key_columns));
+    COUNTER_SET(_spilled_probe_rows, _probe_spiller->spilled_rows());
+    return Status::OK();
+}
+
+bool HashJoiner::_can_skip_spilled_partition(size_t build_rows, size_t probe_rows) const {
+    if (probe_rows == 0 && !_need_post_probe()) {
+        return true;
+    }
+    // Same as _short_circuit_break().
+    return build_rows == 0 && (_join_type == TJoinOp::INNER_JOIN || _join_type == TJoinOp::LEFT_SEMI_JOIN ||
+                               _join_type == TJoinOp::RIGHT_SEMI_JOIN || _join_type == TJoinOp::RIGHT_ANTI_JOIN ||
+                               _join_type == TJoinOp::RIGHT_OUTER_JOIN);
+}
+
+Status HashJoiner::_restore_spilled_build_partition(RuntimeState* state, SpillFile* partition) {
+    _ht.close();
+    HashTableParam param;
+    _init_hash_table_param(&param);
+    _ht.create(param);
+
+    while (true) {
+        auto chunk_or = partition->read(*_build_spill_prototype);
+        if (chunk_or.status().is_end_of_file()) {
+            break;
+        }
+        RETURN_IF_ERROR(chunk_or.status());
+        ChunkPtr chunk = from_spill_chunk(std::move(chunk_or.value()), _build_row_descriptor);
+        if (UNLIKELY(_ht.get_row_count() + chunk->num_rows() >= UINT32_MAX)) {
+            return Status::NotSupported(
+                    strings::Substitute("row count of spilled partition in hash join > $0", UINT32_MAX));
+        }
+        RETURN_IF_ERROR(_ht.append_chunk(state, chunk));
+    }
+    RETURN_IF_ERROR(partition->remove());
+    return _build(state);
+}
+
+StatusOr<ChunkPtr> HashJoiner::_pull_spilled_output_chunk(RuntimeState* state) {
+    DCHECK(_phase != HashJoinPhase::BUILD);
+    RETURN_IF_ERROR(_spill_status);
+
+    auto chunk = std::make_shared<Chunk>();
+    if (_phase != HashJoinPhase::POST_PROBE) {
+        return chunk;
+    }
+
+    if (!_probe_spiller->is_finished()) {
+        SCOPED_TIMER(_probe_spill_timer);
+        RETURN_IF_ERROR(_probe_spiller->finish());
+        COUNTER_SET(_spilled_probe_bytes, _probe_spiller->spilled_bytes());
+        update_spill_partition_counters(_probe_runtime_profile, _probe_spiller.get());
+    }
+
+    while (_spill_partition_idx < _build_spiller->num_partitions()) {
+        SpillFile* build_partition = _build_spiller->partition(_spill_partition_idx);
+        SpillFile* probe_partition = _probe_spiller->partition(_spill_partition_idx);
+
+        if (!_spill_partition_restored) {
+            if (_can_skip_spilled_partition(build_partition->num_rows(), probe_partition->num_rows())) {
+                RETURN_IF_ERROR(build_partition->remove());
+                RETURN_IF_ERROR(probe_partition->remove());
+                _spill_partition_idx++;
+                continue;
+            }
+            SCOPED_TIMER(_spill_restore_timer);
+            RETURN_IF_ERROR(_restore_spilled_build_partition(state, build_partition));
+            _spill_partition_restored = true;
+            _spill_partition_probe_eos = false;
+            _spill_partition_post_probe_eos = !_need_post_probe();
+        }
+
+        if (_probe_input_chunk != nullptr) {
+            RETURN_IF_ERROR(_ht.probe(state, _key_columns, &_probe_input_chunk, &chunk, &_ht_has_remain));
+            if (!_ht_has_remain) {
+                _probe_input_chunk = nullptr;
+            }
+            _filter_probe_output_chunk(chunk);
+            return chunk;
+        }
+
+        if (!_spill_partition_probe_eos) {
+            SCOPED_TIMER(_spill_restore_timer);
+            auto chunk_or = probe_partition->read(*_probe_spill_prototype);
+            if (chunk_or.status().is_end_of_file()) {
+                _spill_partition_probe_eos = true;
+                RETURN_IF_ERROR(probe_partition->remove());
+            } else {
+                RETURN_IF_ERROR(chunk_or.status());
+                _probe_input_chunk = from_spill_chunk(std::move(chunk_or.value()), _probe_row_descriptor);
+                _ht_has_remain = true;
+                _prepare_probe_key_columns();
+            }
+            continue;
+        }
+
+        if (!_spill_partition_post_probe_eos) {
+            bool has_remain = false;
+            RETURN_IF_ERROR(_ht.probe_remain(state, &chunk, &has_remain));
+            _spill_partition_post_probe_eos = !has_remain;
+            _filter_post_probe_output_chunk(chunk);
+            return chunk;
+        }
+
+        _spill_partition_idx++;
+        _spill_partition_restored = false;
+    }
+
+    enter_eos_phase();
+    return chunk;
+}
+
 void HashJoiner::_calc_filter_for_other_conjunct(ChunkPtr* chunk, Column::Filter& filter, bool& filter_all,
                                                  bool& hit_all) {
     filter_all = false;
@@ -396,7 +815,7 @@ void HashJoiner::_process_outer_join_with_other_conjunct(ChunkPtr* chunk, size_t
     _calc_filter_for_other_conjunct(chunk, filter, filter_all, hit_all);
     _process_row_for_other_conjunct(chunk, start_column, column_count, filter_all, hit_all, filter);
 
-    _ht.remove_duplicate_index(&filter);
+    _probe_ht->remove_duplicate_index(&filter);
     (*chunk)->filter(filter);
 }
 
@@ -407,7 +826,7 @@ void HashJoiner::_process_semi_join_with_other_conjunct(ChunkPtr* chunk) {
 
     _calc_filter_for_other_conjunct(chunk, filter, filter_all, hit_all);
 
-    _ht.remove_duplicate_index(&filter);
+    _probe_ht->remove_duplicate_index(&filter);
     (*chunk)->filter(filter);
 }
 
@@ -418,7 +837,7 @@ void HashJoiner::_process_right_anti_join_with_other_conjunct(ChunkPtr* chunk) {
 
     _calc_filter_for_other_conjunct(chunk, filter, filter_all, hit_all);
 
-    _ht.remove_duplicate_index(&filter);
+    _probe_ht->remove_duplicate_index(&filter);
     (*chunk)->set_num_rows(0);
 }
 
@@ -10,6 +10,7 @@
 #include "exec/pipeline/runtime_filter_types.h"
 #include "exec/vectorized/hash_join_node.h"
 #include "exec/vectorized/join_hash_map.h"
+#include "exec/vectorized/spiller.h"
 #include "exprs/vectorized/in_const_predicate.hpp"
 #include "util/phmap/phmap.h"
 
@@ -37,6 +38,11 @@ using HashJoinerPtr = std::shared_ptr<HashJoiner>;
 //   processed.
 // 4.DONE: all input streams have been processed.
 //
+// When spilling is enabled and the hash table grows beyond the budget in BUILD phase, HashJoiner turns into a grace
+// hash join: the build rows are hash partitioned by the join keys into spill files, so are the probe rows in PROBE
+// phase. In POST_PROBE phase, the partitions are joined one by one, each by building a hash table from the build
+// partition and probing it with the probe partition of the same index.
+//
 enum HashJoinPhase {
     BUILD = 0,
     PROBE = 1,
@@ -97,6 +103,8 @@ struct HashJoinerParam {
 
     const TJoinDistributionMode::type _distribution_mode;
     bool _is_buildable = false;
+    // Whether the hash table of broadcast join is built by all the drivers in parallel.
+    bool _is_parallel_build = false;
 };
 
 class HashJoiner final : public pipeline::ContextWithDependency {
@@ -119,10 +127,13 @@ public:
     bool is_done() const { return _phase == HashJoinPhase::EOS; }
 
     void enter_probe_phase() {
-        _short_circuit_break();
+        if (!is_spilled()) {
+            _short_circuit_break();
+        }
 
         auto old_phase = HashJoinPhase::BUILD;
         _phase.compare_exchange_strong(old_phase, HashJoinPhase::PROBE);
+        _observable.notify_observers();
     }
     void enter_post_probe_phase() {
         HashJoinPhase old_phase = HashJoinPhase::PROBE;
@@ -137,7 +148,7 @@ public:
     Status append_chunk_to_ht(RuntimeState* state, const ChunkPtr& chunk);
     Status build_ht(RuntimeState* state);
     // probe phase
-    void push_chunk(RuntimeState* state, ChunkPtr&& chunk);
+    Status push_chunk(RuntimeState* state, ChunkPtr&& chunk);
     StatusOr<ChunkPtr> pull_chunk(RuntimeState* state);
 
     std::list<ExprContext*>& get_runtime_in_filters() { return _runtime_in_filters; }
@@ -145,12 +156,22 @@ public:
     std::list<pipeline::RuntimeBloomFilterBuildParam>& get_runtime_bloom_filter_build_params() {
         return _runtime_bloom_filter_build_params;
     }
-    size_t get_ht_row_count() { return _ht.get_row_count(); }
+    size_t get_ht_row_count() {
+        // The rows of a spilled hash table are on disk, report them so that this hash table isn't taken as empty.
+        return is_spilled() ? _build_spiller->spilled_rows() : _ht.get_row_count();
+    }
+
+    bool is_spilled() const { return _build_spiller != nullptr; }
 
     Status create_runtime_filters(RuntimeState* state);
 
     void reference_hash_table(HashJoiner* src_join_builder);
 
+    // Called by the last finished builder of the parallel build of broadcast join, after all the sub hash tables
+    // are built. A small build side is merged into one hash table referenced by all the |join_builders|,
+    // otherwise every one of |join_builders| probes all the sub hash tables.
+    static void share_parallel_built_hash_tables(RuntimeState* state, const std::vector<HashJoinerPtr>& join_builders);
+
     bool is_buildable() const { return _is_buildable; }
 
     // These two methods are used only by the hash join builder.
@@ -195,9 +216,20 @@ private:
                _join_type == TJoinOp::FULL_OUTER_JOIN;
     }
 
+    size_t _build_row_count() const {
+        if (_sub_hts.empty()) {
+            return _ht.get_row_count();
+        }
+        size_t num_rows = 0;
+        for (const auto& sub_ht : _sub_hts) {
+            num_rows += sub_ht.get_row_count();
+        }
+        return num_rows;
+    }
+
     void _short_circuit_break() {
         // special cases of short-circuit break.
-        if (_ht.get_row_count() == 0 &&
+        if (_build_row_count() == 0 &&
             (_join_type == TJoinOp::INNER_JOIN || _join_type == TJoinOp::LEFT_SEMI_JOIN ||
              _join_type == TJoinOp::RIGHT_SEMI_JOIN || _join_type == TJoinOp::RIGHT_ANTI_JOIN ||
              _join_type == TJoinOp::RIGHT_OUTER_JOIN)) {
@@ -221,6 +253,19 @@ private:
     }
 
     Status _build(RuntimeState* state);
+    Status _merge_hash_tables(RuntimeState* state, const std::vector<HashJoinerPtr>& join_builders);
+    void _partition_probe_chunk();
+    void _next_probe_partition();
+
+    bool _is_spill_supported(RuntimeState* state) const;
+    bool _should_spill();
+    Status _spill_hash_table(RuntimeState* state);
+    Status _spill_build_chunk(const Chunk& chunk, size_t offset, size_t count);
+    Status _spill_probe_chunk(const Chunk& chunk);
+    bool _can_skip_spilled_partition(size_t build_rows, size_t probe_rows) const;
+    Status _restore_spilled_build_partition(RuntimeState* state, SpillFile* partition);
+    StatusOr<ChunkPtr> _pull_spilled_output_chunk(RuntimeState* state);
+
     Status _probe(RuntimeState* state, ScopedTimer<MonotonicStopWatch>& probe_timer, ChunkPtr* chunk, bool& eos);
 
     StatusOr<ChunkPtr> _pull_probe_output_chunk(RuntimeState* state);
@@ -353,6 +398,18 @@ private:
     bool _is_push_down = false;
 
     JoinHashTable _ht;
+    // The sub hash tables of the parallel build of broadcast join, probe rows are dispatched to them by the hash
+    // of join keys, in the same way as the local shuffle exchange of the build side.
+    std::vector<JoinHashTable> _sub_hts;
+    // The hash table probed by _probe_input_chunk.
+    JoinHashTable* _probe_ht = &_ht;
+    // The probe chunk being dispatched to _sub_hts.
+    ChunkPtr _partitioned_probe_chunk;
+    Columns _partitioned_key_columns;
+    std::vector<uint32_t> _probe_partition_hashes;
+    std::vector<uint32_t> _probe_partition_row_indexes;
+    std::vector<uint32_t> _probe_partition_start_points;
+    size_t _probe_partition_idx = 0;
 
     Columns _key_columns;
     size_t _probe_column_count = 0;
@@ -368,6 +425,23 @@ private:
     const std::vector<HashJoinerPtr>& _read_only_join_probers;
     std::atomic<size_t> _num_unfinished_probers = 0;
 
+    const TJoinDistributionMode::type _distribution_mode;
+
+    // Grace hash join, both spillers are created once the hash table is spilled.
+    bool _enable_spill = false;
+    std::unique_ptr<PartitionedSpiller> _build_spiller;
+    std::unique_ptr<PartitionedSpiller> _probe_spiller;
+    ChunkPtr _build_spill_prototype;
+    ChunkPtr _probe_spill_prototype;
+    Columns _spill_key_columns;
+    // The error hit when finishing the build spiller, which could not be returned by HashJoinBuildOperator.
+    Status _spill_status;
+    // Partition being joined in POST_PROBE phase.
+    size_t _spill_partition_idx = 0;
+    bool _spill_partition_restored = false;
+    bool _spill_partition_probe_eos = false;
+    bool _spill_partition_post_probe_eos = false;
+
     // Profile for hash join builder.
     RuntimeProfile::Counter* _build_ht_timer = nullptr;
     RuntimeProfile::Counter* _copy_right_table_chunk_timer = nullptr;
@@ -375,6 +449,10 @@ private:
     RuntimeProfile::Counter* _output_build_column_timer = nullptr;
     RuntimeProfile::Counter* _build_buckets_counter = nullptr;
     RuntimeProfile::Counter* _runtime_filter_num = nullptr;
+    RuntimeProfile* _build_runtime_profile = nullptr;
+    RuntimeProfile::Counter* _build_spill_timer = nullptr;
+    RuntimeProfile::Counter* _spilled_build_rows = nullptr;
+    RuntimeProfile::Counter* _spilled_build_bytes = nullptr;
 
     // Profile for hash join prober.
     RuntimeProfile::Counter* _search_ht_timer = nullptr;
@@ -384,6 +462,11 @@ private:
     RuntimeProfile::Counter* _probe_conjunct_evaluate_timer = nullptr;
     RuntimeProfile::Counter* _other_join_conjunct_evaluate_timer = nullptr;
     RuntimeProfile::Counter* _where_conjunct_evaluate_timer = nullptr;
+    RuntimeProfile* _probe_runtime_profile = nullptr;
+    RuntimeProfile::Counter* _probe_spill_timer = nullptr;
+    RuntimeProfile::Counter* _spill_restore_timer = nullptr;
+    RuntimeProfile::Counter* _spilled_probe_rows = nullptr;
+    RuntimeProfile::Counter* _spilled_probe_bytes = nullptr;
 };
 
 } // namespace vectorized
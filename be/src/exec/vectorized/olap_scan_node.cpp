@@ -388,6 +388,8 @@ void OlapScanNode::_init_counter(RuntimeState* state) {
     _seg_init_timer = ADD_TIMER(_scan_profile, "SegmentInit");
     _bi_filter_timer = ADD_CHILD_TIMER(_scan_profile, "BitmapIndexFilter", "SegmentInit");
     _bi_filtered_counter = ADD_CHILD_COUNTER(_scan_profile, "BitmapIndexFilterRows", TUnit::UNIT, "SegmentInit");
+    _ii_filter_timer = ADD_CHILD_TIMER(_scan_profile, "InvertedIndexFilter", "SegmentInit");
+    _ii_filtered_counter = ADD_CHILD_COUNTER(_scan_profile, "InvertedIndexFilterRows", TUnit::UNIT, "SegmentInit");
     _bf_filtered_counter = ADD_CHILD_COUNTER(_scan_profile, "BloomFilterFilterRows", TUnit::UNIT, "SegmentInit");
     _seg_zm_filtered_counter = ADD_CHILD_COUNTER(_scan_profile, "SegmentZoneMapFilterRows", TUnit::UNIT, "SegmentInit");
     _zm_filtered_counter = ADD_CHILD_COUNTER(_scan_profile, "ZoneMapIndexFilterRows", TUnit::UNIT, "SegmentInit");
@@ -401,7 +403,10 @@ void OlapScanNode::_init_counter(RuntimeState* state) {
     _block_seek_counter = ADD_CHILD_COUNTER(_scan_profile, "BlockSeekCount", TUnit::UNIT, "SegmentRead");
     _pred_filter_timer = ADD_CHILD_TIMER(_scan_profile, "PredFilter", "SegmentRead");
     _pred_filter_counter = ADD_CHILD_COUNTER(_scan_profile, "PredFilterRows", TUnit::UNIT, "SegmentRead");
+    _pred_filter_encoded_counter =
+            ADD_CHILD_COUNTER(_scan_profile, "PredFilterEncodedRows", TUnit::UNIT, "PredFilterRows");
     _del_vec_filter_counter = ADD_CHILD_COUNTER(_scan_profile, "DelVecFilterRows", TUnit::UNIT, "SegmentRead");
+    _rf_filter_counter = ADD_CHILD_COUNTER(_scan_profile, "RuntimeFilterRows", TUnit::UNIT, "SegmentRead");
     _chunk_copy_timer = ADD_CHILD_TIMER(_scan_profile, "ChunkCopy", "SegmentRead");
     _decompress_timer = ADD_CHILD_TIMER(_scan_profile, "DecompressT", "SegmentRead");
     _index_load_timer = ADD_CHILD_TIMER(_scan_profile, "IndexLoad", "SegmentRead");
@@ -409,6 +414,10 @@ void OlapScanNode::_init_counter(RuntimeState* state) {
     _segments_read_count = ADD_CHILD_COUNTER(_scan_profile, "SegmentsReadCount", TUnit::UNIT, "SegmentRead");
     _total_columns_data_page_count =
             ADD_CHILD_COUNTER(_scan_profile, "TotalColumnsDataPageCount", TUnit::UNIT, "SegmentRead");
+    _prefetch_io_counter = ADD_CHILD_COUNTER(_scan_profile, "PrefetchIOCount", TUnit::UNIT, "SegmentRead");
+    _prefetch_io_saved_counter = ADD_CHILD_COUNTER(_scan_profile, "PrefetchIOSaved", TUnit::UNIT, "SegmentRead");
+    _prefetch_bytes_counter = ADD_CHILD_COUNTER(_scan_profile, "PrefetchBytes", TUnit::BYTES, "SegmentRead");
+    _prefetch_hit_bytes_counter = ADD_CHILD_COUNTER(_scan_profile, "PrefetchHitBytes", TUnit::BYTES, "SegmentRead");
 
     /// IOTime
     _io_timer = ADD_TIMER(_scan_profile, "IOTime");
@@ -164,7 +164,9 @@ private:
     RuntimeProfile::Counter* _read_uncompressed_counter = nullptr;
     RuntimeProfile::Counter* _raw_rows_counter = nullptr;
     RuntimeProfile::Counter* _pred_filter_counter = nullptr;
+    RuntimeProfile::Counter* _pred_filter_encoded_counter = nullptr;
     RuntimeProfile::Counter* _del_vec_filter_counter = nullptr;
+    RuntimeProfile::Counter* _rf_filter_counter = nullptr;
     RuntimeProfile::Counter* _pred_filter_timer = nullptr;
     RuntimeProfile::Counter* _chunk_copy_timer = nullptr;
     RuntimeProfile::Counter* _seg_init_timer = nullptr;
@@ -182,10 +184,16 @@ private:
     RuntimeProfile::Counter* _cached_pages_num_counter = nullptr;
     RuntimeProfile::Counter* _bi_filtered_counter = nullptr;
     RuntimeProfile::Counter* _bi_filter_timer = nullptr;
+    RuntimeProfile::Counter* _ii_filtered_counter = nullptr;
+    RuntimeProfile::Counter* _ii_filter_timer = nullptr;
     RuntimeProfile::Counter* _pushdown_predicates_counter = nullptr;
     RuntimeProfile::Counter* _rowsets_read_count = nullptr;
     RuntimeProfile::Counter* _segments_read_count = nullptr;
     RuntimeProfile::Counter* _total_columns_data_page_count = nullptr;
+    RuntimeProfile::Counter* _prefetch_io_counter = nullptr;
+    RuntimeProfile::Counter* _prefetch_io_saved_counter = nullptr;
+    RuntimeProfile::Counter* _prefetch_bytes_counter = nullptr;
+    RuntimeProfile::Counter* _prefetch_hit_bytes_counter = nullptr;
 };
 
 } // namespace starrocks::vectorized
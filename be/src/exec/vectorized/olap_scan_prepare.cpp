@@ -7,13 +7,16 @@
 
 #include "column/type_traits.h"
 #include "exprs/vectorized/in_const_predicate.hpp"
+#include "exprs/vectorized/runtime_filter_bank.h"
 #include "gutil/map_util.h"
 #include "runtime/date_value.hpp"
 #include "runtime/descriptors.h"
 #include "runtime/primitive_type.h"
 #include "runtime/primitive_type_infra.h"
+#include "storage/tablet_schema.h"
 #include "storage/vectorized/column_predicate.h"
 #include "storage/vectorized/predicate_parser.h"
+#include "storage/vectorized/runtime_filter_predicate.h"
 
 namespace starrocks {
 namespace vectorized {
@@ -641,6 +644,103 @@ Status OlapScanConjunctsManager::get_column_predicates(PredicateParser* parser,
     return Status::OK();
 }
 
+struct RuntimeFilterRangeBuilder {
+    template <PrimitiveType ptype>
+    std::nullptr_t operator()(const SlotDescriptor* slot, const JoinRuntimeFilter* rf, std::vector<TCondition>* filters) {
+        if constexpr (ptype == TYPE_TIME || ptype == TYPE_NULL || ptype == TYPE_JSON || pt_is_float<ptype>) {
+            return nullptr;
+        } else {
+            // Same as ColumnRangeBuilder
+            constexpr PrimitiveType limit_type = ptype == TYPE_TINYINT || ptype == TYPE_BOOLEAN ? TYPE_INT : ptype;
+            constexpr PrimitiveType mapping_type = ptype == TYPE_CHAR ? TYPE_VARCHAR : ptype;
+            using value_type = typename RunTimeTypeLimits<limit_type>::value_type;
+
+            const auto* filter = down_cast<const RuntimeBloomFilter<mapping_type>*>(rf);
+            if (filter->has_null() || !filter->has_min_max()) {
+                return nullptr;
+            }
+            ColumnValueRange<value_type> range(slot->col_name(), ptype, RunTimeTypeLimits<ptype>::min_value(),
+                                               RunTimeTypeLimits<ptype>::max_value());
+            if constexpr (pt_is_decimal<limit_type>) {
+                range.set_precision(slot->type().precision);
+                range.set_scale(slot->type().scale);
+            }
+            range.add_range(to_olap_filter_type(TExprOpcode::GE, false), static_cast<value_type>(filter->min_value()));
+            range.add_range(to_olap_filter_type(TExprOpcode::LE, false), static_cast<value_type>(filter->max_value()));
+            range.to_olap_filter(*filters);
+            return nullptr;
+        }
+    }
+};
+
+// Adapts a join runtime filter on a slot of the scan to storage.
+class JoinRuntimeFilterPredicate final : public RuntimeFilterPredicate {
+public:
+    JoinRuntimeFilterPredicate(ColumnId column_id, const RuntimeFilterProbeDescriptor* desc, const SlotDescriptor* slot,
+                               const TabletSchema* schema)
+            : RuntimeFilterPredicate(column_id), _desc(desc), _slot(slot), _schema(schema) {}
+
+    bool is_ready() const override { return _desc->runtime_filter() != nullptr; }
+
+    Status get_zone_map_predicates(ObjectPool* pool, std::vector<const ColumnPredicate*>* preds) const override {
+        std::vector<TCondition> filters;
+        type_dispatch_predicate<std::nullptr_t>(_slot->type().type, false, RuntimeFilterRangeBuilder(), _slot,
+                                                _desc->runtime_filter(), &filters);
+        PredicateParser parser(*_schema);
+        for (const auto& f : filters) {
+            ColumnPredicate* p = parser.parse_thrift_cond(f);
+            RETURN_IF(p == nullptr, Status::RuntimeError("invalid filter"));
+            preds->emplace_back(pool->add(p));
+        }
+        return Status::OK();
+    }
+
+    void evaluate_and(Column* column, uint8_t* selection) const override {
+        const Column::Filter& filter = _desc->runtime_filter()->evaluate(column, &_running_ctx);
+        const size_t size = column->size();
+        for (size_t i = 0; i < size; i++) {
+            selection[i] &= filter[i];
+        }
+    }
+
+private:
+    const RuntimeFilterProbeDescriptor* _desc;
+    const SlotDescriptor* _slot;
+    const TabletSchema* _schema;
+    mutable JoinRuntimeFilter::RunningContext _running_ctx;
+};
+
+void OlapScanConjunctsManager::get_runtime_filter_predicates(
+        const TabletSchema& schema, const ColumnIdToGlobalDictMap& global_dictmaps,
+        std::vector<std::unique_ptr<RuntimeFilterPredicate>>* preds) {
+    if (runtime_filters == nullptr) {
+        return;
+    }
+    PredicateParser parser(schema);
+    for (const auto& [filter_id, desc] : runtime_filters->descriptors()) {
+        SlotId slot_id;
+        if (!desc->is_probe_slot_ref(&slot_id)) {
+            continue;
+        }
+        const SlotDescriptor* slot = nullptr;
+        for (const SlotDescriptor* s : tuple_desc->slots()) {
+            if (s->id() == slot_id) {
+                slot = s;
+                break;
+            }
+        }
+        // The values of CHAR columns may be padded in storage.
+        if (slot == nullptr || desc->probe_expr_type() != slot->type().type || slot->type().type == TYPE_CHAR) {
+            continue;
+        }
+        const int32_t column_id = schema.field_index(slot->col_name());
+        if (column_id < 0 || global_dictmaps.count(column_id) || !parser.can_pushdown(column_id)) {
+            continue;
+        }
+        preds->emplace_back(std::make_unique<JoinRuntimeFilterPredicate>(column_id, desc, slot, &schema));
+    }
+}
+
 void OlapScanConjunctsManager::eval_const_conjuncts(const std::vector<ExprContext*>& conjunct_ctxs, Status* status) {
     *status = Status::OK();
     for (const auto& ctx_iter : conjunct_ctxs) {
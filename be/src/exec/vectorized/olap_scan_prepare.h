@@ -6,14 +6,17 @@
 #include "exec/olap_common.h"
 #include "exprs/expr.h"
 #include "exprs/expr_context.h"
+#include "runtime/global_dicts.h"
 
 namespace starrocks {
 class RuntimeState;
+class TabletSchema;
 namespace vectorized {
 
 class RuntimeFilterProbeCollector;
 class PredicateParser;
 class ColumnPredicate;
+class RuntimeFilterPredicate;
 
 class OlapScanConjunctsManager {
 public:
@@ -40,6 +43,11 @@ public:
 
     Status get_column_predicates(PredicateParser* parser, std::vector<std::unique_ptr<ColumnPredicate>>* preds);
 
+    // Get the join runtime filters which could be probed in storage, whether they have arrived or not.
+    // Filters on the columns with global dicts, or which couldn't be filtered before aggregation, are skipped.
+    void get_runtime_filter_predicates(const TabletSchema& schema, const ColumnIdToGlobalDictMap& global_dictmaps,
+                                       std::vector<std::unique_ptr<RuntimeFilterPredicate>>* preds);
+
     Status get_key_ranges(std::vector<std::unique_ptr<OlapScanRange>>* key_ranges);
 
     void get_not_push_down_conjuncts(std::vector<ExprContext*>* predicates);
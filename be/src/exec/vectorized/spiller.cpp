@@ -0,0 +1,272 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "exec/vectorized/spiller.h"
+
+#include <atomic>
+
+#include "column/column.h"
+#include "common/config.h"
+#include "env/env.h"
+#include "fmt/format.h"
+#include "gutil/strings/split.h"
+#include "runtime/runtime_state.h"
+#include "serde/column_array_serde.h"
+#include "util/block_compression.h"
+#include "util/coding.h"
+#include "util/hash_util.hpp"
+#include "util/uid_util.h"
+
+namespace starrocks::vectorized {
+
+static constexpr size_t kSpillBlockHeaderSize = 4 + 8 + 8;
+
+SpillFile::~SpillFile() {
+    WARN_IF_ERROR(remove(), "Fail to remove spill file " + _path);
+}
+
+Status SpillFile::_init_codec() {
+    if (!_codec_inited) {
+        RETURN_IF_ERROR(get_block_compression_codec(CompressionTypePB::LZ4, &_codec));
+        _codec_inited = true;
+    }
+    return Status::OK();
+}
+
+Status SpillFile::append(const Chunk& chunk) {
+    DCHECK(_reader == nullptr);
+    if (chunk.num_rows() == 0) {
+        return Status::OK();
+    }
+    RETURN_IF_ERROR(_init_codec());
+    if (_writer == nullptr) {
+        ASSIGN_OR_RETURN(_writer, Env::Default()->new_writable_file(_path));
+    }
+
+    int64_t max_size = 0;
+    for (const auto& column : chunk.columns()) {
+        int64_t size = serde::ColumnArraySerde::max_serialized_size(*column);
+        if (UNLIKELY(size == 0)) {
+            return Status::NotSupported("spill unsupported column " + column->get_name());
+        }
+        max_size += size;
+    }
+    _serialize_buffer.resize(kSpillBlockHeaderSize + max_size);
+    uint8_t* buff = _serialize_buffer.data() + kSpillBlockHeaderSize;
+    for (const auto& column : chunk.columns()) {
+        buff = serde::ColumnArraySerde::serialize(*column, buff);
+        if (UNLIKELY(buff == nullptr)) {
+            return Status::InternalError("serialize spilled column failed");
+        }
+    }
+    const uint64_t uncompressed_size = buff - (_serialize_buffer.data() + kSpillBlockHeaderSize);
+
+    Slice data(_serialize_buffer.data() + kSpillBlockHeaderSize, uncompressed_size);
+    if (_codec != nullptr && !_codec->exceed_max_input_size(uncompressed_size)) {
+        _compress_buffer.resize(kSpillBlockHeaderSize + _codec->max_compressed_len(uncompressed_size));
+        Slice compressed(_compress_buffer.data() + kSpillBlockHeaderSize,
+                         _compress_buffer.size() - kSpillBlockHeaderSize);
+        RETURN_IF_ERROR(_codec->compress(data, &compressed));
+        if (compressed.size < uncompressed_size) {
+            data = compressed;
+        }
+    }
+
+    uint8_t* header = (uint8_t*)data.data - kSpillBlockHeaderSize;
+    encode_fixed32_le(header, chunk.num_rows());
+    encode_fixed64_le(header + 4, uncompressed_size);
+    encode_fixed64_le(header + 12, data.size);
+    RETURN_IF_ERROR(_writer->append(Slice(header, kSpillBlockHeaderSize + data.size)));
+
+    _num_rows += chunk.num_rows();
+    _num_chunks++;
+    _file_size += kSpillBlockHeaderSize + data.size;
+    return Status::OK();
+}
+
+Status SpillFile::finish() {
+    if (_writer != nullptr) {
+        RETURN_IF_ERROR(_writer->close());
+        _writer.reset();
+    }
+    _serialize_buffer.clear();
+    _serialize_buffer.shrink_to_fit();
+    _compress_buffer.clear();
+    _compress_buffer.shrink_to_fit();
+    return Status::OK();
+}
+
+StatusOr<ChunkUniquePtr> SpillFile::read(const Chunk& prototype) {
+    DCHECK(_writer == nullptr);
+    if (_num_chunks == 0 || _read_offset >= _file_size) {
+        return Status::EndOfFile("no more spilled chunk");
+    }
+    if (_removed) {
+        return Status::InternalError("spill file has been removed: " + _path);
+    }
+    RETURN_IF_ERROR(_init_codec());
+    if (_reader == nullptr) {
+        ASSIGN_OR_RETURN(_reader, Env::Default()->new_random_access_file(_path));
+    }
+
+    uint8_t header[kSpillBlockHeaderSize];
+    RETURN_IF_ERROR(_reader->read_at_fully(_read_offset, header, kSpillBlockHeaderSize));
+    const uint32_t num_rows = decode_fixed32_le(header);
+    const uint64_t uncompressed_size = decode_fixed64_le(header + 4);
+    const uint64_t stored_size = decode_fixed64_le(header + 12);
+    _read_offset += kSpillBlockHeaderSize;
+
+    _serialize_buffer.resize(uncompressed_size);
+    if (stored_size < uncompressed_size) {
+        if (UNLIKELY(_codec == nullptr)) {
+            return Status::Corruption("compressed spill block without codec");
+        }
+        _compress_buffer.resize(stored_size);
+        RETURN_IF_ERROR(_reader->read_at_fully(_read_offset, _compress_buffer.data(), stored_size));
+        Slice output(_serialize_buffer.data(), uncompressed_size);
+        RETURN_IF_ERROR(_codec->decompress(Slice(_compress_buffer.data(), stored_size), &output));
+        if (UNLIKELY(output.size != uncompressed_size)) {
+            return Status::Corruption(fmt::format("spill block size mismatch: {} vs {}", output.size,
+                                                  uncompressed_size));
+        }
+    } else {
+        RETURN_IF_ERROR(_reader->read_at_fully(_read_offset, _serialize_buffer.data(), stored_size));
+    }
+    _read_offset += stored_size;
+
+    ChunkUniquePtr chunk = prototype.clone_empty_with_tuple(num_rows);
+    const uint8_t* buff = _serialize_buffer.data();
+    for (auto& column : chunk->columns()) {
+        buff = serde::ColumnArraySerde::deserialize(buff, column.get());
+        if (UNLIKELY(buff == nullptr || column->size() != num_rows)) {
+            return Status::Corruption("deserialize spilled chunk failed: " + _path);
+        }
+    }
+    return std::move(chunk);
+}
+
+Status SpillFile::remove() {
+    if (_removed) {
+        return Status::OK();
+    }
+    _removed = true;
+    _writer.reset();
+    _reader.reset();
+    if (_file_size == 0) {
+        // Nothing has been written, the file was never created.
+        return Status::OK();
+    }
+    return Env::Default()->delete_file(_path);
+}
+
+PartitionedSpiller::PartitionedSpiller(std::string path_prefix, size_t num_partitions, uint32_t hash_seed)
+        : _hash_seed(hash_seed) {
+    DCHECK_GT(num_partitions, 0);
+    _partitions.reserve(num_partitions);
+    for (size_t i = 0; i < num_partitions; ++i) {
+        _partitions.emplace_back(std::make_unique<SpillFile>(fmt::format("{}_{}", path_prefix, i)));
+    }
+}
+
+StatusOr<std::unique_ptr<PartitionedSpiller>> PartitionedSpiller::create(RuntimeState* state,
+                                                                         const std::string& name,
+                                                                         size_t num_partitions, uint32_t hash_seed) {
+    static std::atomic<uint64_t> s_spiller_seq{0};
+
+    std::vector<std::string> dirs =
+            strings::Split(config::query_scratch_dirs, ";", strings::SkipWhitespace());
+    if (dirs.empty()) {
+        return Status::InternalError("query_scratch_dirs is empty, could not spill");
+    }
+    uint64_t seq = s_spiller_seq.fetch_add(1);
+    std::string dir = dirs[seq % dirs.size()] + "/spill";
+    RETURN_IF_ERROR(Env::Default()->create_dir_if_missing(dir));
+
+    std::string path_prefix =
+            fmt::format("{}/{}_{}_{}", dir, print_id(state->fragment_instance_id()), name, seq);
+    return std::make_unique<PartitionedSpiller>(std::move(path_prefix), num_partitions, hash_seed);
+}
+
+void PartitionedSpiller::compute_partition_hash(const Columns& key_columns, size_t num_rows,
+                                                std::vector<uint32_t>* hash_values, uint32_t hash_seed) {
+    hash_values->assign(num_rows, hash_seed);
+    for (const auto& column : key_columns) {
+        column->fnv_hash(hash_values->data(), 0, num_rows);
+    }
+    // The input may already be partitioned by FNV hash (e.g. shuffled by exchange), scramble
+    // the hash values so that the rows are still distributed evenly among the spill partitions.
+    for (auto& hash : *hash_values) {
+        hash = static_cast<uint32_t>((static_cast<uint64_t>(hash) * 0x9E3779B97F4A7C15ULL) >> 32);
+    }
+}
+
+Status PartitionedSpiller::spill(const Chunk& chunk, const Columns& key_columns) {
+    compute_partition_hash(key_columns, chunk.num_rows(), &_hash_values, _hash_seed);
+    return spill(chunk, _hash_values);
+}
+
+Status PartitionedSpiller::spill(const Chunk& chunk, const std::vector<uint32_t>& hash_values) {
+    DCHECK(!_is_finished);
+    const size_t num_rows = chunk.num_rows();
+    if (num_rows == 0) {
+        return Status::OK();
+    }
+    DCHECK_EQ(num_rows, hash_values.size());
+    const size_t num_partitions = _partitions.size();
+    if (num_partitions == 1) {
+        RETURN_IF_ERROR(_partitions[0]->append(chunk));
+        _spilled_rows += num_rows;
+        return Status::OK();
+    }
+
+    // Counting sort the row indexes by partition, like ExchangeSinkOperator does for channels.
+    _partition_row_start_points.assign(num_partitions + 1, 0);
+    for (size_t i = 0; i < num_rows; ++i) {
+        _partition_row_start_points[partition_index(hash_values[i])]++;
+    }
+    for (size_t i = 1; i <= num_partitions; ++i) {
+        _partition_row_start_points[i] += _partition_row_start_points[i - 1];
+    }
+    _row_indexes.resize(num_rows);
+    for (int64_t i = num_rows - 1; i >= 0; --i) {
+        size_t p = partition_index(hash_values[i]);
+        _row_indexes[--_partition_row_start_points[p]] = i;
+    }
+
+    for (size_t p = 0; p < num_partitions; ++p) {
+        uint32_t from = _partition_row_start_points[p];
+        uint32_t size = _partition_row_start_points[p + 1] - from;
+        if (size == 0) {
+            continue;
+        }
+        if (size == num_rows) {
+            RETURN_IF_ERROR(_partitions[p]->append(chunk));
+            continue;
+        }
+        ChunkUniquePtr part = chunk.clone_empty_with_tuple(size);
+        part->append_selective(chunk, _row_indexes.data(), from, size);
+        RETURN_IF_ERROR(_partitions[p]->append(*part));
+    }
+    _spilled_rows += num_rows;
+    return Status::OK();
+}
+
+Status PartitionedSpiller::finish() {
+    if (_is_finished) {
+        return Status::OK();
+    }
+    _is_finished = true;
+    for (auto& partition : _partitions) {
+        RETURN_IF_ERROR(partition->finish());
+    }
+    return Status::OK();
+}
+
+int64_t PartitionedSpiller::spilled_bytes() const {
+    int64_t bytes = 0;
+    for (const auto& partition : _partitions) {
+        bytes += partition->file_size();
+    }
+    return bytes;
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,129 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "column/chunk.h"
+#include "column/vectorized_fwd.h"
+#include "common/statusor.h"
+#include "util/hash_util.hpp"
+#include "util/raw_container.h"
+
+namespace starrocks {
+class BlockCompressionCodec;
+class RandomAccessFile;
+class RuntimeState;
+class WritableFile;
+} // namespace starrocks
+
+namespace starrocks::vectorized {
+
+// SpillFile stores a sequence of chunks with the same schema in a local file.
+// Each chunk is written as one block:
+//   | num rows (4 bytes) | uncompressed size (8 bytes) | stored size (8 bytes) | data |
+// Data is the columns serialized one after another by ColumnArraySerde, compressed with LZ4
+// when it makes the block smaller (stored size < uncompressed size).
+// Column types are not persisted, so the reader must provide a prototype chunk with the
+// same schema as the written chunks.
+//
+// A SpillFile is written once and then read once, the file is removed on destruction.
+class SpillFile {
+public:
+    explicit SpillFile(std::string path) : _path(std::move(path)) {}
+    ~SpillFile();
+
+    SpillFile(const SpillFile&) = delete;
+    SpillFile& operator=(const SpillFile&) = delete;
+
+    Status append(const Chunk& chunk);
+
+    // Close the writer, the file could be read after this.
+    Status finish();
+
+    // Read the next chunk. Return Status::EndOfFile after the last chunk.
+    StatusOr<ChunkUniquePtr> read(const Chunk& prototype);
+
+    // Remove the underlying file, the file could not be read anymore.
+    Status remove();
+
+    const std::string& path() const { return _path; }
+    size_t num_rows() const { return _num_rows; }
+    size_t num_chunks() const { return _num_chunks; }
+    // Bytes written to disk
+    int64_t file_size() const { return _file_size; }
+
+private:
+    Status _init_codec();
+
+    const std::string _path;
+    const BlockCompressionCodec* _codec = nullptr;
+    bool _codec_inited = false;
+
+    std::unique_ptr<WritableFile> _writer;
+    std::unique_ptr<RandomAccessFile> _reader;
+    bool _removed = false;
+    int64_t _read_offset = 0;
+
+    size_t _num_rows = 0;
+    size_t _num_chunks = 0;
+    int64_t _file_size = 0;
+
+    raw::RawVector<uint8_t> _serialize_buffer;
+    raw::RawVector<uint8_t> _compress_buffer;
+};
+
+// PartitionedSpiller hash partitions rows by a set of key columns into a fixed number of
+// SpillFiles. Rows with the same key always land in the same partition, so each partition
+// could be processed independently with a fraction of the memory needed by the whole input.
+class PartitionedSpiller {
+public:
+    // Spill files are named as "<path_prefix>_<partition>".
+    // The rows of a partition all have the same partition of another spiller with the same |hash_seed|, so a
+    // partition too large to be processed must be repartitioned by a spiller with another seed.
+    PartitionedSpiller(std::string path_prefix, size_t num_partitions, uint32_t hash_seed = HashUtil::FNV_SEED);
+    ~PartitionedSpiller() = default;
+
+    // Create a spiller whose files are located in one of config::query_scratch_dirs.
+    // |name| is used to tell the spill files of different operators apart.
+    static StatusOr<std::unique_ptr<PartitionedSpiller>> create(RuntimeState* state, const std::string& name,
+                                                                size_t num_partitions,
+                                                                uint32_t hash_seed = HashUtil::FNV_SEED);
+
+    // Partition the rows of |chunk| by the hash of |key_columns|, and append them to the
+    // spill files. |key_columns| must have the same number of rows as |chunk|.
+    Status spill(const Chunk& chunk, const Columns& key_columns);
+
+    // Like above, but with hash values precomputed by |compute_partition_hash|.
+    Status spill(const Chunk& chunk, const std::vector<uint32_t>& hash_values);
+
+    // Flush all partitions, no more rows could be spilled after this.
+    Status finish();
+
+    // Compute hash values of |key_columns| used to pick partitions, the result is
+    // stable across calls, so the same key is always mapped to the same partition.
+    static void compute_partition_hash(const Columns& key_columns, size_t num_rows, std::vector<uint32_t>* hash_values,
+                                       uint32_t hash_seed = HashUtil::FNV_SEED);
+
+    size_t num_partitions() const { return _partitions.size(); }
+    SpillFile* partition(size_t i) { return _partitions[i].get(); }
+    size_t partition_index(uint32_t hash) const { return hash % _partitions.size(); }
+
+    int64_t spilled_rows() const { return _spilled_rows; }
+    int64_t spilled_bytes() const;
+    bool is_finished() const { return _is_finished; }
+
+private:
+    std::vector<std::unique_ptr<SpillFile>> _partitions;
+    const uint32_t _hash_seed;
+    bool _is_finished = false;
+    int64_t _spilled_rows = 0;
+
+    std::vector<uint32_t> _hash_values;
+    std::vector<uint32_t> _row_indexes;
+    std::vector<uint32_t> _partition_row_start_points;
+};
+
+} // namespace starrocks::vectorized
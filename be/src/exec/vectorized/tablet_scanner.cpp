@@ -96,6 +96,7 @@ Status TabletScanner::close(RuntimeState* state) {
     update_counter();
     _reader.reset();
     _predicate_free_pool.clear();
+    _runtime_filter_preds.clear();
     Expr::close(_conjunct_ctxs, state);
     // Reduce the memory usage if the the average string size is greater than 512.
     release_large_columns<BinaryColumn>(state->chunk_size() * 512);
@@ -146,6 +147,14 @@ Status TabletScanner::_init_reader_params(const std::vector<OlapScanRange*>* key
         _predicate_free_pool.emplace_back(std::move(p));
     }
 
+    if (config::enable_storage_runtime_filter) {
+        _parent->_conjuncts_manager.get_runtime_filter_predicates(_tablet->tablet_schema(), *_params.global_dictmaps,
+                                                                  &_runtime_filter_preds);
+        for (const auto& p : _runtime_filter_preds) {
+            _params.runtime_filter_preds.push_back(p.get());
+        }
+    }
+
     ConjunctivePredicatesRewriter not_pushdown_predicate_rewriter(_predicates, *_params.global_dictmaps);
     not_pushdown_predicate_rewriter.rewrite_predicate(&_parent->_obj_pool);
 
@@ -318,7 +327,9 @@ void TabletScanner::update_counter() {
 
     COUNTER_UPDATE(_parent->_pred_filter_timer, _reader->stats().vec_cond_evaluate_ns);
     COUNTER_UPDATE(_parent->_pred_filter_counter, _reader->stats().rows_vec_cond_filtered);
+    COUNTER_UPDATE(_parent->_pred_filter_encoded_counter, _reader->stats().rows_encoded_pred_filtered);
     COUNTER_UPDATE(_parent->_del_vec_filter_counter, _reader->stats().rows_del_vec_filtered);
+    COUNTER_UPDATE(_parent->_rf_filter_counter, _reader->stats().rows_runtime_filter_filtered);
     COUNTER_UPDATE(_parent->_seg_zm_filtered_counter, _reader->stats().segment_stats_filtered);
     COUNTER_UPDATE(_parent->_zm_filtered_counter, _reader->stats().rows_stats_filtered);
     COUNTER_UPDATE(_parent->_bf_filtered_counter, _reader->stats().rows_bf_filtered);
@@ -330,11 +341,18 @@ void TabletScanner::update_counter() {
 
     COUNTER_UPDATE(_parent->_bi_filtered_counter, _reader->stats().rows_bitmap_index_filtered);
     COUNTER_UPDATE(_parent->_bi_filter_timer, _reader->stats().bitmap_index_filter_timer);
+    COUNTER_UPDATE(_parent->_ii_filtered_counter, _reader->stats().rows_inverted_index_filtered);
+    COUNTER_UPDATE(_parent->_ii_filter_timer, _reader->stats().inverted_index_filter_timer);
     COUNTER_UPDATE(_parent->_block_seek_counter, _reader->stats().block_seek_num);
 
     COUNTER_UPDATE(_parent->_rowsets_read_count, _reader->stats().rowsets_read_count);
     COUNTER_UPDATE(_parent->_segments_read_count, _reader->stats().segments_read_count);
     COUNTER_UPDATE(_parent->_total_columns_data_page_count, _reader->stats().total_columns_data_page_count);
+    COUNTER_UPDATE(_parent->_prefetch_io_counter, _reader->stats().prefetch_io_count);
+    COUNTER_UPDATE(_parent->_prefetch_io_saved_counter,
+                   _reader->stats().prefetch_hit_pages - _reader->stats().prefetch_io_count);
+    COUNTER_UPDATE(_parent->_prefetch_bytes_counter, _reader->stats().prefetch_bytes);
+    COUNTER_UPDATE(_parent->_prefetch_hit_bytes_counter, _reader->stats().prefetch_hit_bytes);
 
     COUNTER_SET(_parent->_pushdown_predicates_counter, (int64_t)_params.predicates.size());
 
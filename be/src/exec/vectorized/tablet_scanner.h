@@ -78,6 +78,7 @@ private:
 
     // for release memory.
     std::vector<PredicatePtr> _predicate_free_pool;
+    std::vector<std::unique_ptr<RuntimeFilterPredicate>> _runtime_filter_preds;
 
     bool _is_open = false;
     bool _is_closed = false;
@@ -19,6 +19,7 @@
 #include "storage/olap_define.h"
 #include "util/raw_container.h"
 #include "util/sm3.h"
+#include "util/text_tokenizer.h"
 #include "util/utf8.h"
 
 namespace starrocks::vectorized {
@@ -2941,4 +2942,49 @@ ColumnPtr StringFunctions::parse_url(FunctionContext* context, const starrocks::
     return parse_url_general(context, columns);
 }
 
+// match_all and match_phrase
+template <bool phrase>
+static ColumnPtr match_terms(const Columns& columns) {
+    DCHECK_EQ(columns.size(), 2);
+    auto str_viewer = ColumnViewer<TYPE_VARCHAR>(columns[0]);
+    auto query_viewer = ColumnViewer<TYPE_VARCHAR>(columns[1]);
+    const bool const_query = columns[1]->is_constant();
+    std::vector<std::string> query_terms;
+    if (const_query && !query_viewer.is_null(0)) {
+        query_terms = TextTokenizer::tokenize(query_viewer.value(0));
+    }
+
+    auto size = columns[0]->size();
+    ColumnBuilder<TYPE_BOOLEAN> result(size);
+    for (int row = 0; row < size; ++row) {
+        if (str_viewer.is_null(row) || query_viewer.is_null(row)) {
+            result.append_null();
+            continue;
+        }
+        if (!const_query) {
+            query_terms = TextTokenizer::tokenize(query_viewer.value(row));
+        }
+        std::vector<std::string> terms = TextTokenizer::tokenize(str_viewer.value(row));
+        bool matched;
+        if constexpr (phrase) {
+            matched = std::search(terms.begin(), terms.end(), query_terms.begin(), query_terms.end()) != terms.end();
+        } else {
+            matched = std::all_of(query_terms.begin(), query_terms.end(), [&terms](const std::string& term) {
+                return std::find(terms.begin(), terms.end(), term) != terms.end();
+            });
+        }
+        result.append(matched);
+    }
+
+    return result.build(ColumnHelper::is_all_const(columns));
+}
+
+ColumnPtr StringFunctions::match_all(FunctionContext* context, const starrocks::vectorized::Columns& columns) {
+    return match_terms<false>(columns);
+}
+
+ColumnPtr StringFunctions::match_phrase(FunctionContext* context, const starrocks::vectorized::Columns& columns) {
+    return match_terms<true>(columns);
+}
+
 } // namespace starrocks::vectorized
@@ -363,6 +363,25 @@ public:
    */
     DEFINE_VECTORIZED_FN(parse_url);
 
+    /**
+     * Return whether every term of query_value is a term of string_value, the terms are split by
+     * TextTokenizer, the same as the inverted index.
+     *
+     * @param: [string_value, query_value]
+     * @paramType: [BinaryColumn, BinaryColumn]
+     * @return: BooleanColumn
+     */
+    DEFINE_VECTORIZED_FN(match_all);
+
+    /**
+     * Return whether the terms of query_value appear adjacently and in order in the terms of string_value.
+     *
+     * @param: [string_value, query_value]
+     * @paramType: [BinaryColumn, BinaryColumn]
+     * @return: BooleanColumn
+     */
+    DEFINE_VECTORIZED_FN(match_phrase);
+
     /**
      * @param: [BigIntColumn]
      * @return: StringColumn
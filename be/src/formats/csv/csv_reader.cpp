@@ -2,8 +2,34 @@
 
 #include "formats/csv/csv_reader.h"
 
+#ifdef __SSE2__
+#include <immintrin.h>
+#endif
+
 namespace starrocks::vectorized {
 
+#if defined(__AVX2__) || defined(__SSE2__)
+static constexpr size_t kScanBlockSize = 32;
+
+// Returns a bitmask of the bytes in [p, p + kScanBlockSize) equal to |c1| or |c2|, the lowest bit is |p[0]|.
+static inline uint32_t delimiter_mask(const char* p, char c1, char c2) {
+#if defined(__AVX2__)
+    __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    __m256i eq = _mm256_or_si256(_mm256_cmpeq_epi8(data, _mm256_set1_epi8(c1)),
+                                 _mm256_cmpeq_epi8(data, _mm256_set1_epi8(c2)));
+    return static_cast<uint32_t>(_mm256_movemask_epi8(eq));
+#else
+    const __m128i v1 = _mm_set1_epi8(c1);
+    const __m128i v2 = _mm_set1_epi8(c2);
+    __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16));
+    uint32_t lo_mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(lo, v1), _mm_cmpeq_epi8(lo, v2)));
+    uint32_t hi_mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(hi, v1), _mm_cmpeq_epi8(hi, v2)));
+    return lo_mask | (hi_mask << 16);
+#endif
+}
+#endif
+
 Status CSVReader::next_record(Record* record) {
     if (_limit > 0 && _parsed_bytes > _limit) {
         return Status::EndOfFile("Reached limit");
@@ -41,14 +67,102 @@ Status CSVReader::_expand_buffer() {
     return Status::OK();
 }
 
+Status CSVReader::next_records(size_t max_records, Records* records, Fields* fields,
+                               std::vector<uint32_t>* field_offsets) {
+    DCHECK_GT(max_records, 0);
+    records->clear();
+    fields->clear();
+    field_offsets->assign(1, 0);
+    if (_field_delimiter.size() != 1 || _field_delimiter[0] == _record_delimiter) {
+        // The records may be moved by the next read of the buffer, so only one record is read.
+        Record record;
+        RETURN_IF_ERROR(next_record(&record));
+        records->emplace_back(record);
+        split_record(record, fields);
+        field_offsets->emplace_back(fields->size());
+        return Status::OK();
+    }
+    if (_limit > 0 && _parsed_bytes > _limit) {
+        return Status::EndOfFile("Reached limit");
+    }
+    while (_index_records(max_records, records, fields, field_offsets) == 0) {
+        // No complete record in the buffer.
+        _buff.compact();
+        if (_buff.free_space() == 0) {
+            RETURN_IF_ERROR(_expand_buffer());
+        }
+        RETURN_IF_ERROR(_fill_buffer());
+    }
+    return Status::OK();
+}
+
+size_t CSVReader::_index_records(size_t max_records, Records* records, Fields* fields,
+                                 std::vector<uint32_t>* field_offsets) {
+    const char field_delimiter = _field_delimiter[0];
+    const char* const begin = _buff.position();
+    const char* const end = _buff.limit();
+    const char* record_begin = begin;
+    const char* value = begin;
+    // Returns false if no more records should be indexed.
+    auto on_delimiter = [&](const char* p) {
+        fields->emplace_back(value, p - value);
+        value = p + 1;
+        if (*p == field_delimiter) {
+            return true;
+        }
+        records->emplace_back(record_begin, p - record_begin);
+        field_offsets->emplace_back(fields->size());
+        record_begin = value;
+        // Same as next_record(), the record crossing the limit is the last one.
+        return records->size() < max_records && fields->size() < kMaxBatchFields &&
+               (_limit == 0 || _parsed_bytes + (record_begin - begin) <= _limit);
+    };
+
+    const char* p = begin;
+    bool more = true;
+#if defined(__AVX2__) || defined(__SSE2__)
+    for (; more && p + kScanBlockSize <= end; p += kScanBlockSize) {
+        uint32_t mask = delimiter_mask(p, field_delimiter, _record_delimiter);
+        while (more && mask != 0) {
+            more = on_delimiter(p + __builtin_ctz(mask));
+            mask &= mask - 1;
+        }
+    }
+#endif
+    for (; more && p < end; ++p) {
+        if (*p == field_delimiter || *p == _record_delimiter) {
+            more = on_delimiter(p);
+        }
+    }
+    // Drop the fields of the incomplete record.
+    fields->resize(field_offsets->back());
+    size_t n = record_begin - begin;
+    _buff.skip(n);
+    _parsed_bytes += n;
+    return records->size();
+}
+
 void CSVReader::split_record(const Record& record, Fields* fields) const {
     const char* value = record.data;
     const char* ptr = record.data;
     const size_t size = record.size;
 
     if (_field_delimiter.size() == 1) {
-        for (size_t i = 0; i < size; ++i, ++ptr) {
-            if (*ptr == _field_delimiter[0]) {
+        const char field_delimiter = _field_delimiter[0];
+        const char* const end = record.data + size;
+#if defined(__AVX2__) || defined(__SSE2__)
+        for (; ptr + kScanBlockSize <= end; ptr += kScanBlockSize) {
+            uint32_t mask = delimiter_mask(ptr, field_delimiter, field_delimiter);
+            while (mask != 0) {
+                const char* d = ptr + __builtin_ctz(mask);
+                fields->emplace_back(value, d - value);
+                value = d + 1;
+                mask &= mask - 1;
+            }
+        }
+#endif
+        for (; ptr < end; ++ptr) {
+            if (*ptr == field_delimiter) {
                 fields->emplace_back(value, ptr - value);
                 value = ptr + 1;
             }
@@ -61,11 +61,14 @@ class CSVReader {
     constexpr static size_t kMinBufferSize = 128 * 1024L;
     constexpr static size_t kMaxBufferSize = 512 * 1024L;
 #endif
+    // Stop indexing a batch of records once it has this many fields, to keep the fields in the cache.
+    constexpr static size_t kMaxBatchFields = 16 * 1024;
 
 public:
     using Record = Slice;
     using Field = Slice;
     using Fields = std::vector<Field>;
+    using Records = std::vector<Record>;
 
     CSVReader(char record_delimiter, string field_delimiter)
             : _record_delimiter(record_delimiter),
@@ -81,6 +84,13 @@ public:
 
     void split_record(const Record& record, Fields* fields) const;
 
+    // Reads at most |max_records| records and splits them into fields, the fields of the i-th record are
+    // |fields|[|field_offsets|[i], |field_offsets|[i + 1]). The records and fields are valid until the next
+    // call of next_record() or next_records().
+    // With a single-byte field delimiter, the records in the buffer are indexed in one pass that finds
+    // both delimiters a block of bytes at a time with SIMD instructions.
+    Status next_records(size_t max_records, Records* records, Fields* fields, std::vector<uint32_t>* field_offsets);
+
 protected:
     // TODO: support string
     char _record_delimiter;
@@ -92,6 +102,8 @@ protected:
 
 private:
     Status _expand_buffer();
+    // Indexes the complete records in the buffer, returns the number of records indexed.
+    size_t _index_records(size_t max_records, Records* records, Fields* fields, std::vector<uint32_t>* field_offsets);
 
     size_t _parsed_bytes = 0;
     size_t _limit = 0;
@@ -21,6 +21,7 @@
 
 #include "runtime/data_stream_mgr.h"
 
+#include <atomic>
 #include <boost/thread/thread.hpp>
 #include <iostream>
 #include <utility>
@@ -200,6 +201,45 @@ Status DataStreamMgr::deregister_recvr(const TUniqueId& fragment_instance_id, Pl
     }
 }
 
+namespace {
+// The closure shared by the requests of a batch, the closure of the RPC is run after it's run by all of them,
+// since a receiver may hold the closure of a request to apply back pressure to the sender.
+class BatchRequestClosure final : public google::protobuf::Closure {
+public:
+    BatchRequestClosure(google::protobuf::Closure* done, int refs) : _done(done), _refs(refs) {}
+
+    void Run() override {
+        if (_refs.fetch_sub(1) == 1) {
+            _done->Run();
+            delete this;
+        }
+    }
+
+private:
+    google::protobuf::Closure* _done;
+    std::atomic<int> _refs;
+};
+} // namespace
+
+Status DataStreamMgr::transmit_chunk_batch(const PTransmitChunkBatchParams& request,
+                                           ::google::protobuf::Closure** done) {
+    // One more reference is returned to the caller, so the response could be set before the RPC finishes.
+    auto* batch_done = new BatchRequestClosure(*done, request.requests_size() + 1);
+    *done = batch_done;
+    Status status;
+    for (const auto& sub_request : request.requests()) {
+        google::protobuf::Closure* sub_done = batch_done;
+        Status st = transmit_chunk(sub_request, &sub_done);
+        if (!st.ok() && status.ok()) {
+            status = st;
+        }
+        if (sub_done != nullptr) {
+            sub_done->Run();
+        }
+    }
+    return status;
+}
+
 void DataStreamMgr::cancel(const TUniqueId& fragment_instance_id) {
     VLOG_QUERY << "cancelling all streams for fragment=" << fragment_instance_id;
     std::vector<std::shared_ptr<DataStreamRecvr>> recvrs;
@@ -86,6 +86,11 @@ public:
     Status transmit_data(const PTransmitDataParams* request, ::google::protobuf::Closure** done);
 
     Status transmit_chunk(const PTransmitChunkParams& request, ::google::protobuf::Closure** done);
+
+    // Demultiplex the requests to the fragment instances on this backend batched in one RPC, see
+    // `transmit_chunk`. |done| is run once all the receivers release it.
+    Status transmit_chunk_batch(const PTransmitChunkBatchParams& request, ::google::protobuf::Closure** done);
+
     // Closes all receivers registered for fragment_instance_id immediately.
     void cancel(const TUniqueId& fragment_instance_id);
 
@@ -24,6 +24,7 @@
 #include "column/vectorized_fwd.h"
 #include "common/object_pool.h"
 #include "common/status.h"
+#include "exec/pipeline/observable.h"
 #include "gen_cpp/Types_types.h" // for TUniqueId
 #include "runtime/descriptors.h"
 #include "runtime/local_pass_through_buffer.h"
@@ -112,6 +113,9 @@ public:
 
     bool is_data_ready();
 
+    // Notified when chunks arrive, senders finish or the stream is cancelled.
+    pipeline::Observable& observable() { return _observable; }
+
 private:
     friend class DataStreamMgr;
     class SenderQueue;
@@ -203,6 +207,8 @@ private:
     // if _keep_order is set to true, then receiver will keep the order according sequence
     bool _keep_order;
     PassThroughContext _pass_through_context;
+
+    pipeline::Observable _observable;
 };
 
 } // end namespace starrocks
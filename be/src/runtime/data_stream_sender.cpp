@@ -467,6 +467,15 @@ Status DataStreamSender::prepare(RuntimeState* state) {
         _compress_type = CompressionTypePB::LZ4;
     }
     RETURN_IF_ERROR(get_block_compression_codec(_compress_type, &_compress_codec));
+    if (state->query_options().__isset.transmission_encode_level &&
+        state->query_options().transmission_encode_level != 0) {
+        _encode_context = std::make_unique<serde::EncodeContext>(state->query_options().transmission_encode_level);
+    }
+    if ((_part_type == TPartitionType::HASH_PARTITIONED ||
+         _part_type == TPartitionType::BUCKET_SHFFULE_HASH_PARTITIONED) &&
+        config::shuffle_hot_key_ratio > 0) {
+        _skew_detector = std::make_unique<ShuffleSkewDetector>(_channels.size(), 1);
+    }
 
     std::string instances;
     for (const auto& channel : _channels) {
@@ -603,6 +612,9 @@ Status DataStreamSender::send_chunk(RuntimeState* state, vectorized::Chunk* chun
                     column->crc32_hash(&_hash_values[0], 0, num_rows);
                 }
             }
+            if (_skew_detector != nullptr) {
+                _skew_detector->update(_hash_values.data(), num_rows);
+            }
 
             // compute row indexes for each channel
             _channel_row_idx_start_points.assign(num_channels + 1, 0);
@@ -668,6 +680,9 @@ Status DataStreamSender::close(RuntimeState* state, Status exec_status) {
     for (auto& _channel : _channels) {
         _channel->close_wait(state);
     }
+    if (_skew_detector != nullptr) {
+        _skew_detector->report(_profile);
+    }
     for (auto iter : _partition_infos) {
         auto st = iter->close(state);
         if (!st.ok()) {
@@ -690,12 +705,12 @@ Status DataStreamSender::serialize_chunk(const vectorized::Chunk* src, ChunkPB*
         SCOPED_TIMER(_serialize_batch_timer);
         // We only serialize chunk meta for first chunk
         if (*is_first_chunk) {
-            StatusOr<ChunkPB> res = serde::ProtobufChunkSerde::serialize(*src);
+            StatusOr<ChunkPB> res = serde::ProtobufChunkSerde::serialize(*src, _encode_context.get());
             if (!res.ok()) return res.status();
             res->Swap(dst);
             *is_first_chunk = false;
         } else {
-            StatusOr<ChunkPB> res = serde::ProtobufChunkSerde::serialize_without_meta(*src);
+            StatusOr<ChunkPB> res = serde::ProtobufChunkSerde::serialize_without_meta(*src, _encode_context.get());
             if (!res.ok()) return res.status();
             res->Swap(dst);
         }
@@ -31,6 +31,8 @@
 #include "exec/data_sink.h"
 #include "gen_cpp/doris_internal_service.pb.h"
 #include "gen_cpp/internal_service.pb.h"
+#include "runtime/shuffle_skew_detector.h"
+#include "serde/encode_context.h"
 #include "util/raw_container.h"
 #include "util/runtime_profile.h"
 
@@ -176,6 +178,10 @@ private:
 
     CompressionTypePB _compress_type = CompressionTypePB::NO_COMPRESSION;
     const BlockCompressionCodec* _compress_codec = nullptr;
+    // Choose the encodings of the columns, null if `transmission_encode_level` is 0.
+    std::unique_ptr<serde::EncodeContext> _encode_context;
+    // Detect the hot keys of the hash shuffle, null if `shuffle_hot_key_ratio` is 0.
+    std::unique_ptr<ShuffleSkewDetector> _skew_detector;
 
     // Because we should close all channels even if fail to close some channel.
     // We use a global _close_status to record the error close status.
@@ -28,6 +28,7 @@
 #include "common/logging.h"
 #include "exec/pipeline/pipeline_driver_executor.h"
 #include "exec/pipeline/pipeline_fwd.h"
+#include "exec/pipeline/query_cache/query_cache.h"
 #include "exec/workgroup/scan_executor.h"
 #include "exec/workgroup/work_group.h"
 #include "gen_cpp/BackendService.h"
@@ -267,6 +268,7 @@ Status ExecEnv::init_mem_tracker() {
     _schema_change_mem_tracker = new MemTracker(-1, "schema_change", _mem_tracker);
     _column_pool_mem_tracker = new MemTracker(-1, "column_pool", _mem_tracker);
     _page_cache_mem_tracker = new MemTracker(-1, "page_cache", _mem_tracker);
+    _query_cache_mem_tracker = new MemTracker(-1, "query_cache", _mem_tracker);
     _update_mem_tracker = new MemTracker(bytes_limit * 0.6, "update", nullptr);
     _chunk_allocator_mem_tracker = new MemTracker(-1, "chunk_allocator", _mem_tracker);
     _clone_mem_tracker = new MemTracker(-1, "clone", _mem_tracker);
@@ -297,6 +299,13 @@ Status ExecEnv::_init_mem_tracker() {
                      << config::storage_page_cache_limit << ", memory=" << MemInfo::physical_mem();
     }
     StoragePageCache::create_global_cache(_page_cache_mem_tracker, storage_cache_limit);
+    if (!config::storage_page_disk_cache_path.empty()) {
+        Status st = StoragePageCache::instance()->init_disk_cache(config::storage_page_disk_cache_path,
+                                                                  config::storage_page_disk_cache_capacity);
+        LOG_IF(WARNING, !st.ok()) << "Fail to init storage page disk cache, path="
+                                  << config::storage_page_disk_cache_path << ", error=" << st;
+    }
+    pipeline::QueryCache::create_global_cache(_query_cache_mem_tracker, config::query_cache_capacity);
 
     // TODO(zc): The current memory usage configuration is a bit confusing,
     // we need to sort out the use of memory
@@ -412,6 +421,12 @@ void ExecEnv::_destroy() {
         delete _page_cache_mem_tracker;
         _page_cache_mem_tracker = nullptr;
     }
+    if (_query_cache_mem_tracker) {
+        // The cached chunks are released to the tracker.
+        pipeline::QueryCache::release_global_cache();
+        delete _query_cache_mem_tracker;
+        _query_cache_mem_tracker = nullptr;
+    }
     if (_column_pool_mem_tracker) {
         delete _column_pool_mem_tracker;
         _column_pool_mem_tracker = nullptr;
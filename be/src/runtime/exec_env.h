@@ -117,6 +117,7 @@ public:
     MemTracker* schema_change_mem_tracker() { return _schema_change_mem_tracker; }
     MemTracker* column_pool_mem_tracker() { return _column_pool_mem_tracker; }
     MemTracker* page_cache_mem_tracker() { return _page_cache_mem_tracker; }
+    MemTracker* query_cache_mem_tracker() { return _query_cache_mem_tracker; }
     MemTracker* update_mem_tracker() { return _update_mem_tracker; }
     MemTracker* chunk_allocator_mem_tracker() { return _chunk_allocator_mem_tracker; }
     MemTracker* clone_mem_tracker() { return _clone_mem_tracker; }
@@ -195,6 +196,9 @@ private:
     // The memory used for page cache
     MemTracker* _page_cache_mem_tracker = nullptr;
 
+    // The memory used for query cache
+    MemTracker* _query_cache_mem_tracker = nullptr;
+
     // The memory tracker for update manager
     MemTracker* _update_mem_tracker = nullptr;
 
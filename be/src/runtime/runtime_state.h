@@ -96,6 +96,7 @@ public:
     ObjectPool* obj_pool() const { return _obj_pool.get(); }
     ObjectPool* global_obj_pool() const;
     void set_query_ctx(pipeline::QueryContext* ctx) { _query_ctx = ctx; }
+    pipeline::QueryContext* query_ctx() const { return _query_ctx; }
 
     const DescriptorTbl& desc_tbl() const { return *_desc_tbl; }
     void set_desc_tbl(DescriptorTbl* desc_tbl) { _desc_tbl = desc_tbl; }
@@ -364,6 +365,8 @@ private:
     int64_t _load_job_id = 0;
     std::unique_ptr<TLoadErrorHubInfo> _load_error_hub_info;
 
+    // Lock protecting _error_log_file and _error_hub, the rows of a load may be parsed by several threads.
+    std::mutex _error_log_file_lock;
     std::string _error_log_file_path;
     std::ofstream* _error_log_file = nullptr; // error file path, absolute path
     std::unique_ptr<LoadErrorHub> _error_hub;
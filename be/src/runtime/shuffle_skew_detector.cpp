@@ -0,0 +1,118 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "runtime/shuffle_skew_detector.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+
+#include "common/config.h"
+#include "common/logging.h"
+#include "util/runtime_profile.h"
+
+namespace starrocks {
+
+// Odd multipliers to derive the independent hash of each row of the sketch from the hash value of a row.
+static constexpr uint32_t kSketchSeeds[] = {0x9E3779B1U, 0x85EBCA77U, 0xC2B2AE3DU, 0x27D4EB2FU};
+
+ShuffleSkewDetector::ShuffleSkewDetector(size_t num_channels, size_t num_shuffles)
+        : _num_channels(std::max<size_t>(num_channels, 1)),
+          _num_shuffles(std::max<size_t>(num_shuffles, 1)),
+          _sketch(kSketchDepth),
+          _destination_rows(_num_channels * _num_shuffles, 0) {
+    static_assert(sizeof(kSketchSeeds) / sizeof(kSketchSeeds[0]) == kSketchDepth);
+    for (auto& row : _sketch) {
+        row.fill(0);
+    }
+    _hot_keys.reserve(kMaxHotKeys);
+}
+
+void ShuffleSkewDetector::update(const uint32_t* hash_values, size_t num_rows) {
+    size_t i = _next_sample;
+    for (; i < num_rows; i += kSampleInterval) {
+        uint32_t hash = hash_values[i];
+        _sampled_rows++;
+        _destination_rows[hash % _num_channels * _num_shuffles + hash % _num_shuffles]++;
+        uint32_t count = _add_to_sketch(hash);
+        if (count >= _hot_key_threshold(_sampled_rows)) {
+            _add_hot_key(hash, count);
+        }
+    }
+    _next_sample = i - num_rows;
+}
+
+uint32_t ShuffleSkewDetector::_hot_key_threshold(int64_t sampled_rows) const {
+    // A key taking fewer rows than a destination receives on average doesn't skew the shuffle by itself.
+    double ratio = std::max(config::shuffle_hot_key_ratio, 1.0 / (_num_channels * _num_shuffles));
+    return std::max<uint32_t>(static_cast<uint32_t>(sampled_rows * ratio), 1);
+}
+
+uint32_t ShuffleSkewDetector::_add_to_sketch(uint32_t hash) {
+    uint32_t count = UINT32_MAX;
+    for (size_t d = 0; d < kSketchDepth; ++d) {
+        uint32_t& counter = _sketch[d][(hash * kSketchSeeds[d]) >> (32 - kSketchWidthBits)];
+        counter++;
+        count = std::min(count, counter);
+    }
+    return count;
+}
+
+void ShuffleSkewDetector::_add_hot_key(uint32_t hash, uint32_t count) {
+    auto min_iter = _hot_keys.end();
+    for (auto iter = _hot_keys.begin(); iter != _hot_keys.end(); ++iter) {
+        if (iter->hash == hash) {
+            iter->count = count;
+            return;
+        }
+        if (min_iter == _hot_keys.end() || iter->count < min_iter->count) {
+            min_iter = iter;
+        }
+    }
+    if (_hot_keys.size() < kMaxHotKeys) {
+        _hot_keys.push_back({hash, count});
+    } else if (min_iter->count < count) {
+        // The keys counted as hot at the beginning of the shuffle are replaced by the real heavy hitters.
+        *min_iter = {hash, count};
+    }
+}
+
+size_t ShuffleSkewDetector::hot_keys() const {
+    uint32_t threshold = _hot_key_threshold(_sampled_rows);
+    return std::count_if(_hot_keys.begin(), _hot_keys.end(),
+                         [threshold](const HotKey& key) { return key.count >= threshold; });
+}
+
+int64_t ShuffleSkewDetector::hot_key_rows() const {
+    uint32_t threshold = _hot_key_threshold(_sampled_rows);
+    int64_t rows = 0;
+    for (const auto& key : _hot_keys) {
+        if (key.count >= threshold) {
+            rows += key.count;
+        }
+    }
+    return rows * kSampleInterval;
+}
+
+double ShuffleSkewDetector::skew_ratio() const {
+    if (_sampled_rows == 0) {
+        return 1;
+    }
+    int64_t max_rows = *std::max_element(_destination_rows.begin(), _destination_rows.end());
+    return static_cast<double>(max_rows) * _destination_rows.size() / _sampled_rows;
+}
+
+void ShuffleSkewDetector::report(RuntimeProfile* profile) const {
+    size_t num_hot_keys = hot_keys();
+    double ratio = skew_ratio();
+    COUNTER_SET(ADD_COUNTER(profile, "ShuffleHotKeys", TUnit::UNIT), static_cast<int64_t>(num_hot_keys));
+    COUNTER_SET(ADD_COUNTER(profile, "ShuffleHotKeyRows", TUnit::UNIT), hot_key_rows());
+    profile->add_info_string("ShuffleSkewRatio", fmt::format("{:.2f}", ratio));
+    if (num_hot_keys > 0) {
+        // Every sender of a skewed shuffle reports it, the statistics are in the profile.
+        VLOG(1) << "Skewed hash shuffle, rows=" << _sampled_rows * kSampleInterval
+                  << ", destinations=" << _destination_rows.size() << ", skew_ratio=" << ratio
+                  << ", hot_keys=" << num_hot_keys << ", hot_key_rows=" << hot_key_rows();
+    }
+}
+
+} // namespace starrocks
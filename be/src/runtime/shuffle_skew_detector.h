@@ -0,0 +1,66 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace starrocks {
+
+class RuntimeProfile;
+
+// ShuffleSkewDetector finds the heavy hitters of a hash shuffle at runtime.
+// One of every kSampleInterval rows is sampled, the hash value of its partition columns is counted by a
+// count-min sketch, and the hash values whose estimated share of the sampled rows exceeds the hot key
+// threshold are kept as hot keys. The sampled rows of each destination are counted too, so that the skew
+// of the shuffle is reported in the profile even if no single key is hot.
+// Not thread-safe.
+class ShuffleSkewDetector {
+public:
+    // The rows are sent to |num_channels| * |num_shuffles| destinations, the destination of a row is
+    // `hash % num_channels * num_shuffles + hash % num_shuffles`.
+    ShuffleSkewDetector(size_t num_channels, size_t num_shuffles);
+
+    // Count the |num_rows| hash values of the partition columns of a chunk.
+    void update(const uint32_t* hash_values, size_t num_rows);
+
+    // The number of hot keys and their estimated number of rows.
+    size_t hot_keys() const;
+    int64_t hot_key_rows() const;
+
+    // The rows of the destination receiving the most rows divided by the average rows of all destinations,
+    // 1 means no skew.
+    double skew_ratio() const;
+
+    // Add the skew statistics to |profile|, and log the hot keys at VLOG(1) if the shuffle is skewed.
+    void report(RuntimeProfile* profile) const;
+
+private:
+    static constexpr size_t kSampleInterval = 8;
+    static constexpr size_t kSketchDepth = 4;
+    static constexpr size_t kSketchWidthBits = 10;
+    static constexpr size_t kSketchWidth = 1 << kSketchWidthBits;
+    static constexpr size_t kMaxHotKeys = 8;
+
+    struct HotKey {
+        uint32_t hash = 0;
+        uint32_t count = 0;
+    };
+
+    // The minimum estimated count of a hot key among |sampled_rows| rows.
+    uint32_t _hot_key_threshold(int64_t sampled_rows) const;
+    uint32_t _add_to_sketch(uint32_t hash);
+    void _add_hot_key(uint32_t hash, uint32_t count);
+
+    const size_t _num_channels;
+    const size_t _num_shuffles;
+    // The offset of the next sampled row in the next chunk.
+    size_t _next_sample = 0;
+    int64_t _sampled_rows = 0;
+    std::vector<std::array<uint32_t, kSketchWidth>> _sketch;
+    std::vector<int64_t> _destination_rows;
+    std::vector<HotKey> _hot_keys;
+};
+
+} // namespace starrocks
@@ -6,6 +6,7 @@
 
 #include "column/array_column.h"
 #include "column/binary_column.h"
+#include "column/column_hash.h"
 #include "column/column_visitor_adapter.h"
 #include "column/const_column.h"
 #include "column/decimalv3_column.h"
@@ -16,10 +17,41 @@
 #include "gutil/strings/substitute.h"
 #include "runtime/descriptors.h"
 #include "util/coding.h"
+#include "util/frame_of_reference_coding.h"
 #include "util/json.h"
+#include "util/phmap/phmap.h"
+#include "util/rle_encoding.h"
 
 namespace starrocks::serde {
 namespace {
+
+// The type of the encoding written before each encodable part of an encoded column.
+enum EncodeType : uint8_t {
+    PLAIN_ENCODED = 0,
+    FOR_ENCODED = 1,
+    DICT_ENCODED = 2,
+    RLE_ENCODED = 3,
+    // A null map without any null, only the number of values is written.
+    NO_NULL = 4,
+};
+
+// The integer type to encode a fixed length column of T by frame-of-reference, void if it can't be encoded.
+template <typename T>
+struct ForEncodedType {
+    using type = std::conditional_t<std::is_integral_v<T>, T, void>;
+};
+
+template <>
+struct ForEncodedType<vectorized::DateValue> {
+    static_assert(sizeof(vectorized::DateValue) == sizeof(int32_t));
+    using type = int32_t;
+};
+
+template <>
+struct ForEncodedType<vectorized::TimestampValue> {
+    static_assert(sizeof(vectorized::TimestampValue) == sizeof(int64_t));
+    using type = int64_t;
+};
 uint8_t* write_little_endian_32(uint32_t value, uint8_t* buff) {
     encode_fixed32_le(buff, value);
     return buff + sizeof(value);
@@ -53,18 +85,32 @@ const uint8_t* read_raw(const uint8_t* buff, void* target, int64_t size) {
 template <typename T>
 class FixedLengthColumnSerde {
 public:
-    static int64_t max_serialized_size(const vectorized::FixedLengthColumnBase<T>& column) {
-        return sizeof(uint32_t) + sizeof(T) * column.size();
+    using EncodedType = typename ForEncodedType<T>::type;
+
+    static int64_t max_serialized_size(const vectorized::FixedLengthColumnBase<T>& column, int encode_level) {
+        return sizeof(uint32_t) + sizeof(T) * column.size() + is_encoded(encode_level);
     }
 
-    static uint8_t* serialize(const vectorized::FixedLengthColumnBase<T>& column, uint8_t* buff) {
+    static uint8_t* serialize(const vectorized::FixedLengthColumnBase<T>& column, uint8_t* buff, int encode_level) {
+        if (is_encoded(encode_level)) {
+            return serialize_encoded(column, buff);
+        }
         uint32_t size = sizeof(T) * column.size();
         buff = write_little_endian_32(size, buff);
         buff = write_raw(column.raw_data(), size, buff);
         return buff;
     }
 
-    static const uint8_t* deserialize(const uint8_t* buff, vectorized::FixedLengthColumnBase<T>* column) {
+    static const uint8_t* deserialize(const uint8_t* buff, vectorized::FixedLengthColumnBase<T>* column,
+                                      int encode_level) {
+        if (is_encoded(encode_level)) {
+            uint8_t encode_type = *buff++;
+            if (encode_type == FOR_ENCODED) {
+                return deserialize_for(buff, column);
+            } else if (encode_type != PLAIN_ENCODED) {
+                return nullptr;
+            }
+        }
         uint32_t size = 0;
         buff = read_little_endian_32(buff, &size);
         std::vector<T>& data = column->get_data();
@@ -72,17 +118,66 @@ public:
         buff = read_raw(buff, data.data(), size);
         return buff;
     }
+
+private:
+    static bool is_encoded(int encode_level) {
+        return !std::is_void_v<EncodedType> && (encode_level & ENCODE_INTEGER);
+    }
+
+    // Layout
+    // uint8: encode type
+    // PLAIN_ENCODED: the plain format
+    // FOR_ENCODED: uint32 number of values, uint32 size of encoded values, values encoded by ForEncoder
+    static uint8_t* serialize_encoded(const vectorized::FixedLengthColumnBase<T>& column, uint8_t* buff) {
+        if constexpr (!std::is_void_v<EncodedType>) {
+            faststring encoded;
+            if (!column.empty()) {
+                ForEncoder<EncodedType> encoder(&encoded);
+                encoder.put_batch(reinterpret_cast<const EncodedType*>(column.raw_data()), column.size());
+                encoder.flush();
+            }
+            if (!column.empty() && sizeof(uint32_t) + encoded.size() < sizeof(T) * column.size()) {
+                *buff++ = FOR_ENCODED;
+                buff = write_little_endian_32(column.size(), buff);
+                buff = write_little_endian_32(encoded.size(), buff);
+                return write_raw(encoded.data(), encoded.size(), buff);
+            }
+        }
+        *buff++ = PLAIN_ENCODED;
+        return serialize(column, buff, 0);
+    }
+
+    static const uint8_t* deserialize_for(const uint8_t* buff, vectorized::FixedLengthColumnBase<T>* column) {
+        if constexpr (!std::is_void_v<EncodedType>) {
+            uint32_t num_values = 0;
+            uint32_t encoded_size = 0;
+            buff = read_little_endian_32(buff, &num_values);
+            buff = read_little_endian_32(buff, &encoded_size);
+            std::vector<T>& data = column->get_data();
+            raw::make_room(&data, num_values);
+            ForDecoder<EncodedType> decoder(buff, encoded_size);
+            if (!decoder.init() || !decoder.get_batch(reinterpret_cast<EncodedType*>(data.data()), num_values)) {
+                return nullptr;
+            }
+            return buff + encoded_size;
+        }
+        return nullptr;
+    }
 };
 
 class BinaryColumnSerde {
 public:
-    static int64_t max_serialized_size(const vectorized::BinaryColumn& column) {
+    static int64_t max_serialized_size(const vectorized::BinaryColumn& column, int encode_level) {
         const vectorized::BinaryColumn::Bytes& bytes = column.get_bytes();
         const vectorized::Offsets& offsets = column.get_offset();
-        return bytes.size() + offsets.size() * sizeof(vectorized::BinaryColumn::Offset) + sizeof(uint32_t) * 2;
+        return bytes.size() + offsets.size() * sizeof(vectorized::BinaryColumn::Offset) + sizeof(uint32_t) * 2 +
+               is_encoded(encode_level);
     }
 
-    static uint8_t* serialize(const vectorized::BinaryColumn& column, uint8_t* buff) {
+    static uint8_t* serialize(const vectorized::BinaryColumn& column, uint8_t* buff, int encode_level) {
+        if (is_encoded(encode_level)) {
+            return serialize_encoded(column, buff);
+        }
         const vectorized::BinaryColumn::Bytes& bytes = column.get_bytes();
         const vectorized::Offsets& offsets = column.get_offset();
 
@@ -96,7 +191,15 @@ public:
         return buff;
     }
 
-    static const uint8_t* deserialize(const uint8_t* buff, vectorized::BinaryColumn* column) {
+    static const uint8_t* deserialize(const uint8_t* buff, vectorized::BinaryColumn* column, int encode_level) {
+        if (is_encoded(encode_level)) {
+            uint8_t encode_type = *buff++;
+            if (encode_type == DICT_ENCODED) {
+                return deserialize_dict(buff, column);
+            } else if (encode_type != PLAIN_ENCODED) {
+                return nullptr;
+            }
+        }
         uint32_t bytes_size = 0;
         buff = read_little_endian_32(buff, &bytes_size);
         column->get_bytes().resize(bytes_size);
@@ -108,6 +211,87 @@ public:
         buff = read_raw(buff, column->get_offset().data(), offsets_size);
         return buff;
     }
+
+private:
+    static bool is_encoded(int encode_level) { return encode_level & ENCODE_STRING; }
+
+    // Layout
+    // uint8: encode type
+    // PLAIN_ENCODED: the plain format
+    // DICT_ENCODED: uint32 number of values, dictionary in the plain format, uint32 size of encoded codes,
+    //               codes encoded by ForEncoder
+    static uint8_t* serialize_encoded(const vectorized::BinaryColumn& column, uint8_t* buff) {
+        const size_t num_values = column.size();
+        // The dictionary is given up once it has more words than half of the values.
+        vectorized::BinaryColumn dict;
+        std::vector<uint32_t> codes;
+        phmap::flat_hash_map<Slice, uint32_t, vectorized::SliceHash> words;
+        codes.reserve(num_values);
+        for (size_t i = 0; i < num_values && words.size() * 2 <= num_values; i++) {
+            Slice value = column.get_slice(i);
+            auto [iter, inserted] = words.emplace(value, words.size());
+            if (inserted) {
+                dict.append(value);
+            }
+            codes.push_back(iter->second);
+        }
+        if (codes.size() == num_values && words.size() * 2 <= num_values) {
+            faststring encoded;
+            ForEncoder<uint32_t> encoder(&encoded);
+            encoder.put_batch(codes.data(), codes.size());
+            encoder.flush();
+            int64_t dict_size = max_serialized_size(dict, 0);
+            if (sizeof(uint32_t) * 2 + dict_size + encoded.size() < max_serialized_size(column, 0)) {
+                *buff++ = DICT_ENCODED;
+                buff = write_little_endian_32(num_values, buff);
+                buff = serialize(dict, buff, 0);
+                buff = write_little_endian_32(encoded.size(), buff);
+                return write_raw(encoded.data(), encoded.size(), buff);
+            }
+        }
+        *buff++ = PLAIN_ENCODED;
+        return serialize(column, buff, 0);
+    }
+
+    // The values are copied from the dictionary to |column| directly.
+    static const uint8_t* deserialize_dict(const uint8_t* buff, vectorized::BinaryColumn* column) {
+        uint32_t num_values = 0;
+        buff = read_little_endian_32(buff, &num_values);
+        vectorized::BinaryColumn dict;
+        buff = deserialize(buff, &dict, 0);
+
+        uint32_t encoded_size = 0;
+        buff = read_little_endian_32(buff, &encoded_size);
+        std::vector<uint32_t> codes;
+        raw::make_room(&codes, num_values);
+        ForDecoder<uint32_t> decoder(buff, encoded_size);
+        if (!decoder.init() || !decoder.get_batch(codes.data(), num_values)) {
+            return nullptr;
+        }
+        buff += encoded_size;
+
+        const vectorized::Offsets& dict_offsets = dict.get_offset();
+        size_t bytes_size = 0;
+        for (uint32_t code : codes) {
+            if (UNLIKELY(code >= dict.size())) {
+                return nullptr;
+            }
+            bytes_size += dict_offsets[code + 1] - dict_offsets[code];
+        }
+        vectorized::BinaryColumn::Bytes& bytes = column->get_bytes();
+        vectorized::Offsets& offsets = column->get_offset();
+        bytes.resize(bytes_size);
+        raw::make_room(&offsets, num_values + 1);
+        offsets[0] = 0;
+        uint8_t* dst = bytes.data();
+        for (uint32_t i = 0; i < num_values; i++) {
+            uint32_t length = dict_offsets[codes[i] + 1] - dict_offsets[codes[i]];
+            strings::memcpy_inlined(dst, dict.get_bytes().data() + dict_offsets[codes[i]], length);
+            dst += length;
+            offsets[i + 1] = offsets[i] + length;
+        }
+        return buff;
+    }
 };
 
 template <typename T>
@@ -202,61 +386,140 @@ public:
 
 class NullableColumnSerde {
 public:
-    static int64_t max_serialized_size(const vectorized::NullableColumn& column) {
-        return serde::ColumnArraySerde::max_serialized_size(*column.null_column()) +
-               serde::ColumnArraySerde::max_serialized_size(*column.data_column());
+    // The null map is serialized in the plain format or by run-length, it's never encoded as integers.
+    static int64_t max_serialized_size(const vectorized::NullableColumn& column, int encode_level) {
+        return serde::ColumnArraySerde::max_serialized_size(*column.null_column()) + is_null_encoded(encode_level) +
+               serde::ColumnArraySerde::max_serialized_size(*column.data_column(), encode_level);
     }
 
-    static uint8_t* serialize(const vectorized::NullableColumn& column, uint8_t* buff) {
-        buff = serde::ColumnArraySerde::serialize(*column.null_column(), buff);
-        buff = serde::ColumnArraySerde::serialize(*column.data_column(), buff);
+    static uint8_t* serialize(const vectorized::NullableColumn& column, uint8_t* buff, int encode_level) {
+        if (is_null_encoded(encode_level)) {
+            buff = serialize_null_encoded(*column.null_column(), column.has_null(), buff);
+        } else {
+            buff = serde::ColumnArraySerde::serialize(*column.null_column(), buff);
+        }
+        buff = serde::ColumnArraySerde::serialize(*column.data_column(), buff, encode_level);
         return buff;
     }
 
-    static const uint8_t* deserialize(const uint8_t* buff, vectorized::NullableColumn* column) {
-        buff = serde::ColumnArraySerde::deserialize(buff, column->null_column().get());
-        buff = serde::ColumnArraySerde::deserialize(buff, column->data_column().get());
+    static const uint8_t* deserialize(const uint8_t* buff, vectorized::NullableColumn* column, int encode_level) {
+        if (is_null_encoded(encode_level)) {
+            buff = deserialize_null_encoded(buff, column->null_column().get());
+        } else {
+            buff = serde::ColumnArraySerde::deserialize(buff, column->null_column().get());
+        }
+        if (buff == nullptr) {
+            return nullptr;
+        }
+        buff = serde::ColumnArraySerde::deserialize(buff, column->data_column().get(), encode_level);
         column->update_has_null();
         return buff;
     }
+
+private:
+    static bool is_null_encoded(int encode_level) { return encode_level & ENCODE_NULL; }
+
+    // Layout
+    // uint8: encode type
+    // PLAIN_ENCODED: the plain format
+    // NO_NULL: uint32 number of values
+    // RLE_ENCODED: uint32 number of values, uint32 size of encoded values, values encoded by RleEncoder
+    static uint8_t* serialize_null_encoded(const vectorized::NullColumn& null_column, bool has_null, uint8_t* buff) {
+        const uint32_t num_values = null_column.size();
+        if (!has_null) {
+            *buff++ = NO_NULL;
+            return write_little_endian_32(num_values, buff);
+        }
+        faststring encoded;
+        RleEncoder<uint8_t> encoder(&encoded, 1);
+        const vectorized::NullData& nulls = null_column.get_data();
+        for (uint32_t i = 0; i < num_values;) {
+            uint32_t run_end = i + 1;
+            while (run_end < num_values && nulls[run_end] == nulls[i]) {
+                run_end++;
+            }
+            encoder.Put(nulls[i], run_end - i);
+            i = run_end;
+        }
+        encoder.Flush();
+        if (sizeof(uint32_t) + encoded.size() < num_values) {
+            *buff++ = RLE_ENCODED;
+            buff = write_little_endian_32(num_values, buff);
+            buff = write_little_endian_32(encoded.size(), buff);
+            return write_raw(encoded.data(), encoded.size(), buff);
+        }
+        *buff++ = PLAIN_ENCODED;
+        return serde::ColumnArraySerde::serialize(null_column, buff);
+    }
+
+    static const uint8_t* deserialize_null_encoded(const uint8_t* buff, vectorized::NullColumn* null_column) {
+        uint8_t encode_type = *buff++;
+        if (encode_type == PLAIN_ENCODED) {
+            return serde::ColumnArraySerde::deserialize(buff, null_column);
+        }
+        uint32_t num_values = 0;
+        buff = read_little_endian_32(buff, &num_values);
+        vectorized::NullData& nulls = null_column->get_data();
+        if (encode_type == NO_NULL) {
+            nulls.assign(num_values, 0);
+            return buff;
+        } else if (encode_type != RLE_ENCODED) {
+            return nullptr;
+        }
+        uint32_t encoded_size = 0;
+        buff = read_little_endian_32(buff, &encoded_size);
+        raw::make_room(&nulls, num_values);
+        RleDecoder<uint8_t> decoder(buff, encoded_size, 1);
+        if (decoder.GetBatch(nulls.data(), num_values) != num_values) {
+            return nullptr;
+        }
+        return buff + encoded_size;
+    }
 };
 
 class ArrayColumnSerde {
 public:
-    static int64_t max_serialized_size(const vectorized::ArrayColumn& column) {
-        return serde::ColumnArraySerde::max_serialized_size(column.offsets()) +
-               serde::ColumnArraySerde::max_serialized_size(column.elements());
+    static int64_t max_serialized_size(const vectorized::ArrayColumn& column, int encode_level) {
+        return serde::ColumnArraySerde::max_serialized_size(column.offsets(), encode_level) +
+               serde::ColumnArraySerde::max_serialized_size(column.elements(), encode_level);
     }
 
-    static uint8_t* serialize(const vectorized::ArrayColumn& column, uint8_t* buff) {
-        buff = serde::ColumnArraySerde::serialize(column.offsets(), buff);
-        buff = serde::ColumnArraySerde::serialize(column.elements(), buff);
+    static uint8_t* serialize(const vectorized::ArrayColumn& column, uint8_t* buff, int encode_level) {
+        buff = serde::ColumnArraySerde::serialize(column.offsets(), buff, encode_level);
+        buff = serde::ColumnArraySerde::serialize(column.elements(), buff, encode_level);
         return buff;
     }
 
-    static const uint8_t* deserialize(const uint8_t* buff, vectorized::ArrayColumn* column) {
-        buff = serde::ColumnArraySerde::deserialize(buff, column->offsets_column().get());
-        buff = serde::ColumnArraySerde::deserialize(buff, column->elements_column().get());
+    static const uint8_t* deserialize(const uint8_t* buff, vectorized::ArrayColumn* column, int encode_level) {
+        buff = serde::ColumnArraySerde::deserialize(buff, column->offsets_column().get(), encode_level);
+        if (buff == nullptr) {
+            return nullptr;
+        }
+        buff = serde::ColumnArraySerde::deserialize(buff, column->elements_column().get(), encode_level);
         return buff;
     }
 };
 
 class ConstColumnSerde {
 public:
-    static int64_t max_serialized_size(const vectorized::ConstColumn& column) {
-        return /*sizeof(uint64_t)=*/8 + serde::ColumnArraySerde::max_serialized_size(*column.data_column());
+    static int64_t max_serialized_size(const vectorized::ConstColumn& column, int encode_level) {
+        return /*sizeof(uint64_t)=*/8 +
+               serde::ColumnArraySerde::max_serialized_size(*column.data_column(), encode_level);
     }
 
-    static uint8_t* serialize(const vectorized::ConstColumn& column, uint8_t* buff) {
+    static uint8_t* serialize(const vectorized::ConstColumn& column, uint8_t* buff, int encode_level) {
         buff = write_little_endian_64(column.size(), buff);
-        buff = serde::ColumnArraySerde::serialize(*column.data_column(), buff);
+        buff = serde::ColumnArraySerde::serialize(*column.data_column(), buff, encode_level);
         return buff;
     }
 
-    static const uint8_t* deserialize(const uint8_t* buff, vectorized::ConstColumn* column) {
+    static const uint8_t* deserialize(const uint8_t* buff, vectorized::ConstColumn* column, int encode_level) {
         uint64_t size = 0;
         buff = read_little_endian_64(buff, &size);
-        buff = serde::ColumnArraySerde::deserialize(buff, column->data_column().get());
+        buff = serde::ColumnArraySerde::deserialize(buff, column->data_column().get(), encode_level);
+        if (buff == nullptr) {
+            return nullptr;
+        }
         column->resize(size);
         return buff;
     }
@@ -264,31 +527,32 @@ public:
 
 class ColumnSerializedSizeVisitor final : public ColumnVisitorAdapter<ColumnSerializedSizeVisitor> {
 public:
-    explicit ColumnSerializedSizeVisitor(int64_t init_size) : ColumnVisitorAdapter(this), _size(init_size) {}
+    ColumnSerializedSizeVisitor(int64_t init_size, int encode_level)
+            : ColumnVisitorAdapter(this), _size(init_size), _encode_level(encode_level) {}
 
     Status do_visit(const vectorized::NullableColumn& column) {
-        _size += NullableColumnSerde::max_serialized_size(column);
+        _size += NullableColumnSerde::max_serialized_size(column, _encode_level);
         return Status::OK();
     }
 
     Status do_visit(const vectorized::ConstColumn& column) {
-        _size += ConstColumnSerde::max_serialized_size(column);
+        _size += ConstColumnSerde::max_serialized_size(column, _encode_level);
         return Status::OK();
     }
 
     Status do_visit(const vectorized::ArrayColumn& column) {
-        _size += ArrayColumnSerde::max_serialized_size(column);
+        _size += ArrayColumnSerde::max_serialized_size(column, _encode_level);
         return Status::OK();
     }
 
     Status do_visit(const vectorized::BinaryColumn& column) {
-        _size += BinaryColumnSerde::max_serialized_size(column);
+        _size += BinaryColumnSerde::max_serialized_size(column, _encode_level);
         return Status::OK();
     }
 
     template <typename T>
     Status do_visit(const vectorized::FixedLengthColumnBase<T>& column) {
-        _size += FixedLengthColumnSerde<T>::max_serialized_size(column);
+        _size += FixedLengthColumnSerde<T>::max_serialized_size(column, _encode_level);
         return Status::OK();
     }
 
@@ -307,35 +571,37 @@ public:
 
 private:
     int64_t _size;
+    int _encode_level;
 };
 
 class ColumnSerializingVisitor final : public ColumnVisitorAdapter<ColumnSerializingVisitor> {
 public:
-    explicit ColumnSerializingVisitor(uint8_t* buff) : ColumnVisitorAdapter(this), _buff(buff), _cur(buff) {}
+    ColumnSerializingVisitor(uint8_t* buff, int encode_level)
+            : ColumnVisitorAdapter(this), _buff(buff), _cur(buff), _encode_level(encode_level) {}
 
     Status do_visit(const vectorized::NullableColumn& column) {
-        _cur = NullableColumnSerde::serialize(column, _cur);
+        _cur = NullableColumnSerde::serialize(column, _cur, _encode_level);
         return Status::OK();
     }
 
     Status do_visit(const vectorized::ConstColumn& column) {
-        _cur = ConstColumnSerde::serialize(column, _cur);
+        _cur = ConstColumnSerde::serialize(column, _cur, _encode_level);
         return Status::OK();
     }
 
     Status do_visit(const vectorized::ArrayColumn& column) {
-        _cur = ArrayColumnSerde::serialize(column, _cur);
+        _cur = ArrayColumnSerde::serialize(column, _cur, _encode_level);
         return Status::OK();
     }
 
     Status do_visit(const vectorized::BinaryColumn& column) {
-        _cur = BinaryColumnSerde::serialize(column, _cur);
+        _cur = BinaryColumnSerde::serialize(column, _cur, _encode_level);
         return Status::OK();
     }
 
     template <typename T>
     Status do_visit(const vectorized::FixedLengthColumnBase<T>& column) {
-        _cur = FixedLengthColumnSerde<T>::serialize(column, _cur);
+        _cur = FixedLengthColumnSerde<T>::serialize(column, _cur, _encode_level);
         return Status::OK();
     }
 
@@ -357,37 +623,38 @@ public:
 private:
     uint8_t* _buff;
     uint8_t* _cur;
+    int _encode_level;
 };
 
 class ColumnDeserializingVisitor final : public ColumnVisitorMutableAdapter<ColumnDeserializingVisitor> {
 public:
-    explicit ColumnDeserializingVisitor(const uint8_t* buff)
-            : ColumnVisitorMutableAdapter(this), _buff(buff), _cur(buff) {}
+    ColumnDeserializingVisitor(const uint8_t* buff, int encode_level)
+            : ColumnVisitorMutableAdapter(this), _buff(buff), _cur(buff), _encode_level(encode_level) {}
 
     Status do_visit(vectorized::NullableColumn* column) {
-        _cur = NullableColumnSerde::deserialize(_cur, column);
-        return Status::OK();
+        _cur = NullableColumnSerde::deserialize(_cur, column, _encode_level);
+        return _cur_status();
     }
 
     Status do_visit(vectorized::ConstColumn* column) {
-        _cur = ConstColumnSerde::deserialize(_cur, column);
-        return Status::OK();
+        _cur = ConstColumnSerde::deserialize(_cur, column, _encode_level);
+        return _cur_status();
     }
 
     Status do_visit(vectorized::ArrayColumn* column) {
-        _cur = ArrayColumnSerde::deserialize(_cur, column);
-        return Status::OK();
+        _cur = ArrayColumnSerde::deserialize(_cur, column, _encode_level);
+        return _cur_status();
     }
 
     Status do_visit(vectorized::BinaryColumn* column) {
-        _cur = BinaryColumnSerde::deserialize(_cur, column);
-        return Status::OK();
+        _cur = BinaryColumnSerde::deserialize(_cur, column, _encode_level);
+        return _cur_status();
     }
 
     template <typename T>
     Status do_visit(vectorized::FixedLengthColumnBase<T>* column) {
-        _cur = FixedLengthColumnSerde<T>::deserialize(_cur, column);
-        return Status::OK();
+        _cur = FixedLengthColumnSerde<T>::deserialize(_cur, column, _encode_level);
+        return _cur_status();
     }
 
     template <typename T>
@@ -406,28 +673,31 @@ public:
     int64_t bytes() const { return _cur - _buff; }
 
 private:
+    Status _cur_status() const { return _cur != nullptr ? Status::OK() : Status::Corruption("invalid column data"); }
+
     const uint8_t* _buff;
     const uint8_t* _cur;
+    int _encode_level;
 };
 
 } // namespace
 
-int64_t ColumnArraySerde::max_serialized_size(const vectorized::Column& column) {
-    ColumnSerializedSizeVisitor visitor(0);
+int64_t ColumnArraySerde::max_serialized_size(const vectorized::Column& column, int encode_level) {
+    ColumnSerializedSizeVisitor visitor(0, encode_level);
     auto st = column.accept(&visitor);
     LOG_IF(WARNING, !st.ok()) << st;
     return st.ok() ? visitor.size() : 0;
 }
 
-uint8_t* ColumnArraySerde::serialize(const vectorized::Column& column, uint8_t* buff) {
-    ColumnSerializingVisitor visitor(buff);
+uint8_t* ColumnArraySerde::serialize(const vectorized::Column& column, uint8_t* buff, int encode_level) {
+    ColumnSerializingVisitor visitor(buff, encode_level);
     auto st = column.accept(&visitor);
     LOG_IF(WARNING, !st.ok()) << st;
     return st.ok() ? visitor.cur() : nullptr;
 }
 
-const uint8_t* ColumnArraySerde::deserialize(const uint8_t* data, vectorized::Column* column) {
-    ColumnDeserializingVisitor visitor(data);
+const uint8_t* ColumnArraySerde::deserialize(const uint8_t* data, vectorized::Column* column, int encode_level) {
+    ColumnDeserializingVisitor visitor(data, encode_level);
     auto st = column->accept_mutable(&visitor);
     LOG_IF(WARNING, !st.ok()) << st;
     return st.ok() ? visitor.cur() : nullptr;
@@ -14,17 +14,32 @@ class Column;
 
 namespace starrocks::serde {
 
+// The encodings could be used by ColumnArraySerde, the encode level is a bitwise OR of them.
+// The default encode level 0 produces the plain format, which is also used by the persisted data
+// like spill files and delta column groups, so it must not be changed.
+enum EncodeFlag : int {
+    // Frame-of-reference and bit-packing for integer, date and datetime columns.
+    ENCODE_INTEGER = 1,
+    // Dictionary for low-cardinality binary columns.
+    ENCODE_STRING = 2,
+    // Run-length for null maps.
+    ENCODE_NULL = 4,
+};
+
 // ColumnArraySerde used to serialize/deserialize a column to/from an in-memory array.
+// With a non-zero |encode_level|, each encodable part of the column is prefixed by the type of its encoding,
+// and an encoding is used only if it's smaller than the plain format. A column must be deserialized with
+// the same encode level it's serialized with.
 class ColumnArraySerde {
 public:
     // 0 means does not support the type of column
-    static int64_t max_serialized_size(const vectorized::Column& column);
+    static int64_t max_serialized_size(const vectorized::Column& column, int encode_level = 0);
 
     // Return nullptr on error.
-    static uint8_t* serialize(const vectorized::Column& column, uint8_t* buff);
+    static uint8_t* serialize(const vectorized::Column& column, uint8_t* buff, int encode_level = 0);
 
     // Return nullptr on error.
-    static const uint8_t* deserialize(const uint8_t* buff, vectorized::Column* column);
+    static const uint8_t* deserialize(const uint8_t* buff, vectorized::Column* column, int encode_level = 0);
 };
 
 } //  namespace starrocks::serde
@@ -0,0 +1,52 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "serde/encode_context.h"
+
+#include <algorithm>
+
+#include "common/config.h"
+#include "common/logging.h"
+
+namespace starrocks::serde {
+
+int EncodeContext::next_encode_level(size_t col_id) {
+    if (_session_encode_level == 0) {
+        return 0;
+    }
+    if (col_id >= _column_stats.size()) {
+        _column_stats.resize(col_id + 1);
+    }
+    ColumnEncodeStats& stats = _column_stats[col_id];
+    if (stats.skipped_chunks > 0) {
+        --stats.skipped_chunks;
+        return 0;
+    }
+    return _session_encode_level;
+}
+
+void EncodeContext::update(size_t col_id, int64_t raw_bytes, int64_t encoded_bytes, int64_t encode_ns) {
+    DCHECK_LT(col_id, _column_stats.size());
+    ColumnEncodeStats& stats = _column_stats[col_id];
+    stats.raw_bytes += raw_bytes;
+    stats.encoded_bytes += encoded_bytes;
+    stats.encode_ns += encode_ns;
+    if (++stats.sampled_chunks >= kSampleChunks) {
+        _adjust(&stats);
+    }
+}
+
+void EncodeContext::_adjust(ColumnEncodeStats* stats) {
+    int64_t saved_bytes = stats->raw_bytes - stats->encoded_bytes;
+    // bytes per second to nanoseconds per byte
+    double send_ns_per_byte = 1e3 / std::max<int64_t>(1, config::transmission_encode_bandwidth_mb);
+    bool worthwhile = stats->encoded_bytes * config::rpc_compress_ratio_threshold < stats->raw_bytes &&
+                      stats->encode_ns < saved_bytes * send_ns_per_byte;
+    VLOG(2) << "encoded " << stats->raw_bytes << " bytes to " << stats->encoded_bytes << " bytes in "
+            << stats->encode_ns << "ns, worthwhile: " << worthwhile;
+    *stats = ColumnEncodeStats();
+    if (!worthwhile) {
+        stats->skipped_chunks = kSkipChunks;
+    }
+}
+
+} // namespace starrocks::serde
@@ -0,0 +1,48 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace starrocks::serde {
+
+// EncodeContext chooses the encode level of each column of the chunks sent by an exchange sender.
+// The columns are encoded with the encode level of the session at first, and every kSampleChunks chunks
+// the observed ratio and throughput of the encoding decide whether a column is still encoded: a column
+// is sent without encoding for the next kSkipChunks chunks if the encoding saves few bytes, or it takes
+// more time than sending the saved bytes with `transmission_encode_bandwidth_mb`.
+// Not thread-safe.
+class EncodeContext {
+public:
+    // |encode_level| is a bitwise OR of EncodeFlag.
+    explicit EncodeContext(int encode_level) : _session_encode_level(encode_level) {}
+
+    // The encode level of the |col_id|-th column of the next chunk, 0 means not to encode it.
+    int next_encode_level(size_t col_id);
+
+    // Record that the |col_id|-th column of |raw_bytes| in the plain format is encoded to |encoded_bytes|
+    // in |encode_ns|.
+    void update(size_t col_id, int64_t raw_bytes, int64_t encoded_bytes, int64_t encode_ns);
+
+    int session_encode_level() const { return _session_encode_level; }
+
+private:
+    static constexpr int kSampleChunks = 16;
+    static constexpr int kSkipChunks = 256;
+
+    struct ColumnEncodeStats {
+        int64_t raw_bytes = 0;
+        int64_t encoded_bytes = 0;
+        int64_t encode_ns = 0;
+        int sampled_chunks = 0;
+        int skipped_chunks = 0;
+    };
+
+    void _adjust(ColumnEncodeStats* stats);
+
+    const int _session_encode_level;
+    std::vector<ColumnEncodeStats> _column_stats;
+};
+
+} // namespace starrocks::serde
@@ -6,21 +6,36 @@
 #include "gutil/strings/substitute.h"
 #include "runtime/descriptors.h"
 #include "serde/column_array_serde.h"
+#include "serde/encode_context.h"
 #include "util/coding.h"
 #include "util/raw_container.h"
+#include "util/time.h"
 
 namespace starrocks::serde {
 
-int64_t ProtobufChunkSerde::max_serialized_size(const vectorized::Chunk& chunk) {
+// The columns are in the plain format.
+static constexpr uint32_t kPlainVersion = 1;
+// Each column is written after one byte of its encode level.
+static constexpr uint32_t kEncodedVersion = 2;
+
+int64_t ProtobufChunkSerde::max_serialized_size(const vectorized::Chunk& chunk, const EncodeContext* context) {
     int64_t serialized_size = 8; // 4 bytes version plus 4 bytes row number
+    if (context == nullptr) {
+        for (const auto& column : chunk.columns()) {
+            serialized_size += ColumnArraySerde::max_serialized_size(*column);
+        }
+        return serialized_size;
+    }
+    // All the encodings of the session are counted as the encode level of a column is unknown until
+    // it's serialized.
     for (const auto& column : chunk.columns()) {
-        serialized_size += ColumnArraySerde::max_serialized_size(*column);
+        serialized_size += 1 + ColumnArraySerde::max_serialized_size(*column, context->session_encode_level());
     }
     return serialized_size;
 }
 
-StatusOr<ChunkPB> ProtobufChunkSerde::serialize(const vectorized::Chunk& chunk) {
-    StatusOr<ChunkPB> res = serialize_without_meta(chunk);
+StatusOr<ChunkPB> ProtobufChunkSerde::serialize(const vectorized::Chunk& chunk, EncodeContext* context) {
+    StatusOr<ChunkPB> res = serialize_without_meta(chunk, context);
     if (!res.ok()) return res.status();
 
     const auto& slot_id_to_index = chunk.get_slot_id_to_index_map();
@@ -53,19 +68,36 @@ StatusOr<ChunkPB> ProtobufChunkSerde::serialize(const vectorized::Chunk& chunk)
     return res;
 }
 
-StatusOr<ChunkPB> ProtobufChunkSerde::serialize_without_meta(const vectorized::Chunk& chunk) {
+StatusOr<ChunkPB> ProtobufChunkSerde::serialize_without_meta(const vectorized::Chunk& chunk, EncodeContext* context) {
     ChunkPB chunk_pb;
     chunk_pb.set_compress_type(CompressionTypePB::NO_COMPRESSION);
 
     std::string* serialized_data = chunk_pb.mutable_data();
-    raw::stl_string_resize_uninitialized(serialized_data, ProtobufChunkSerde::max_serialized_size(chunk));
+    raw::stl_string_resize_uninitialized(serialized_data, ProtobufChunkSerde::max_serialized_size(chunk, context));
     auto* buff = reinterpret_cast<uint8_t*>(serialized_data->data());
-    encode_fixed32_le(buff + 0, 1);
+    encode_fixed32_le(buff + 0, context == nullptr ? kPlainVersion : kEncodedVersion);
     encode_fixed32_le(buff + 4, chunk.num_rows());
     buff = buff + 8;
 
-    for (const auto& column : chunk.columns()) {
-        buff = ColumnArraySerde::serialize(*column, buff);
+    const auto& columns = chunk.columns();
+    for (size_t i = 0; i < columns.size(); i++) {
+        if (context == nullptr) {
+            buff = ColumnArraySerde::serialize(*columns[i], buff);
+        } else {
+            int encode_level = context->next_encode_level(i);
+            *buff++ = static_cast<uint8_t>(encode_level);
+            if (encode_level == 0) {
+                buff = ColumnArraySerde::serialize(*columns[i], buff);
+            } else {
+                int64_t start_ns = MonotonicNanos();
+                uint8_t* begin = buff;
+                buff = ColumnArraySerde::serialize(*columns[i], buff, encode_level);
+                if (LIKELY(buff != nullptr)) {
+                    context->update(i, ColumnArraySerde::max_serialized_size(*columns[i]), buff - begin,
+                                    MonotonicNanos() - start_ns);
+                }
+            }
+        }
         if (UNLIKELY(buff == nullptr)) return Status::InternalError("has unsupported column");
     }
     chunk_pb.set_serialized_size(buff - reinterpret_cast<const uint8_t*>(serialized_data->data()));
@@ -115,7 +147,7 @@ StatusOr<vectorized::Chunk> ProtobufChunkDeserializer::deserialize(std::string_v
     auto* cur = reinterpret_cast<const uint8_t*>(buff.data());
 
     uint32_t version = decode_fixed32_le(cur);
-    if (version != 1) {
+    if (version != kPlainVersion && version != kEncodedVersion) {
         return Status::Corruption("invalid version");
     }
     cur += 4;
@@ -130,7 +162,15 @@ StatusOr<vectorized::Chunk> ProtobufChunkDeserializer::deserialize(std::string_v
     }
 
     for (auto& column : columns) {
-        cur = ColumnArraySerde::deserialize(cur, column.get());
+        if (version == kEncodedVersion) {
+            uint8_t encode_level = *cur++;
+            cur = ColumnArraySerde::deserialize(cur, column.get(), encode_level);
+            if (UNLIKELY(cur == nullptr)) {
+                return Status::Corruption("failed to deserialize encoded column");
+            }
+        } else {
+            cur = ColumnArraySerde::deserialize(cur, column.get());
+        }
     }
 
     for (auto& col : columns) {
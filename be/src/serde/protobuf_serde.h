@@ -15,21 +15,26 @@ class RowDescriptor;
 
 namespace starrocks::serde {
 
+class EncodeContext;
 class ProtobufChunkDeserializer;
 
+// The columns are written in the plain format of ColumnArraySerde if no EncodeContext is given,
+// otherwise each column is written with the encode level chosen by the EncodeContext, and the
+// data has a different version so ProtobufChunkDeserializer could tell them apart.
 class ProtobufChunkSerde {
 public:
-    static int64_t max_serialized_size(const vectorized::Chunk& chunk);
+    static int64_t max_serialized_size(const vectorized::Chunk& chunk, const EncodeContext* context = nullptr);
 
     // Write the contents of |chunk| to ChunkPB
-    static StatusOr<ChunkPB> serialize(const vectorized::Chunk& chunk);
+    static StatusOr<ChunkPB> serialize(const vectorized::Chunk& chunk, EncodeContext* context = nullptr);
 
     // Like `serialize()` but leave the following fields of ChunkPB unfilled:
     //  - slot_id_map()
     //  - tuple_id_map()
     //  - is_nulls()
     //  - is_consts()
-    static StatusOr<ChunkPB> serialize_without_meta(const vectorized::Chunk& chunk);
+    static StatusOr<ChunkPB> serialize_without_meta(const vectorized::Chunk& chunk,
+                                                    EncodeContext* context = nullptr);
 
     // REQUIRE: the following fields of |chunk_pb| must be non-empty:
     //  - slot_id_map()
@@ -77,6 +77,16 @@ void PInternalServiceImpl<T>::transmit_data(google::protobuf::RpcController* cnt
     }
 }
 
+// Copy the data of the chunks of |request| from |io_buf| starting at |offset|, return the end offset.
+static size_t copy_chunks_from_attachment(const butil::IOBuf& io_buf, size_t offset, PTransmitChunkParams* request) {
+    for (size_t i = 0; i < request->chunks().size(); ++i) {
+        auto chunk = request->mutable_chunks(i);
+        io_buf.copy_to(chunk->mutable_data(), chunk->data_size(), offset);
+        offset += chunk->data_size();
+    }
+    return offset;
+}
+
 template <typename T>
 void PInternalServiceImpl<T>::transmit_chunk(google::protobuf::RpcController* cntl_base,
                                              const PTransmitChunkParams* request, PTransmitChunkResult* response,
@@ -89,13 +99,7 @@ void PInternalServiceImpl<T>::transmit_chunk(google::protobuf::RpcController* cn
     brpc::Controller* cntl = static_cast<brpc::Controller*>(cntl_base);
     PTransmitChunkParams* req = const_cast<PTransmitChunkParams*>(request);
     if (cntl->request_attachment().size() > 0) {
-        const butil::IOBuf& io_buf = cntl->request_attachment();
-        size_t offset = 0;
-        for (size_t i = 0; i < req->chunks().size(); ++i) {
-            auto chunk = req->mutable_chunks(i);
-            io_buf.copy_to(chunk->mutable_data(), chunk->data_size(), offset);
-            offset += chunk->data_size();
-        }
+        copy_chunks_from_attachment(cntl->request_attachment(), 0, req);
     }
     Status st;
     st.to_protobuf(response->mutable_status());
@@ -111,6 +115,32 @@ void PInternalServiceImpl<T>::transmit_chunk(google::protobuf::RpcController* cn
     }
 }
 
+template <typename T>
+void PInternalServiceImpl<T>::transmit_chunk_batch(google::protobuf::RpcController* cntl_base,
+                                                   const PTransmitChunkBatchParams* request,
+                                                   PTransmitChunkResult* response, google::protobuf::Closure* done) {
+    VLOG_ROW << "transmit data batch: num_requests=" << request->requests_size();
+    brpc::Controller* cntl = static_cast<brpc::Controller*>(cntl_base);
+    auto* req = const_cast<PTransmitChunkBatchParams*>(request);
+    if (cntl->request_attachment().size() > 0) {
+        size_t offset = 0;
+        for (auto& sub_request : *req->mutable_requests()) {
+            offset = copy_chunks_from_attachment(cntl->request_attachment(), offset, &sub_request);
+        }
+    }
+    Status st;
+    st.to_protobuf(response->mutable_status());
+    st = _exec_env->stream_mgr()->transmit_chunk_batch(*request, &done);
+    if (!st.ok()) {
+        LOG(WARNING) << "transmit_data batch failed, message=" << st.get_error_msg();
+    }
+    if (done != nullptr) {
+        // NOTE: only when done is not null, we can set response status
+        st.to_protobuf(response->mutable_status());
+        done->Run();
+    }
+}
+
 template <typename T>
 void PInternalServiceImpl<T>::transmit_runtime_filter(google::protobuf::RpcController* cntl_base,
                                                       const PTransmitRuntimeFilterParams* request,
@@ -35,6 +35,7 @@
 #include <cstdio>
 #include <filesystem>
 #include <fstream>
+#include <mutex>
 #include <set>
 #include <sstream>
 #include <utility>
@@ -56,6 +57,7 @@
 #include "util/file_utils.h"
 #include "util/monotime.h"
 #include "util/string_util.h"
+#include "util/threadpool.h"
 
 using strings::Substitute;
 
@@ -63,6 +65,8 @@ namespace starrocks {
 
 static const char* const kMtabPath = "/etc/mtab";
 static const char* const kTestFilePath = "/.testfile";
+// number of the tablet or rowset metas loaded by a task at startup
+static const size_t kLoadMetaBatchSize = 256;
 
 DataDir::DataDir(std::string path, TStorageMedium::type storage_medium, TabletManager* tablet_manager,
                  TxnManager* txn_manager)
@@ -424,27 +428,55 @@ Status DataDir::load() {
     // COMMITTED: add to txn manager
     // VISIBLE: add to tablet
     // if one rowset load failed, then the total data dir will not be loaded
+    // The metas are parsed and the tablets are created by |load_pool| in batches, while
+    // the current thread iterates the meta store.
+    std::unique_ptr<ThreadPool> load_pool;
+    RETURN_IF_ERROR(ThreadPoolBuilder("load_tablet")
+                            .set_min_threads(1)
+                            .set_max_threads(std::max(1, config::load_tablet_thread_num_per_store))
+                            .build(&load_pool));
+    // run |task| in |load_pool|, or in the current thread if it's failed to submit.
+    auto run_task = [&load_pool](const std::function<void()>& task) {
+        if (!load_pool->submit_func(task).ok()) {
+            task();
+        }
+    };
+    std::mutex result_lock;
+
     std::vector<RowsetMetaSharedPtr> dir_rowset_metas;
     LOG(INFO) << "begin loading rowset from meta";
-    auto load_rowset_func = [&dir_rowset_metas](const TabletUid& tablet_uid, RowsetId rowset_id,
-                                                const std::string& meta_str) -> bool {
-        RowsetMetaSharedPtr rowset_meta(new RowsetMeta());
-        bool parsed = rowset_meta->init(meta_str);
-        if (!parsed) {
-            LOG(WARNING) << "parse rowset meta string failed for rowset_id:" << rowset_id;
-            // return false will break meta iterator, return true to skip this error
-            return true;
+    auto parse_rowset_metas = [&dir_rowset_metas, &result_lock](const std::vector<std::string>& meta_strs) {
+        std::vector<RowsetMetaSharedPtr> rowset_metas;
+        rowset_metas.reserve(meta_strs.size());
+        for (const auto& meta_str : meta_strs) {
+            RowsetMetaSharedPtr rowset_meta(new RowsetMeta());
+            bool parsed = rowset_meta->init(meta_str);
+            if (!parsed) {
+                LOG(WARNING) << "parse rowset meta string failed";
+                continue;
+            }
+            if (rowset_meta->rowset_type() == ALPHA_ROWSET) {
+                LOG(FATAL) << "must change V1 format to V2 format."
+                           << "tablet_id: " << rowset_meta->tablet_id() << ", tablet_uid:" << rowset_meta->tablet_uid()
+                           << ", schema_hash: " << rowset_meta->tablet_schema_hash()
+                           << ", rowset_id:" << rowset_meta->rowset_id();
+            }
+            rowset_metas.emplace_back(std::move(rowset_meta));
         }
-        if (rowset_meta->rowset_type() == ALPHA_ROWSET) {
-            LOG(FATAL) << "must change V1 format to V2 format."
-                       << "tablet_id: " << rowset_meta->tablet_id() << ", tablet_uid:" << rowset_meta->tablet_uid()
-                       << ", schema_hash: " << rowset_meta->tablet_schema_hash()
-                       << ", rowset_id:" << rowset_meta->rowset_id();
+        std::lock_guard l(result_lock);
+        dir_rowset_metas.insert(dir_rowset_metas.end(), rowset_metas.begin(), rowset_metas.end());
+    };
+    auto rowset_meta_batch = std::make_shared<std::vector<std::string>>();
+    auto load_rowset_func = [&](const TabletUid& tablet_uid, RowsetId rowset_id, const std::string& meta_str) -> bool {
+        rowset_meta_batch->emplace_back(meta_str);
+        if (rowset_meta_batch->size() >= kLoadMetaBatchSize) {
+            run_task([&parse_rowset_metas, batch = std::move(rowset_meta_batch)] { parse_rowset_metas(*batch); });
+            rowset_meta_batch = std::make_shared<std::vector<std::string>>();
         }
-        dir_rowset_metas.push_back(rowset_meta);
         return true;
     };
     Status load_rowset_status = RowsetMetaManager::traverse_rowset_metas(_kv_store, load_rowset_func);
+    run_task([&parse_rowset_metas, batch = std::move(rowset_meta_batch)] { parse_rowset_metas(*batch); });
 
     if (!load_rowset_status.ok()) {
         LOG(WARNING) << "errors when load rowset meta from meta env, skip this data dir:" << _path;
@@ -457,26 +489,46 @@ Status DataDir::load() {
     LOG(INFO) << "begin loading tablet from meta";
     std::set<int64_t> tablet_ids;
     std::set<int64_t> failed_tablet_ids;
-    auto load_tablet_func = [this, &tablet_ids, &failed_tablet_ids](int64_t tablet_id, int32_t schema_hash,
-                                                                    const std::string& value) -> bool {
-        Status st =
-                _tablet_manager->load_tablet_from_meta(this, tablet_id, schema_hash, value, false, false, false, false);
-        if (!st.ok() && !st.is_not_found()) {
-            // load_tablet_from_meta() may return NotFound which means the tablet status is DELETED
-            // This may happen when the tablet was just deleted before the BE restarted,
-            // but it has not been cleared from rocksdb. At this time, restarting the BE
-            // will read the tablet in the DELETE state from rocksdb. These tablets have been
-            // added to the garbage collection queue and will be automatically deleted afterwards.
-            // Therefore, we believe that this situation is not a failure.
-            LOG(WARNING) << "load tablet from header failed. status:" << st.to_string() << ", tablet=" << tablet_id
-                         << "." << schema_hash;
-            failed_tablet_ids.insert(tablet_id);
-        } else {
-            tablet_ids.insert(tablet_id);
+    struct TabletMetaEntry {
+        int64_t tablet_id;
+        int32_t schema_hash;
+        std::string value;
+    };
+    auto load_tablets = [this, &tablet_ids, &failed_tablet_ids, &result_lock](
+                                const std::vector<TabletMetaEntry>& entries) {
+        for (const auto& entry : entries) {
+            Status st = _tablet_manager->load_tablet_from_meta_at_startup(this, entry.tablet_id, entry.schema_hash,
+                                                                          entry.value);
+            std::lock_guard l(result_lock);
+            if (!st.ok() && !st.is_not_found()) {
+                // load_tablet_from_meta() may return NotFound which means the tablet status is DELETED
+                // This may happen when the tablet was just deleted before the BE restarted,
+                // but it has not been cleared from rocksdb. At this time, restarting the BE
+                // will read the tablet in the DELETE state from rocksdb. These tablets have been
+                // added to the garbage collection queue and will be automatically deleted afterwards.
+                // Therefore, we believe that this situation is not a failure.
+                LOG(WARNING) << "load tablet from header failed. status:" << st.to_string()
+                             << ", tablet=" << entry.tablet_id << "." << entry.schema_hash;
+                failed_tablet_ids.insert(entry.tablet_id);
+            } else {
+                tablet_ids.insert(entry.tablet_id);
+            }
+        }
+    };
+    auto tablet_meta_batch = std::make_shared<std::vector<TabletMetaEntry>>();
+    auto load_tablet_func = [&](int64_t tablet_id, int32_t schema_hash, const std::string& value) -> bool {
+        tablet_meta_batch->push_back({tablet_id, schema_hash, value});
+        if (tablet_meta_batch->size() >= kLoadMetaBatchSize) {
+            run_task([&load_tablets, batch = std::move(tablet_meta_batch)] { load_tablets(*batch); });
+            tablet_meta_batch = std::make_shared<std::vector<TabletMetaEntry>>();
         }
         return true;
     };
     Status load_tablet_status = TabletMetaManager::traverse_headers(_kv_store, load_tablet_func);
+    run_task([&load_tablets, batch = std::move(tablet_meta_batch)] { load_tablets(*batch); });
+    load_pool->wait();
+    load_pool->shutdown();
+
     if (failed_tablet_ids.size() != 0) {
         LOG(ERROR) << "load tablets from header failed"
                    << ", loaded tablet: " << tablet_ids.size() << ", error tablet: " << failed_tablet_ids.size()
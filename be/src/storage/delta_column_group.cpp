@@ -0,0 +1,173 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "storage/delta_column_group.h"
+
+#include <algorithm>
+
+#include "column/chunk.h"
+#include "column/column.h"
+#include "column/fixed_length_column.h"
+#include "env/env.h"
+#include "gen_cpp/olap_file.pb.h"
+#include "gutil/strings/join.h"
+#include "gutil/strings/substitute.h"
+#include "serde/column_array_serde.h"
+#include "storage/fs/block_manager.h"
+#include "storage/fs/fs_util.h"
+#include "storage/tablet_schema.h"
+#include "storage/vectorized/chunk_helper.h"
+
+namespace starrocks {
+
+void DeltaColumnGroup::init(int64_t version, std::vector<uint32_t> column_ids, std::string file_name) {
+    _version = version;
+    _column_ids = std::move(column_ids);
+    _file_name = std::move(file_name);
+}
+
+Status DeltaColumnGroup::load(int64_t version, const char* data, size_t length) {
+    DeltaColumnGroupPB pb;
+    if (!pb.ParseFromArray(data, length)) {
+        return Status::Corruption("parse DeltaColumnGroupPB failed");
+    }
+    _version = version;
+    _column_ids.assign(pb.column_ids().begin(), pb.column_ids().end());
+    _file_name = pb.file_name();
+    return Status::OK();
+}
+
+std::string DeltaColumnGroup::save() const {
+    DeltaColumnGroupPB pb;
+    for (uint32_t cid : _column_ids) {
+        pb.add_column_ids(cid);
+    }
+    pb.set_file_name(_file_name);
+    return pb.SerializeAsString();
+}
+
+std::string DeltaColumnGroup::to_string() const {
+    return strings::Substitute("DeltaColumnGroup version:$0 columns:[$1] file:$2", _version,
+                               JoinInts(_column_ids, ","), _file_name);
+}
+
+Status DeltaColumnGroup::write_file(const std::string& path, const vectorized::Column& rowids,
+                                    const std::vector<const vectorized::Column*>& columns) {
+    size_t size = serde::ColumnArraySerde::max_serialized_size(rowids);
+    for (const auto* column : columns) {
+        DCHECK_EQ(rowids.size(), column->size());
+        size += serde::ColumnArraySerde::max_serialized_size(*column);
+    }
+    std::vector<uint8_t> content(size);
+    uint8_t* end = serde::ColumnArraySerde::serialize(rowids, content.data());
+    for (size_t i = 0; i < columns.size() && end != nullptr; i++) {
+        end = serde::ColumnArraySerde::serialize(*columns[i], end);
+    }
+    if (end == nullptr) {
+        return Status::InternalError("delta column serialize failed");
+    }
+
+    std::unique_ptr<fs::WritableBlock> wblock;
+    fs::CreateBlockOptions opts({path});
+    opts.mode = Env::CREATE_OR_OPEN_WITH_TRUNCATE;
+    RETURN_IF_ERROR(fs::fs_util::block_manager()->create_block(opts, &wblock));
+    RETURN_IF_ERROR(wblock->append(Slice(content.data(), end - content.data())));
+    RETURN_IF_ERROR(wblock->finalize());
+    return wblock->close();
+}
+
+Status DeltaColumnGroup::read_file(const std::string& path, vectorized::Column* rowids,
+                                   const std::vector<vectorized::Column*>& columns) {
+    std::unique_ptr<fs::ReadableBlock> rblock;
+    RETURN_IF_ERROR(fs::fs_util::block_manager()->open_block(path, &rblock));
+    uint64_t file_size = 0;
+    RETURN_IF_ERROR(rblock->size(&file_size));
+    std::vector<uint8_t> content(file_size);
+    RETURN_IF_ERROR(rblock->read(0, Slice(content.data(), content.size())));
+
+    const uint8_t* p = serde::ColumnArraySerde::deserialize(content.data(), rowids);
+    for (size_t i = 0; i < columns.size() && p != nullptr; i++) {
+        p = serde::ColumnArraySerde::deserialize(p, columns[i]);
+        if (p != nullptr && columns[i]->size() != rowids->size()) {
+            p = nullptr;
+        }
+    }
+    if (p == nullptr || p > content.data() + content.size()) {
+        return Status::Corruption(strings::Substitute("bad delta column file $0", path));
+    }
+    return Status::OK();
+}
+
+Status load_delta_column_values(const std::string& dir, const TabletSchema& tablet_schema,
+                                const DeltaColumnGroupList& dcgs, const std::vector<uint32_t>& column_ids,
+                                std::map<uint32_t, DeltaColumnValues>* values) {
+    // (rowid, index of the source column, row in the source column) of each update of a column
+    struct Update {
+        uint32_t rowid;
+        uint32_t source;
+        uint32_t row;
+    };
+    std::map<uint32_t, std::vector<Update>> updates;
+    std::vector<vectorized::ColumnPtr> sources;
+    for (const auto& dcg : dcgs) {
+        const auto& dcg_column_ids = dcg->column_ids();
+        bool needed = std::any_of(dcg_column_ids.begin(), dcg_column_ids.end(), [&](uint32_t cid) {
+            return std::find(column_ids.begin(), column_ids.end(), cid) != column_ids.end();
+        });
+        if (!needed) {
+            continue;
+        }
+        auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema, dcg_column_ids);
+        auto chunk = vectorized::ChunkHelper::new_chunk(schema, 0);
+        auto rowids = vectorized::UInt32Column::create();
+        std::vector<vectorized::Column*> columns;
+        for (size_t i = 0; i < chunk->num_columns(); i++) {
+            columns.emplace_back(chunk->get_column_by_index(i).get());
+        }
+        RETURN_IF_ERROR(DeltaColumnGroup::read_file(dir + "/" + dcg->file_name(), rowids.get(), columns));
+
+        const auto& rowid_data = rowids->get_data();
+        for (size_t i = 0; i < dcg_column_ids.size(); i++) {
+            uint32_t cid = dcg_column_ids[i];
+            if (std::find(column_ids.begin(), column_ids.end(), cid) == column_ids.end()) {
+                continue;
+            }
+            uint32_t source = sources.size();
+            sources.emplace_back(chunk->get_column_by_index(i));
+            auto& column_updates = updates[cid];
+            column_updates.reserve(column_updates.size() + rowid_data.size());
+            for (uint32_t row = 0; row < rowid_data.size(); row++) {
+                column_updates.push_back({rowid_data[row], source, row});
+            }
+        }
+    }
+
+    for (auto& [cid, column_updates] : updates) {
+        auto& v = (*values)[cid];
+        const uint32_t first_source = column_updates.front().source;
+        if (column_updates.back().source == first_source) {
+            // only updated by one delta column group, the rowids are sorted and unique already.
+            v.rowids.reserve(column_updates.size());
+            for (const auto& u : column_updates) {
+                v.rowids.push_back(u.rowid);
+            }
+            v.values = sources[first_source];
+            continue;
+        }
+        // the updates of the same row are kept in version order, the last one is the newest.
+        std::stable_sort(column_updates.begin(), column_updates.end(),
+                         [](const Update& lhs, const Update& rhs) { return lhs.rowid < rhs.rowid; });
+        v.values = sources[first_source]->clone_empty();
+        v.values->reserve(column_updates.size());
+        for (size_t i = 0; i < column_updates.size(); i++) {
+            const auto& u = column_updates[i];
+            if (i + 1 < column_updates.size() && column_updates[i + 1].rowid == u.rowid) {
+                continue;
+            }
+            v.rowids.push_back(u.rowid);
+            v.values->append(*sources[u.source], u.row, 1);
+        }
+    }
+    return Status::OK();
+}
+
+} // namespace starrocks
@@ -0,0 +1,74 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "column/vectorized_fwd.h"
+#include "common/status.h"
+
+namespace starrocks {
+
+class TabletSchema;
+
+// The values of some columns of a segment, updated by a column mode partial update at a version.
+// Only the updated rows are stored, in a delta column file beside the segment file:
+// |rowids|column 0|column 1|...|
+// each part is serialized by ColumnArraySerde, rowids are sorted in ascending order, and the column
+// types are the format v2 types of |column_ids| in the tablet schema.
+// Like DelVector, the meta is stored in the meta store and associated with EditVersion's major version.
+class DeltaColumnGroup {
+public:
+    DeltaColumnGroup() = default;
+    ~DeltaColumnGroup() = default;
+
+    void init(int64_t version, std::vector<uint32_t> column_ids, std::string file_name);
+
+    int64_t version() const { return _version; }
+
+    const std::vector<uint32_t>& column_ids() const { return _column_ids; }
+
+    // file name relative to the directory of the segment
+    const std::string& file_name() const { return _file_name; }
+
+    Status load(int64_t version, const char* data, size_t length);
+
+    std::string save() const;
+
+    std::string to_string() const;
+
+    // Write |rowids| and the values of |columns| of these rows to the delta column file |path|.
+    static Status write_file(const std::string& path, const vectorized::Column& rowids,
+                             const std::vector<const vectorized::Column*>& columns);
+
+    // |columns| must be empty columns with the same types as the ones written.
+    static Status read_file(const std::string& path, vectorized::Column* rowids,
+                            const std::vector<vectorized::Column*>& columns);
+
+private:
+    int64_t _version = 0;
+    std::vector<uint32_t> _column_ids;
+    std::string _file_name;
+};
+
+using DeltaColumnGroupPtr = std::shared_ptr<DeltaColumnGroup>;
+// ordered by version in ascending order
+using DeltaColumnGroupList = std::vector<DeltaColumnGroupPtr>;
+
+// The merged updates of a column of a segment, |rowids| are sorted in ascending order, and
+// |values| holds the newest value of each row.
+struct DeltaColumnValues {
+    std::vector<uint32_t> rowids;
+    vectorized::ColumnPtr values;
+};
+
+// Load the updates of |column_ids| from the delta column files of |dcgs| under |dir|, the columns
+// not updated by any of |dcgs| are absent from |values|.
+Status load_delta_column_values(const std::string& dir, const TabletSchema& tablet_schema,
+                                const DeltaColumnGroupList& dcgs, const std::vector<uint32_t>& column_ids,
+                                std::map<uint32_t, DeltaColumnValues>* values);
+
+} // namespace starrocks
@@ -421,6 +421,8 @@ struct OlapReaderStatistics {
     int64_t raw_rows_read = 0;
 
     int64_t rows_vec_cond_filtered = 0;
+    // the rows filtered by the predicates evaluated on encoded pages, included in |rows_vec_cond_filtered|.
+    int64_t rows_encoded_pred_filtered = 0;
     int64_t vec_cond_ns = 0;
     int64_t vec_cond_evaluate_ns = 0;
     int64_t vec_cond_chunk_copy_ns = 0;
@@ -432,6 +434,8 @@ struct OlapReaderStatistics {
     int64_t rows_key_range_filtered = 0;
     int64_t rows_stats_filtered = 0;
     int64_t rows_bf_filtered = 0;
+    // Rows filtered by probing the bloom filters of join runtime filters.
+    int64_t rows_runtime_filter_filtered = 0;
     int64_t rows_del_filtered = 0;
     int64_t del_filter_ns = 0;
 
@@ -440,8 +444,17 @@ struct OlapReaderStatistics {
     int64_t total_pages_num = 0;
     int64_t cached_pages_num = 0;
 
+    // coalesced reads of data pages, see PrefetchReadableBlock
+    int64_t prefetch_io_count = 0;
+    int64_t prefetch_pages = 0;
+    int64_t prefetch_bytes = 0;
+    int64_t prefetch_hit_pages = 0;
+    int64_t prefetch_hit_bytes = 0;
+
     int64_t rows_bitmap_index_filtered = 0;
     int64_t bitmap_index_filter_timer = 0;
+    int64_t rows_inverted_index_filtered = 0;
+    int64_t inverted_index_filter_timer = 0;
 
     int64_t rows_del_vec_filtered = 0;
 
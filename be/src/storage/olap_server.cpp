@@ -137,6 +137,12 @@ Status StorageEngine::start_bg_threads() {
     Thread::set_thread_name(_fd_cache_clean_thread, "fd_cache_clean");
     LOG(INFO) << "fd cache clean thread started";
 
+    if (config::verify_rowset_files_after_load) {
+        _rowset_file_verify_thread = std::thread([this] { _rowset_file_verify_callback(nullptr); });
+        Thread::set_thread_name(_rowset_file_verify_thread, "rowset_verify");
+        LOG(INFO) << "rowset file verify thread started";
+    }
+
     // path scan and gc thread
     if (config::path_gc_check) {
         for (auto data_dir : get_stores()) {
@@ -152,6 +158,21 @@ Status StorageEngine::start_bg_threads() {
     return Status::OK();
 }
 
+void* StorageEngine::_rowset_file_verify_callback(void* arg) {
+#ifdef GOOGLE_PROFILER
+    ProfilerRegisterThread();
+#endif
+    int64_t start_ms = MonotonicMillis();
+    for (DataDir* data_dir : get_stores()) {
+        if (_bg_worker_stopped.load(std::memory_order_consume)) {
+            break;
+        }
+        _tablet_manager->verify_rowset_files(data_dir, _bg_worker_stopped);
+    }
+    LOG(INFO) << "rowset file verify finished in " << MonotonicMillis() - start_ms << "ms";
+    return nullptr;
+}
+
 void* StorageEngine::_fd_cache_clean_callback(void* arg) {
 #ifdef GOOGLE_PROFILER
     ProfilerRegisterThread();
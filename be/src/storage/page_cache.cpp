@@ -23,9 +23,11 @@
 
 #include <malloc.h>
 
+#include "column/column.h"
 #include "runtime/current_thread.h"
 #include "runtime/exec_env.h"
 #include "runtime/mem_tracker.h"
+#include "storage/page_disk_cache.h"
 #include "util/defer_op.h"
 #include "util/metrics.h"
 #include "util/starrocks_metrics.h"
@@ -50,18 +52,64 @@ void StoragePageCache::release_global_cache() {
 StoragePageCache::StoragePageCache(MemTracker* mem_tracker, size_t capacity)
         : _mem_tracker(mem_tracker), _cache(new_lru_cache(capacity)) {}
 
-StoragePageCache::~StoragePageCache() {}
+StoragePageCache::~StoragePageCache() {
+    // the pages evicted on destruction are not demoted
+    _demote_enabled = false;
+    _cache.reset();
+    _disk_cache.reset();
+}
+
+Status StoragePageCache::init_disk_cache(const std::string& path, size_t capacity) {
+    auto disk_cache = std::make_unique<PageDiskCache>(path, capacity, _mem_tracker);
+    RETURN_IF_ERROR(disk_cache->open());
+    _disk_cache = std::move(disk_cache);
+    _demote_enabled = true;
+    LOG(INFO) << "storage page disk cache opened, path:" << path << " capacity:" << capacity
+              << " usage:" << _disk_cache->usage() << " pages:" << _disk_cache->num_pages();
+    return Status::OK();
+}
 
 bool StoragePageCache::lookup(const CacheKey& key, PageCacheHandle* handle) {
+    StarRocksMetrics::instance()->page_cache_lookup_total.increment(1);
+    std::string encoded_key = key.encode();
+    auto* lru_handle = _cache->lookup(encoded_key);
+    if (lru_handle != nullptr) {
+        StarRocksMetrics::instance()->page_cache_memory_hit_total.increment(1);
+        *handle = PageCacheHandle(_cache.get(), lru_handle);
+        return true;
+    }
+    if (_disk_cache == nullptr) {
+        return false;
+    }
+    // Allocate APPEND_OVERFLOW_MAX_SIZE more bytes like PageIO does to make append_strings_overflow work
+    std::unique_ptr<char[]> page;
+    size_t size = 0;
+    if (!_disk_cache->lookup(encoded_key, vectorized::Column::APPEND_OVERFLOW_MAX_SIZE, &page, &size)) {
+        return false;
+    }
+    StarRocksMetrics::instance()->page_cache_disk_hit_total.increment(1);
+    // promote the page to memory
+    lru_handle = _insert(encoded_key, Slice(page.release(), size), false);
+    *handle = PageCacheHandle(_cache.get(), lru_handle);
+    return true;
+}
+
+bool StoragePageCache::contains(const CacheKey& key) {
     auto* lru_handle = _cache->lookup(key.encode());
     if (lru_handle == nullptr) {
         return false;
     }
-    *handle = PageCacheHandle(_cache.get(), lru_handle);
+    // release the entry like PageCacheHandle does
+    PageCacheHandle handle(_cache.get(), lru_handle);
     return true;
 }
 
 void StoragePageCache::insert(const CacheKey& key, const Slice& data, PageCacheHandle* handle, bool in_memory) {
+    auto* lru_handle = _insert(key.encode(), data, in_memory);
+    *handle = PageCacheHandle(_cache.get(), lru_handle);
+}
+
+Cache::Handle* StoragePageCache::_insert(const std::string& key, const Slice& data, bool in_memory) {
 #ifndef BE_TEST
     int64_t mem_size = malloc_usable_size(data.data);
     tls_thread_status.mem_release(mem_size);
@@ -70,15 +118,25 @@ void StoragePageCache::insert(const CacheKey& key, const Slice& data, PageCacheH
     DeferOp op([&] { tls_thread_status.set_mem_tracker(prev_tracker); });
 #endif
 
-    auto deleter = [](const starrocks::CacheKey& key, void* value) { delete[](uint8_t*) value; };
-
     CachePriority priority = CachePriority::NORMAL;
     if (in_memory) {
         priority = CachePriority::DURABLE;
     }
 
-    auto* lru_handle = _cache->insert(key.encode(), data.data, data.size, deleter, priority);
-    *handle = PageCacheHandle(_cache.get(), lru_handle);
+    auto* page = new CachedPage{data, this};
+    return _cache->insert(key, page, data.size, &StoragePageCache::_delete_page, priority);
+}
+
+void StoragePageCache::_delete_page(const starrocks::CacheKey& key, void* value) {
+    auto* page = static_cast<CachedPage*>(value);
+    StoragePageCache* cache = page->cache;
+    if (cache->_demote_enabled.load(std::memory_order_relaxed)) {
+        // the disk cache takes the ownership of the page
+        cache->_disk_cache->insert(key.to_string(), page->data.data, page->data.size);
+    } else {
+        delete[] page->data.data;
+    }
+    delete page;
 }
 
 } // namespace starrocks
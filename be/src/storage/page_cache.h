@@ -21,10 +21,12 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <utility>
 
+#include "common/status.h"
 #include "gutil/macros.h" // for DISALLOW_COPY_AND_ASSIGN
 #include "runtime/current_thread.h"
 #include "storage/lru_cache.h"
@@ -33,11 +35,13 @@
 namespace starrocks {
 
 class PageCacheHandle;
+class PageDiskCache;
 class MemTracker;
 
 // Warpper around Cache, and used for cache page of column datas
 // in Segment.
-// TODO(zc): We should add some metric to see cache hit/miss rate.
+// If a disk cache is initialized, the pages evicted from memory are demoted to it, and the pages
+// found in it are promoted to memory again, see PageDiskCache.
 class StoragePageCache {
 public:
     virtual ~StoragePageCache();
@@ -71,6 +75,12 @@ public:
 
     StoragePageCache(MemTracker* mem_tracker, size_t capacity);
 
+    // Use |path| on a local disk as the second tier of this cache, which holds at most |capacity|
+    // bytes of pages. Should be called before the cache is used.
+    Status init_disk_cache(const std::string& path, size_t capacity);
+
+    PageDiskCache* disk_cache() const { return _disk_cache.get(); }
+
     // Lookup the given page in the cache.
     //
     // If the page is found, the cache entry will be written into handle.
@@ -80,6 +90,9 @@ public:
     // Return true if entry is found, otherwise return false.
     bool lookup(const CacheKey& key, PageCacheHandle* handle);
 
+    // Return true if the page is cached in memory.
+    bool contains(const CacheKey& key);
+
     // Insert a page with key into this cache.
     // Given hanlde will be set to valid reference.
     // This function is thread-safe, and when two clients insert two same key
@@ -89,11 +102,24 @@ public:
 
     size_t memory_usage() const { return _cache->get_memory_usage(); }
 
+    // The value of an entry in |_cache|, which tells the deleter where to demote the page to.
+    struct CachedPage {
+        Slice data;
+        StoragePageCache* cache;
+    };
+
 private:
+    static void _delete_page(const starrocks::CacheKey& key, void* value);
+
+    Cache::Handle* _insert(const std::string& key, const Slice& data, bool in_memory);
+
     static StoragePageCache* _s_instance;
 
     MemTracker* _mem_tracker = nullptr;
     std::unique_ptr<Cache> _cache = nullptr;
+    std::unique_ptr<PageDiskCache> _disk_cache;
+    // whether to demote the evicted pages to |_disk_cache|, disabled before destruction
+    std::atomic<bool> _demote_enabled{false};
 };
 
 // A handle for StoragePageCache entry. This class make it easy to handle
@@ -127,7 +153,7 @@ public:
     }
 
     Cache* cache() const { return _cache; }
-    Slice data() const { return _cache->value_slice(_handle); }
+    Slice data() const { return static_cast<StoragePageCache::CachedPage*>(_cache->value(_handle))->data; }
 
 private:
     Cache* _cache = nullptr;
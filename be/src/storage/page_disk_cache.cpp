@@ -0,0 +1,398 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "storage/page_disk_cache.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include "common/config.h"
+#include "env/env.h"
+#include "gutil/strings/substitute.h"
+#include "runtime/current_thread.h"
+#include "util/coding.h"
+#include "util/crc32c.h"
+#include "util/starrocks_metrics.h"
+#include "util/thread.h"
+
+namespace starrocks {
+
+// key size, page size and checksum
+static constexpr size_t kRecordHeaderSize = 12;
+static constexpr size_t kMaxDataFileSize = 64 * 1024 * 1024;
+static constexpr size_t kMinDataFileSize = 1024 * 1024;
+static constexpr size_t kMaxKeySize = 4096;
+static const char* const kDataFileSuffix = ".dat";
+static const char* const kIndexFileSuffix = ".idx";
+
+PageDiskCache::PageDiskCache(std::string dir, size_t capacity, MemTracker* mem_tracker)
+        : _dir(std::move(dir)),
+          _capacity(capacity),
+          _file_size(std::clamp(capacity / 4, kMinDataFileSize, kMaxDataFileSize)),
+          _mem_tracker(mem_tracker) {}
+
+PageDiskCache::~PageDiskCache() {
+    {
+        std::lock_guard l(_queue_lock);
+        _stopped = true;
+    }
+    _queue_cv.notify_all();
+    if (_writer.joinable()) {
+        _writer.join();
+    }
+    // save the index of the active file, so it needn't be scanned on next open
+    auto st = _seal_active_file();
+    LOG_IF(WARNING, !st.ok()) << "failed to seal page disk cache file: " << st;
+    StarRocksMetrics::instance()->metrics()->deregister_hook("page_cache_disk_usage_bytes");
+}
+
+std::string PageDiskCache::_data_file_path(uint32_t id) const {
+    return strings::Substitute("$0/page_$1$2", _dir, id, kDataFileSuffix);
+}
+
+std::string PageDiskCache::_index_file_path(uint32_t id) const {
+    return strings::Substitute("$0/page_$1$2", _dir, id, kIndexFileSuffix);
+}
+
+Status PageDiskCache::open() {
+    RETURN_IF_ERROR(Env::Default()->create_dir_if_missing(_dir));
+    std::vector<std::string> children;
+    RETURN_IF_ERROR(Env::Default()->get_children(_dir, &children));
+    // file id => whether it has an index file
+    std::map<uint32_t, bool> data_files;
+    std::vector<uint32_t> index_files;
+    for (const auto& name : children) {
+        uint32_t id = 0;
+        char suffix[8] = {0};
+        if (sscanf(name.c_str(), "page_%u%7s", &id, suffix) != 2) {
+            continue;
+        }
+        if (strcmp(suffix, kDataFileSuffix) == 0) {
+            data_files.emplace(id, false);
+        } else if (strcmp(suffix, kIndexFileSuffix) == 0) {
+            index_files.push_back(id);
+        }
+    }
+    for (uint32_t id : index_files) {
+        auto iter = data_files.find(id);
+        if (iter != data_files.end()) {
+            iter->second = true;
+        } else {
+            (void)Env::Default()->delete_file(_index_file_path(id));
+        }
+    }
+    // load in the order of writing, so the newer records override the older ones
+    for (const auto& [id, has_index] : data_files) {
+        auto st = _load_data_file(id, has_index);
+        if (!st.ok()) {
+            LOG(WARNING) << "drop page disk cache file " << _data_file_path(id) << ": " << st;
+            (void)Env::Default()->delete_file(_data_file_path(id));
+            (void)Env::Default()->delete_file(_index_file_path(id));
+        }
+        _next_file_id = id + 1;
+    }
+    _evict(0);
+    LOG(INFO) << "open page disk cache " << _dir << " #file:" << _files.size() << " #page:" << _index.size()
+              << " usage:" << _usage << " capacity:" << _capacity;
+
+    REGISTER_GAUGE_STARROCKS_METRIC(page_cache_disk_usage_bytes, [this]() { return usage(); });
+    _writer = std::thread([this] { _write_loop(); });
+    Thread::set_thread_name(_writer, "page_disk_cache");
+    return Status::OK();
+}
+
+Status PageDiskCache::_load_data_file(uint32_t id, bool has_index) {
+    auto file = std::make_shared<DataFile>();
+    file->id = id;
+    ASSIGN_OR_RETURN(file->file, Env::Default()->new_random_access_file(_data_file_path(id)));
+    RETURN_IF_ERROR(file->file->size(&file->size));
+    std::vector<std::pair<std::string, PageLocation>> entries;
+    Status st = has_index ? _load_index_file(id, file->size, &entries) : Status::NotFound("no index file");
+    if (!st.ok()) {
+        entries.clear();
+        RETURN_IF_ERROR(_scan_data_file(*file, &entries));
+        // save the index for next open, it's fine to fail.
+        (void)_save_index_file(id, entries);
+    }
+    std::lock_guard l(_lock);
+    for (auto& [key, location] : entries) {
+        _index[std::move(key)] = location;
+    }
+    _usage += file->size;
+    _files.emplace(id, std::move(file));
+    return Status::OK();
+}
+
+// index file: |entry|entry|...|crc32c of entries(4)|, an entry is |key size(4)|key|offset(8)|page size(4)|
+Status PageDiskCache::_load_index_file(uint32_t id, uint64_t file_size,
+                                       std::vector<std::pair<std::string, PageLocation>>* entries) {
+    ASSIGN_OR_RETURN(auto rfile, Env::Default()->new_random_access_file(_index_file_path(id)));
+    uint64_t size = 0;
+    RETURN_IF_ERROR(rfile->size(&size));
+    if (size < 4) {
+        return Status::Corruption("bad page disk cache index file");
+    }
+    std::string buf(size, '\0');
+    RETURN_IF_ERROR(rfile->read_at_fully(0, buf.data(), buf.size()));
+    const auto* p = reinterpret_cast<const uint8_t*>(buf.data());
+    const auto* end = p + size - 4;
+    if (crc32c::Value(buf.data(), size - 4) != decode_fixed32_le(end)) {
+        return Status::Corruption("page disk cache index file checksum mismatch");
+    }
+    while (p < end) {
+        if (end - p < 4) {
+            return Status::Corruption("bad page disk cache index file");
+        }
+        uint32_t key_size = decode_fixed32_le(p);
+        p += 4;
+        if (static_cast<size_t>(end - p) < key_size + 12) {
+            return Status::Corruption("bad page disk cache index file");
+        }
+        std::string key(reinterpret_cast<const char*>(p), key_size);
+        p += key_size;
+        PageLocation location{id, 0, decode_fixed64_le(p)};
+        location.size = decode_fixed32_le(p + 8);
+        p += 12;
+        if (location.offset + kRecordHeaderSize + key.size() + location.size > file_size) {
+            return Status::Corruption("page disk cache index file out of range");
+        }
+        entries->emplace_back(std::move(key), location);
+    }
+    return Status::OK();
+}
+
+Status PageDiskCache::_scan_data_file(const DataFile& file,
+                                      std::vector<std::pair<std::string, PageLocation>>* entries) {
+    uint8_t header[kRecordHeaderSize];
+    uint64_t offset = 0;
+    while (offset + kRecordHeaderSize <= file.size) {
+        RETURN_IF_ERROR(file.file->read_at_fully(offset, header, kRecordHeaderSize));
+        uint32_t key_size = decode_fixed32_le(header);
+        uint32_t page_size = decode_fixed32_le(header + 4);
+        uint64_t record_size = kRecordHeaderSize + key_size + page_size;
+        if (key_size == 0 || key_size > kMaxKeySize || offset + record_size > file.size) {
+            // a torn write at the end of the file, the checksum of the pages is verified on read
+            break;
+        }
+        std::string key(key_size, '\0');
+        RETURN_IF_ERROR(file.file->read_at_fully(offset + kRecordHeaderSize, key.data(), key_size));
+        entries->emplace_back(std::move(key), PageLocation{file.id, page_size, offset});
+        offset += record_size;
+    }
+    return Status::OK();
+}
+
+Status PageDiskCache::_save_index_file(uint32_t id,
+                                       const std::vector<std::pair<std::string, PageLocation>>& entries) {
+    std::string buf;
+    for (const auto& [key, location] : entries) {
+        put_fixed32_le(&buf, key.size());
+        buf.append(key);
+        put_fixed64_le(&buf, location.offset);
+        put_fixed32_le(&buf, location.size);
+    }
+    put_fixed32_le(&buf, crc32c::Value(buf.data(), buf.size()));
+    ASSIGN_OR_RETURN(auto wfile, Env::Default()->new_writable_file(_index_file_path(id)));
+    RETURN_IF_ERROR(wfile->append(buf));
+    return wfile->close();
+}
+
+bool PageDiskCache::lookup(const std::string& key, size_t padding, std::unique_ptr<char[]>* page, size_t* size) {
+    DataFilePtr file;
+    PageLocation location;
+    {
+        std::lock_guard l(_lock);
+        auto iter = _index.find(key);
+        if (iter == _index.end()) {
+            return false;
+        }
+        location = iter->second;
+        auto file_iter = _files.find(location.file_id);
+        if (file_iter == _files.end()) {
+            return false;
+        }
+        file = file_iter->second;
+    }
+    // the file is kept open by |file| even if it's evicted during the read
+    std::string header(kRecordHeaderSize + key.size(), '\0');
+    std::unique_ptr<char[]> buf(new char[location.size + padding]);
+    Slice slices[2] = {Slice(header), Slice(buf.get(), location.size)};
+    auto st = file->file->readv_at(location.offset, slices, 2);
+    if (!st.ok()) {
+        LOG(WARNING) << "failed to read page disk cache file " << _data_file_path(location.file_id) << ": " << st;
+        return false;
+    }
+    const auto* h = reinterpret_cast<const uint8_t*>(header.data());
+    uint32_t crc = crc32c::Extend(0, header.data() + kRecordHeaderSize, key.size());
+    crc = crc32c::Extend(crc, buf.get(), location.size);
+    if (decode_fixed32_le(h) != key.size() || decode_fixed32_le(h + 4) != location.size ||
+        decode_fixed32_le(h + 8) != crc || memcmp(header.data() + kRecordHeaderSize, key.data(), key.size()) != 0) {
+        LOG(WARNING) << "bad page in page disk cache file " << _data_file_path(location.file_id)
+                     << " offset:" << location.offset;
+        std::lock_guard l(_lock);
+        auto iter = _index.find(key);
+        if (iter != _index.end() && iter->second.file_id == location.file_id &&
+            iter->second.offset == location.offset) {
+            _index.erase(iter);
+        }
+        return false;
+    }
+    *page = std::move(buf);
+    *size = location.size;
+    return true;
+}
+
+void PageDiskCache::insert(std::string key, char* page, size_t size) {
+    std::unique_ptr<char[]> page_ptr(page);
+    if (key.size() > kMaxKeySize || kRecordHeaderSize + key.size() + size > _file_size) {
+        return;
+    }
+    {
+        std::lock_guard l(_queue_lock);
+        if (_stopped || _queue_bytes + size > config::storage_page_disk_cache_write_buffer_bytes) {
+            return;
+        }
+        _queue_bytes += size;
+        _queue.push_back({std::move(key), std::move(page_ptr), size});
+    }
+    _queue_cv.notify_one();
+}
+
+void PageDiskCache::flush() {
+    std::unique_lock l(_queue_lock);
+    _flushed_cv.wait(l, [this] { return _stopped || (_queue.empty() && !_writing); });
+}
+
+size_t PageDiskCache::usage() const {
+    std::lock_guard l(_lock);
+    return _usage;
+}
+
+size_t PageDiskCache::num_pages() const {
+    std::lock_guard l(_lock);
+    return _index.size();
+}
+
+void PageDiskCache::_write_loop() {
+    // the pages are freed in this thread
+    if (_mem_tracker != nullptr) {
+        tls_thread_status.set_mem_tracker(_mem_tracker);
+    }
+    while (true) {
+        std::deque<PendingPage> pages;
+        {
+            std::unique_lock l(_queue_lock);
+            _queue_cv.wait(l, [this] { return _stopped || !_queue.empty(); });
+            if (_stopped) {
+                _queue.clear();
+                _queue_bytes = 0;
+                _flushed_cv.notify_all();
+                break;
+            }
+            pages.swap(_queue);
+            _queue_bytes = 0;
+            _writing = true;
+        }
+        for (const auto& page : pages) {
+            auto st = _write_page(page);
+            if (!st.ok()) {
+                LOG(WARNING) << "failed to write page disk cache: " << st;
+                // start a new file on next write
+                _active_writer.reset();
+                _active_file.reset();
+                _active_entries.clear();
+            }
+        }
+        pages.clear();
+        {
+            std::lock_guard l(_queue_lock);
+            _writing = false;
+        }
+        _flushed_cv.notify_all();
+    }
+}
+
+Status PageDiskCache::_write_page(const PendingPage& page) {
+    {
+        std::lock_guard l(_lock);
+        if (_index.count(page.key) > 0) {
+            return Status::OK();
+        }
+    }
+    const size_t record_size = kRecordHeaderSize + page.key.size() + page.size;
+    if (_active_file == nullptr || _active_file->size + record_size > _file_size) {
+        RETURN_IF_ERROR(_roll_active_file());
+    }
+    _evict(record_size);
+
+    uint8_t header[kRecordHeaderSize];
+    encode_fixed32_le(header, page.key.size());
+    encode_fixed32_le(header + 4, page.size);
+    uint32_t crc = crc32c::Extend(0, page.key.data(), page.key.size());
+    encode_fixed32_le(header + 8, crc32c::Extend(crc, page.page.get(), page.size));
+    Slice slices[3] = {Slice(header, kRecordHeaderSize), Slice(page.key), Slice(page.page.get(), page.size)};
+    RETURN_IF_ERROR(_active_writer->appendv(slices, 3));
+
+    PageLocation location{_active_file->id, static_cast<uint32_t>(page.size), _active_file->size};
+    _active_entries.emplace_back(page.key, location);
+    StarRocksMetrics::instance()->page_cache_disk_demote_total.increment(1);
+    std::lock_guard l(_lock);
+    _active_file->size += record_size;
+    _usage += record_size;
+    _index[page.key] = location;
+    return Status::OK();
+}
+
+Status PageDiskCache::_roll_active_file() {
+    RETURN_IF_ERROR(_seal_active_file());
+    uint32_t id = _next_file_id++;
+    ASSIGN_OR_RETURN(_active_writer, Env::Default()->new_writable_file(_data_file_path(id)));
+    auto file = std::make_shared<DataFile>();
+    file->id = id;
+    ASSIGN_OR_RETURN(file->file, Env::Default()->new_random_access_file(_data_file_path(id)));
+    _active_file = file;
+    std::lock_guard l(_lock);
+    _files.emplace(id, std::move(file));
+    return Status::OK();
+}
+
+Status PageDiskCache::_seal_active_file() {
+    if (_active_writer == nullptr) {
+        return Status::OK();
+    }
+    auto writer = std::move(_active_writer);
+    auto entries = std::move(_active_entries);
+    _active_entries.clear();
+    RETURN_IF_ERROR(writer->close());
+    return _save_index_file(_active_file->id, entries);
+}
+
+void PageDiskCache::_evict(size_t bytes) {
+    std::vector<uint32_t> evicted;
+    {
+        std::lock_guard l(_lock);
+        while (_usage + bytes > _capacity && !_files.empty()) {
+            auto file = _files.begin()->second;
+            if (file == _active_file) {
+                break;
+            }
+            for (auto iter = _index.begin(); iter != _index.end();) {
+                if (iter->second.file_id == file->id) {
+                    iter = _index.erase(iter);
+                } else {
+                    ++iter;
+                }
+            }
+            _usage -= file->size;
+            _files.erase(_files.begin());
+            evicted.push_back(file->id);
+        }
+    }
+    // the readers holding the files can still read them after they are deleted
+    for (uint32_t id : evicted) {
+        (void)Env::Default()->delete_file(_data_file_path(id));
+        (void)Env::Default()->delete_file(_index_file_path(id));
+    }
+}
+
+} // namespace starrocks
@@ -0,0 +1,126 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "common/status.h"
+
+namespace starrocks {
+
+class MemTracker;
+class RandomAccessFile;
+class WritableFile;
+
+// The second tier of StoragePageCache on a local disk, usually a NVMe SSD. Pages evicted from the
+// memory tier are demoted to it, and are promoted to the memory tier again on hit.
+//
+// Pages are appended to data files of at most |_file_size| bytes, and the space is reclaimed by
+// removing the oldest data file, so that all writes to the disk are sequential.
+// A record in a data file is:
+//   |key size(4)|page size(4)|crc32c of key and page(4)|key|page|
+// When a data file is full, the positions of its records are saved to an index file beside it.
+// On open, the index files are loaded and the data files without an index file are scanned, so the
+// cached pages survive restarts.
+class PageDiskCache {
+public:
+    // At most |capacity| bytes of pages are kept in |dir|. The pages waiting to be written are
+    // accounted to |mem_tracker|.
+    PageDiskCache(std::string dir, size_t capacity, MemTracker* mem_tracker);
+    ~PageDiskCache();
+
+    // Load the pages persisted in the directory and start the writer thread.
+    Status open();
+
+    // Read the page of |key| into |page|, which is allocated with |padding| bytes more than |size|.
+    // Return false if the page is not cached or fails to be read.
+    bool lookup(const std::string& key, size_t padding, std::unique_ptr<char[]>* page, size_t* size);
+
+    // Write the page of |key| asynchronously and take the ownership of |page|, which is allocated
+    // by new char[]. The page is dropped if it's cached already or too many pages are waiting.
+    void insert(std::string key, char* page, size_t size);
+
+    // Wait for the pages inserted to be written.
+    void flush();
+
+    size_t usage() const;
+
+    size_t num_pages() const;
+
+private:
+    struct DataFile {
+        uint32_t id = 0;
+        uint64_t size = 0;
+        std::unique_ptr<RandomAccessFile> file;
+    };
+    using DataFilePtr = std::shared_ptr<DataFile>;
+
+    struct PageLocation {
+        uint32_t file_id;
+        uint32_t size;
+        // offset of the record in the data file
+        uint64_t offset;
+    };
+
+    struct PendingPage {
+        std::string key;
+        std::unique_ptr<char[]> page;
+        size_t size;
+    };
+
+    std::string _data_file_path(uint32_t id) const;
+    std::string _index_file_path(uint32_t id) const;
+
+    Status _load_data_file(uint32_t id, bool has_index);
+    Status _load_index_file(uint32_t id, uint64_t file_size, std::vector<std::pair<std::string, PageLocation>>* entries);
+    Status _scan_data_file(const DataFile& file, std::vector<std::pair<std::string, PageLocation>>* entries);
+    Status _save_index_file(uint32_t id, const std::vector<std::pair<std::string, PageLocation>>& entries);
+
+    void _write_loop();
+    Status _write_page(const PendingPage& page);
+    Status _roll_active_file();
+    Status _seal_active_file();
+    // remove the oldest data files until |bytes| more can be written
+    void _evict(size_t bytes);
+
+    const std::string _dir;
+    const size_t _capacity;
+    const size_t _file_size;
+    MemTracker* _mem_tracker;
+
+    // |_lock| protects |_files|, |_index| and |_usage|.
+    mutable std::mutex _lock;
+    std::map<uint32_t, DataFilePtr> _files;
+    std::unordered_map<std::string, PageLocation> _index;
+    size_t _usage = 0;
+
+    // only accessed by the writer thread after open
+    uint32_t _next_file_id = 0;
+    DataFilePtr _active_file;
+    std::unique_ptr<WritableFile> _active_writer;
+    std::vector<std::pair<std::string, PageLocation>> _active_entries;
+
+    // |_queue_lock| protects the pages waiting to be written
+    std::mutex _queue_lock;
+    std::condition_variable _queue_cv;
+    std::condition_variable _flushed_cv;
+    std::deque<PendingPage> _queue;
+    size_t _queue_bytes = 0;
+    bool _writing = false;
+    bool _stopped = false;
+    std::thread _writer;
+
+    PageDiskCache(const PageDiskCache&) = delete;
+    const PageDiskCache& operator=(const PageDiskCache&) = delete;
+};
+
+} // namespace starrocks
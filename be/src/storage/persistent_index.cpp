@@ -2,11 +2,16 @@
 
 #include "storage/persistent_index.h"
 
+#include <condition_variable>
 #include <cstring>
+#include <mutex>
 #include <numeric>
+#include <set>
 
+#include "common/config.h"
 #include "gutil/strings/substitute.h"
 #include "storage/fs/fs_util.h"
+#include "storage/rowset/bloom_filter.h"
 #include "util/coding.h"
 #include "util/crc32c.h"
 #include "util/debug_util.h"
@@ -15,6 +20,7 @@
 #include "util/filesystem_util.h"
 #include "util/murmur_hash3.h"
 #include "util/raw_container.h"
+#include "util/threadpool.h"
 
 namespace starrocks {
 
@@ -93,7 +99,7 @@ static std::tuple<size_t, size_t> estimate_nshard_and_npage(size_t kv_size, size
             break;
         }
     }
-    size_t npage = npad(cap / nshard, page_size);
+    size_t npage = std::max<size_t>(1, npad(cap / nshard, page_size));
     return {nshard, npage};
 }
 
@@ -416,51 +422,98 @@ StatusOr<std::unique_ptr<ImmutableIndexShard>> ImmutableIndexShard::create(size_
     return std::move(ret);
 }
 
-Status write_immutable_index(size_t key_size, size_t value_size,
-                             const std::vector<std::vector<IndexHash>>& hashes_by_shard,
-                             const std::vector<std::vector<KVPairPtr>>& kv_ptrs_by_shard, size_t npage_hint,
-                             const EditVersion& version, fs::WritableBlock& wb) {
-    size_t kv_size = key_size + value_size;
-    ImmutableIndexMetaPB meta;
-    size_t total = 0;
-    size_t total_moved = 0;
-    size_t total_bytes = 0;
-    for (size_t i = 0; i < hashes_by_shard.size(); i++) {
-        auto rs_create = ImmutableIndexShard::create(kv_size, hashes_by_shard[i], kv_ptrs_by_shard[i], npage_hint);
-        if (!rs_create.ok()) {
-            return std::move(rs_create).status();
+// Writes the shards of an immutable index one by one, in any order, followed by the footer.
+class ImmutableIndexWriter {
+public:
+    ImmutableIndexWriter(size_t key_size, size_t value_size, size_t nshard, size_t npage_hint, fs::WritableBlock* wb)
+            : _key_size(key_size), _value_size(value_size), _npage_hint(npage_hint), _wb(wb) {
+        for (size_t i = 0; i < nshard; i++) {
+            _meta.add_shards();
         }
-        auto& shard = rs_create.value();
-        size_t pos_before = wb.bytes_appended();
-        RETURN_IF_ERROR(shard->write(wb));
-        size_t pos_after = wb.bytes_appended();
-        auto shard_meta = meta.add_shards();
-        shard_meta->set_size(hashes_by_shard[i].size());
-        shard_meta->set_npage(shard->npage());
-        auto ptr_meta = shard_meta->mutable_data();
-        ptr_meta->set_offset(pos_before);
-        ptr_meta->set_size(pos_after - pos_before);
-        total += hashes_by_shard[i].size();
-        total_moved += shard->num_entry_moved;
-        total_bytes += pos_after - pos_before;
-    }
-    LOG(INFO) << strings::Substitute(
-            "write immutable index kv_size:$0 shard:$1 npage_hint:$2 #kv:$3 #moved:$4($5) bytes:$6 usage:$7", kv_size,
-            hashes_by_shard.size(), npage_hint, total, total_moved, total_moved * 1000 / total / 1000.0, total_bytes,
-            kv_size * total * 1000 / total_bytes / 1000.0);
-    version.to_pb(meta.mutable_version());
-    meta.set_size(total);
-    meta.set_fixed_key_size(key_size);
-    meta.set_fixed_value_size(value_size);
+    }
+
+    Status write_shard(size_t shard_idx, const std::vector<IndexHash>& hashes, const std::vector<KVPairPtr>& kv_ptrs);
+
+    Status finish(const EditVersion& version);
+
+private:
+    const size_t _key_size;
+    const size_t _value_size;
+    const size_t _npage_hint;
+    fs::WritableBlock* _wb;
+    ImmutableIndexMetaPB _meta;
+    size_t _total = 0;
+    size_t _total_moved = 0;
+    size_t _total_bytes = 0;
+};
+
+Status ImmutableIndexWriter::write_shard(size_t shard_idx, const std::vector<IndexHash>& hashes,
+                                         const std::vector<KVPairPtr>& kv_ptrs) {
+    size_t kv_size = _key_size + _value_size;
+    auto rs_create = ImmutableIndexShard::create(kv_size, hashes, kv_ptrs, _npage_hint);
+    if (!rs_create.ok()) {
+        return std::move(rs_create).status();
+    }
+    auto& shard = rs_create.value();
+    size_t pos_before = _wb->bytes_appended();
+    RETURN_IF_ERROR(shard->write(*_wb));
+    size_t pos_after = _wb->bytes_appended();
+    auto shard_meta = _meta.mutable_shards(shard_idx);
+    shard_meta->set_size(hashes.size());
+    shard_meta->set_npage(shard->npage());
+    auto ptr_meta = shard_meta->mutable_data();
+    ptr_meta->set_offset(pos_before);
+    ptr_meta->set_size(pos_after - pos_before);
+    if (!hashes.empty()) {
+        std::unique_ptr<BloomFilter> bf;
+        RETURN_IF_ERROR(BloomFilter::create(BLOCK_BLOOM_FILTER, &bf));
+        RETURN_IF_ERROR(bf->init(hashes.size(), config::persistent_index_bloom_filter_fpp, HASH_MURMUR3_X64_64));
+        for (const auto& h : hashes) {
+            bf->add_hash(h.hash);
+        }
+        auto bf_meta = shard_meta->mutable_bloom_filter();
+        bf_meta->set_offset(_wb->bytes_appended());
+        bf_meta->set_size(bf->size());
+        RETURN_IF_ERROR(_wb->append(Slice(bf->data(), bf->size())));
+    }
+    _total += hashes.size();
+    _total_moved += shard->num_entry_moved;
+    _total_bytes += pos_after - pos_before;
+    return Status::OK();
+}
+
+Status ImmutableIndexWriter::finish(const EditVersion& version) {
+    size_t kv_size = _key_size + _value_size;
+    if (_total > 0) {
+        LOG(INFO) << strings::Substitute(
+                "write immutable index kv_size:$0 shard:$1 npage_hint:$2 #kv:$3 #moved:$4($5) bytes:$6 usage:$7",
+                kv_size, _meta.shards_size(), _npage_hint, _total, _total_moved,
+                _total_moved * 1000 / _total / 1000.0, _total_bytes, kv_size * _total * 1000 / _total_bytes / 1000.0);
+    }
+    version.to_pb(_meta.mutable_version());
+    _meta.set_size(_total);
+    _meta.set_fixed_key_size(_key_size);
+    _meta.set_fixed_value_size(_value_size);
     std::string footer;
-    if (!meta.SerializeToString(&footer)) {
+    if (!_meta.SerializeToString(&footer)) {
         return Status::InternalError("ImmutableIndexMetaPB::SerializeToString failed");
     }
     put_fixed32_le(&footer, static_cast<uint32_t>(footer.size()));
     uint32_t checksum = crc32c::Value(footer.data(), footer.size());
     put_fixed32_le(&footer, checksum);
     footer.append(index_file_magic, 4);
-    return wb.append(Slice(footer));
+    return _wb->append(Slice(footer));
+}
+
+Status write_immutable_index(size_t key_size, size_t value_size,
+                             const std::vector<std::vector<IndexHash>>& hashes_by_shard,
+                             const std::vector<std::vector<KVPairPtr>>& kv_ptrs_by_shard, size_t npage_hint,
+                             const EditVersion& version, fs::WritableBlock& wb) {
+    ImmutableIndexWriter writer(key_size, value_size, hashes_by_shard.size(), npage_hint, &wb);
+    for (size_t i = 0; i < hashes_by_shard.size(); i++) {
+        RETURN_IF_ERROR(writer.write_shard(i, hashes_by_shard[i], kv_ptrs_by_shard[i]));
+    }
+    return writer.finish(version);
 }
 
 template <size_t KeySize>
@@ -474,8 +527,8 @@ public:
 
     size_t size() const override { return _map.size(); }
 
-    Status flush_to_immutable_index(size_t num_entry, const EditVersion& version,
-                                    fs::WritableBlock& wb) const override {
+    Status flush_to_immutable_index(size_t num_entry, const EditVersion& version, fs::WritableBlock& wb,
+                                    bool keep_tombstone) const override {
         size_t kv_size = KeySize + sizeof(IndexValue);
         auto [nshard, npage_hint] = estimate_nshard_and_npage(kv_size, num_entry, default_usage_percent);
         std::vector<std::vector<IndexHash>> hashes_by_shard(nshard);
@@ -488,7 +541,7 @@ public:
         auto hasher = FixedKeyHash<KeySize>();
         size_t shard_mask = nshard - 1;
         for (const auto& e : _map) {
-            if (e.second == NullIndexValue) {
+            if (e.second == NullIndexValue && !keep_tombstone) {
                 continue;
             }
             const auto& k = e.first;
@@ -531,6 +584,7 @@ public:
             uint64_t hash = FixedKeyHash<KeySize>()(key);
             auto p = _map.emplace_with_hash(hash, key, v);
             if (p.second) {
+                old_values[i] = NullIndexValue;
                 not_found->key_idxes.emplace_back((uint32_t)i);
                 not_found->hashes.emplace_back(hash);
             } else {
@@ -630,6 +684,7 @@ public:
 
     size_t size() { return _map.size(); }
     size_t capacity() { return _map.capacity(); }
+    size_t memory_usage() { return _map.capacity() * (1 + sizeof(typename decltype(_map)::value_type)); }
 };
 
 StatusOr<std::unique_ptr<MutableIndex>> MutableIndex::create(size_t key_size) {
@@ -704,72 +759,82 @@ size_t get_matched_tag_idxes(const uint8_t* tags, size_t ntag, uint8_t tag, uint
 
 #endif
 
+Status ImmutableIndex::_read_shard(size_t shard_idx, std::unique_ptr<ImmutableIndexShard>* shard) const {
+    const auto& shard_info = _shards[shard_idx];
+    if (shard_info.size == 0) {
+        shard->reset();
+        return Status::OK();
+    }
+    *shard = std::make_unique<ImmutableIndexShard>(shard_info.npage);
+    CHECK((*shard)->pages.size() * page_size == shard_info.bytes) << "illegal shard size";
+    return _rb->read(shard_info.offset, Slice((uint8_t*)(*shard)->pages.data(), shard_info.bytes));
+}
+
 Status ImmutableIndex::_get_in_shard(size_t shard_idx, size_t n, const void* keys, const KeysInfo& keys_info,
-                                     IndexValue* values, size_t* num_found) const {
+                                     IndexValue* values, KeysInfo* not_found, size_t* num_found) const {
+    auto add_not_found = [&](size_t i) {
+        values[keys_info.key_idxes[i]] = NullIndexValue;
+        if (not_found != nullptr) {
+            not_found->key_idxes.emplace_back(keys_info.key_idxes[i]);
+            not_found->hashes.emplace_back(keys_info.hashes[i]);
+        }
+    };
     const auto& shard_info = _shards[shard_idx];
-    if (shard_info.size == 0 || keys_info.size() == 0) {
+    if (keys_info.size() == 0) {
         return Status::OK();
     }
-    size_t found = 0;
-    std::unique_ptr<ImmutableIndexShard> shard = std::make_unique<ImmutableIndexShard>(shard_info.npage);
-    CHECK(shard->pages.size() * page_size == shard_info.bytes) << "illegal shard size";
-    RETURN_IF_ERROR(_rb->read(shard_info.offset, Slice((uint8_t*)shard->pages.data(), shard_info.bytes)));
-    uint8_t candidate_idxes[bucket_size_max];
+    if (shard_info.size == 0) {
+        for (size_t i = 0; i < keys_info.size(); i++) {
+            add_not_found(i);
+        }
+        return Status::OK();
+    }
+    // check the bloom filter first, to avoid reading the shard if none of the keys may exist
+    std::vector<uint32_t> candidates;
+    candidates.reserve(keys_info.size());
+    const BloomFilter* bf = _bloom_filters[shard_idx].get();
     for (size_t i = 0; i < keys_info.size(); i++) {
-        IndexHash h(keys_info.hashes[i]);
-        auto pageid = h.page() % shard_info.npage;
-        auto bucketid = h.bucket();
-        auto& bucket_info = shard->bucket(pageid, bucketid);
-        uint8_t* bucket_pos = shard->pages[bucket_info.pageid].pack(bucket_info.packid);
-        auto nele = bucket_info.size;
-        auto ncandidates = get_matched_tag_idxes(bucket_pos, nele, h.tag(), candidate_idxes);
-        auto key_idx = keys_info.key_idxes[i];
-        const uint8_t* fixed_key_probe = (const uint8_t*)keys + _fixed_key_size * key_idx;
-        auto kv_pos = bucket_pos + pad(nele, pack_size);
-        values[key_idx] = NullIndexValue;
-        for (size_t candidate_idx = 0; candidate_idx < ncandidates; candidate_idx++) {
-            auto idx = candidate_idxes[candidate_idx];
-            auto candidate_kv = kv_pos + (_fixed_key_size + _fixed_value_size) * idx;
-            if (strings::memeq(candidate_kv, fixed_key_probe, _fixed_key_size)) {
-                values[key_idx] = UNALIGNED_LOAD64(candidate_kv + _fixed_key_size);
-                found++;
-                break;
-            }
+        if (bf == nullptr || bf->test_hash(keys_info.hashes[i])) {
+            candidates.emplace_back(i);
+        } else {
+            add_not_found(i);
         }
     }
-    *num_found += found;
-    return Status::OK();
-}
-
-Status ImmutableIndex::_check_not_exist_in_shard(size_t shard_idx, size_t n, const void* keys,
-                                                 const KeysInfo& keys_info) const {
-    const auto& shard_info = _shards[shard_idx];
-    if (shard_info.size == 0 || keys_info.size() == 0) {
+    if (candidates.empty()) {
         return Status::OK();
     }
-    std::unique_ptr<ImmutableIndexShard> shard = std::make_unique<ImmutableIndexShard>(shard_info.npage);
-    CHECK(shard->pages.size() * page_size == shard_info.bytes) << "illegal shard size";
-    RETURN_IF_ERROR(_rb->read(shard_info.offset, Slice((uint8_t*)shard->pages.data(), shard_info.bytes)));
+    size_t found = 0;
+    std::unique_ptr<ImmutableIndexShard> shard;
+    RETURN_IF_ERROR(_read_shard(shard_idx, &shard));
     uint8_t candidate_idxes[bucket_size_max];
-    for (size_t i = 0; i < keys_info.size(); i++) {
+    for (uint32_t i : candidates) {
         IndexHash h(keys_info.hashes[i]);
         auto pageid = h.page() % shard_info.npage;
         auto bucketid = h.bucket();
         auto& bucket_info = shard->bucket(pageid, bucketid);
         uint8_t* bucket_pos = shard->pages[bucket_info.pageid].pack(bucket_info.packid);
         auto nele = bucket_info.size;
-        auto key_idx = keys_info.key_idxes[i];
         auto ncandidates = get_matched_tag_idxes(bucket_pos, nele, h.tag(), candidate_idxes);
+        auto key_idx = keys_info.key_idxes[i];
         const uint8_t* fixed_key_probe = (const uint8_t*)keys + _fixed_key_size * key_idx;
         auto kv_pos = bucket_pos + pad(nele, pack_size);
+        bool matched = false;
         for (size_t candidate_idx = 0; candidate_idx < ncandidates; candidate_idx++) {
             auto idx = candidate_idxes[candidate_idx];
             auto candidate_kv = kv_pos + (_fixed_key_size + _fixed_value_size) * idx;
             if (strings::memeq(candidate_kv, fixed_key_probe, _fixed_key_size)) {
-                return Status::AlreadyExist("key already exists in immutable index");
+                // the value of an erased key is NullIndexValue
+                values[key_idx] = UNALIGNED_LOAD64(candidate_kv + _fixed_key_size);
+                found += (values[key_idx] != NullIndexValue);
+                matched = true;
+                break;
             }
         }
+        if (!matched) {
+            add_not_found(i);
+        }
     }
+    *num_found += found;
     return Status::OK();
 }
 
@@ -786,37 +851,51 @@ static void split_keys_info_by_shard(const KeysInfo& keys_info, std::vector<Keys
 
 Status ImmutableIndex::get(size_t n, const void* keys, const KeysInfo& keys_info, IndexValue* values,
                            size_t* num_found) const {
+    return get(n, keys, keys_info, values, nullptr, num_found);
+}
+
+Status ImmutableIndex::get(size_t n, const void* keys, const KeysInfo& keys_info, IndexValue* values,
+                           KeysInfo* not_found, size_t* num_found) const {
     size_t found = 0;
     if (_shards.size() > 1) {
         std::vector<KeysInfo> keys_info_by_shard(_shards.size());
         split_keys_info_by_shard(keys_info, keys_info_by_shard);
         for (size_t i = 0; i < _shards.size(); i++) {
-            RETURN_IF_ERROR(_get_in_shard(i, n, keys, keys_info_by_shard[i], values, &found));
+            RETURN_IF_ERROR(_get_in_shard(i, n, keys, keys_info_by_shard[i], values, not_found, &found));
         }
     } else {
-        RETURN_IF_ERROR(_get_in_shard(0, n, keys, keys_info, values, &found));
+        RETURN_IF_ERROR(_get_in_shard(0, n, keys, keys_info, values, not_found, &found));
     }
     *num_found += found;
     return Status::OK();
 }
 
 Status ImmutableIndex::check_not_exist(size_t n, const void* keys) {
-    size_t nshard = _shards.size();
-    std::vector<KeysInfo> keys_info_by_shard(nshard);
-    uint64_t shard_mask = nshard - 1;
+    KeysInfo keys_info;
+    keys_info.key_idxes.reserve(n);
+    keys_info.hashes.reserve(n);
     for (size_t i = 0; i < n; i++) {
         const uint8_t* key = (const uint8_t*)keys + _fixed_key_size * i;
-        IndexHash h(key_index_hash(key, _fixed_key_size));
-        auto shard = h.shard() & shard_mask;
-        keys_info_by_shard[shard].key_idxes.emplace_back(i);
-        keys_info_by_shard[shard].hashes.emplace_back(h.hash);
+        keys_info.key_idxes.emplace_back(i);
+        keys_info.hashes.emplace_back(key_index_hash(key, _fixed_key_size));
     }
-    for (size_t i = 0; i < nshard; i++) {
-        RETURN_IF_ERROR(_check_not_exist_in_shard(i, n, keys, keys_info_by_shard[i]));
+    std::vector<IndexValue> values(n);
+    size_t num_found = 0;
+    RETURN_IF_ERROR(get(n, keys, keys_info, values.data(), &num_found));
+    if (num_found > 0) {
+        return Status::AlreadyExist("key already exists in immutable index");
     }
     return Status::OK();
 }
 
+size_t ImmutableIndex::memory_usage() const {
+    size_t ret = 0;
+    for (const auto& bf : _bloom_filters) {
+        ret += (bf == nullptr) ? 0 : bf->size();
+    }
+    return ret;
+}
+
 StatusOr<std::unique_ptr<ImmutableIndex>> ImmutableIndex::load(std::unique_ptr<fs::ReadableBlock>&& rb) {
     uint64_t file_size;
     RETURN_IF_ERROR(rb->size(&file_size));
@@ -855,8 +934,10 @@ StatusOr<std::unique_ptr<ImmutableIndex>> ImmutableIndex::load(std::unique_ptr<f
     idx->_size = meta.size();
     idx->_fixed_key_size = meta.fixed_key_size();
     idx->_fixed_value_size = meta.fixed_value_size();
+    idx->_file_size = file_size;
     size_t nshard = meta.shards_size();
     idx->_shards.resize(nshard);
+    idx->_bloom_filters.resize(nshard);
     for (size_t i = 0; i < nshard; i++) {
         const auto& src = meta.shards(i);
         auto& dest = idx->_shards[i];
@@ -864,14 +945,157 @@ StatusOr<std::unique_ptr<ImmutableIndex>> ImmutableIndex::load(std::unique_ptr<f
         dest.npage = src.npage();
         dest.offset = src.data().offset();
         dest.bytes = src.data().size();
+        if (src.has_bloom_filter() && src.bloom_filter().size() > 0) {
+            std::string bf_buff;
+            raw::stl_string_resize_uninitialized(&bf_buff, src.bloom_filter().size());
+            RETURN_IF_ERROR(rb->read(src.bloom_filter().offset(), bf_buff));
+            RETURN_IF_ERROR(BloomFilter::create(BLOCK_BLOOM_FILTER, &idx->_bloom_filters[i]));
+            RETURN_IF_ERROR(idx->_bloom_filters[i]->init(bf_buff.data(), bf_buff.size(), HASH_MURMUR3_X64_64));
+        }
     }
     idx->_rb.swap(rb);
     return std::move(idx);
 }
 
+Status ImmutableIndex::merge(const std::vector<const ImmutableIndex*>& inputs, bool drop_tombstone,
+                             const EditVersion& version, fs::WritableBlock& wb) {
+    DCHECK(!inputs.empty());
+    const size_t key_size = inputs[0]->_fixed_key_size;
+    const size_t value_size = inputs[0]->_fixed_value_size;
+    const size_t kv_size = key_size + value_size;
+    size_t total = 0;
+    // the shards of the output whose ids are congruent modulo |ngroup| are merged together as a group, which
+    // only reads one shard of each input, given the number of shards of each input is a power of 2 not
+    // larger than |ngroup|.
+    size_t ngroup = 1;
+    for (const auto* input : inputs) {
+        DCHECK_EQ(key_size, input->_fixed_key_size);
+        DCHECK_EQ(value_size, input->_fixed_value_size);
+        total += input->_size;
+        ngroup = std::max(ngroup, input->_shards.size());
+    }
+    auto [nshard, npage_hint] = estimate_nshard_and_npage(kv_size, total, default_usage_percent);
+    if (nshard < ngroup) {
+        npage_hint = std::max<size_t>(1, npage_hint * nshard / ngroup);
+        nshard = ngroup;
+    }
+    const size_t nshard_per_group = nshard / ngroup;
+    ImmutableIndexWriter writer(key_size, value_size, nshard, npage_hint, &wb);
+    std::vector<std::unique_ptr<ImmutableIndexShard>> input_shards(inputs.size());
+    for (size_t group = 0; group < ngroup; group++) {
+        // key => (kv, hash), the newer inputs override the older ones
+        phmap::flat_hash_map<std::string_view, std::pair<KVPairPtr, uint64_t>> kvs;
+        for (size_t i = 0; i < inputs.size(); i++) {
+            const ImmutableIndex* input = inputs[i];
+            RETURN_IF_ERROR(input->_read_shard(group & (input->_shards.size() - 1), &input_shards[i]));
+            const auto& shard = input_shards[i];
+            if (shard == nullptr) {
+                continue;
+            }
+            for (uint32_t pageid = 0; pageid < shard->npage(); pageid++) {
+                for (uint32_t bucketid = 0; bucketid < bucket_per_page; bucketid++) {
+                    const auto& bucket_info = shard->bucket(pageid, bucketid);
+                    const uint8_t* kv_pos = shard->pages[bucket_info.pageid].pack(bucket_info.packid) +
+                                            pad((size_t)bucket_info.size, pack_size);
+                    for (size_t j = 0; j < bucket_info.size; j++, kv_pos += kv_size) {
+                        uint64_t hash = key_index_hash(kv_pos, key_size);
+                        if ((IndexHash(hash).shard() & (ngroup - 1)) != group) {
+                            continue;
+                        }
+                        kvs[std::string_view((const char*)kv_pos, key_size)] = {kv_pos, hash};
+                    }
+                }
+            }
+        }
+        std::vector<std::vector<IndexHash>> hashes_by_shard(nshard_per_group);
+        std::vector<std::vector<KVPairPtr>> kv_ptrs_by_shard(nshard_per_group);
+        for (const auto& [key, kv] : kvs) {
+            if (drop_tombstone && UNALIGNED_LOAD64(kv.first + key_size) == NullIndexValue) {
+                continue;
+            }
+            IndexHash h(kv.second);
+            size_t idx = (h.shard() & (nshard - 1)) / ngroup;
+            hashes_by_shard[idx].emplace_back(h);
+            kv_ptrs_by_shard[idx].emplace_back(kv.first);
+        }
+        for (size_t i = 0; i < nshard_per_group; i++) {
+            RETURN_IF_ERROR(writer.write_shard(group + i * ngroup, hashes_by_shard[i], kv_ptrs_by_shard[i]));
+        }
+    }
+    return writer.finish(version);
+}
+
+// A merge of immutable indexes of a persistent index, which runs out of the apply process.
+class ImmutableIndexMergeTask {
+public:
+    ImmutableIndexMergeTask(int input_level, std::vector<std::shared_ptr<ImmutableIndex>> inputs, bool drop_tombstone,
+                            std::string path, const EditVersion& version)
+            : input_level(input_level),
+              inputs(std::move(inputs)),
+              drop_tombstone(drop_tombstone),
+              path(std::move(path)),
+              version(version) {}
+
+    void run() {
+        Status st = _merge();
+        std::lock_guard<std::mutex> l(_mutex);
+        status = st;
+        _finished = true;
+        _cv.notify_all();
+    }
+
+    bool is_finished() {
+        std::lock_guard<std::mutex> l(_mutex);
+        return _finished;
+    }
+
+    void wait() {
+        std::unique_lock<std::mutex> l(_mutex);
+        _cv.wait(l, [this] { return _finished; });
+    }
+
+    // 1 if the inputs are the oldest indexes in l1, or 2 if they are the newest indexes in l2
+    const int input_level;
+    const std::vector<std::shared_ptr<ImmutableIndex>> inputs;
+    const bool drop_tombstone;
+    const std::string path;
+    const EditVersion version;
+
+    // result, valid after finished
+    Status status;
+    std::shared_ptr<ImmutableIndex> output;
+
+private:
+    Status _merge() {
+        std::vector<const ImmutableIndex*> input_ptrs;
+        for (const auto& input : inputs) {
+            input_ptrs.emplace_back(input.get());
+        }
+        auto path_tmp = path + ".tmp";
+        fs::BlockManager* block_mgr = fs::fs_util::block_manager();
+        std::unique_ptr<fs::WritableBlock> wblock;
+        fs::CreateBlockOptions wblock_opts({path_tmp});
+        RETURN_IF_ERROR(block_mgr->create_block(wblock_opts, &wblock));
+        DeferOp remove_tmp_file([&] { Env::Default()->delete_file(path_tmp); });
+        RETURN_IF_ERROR(ImmutableIndex::merge(input_ptrs, drop_tombstone, version, *wblock));
+        RETURN_IF_ERROR(wblock->finalize());
+        RETURN_IF_ERROR(wblock->close());
+        RETURN_IF_ERROR(Env::Default()->rename_file(path_tmp, path));
+        std::unique_ptr<fs::ReadableBlock> rblock;
+        RETURN_IF_ERROR(block_mgr->open_block(path, &rblock));
+        ASSIGN_OR_RETURN(output, ImmutableIndex::load(std::move(rblock)));
+        return Status::OK();
+    }
+
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    bool _finished = false;
+};
+
 PersistentIndex::PersistentIndex(const std::string& path) : _path(path) {}
 
 PersistentIndex::~PersistentIndex() {
+    wait_for_merge();
     if (_index_block) {
         _index_block->close();
     }
@@ -881,6 +1105,19 @@ std::string PersistentIndex::_get_l0_index_file_name(std::string& dir, const Edi
     return strings::Substitute("$0/index.l0.$1.$2", dir, version.major(), version.minor());
 }
 
+std::string PersistentIndex::_get_immutable_index_file_name(int level, const EditVersion& version) const {
+    return strings::Substitute("$0/index.l$1.$2.$3", _path, level, version.major(), version.minor());
+}
+
+Status PersistentIndex::_load_immutable_index(int level, const EditVersion& version) {
+    fs::BlockManager* block_mgr = fs::fs_util::block_manager();
+    std::unique_ptr<fs::ReadableBlock> rblock;
+    RETURN_IF_ERROR(block_mgr->open_block(_get_immutable_index_file_name(level, version), &rblock));
+    ASSIGN_OR_RETURN(auto idx, ImmutableIndex::load(std::move(rblock)));
+    (level == 1 ? _l1_vec : _l2_vec).emplace_back(std::move(idx));
+    return Status::OK();
+}
+
 Status PersistentIndex::create(size_t key_size, const EditVersion& version) {
     if (loaded()) {
         return Status::InternalError("PersistentIndex already loaded");
@@ -972,6 +1209,14 @@ Status PersistentIndex::load(const PersistentIndexMetaPB& index_meta) {
     fs::CreateBlockOptions wblock_opts({l0_index_file_name});
     wblock_opts.mode = Env::MUST_EXIST;
     RETURN_IF_ERROR(block_mgr->create_block(wblock_opts, &_index_block));
+    _l1_vec.clear();
+    _l2_vec.clear();
+    for (const auto& version_pb : index_meta.l1_versions()) {
+        RETURN_IF_ERROR(_load_immutable_index(1, EditVersion(version_pb)));
+    }
+    for (const auto& version_pb : index_meta.l2_versions()) {
+        RETURN_IF_ERROR(_load_immutable_index(2, EditVersion(version_pb)));
+    }
     RETURN_IF_ERROR(_delete_expired_index_file(start_version));
     return Status::OK();
 }
@@ -988,7 +1233,12 @@ Status PersistentIndex::abort() {
 }
 
 Status PersistentIndex::commit(PersistentIndexMetaPB* index_meta) {
-    // TODO: l0 may be need to flush
+    _apply_merge();
+    if (_need_flush_l0()) {
+        RETURN_IF_ERROR(_flush_l0());
+        // the wals of l0 are flushed, start a new l0 file with an empty snapshot
+        _dump_snapshot = true;
+    }
     if (_dump_snapshot) {
         // if _map size is small enough to dump directly, rewrite snapshot
         std::string file_name = _get_l0_index_file_name(_path, _version);
@@ -1010,7 +1260,7 @@ Status PersistentIndex::commit(PersistentIndexMetaPB* index_meta) {
         PagePointerPB* data = snapshot->mutable_data();
         data->set_offset(0);
         data->set_size(snapshot_size);
-        _offset += snapshot_size;
+        _offset = snapshot_size;
         _page_size = 0;
     } else {
         MutableIndexMetaPB* l0_meta = index_meta->mutable_l0_meta();
@@ -1021,12 +1271,19 @@ Status PersistentIndex::commit(PersistentIndexMetaPB* index_meta) {
         data->set_offset(_offset);
         data->set_size(_page_size);
 
-        _version.to_pb(index_meta->mutable_version());
-        index_meta->set_size(_size);
-
         _offset += _page_size;
         _page_size = 0;
     }
+    _version.to_pb(index_meta->mutable_version());
+    index_meta->set_size(_size);
+    index_meta->clear_l1_versions();
+    for (const auto& l1 : _l1_vec) {
+        l1->version().to_pb(index_meta->add_l1_versions());
+    }
+    index_meta->clear_l2_versions();
+    for (const auto& l2 : _l2_vec) {
+        l2->version().to_pb(index_meta->add_l2_versions());
+    }
     return Status::OK();
 }
 
@@ -1045,6 +1302,12 @@ Status PersistentIndex::on_commited() {
         Env::Default()->delete_file(expired_file_path);
     }
     _dump_snapshot = false;
+    for (const auto& path : _files_to_delete) {
+        VLOG(1) << "delete merged immutable index file: " << path;
+        Env::Default()->delete_file(path);
+    }
+    _files_to_delete.clear();
+    _schedule_merge();
 
     return Status::OK();
 }
@@ -1053,10 +1316,7 @@ Status PersistentIndex::get(size_t n, const void* keys, IndexValue* values) {
     KeysInfo l1_checks;
     size_t num_found = 0;
     RETURN_IF_ERROR(_l0->get(n, keys, values, &l1_checks, &num_found));
-    if (_l1) {
-        RETURN_IF_ERROR(_l1->get(n, keys, l1_checks, values, &num_found));
-    }
-    return Status::OK();
+    return _get_from_immutable_index(n, keys, l1_checks, values, &num_found);
 }
 
 Status PersistentIndex::upsert(size_t n, const void* keys, const IndexValue* values, IndexValue* old_values) {
@@ -1064,9 +1324,7 @@ Status PersistentIndex::upsert(size_t n, const void* keys, const IndexValue* val
     size_t num_found = 0;
     RETURN_IF_ERROR(_l0->upsert(n, keys, values, old_values, &l1_checks, &num_found));
     _dump_snapshot |= _can_dump_directly();
-    if (_l1) {
-        RETURN_IF_ERROR(_l1->get(n, keys, l1_checks, old_values, &num_found));
-    }
+    RETURN_IF_ERROR(_get_from_immutable_index(n, keys, l1_checks, old_values, &num_found));
     _size += (n - num_found);
     if (!_dump_snapshot) {
         RETURN_IF_ERROR(_append_wal(n, keys, values));
@@ -1076,8 +1334,20 @@ Status PersistentIndex::upsert(size_t n, const void* keys, const IndexValue* val
 
 Status PersistentIndex::insert(size_t n, const void* keys, const IndexValue* values, bool check_l1) {
     RETURN_IF_ERROR(_l0->insert(n, keys, values));
-    if (_l1 && check_l1) {
-        RETURN_IF_ERROR(_l1->check_not_exist(n, keys));
+    if (check_l1 && (!_l1_vec.empty() || !_l2_vec.empty())) {
+        KeysInfo keys_info;
+        keys_info.key_idxes.reserve(n);
+        keys_info.hashes.reserve(n);
+        for (size_t i = 0; i < n; i++) {
+            keys_info.key_idxes.emplace_back(i);
+            keys_info.hashes.emplace_back(key_index_hash((const uint8_t*)keys + _key_size * i, _key_size));
+        }
+        std::vector<IndexValue> found_values(n);
+        size_t num_found = 0;
+        RETURN_IF_ERROR(_get_from_immutable_index(n, keys, keys_info, found_values.data(), &num_found));
+        if (num_found > 0) {
+            return Status::AlreadyExist("key already exists in immutable index");
+        }
     }
     _dump_snapshot |= _can_dump_directly();
     _size += n;
@@ -1092,9 +1362,7 @@ Status PersistentIndex::erase(size_t n, const void* keys, IndexValue* old_values
     size_t num_erased = 0;
     RETURN_IF_ERROR(_l0->erase(n, keys, old_values, &l1_checks, &num_erased));
     _dump_snapshot |= _can_dump_directly();
-    if (_l1) {
-        RETURN_IF_ERROR(_l1->get(n, keys, l1_checks, old_values, &num_erased));
-    }
+    RETURN_IF_ERROR(_get_from_immutable_index(n, keys, l1_checks, old_values, &num_erased));
     CHECK(_size >= num_erased) << strings::Substitute("_size($0) < num_erased($1)", _size, num_erased);
     _size -= num_erased;
     if (!_dump_snapshot) {
@@ -1117,19 +1385,123 @@ Status PersistentIndex::_append_wal(size_t n, const void* keys, const IndexValue
     return Status::OK();
 }
 
+Status PersistentIndex::_get_from_immutable_index(size_t n, const void* keys, const KeysInfo& keys_info,
+                                                  IndexValue* values, size_t* num_found) const {
+    const KeysInfo* checks = &keys_info;
+    KeysInfo not_found[2];
+    int cur = 0;
+    auto get_from = [&](const ImmutableIndex& idx) -> Status {
+        KeysInfo& next = not_found[cur];
+        cur ^= 1;
+        next.key_idxes.clear();
+        next.hashes.clear();
+        RETURN_IF_ERROR(idx.get(n, keys, *checks, values, &next, num_found));
+        checks = &next;
+        return Status::OK();
+    };
+    for (auto iter = _l1_vec.rbegin(); iter != _l1_vec.rend() && checks->size() > 0; ++iter) {
+        RETURN_IF_ERROR(get_from(**iter));
+    }
+    for (auto iter = _l2_vec.rbegin(); iter != _l2_vec.rend() && checks->size() > 0; ++iter) {
+        RETURN_IF_ERROR(get_from(**iter));
+    }
+    return Status::OK();
+}
+
+bool PersistentIndex::_need_flush_l0() {
+    return _l0->size() > 0 && static_cast<int64_t>(_l0->memory_usage()) > config::l0_max_mem_usage;
+}
+
 Status PersistentIndex::_flush_l0() {
-    auto idx_file_path = strings::Substitute("$0/index.l1.$1.$2", _path, _version.major(), _version.minor());
+    auto idx_file_path = _get_immutable_index_file_name(1, _version);
     auto idx_file_path_tmp = idx_file_path + ".tmp";
     fs::BlockManager* block_mgr = fs::fs_util::block_manager();
     std::unique_ptr<fs::WritableBlock> wblock;
     fs::CreateBlockOptions wblock_opts({idx_file_path_tmp});
     RETURN_IF_ERROR(block_mgr->create_block(wblock_opts, &wblock));
     DeferOp remove_tmp_file([&] { Env::Default()->delete_file(idx_file_path_tmp); });
-    RETURN_IF_ERROR(_l0->flush_to_immutable_index(_size, _version, *wblock));
+    // the erased keys must be kept to hide the same keys in older immutable indexes
+    bool keep_tombstone = !_l1_vec.empty() || !_l2_vec.empty();
+    RETURN_IF_ERROR(_l0->flush_to_immutable_index(_l0->size(), _version, *wblock, keep_tombstone));
+    RETURN_IF_ERROR(wblock->finalize());
+    RETURN_IF_ERROR(wblock->close());
     RETURN_IF_ERROR(Env::Default()->rename_file(idx_file_path_tmp, idx_file_path));
+    RETURN_IF_ERROR(_load_immutable_index(1, _version));
+    ASSIGN_OR_RETURN(_l0, MutableIndex::create(_key_size));
     return Status::OK();
 }
 
+void PersistentIndex::_schedule_merge() {
+    if (_merge_task != nullptr) {
+        return;
+    }
+    const size_t threshold = std::max(2, config::persistent_index_merge_threshold);
+    std::shared_ptr<ImmutableIndexMergeTask> task;
+    if (_l1_vec.size() >= threshold) {
+        task = std::make_shared<ImmutableIndexMergeTask>(1, _l1_vec, _l2_vec.empty(),
+                                                         _get_immutable_index_file_name(2, _version), _version);
+    } else if (_l2_vec.size() >= threshold) {
+        // Merge the newest indexes until an older one larger than all the newer ones, so the large
+        // indexes at the bottom are not rewritten by each merge.
+        size_t start = _l2_vec.size() - 1;
+        size_t newer_bytes = _l2_vec[start]->file_size();
+        while (start > 0 && _l2_vec[start - 1]->file_size() <= newer_bytes) {
+            start--;
+            newer_bytes += _l2_vec[start]->file_size();
+        }
+        if (_l2_vec.size() - start < 2) {
+            return;
+        }
+        std::vector<std::shared_ptr<ImmutableIndex>> inputs(_l2_vec.begin() + start, _l2_vec.end());
+        task = std::make_shared<ImmutableIndexMergeTask>(2, std::move(inputs), start == 0,
+                                                         _get_immutable_index_file_name(2, _version), _version);
+    } else {
+        return;
+    }
+    _merge_task = task;
+    if (_merge_thread_pool != nullptr) {
+        Status st = _merge_thread_pool->submit_func([task]() { task->run(); });
+        if (st.ok()) {
+            return;
+        }
+        LOG(WARNING) << "submit persistent index merge failed, merge in place: " << st;
+    }
+    task->run();
+}
+
+void PersistentIndex::_apply_merge() {
+    if (_merge_task == nullptr || !_merge_task->is_finished()) {
+        return;
+    }
+    auto task = std::move(_merge_task);
+    if (!task->status.ok()) {
+        LOG(WARNING) << "merge immutable indexes of persistent index " << _path << " failed: " << task->status;
+        return;
+    }
+    auto& inputs_level = task->input_level == 1 ? _l1_vec : _l2_vec;
+    auto first = std::find(inputs_level.begin(), inputs_level.end(), task->inputs.front());
+    DCHECK(first != inputs_level.end());
+    DCHECK_GE(inputs_level.end() - first, static_cast<ssize_t>(task->inputs.size()));
+    auto pos = inputs_level.erase(first, first + task->inputs.size());
+    if (task->input_level == 1) {
+        // all l2 indexes are older than l1
+        _l2_vec.emplace_back(task->output);
+    } else {
+        _l2_vec.insert(pos, task->output);
+    }
+    for (const auto& input : task->inputs) {
+        _files_to_delete.emplace_back(input->path());
+    }
+    LOG(INFO) << strings::Substitute("persistent index $0 merged $1 l$2 indexes, l1:$3 l2:$4", _path,
+                                     task->inputs.size(), task->input_level, _l1_vec.size(), _l2_vec.size());
+}
+
+void PersistentIndex::wait_for_merge() {
+    if (_merge_task != nullptr) {
+        _merge_task->wait();
+    }
+}
+
 size_t PersistentIndex::mutable_index_size() {
     return (_l0 == nullptr) ? 0 : _l0->size();
 }
@@ -1158,11 +1530,19 @@ bool PersistentIndex::_load_snapshot(phmap::BinaryInputArchive& ar) {
 
 Status PersistentIndex::_delete_expired_index_file(const EditVersion& version) {
     std::string file_name = strings::Substitute("index.l0.$0.$1", version.major(), version.minor());
-    std::string prefix("index.l0");
+    std::string prefix("index.l");
     std::string dir = _path;
+    // the files of immutable indexes in use, the others are left by unfinished flushes or merges
+    std::set<std::string> immutable_index_files;
+    for (const auto* vec : {&_l1_vec, &_l2_vec}) {
+        for (const auto& idx : *vec) {
+            immutable_index_files.emplace(idx->path().substr(idx->path().rfind('/') + 1));
+        }
+    }
     auto cb = [&](const char* name) -> bool {
         std::string full(name);
-        if (full.compare(0, prefix.length(), prefix) == 0 && full.compare(file_name) != 0) {
+        if (full.compare(0, prefix.length(), prefix) == 0 && full.compare(file_name) != 0 &&
+            immutable_index_files.count(full) == 0) {
             std::string path = dir + "/" + name;
             VLOG(1) << "delete expired index file " << path;
             Status st = Env::Default()->delete_file(path);
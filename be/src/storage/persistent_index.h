@@ -4,6 +4,7 @@
 
 #include <memory>
 #include <tuple>
+#include <vector>
 
 #include "common/statusor.h"
 #include "gen_cpp/persistent_index.pb.h"
@@ -14,6 +15,11 @@
 
 namespace starrocks {
 
+class BloomFilter;
+class ImmutableIndexMergeTask;
+struct ImmutableIndexShard;
+class ThreadPool;
+
 using IndexValue = uint64_t;
 static constexpr IndexValue NullIndexValue = -1;
 
@@ -36,8 +42,10 @@ public:
     // flush mutable index into immutable index
     // |num_entry|: num of valid entries in this index(excluding NullIndexValue)
     // |wb|: file block written to
-    virtual Status flush_to_immutable_index(size_t num_entry, const EditVersion& version,
-                                            fs::WritableBlock& wb) const = 0;
+    // |keep_tombstone|: also flush the erased keys with NullIndexValue, which is required if there are
+    //                   older immutable indexes, so that the erased keys are not found in them
+    virtual Status flush_to_immutable_index(size_t num_entry, const EditVersion& version, fs::WritableBlock& wb,
+                                            bool keep_tombstone) const = 0;
 
     // batch get
     // |n|: size of key/value array
@@ -101,9 +109,16 @@ public:
     // [not thread-safe]
     virtual size_t capacity() = 0;
 
+    // [not thread-safe]
+    virtual size_t memory_usage() = 0;
+
     static StatusOr<std::unique_ptr<MutableIndex>> create(size_t key_size);
 };
 
+// An immutable index is a file of hash sharded pages, each shard has a bloom filter of its keys kept in
+// memory, which is checked before the pages of the shard are read.
+// The erased keys may be stored with NullIndexValue, to hide the same keys in older immutable indexes,
+// see PersistentIndex.
 class ImmutableIndex {
 public:
     // batch get
@@ -114,20 +129,47 @@ public:
     // |num_found|: add the number of keys found in L1 to this argument
     Status get(size_t n, const void* keys, const KeysInfo& keys_info, IndexValue* values, size_t* num_found) const;
 
+    // batch get, same as above, and also returns the keys not found in this index
+    // |not_found|: information of keys not found in this index, which need to be checked in older indexes
+    Status get(size_t n, const void* keys, const KeysInfo& keys_info, IndexValue* values, KeysInfo* not_found,
+               size_t* num_found) const;
+
     // batch check key existence
     Status check_not_exist(size_t n, const void* keys);
 
+    // number of entries, including the erased keys
+    size_t size() const { return _size; }
+
+    size_t file_size() const { return _file_size; }
+
+    const EditVersion& version() const { return _version; }
+
+    const std::string& path() const { return _rb->path(); }
+
+    // memory used by bloom filters
+    size_t memory_usage() const;
+
     static StatusOr<std::unique_ptr<ImmutableIndex>> load(std::unique_ptr<fs::ReadableBlock>&& rb);
 
+    // Merge |inputs|, ordered from the oldest to the newest, into one immutable index written to |wb|,
+    // the value of a key is taken from the newest input which contains it.
+    // The shards of the inputs are merged one group at a time, so the memory used is bounded
+    // by the size of a group instead of the whole inputs.
+    // |drop_tombstone|: drop the erased keys, only if there is no index older than |inputs|
+    static Status merge(const std::vector<const ImmutableIndex*>& inputs, bool drop_tombstone,
+                        const EditVersion& version, fs::WritableBlock& wb);
+
 private:
     Status _get_in_shard(size_t shard_idx, size_t n, const void* keys, const KeysInfo& keys_info, IndexValue* values,
-                         size_t* num_found) const;
+                         KeysInfo* not_found, size_t* num_found) const;
 
-    Status _check_not_exist_in_shard(size_t shard_idx, size_t n, const void* keys, const KeysInfo& keys_info) const;
+    // read the pages of shard |shard_idx|, |shard| is set to nullptr if the shard is empty
+    Status _read_shard(size_t shard_idx, std::unique_ptr<ImmutableIndexShard>* shard) const;
 
     std::unique_ptr<fs::ReadableBlock> _rb;
     EditVersion _version;
     size_t _size = 0;
+    size_t _file_size = 0;
     size_t _fixed_key_size = 0;
     size_t _fixed_value_size = 0;
 
@@ -139,12 +181,24 @@ private:
     };
 
     std::vector<ShardInfo> _shards;
+    // bloom filter of each shard, nullptr if the shard is empty or written without a bloom filter
+    std::vector<std::unique_ptr<BloomFilter>> _bloom_filters;
 };
 
-// A persistent primary index contains an in-memory L0 and an on-SSD/NVMe L1,
+// A persistent primary index contains an in-memory L0 and on-SSD/NVMe immutable indexes in two levels,
 // this saves memory usage comparing to the orig all-in-memory implementation.
 // This is a internal class and is intended to be used by PrimaryIndex internally.
-// TODO: code skeleton currently, implementation in future PRs
+//
+// Once the memory usage of L0 exceeds config::l0_max_mem_usage, it's flushed to a new immutable index in L1
+// when committed, the erased keys are kept so they hide the same keys in older immutable indexes.
+// The immutable indexes are merged in background to bound the number of them checked by each operation:
+//   * once there are config::persistent_index_merge_threshold indexes in L1, they are merged into a
+//     new index in L2.
+//   * once there are config::persistent_index_merge_threshold indexes in L2, the newest ones of similar
+//     sizes are merged into one, so a large index is rewritten only after the ones above it catch up
+//     with it in size.
+// A key is searched from L0, then the immutable indexes from the newest to the oldest, and stops at the
+// first one it's found in. At most one merge runs at a time, whose result is applied in commit.
 //
 // Currently primary index is only modified in TabletUpdates::apply process, it's
 // typical use pattern in apply:
@@ -223,6 +277,16 @@ public:
 
     size_t mutable_index_capacity();
 
+    // number of immutable indexes in L1 and L2
+    size_t l1_num() const { return _l1_vec.size(); }
+    size_t l2_num() const { return _l2_vec.size(); }
+
+    // Set the thread pool to merge immutable indexes in, they are merged in on_commited if not set.
+    void set_merge_thread_pool(ThreadPool* pool) { _merge_thread_pool = pool; }
+
+    // Wait for the running merge, if any, to finish, it's applied in next commit.
+    void wait_for_merge();
+
 private:
     std::string _get_l0_index_file_name(std::string& dir, const EditVersion& version);
 
@@ -243,15 +307,38 @@ private:
     // |values|: value array, if operation is erase, |values| is nullptr
     Status _append_wal(size_t n, const void* key, const IndexValue* values);
 
+    std::string _get_immutable_index_file_name(int level, const EditVersion& version) const;
+
+    Status _load_immutable_index(int level, const EditVersion& version);
+
+    // get the keys not found in l0 from immutable indexes, from the newest to the oldest
+    Status _get_from_immutable_index(size_t n, const void* keys, const KeysInfo& keys_info, IndexValue* values,
+                                     size_t* num_found) const;
+
+    bool _need_flush_l0();
+
     Status _flush_l0();
 
+    // start a merge of immutable indexes if needed and no merge is running
+    void _schedule_merge();
+
+    // replace the inputs of the finished merge, if any, with its output
+    void _apply_merge();
+
     // index storage directory
     std::string _path;
     size_t _key_size = 0;
     size_t _size = 0;
     EditVersion _version;
     std::unique_ptr<MutableIndex> _l0;
-    std::unique_ptr<ImmutableIndex> _l1;
+    // immutable indexes flushed from l0, from the oldest to the newest
+    std::vector<std::shared_ptr<ImmutableIndex>> _l1_vec;
+    // immutable indexes merged from l1 or l2, from the oldest to the newest, they are all older than l1
+    std::vector<std::shared_ptr<ImmutableIndex>> _l2_vec;
+    std::shared_ptr<ImmutableIndexMergeTask> _merge_task;
+    ThreadPool* _merge_thread_pool = nullptr;
+    // files of the immutable indexes replaced by the applied merge, deleted after committed
+    std::vector<std::string> _files_to_delete;
     // |_offset|: the start offset of last wal in index file
     // |_page_size|: the size of last wal in index file
     uint64_t _offset = 0;
@@ -0,0 +1,278 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <vector>
+
+#include "column/column.h"
+#include "gutil/strings/substitute.h"
+#include "storage/rowset/options.h"      // for PageBuilderOptions/PageDecoderOptions
+#include "storage/rowset/page_builder.h" // for PageBuilder
+#include "storage/rowset/page_decoder.h" // for PageDecoder
+#include "util/coding.h"
+#include "util/float_coding.h"
+
+namespace starrocks {
+
+// How the values of an ALP page are encoded, chosen by the page builder.
+enum class AlpPageMode : uint8_t {
+    ALP = 0,
+    GORILLA = 1,
+    PLAIN = 2,
+};
+
+// Encode page of FLOAT/DOUBLE with ALP coding.
+// Values like prices or measurements with limited decimal digits are encoded into small integers,
+// but the coding is useless for other values, so a sample of the page is encoded with ALP and Gorilla
+// when the page is finished, and the page is encoded with the smaller one, or left plain if neither helps.
+// The page format is:
+//   | mode (1) | count (4) | encoded values |
+template <FieldType Type>
+class AlpPageBuilder final : public PageBuilder {
+public:
+    // the page is sampled by |kNumSampleRuns| runs of |kSampleRunSize| consecutive values
+    static constexpr size_t kNumSampleRuns = 4;
+    static constexpr size_t kSampleRunSize = 64;
+
+    explicit AlpPageBuilder(const PageBuilderOptions& options) : _options(options), _finished(false) {}
+
+    ~AlpPageBuilder() override = default;
+
+    bool is_page_full() override { return _values.size() * sizeof(CppType) >= _options.data_page_size; }
+
+    size_t add(const uint8_t* vals, size_t count) override {
+        DCHECK(!_finished);
+        auto new_vals = reinterpret_cast<const CppType*>(vals);
+        _values.insert(_values.end(), new_vals, new_vals + count);
+        return count;
+    }
+
+    faststring* finish() override {
+        DCHECK(!_finished);
+        _finished = true;
+        _buf.clear();
+        typename AlpCoding<CppType>::Params params;
+        AlpPageMode mode = _choose_mode(&params);
+        _buf.push_back(static_cast<uint8_t>(mode));
+        put_fixed32_le(&_buf, _values.size());
+        switch (mode) {
+        case AlpPageMode::ALP:
+            AlpCoding<CppType>::encode(_values.data(), _values.size(), params, &_buf);
+            break;
+        case AlpPageMode::GORILLA: {
+            faststring data;
+            GorillaEncoder<CppType> encoder(&data);
+            encoder.add(_values.data(), _values.size());
+            encoder.flush();
+            _buf.append(data.data(), encoder.bytes_written());
+            break;
+        }
+        case AlpPageMode::PLAIN:
+            _buf.append(_values.data(), _values.size() * sizeof(CppType));
+            break;
+        }
+        return &_buf;
+    }
+
+    void reset() override {
+        _finished = false;
+        _values.clear();
+        _buf.clear();
+    }
+
+    size_t count() const override { return _values.size(); }
+
+    uint64_t size() const override { return _finished ? _buf.size() : 5 + _values.size() * sizeof(CppType); }
+
+    Status get_first_value(void* value) const override {
+        if (_values.empty()) {
+            return Status::NotFound("page is empty");
+        }
+        memcpy(value, &_values.front(), sizeof(CppType));
+        return Status::OK();
+    }
+
+    Status get_last_value(void* value) const override {
+        if (_values.empty()) {
+            return Status::NotFound("page is empty");
+        }
+        memcpy(value, &_values.back(), sizeof(CppType));
+        return Status::OK();
+    }
+
+private:
+    typedef typename TypeTraits<Type>::CppType CppType;
+    static_assert(std::is_floating_point_v<CppType>, "unexpected field type");
+
+    AlpPageMode _choose_mode(typename AlpCoding<CppType>::Params* params) const {
+        if (_values.empty()) {
+            return AlpPageMode::PLAIN;
+        }
+        AlpCoding<CppType>::choose_params(_values.data(), _values.size(), kNumSampleRuns * kSampleRunSize, params);
+
+        // encode the sample runs to compare the real sizes, the Gorilla coding depends on the previous values,
+        // so it can't be estimated from values far away from each other.
+        const size_t num_runs = std::min(kNumSampleRuns, (_values.size() + kSampleRunSize - 1) / kSampleRunSize);
+        const size_t run_stride = num_runs > 1 ? (_values.size() - kSampleRunSize) / (num_runs - 1) : 0;
+        size_t alp_bytes = 0;
+        size_t gorilla_bytes = 0;
+        size_t plain_bytes = 0;
+        faststring alp_buf;
+        faststring gorilla_buf;
+        for (size_t i = 0; i < num_runs; i++) {
+            const CppType* run = _values.data() + i * run_stride;
+            size_t run_size = std::min(kSampleRunSize, _values.size() - i * run_stride);
+            alp_buf.clear();
+            AlpCoding<CppType>::encode(run, run_size, *params, &alp_buf);
+            alp_bytes += alp_buf.size();
+            GorillaEncoder<CppType> gorilla(&gorilla_buf);
+            gorilla.add(run, run_size);
+            gorilla.flush();
+            gorilla_bytes += gorilla.bytes_written();
+            plain_bytes += run_size * sizeof(CppType);
+        }
+        if (alp_bytes <= gorilla_bytes && alp_bytes < plain_bytes) {
+            return AlpPageMode::ALP;
+        }
+        if (gorilla_bytes < plain_bytes) {
+            return AlpPageMode::GORILLA;
+        }
+        return AlpPageMode::PLAIN;
+    }
+
+    PageBuilderOptions _options;
+    bool _finished;
+    std::vector<CppType> _values;
+    faststring _buf;
+};
+
+template <FieldType Type>
+class AlpPageDecoder final : public PageDecoder {
+public:
+    AlpPageDecoder(Slice data, const PageDecoderOptions& options)
+            : _parsed(false), _data(data), _mode(AlpPageMode::PLAIN), _num_elements(0), _cur_index(0) {}
+
+    ~AlpPageDecoder() override = default;
+
+    Status init() override {
+        CHECK(!_parsed);
+        if (_data.size < 5) {
+            return Status::Corruption("The alp page metadata maybe broken");
+        }
+        const auto* data = reinterpret_cast<const uint8_t*>(_data.data);
+        _mode = static_cast<AlpPageMode>(data[0]);
+        _num_elements = decode_fixed32_le(data + 1);
+        const uint8_t* body = data + 5;
+        const size_t body_size = _data.size - 5;
+        switch (_mode) {
+        case AlpPageMode::ALP:
+            if (!_alp_decoder.init(body, body_size, _num_elements)) {
+                return Status::Corruption("The alp page metadata maybe broken");
+            }
+            break;
+        case AlpPageMode::GORILLA:
+            _gorilla_decoder.init(body, body_size, _num_elements);
+            break;
+        case AlpPageMode::PLAIN:
+            if (body_size != _num_elements * sizeof(CppType)) {
+                return Status::Corruption("The alp page metadata maybe broken");
+            }
+            break;
+        default:
+            return Status::Corruption(strings::Substitute("Unknown alp page mode $0", data[0]));
+        }
+        _plain_data = body;
+        _parsed = true;
+        return Status::OK();
+    }
+
+    Status seek_to_position_in_page(size_t pos) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        DCHECK_LE(pos, _num_elements) << "Tried to seek to " << pos << " which is > number of elements ("
+                                      << _num_elements << ") in the block!";
+        _cur_index = pos;
+        return Status::OK();
+    }
+
+    Status next_batch(size_t* n, ColumnBlockView* dst) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        if (PREDICT_FALSE(*n == 0 || _cur_index >= _num_elements)) {
+            *n = 0;
+            return Status::OK();
+        }
+
+        size_t to_fetch = std::min(*n, _num_elements - _cur_index);
+        RETURN_IF_ERROR(_decode(to_fetch, reinterpret_cast<CppType*>(dst->data())));
+        *n = to_fetch;
+        return Status::OK();
+    }
+
+    Status next_batch(size_t* n, vectorized::Column* dst) override {
+        vectorized::SparseRange read_range;
+        size_t begin = current_index();
+        read_range.add(vectorized::Range(begin, begin + *n));
+        RETURN_IF_ERROR(next_batch(read_range, dst));
+        *n = current_index() - begin;
+        return Status::OK();
+    }
+
+    Status next_batch(const vectorized::SparseRange& range, vectorized::Column* dst) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        if (PREDICT_FALSE(range.span_size() == 0 || _cur_index >= _num_elements)) {
+            return Status::OK();
+        }
+
+        size_t to_read =
+                std::min(static_cast<size_t>(range.span_size()), static_cast<size_t>(_num_elements - _cur_index));
+        vectorized::SparseRangeIterator iter = range.new_iterator();
+        while (to_read > 0 && _cur_index < _num_elements) {
+            _cur_index = iter.begin();
+            vectorized::Range r = iter.next(to_read);
+            const size_t ori_size = dst->size();
+            dst->resize(ori_size + r.span_size());
+            auto* p = reinterpret_cast<CppType*>(dst->mutable_raw_data()) + ori_size;
+            RETURN_IF_ERROR(_decode(r.span_size(), p));
+            to_read -= r.span_size();
+        }
+        return Status::OK();
+    }
+
+    size_t count() const override { return _num_elements; }
+
+    size_t current_index() const override { return _cur_index; }
+
+    EncodingTypePB encoding_type() const override { return ALP_ENCODING; }
+
+private:
+    typedef typename TypeTraits<Type>::CppType CppType;
+
+    // decode |n| values from |_cur_index| into |out|
+    Status _decode(size_t n, CppType* out) {
+        switch (_mode) {
+        case AlpPageMode::ALP:
+            _alp_decoder.decode(_cur_index, n, out);
+            break;
+        case AlpPageMode::GORILLA:
+            if (!_gorilla_decoder.seek(_cur_index) || !_gorilla_decoder.next_batch(out, n)) {
+                return Status::Corruption("The alp page maybe broken");
+            }
+            break;
+        case AlpPageMode::PLAIN:
+            memcpy(out, _plain_data + _cur_index * sizeof(CppType), n * sizeof(CppType));
+            break;
+        }
+        _cur_index += n;
+        return Status::OK();
+    }
+
+    bool _parsed;
+    Slice _data;
+    AlpPageMode _mode;
+    size_t _num_elements;
+    size_t _cur_index;
+    const uint8_t* _plain_data = nullptr;
+    AlpCoding<CppType> _alp_decoder;
+    GorillaDecoder<CppType> _gorilla_decoder;
+};
+
+} // namespace starrocks
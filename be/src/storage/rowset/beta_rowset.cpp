@@ -60,6 +60,10 @@ std::string BetaRowset::segment_srcrssid_file_path(const std::string& dir, const
     return strings::Substitute("$0/$1_$2.rssid", dir, rowset_id.to_string(), segment_id);
 }
 
+std::string BetaRowset::segment_delta_column_file_name(const RowsetId& rowset_id, int segment_id, uint32_t delta_id) {
+    return strings::Substitute("$0_$1_$2.cols", rowset_id.to_string(), segment_id, delta_id);
+}
+
 BetaRowset::BetaRowset(const TabletSchema* schema, string rowset_path, RowsetMetaSharedPtr rowset_meta)
         : Rowset(schema, std::move(rowset_path), std::move(rowset_meta)) {}
 
@@ -246,6 +250,7 @@ Status BetaRowset::get_segment_iterators(const vectorized::Schema& schema, const
     seg_options.stats = options.stats;
     seg_options.ranges = options.ranges;
     seg_options.predicates = options.predicates;
+    seg_options.runtime_filter_preds = options.runtime_filter_preds;
     seg_options.use_page_cache = options.use_page_cache;
     seg_options.profile = options.profile;
     seg_options.reader_type = options.reader_type;
@@ -275,12 +280,15 @@ Status BetaRowset::get_segment_iterators(const vectorized::Schema& schema, const
         }
     }
 
+    const size_t segment_begin = options.segment_begin;
+    const size_t segment_end = std::min<size_t>(options.segment_end, segments().size());
     std::vector<vectorized::ChunkIteratorPtr> tmp_seg_iters;
-    tmp_seg_iters.reserve(num_segments());
-    if (options.stats) {
-        options.stats->segments_read_count += num_segments();
+    tmp_seg_iters.reserve(segment_end > segment_begin ? segment_end - segment_begin : 0);
+    if (options.stats && segment_end > segment_begin) {
+        options.stats->segments_read_count += segment_end - segment_begin;
     }
-    for (auto& seg_ptr : segments()) {
+    for (size_t i = segment_begin; i < segment_end; ++i) {
+        auto& seg_ptr = segments()[i];
         if (seg_ptr->num_rows() == 0) {
             continue;
         }
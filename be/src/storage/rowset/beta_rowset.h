@@ -85,6 +85,11 @@ public:
     static std::string segment_srcrssid_file_path(const std::string& segment_dir, const RowsetId& rowset_id,
                                                   int segment_id);
 
+    // name of the delta column file written by column mode partial update |delta_id| to segment |segment_id|,
+    // the file is in the directory of the segment. These files are not removed with the rowset, but by
+    // the path gc after the rowset is unused.
+    static std::string segment_delta_column_file_name(const RowsetId& rowset_id, int segment_id, uint32_t delta_id);
+
     Status remove() override;
 
     Status link_files_to(const std::string& dir, RowsetId new_rowset_id) override;
@@ -23,11 +23,14 @@
 
 #include <cstddef>
 #include <memory>
+#include <vector>
 
 #include "common/status.h"
 #include "gen_cpp/segment.pb.h"
 #include "gutil/macros.h"
 
+class Roaring;
+
 namespace starrocks {
 
 class TypeInfo;
@@ -52,6 +55,11 @@ public:
 
     virtual uint64_t size() const = 0;
 
+    // Write |bitmaps| as the bitmap column of bitmap index, i.e, the posting lists of the values in dictionary.
+    // |bitmaps| are optimized in place.
+    static Status write_bitmap_column(const std::vector<Roaring*>& bitmaps, fs::WritableBlock* wblock,
+                                      IndexedColumnMetaPB* meta);
+
 private:
     BitmapIndexWriter(const BitmapIndexWriter&) = delete;
     const BitmapIndexWriter& operator=(const BitmapIndexWriter&) = delete;
@@ -58,6 +58,9 @@ public:
 
     const TypeInfoPtr& type_info() const { return _typeinfo; }
 
+    // number of bytes of each gram of ngram bloom filter index, 0 for other bloom filter index.
+    uint32_t gram_size() const { return _gram_size; }
+
     size_t mem_usage() const {
         size_t size = sizeof(BloomFilterIndexReader);
         if (_bloom_filter_reader != nullptr) {
@@ -70,6 +73,7 @@ private:
     TypeInfoPtr _typeinfo;
     BloomFilterAlgorithmPB _algorithm = BLOCK_BLOOM_FILTER;
     HashStrategyPB _hash_strategy = HASH_MURMUR3_X64_64;
+    uint32_t _gram_size = 0;
     std::unique_ptr<IndexedColumnReader> _bloom_filter_reader;
 };
 
@@ -34,6 +34,8 @@
 #include "storage/rowset/encoding_info.h"
 #include "storage/rowset/indexed_column_writer.h"
 #include "storage/types.h"
+#include "util/murmur_hash3.h"
+#include "util/phmap/phmap.h"
 #include "util/slice.h"
 
 namespace starrocks {
@@ -85,6 +87,26 @@ inline void update_bf(BloomFilter* bf, const typename CppTypeTraits<type>::CppTy
     }
 }
 
+// write the bloom filters of all pages as a VARCHAR indexed column with an ordinal index
+Status write_bloom_filters(const BloomFilterOptions& bf_options, const std::vector<std::unique_ptr<BloomFilter>>& bfs,
+                           fs::WritableBlock* wblock, BloomFilterIndexPB* meta) {
+    meta->set_hash_strategy(bf_options.strategy);
+    meta->set_algorithm(BLOCK_BLOOM_FILTER);
+
+    TypeInfoPtr bf_typeinfo = get_type_info(OLAP_FIELD_TYPE_VARCHAR);
+    IndexedColumnWriterOptions options;
+    options.write_ordinal_index = true;
+    options.write_value_index = false;
+    options.encoding = PLAIN_ENCODING;
+    IndexedColumnWriter bf_writer(options, bf_typeinfo, wblock);
+    RETURN_IF_ERROR(bf_writer.init());
+    for (auto& bf : bfs) {
+        Slice data(bf->data(), bf->size());
+        bf_writer.add(&data);
+    }
+    return bf_writer.finish(meta->mutable_bloom_filter());
+}
+
 // Builder for bloom filter. In starrocks, bloom filter index is used in
 // high cardinality key columns and none-agg value columns for high selectivity and storage
 // efficiency.
@@ -133,24 +155,7 @@ public:
             RETURN_IF_ERROR(flush());
         }
         index_meta->set_type(BLOOM_FILTER_INDEX);
-        BloomFilterIndexPB* meta = index_meta->mutable_bloom_filter_index();
-        meta->set_hash_strategy(_bf_options.strategy);
-        meta->set_algorithm(BLOCK_BLOOM_FILTER);
-
-        // write bloom filters
-        TypeInfoPtr bf_typeinfo = get_type_info(OLAP_FIELD_TYPE_VARCHAR);
-        IndexedColumnWriterOptions options;
-        options.write_ordinal_index = true;
-        options.write_value_index = false;
-        options.encoding = PLAIN_ENCODING;
-        IndexedColumnWriter bf_writer(options, bf_typeinfo, wblock);
-        RETURN_IF_ERROR(bf_writer.init());
-        for (auto& bf : _bfs) {
-            Slice data(bf->data(), bf->size());
-            bf_writer.add(&data);
-        }
-        RETURN_IF_ERROR(bf_writer.finish(meta->mutable_bloom_filter()));
-        return Status::OK();
+        return write_bloom_filters(_bf_options, _bfs, wblock, index_meta->mutable_bloom_filter_index());
     }
 
     uint64_t size() override {
@@ -170,6 +175,68 @@ private:
     std::vector<std::unique_ptr<BloomFilter>> _bfs;
 };
 
+// Builder for ngram bloom filter, which is used to skip pages for predicates like `c LIKE '%substr%'`.
+// Every |gram_size| consecutive bytes of the values of a data page are added to the bloom filter of the
+// page, a page can't contain the substring if any gram of the substring is absent from its bloom filter.
+// The bloom filters are stored in the same layout as BloomFilterIndexWriterImpl.
+class NgramBloomFilterIndexWriterImpl : public BloomFilterIndexWriter {
+public:
+    NgramBloomFilterIndexWriterImpl(const BloomFilterOptions& bf_options, size_t gram_size)
+            : _bf_options(bf_options), _gram_size(gram_size), _has_null(false), _bf_buffer_size(0) {}
+
+    ~NgramBloomFilterIndexWriterImpl() override = default;
+
+    void add_values(const void* values, size_t count) override {
+        const auto* v = reinterpret_cast<const Slice*>(values);
+        for (size_t i = 0; i < count; ++i) {
+            // values shorter than a gram add nothing, they can't contain a substring of |_gram_size| bytes either
+            for (size_t j = 0; j + _gram_size <= v[i].size; ++j) {
+                uint64_t hash;
+                murmur_hash3_x64_64(v[i].data + j, _gram_size, BloomFilter::DEFAULT_SEED, &hash);
+                _gram_hashes.insert(hash);
+            }
+        }
+    }
+
+    void add_nulls(uint32_t count) override { _has_null |= (count > 0); }
+
+    Status flush() override {
+        std::unique_ptr<BloomFilter> bf;
+        RETURN_IF_ERROR(BloomFilter::create(BLOCK_BLOOM_FILTER, &bf));
+        RETURN_IF_ERROR(bf->init(_gram_hashes.size(), _bf_options.fpp, _bf_options.strategy));
+        bf->set_has_null(_has_null);
+        for (uint64_t hash : _gram_hashes) {
+            bf->add_hash(hash);
+        }
+        _bf_buffer_size += bf->size();
+        _bfs.push_back(std::move(bf));
+        _gram_hashes.clear();
+        _has_null = false;
+        return Status::OK();
+    }
+
+    Status finish(fs::WritableBlock* wblock, ColumnIndexMetaPB* index_meta) override {
+        if (!_gram_hashes.empty()) {
+            RETURN_IF_ERROR(flush());
+        }
+        index_meta->set_type(NGRAM_BLOOM_FILTER_INDEX);
+        BloomFilterIndexPB* meta = index_meta->mutable_ngram_bloom_filter_index();
+        meta->set_gram_size(_gram_size);
+        return write_bloom_filters(_bf_options, _bfs, wblock, meta);
+    }
+
+    uint64_t size() override { return _bf_buffer_size + _gram_hashes.size() * sizeof(uint64_t); }
+
+private:
+    BloomFilterOptions _bf_options;
+    size_t _gram_size;
+    bool _has_null;
+    uint64_t _bf_buffer_size;
+    // hashes of the distinct grams of current page
+    phmap::flat_hash_set<uint64_t> _gram_hashes;
+    std::vector<std::unique_ptr<BloomFilter>> _bfs;
+};
+
 } // namespace
 
 struct BloomFilterBuilderFunctor {
@@ -187,4 +254,21 @@ Status BloomFilterIndexWriter::create(const BloomFilterOptions& bf_options, cons
     return field_type_dispatch_bloomfilter(typeinfo->type(), BloomFilterBuilderFunctor(), res, bf_options, typeinfo);
 }
 
+Status BloomFilterIndexWriter::create_ngram(const BloomFilterOptions& bf_options, const TypeInfoPtr& typeinfo,
+                                            size_t gram_size, std::unique_ptr<BloomFilterIndexWriter>* res) {
+    if (typeinfo->type() != OLAP_FIELD_TYPE_CHAR && typeinfo->type() != OLAP_FIELD_TYPE_VARCHAR) {
+        return Status::NotSupported(
+                strings::Substitute("ngram bloom filter index does not support type $0", typeinfo->type()));
+    }
+    // the grams are hashed without a BloomFilter instance, see NgramBloomFilterIndexWriterImpl::add_values
+    if (bf_options.strategy != HASH_MURMUR3_X64_64) {
+        return Status::InvalidArgument(strings::Substitute("invalid strategy:$0", bf_options.strategy));
+    }
+    if (gram_size == 0) {
+        return Status::InvalidArgument("gram size of ngram bloom filter index must be positive");
+    }
+    *res = std::make_unique<NgramBloomFilterIndexWriterImpl>(bf_options, gram_size);
+    return Status::OK();
+}
+
 } // namespace starrocks
@@ -44,6 +44,11 @@ public:
     static Status create(const BloomFilterOptions& bf_options, const TypeInfoPtr& typeinfo,
                          std::unique_ptr<BloomFilterIndexWriter>* res);
 
+    // Create a writer of ngram bloom filter index, which adds every |gram_size| consecutive bytes of
+    // the values to the bloom filters instead of the whole values, only CHAR/VARCHAR are supported.
+    static Status create_ngram(const BloomFilterOptions& bf_options, const TypeInfoPtr& typeinfo, size_t gram_size,
+                               std::unique_ptr<BloomFilterIndexWriter>* res);
+
     BloomFilterIndexWriter() = default;
     virtual ~BloomFilterIndexWriter() = default;
 
@@ -41,6 +41,7 @@ class ReadableBlock;
 } // namespace fs
 
 class ColumnReader;
+class PagePointer;
 
 struct ColumnIteratorOptions {
     fs::ReadableBlock* rblock = nullptr;
@@ -177,6 +178,20 @@ public:
 
     Status fetch_dict_codes_by_rowid(const vectorized::Column& rowids, vectorized::Column* values);
 
+    // Append the pointers of the data pages needed to read the rows in |range|, except the page
+    // loaded already. Used to prefetch the pages of many columns by coalesced reads.
+    virtual Status get_data_page_pointers(const vectorized::SparseRange& range, std::vector<PagePointer>* pages) {
+        return Status::OK();
+    }
+
+    // Evaluate |pred| on the encoded data pages of the rows in |range| without decoding them, and
+    // remove the rows not matching |pred| from |range|.
+    // Return Status::NotSupported and leave |range| unchanged if some page can't be evaluated encoded.
+    // The current ordinal is undefined after the call, the caller should seek before reading.
+    virtual Status evaluate_on_encoded_pages(const vectorized::ColumnPredicate& pred, vectorized::SparseRange* range) {
+        return Status::NotSupported("evaluate_on_encoded_pages() not supported");
+    }
+
 protected:
     ColumnIteratorOptions _opts;
 };
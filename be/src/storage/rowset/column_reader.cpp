@@ -65,7 +65,9 @@ ColumnReader::ColumnReader(MemTracker* mem_tracker, const private_type&, const C
           _zone_map_index(),
           _ordinal_index(),
           _bitmap_index(),
-          _bloom_filter_index() {
+          _bloom_filter_index(),
+          _ngram_bloom_filter_index(),
+          _inverted_index() {
     _mem_tracker->consume(sizeof(ColumnReader));
 }
 
@@ -103,6 +105,22 @@ ColumnReader::~ColumnReader() {
         size += _bloom_filter_index.reader->mem_usage();
         delete _bloom_filter_index.reader;
     }
+    if (_flags[kHasNgramBloomFilterIndexMetaPos]) {
+        size += _ngram_bloom_filter_index.meta->SpaceUsedLong();
+        delete _ngram_bloom_filter_index.meta;
+    }
+    if (_flags[kHasNgramBloomFilterIndexReaderPos]) {
+        size += _ngram_bloom_filter_index.reader->mem_usage();
+        delete _ngram_bloom_filter_index.reader;
+    }
+    if (_flags[kHasInvertedIndexMetaPos]) {
+        size += _inverted_index.meta->SpaceUsedLong();
+        delete _inverted_index.meta;
+    }
+    if (_flags[kHasInvertedIndexReaderPos]) {
+        size += _inverted_index.reader->mem_usage();
+        delete _inverted_index.reader;
+    }
     _mem_tracker->release(size);
 }
 
@@ -150,6 +168,21 @@ Status ColumnReader::_init(ColumnMetaPB* meta) {
                 _flags.set(kHasBloomFilterIndexMetaPos, true);
                 _mem_tracker->consume(_bloom_filter_index.meta->SpaceUsedLong());
                 break;
+            case NGRAM_BLOOM_FILTER_INDEX:
+                _ngram_bloom_filter_index.meta = index_meta->release_ngram_bloom_filter_index();
+                _flags.set(kHasNgramBloomFilterIndexMetaPos, true);
+                _mem_tracker->consume(_ngram_bloom_filter_index.meta->SpaceUsedLong());
+                break;
+            case INVERTED_INDEX:
+                // The terms are only comparable with the query terms split by the same tokenizer,
+                // ignore the index written by an unknown tokenizer.
+                if (index_meta->inverted_index().tokenizer() != STANDARD_TOKENIZER) {
+                    break;
+                }
+                _inverted_index.meta = index_meta->release_inverted_index();
+                _flags.set(kHasInvertedIndexMetaPos, true);
+                _mem_tracker->consume(_inverted_index.meta->SpaceUsedLong());
+                break;
             case UNKNOWN_INDEX_TYPE:
                 return Status::Corruption(fmt::format("Bad file {}: unknown index type", _file_name));
             }
@@ -209,6 +242,12 @@ Status ColumnReader::new_bitmap_index_iterator(BitmapIndexIterator** iterator) {
     return Status::OK();
 }
 
+Status ColumnReader::new_inverted_index_iterator(BitmapIndexIterator** iterator) {
+    RETURN_IF_ERROR(_load_inverted_index_once());
+    RETURN_IF_ERROR(_inverted_index.reader->new_iterator(iterator));
+    return Status::OK();
+}
+
 Status ColumnReader::read_page(const ColumnIteratorOptions& iter_opts, const PagePointer& pp, PageHandle* handle,
                                Slice* page_body, PageFooterPB* footer) {
     iter_opts.sanity_check();
@@ -256,19 +295,8 @@ Status ColumnReader::bloom_filter(const std::vector<const vectorized::ColumnPred
     vectorized::SparseRange bf_row_ranges;
     std::unique_ptr<BloomFilterIndexIterator> bf_iter;
     RETURN_IF_ERROR(_bloom_filter_index.reader->new_iterator(&bf_iter));
-    size_t range_size = row_ranges->size();
-    // get covered page ids
     std::set<int32_t> page_ids;
-    for (int i = 0; i < range_size; ++i) {
-        vectorized::Range r = (*row_ranges)[i];
-        int64_t idx = r.begin();
-        auto iter = _ordinal_index.reader->seek_at_or_before(r.begin());
-        while (idx < r.end()) {
-            page_ids.insert(iter.page_index());
-            idx = static_cast<int>(iter.last_ordinal() + 1);
-            iter.next();
-        }
-    }
+    _get_page_ids(*row_ranges, &page_ids);
     for (const auto& pid : page_ids) {
         std::unique_ptr<BloomFilter> bf;
         RETURN_IF_ERROR(bf_iter->read_bloom_filter(pid, &bf));
@@ -283,6 +311,48 @@ Status ColumnReader::bloom_filter(const std::vector<const vectorized::ColumnPred
     return Status::OK();
 }
 
+// prerequisite: at least one predicate in |predicates| support ngram bloom filter.
+Status ColumnReader::ngram_bloom_filter(const std::vector<const vectorized::ColumnPredicate*>& predicates,
+                                        vectorized::SparseRange* row_ranges) {
+    RETURN_IF_ERROR(_load_ngram_bloom_filter_index_once());
+    const size_t gram_size = _ngram_bloom_filter_index.reader->gram_size();
+    vectorized::SparseRange bf_row_ranges;
+    std::unique_ptr<BloomFilterIndexIterator> bf_iter;
+    RETURN_IF_ERROR(_ngram_bloom_filter_index.reader->new_iterator(&bf_iter));
+    std::set<int32_t> page_ids;
+    _get_page_ids(*row_ranges, &page_ids);
+    for (const auto& pid : page_ids) {
+        std::unique_ptr<BloomFilter> bf;
+        RETURN_IF_ERROR(bf_iter->read_bloom_filter(pid, &bf));
+        bool may_match = true;
+        for (const auto* pred : predicates) {
+            if (pred->support_ngram_bloom_filter() && !pred->ngram_bloom_filter(bf.get(), gram_size)) {
+                may_match = false;
+                break;
+            }
+        }
+        if (may_match) {
+            bf_row_ranges.add(vectorized::Range(_ordinal_index.reader->get_first_ordinal(pid),
+                                                _ordinal_index.reader->get_last_ordinal(pid) + 1));
+        }
+    }
+    *row_ranges = row_ranges->intersection(bf_row_ranges);
+    return Status::OK();
+}
+
+void ColumnReader::_get_page_ids(const vectorized::SparseRange& row_ranges, std::set<int32_t>* page_ids) {
+    for (size_t i = 0; i < row_ranges.size(); ++i) {
+        vectorized::Range r = row_ranges[i];
+        int64_t idx = r.begin();
+        auto iter = _ordinal_index.reader->seek_at_or_before(r.begin());
+        while (idx < r.end()) {
+            page_ids->insert(iter.page_index());
+            idx = static_cast<int>(iter.last_ordinal() + 1);
+            iter.next();
+        }
+    }
+}
+
 Status ColumnReader::_load_ordinal_index(bool use_page_cache, bool kept_in_memory) {
     Status st;
     if (_flags[kHasOrdinalIndexMetaPos]) {
@@ -346,6 +416,38 @@ Status ColumnReader::_load_bloom_filter_index(bool use_page_cache, bool kept_in_
     return st;
 }
 
+Status ColumnReader::_load_ngram_bloom_filter_index(bool use_page_cache, bool kept_in_memory) {
+    Status st;
+    if (_flags[kHasNgramBloomFilterIndexMetaPos]) {
+        SCOPED_THREAD_LOCAL_CHECK_MEM_LIMIT_SETTER(false);
+        std::unique_ptr<BloomFilterIndexPB> index_meta(_ngram_bloom_filter_index.meta);
+        _flags.set(kHasNgramBloomFilterIndexMetaPos, false);
+        _mem_tracker->release(index_meta->SpaceUsedLong());
+        _ngram_bloom_filter_index.reader = new BloomFilterIndexReader();
+        _flags.set(kHasNgramBloomFilterIndexReaderPos, true);
+        st = _ngram_bloom_filter_index.reader->load(_opts.block_mgr, _file_name, index_meta.get(), use_page_cache,
+                                                    kept_in_memory);
+        _mem_tracker->consume(_ngram_bloom_filter_index.reader->mem_usage());
+    }
+    return st;
+}
+
+Status ColumnReader::_load_inverted_index(bool use_page_cache, bool kept_in_memory) {
+    Status st;
+    if (_flags[kHasInvertedIndexMetaPos]) {
+        SCOPED_THREAD_LOCAL_CHECK_MEM_LIMIT_SETTER(false);
+        std::unique_ptr<InvertedIndexPB> index_meta(_inverted_index.meta);
+        _flags.set(kHasInvertedIndexMetaPos, false);
+        _mem_tracker->release(index_meta->SpaceUsedLong());
+        _inverted_index.reader = new BitmapIndexReader();
+        _flags.set(kHasInvertedIndexReaderPos, true);
+        st = _inverted_index.reader->load(_opts.block_mgr, _file_name, &index_meta->postings(), use_page_cache,
+                                          kept_in_memory);
+        _mem_tracker->consume(_inverted_index.reader->mem_usage());
+    }
+    return st;
+}
+
 Status ColumnReader::seek_to_first(OrdinalPageIndexIterator* iter) {
     *iter = _ordinal_index.reader->begin();
     if (!iter->valid()) {
@@ -454,6 +556,19 @@ Status ColumnReader::_load_bloom_filter_index_once() {
     return status;
 }
 
+Status ColumnReader::_load_ngram_bloom_filter_index_once() {
+    Status status = _ngram_bloomfilter_index_once.call([this] {
+        return _load_ngram_bloom_filter_index(!config::disable_storage_page_cache, _opts.kept_in_memory);
+    });
+    return status;
+}
+
+Status ColumnReader::_load_inverted_index_once() {
+    Status status = _inverted_index_once.call(
+            [this] { return _load_inverted_index(!config::disable_storage_page_cache, _opts.kept_in_memory); });
+    return status;
+}
+
 Status ColumnReader::load_ordinal_index_once() {
     // Only load ordinal index.
     // Other indexes like zone map/bitmap/bloomfilter should be load when necessary
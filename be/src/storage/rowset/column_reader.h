@@ -26,6 +26,7 @@
 #include <cstddef> // for size_t
 #include <cstdint> // for uint32_t
 #include <memory>  // for unique_ptr
+#include <set>
 #include <utility>
 
 #include "column/datum.h"
@@ -109,6 +110,10 @@ public:
     // TODO: StatusOr<std::unique_ptr<ColumnIterator>> new_bitmap_index_iterator()
     Status new_bitmap_index_iterator(BitmapIndexIterator** iterator);
 
+    // Iterate the terms of the inverted index, the dictionary entries are the terms and the bitmaps are
+    // the rows containing them. Caller should free returned iterator after unused.
+    Status new_inverted_index_iterator(BitmapIndexIterator** iterator);
+
     // Seek to the first entry in the column.
     Status seek_to_first(OrdinalPageIndexIterator* iter);
     Status seek_at_or_before(ordinal_t ordinal, OrdinalPageIndexIterator* iter);
@@ -126,6 +131,12 @@ public:
     bool has_bloom_filter_index() const {
         return _flags[kHasBloomFilterIndexMetaPos] || _flags[kHasBloomFilterIndexReaderPos];
     }
+    bool has_ngram_bloom_filter_index() const {
+        return _flags[kHasNgramBloomFilterIndexMetaPos] || _flags[kHasNgramBloomFilterIndexReaderPos];
+    }
+    bool has_inverted_index() const {
+        return _flags[kHasInvertedIndexMetaPos] || _flags[kHasInvertedIndexReaderPos];
+    }
 
     ZoneMapPB* segment_zone_map() const { return _segment_zone_map.get(); }
 
@@ -158,6 +169,11 @@ public:
     Status bloom_filter(const std::vector<const ::starrocks::vectorized::ColumnPredicate*>& p,
                         vectorized::SparseRange* ranges);
 
+    // prerequisite: at least one predicate in |predicates| support ngram bloom filter.
+    // Keep the pages whose ngram bloom filter may match all the predicates supporting it.
+    Status ngram_bloom_filter(const std::vector<const ::starrocks::vectorized::ColumnPredicate*>& p,
+                              vectorized::SparseRange* ranges);
+
     uint32_t version() const { return _opts.storage_format_version; }
 
     Status load_ordinal_index_once();
@@ -184,6 +200,10 @@ private:
     constexpr static size_t kIsNullablePos = 8;
     constexpr static size_t kHasAllDictEncodedPos = 9;
     constexpr static size_t kAllDictEncodedPos = 10;
+    constexpr static size_t kHasNgramBloomFilterIndexMetaPos = 11;
+    constexpr static size_t kHasNgramBloomFilterIndexReaderPos = 12;
+    constexpr static size_t kHasInvertedIndexMetaPos = 13;
+    constexpr static size_t kHasInvertedIndexReaderPos = 14;
 
     // Disable copy and assignment
     ColumnReader(const ColumnReader&) = delete;
@@ -197,17 +217,24 @@ private:
     Status _load_zone_map_index_once();
     Status _load_bitmap_index_once();
     Status _load_bloom_filter_index_once();
+    Status _load_ngram_bloom_filter_index_once();
+    Status _load_inverted_index_once();
 
     Status _load_zone_map_index(bool use_page_cache, bool kept_in_memory);
     Status _load_ordinal_index(bool use_page_cache, bool kept_in_memory);
     Status _load_bitmap_index(bool use_page_cache, bool kept_in_memory);
     Status _load_bloom_filter_index(bool use_page_cache, bool kept_in_memory);
+    Status _load_ngram_bloom_filter_index(bool use_page_cache, bool kept_in_memory);
+    Status _load_inverted_index(bool use_page_cache, bool kept_in_memory);
 
     static void _parse_zone_map(const ZoneMapPB& zone_map, WrapperField* min_value_container,
                                 WrapperField* max_value_container);
 
     Status _parse_zone_map(const ZoneMapPB& zm, vectorized::ZoneMapDetail* detail) const;
 
+    // ids of the pages covered by |row_ranges|
+    void _get_page_ids(const vectorized::SparseRange& row_ranges, std::set<int32_t>* page_ids);
+
     Status _calculate_row_ranges(const std::vector<uint32_t>& page_indexes, vectorized::SparseRange* row_ranges);
 
     Status _zone_map_filter(const std::vector<const vectorized::ColumnPredicate*>& predicates,
@@ -235,6 +262,8 @@ private:
     ColumnIndex<OrdinalIndexPB, OrdinalIndexReader> _ordinal_index;
     ColumnIndex<BitmapIndexPB, BitmapIndexReader> _bitmap_index;
     ColumnIndex<BloomFilterIndexPB, BloomFilterIndexReader> _bloom_filter_index;
+    ColumnIndex<BloomFilterIndexPB, BloomFilterIndexReader> _ngram_bloom_filter_index;
+    ColumnIndex<InvertedIndexPB, BitmapIndexReader> _inverted_index;
 
     std::unique_ptr<ZoneMapPB> _segment_zone_map;
 
@@ -249,6 +278,8 @@ private:
     StarRocksCallOnce<Status> _zonemap_index_once;
     StarRocksCallOnce<Status> _bitmap_index_once;
     StarRocksCallOnce<Status> _bloomfilter_index_once;
+    StarRocksCallOnce<Status> _ngram_bloomfilter_index_once;
+    StarRocksCallOnce<Status> _inverted_index_once;
 
     std::bitset<16> _flags;
 };
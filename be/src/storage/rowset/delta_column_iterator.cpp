@@ -0,0 +1,87 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "storage/rowset/delta_column_iterator.h"
+
+#include <algorithm>
+
+#include "column/column.h"
+#include "storage/vectorized/range.h"
+
+namespace starrocks {
+
+DeltaColumnIterator::DeltaColumnIterator(ColumnIterator* base, ordinal_t num_rows, std::vector<rowid_t> rowids,
+                                         vectorized::ColumnPtr values)
+        : _base(base), _num_rows(num_rows), _rowids(std::move(rowids)), _values(std::move(values)) {
+    DCHECK_EQ(_rowids.size(), _values->size());
+}
+
+Status DeltaColumnIterator::next_batch(size_t* n, vectorized::Column* dst) {
+    const auto begin = static_cast<rowid_t>(_base->get_current_ordinal());
+    const size_t offset = dst->size();
+    RETURN_IF_ERROR(_base->next_batch(n, dst));
+    return _apply_updates(begin, begin + *n, offset, dst);
+}
+
+Status DeltaColumnIterator::next_batch(const vectorized::SparseRange& range, vectorized::Column* dst) {
+    size_t offset = dst->size();
+    RETURN_IF_ERROR(_base->next_batch(range, dst));
+    _dst_indexes.clear();
+    _src_indexes.clear();
+    for (size_t i = 0; i < range.size(); i++) {
+        const vectorized::Range& r = range[i];
+        auto iter = std::lower_bound(_rowids.begin(), _rowids.end(), r.begin());
+        for (; iter != _rowids.end() && *iter < r.end(); ++iter) {
+            _dst_indexes.push_back(offset + *iter - r.begin());
+            _src_indexes.push_back(iter - _rowids.begin());
+        }
+        offset += r.span_size();
+    }
+    return _update_rows(dst);
+}
+
+Status DeltaColumnIterator::get_row_ranges_by_zone_map(
+        const std::vector<const vectorized::ColumnPredicate*>& predicates,
+        const vectorized::ColumnPredicate* del_predicate, vectorized::SparseRange* row_ranges) {
+    DCHECK(row_ranges->empty());
+    row_ranges->add({0, static_cast<rowid_t>(_num_rows)});
+    return Status::OK();
+}
+
+Status DeltaColumnIterator::fetch_values_by_rowid(const rowid_t* rowids, size_t size, vectorized::Column* values) {
+    const size_t offset = values->size();
+    RETURN_IF_ERROR(_base->fetch_values_by_rowid(rowids, size, values));
+    // both |rowids| and |_rowids| are sorted.
+    _dst_indexes.clear();
+    _src_indexes.clear();
+    auto iter = _rowids.begin();
+    for (size_t i = 0; i < size && iter != _rowids.end(); i++) {
+        iter = std::lower_bound(iter, _rowids.end(), rowids[i]);
+        if (iter != _rowids.end() && *iter == rowids[i]) {
+            _dst_indexes.push_back(offset + i);
+            _src_indexes.push_back(iter - _rowids.begin());
+        }
+    }
+    return _update_rows(values);
+}
+
+Status DeltaColumnIterator::_apply_updates(rowid_t begin, rowid_t end, size_t offset, vectorized::Column* dst) {
+    _dst_indexes.clear();
+    _src_indexes.clear();
+    auto iter = std::lower_bound(_rowids.begin(), _rowids.end(), begin);
+    for (; iter != _rowids.end() && *iter < end; ++iter) {
+        _dst_indexes.push_back(offset + *iter - begin);
+        _src_indexes.push_back(iter - _rowids.begin());
+    }
+    return _update_rows(dst);
+}
+
+Status DeltaColumnIterator::_update_rows(vectorized::Column* dst) {
+    if (_dst_indexes.empty()) {
+        return Status::OK();
+    }
+    auto updates = _values->clone_empty();
+    updates->append_selective(*_values, _src_indexes.data(), 0, _src_indexes.size());
+    return dst->update_rows(*updates, _dst_indexes.data());
+}
+
+} // namespace starrocks
@@ -0,0 +1,71 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <vector>
+
+#include "column/vectorized_fwd.h"
+#include "storage/rowset/column_iterator.h"
+
+namespace starrocks {
+
+// Read a column of a segment with the values of the rows updated by column mode partial updates
+// replaced by the newest ones, see DeltaColumnGroup.
+// The indexes of the base column (zone map, bloom filter and dictionary) are not used, because they
+// don't cover the updated values.
+class DeltaColumnIterator final : public ColumnIterator {
+public:
+    // |base| is not owned by this iterator, and must have been initialized.
+    // |rowids| are the updated rows sorted in ascending order, |values| are their values.
+    DeltaColumnIterator(ColumnIterator* base, ordinal_t num_rows, std::vector<rowid_t> rowids,
+                        vectorized::ColumnPtr values);
+
+    ~DeltaColumnIterator() override = default;
+
+    Status seek_to_first() override { return _base->seek_to_first(); }
+
+    Status seek_to_ordinal(ordinal_t ord) override { return _base->seek_to_ordinal(ord); }
+
+    Status next_batch(size_t* n, ColumnBlockView* dst, bool* has_null) override {
+        return Status::NotSupported("DeltaColumnIterator does not support ColumnBlockView");
+    }
+
+    Status next_batch(size_t* n, vectorized::Column* dst) override;
+
+    Status next_batch(const vectorized::SparseRange& range, vectorized::Column* dst) override;
+
+    ordinal_t get_current_ordinal() const override { return _base->get_current_ordinal(); }
+
+    Status get_row_ranges_by_zone_map(const std::vector<const vectorized::ColumnPredicate*>& predicates,
+                                      const vectorized::ColumnPredicate* del_predicate,
+                                      vectorized::SparseRange* row_ranges) override;
+
+    int64_t element_ordinal() const override { return _base->element_ordinal(); }
+
+    Status seek_to_ordinal_and_calc_element_ordinal(ordinal_t ord) override {
+        return _base->seek_to_ordinal_and_calc_element_ordinal(ord);
+    }
+
+    Status fetch_values_by_rowid(const rowid_t* rowids, size_t size, vectorized::Column* values) override;
+
+    Status get_data_page_pointers(const vectorized::SparseRange& range, std::vector<PagePointer>* pages) override {
+        return _base->get_data_page_pointers(range, pages);
+    }
+
+private:
+    // Replace the values of rows in [begin, end), which are stored in |dst| from |offset|.
+    Status _apply_updates(rowid_t begin, rowid_t end, size_t offset, vectorized::Column* dst);
+
+    Status _update_rows(vectorized::Column* dst);
+
+    ColumnIterator* _base;
+    const ordinal_t _num_rows;
+    const std::vector<rowid_t> _rowids;
+    const vectorized::ColumnPtr _values;
+
+    // reused buffers for the positions in |dst| and in |_values| of the rows to update
+    std::vector<uint32_t> _dst_indexes;
+    std::vector<uint32_t> _src_indexes;
+};
+
+} // namespace starrocks
@@ -47,6 +47,10 @@ public:
 
     ordinal_t get_current_ordinal() const override { return _col_iter->get_current_ordinal(); }
 
+    Status get_data_page_pointers(const vectorized::SparseRange& range, std::vector<PagePointer>* pages) override {
+        return _col_iter->get_data_page_pointers(range, pages);
+    }
+
     bool all_page_dict_encoded() const override { return _col_iter->all_page_dict_encoded(); }
 
     int dict_lookup(const Slice& word) override { return _col_iter->dict_lookup(word); }
@@ -21,10 +21,13 @@
 
 #pragma once
 
+#include <limits>
+
 #include "column/column.h"
 #include "storage/rowset/options.h"      // for PageBuilderOptions/PageDecoderOptions
 #include "storage/rowset/page_builder.h" // for PageBuilder
 #include "storage/rowset/page_decoder.h" // for PageDecoder
+#include "storage/vectorized/column_predicate.h"
 #include "util/frame_of_reference_coding.h"
 
 namespace starrocks {
@@ -211,6 +214,62 @@ public:
         return Status::OK();
     }
 
+    // Only the comparisons with a constant on integer columns are supported, they are converted into a range
+    // [lo, hi] and evaluated on the bit-packed deltas, see `ForDecoder::evaluate_range`.
+    Status evaluate(const vectorized::ColumnPredicate& pred, size_t from, size_t to, uint8_t* selection) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        DCHECK_LE(to, _num_elements);
+        if constexpr (Type == OLAP_FIELD_TYPE_TINYINT || Type == OLAP_FIELD_TYPE_SMALLINT ||
+                      Type == OLAP_FIELD_TYPE_INT || Type == OLAP_FIELD_TYPE_BIGINT) {
+            if (pred.type_info()->type() != Type) {
+                return Status::NotSupported("evaluate() on different type");
+            }
+            const CppType value = pred.value().get<CppType>();
+            CppType lo = std::numeric_limits<CppType>::lowest();
+            CppType hi = std::numeric_limits<CppType>::max();
+            bool negate = false;
+            bool empty = false;
+            switch (pred.type()) {
+            case vectorized::PredicateType::kNE:
+                negate = true;
+                [[fallthrough]];
+            case vectorized::PredicateType::kEQ:
+                lo = value;
+                hi = value;
+                break;
+            case vectorized::PredicateType::kGT:
+                empty = value == hi;
+                lo = empty ? value : value + 1;
+                break;
+            case vectorized::PredicateType::kGE:
+                lo = value;
+                break;
+            case vectorized::PredicateType::kLT:
+                empty = value == lo;
+                hi = empty ? value : value - 1;
+                break;
+            case vectorized::PredicateType::kLE:
+                hi = value;
+                break;
+            default:
+                return Status::NotSupported("evaluate() on non-comparison predicate");
+            }
+            if (empty) {
+                memset(selection, 0, to - from);
+            } else if (!_decoder.evaluate_range(lo, hi, from, to, selection)) {
+                return Status::NotSupported("evaluate() not supported");
+            }
+            if (negate) {
+                for (size_t i = 0; i < to - from; i++) {
+                    selection[i] ^= 1;
+                }
+            }
+            return Status::OK();
+        } else {
+            return Status::NotSupported("evaluate() not supported");
+        }
+    }
+
     size_t count() const override { return _num_elements; }
 
     size_t current_index() const override { return _cur_index; }
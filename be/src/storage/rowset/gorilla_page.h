@@ -0,0 +1,188 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include "column/column.h"
+#include "storage/rowset/options.h"      // for PageBuilderOptions/PageDecoderOptions
+#include "storage/rowset/page_builder.h" // for PageBuilder
+#include "storage/rowset/page_decoder.h" // for PageDecoder
+#include "util/coding.h"
+#include "util/float_coding.h"
+
+namespace starrocks {
+
+// Encode page of FLOAT/DOUBLE with the XOR based coding of Gorilla.
+// The page format is:
+//   | count (4) | encoded values |
+template <FieldType Type>
+class GorillaPageBuilder final : public PageBuilder {
+public:
+    explicit GorillaPageBuilder(const PageBuilderOptions& options)
+            : _options(options), _finished(false), _encoder(&_data) {}
+
+    ~GorillaPageBuilder() override = default;
+
+    bool is_page_full() override { return _encoder.bytes_written() >= _options.data_page_size; }
+
+    size_t add(const uint8_t* vals, size_t count) override {
+        DCHECK(!_finished);
+        if (count == 0) {
+            return 0;
+        }
+        auto new_vals = reinterpret_cast<const CppType*>(vals);
+        if (_encoder.count() == 0) {
+            _first_val = *new_vals;
+        }
+        _encoder.add(new_vals, count);
+        _last_val = new_vals[count - 1];
+        return count;
+    }
+
+    faststring* finish() override {
+        DCHECK(!_finished);
+        _finished = true;
+        _encoder.flush();
+        _buf.clear();
+        put_fixed32_le(&_buf, _encoder.count());
+        _buf.append(_data.data(), _encoder.bytes_written());
+        return &_buf;
+    }
+
+    void reset() override {
+        _finished = false;
+        _encoder.clear();
+        _buf.clear();
+    }
+
+    size_t count() const override { return _encoder.count(); }
+
+    uint64_t size() const override { return _finished ? _buf.size() : 4 + _encoder.bytes_written(); }
+
+    Status get_first_value(void* value) const override {
+        if (_encoder.count() == 0) {
+            return Status::NotFound("page is empty");
+        }
+        memcpy(value, &_first_val, sizeof(CppType));
+        return Status::OK();
+    }
+
+    Status get_last_value(void* value) const override {
+        if (_encoder.count() == 0) {
+            return Status::NotFound("page is empty");
+        }
+        memcpy(value, &_last_val, sizeof(CppType));
+        return Status::OK();
+    }
+
+private:
+    typedef typename TypeTraits<Type>::CppType CppType;
+    static_assert(std::is_floating_point_v<CppType>, "unexpected field type");
+
+    PageBuilderOptions _options;
+    bool _finished;
+    faststring _data;
+    faststring _buf;
+    CppType _first_val;
+    CppType _last_val;
+    GorillaEncoder<CppType> _encoder;
+};
+
+template <FieldType Type>
+class GorillaPageDecoder final : public PageDecoder {
+public:
+    GorillaPageDecoder(Slice data, const PageDecoderOptions& options)
+            : _parsed(false), _data(data), _num_elements(0), _cur_index(0) {}
+
+    ~GorillaPageDecoder() override = default;
+
+    Status init() override {
+        CHECK(!_parsed);
+        if (_data.size < 4) {
+            return Status::Corruption("The gorilla page metadata maybe broken");
+        }
+        _num_elements = decode_fixed32_le(reinterpret_cast<const uint8_t*>(_data.data));
+        _decoder.init(reinterpret_cast<const uint8_t*>(_data.data) + 4, _data.size - 4, _num_elements);
+        _parsed = true;
+        return Status::OK();
+    }
+
+    Status seek_to_position_in_page(size_t pos) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        DCHECK_LE(pos, _num_elements) << "Tried to seek to " << pos << " which is > number of elements ("
+                                      << _num_elements << ") in the block!";
+        if (PREDICT_FALSE(_num_elements == 0)) {
+            return Status::OK();
+        }
+        if (!_decoder.seek(pos)) {
+            return Status::Corruption("The gorilla page maybe broken");
+        }
+        _cur_index = pos;
+        return Status::OK();
+    }
+
+    Status next_batch(size_t* n, ColumnBlockView* dst) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        if (PREDICT_FALSE(*n == 0 || _cur_index >= _num_elements)) {
+            *n = 0;
+            return Status::OK();
+        }
+
+        size_t to_fetch = std::min(*n, _num_elements - _cur_index);
+        if (!_decoder.next_batch(reinterpret_cast<CppType*>(dst->data()), to_fetch)) {
+            return Status::Corruption("The gorilla page maybe broken");
+        }
+        _cur_index += to_fetch;
+        *n = to_fetch;
+        return Status::OK();
+    }
+
+    Status next_batch(size_t* n, vectorized::Column* dst) override {
+        vectorized::SparseRange read_range;
+        size_t begin = current_index();
+        read_range.add(vectorized::Range(begin, begin + *n));
+        RETURN_IF_ERROR(next_batch(read_range, dst));
+        *n = current_index() - begin;
+        return Status::OK();
+    }
+
+    Status next_batch(const vectorized::SparseRange& range, vectorized::Column* dst) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        if (PREDICT_FALSE(range.span_size() == 0 || _cur_index >= _num_elements)) {
+            return Status::OK();
+        }
+
+        size_t to_read =
+                std::min(static_cast<size_t>(range.span_size()), static_cast<size_t>(_num_elements - _cur_index));
+        vectorized::SparseRangeIterator iter = range.new_iterator();
+        while (to_read > 0 && _cur_index < _num_elements) {
+            RETURN_IF_ERROR(seek_to_position_in_page(iter.begin()));
+            vectorized::Range r = iter.next(to_read);
+            const size_t ori_size = dst->size();
+            dst->resize(ori_size + r.span_size());
+            auto* p = reinterpret_cast<CppType*>(dst->mutable_raw_data()) + ori_size;
+            if (!_decoder.next_batch(p, r.span_size())) {
+                return Status::Corruption("The gorilla page maybe broken");
+            }
+            _cur_index += r.span_size();
+            to_read -= r.span_size();
+        }
+        return Status::OK();
+    }
+
+    size_t count() const override { return _num_elements; }
+
+    size_t current_index() const override { return _cur_index; }
+
+    EncodingTypePB encoding_type() const override { return GORILLA_ENCODING; }
+
+private:
+    typedef typename TypeTraits<Type>::CppType CppType;
+
+    bool _parsed;
+    Slice _data;
+    size_t _num_elements;
+    size_t _cur_index;
+    GorillaDecoder<CppType> _decoder;
+};
+
+} // namespace starrocks
@@ -0,0 +1,72 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "storage/rowset/inverted_index_writer.h"
+
+#include "gutil/strings/substitute.h"
+#include "storage/rowset/bitmap_index_writer.h"
+#include "storage/rowset/encoding_info.h"
+#include "storage/rowset/indexed_column_writer.h"
+#include "storage/types.h"
+#include "util/slice.h"
+#include "util/text_tokenizer.h"
+
+namespace starrocks {
+
+Status InvertedIndexWriter::create(const TypeInfoPtr& type_info, std::unique_ptr<InvertedIndexWriter>* res) {
+    if (type_info->type() != OLAP_FIELD_TYPE_CHAR && type_info->type() != OLAP_FIELD_TYPE_VARCHAR) {
+        return Status::NotSupported(
+                strings::Substitute("inverted index does not support type $0", type_info->type()));
+    }
+    *res = std::make_unique<InvertedIndexWriter>();
+    return Status::OK();
+}
+
+void InvertedIndexWriter::add_values(const void* values, size_t count) {
+    const auto* v = reinterpret_cast<const Slice*>(values);
+    for (size_t i = 0; i < count; ++i) {
+        TextTokenizer::tokenize(v[i], [this](const std::string& term) {
+            auto [it, inserted] = _postings.try_emplace(term);
+            if (inserted) {
+                _terms_bytes += sizeof(Roaring) + term.size();
+            }
+            it->second.add(_rid);
+            _num_postings++;
+        });
+        _rid++;
+    }
+}
+
+Status InvertedIndexWriter::finish(fs::WritableBlock* wblock, ColumnIndexMetaPB* index_meta) {
+    index_meta->set_type(INVERTED_INDEX);
+    InvertedIndexPB* meta = index_meta->mutable_inverted_index();
+    meta->set_tokenizer(STANDARD_TOKENIZER);
+    BitmapIndexPB* postings = meta->mutable_postings();
+    postings->set_bitmap_type(BitmapIndexPB::ROARING_BITMAP);
+    postings->set_has_null(false);
+
+    { // write dictionary
+        TypeInfoPtr typeinfo = get_type_info(OLAP_FIELD_TYPE_VARCHAR);
+        IndexedColumnWriterOptions options;
+        options.write_ordinal_index = false;
+        options.write_value_index = true;
+        options.encoding = EncodingInfo::get_default_encoding(typeinfo->type(), true);
+        options.compression = CompressionTypePB::LZ4_FRAME;
+
+        IndexedColumnWriter dict_column_writer(options, typeinfo, wblock);
+        RETURN_IF_ERROR(dict_column_writer.init());
+        for (auto const& it : _postings) {
+            Slice term(it.first);
+            RETURN_IF_ERROR(dict_column_writer.add(&term));
+        }
+        RETURN_IF_ERROR(dict_column_writer.finish(postings->mutable_dict_column()));
+    }
+    // write posting lists
+    std::vector<Roaring*> bitmaps;
+    bitmaps.reserve(_postings.size());
+    for (auto& it : _postings) {
+        bitmaps.push_back(&(it.second));
+    }
+    return BitmapIndexWriter::write_bitmap_column(bitmaps, wblock, postings->mutable_bitmap_column());
+}
+
+} // namespace starrocks
@@ -0,0 +1,63 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <roaring/roaring.hh>
+#include <string>
+
+#include "common/status.h"
+#include "gen_cpp/segment.pb.h"
+#include "storage/rowset/common.h"
+
+namespace starrocks {
+
+class TypeInfo;
+using TypeInfoPtr = std::shared_ptr<TypeInfo>;
+
+namespace fs {
+class WritableBlock;
+}
+
+// Builder for inverted index of CHAR/VARCHAR columns. The values are split into terms by TextTokenizer,
+// and the index is comprised of the ordered dictionary of the distinct terms, and the posting list of
+// each term, i.e, the bitmap of the rows containing the term. The layout is the same as bitmap index,
+// so the index is read by BitmapIndexReader, but unlike bitmap index, a row may be in many bitmaps,
+// and the null rows are in no bitmap.
+//
+// E.g, if the column contains 3 rows ['GET /index.html', 'POST /login', 'GET /login'],
+// then the ordered dictionary would be ['get', 'html', 'index', 'login', 'post'], and the posting list
+// would contain five bitmaps
+//   get   : [1 0 1]
+//   html  : [1 0 0]
+//   index : [1 0 0]
+//   login : [0 1 1]
+//   post  : [0 1 0]
+class InvertedIndexWriter {
+public:
+    static Status create(const TypeInfoPtr& type_info, std::unique_ptr<InvertedIndexWriter>* res);
+
+    InvertedIndexWriter() = default;
+
+    void add_values(const void* values, size_t count);
+
+    void add_nulls(uint32_t count) { _rid += count; }
+
+    Status finish(fs::WritableBlock* wblock, ColumnIndexMetaPB* index_meta);
+
+    uint64_t size() const { return _terms_bytes + _num_postings * sizeof(rowid_t); }
+
+private:
+    InvertedIndexWriter(const InvertedIndexWriter&) = delete;
+    const InvertedIndexWriter& operator=(const InvertedIndexWriter&) = delete;
+
+    rowid_t _rid = 0;
+    // distinct term to the rows containing it
+    std::map<std::string, Roaring> _postings;
+    // estimated memory usage
+    uint64_t _terms_bytes = 0;
+    uint64_t _num_postings = 0;
+};
+
+} // namespace starrocks
@@ -31,7 +31,8 @@
 
 namespace starrocks::vectorized {
 class Column;
-}
+class ColumnPredicate;
+} // namespace starrocks::vectorized
 
 namespace starrocks {
 
@@ -101,6 +102,15 @@ public:
         return Status::NotSupported("PageDecoder Not Support");
     }
 
+    // Evaluate |pred| on the values in [from, to) of the page without decoding them into a column,
+    // set selection[i - from] to 1 if the i-th value matches, otherwise 0.
+    // The position of the decoder is not changed.
+    //
+    // Return Status::NotSupported if the predicate can't be evaluated on the encoded values.
+    virtual Status evaluate(const vectorized::ColumnPredicate& pred, size_t from, size_t to, uint8_t* selection) {
+        return Status::NotSupported("evaluate() not supported");
+    }
+
     // Return the number of elements in this page.
     virtual size_t count() const = 0;
 
@@ -223,6 +223,16 @@ public:
         return Status::OK();
     }
 
+    // The positions of the values in the data page are shifted by the NULL records, only the pages
+    // without NULL are supported.
+    Status evaluate(const vectorized::ColumnPredicate& pred, ordinal_t from, ordinal_t to,
+                    uint8_t* selection) override {
+        if (_has_null) {
+            return Status::NotSupported("evaluate() on page with null");
+        }
+        return _data_decoder->evaluate(pred, from, to, selection);
+    }
+
 private:
     friend Status parse_page_v1(std::unique_ptr<ParsedPage>* result, PageHandle handle, const Slice& body,
                                 const DataPageFooterPB& footer, const EncodingInfo* encoding,
@@ -337,6 +347,18 @@ public:
         return Status::OK();
     }
 
+    Status evaluate(const vectorized::ColumnPredicate& pred, ordinal_t from, ordinal_t to,
+                    uint8_t* selection) override {
+        RETURN_IF_ERROR(_data_decoder->evaluate(pred, from, to, selection));
+        if (_null_flags.size() > 0) {
+            const uint8_t* null_flags = _null_flags.data() + from;
+            for (size_t i = 0; i < to - from; i++) {
+                selection[i] &= !null_flags[i];
+            }
+        }
+        return Status::OK();
+    }
+
 private:
     friend Status parse_page_v2(std::unique_ptr<ParsedPage>* result, PageHandle handle, const Slice& body,
                                 const DataPageFooterPB& footer, const EncodingInfo* encoding,
@@ -35,7 +35,8 @@ class Status;
 
 namespace vectorized {
 class Column;
-}
+class ColumnPredicate;
+} // namespace vectorized
 
 class DataPageFooterPB;
 class EncodingInfo;
@@ -111,6 +112,14 @@ public:
 
     virtual Status read_dict_codes(vectorized::Column* column, const vectorized::SparseRange& range) = 0;
 
+    // Evaluate |pred| on the encoded records in [from, to) of this page, see `PageDecoder::evaluate`.
+    // The |from| and |to| are relative to first_ordinal(), NULL records never match.
+    // The page offset is not changed.
+    virtual Status evaluate(const vectorized::ColumnPredicate& pred, ordinal_t from, ordinal_t to,
+                            uint8_t* selection) {
+        return Status::NotSupported("evaluate() not supported");
+    }
+
 protected:
     uint32_t _page_index{0};
     uint64_t _num_rows{0};
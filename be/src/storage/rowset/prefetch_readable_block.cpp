@@ -0,0 +1,91 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "storage/rowset/prefetch_readable_block.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "util/runtime_profile.h"
+
+namespace starrocks {
+
+Status PrefetchReadableBlock::prefetch(std::vector<PagePointer> pages, size_t max_gap_bytes, size_t max_bytes) {
+    _buffers.clear();
+    std::sort(pages.begin(), pages.end(),
+              [](const PagePointer& lhs, const PagePointer& rhs) { return lhs.offset < rhs.offset; });
+    pages.erase(std::unique(pages.begin(), pages.end()), pages.end());
+
+    size_t total_bytes = 0;
+    size_t i = 0;
+    while (i < pages.size() && total_bytes < max_bytes) {
+        // merge the following pages into [begin, end)
+        uint64_t begin = pages[i].offset;
+        uint64_t end = begin + pages[i].size;
+        size_t num_pages = 1;
+        for (i++; i < pages.size() && pages[i].offset <= end + max_gap_bytes; i++) {
+            if (total_bytes + std::max<uint64_t>(end, pages[i].offset + pages[i].size) - begin > max_bytes) {
+                break;
+            }
+            end = std::max<uint64_t>(end, pages[i].offset + pages[i].size);
+            num_pages++;
+        }
+        if (num_pages == 1) {
+            // nothing to coalesce, leave it to the normal read
+            continue;
+        }
+        Buffer buffer{end - begin, std::unique_ptr<char[]>(new char[end - begin])};
+        {
+            SCOPED_RAW_TIMER(&_stats->io_ns);
+            RETURN_IF_ERROR(_block->read(begin, Slice(buffer.data.get(), buffer.size)));
+        }
+        total_bytes += buffer.size;
+        _stats->prefetch_io_count++;
+        _stats->prefetch_pages += num_pages;
+        _stats->prefetch_bytes += buffer.size;
+        _buffers.emplace(begin, std::move(buffer));
+    }
+    return Status::OK();
+}
+
+const char* PrefetchReadableBlock::_find(uint64_t offset, size_t size) const {
+    auto iter = _buffers.upper_bound(offset);
+    if (iter == _buffers.begin()) {
+        return nullptr;
+    }
+    --iter;
+    if (offset + size > iter->first + iter->second.size) {
+        return nullptr;
+    }
+    return iter->second.data.get() + (offset - iter->first);
+}
+
+Status PrefetchReadableBlock::read(uint64_t offset, Slice result) const {
+    const char* data = _find(offset, result.size);
+    if (data == nullptr) {
+        return _block->read(offset, result);
+    }
+    memcpy(result.data, data, result.size);
+    _stats->prefetch_hit_pages++;
+    _stats->prefetch_hit_bytes += result.size;
+    return Status::OK();
+}
+
+Status PrefetchReadableBlock::readv(uint64_t offset, const Slice* res, size_t res_cnt) const {
+    size_t size = 0;
+    for (size_t i = 0; i < res_cnt; i++) {
+        size += res[i].size;
+    }
+    const char* data = _find(offset, size);
+    if (data == nullptr) {
+        return _block->readv(offset, res, res_cnt);
+    }
+    for (size_t i = 0; i < res_cnt; i++) {
+        memcpy(res[i].data, data, res[i].size);
+        data += res[i].size;
+    }
+    _stats->prefetch_hit_pages++;
+    _stats->prefetch_hit_bytes += size;
+    return Status::OK();
+}
+
+} // namespace starrocks
@@ -0,0 +1,65 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "storage/fs/block_manager.h"
+#include "storage/olap_common.h"
+#include "storage/rowset/page_pointer.h"
+
+namespace starrocks {
+
+// A ReadableBlock serving the reads of the pages prefetched from |_block|.
+//
+// Instead of reading the pages of many columns one by one, the pages to be read soon are sorted by
+// offset, and the adjacent ones (with gap no larger than |max_gap_bytes|) are read by one IO.
+// Reads not covered by the prefetched pages are forwarded to |_block|.
+// Not thread-safe.
+class PrefetchReadableBlock final : public fs::ReadableBlock {
+public:
+    // |block| and |stats| are not owned by this object.
+    PrefetchReadableBlock(fs::ReadableBlock* block, OlapReaderStatistics* stats)
+            : _block(block), _stats(stats) {}
+
+    ~PrefetchReadableBlock() override = default;
+
+    // Read |pages| with as few IOs as possible, the pages prefetched before are released.
+    // The pages beyond |max_bytes| are not prefetched.
+    Status prefetch(std::vector<PagePointer> pages, size_t max_gap_bytes, size_t max_bytes);
+
+    // Release the pages prefetched.
+    void reset() { _buffers.clear(); }
+
+    Status close() override { return _block->close(); }
+
+    fs::BlockManager* block_manager() const override { return _block->block_manager(); }
+
+    const BlockId& id() const override { return _block->id(); }
+
+    const std::string& path() const override { return _block->path(); }
+
+    Status size(uint64_t* sz) const override { return _block->size(sz); }
+
+    Status read(uint64_t offset, Slice result) const override;
+
+    Status readv(uint64_t offset, const Slice* res, size_t res_cnt) const override;
+
+private:
+    struct Buffer {
+        uint64_t size;
+        std::unique_ptr<char[]> data;
+    };
+
+    // return the buffer containing [offset, offset + size), or nullptr
+    const char* _find(uint64_t offset, size_t size) const;
+
+    fs::ReadableBlock* _block;
+    OlapReaderStatistics* _stats;
+    // offset => prefetched bytes
+    std::map<uint64_t, Buffer> _buffers;
+};
+
+} // namespace starrocks
@@ -326,13 +326,18 @@ Status ScalarColumnIterator::get_row_ranges_by_zone_map(
 
 Status ScalarColumnIterator::get_row_ranges_by_bloom_filter(
         const std::vector<const vectorized::ColumnPredicate*>& predicates, vectorized::SparseRange* row_ranges) {
-    RETURN_IF(!_reader->has_bloom_filter_index(), Status::OK());
     bool support = false;
+    bool support_ngram = false;
     for (const auto* pred : predicates) {
         support = support | pred->support_bloom_filter();
+        support_ngram = support_ngram | pred->support_ngram_bloom_filter();
+    }
+    if (support && _reader->has_bloom_filter_index()) {
+        RETURN_IF_ERROR(_reader->bloom_filter(predicates, row_ranges));
+    }
+    if (support_ngram && _reader->has_ngram_bloom_filter_index()) {
+        RETURN_IF_ERROR(_reader->ngram_bloom_filter(predicates, row_ranges));
     }
-    RETURN_IF(!support, Status::OK());
-    RETURN_IF_ERROR(_reader->bloom_filter(predicates, row_ranges));
     return Status::OK();
 }
 
@@ -528,6 +533,57 @@ Status ScalarColumnIterator::fetch_dict_codes_by_rowid(const rowid_t* rowids, si
     return _fetch_by_rowid(rowids, size, values, page_parse);
 }
 
+Status ScalarColumnIterator::get_data_page_pointers(const vectorized::SparseRange& range,
+                                                    std::vector<PagePointer>* pages) {
+    int32_t last_page_index = _page != nullptr ? static_cast<int32_t>(_page->page_index()) : -1;
+    for (size_t i = 0; i < range.size(); i++) {
+        const vectorized::Range& r = range[i];
+        OrdinalPageIndexIterator iter;
+        RETURN_IF_ERROR(_reader->seek_at_or_before(r.begin(), &iter));
+        for (; iter.valid() && iter.first_ordinal() < r.end(); iter.next()) {
+            // the ranges are sorted, so a page shared by adjacent ranges is always the last one
+            if (iter.page_index() != last_page_index) {
+                pages->emplace_back(iter.page());
+                last_page_index = iter.page_index();
+            }
+        }
+    }
+    return Status::OK();
+}
+
+Status ScalarColumnIterator::evaluate_on_encoded_pages(const vectorized::ColumnPredicate& pred,
+                                                       vectorized::SparseRange* range) {
+    vectorized::SparseRange result;
+    std::vector<uint8_t> selection;
+    for (size_t i = 0; i < range->size(); i++) {
+        const vectorized::Range& r = (*range)[i];
+        ordinal_t ord = r.begin();
+        while (ord < r.end()) {
+            RETURN_IF_ERROR(seek_to_ordinal(ord));
+            const ordinal_t from = ord - _page->first_ordinal();
+            const ordinal_t to = std::min<ordinal_t>(r.end() - _page->first_ordinal(), _page->num_rows());
+            const size_t n = to - from;
+            selection.resize(n);
+            RETURN_IF_ERROR(_page->evaluate(pred, from, to, selection.data()));
+            // convert the runs of selected rows into ranges
+            size_t j = 0;
+            while (j < n) {
+                while (j < n && !selection[j]) {
+                    j++;
+                }
+                size_t start = j;
+                while (j < n && selection[j]) {
+                    j++;
+                }
+                result.add(vectorized::Range(ord + start, ord + j));
+            }
+            ord += n;
+        }
+    }
+    *range = std::move(result);
+    return Status::OK();
+}
+
 int ScalarColumnIterator::dict_size() {
     if (_reader->column_type() == OLAP_FIELD_TYPE_CHAR) {
         auto dict = down_cast<BinaryPlainPageDecoder<OLAP_FIELD_TYPE_CHAR>*>(_dict_decoder.get());
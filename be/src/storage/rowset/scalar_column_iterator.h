@@ -75,6 +75,10 @@ public:
 
     Status fetch_dict_codes_by_rowid(const rowid_t* rowids, size_t size, vectorized::Column* values) override;
 
+    Status get_data_page_pointers(const vectorized::SparseRange& range, std::vector<PagePointer>* pages) override;
+
+    Status evaluate_on_encoded_pages(const vectorized::ColumnPredicate& pred, vectorized::SparseRange* range) override;
+
     ParsedPage* get_current_page() { return _page.get(); }
 
     bool is_nullable();
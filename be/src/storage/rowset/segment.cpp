@@ -34,6 +34,7 @@
 #include "column/schema.h"
 #include "common/logging.h"
 #include "gutil/strings/substitute.h"
+#include "storage/delta_column_group.h"
 #include "storage/fs/fs_util.h"
 #include "storage/rowset/column_reader.h"
 #include "storage/rowset/default_value_column_iterator.h"
@@ -42,7 +43,9 @@
 #include "storage/rowset/vectorized/segment_chunk_iterator_adapter.h"
 #include "storage/rowset/vectorized/segment_iterator.h"
 #include "storage/rowset/vectorized/segment_options.h"
+#include "storage/storage_engine.h"
 #include "storage/tablet_schema.h"
+#include "storage/update_manager.h"
 #include "storage/vectorized/type_utils.h"
 #include "util/crc32c.h"
 #include "util/slice.h"
@@ -184,12 +187,28 @@ Status Segment::_open(MemTracker* mem_tracker, size_t* footer_length_hint,
 StatusOr<ChunkIteratorPtr> Segment::_new_iterator(const vectorized::Schema& schema,
                                                   const vectorized::SegmentReadOptions& read_options) {
     DCHECK(read_options.stats != nullptr);
+    // the segment-level zone maps don't cover the values updated by column mode partial updates.
+    std::vector<uint32_t> updated_columns;
+    if (read_options.is_primary_keys && read_options.version > 0) {
+        TabletSegmentId tsid;
+        tsid.tablet_id = read_options.tablet_id;
+        tsid.segment_id = read_options.rowset_id + id();
+        DeltaColumnGroupList dcgs;
+        RETURN_IF_ERROR(StorageEngine::instance()->update_manager()->get_delta_column_groups(
+                read_options.meta, tsid, read_options.version, &dcgs));
+        for (const auto& dcg : dcgs) {
+            updated_columns.insert(updated_columns.end(), dcg->column_ids().begin(), dcg->column_ids().end());
+        }
+    }
     // trying to prune the current segment by segment-level zone map
     for (const auto& pair : read_options.predicates) {
         ColumnId column_id = pair.first;
         if (_column_readers[column_id] == nullptr || !_column_readers[column_id]->has_zone_map()) {
             continue;
         }
+        if (std::find(updated_columns.begin(), updated_columns.end(), column_id) != updated_columns.end()) {
+            continue;
+        }
         if (!_column_readers[column_id]->segment_zone_map_filter(pair.second)) {
             read_options.stats->segment_stats_filtered += _column_readers[column_id]->num_rows();
             return Status::EndOfFile(strings::Substitute("End of file $0, empty iterator", _fname));
@@ -334,4 +353,11 @@ Status Segment::new_bitmap_index_iterator(uint32_t cid, BitmapIndexIterator** it
     return Status::OK();
 }
 
+Status Segment::new_inverted_index_iterator(uint32_t cid, BitmapIndexIterator** iter) {
+    if (_column_readers[cid] != nullptr && _column_readers[cid]->has_inverted_index()) {
+        return _column_readers[cid]->new_inverted_index_iterator(iter);
+    }
+    return Status::OK();
+}
+
 } // namespace starrocks
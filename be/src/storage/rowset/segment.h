@@ -103,6 +103,9 @@ public:
 
     Status new_bitmap_index_iterator(uint32_t cid, BitmapIndexIterator** iter);
 
+    // |*iter| is left unchanged if column |cid| has no inverted index.
+    Status new_inverted_index_iterator(uint32_t cid, BitmapIndexIterator** iter);
+
     size_t num_short_keys() const { return _tablet_schema->num_short_key_columns(); }
 
     uint32_t num_rows_per_block() const {
@@ -131,6 +134,8 @@ public:
 
     const std::string& file_name() const { return _fname; }
 
+    const TabletSchema& tablet_schema() const { return *_tablet_schema; }
+
     size_t num_columns() const { return _column_readers.size(); }
 
     const ColumnReader* column(size_t i) const { return _column_readers[i].get(); }
@@ -26,6 +26,7 @@
 #include "column/chunk.h"
 #include "column/datum_tuple.h"
 #include "column/nullable_column.h"
+#include "common/config.h"
 #include "common/logging.h" // LOG
 #include "env/env.h"        // Env
 #include "gen_cpp/segment.pb.h"
@@ -57,7 +58,12 @@ void SegmentWriter::_init_column_meta(ColumnMetaPB* meta, uint32_t column_id, co
     meta->set_unique_id(column.unique_id());
     meta->set_type(column.type());
     meta->set_length(column.length());
-    meta->set_encoding(DEFAULT_ENCODING);
+    if (config::enable_lightweight_float_encoding &&
+        (column.type() == OLAP_FIELD_TYPE_FLOAT || column.type() == OLAP_FIELD_TYPE_DOUBLE)) {
+        meta->set_encoding(ALP_ENCODING);
+    } else {
+        meta->set_encoding(DEFAULT_ENCODING);
+    }
     meta->set_compression(LZ4_FRAME);
     meta->set_is_nullable(column.is_nullable());
 
@@ -139,11 +145,13 @@ Status SegmentWriter::init(const std::vector<uint32_t>& column_indexes, bool has
         }
         opts.need_bloom_filter = column.is_bf_column();
         opts.need_bitmap_index = column.has_bitmap_index();
+        opts.need_ngram_bloom_filter = column.has_ngram_bf_index();
+        opts.need_inverted_index = column.has_inverted_index();
         if (column.type() == FieldType::OLAP_FIELD_TYPE_ARRAY) {
-            if (opts.need_bloom_filter) {
+            if (opts.need_bloom_filter || opts.need_ngram_bloom_filter) {
                 return Status::NotSupported("Do not support bloom filter for array type");
             }
-            if (opts.need_bitmap_index) {
+            if (opts.need_bitmap_index || opts.need_inverted_index) {
                 return Status::NotSupported("Do not support bitmap index for array type");
             }
         }
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <limits>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -9,6 +10,7 @@
 #include "runtime/global_dicts.h"
 #include "storage/fs/fs_util.h"
 #include "storage/olap_common.h"
+#include "storage/vectorized/runtime_filter_predicate.h"
 #include "storage/vectorized/seek_range.h"
 
 namespace starrocks {
@@ -38,8 +40,14 @@ public:
 
     std::vector<SeekRange> ranges;
 
+    // Only the segments in [segment_begin, segment_end) of the rowset are read.
+    uint32_t segment_begin = 0;
+    uint32_t segment_end = std::numeric_limits<uint32_t>::max();
+
     std::unordered_map<ColumnId, PredicateList> predicates;
 
+    RuntimeFilterPredicates runtime_filter_preds;
+
     // whether rowset should return rows in sorted order.
     bool sorted = true;
 
@@ -19,13 +19,17 @@
 #include "runtime/external_scan_context_mgr.h"
 #include "simd/simd.h"
 #include "storage/del_vector.h"
+#include "storage/delta_column_group.h"
 #include "storage/fs/fs_util.h"
+#include "storage/page_cache.h"
 #include "storage/rowset/bitmap_index_reader.h"
 #include "storage/rowset/column_decoder.h"
 #include "storage/rowset/column_reader.h"
 #include "storage/rowset/common.h"
 #include "storage/rowset/default_value_column_iterator.h"
+#include "storage/rowset/delta_column_iterator.h"
 #include "storage/rowset/dictcode_column_iterator.h"
+#include "storage/rowset/prefetch_readable_block.h"
 #include "storage/rowset/scalar_column_iterator.h"
 #include "storage/rowset/segment.h"
 #include "storage/rowset/vectorized/rowid_column_iterator.h"
@@ -41,6 +45,8 @@
 #include "storage/vectorized/projection_iterator.h"
 #include "storage/vectorized/range.h"
 #include "storage/vectorized/roaring2range.h"
+#include "storage/vectorized/runtime_filter_predicate.h"
+#include "util/path_util.h"
 #include "util/slice.h"
 #include "util/starrocks_metrics.h"
 
@@ -71,6 +77,15 @@ static int compare(const SeekTuple& tuple, const Chunk& chunk) {
     return 0;
 }
 
+static int field_index_by_id(const Schema& schema, ColumnId cid) {
+    for (size_t i = 0; i < schema.num_fields(); i++) {
+        if (schema.field(i)->id() == cid) {
+            return i;
+        }
+    }
+    return -1;
+}
+
 /// SegmentIterator
 // TODO(zhuming): Refine the implementation of this class to reduce the intellectual overhead.
 // Too many policies encapsulated in this class, should split this class into many small classes.
@@ -177,6 +192,7 @@ private:
     Status _get_row_ranges_by_keys();
     Status _get_row_ranges_by_zone_map();
     Status _get_row_ranges_by_bloom_filter();
+    Status _get_row_ranges_by_runtime_filters();
 
     uint32_t segment_id() const { return _segment->id(); }
     uint32_t num_rows() const { return _segment->num_rows(); }
@@ -187,6 +203,7 @@ private:
 
     uint16_t _filter(Chunk* chunk, vector<rowid_t>* rowid, uint16_t from, uint16_t to);
     uint16_t _filter_by_expr_predicates(Chunk* chunk, vector<rowid_t>* rowid);
+    size_t _filter_by_runtime_filters(ScanContext* ctx, vector<rowid_t>* rowid);
 
     void _init_column_predicates();
 
@@ -222,10 +239,19 @@ private:
 
     Status _apply_bitmap_index();
 
+    // Narrow |_scan_range| to the rows whose terms match the predicates supporting inverted index.
+    Status _apply_inverted_index();
+
     Status _apply_del_vector();
 
     Status _read(Chunk* chunk, vector<rowid_t>* rowid, size_t n);
 
+    // Prefetch the data pages of the next few chunks of |_context| if they're not prefetched yet.
+    Status _prefetch_pages();
+
+    // Remove the rows not matching |_encoded_preds| from |range| by evaluating them on the encoded pages.
+    Status _evaluate_encoded_predicates(SparseRange* range);
+
     Status _read_by_column(size_t n, Chunk* result, vector<rowid_t>* rowids);
 
 private:
@@ -240,8 +266,17 @@ private:
     DelVectorPtr _del_vec;
     roaring_uint32_iterator_t _roaring_iter;
 
+    // the merged values of the columns of |_schema| updated by column mode partial updates.
+    std::map<ColumnId, DeltaColumnValues> _delta_columns;
+
     // block for file to read
     std::unique_ptr<fs::ReadableBlock> _rblock;
+    // wraps |_rblock| to serve the page reads of column iterators from coalesced reads, nullptr if
+    // the prefetch is disabled.
+    std::unique_ptr<PrefetchReadableBlock> _prefetch_block;
+    // the context and the end rowid of the pages prefetched
+    ScanContext* _prefetch_context = nullptr;
+    rowid_t _prefetch_end = 0;
 
     SparseRange _scan_range;
     SparseRangeIterator _range_iter;
@@ -249,6 +284,13 @@ private:
     std::vector<const ColumnPredicate*> _vectorized_preds;
     std::vector<const ColumnPredicate*> _branchless_preds;
     std::vector<const ColumnPredicate*> _expr_ctx_preds; // predicates using ExprContext*
+    // the predicates of |_vectorized_preds| evaluated on the encoded pages before reading the columns,
+    // a predicate is removed once some page of its column can't be evaluated encoded.
+    std::vector<const ColumnPredicate*> _encoded_preds;
+    // the predicates of |_encoded_preds| applied to the rows read by the last `_read`, and the predicates of
+    // |_vectorized_preds| left to `_filter`.
+    std::vector<const ColumnPredicate*> _applied_encoded_preds;
+    std::vector<const ColumnPredicate*> _unapplied_vectorized_preds;
     // _selection is used to accelerate
     Buffer<uint8_t> _selection;
 
@@ -268,6 +310,13 @@ private:
 
     // initial size of |_opts.predicates|.
     int _predicate_columns = 0;
+    // the number of leading fields of |_schema| which are read before late materialization, i.e, the
+    // columns with predicates, followed by the columns with runtime filters.
+    int _early_materialize_columns = 0;
+
+    // the runtime filters not arrived yet, and the arrived ones whose bloom filters are probed.
+    std::vector<const RuntimeFilterPredicate*> _pending_runtime_filters;
+    std::vector<const RuntimeFilterPredicate*> _runtime_filters;
 
     // the next rowid to read
     rowid_t _cur_rowid = 0;
@@ -283,7 +332,21 @@ SegmentIterator::SegmentIterator(std::shared_ptr<Segment> segment, vectorized::S
         : ChunkIterator(std::move(schema), options.chunk_size),
           _segment(std::move(segment)),
           _opts(std::move(options)),
-          _predicate_columns(_opts.predicates.size()) {}
+          _predicate_columns(_opts.predicates.size()) {
+    _early_materialize_columns = _predicate_columns;
+    for (const RuntimeFilterPredicate* rf : _opts.runtime_filter_preds) {
+        const ColumnId cid = rf->column_id();
+        if (field_index_by_id(_schema, cid) < 0) {
+            continue;
+        }
+        if (!_opts.predicates.count(cid) &&
+            std::none_of(_pending_runtime_filters.begin(), _pending_runtime_filters.end(),
+                         [cid](const RuntimeFilterPredicate* p) { return p->column_id() == cid; })) {
+            _early_materialize_columns++;
+        }
+        _pending_runtime_filters.emplace_back(rf);
+    }
+}
 
 Status SegmentIterator::_init() {
     SCOPED_RAW_TIMER(&_opts.stats->segment_init_ns);
@@ -305,6 +368,17 @@ Status SegmentIterator::_init() {
                     << " " << _del_vec->cardinality() << "/" << _segment->num_rows();
             roaring_init_iterator(&_del_vec->roaring()->roaring, &_roaring_iter);
         }
+        DeltaColumnGroupList dcgs;
+        RETURN_IF_ERROR(StorageEngine::instance()->update_manager()->get_delta_column_groups(_opts.meta, tsid,
+                                                                                             _opts.version, &dcgs));
+        if (!dcgs.empty()) {
+            std::vector<uint32_t> cids;
+            for (const FieldPtr& f : _schema.fields()) {
+                cids.push_back(f->id());
+            }
+            RETURN_IF_ERROR(load_delta_column_values(path_util::dir_name(_segment->file_name()),
+                                                     _segment->tablet_schema(), dcgs, cids, &_delta_columns));
+        }
     }
 
     _selection.resize(_opts.chunk_size);
@@ -312,6 +386,9 @@ Status SegmentIterator::_init() {
     StarRocksMetrics::instance()->segment_read_total.increment(1);
     // get file handle from file descriptor of segment
     RETURN_IF_ERROR(_opts.block_mgr->open_block(_segment->file_name(), &_rblock));
+    if (config::column_page_prefetch_chunks > 0) {
+        _prefetch_block = std::make_unique<PrefetchReadableBlock>(_rblock.get(), _opts.stats);
+    }
 
     /// the calling order matters, do not change unless you know why.
 
@@ -326,8 +403,10 @@ Status SegmentIterator::_init() {
     RETURN_IF_ERROR(_get_row_ranges_by_keys());
     RETURN_IF_ERROR(_apply_del_vector());
     RETURN_IF_ERROR(_apply_bitmap_index());
+    RETURN_IF_ERROR(_apply_inverted_index());
     RETURN_IF_ERROR(_get_row_ranges_by_zone_map());
     RETURN_IF_ERROR(_get_row_ranges_by_bloom_filter());
+    RETURN_IF_ERROR(_get_row_ranges_by_runtime_filters());
     // rewrite stage
     // Rewriting predicates using segment dictionary codes
     _rewrite_predicates();
@@ -373,11 +452,17 @@ Status SegmentIterator::_init_column_iterators(const Schema& schema) {
             ColumnIteratorOptions iter_opts;
             iter_opts.stats = _opts.stats;
             iter_opts.use_page_cache = _opts.use_page_cache;
-            iter_opts.rblock = _rblock.get();
+            iter_opts.rblock = _prefetch_block != nullptr ? _prefetch_block.get() : _rblock.get();
             iter_opts.check_dict_encoding = check_dict_enc;
             iter_opts.reader_type = _opts.reader_type;
             RETURN_IF_ERROR(_column_iterators[cid]->init(iter_opts));
 
+            auto delta = _delta_columns.find(cid);
+            if (delta != _delta_columns.end()) {
+                _column_iterators[cid] = _obj_pool.add(new DeltaColumnIterator(
+                        _column_iterators[cid], _segment->num_rows(), delta->second.rowids, delta->second.values));
+            }
+
             if constexpr (check_global_dict) {
                 _column_decoders[cid].set_iterator(_column_iterators[cid]);
                 _column_decoders[cid].set_all_page_dict_encoded(_column_iterators[cid]->all_page_dict_encoded());
@@ -415,6 +500,20 @@ void SegmentIterator::_init_column_predicates() {
     if (_vectorized_preds.empty() && _branchless_preds.empty()) {
         _opts.predicates.clear();
     }
+    if (config::enable_encoded_predicate_evaluation) {
+        for (const ColumnPredicate* pred : _vectorized_preds) {
+            const PredicateType type = pred->type();
+            const FieldType field_type = pred->type_info()->type();
+            bool is_cmp = type == PredicateType::kEQ || type == PredicateType::kNE || type == PredicateType::kGT ||
+                          type == PredicateType::kGE || type == PredicateType::kLT || type == PredicateType::kLE;
+            bool is_integer = field_type == OLAP_FIELD_TYPE_TINYINT || field_type == OLAP_FIELD_TYPE_SMALLINT ||
+                              field_type == OLAP_FIELD_TYPE_INT || field_type == OLAP_FIELD_TYPE_BIGINT;
+            // the rewritten predicates are evaluated on the dictionary codes
+            if (is_cmp && is_integer && !_predicate_need_rewrite[pred->column_id()]) {
+                _encoded_preds.emplace_back(pred);
+            }
+        }
+    }
 }
 
 Status SegmentIterator::_get_row_ranges_by_keys() {
@@ -598,10 +697,20 @@ inline Status SegmentIterator::_read(Chunk* chunk, vector<rowid_t>* rowids, size
         RETURN_IF_ERROR(_context->seek_columns(_cur_rowid));
     }
 
+    {
+        SCOPED_RAW_TIMER(&_opts.stats->block_fetch_ns);
+        RETURN_IF_ERROR(_prefetch_pages());
+    }
+
     _range_iter.next_range(n, &range);
     read_num += range.span_size();
 
-    {
+    _applied_encoded_preds.clear();
+    if (!_encoded_preds.empty()) {
+        RETURN_IF_ERROR(_evaluate_encoded_predicates(&range));
+    }
+
+    if (!range.empty()) {
         _opts.stats->blocks_load += 1;
         SCOPED_RAW_TIMER(&_opts.stats->block_fetch_ns);
         RETURN_IF_ERROR(_context->read_columns(chunk, range));
@@ -624,6 +733,71 @@ inline Status SegmentIterator::_read(Chunk* chunk, vector<rowid_t>* rowids, size
     return Status::OK();
 }
 
+Status SegmentIterator::_evaluate_encoded_predicates(SparseRange* range) {
+    SCOPED_RAW_TIMER(&_opts.stats->vec_cond_evaluate_ns);
+    const size_t num_rows = range->span_size();
+    bool evaluated = false;
+    for (size_t i = 0; i < _encoded_preds.size() && !range->empty();) {
+        const ColumnPredicate* pred = _encoded_preds[i];
+        Status st = _column_iterators[pred->column_id()]->evaluate_on_encoded_pages(*pred, range);
+        evaluated = true;
+        if (st.is_not_supported()) {
+            _encoded_preds.erase(_encoded_preds.begin() + i);
+            continue;
+        }
+        RETURN_IF_ERROR(st);
+        _applied_encoded_preds.emplace_back(pred);
+        i++;
+    }
+    if (_applied_encoded_preds.empty()) {
+        // the column iterators may have been moved by the unsupported evaluations
+        return evaluated && !range->empty() ? _context->seek_columns(range->begin()) : Status::OK();
+    }
+
+    _unapplied_vectorized_preds.clear();
+    for (const ColumnPredicate* pred : _vectorized_preds) {
+        if (std::find(_applied_encoded_preds.begin(), _applied_encoded_preds.end(), pred) ==
+            _applied_encoded_preds.end()) {
+            _unapplied_vectorized_preds.emplace_back(pred);
+        }
+    }
+    const size_t filtered = num_rows - range->span_size();
+    _opts.stats->rows_encoded_pred_filtered += filtered;
+    _opts.stats->rows_vec_cond_filtered += filtered;
+    if (!range->empty()) {
+        RETURN_IF_ERROR(_context->seek_columns(range->begin()));
+    }
+    return Status::OK();
+}
+
+Status SegmentIterator::_prefetch_pages() {
+    if (_prefetch_block == nullptr || !_range_iter.has_more()) {
+        return Status::OK();
+    }
+    if (_context == _prefetch_context && _range_iter.begin() < _prefetch_end) {
+        return Status::OK();
+    }
+    SparseRange range;
+    SparseRangeIterator iter(_range_iter);
+    iter.next_range(static_cast<size_t>(config::column_page_prefetch_chunks) * _opts.chunk_size, &range);
+
+    std::vector<PagePointer> pages;
+    for (ColumnIterator* column_iter : _context->_column_iterators) {
+        RETURN_IF_ERROR(column_iter->get_data_page_pointers(range, &pages));
+    }
+    if (_opts.use_page_cache) {
+        auto* cache = StoragePageCache::instance();
+        auto cached = [&](const PagePointer& pp) {
+            return cache->contains(StoragePageCache::CacheKey(_rblock->path(), pp.offset));
+        };
+        pages.erase(std::remove_if(pages.begin(), pages.end(), cached), pages.end());
+    }
+    _prefetch_context = _context;
+    _prefetch_end = range.end();
+    return _prefetch_block->prefetch(std::move(pages), config::column_page_prefetch_max_gap_bytes,
+                                     config::column_page_prefetch_max_bytes);
+}
+
 Status SegmentIterator::do_get_next(Chunk* chunk) {
     if (!_inited) {
         RETURN_IF_ERROR(_init());
@@ -658,6 +832,9 @@ Status SegmentIterator::_do_get_next(Chunk* result, vector<rowid_t>* rowid) {
     MonotonicStopWatch sw;
     sw.start();
 
+    // Take the runtime filters arrived since the last chunk.
+    RETURN_IF_ERROR(_get_row_ranges_by_runtime_filters());
+
     uint16_t chunk_start = 0;
     const uint32_t chunk_capacity = _opts.chunk_size;
     const bool has_predicate = !_opts.predicates.empty();
@@ -704,6 +881,11 @@ Status SegmentIterator::_do_get_next(Chunk* result, vector<rowid_t>* rowid) {
         RETURN_IF_ERROR(_decode_dict_codes(_context));
     }
 
+    if (!_runtime_filters.empty()) {
+        SCOPED_RAW_TIMER(&_opts.stats->vec_cond_evaluate_ns);
+        chunk_size = _filter_by_runtime_filters(_context, rowid);
+    }
+
     _build_final_chunk(_context);
     chunk = _context->_final_chunk.get();
 
@@ -812,16 +994,22 @@ uint16_t SegmentIterator::_filter(Chunk* chunk, vector<rowid_t>* rowid, uint16_t
 
     SCOPED_RAW_TIMER(&_opts.stats->vec_cond_ns);
 
-    // first evaluate
+    // first evaluate, skip the predicates applied on the encoded pages already
     if (!_vectorized_preds.empty()) {
         SCOPED_RAW_TIMER(&_opts.stats->vec_cond_evaluate_ns);
-        const ColumnPredicate* pred = _vectorized_preds[0];
-        Column* c = chunk->get_column_by_id(pred->column_id()).get();
-        pred->evaluate(c, _selection.data(), from, to);
-        for (int i = 1; i < _vectorized_preds.size(); ++i) {
-            pred = _vectorized_preds[i];
-            c = chunk->get_column_by_id(pred->column_id()).get();
-            pred->evaluate_and(c, _selection.data(), from, to);
+        const std::vector<const ColumnPredicate*>& preds =
+                _applied_encoded_preds.empty() ? _vectorized_preds : _unapplied_vectorized_preds;
+        if (preds.empty()) {
+            memset(&_selection[from], 1, to - from);
+        } else {
+            const ColumnPredicate* pred = preds[0];
+            Column* c = chunk->get_column_by_id(pred->column_id()).get();
+            pred->evaluate(c, _selection.data(), from, to);
+            for (int i = 1; i < preds.size(); ++i) {
+                pred = preds[i];
+                c = chunk->get_column_by_id(pred->column_id()).get();
+                pred->evaluate_and(c, _selection.data(), from, to);
+            }
         }
     }
 
@@ -927,7 +1115,7 @@ bool SegmentIterator::_can_using_global_dict(const FieldPtr& field) const {
 
 template <bool late_materialization>
 Status SegmentIterator::_build_context(ScanContext* ctx) {
-    const size_t predicate_count = _predicate_columns;
+    const size_t predicate_count = _early_materialize_columns;
     const size_t num_fields = _schema.num_fields();
 
     const size_t ctx_fields = late_materialization ? predicate_count + 1 : num_fields;
@@ -1044,7 +1232,7 @@ Status SegmentIterator::_init_context() {
 
     RETURN_IF_ERROR(_init_global_dict_decoder());
 
-    if (_predicate_columns == 0 || _predicate_columns >= _schema.num_fields()) {
+    if (_early_materialize_columns == 0 || _early_materialize_columns >= _schema.num_fields()) {
         // non or all field has predicate, disable late materialization.
         RETURN_IF_ERROR(_build_context<false>(&_context_list[0]));
     } else {
@@ -1235,7 +1423,8 @@ Status SegmentIterator::_init_bitmap_index_iterators() {
     _bitmap_index_iterators.resize(ChunkHelper::max_column_id(_schema) + 1, nullptr);
     for (const auto& pair : _opts.predicates) {
         ColumnId cid = pair.first;
-        if (_bitmap_index_iterators[cid] == nullptr) {
+        // the bitmap index doesn't cover the values updated by column mode partial updates.
+        if (_bitmap_index_iterators[cid] == nullptr && _delta_columns.count(cid) == 0) {
             RETURN_IF_ERROR(_segment->new_bitmap_index_iterator(cid, &_bitmap_index_iterators[cid]));
             _has_bitmap_index |= (_bitmap_index_iterators[cid] != nullptr);
         }
@@ -1338,6 +1527,38 @@ Status SegmentIterator::_apply_bitmap_index() {
     return Status::OK();
 }
 
+Status SegmentIterator::_apply_inverted_index() {
+    RETURN_IF(_scan_range.empty(), Status::OK());
+    for (auto& [cid, pred_list] : _opts.predicates) {
+        // the inverted index doesn't cover the values updated by column mode partial updates.
+        if (pred_list.empty() || _delta_columns.count(cid) > 0) {
+            continue;
+        }
+        BitmapIndexIterator* iter = nullptr;
+        RETURN_IF_ERROR(_segment->new_inverted_index_iterator(cid, &iter));
+        if (iter == nullptr) {
+            continue;
+        }
+        std::unique_ptr<BitmapIndexIterator> iter_guard(iter);
+        SCOPED_RAW_TIMER(&_opts.stats->inverted_index_filter_timer);
+        for (const ColumnPredicate* pred : pred_list) {
+            Roaring rows;
+            Status st = pred->seek_inverted_index(iter, &rows);
+            if (st.is_cancelled()) {
+                continue;
+            }
+            RETURN_IF_ERROR(st);
+            size_t input_rows = _scan_range.span_size();
+            _scan_range = _scan_range.intersection(roaring2range(rows));
+            _opts.stats->rows_inverted_index_filtered += (input_rows - _scan_range.span_size());
+            if (_scan_range.empty()) {
+                return Status::OK();
+            }
+        }
+    }
+    return Status::OK();
+}
+
 Status SegmentIterator::_apply_del_vector() {
     if (_opts.is_primary_keys && _opts.version > 0 && _del_vec && !_del_vec->empty()) {
         Roaring row_bitmap = range2roaring(_scan_range);
@@ -1361,10 +1582,98 @@ Status SegmentIterator::_get_row_ranges_by_bloom_filter() {
     return Status::OK();
 }
 
+// Prune the rows not read yet by the zone maps of the columns with newly arrived runtime filters.
+Status SegmentIterator::_get_row_ranges_by_runtime_filters() {
+    RETURN_IF(_pending_runtime_filters.empty(), Status::OK());
+    SparseRange rf_range(0, num_rows());
+    bool has_new_filter = false;
+    for (auto iter = _pending_runtime_filters.begin(); iter != _pending_runtime_filters.end();) {
+        const RuntimeFilterPredicate* rf = *iter;
+        if (!rf->is_ready()) {
+            ++iter;
+            continue;
+        }
+        std::vector<const ColumnPredicate*> preds;
+        RETURN_IF_ERROR(rf->get_zone_map_predicates(&_obj_pool, &preds));
+        if (!preds.empty()) {
+            SparseRange r;
+            RETURN_IF_ERROR(_column_iterators[rf->column_id()]->get_row_ranges_by_zone_map(preds, nullptr, &r));
+            rf_range = rf_range.intersection(r);
+        }
+        has_new_filter = true;
+        _runtime_filters.emplace_back(rf);
+        iter = _pending_runtime_filters.erase(iter);
+    }
+    RETURN_IF(!has_new_filter, Status::OK());
+
+    if (_inited) {
+        // Only the rows not read yet are pruned, i.e, the ones from the current position.
+        SparseRange remaining;
+        if (_range_iter.has_more()) {
+            remaining = _scan_range.intersection(SparseRange(_range_iter.begin(), num_rows()));
+        }
+        const size_t prev_size = remaining.span_size();
+        _scan_range = remaining.intersection(rf_range);
+        _range_iter = _scan_range.new_iterator();
+        _opts.stats->rows_stats_filtered += prev_size - _scan_range.span_size();
+    } else {
+        const size_t prev_size = _scan_range.span_size();
+        _scan_range = _scan_range.intersection(rf_range);
+        _opts.stats->rows_stats_filtered += prev_size - _scan_range.span_size();
+    }
+    return Status::OK();
+}
+
+// Probe the bloom filters of the arrived runtime filters before the other columns are late materialized.
+// Only the columns with their original types are probed, not the dictionary codes.
+size_t SegmentIterator::_filter_by_runtime_filters(ScanContext* ctx, vector<rowid_t>* rowid) {
+    Chunk* chunk = ctx->_dict_chunk.get();
+    const size_t chunk_size = chunk->num_rows();
+    if (_runtime_filters.empty() || chunk_size == 0) {
+        return chunk_size;
+    }
+    bool evaluated = false;
+    for (const RuntimeFilterPredicate* rf : _runtime_filters) {
+        const ColumnId cid = rf->column_id();
+        const int index = field_index_by_id(ctx->_dict_decode_schema, cid);
+        if (index < 0 || ctx->_dict_decode_schema.field(index)->type()->type() !=
+                                 _schema.field(field_index_by_id(_schema, cid))->type()->type()) {
+            continue;
+        }
+        if (!evaluated) {
+            memset(_selection.data(), 1, chunk_size);
+            evaluated = true;
+        }
+        rf->evaluate_and(chunk->get_column_by_index(index).get(), _selection.data());
+    }
+    if (!evaluated) {
+        return chunk_size;
+    }
+
+    size_t hit_count = SIMD::count_nonzero(_selection.data(), chunk_size);
+    size_t new_size = chunk_size;
+    if (hit_count == 0) {
+        chunk->set_num_rows(0);
+        new_size = 0;
+        if (rowid != nullptr) {
+            rowid->resize(0);
+        }
+    } else if (hit_count != chunk_size) {
+        new_size = chunk->filter_range(_selection, 0, chunk_size);
+        if (rowid != nullptr) {
+            auto size = ColumnHelper::filter_range<uint32_t>(_selection, rowid->data(), 0, chunk_size);
+            rowid->resize(size);
+        }
+    }
+    _opts.stats->rows_runtime_filter_filtered += chunk_size - new_size;
+    return new_size;
+}
+
 void SegmentIterator::close() {
     _context_list[0].close();
     _context_list[1].close();
     _obj_pool.clear();
+    _prefetch_block.reset();
     _rblock.reset();
     _segment.reset();
     _column_decoders.clear();
@@ -1377,10 +1686,15 @@ void SegmentIterator::close() {
     }
 }
 
-// put the field that has predicate on it ahead of those without one, for handle late
-// materialization easier.
-inline Schema reorder_schema(const Schema& input, const std::unordered_map<ColumnId, PredicateList>& predicates) {
+// put the field that has predicate on it ahead of those without one, and then the field that has runtime
+// filter on it, for handle late materialization easier.
+inline Schema reorder_schema(const Schema& input, const std::unordered_map<ColumnId, PredicateList>& predicates,
+                             const RuntimeFilterPredicates& runtime_filters) {
     const std::vector<FieldPtr>& fields = input.fields();
+    auto has_runtime_filter = [&](ColumnId cid) {
+        return std::any_of(runtime_filters.begin(), runtime_filters.end(),
+                           [cid](const RuntimeFilterPredicate* rf) { return rf->column_id() == cid; });
+    };
 
     Schema output;
     output.reserve(fields.size());
@@ -1390,7 +1704,12 @@ inline Schema reorder_schema(const Schema& input, const std::unordered_map<Colum
         }
     }
     for (const auto& field : fields) {
-        if (!predicates.count(field->id())) {
+        if (!predicates.count(field->id()) && has_runtime_filter(field->id())) {
+            output.append(field);
+        }
+    }
+    for (const auto& field : fields) {
+        if (!predicates.count(field->id()) && !has_runtime_filter(field->id())) {
             output.append(field);
         }
     }
@@ -1399,10 +1718,11 @@ inline Schema reorder_schema(const Schema& input, const std::unordered_map<Colum
 
 ChunkIteratorPtr new_segment_iterator(const std::shared_ptr<Segment>& segment, const vectorized::Schema& schema,
                                       const vectorized::SegmentReadOptions& options) {
-    if (options.predicates.empty() || options.predicates.size() >= schema.num_fields()) {
+    if ((options.predicates.empty() && options.runtime_filter_preds.empty()) ||
+        options.predicates.size() >= schema.num_fields()) {
         return std::make_shared<SegmentIterator>(segment, schema, options);
     } else {
-        Schema ordered_schema = reorder_schema(schema, options.predicates);
+        Schema ordered_schema = reorder_schema(schema, options.predicates, options.runtime_filter_preds);
         auto seg_iter = std::make_shared<SegmentIterator>(segment, ordered_schema, options);
         return new_projection_iterator(schema, seg_iter);
     }
@@ -9,6 +9,7 @@
 #include "runtime/global_dicts.h"
 #include "storage/fs/fs_util.h"
 #include "storage/vectorized/disjunctive_predicates.h"
+#include "storage/vectorized/runtime_filter_predicate.h"
 #include "storage/vectorized/seek_range.h"
 
 namespace starrocks {
@@ -33,6 +34,9 @@ public:
 
     std::unordered_map<ColumnId, PredicateList> predicates;
 
+    // Not converted by `convert_to`, because the filters are built on the types of the tablet schema.
+    RuntimeFilterPredicates runtime_filter_preds;
+
     DisjunctivePredicates delete_predicates;
 
     // used for updatable tablet to get delvec
@@ -2,6 +2,9 @@
 
 #include "rowset_update_state.h"
 
+#include <algorithm>
+
+#include "column/fixed_length_column.h"
 #include "gutil/strings/substitute.h"
 #include "serde/column_array_serde.h"
 #include "storage/primary_key_encoder.h"
@@ -9,8 +12,10 @@
 #include "storage/rowset/rowset.h"
 #include "storage/rowset/segment_rewriter.h"
 #include "storage/rowset/vectorized/rowset_options.h"
+#include "storage/storage_engine.h"
 #include "storage/tablet.h"
 #include "storage/tablet_meta_manager.h"
+#include "storage/update_manager.h"
 #include "storage/vectorized/chunk_helper.h"
 #include "util/defer_op.h"
 #include "util/phmap/phmap.h"
@@ -220,17 +225,14 @@ Status RowsetUpdateState::_prepare_partial_update_states(Tablet* tablet, Rowset*
         }
     }
 
-    std::vector<std::unique_ptr<vectorized::Column>> read_columns(read_column_ids.size());
     size_t num_segments = rowset->num_segments();
     _partial_update_states.resize(num_segments);
     for (size_t i = 0; i < num_segments; i++) {
-        _partial_update_states[i].write_columns.resize(read_columns.size());
+        _partial_update_states[i].write_columns.resize(read_column_ids.size());
         _partial_update_states[i].src_rss_rowids.resize(_upserts[i]->size());
-        for (uint32_t j = 0; j < read_columns.size(); ++j) {
-            const auto read_column_id = read_column_ids[j];
-            auto tablet_column = tablet_schema.column(read_column_id);
+        for (uint32_t j = 0; j < read_column_ids.size(); ++j) {
+            auto tablet_column = tablet_schema.column(read_column_ids[j]);
             auto column = ChunkHelper::column_from_field_type(tablet_column.type(), tablet_column.is_nullable());
-            read_columns[j] = column->clone_empty();
             _partial_update_states[i].write_columns[j] = column->clone_empty();
         }
     }
@@ -247,30 +249,57 @@ Status RowsetUpdateState::_prepare_partial_update_states(Tablet* tablet, Rowset*
 
     int64_t t_read_values = MonotonicMillis();
     size_t total_rows = 0;
+    bool all_rows_exist = true;
+    for (size_t i = 0; i < num_segments; i++) {
+        const auto& src_rss_rowids = _partial_update_states[i].src_rss_rowids;
+        total_rows += src_rss_rowids.size();
+        all_rows_exist &= std::none_of(src_rss_rowids.begin(), src_rss_rowids.end(),
+                                       [](uint64_t v) { return (uint32_t)(v >> 32) == (uint32_t)-1; });
+    }
+    if (config::enable_column_mode_partial_update && all_rows_exist) {
+        // may be applied in column mode, which doesn't need the values of the other columns, so defer
+        // reading them to apply in case it falls back to row mode.
+        _column_mode_candidate = true;
+        LOG(INFO) << Substitute(
+                "prepare PartialUpdateState tablet:$0 read_version:$1 #segment:$2 #row:$3 column mode candidate "
+                "time:$4ms(index:$5)",
+                _tablet_id, _read_version.to_string(), num_segments, total_rows, t_read_values - t_start,
+                t_read_values - t_read_index);
+        return Status::OK();
+    }
     // rows actually needed to be read, excluding rows with default values
     size_t total_nondefault_rows = 0;
-    for (size_t i = 0; i < num_segments; i++) {
+    RETURN_IF_ERROR(_read_partial_update_values(tablet, read_column_ids, &total_nondefault_rows));
+    int64_t t_end = MonotonicMillis();
+
+    LOG(INFO) << Substitute(
+            "prepare PartialUpdateState tablet:$0 read_version:$1 #segment:$2 #row:$3(#non-default:$4) #column:$5 "
+            "time:$6ms(index:$7/value:$8)",
+            _tablet_id, _read_version.to_string(), num_segments, total_rows, total_nondefault_rows,
+            read_column_ids.size(), t_end - t_start, t_read_values - t_read_index, t_end - t_read_values);
+    return Status::OK();
+}
+
+Status RowsetUpdateState::_read_partial_update_values(Tablet* tablet, const std::vector<uint32_t>& read_column_ids,
+                                                      size_t* total_nondefault_rows) {
+    std::vector<uint32_t> column_ids(read_column_ids);
+    for (auto& state : _partial_update_states) {
+        std::vector<std::unique_ptr<vectorized::Column>> read_columns(read_column_ids.size());
+        for (size_t j = 0; j < read_columns.size(); j++) {
+            read_columns[j] = state.write_columns[j]->clone_empty();
+        }
         size_t num_default = 0;
         std::map<uint32_t, std::vector<uint32_t>> rowids_by_rssid;
         vector<uint32_t> idxes;
-        plan_read_by_rssid(_partial_update_states[i].src_rss_rowids, &num_default, &rowids_by_rssid, &idxes);
-        total_rows += _partial_update_states[i].src_rss_rowids.size();
-        total_nondefault_rows += _partial_update_states[i].src_rss_rowids.size() - num_default;
+        plan_read_by_rssid(state.src_rss_rowids, &num_default, &rowids_by_rssid, &idxes);
+        *total_nondefault_rows += state.src_rss_rowids.size() - num_default;
         // get column values by rowid, also get default values if needed
         RETURN_IF_ERROR(
-                tablet->updates()->get_column_values(read_column_ids, num_default > 0, rowids_by_rssid, &read_columns));
+                tablet->updates()->get_column_values(column_ids, num_default > 0, rowids_by_rssid, &read_columns));
         for (size_t col_idx = 0; col_idx < read_column_ids.size(); col_idx++) {
-            _partial_update_states[i].write_columns[col_idx]->append_selective(*read_columns[col_idx], idxes.data(), 0,
-                                                                               idxes.size());
+            state.write_columns[col_idx]->append_selective(*read_columns[col_idx], idxes.data(), 0, idxes.size());
         }
     }
-    int64_t t_end = MonotonicMillis();
-
-    LOG(INFO) << Substitute(
-            "prepare PartialUpdateState tablet:$0 read_version:$1 #segment:$2 #row:$3(#non-default:$4) #column:$5 "
-            "time:$6ms(index:$7/value:$8)",
-            _tablet_id, _read_version.to_string(), num_segments, total_rows, total_nondefault_rows, read_columns.size(),
-            t_end - t_start, t_read_values - t_read_index, t_end - t_read_values);
     return Status::OK();
 }
 
@@ -301,6 +330,24 @@ Status RowsetUpdateState::_check_and_resolve_conflict(Tablet* tablet, Rowset* ro
     }
     int64_t t_read_index = MonotonicMillis();
 
+    // the rows updated in column mode after |_read_version| are not moved, but their values have changed.
+    auto manager = StorageEngine::instance()->update_manager();
+    std::unordered_map<uint32_t, bool> column_mode_updated;
+    auto updated_in_column_mode = [&](uint32_t rssid) -> StatusOr<bool> {
+        auto iter = column_mode_updated.find(rssid);
+        if (iter != column_mode_updated.end()) {
+            return iter->second;
+        }
+        TabletSegmentId tsid;
+        tsid.tablet_id = tablet->tablet_id();
+        tsid.segment_id = rssid;
+        DeltaColumnGroupList dcgs;
+        RETURN_IF_ERROR(manager->get_delta_column_groups(tablet->data_dir()->get_meta(), tsid, INT64_MAX, &dcgs));
+        bool updated = !dcgs.empty() && dcgs.back()->version() > _read_version.major();
+        column_mode_updated.emplace(rssid, updated);
+        return updated;
+    };
+
     size_t total_conflicts = 0;
     for (uint32_t i = 0; i < num_segments; ++i) {
         uint32_t num_rows = new_rss_rowids[i].size();
@@ -313,7 +360,11 @@ Status RowsetUpdateState::_check_and_resolve_conflict(Tablet* tablet, Rowset* ro
             uint64_t rss_rowid = _partial_update_states[i].src_rss_rowids[j];
             uint32_t rssid = rss_rowid >> 32;
 
-            if (rssid != new_rssid) {
+            bool conflict = rssid != new_rssid;
+            if (!conflict && rssid != (uint32_t)-1) {
+                ASSIGN_OR_RETURN(conflict, updated_in_column_mode(rssid));
+            }
+            if (conflict) {
                 conflict_idxes.emplace_back(j);
                 conflict_rowids.emplace_back(new_rss_rowid);
             }
@@ -375,6 +426,30 @@ Status RowsetUpdateState::apply(Tablet* tablet, Rowset* rowset, uint32_t rowset_
 
     size_t num_segments = rowset->num_segments();
     DCHECK(num_segments == _upserts.size());
+    if (_column_mode_candidate) {
+        // get the latest positions of the rows, they may have been moved or deleted since load
+        std::vector<std::vector<uint64_t>> rss_rowids(num_segments);
+        bool all_rows_exist = true;
+        for (size_t i = 0; i < num_segments; i++) {
+            rss_rowids[i].resize(_upserts[i]->size());
+            index.get(*_upserts[i], &rss_rowids[i]);
+            all_rows_exist &= std::none_of(rss_rowids[i].begin(), rss_rowids[i].end(),
+                                           [](uint64_t v) { return (uint32_t)(v >> 32) == (uint32_t)-1; });
+        }
+        if (all_rows_exist && tablet->updates()->can_apply_column_mode()) {
+            // a rowset commit is always applied at the next major version
+            return _apply_column_mode(tablet, rowset, rowset_id, latest_applied_version.major() + 1,
+                                      update_colum_ids, rss_rowids);
+        }
+        // fall back to row mode, read the values of the other columns at the latest applied version
+        for (size_t i = 0; i < num_segments; i++) {
+            _partial_update_states[i].src_rss_rowids = std::move(rss_rowids[i]);
+        }
+        size_t total_nondefault_rows = 0;
+        RETURN_IF_ERROR(_read_partial_update_values(tablet, read_column_ids, &total_nondefault_rows));
+        _read_version = latest_applied_version;
+        _column_mode_candidate = false;
+    }
     vector<std::pair<string, string>> rewrite_files;
     DeferOp clean_temp_files([&] {
         for (auto& e : rewrite_files) {
@@ -427,6 +502,104 @@ Status RowsetUpdateState::apply(Tablet* tablet, Rowset* rowset, uint32_t rowset_
     return Status::OK();
 }
 
+Status RowsetUpdateState::_apply_column_mode(Tablet* tablet, Rowset* rowset, uint32_t rowset_id, int64_t version,
+                                             const std::vector<uint32_t>& update_column_ids,
+                                             const std::vector<std::vector<uint64_t>>& rss_rowids) {
+    int64_t t_start = MonotonicMillis();
+    const auto& tschema = tablet->tablet_schema();
+    std::vector<uint32_t> value_column_ids;
+    for (uint32_t cid : update_column_ids) {
+        if (cid >= tschema.num_key_columns()) {
+            value_column_ids.push_back(cid);
+        }
+    }
+    _column_mode = true;
+    if (value_column_ids.empty()) {
+        return Status::OK();
+    }
+
+    // 1. read the updated values of all segments of |rowset|
+    auto value_schema = ChunkHelper::convert_schema_to_format_v2(tschema, value_column_ids);
+    auto values = ChunkHelper::new_chunk(value_schema, 0);
+    RowsetReleaseGuard guard(rowset->shared_from_this());
+    OlapReaderStatistics stats;
+    auto beta_rowset = down_cast<BetaRowset*>(rowset);
+    ASSIGN_OR_RETURN(auto itrs, beta_rowset->get_segment_iterators2(value_schema, nullptr, 0, &stats));
+    DCHECK_EQ(itrs.size(), rss_rowids.size());
+    auto chunk = ChunkHelper::new_chunk(value_schema, config::vector_chunk_size);
+    size_t total_rows = 0;
+    for (size_t i = 0; i < itrs.size(); i++) {
+        total_rows += rss_rowids[i].size();
+        auto itr = itrs[i].get();
+        if (itr == nullptr) {
+            continue;
+        }
+        while (true) {
+            chunk->reset();
+            auto st = itr->get_next(chunk.get());
+            if (st.is_end_of_file()) {
+                break;
+            } else if (!st.ok()) {
+                return st;
+            }
+            values->append(*chunk);
+        }
+        itr->close();
+        if (values->num_rows() != total_rows) {
+            return Status::InternalError("read partial segment: iter rows != num rows");
+        }
+    }
+
+    // 2. group the rows by the segments they update, a later row overrides an earlier one of the same key
+    struct Target {
+        uint32_t rowid;
+        uint32_t idx;
+        bool operator<(const Target& rhs) const { return rowid < rhs.rowid; }
+    };
+    std::map<uint32_t, std::vector<Target>> targets_by_rssid;
+    uint32_t idx = 0;
+    for (const auto& segment_rss_rowids : rss_rowids) {
+        for (uint64_t v : segment_rss_rowids) {
+            targets_by_rssid[v >> 32].push_back({(uint32_t)(v & ROWID_MASK), idx++});
+        }
+    }
+
+    // 3. write a delta column file for each updated segment
+    for (auto& [rssid, targets] : targets_by_rssid) {
+        std::stable_sort(targets.begin(), targets.end());
+        auto rowids = vectorized::UInt32Column::create();
+        std::vector<uint32_t> idxes;
+        for (size_t i = 0; i < targets.size(); i++) {
+            if (i + 1 < targets.size() && targets[i + 1].rowid == targets[i].rowid) {
+                continue;
+            }
+            rowids->append(targets[i].rowid);
+            idxes.push_back(targets[i].idx);
+        }
+        auto columns = values->clone_empty(idxes.size());
+        columns->append_selective(*values, idxes.data(), 0, idxes.size());
+        std::vector<const vectorized::Column*> column_ptrs;
+        for (size_t i = 0; i < columns->num_columns(); i++) {
+            column_ptrs.push_back(columns->get_column_by_index(i).get());
+        }
+
+        RowsetSharedPtr target_rowset;
+        uint32_t segment_idx = 0;
+        RETURN_IF_ERROR(tablet->updates()->get_rowset_and_segment_idx_by_rssid(rssid, &target_rowset, &segment_idx));
+        auto file_name = BetaRowset::segment_delta_column_file_name(target_rowset->rowset_id(), segment_idx, rowset_id);
+        RETURN_IF_ERROR(
+                DeltaColumnGroup::write_file(target_rowset->rowset_path() + "/" + file_name, *rowids, column_ptrs));
+        auto dcg = std::make_shared<DeltaColumnGroup>();
+        dcg->init(version, value_column_ids, file_name);
+        _delta_column_groups.emplace_back(rssid, std::move(dcg));
+    }
+    int64_t t_end = MonotonicMillis();
+    LOG(INFO) << Substitute("apply partial update in column mode tablet:$0 rowset:$1 #row:$2 #column:$3 #dcg:$4 $5ms",
+                            tablet->tablet_id(), rowset_id, values->num_rows(), value_column_ids.size(),
+                            _delta_column_groups.size(), t_end - t_start);
+    return Status::OK();
+}
+
 Status RowsetUpdateState::_update_rowset_meta(Tablet* tablet, Rowset* rowset) {
     rowset->rowset_meta()->release_txn_meta();
     auto& rowset_meta_pb = rowset->rowset_meta()->get_meta_pb();
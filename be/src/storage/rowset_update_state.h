@@ -5,6 +5,7 @@
 #include <string>
 #include <unordered_map>
 
+#include "storage/delta_column_group.h"
 #include "storage/olap_common.h"
 #include "storage/primary_index.h"
 #include "storage/tablet_updates.h"
@@ -43,6 +44,15 @@ public:
 
     const std::vector<PartialUpdateState>& parital_update_states() { return _partial_update_states; }
 
+    // Whether the partial update is applied in column mode, that is the updated values are written as
+    // |delta_column_groups| of the segments holding the rows, instead of rewriting the rowset.
+    bool is_column_mode() const { return _column_mode; }
+
+    // (rssid, delta column group) pairs written by a column mode apply.
+    const std::vector<std::pair<uint32_t, DeltaColumnGroupPtr>>& delta_column_groups() const {
+        return _delta_column_groups;
+    }
+
     // call check conflict directly
     // only use for ut of partial update
     Status test_check_conflict(Tablet* tablet, Rowset* rowset, uint32_t rowset_id, EditVersion latest_applied_version,
@@ -55,6 +65,15 @@ private:
 
     Status _prepare_partial_update_states(Tablet* tablet, Rowset* rowset);
 
+    // read the values of |read_column_ids| of the rows at |src_rss_rowids| into |write_columns|.
+    Status _read_partial_update_values(Tablet* tablet, const std::vector<uint32_t>& read_column_ids,
+                                       size_t* total_nondefault_rows);
+
+    // |rss_rowids| are the latest positions of the rows of each segment of |rowset|, all rows must exist.
+    Status _apply_column_mode(Tablet* tablet, Rowset* rowset, uint32_t rowset_id, int64_t version,
+                              const std::vector<uint32_t>& update_column_ids,
+                              const std::vector<std::vector<uint64_t>>& rss_rowids);
+
     Status _check_and_resolve_conflict(Tablet* tablet, Rowset* rowset, uint32_t rowset_id,
                                        EditVersion latest_applied_version, std::vector<uint32_t>& read_column_ids,
                                        const PrimaryIndex& index);
@@ -77,6 +96,12 @@ private:
     // TODO: dump to disk if memory usage is too large
     std::vector<PartialUpdateState> _partial_update_states;
 
+    // all rows exist at load, the values of |_partial_update_states| are not read until apply, see
+    // `config::enable_column_mode_partial_update`.
+    bool _column_mode_candidate = false;
+    bool _column_mode = false;
+    std::vector<std::pair<uint32_t, DeltaColumnGroupPtr>> _delta_column_groups;
+
     RowsetUpdateState(const RowsetUpdateState&) = delete;
     const RowsetUpdateState& operator=(const RowsetUpdateState&) = delete;
 };
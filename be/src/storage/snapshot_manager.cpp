@@ -33,6 +33,7 @@
 #include "runtime/current_thread.h"
 #include "runtime/exec_env.h"
 #include "storage/del_vector.h"
+#include "storage/delta_column_group.h"
 #include "storage/rowset/beta_rowset.h"
 #include "storage/rowset/rowset_factory.h"
 #include "storage/rowset/rowset_id_generator.h"
@@ -475,6 +476,22 @@ Status SnapshotManager::make_snapshot_on_tablet_meta(SnapshotTypePB snapshot_typ
                 DelVector* delvec = &snapshot_meta.delete_vectors()[new_segment_id];
                 RETURN_IF_ERROR(TabletMetaManager::get_del_vector(meta_store, tablet->tablet_id(), old_segment_id,
                                                                   snapshot_version, delvec, &dummy /*latest_version*/));
+                DeltaColumnGroupList dcgs;
+                RETURN_IF_ERROR(TabletMetaManager::get_delta_column_groups(meta_store, tablet->tablet_id(),
+                                                                           old_segment_id, snapshot_version, &dcgs));
+                for (const auto& dcg : dcgs) {
+                    // |snapshot_dir| is the tablet directory itself when the snapshot is only made on the tablet
+                    // meta, the delta column files are already there.
+                    auto st = Env::Default()->link_file(tablet->schema_hash_path() + "/" + dcg->file_name(),
+                                                        snapshot_dir + "/" + dcg->file_name());
+                    if (!st.ok() && !st.is_already_exist()) {
+                        LOG(WARNING) << "Fail to link delta column file " << dcg->file_name() << ": " << st;
+                        return st;
+                    }
+                }
+                if (!dcgs.empty()) {
+                    snapshot_meta.delta_column_groups()[new_segment_id] = std::move(dcgs);
+                }
             }
             rowset_meta_pb.set_rowset_seg_id(new_rsid);
             new_rsid += std::max<uint32_t>(rowset_meta_pb.num_segments(), 1);
@@ -537,6 +554,24 @@ Status SnapshotManager::assign_new_rowset_id(SnapshotMeta* snapshot_meta, const
             auto new_path = BetaRowset::segment_del_file_path(clone_dir, new_rowset_id, del_id);
             RETURN_IF_ERROR(Env::Default()->link_file(old_path, new_path));
         }
+        // The delta column files are named after the rowset id too, see `BetaRowset::segment_delta_column_file_name`.
+        const std::string old_prefix = old_rowset_id.to_string();
+        for (int seg_id = 0; seg_id < rowset_meta_pb.num_segments(); seg_id++) {
+            auto iter = snapshot_meta->delta_column_groups().find(rowset_meta_pb.rowset_seg_id() + seg_id);
+            if (iter == snapshot_meta->delta_column_groups().end()) {
+                continue;
+            }
+            for (auto& dcg : iter->second) {
+                if (dcg->file_name().compare(0, old_prefix.size(), old_prefix) != 0) {
+                    return Status::Corruption(strings::Substitute("delta column file $0 not of rowset $1",
+                                                                  dcg->file_name(), old_prefix));
+                }
+                auto new_file_name = new_rowset_id.to_string() + dcg->file_name().substr(old_prefix.size());
+                RETURN_IF_ERROR(Env::Default()->link_file(clone_dir + "/" + dcg->file_name(),
+                                                          clone_dir + "/" + new_file_name));
+                dcg->init(dcg->version(), dcg->column_ids(), std::move(new_file_name));
+            }
+        }
         rowset_meta_pb.set_rowset_id_v2(new_rowset_id.to_string());
     }
     return Status::OK();
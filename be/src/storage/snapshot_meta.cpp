@@ -30,6 +30,10 @@ Status SnapshotMeta::serialize_to_file(const std::string& file_path) {
 // +-------------------------------------+
 // |             ......                  |
 // +-------------------------------------+
+// |   Serialized delta column group     |
+// +-------------------------------------+
+// |             ......                  |
+// +-------------------------------------+
 // |      Serialized tablet meta         |  variant length
 // +-------------------------------------+
 // |        SnapshotMetaFooterPB         |  variant length
@@ -67,6 +71,20 @@ Status SnapshotMeta::serialize_to_file(WritableFile* file) {
     footer.add_delvec_segids(-1);
     footer.add_delvec_versions(-1);
 
+    for (const auto& [segment_id, dcgs] : _delta_column_groups) {
+        for (const auto& dcg : dcgs) {
+            footer.add_dcg_segids(segment_id);
+            footer.add_dcg_offsets(static_cast<int64_t>(stream.size()));
+            footer.add_dcg_versions(dcg->version());
+            auto st = stream.append(dcg->save());
+            LOG_IF(WARNING, !st.ok()) << "Fail to save delta column group: " << st;
+            RETURN_IF_ERROR(st);
+        }
+    }
+    footer.add_dcg_offsets(static_cast<int64_t>(stream.size()));
+    footer.add_dcg_segids(-1);
+    footer.add_dcg_versions(-1);
+
     footer.set_tablet_meta_offset(static_cast<int64_t>(stream.size()));
     if (!_tablet_meta.SerializeToOstream(&stream)) {
         return Status::IOError("fail to serialize tablet meta to file");
@@ -123,6 +141,12 @@ Status SnapshotMeta::parse_from_file(RandomAccessFile* file) {
     if (footer.delvec_offsets_size() != footer.delvec_versions_size()) {
         return Status::InternalError("mismatched delete vector size and version size");
     }
+    if (footer.dcg_offsets_size() != footer.dcg_segids_size()) {
+        return Status::InternalError("mismatched delta column group size and segment id size");
+    }
+    if (footer.dcg_offsets_size() != footer.dcg_versions_size()) {
+        return Status::InternalError("mismatched delta column group size and version size");
+    }
     if (!footer.has_tablet_meta_offset()) {
         return Status::InternalError("no tablet meta");
     }
@@ -172,6 +196,19 @@ Status SnapshotMeta::parse_from_file(RandomAccessFile* file) {
     if (_snapshot_type == SNAPSHOT_TYPE_FULL && num_segments != num_delvecs) {
         return Status::InternalError("#segment mismatch #delvec");
     }
+    // Parse delta column groups, absent from the snapshots made before they were shipped.
+    const int num_dcgs = std::max(footer.dcg_offsets_size() - 1, 0);
+    for (int i = 0; i < num_dcgs; i++) {
+        auto segment_id = footer.dcg_segids(i);
+        auto version = footer.dcg_versions(i);
+        auto start = footer.dcg_offsets(i);
+        auto end = footer.dcg_offsets(i + 1);
+        raw::stl_string_resize_uninitialized(&buff, end - start);
+        RETURN_IF_ERROR(file->read_at_fully(start, buff.data(), buff.size()));
+        auto dcg = std::make_shared<DeltaColumnGroup>();
+        RETURN_IF_ERROR(dcg->load(version, buff.data(), buff.size()));
+        _delta_column_groups[static_cast<uint32_t>(segment_id)].emplace_back(std::move(dcg));
+    }
     // Tablet meta
     auto tablet_meta_offset = footer.tablet_meta_offset();
     raw::stl_string_resize_uninitialized(&buff, footer_offset - tablet_meta_offset);
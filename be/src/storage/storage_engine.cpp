@@ -161,7 +161,10 @@ Status StorageEngine::_open() {
 
     auto dirs = get_stores<false>();
     // `load_data_dirs` depend on |_update_manager|.
+    int64_t load_start_ms = MonotonicMillis();
     load_data_dirs(dirs);
+    StarRocksMetrics::instance()->storage_load_duration_ms.set_value(MonotonicMillis() - load_start_ms);
+    LOG(INFO) << "loaded " << dirs.size() << " data dirs in " << MonotonicMillis() - load_start_ms << "ms";
 
     _async_delta_writer_executor = std::make_unique<AsyncDeltaWriterExecutor>();
     RETURN_IF_ERROR_WITH_WARN(_async_delta_writer_executor->init(), "init AsyncDeltaWriterExecutor failed");
@@ -498,6 +501,9 @@ void StorageEngine::stop() {
     if (_fd_cache_clean_thread.joinable()) {
         _fd_cache_clean_thread.join();
     }
+    if (_rowset_file_verify_thread.joinable()) {
+        _rowset_file_verify_thread.join();
+    }
     if (config::path_gc_check) {
         for (auto& thread : _path_scan_threads) {
             if (thread.joinable()) {
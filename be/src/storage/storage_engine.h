@@ -235,6 +235,9 @@ private:
 
     void* _tablet_checkpoint_callback(void* arg);
 
+    // check the segment files of the tablets loaded at startup
+    void* _rowset_file_verify_callback(void* arg);
+
     void _start_clean_fd_cache();
     Status _perform_cumulative_compaction(DataDir* data_dir);
     Status _perform_base_compaction(DataDir* data_dir);
@@ -312,6 +315,8 @@ private:
     std::vector<std::thread> _path_scan_threads;
     // threads to run tablet checkpoint
     std::vector<std::thread> _tablet_checkpoint_threads;
+    // thread to check the segment files of the tablets loaded at startup
+    std::thread _rowset_file_verify_thread;
 
     // For tablet and disk-stat report
     std::mutex _report_mtx;
@@ -31,10 +31,12 @@
 #include <memory>
 #include <utility>
 
+#include "env/env.h"
 #include "runtime/current_thread.h"
 #include "runtime/exec_env.h"
 #include "storage/olap_common.h"
 #include "storage/olap_define.h"
+#include "storage/rowset/beta_rowset.h"
 #include "storage/rowset/rowset_factory.h"
 #include "storage/rowset/rowset_meta_manager.h"
 #include "storage/storage_engine.h"
@@ -43,6 +45,7 @@
 #include "storage/update_manager.h"
 #include "util/defer_op.h"
 #include "util/path_util.h"
+#include "util/starrocks_metrics.h"
 #include "util/time.h"
 
 namespace starrocks {
@@ -1071,6 +1074,37 @@ void Tablet::build_tablet_report_info(TTabletInfo* tablet_info) {
         tablet_info->__set_row_count(_tablet_meta->num_rows());
         tablet_info->__set_data_size(_tablet_meta->tablet_footprint());
     }
+    if (_has_missing_files.load(std::memory_order_relaxed)) {
+        tablet_info->__set_used(false);
+    }
+}
+
+bool Tablet::verify_rowset_files() {
+    if (_updates != nullptr) {
+        // the rowsets of primary key tablets are managed by TabletUpdates.
+        return true;
+    }
+    std::vector<RowsetSharedPtr> rowsets;
+    {
+        std::shared_lock rdlock(_meta_lock);
+        rowsets.reserve(_rs_version_map.size());
+        for (const auto& [version, rowset] : _rs_version_map) {
+            rowsets.emplace_back(rowset);
+        }
+    }
+    for (const auto& rowset : rowsets) {
+        for (int64_t seg_id = 0; seg_id < rowset->num_segments(); seg_id++) {
+            std::string path = BetaRowset::segment_file_path(_tablet_path, rowset->rowset_id(), seg_id);
+            if (!Env::Default()->path_exists(path).ok()) {
+                LOG(WARNING) << "Missing segment file " << path << " of tablet " << full_name() << ", version "
+                             << rowset->version();
+                StarRocksMetrics::instance()->tablet_missing_segment_files_total.increment(1);
+                _has_missing_files.store(true, std::memory_order_relaxed);
+                return false;
+            }
+        }
+    }
+    return true;
 }
 
 // should use this method to get a copy of current tablet meta
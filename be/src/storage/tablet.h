@@ -244,6 +244,10 @@ public:
 
     int64_t mem_usage() { return sizeof(Tablet); }
 
+    // Check whether the segment files of the visible rowsets exist. If not, the tablet is reported
+    // as bad, so that FE will repair it by clone. Return false if any file is missing.
+    bool verify_rowset_files();
+
 protected:
     void on_shutdown() override;
 
@@ -278,6 +282,9 @@ private:
     // should use with migration lock.
     std::atomic<bool> _is_migrating{false};
 
+    // set by verify_rowset_files()
+    std::atomic<bool> _has_missing_files{false};
+
     // explain how these two locks work together.
     mutable std::shared_mutex _meta_lock;
     // A new load job will produce a new rowset, which will be inserted into both _rs_version_map
@@ -662,7 +662,20 @@ TabletSharedPtr TabletManager::find_best_tablet_to_do_update_compaction(DataDir*
 Status TabletManager::load_tablet_from_meta(DataDir* data_dir, TTabletId tablet_id, TSchemaHash schema_hash,
                                             const std::string& meta_binary, bool update_meta, bool force, bool restore,
                                             bool check_path) {
+    // Clone and restore may run concurrently with a drop or another clone of the same tablet.
     std::unique_lock wlock(_get_tablets_shard_lock(tablet_id));
+    return _load_tablet_from_meta(data_dir, tablet_id, schema_hash, meta_binary, update_meta, force, restore,
+                                  check_path, true);
+}
+
+Status TabletManager::load_tablet_from_meta_at_startup(DataDir* data_dir, TTabletId tablet_id,
+                                                       TSchemaHash schema_hash, const std::string& meta_binary) {
+    return _load_tablet_from_meta(data_dir, tablet_id, schema_hash, meta_binary, false, false, false, false, false);
+}
+
+Status TabletManager::_load_tablet_from_meta(DataDir* data_dir, TTabletId tablet_id, TSchemaHash schema_hash,
+                                             const std::string& meta_binary, bool update_meta, bool force,
+                                             bool restore, bool check_path, bool shard_locked) {
     TabletMetaSharedPtr tablet_meta(new TabletMeta());
     if (Status st = tablet_meta->deserialize(meta_binary); !st.ok()) {
         LOG(WARNING) << "Fail to load tablet because can not parse meta_binary string. "
@@ -733,6 +746,10 @@ Status TabletManager::load_tablet_from_meta(DataDir* data_dir, TTabletId tablet_
         // tablet state is invalid, drop tablet
         return Status::InternalError("tablet in running state but without delta");
     }
+    std::unique_lock wlock(_get_tablets_shard_lock(tablet_id), std::defer_lock);
+    if (!shard_locked) {
+        wlock.lock();
+    }
     auto st = _add_tablet_unlocked(tablet, update_meta, force);
     LOG_IF(WARNING, !st.ok()) << "Fail to add tablet " << tablet->full_name();
     return st;
@@ -1027,6 +1044,27 @@ void TabletManager::do_tablet_meta_checkpoint(DataDir* data_dir) {
     }
 }
 
+void TabletManager::verify_rowset_files(DataDir* data_dir, const std::atomic<bool>& stopped) {
+    std::vector<TabletSharedPtr> related_tablets;
+    for (const auto& tablets_shard : _tablets_shards) {
+        std::shared_lock rlock(tablets_shard.lock);
+        for (const auto& [tablet_id, tablet_ptr] : tablets_shard.tablet_map) {
+            if (tablet_ptr->data_dir()->path_hash() == data_dir->path_hash()) {
+                related_tablets.push_back(tablet_ptr);
+            }
+        }
+    }
+    size_t num_bad_tablets = 0;
+    for (const TabletSharedPtr& tablet : related_tablets) {
+        if (stopped.load(std::memory_order_consume)) {
+            return;
+        }
+        num_bad_tablets += !tablet->verify_rowset_files();
+    }
+    LOG(INFO) << "verified rowset files of " << related_tablets.size() << " tablets in " << data_dir->path()
+              << ", bad tablets: " << num_bad_tablets;
+}
+
 void TabletManager::_build_tablet_stat() {
     _tablet_stat_cache.clear();
     for (const auto& tablets_shard : _tablets_shards) {
@@ -1296,6 +1334,11 @@ Status TabletManager::create_tablet_from_meta_snapshot(DataDir* store, TTabletId
     for (const auto& [segid, dv] : snapshot_meta->delete_vectors()) {
         RETURN_IF_ERROR(TabletMetaManager::put_del_vector(store, &wb, tablet_id, segid, dv));
     }
+    for (const auto& [segid, dcgs] : snapshot_meta->delta_column_groups()) {
+        for (const auto& dcg : dcgs) {
+            RETURN_IF_ERROR(TabletMetaManager::put_delta_column_group(store, &wb, tablet_id, segid, *dcg));
+        }
+    }
     RETURN_IF_ERROR(TabletMetaManager::put_tablet_meta(store, &wb, snapshot_meta->tablet_meta()));
 
     auto tablet_meta = std::make_shared<TabletMeta>();
@@ -1332,6 +1375,7 @@ Status TabletManager::create_tablet_from_meta_snapshot(DataDir* store, TTabletId
         LOG(WARNING) << "Fail to init cloned tablet " << tablet_id << ", try to clear meta store";
         wb.Clear();
         RETURN_IF_ERROR(TabletMetaManager::clear_del_vector(store, &wb, tablet_id));
+        RETURN_IF_ERROR(TabletMetaManager::clear_delta_column_group(store, &wb, tablet_id));
         RETURN_IF_ERROR(TabletMetaManager::clear_rowset(store, &wb, tablet_id));
         RETURN_IF_ERROR(TabletMetaManager::clear_log(store, &wb, tablet_id));
         RETURN_IF_ERROR(TabletMetaManager::remove_tablet_meta(store, &wb, tablet_id, schema_hash));
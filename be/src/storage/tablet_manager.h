@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <list>
 #include <map>
 #include <mutex>
@@ -109,6 +110,13 @@ public:
                                  const std::string& header, bool update_meta, bool force = false, bool restore = false,
                                  bool check_path = true);
 
+    // Same as `load_tablet_from_meta(data_dir, tablet_id, schema_hash, header, false, false, false, false)`, but
+    // the tablet is parsed and initialized without holding the shard lock, only adding it to the tablet map is
+    // serialized. Only for loading the tablets of the data dirs concurrently at startup, when no clone, restore
+    // or drop of the tablet could run at the same time.
+    Status load_tablet_from_meta_at_startup(DataDir* data_dir, TTabletId tablet_id, TSchemaHash schema_hash,
+                                            const std::string& header);
+
     Status load_tablet_from_dir(DataDir* data_dir, TTabletId tablet_id, SchemaHash schema_hash,
                                 const std::string& schema_hash_path, bool force = false, bool restore = false);
 
@@ -135,6 +143,10 @@ public:
 
     void do_tablet_meta_checkpoint(DataDir* data_dir);
 
+    // Check the segment files of the tablets in |data_dir|, which is deferred from loading
+    // the tablets at startup. Return early if |stopped| becomes true.
+    void verify_rowset_files(DataDir* data_dir, const std::atomic<bool>& stopped);
+
     void register_clone_tablet(int64_t tablet_id);
     void unregister_clone_tablet(int64_t tablet_id);
 
@@ -184,6 +196,12 @@ private:
 
     Status _update_tablet_map_and_partition_info(const TabletSharedPtr& tablet);
 
+    // If |shard_locked| is false, the shard lock of |tablet_id| is only taken to add the tablet.
+    // REQUIRES: the shard lock of |tablet_id| is held if |shard_locked| is true.
+    Status _load_tablet_from_meta(DataDir* data_dir, TTabletId tablet_id, TSchemaHash schema_hash,
+                                  const std::string& header, bool update_meta, bool force, bool restore,
+                                  bool check_path, bool shard_locked);
+
     Status _create_inital_rowset_unlocked(const TCreateTabletReq& request, Tablet* tablet);
 
     Status _drop_tablet_directly_unlocked(TTabletId tablet_id, TabletDropFlag flag);
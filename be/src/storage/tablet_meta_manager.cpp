@@ -35,6 +35,7 @@
 #include "json2pb/pb_to_json.h"
 #include "rocksdb/write_batch.h"
 #include "storage/del_vector.h"
+#include "storage/delta_column_group.h"
 #include "storage/kv_store.h"
 #include "storage/olap_define.h"
 #include "storage/rocksdb_status_adapter.h"
@@ -51,6 +52,7 @@ static const std::string TABLET_META_LOG_PREFIX = "tlg_";
 static const std::string TABLET_META_ROWSET_PREFIX = "trs_";
 static const std::string TABLET_META_PENDING_ROWSET_PREFIX = "tpr_";
 static const std::string TABLET_DELVEC_PREFIX = "dlv_";
+static const std::string TABLET_DELTA_COLUMN_GROUP_PREFIX = "dcg_";
 static const std::string TABLET_PERSISTENT_INDEX_META_PREFIX = "tpi_";
 
 static string encode_meta_log_key(TTabletId id, uint64_t logid);
@@ -63,6 +65,7 @@ static string encode_meta_pending_rowset_key(TTabletId id, int64_t version);
 std::string encode_del_vector_key(TTabletId tablet_id, uint32_t segment_id, int64_t version);
 void decode_del_vector_key(const std::string_view& enc_key, TTabletId* tablet_id, uint32_t* segment_id,
                            int64_t* version);
+static std::string encode_delta_column_group_key(TTabletId tablet_id, uint32_t segment_id, int64_t version);
 std::string encode_persistent_index_key(TTabletId tablet_id);
 void decode_persistent_index_key(const std::string_view& enc_key, TTabletId* tablet_id);
 
@@ -676,6 +679,19 @@ void decode_del_vector_key(const std::string_view& enc_key, TTabletId* tablet_id
     *version = INT64_MAX - BigEndian::ToHost64(UNALIGNED_LOAD64(enc_key.data() + 16));
 }
 
+// same layout as the key of delete vector, so the delta column groups of a segment are sorted by
+// version in reverse order too.
+static std::string encode_delta_column_group_key(TTabletId tablet_id, uint32_t segment_id, int64_t version) {
+    std::string key;
+    key.reserve(24);
+    key.append(TABLET_DELTA_COLUMN_GROUP_PREFIX);
+    put_fixed64_le(&key, BigEndian::FromHost64(tablet_id));
+    put_fixed32_le(&key, BigEndian::FromHost32(segment_id));
+    int64_t v = std::numeric_limits<int64_t>::max() - version;
+    put_fixed64_le(&key, BigEndian::FromHost64(v));
+    return key;
+}
+
 std::string encode_persistent_index_key(TTabletId tablet_id) {
     std::string key;
     key.reserve(TABLET_PERSISTENT_INDEX_META_PREFIX.length() + sizeof(uint64_t));
@@ -784,6 +800,12 @@ Status TabletMetaManager::rowset_delete(DataDir* store, TTabletId tablet_id, uin
         if (UNLIKELY(!st.ok())) {
             return Status::InternalError("remove delete vector failed");
         }
+        lower = encode_delta_column_group_key(tablet_id, rowset_id + 0, INT64_MAX);
+        upper = encode_delta_column_group_key(tablet_id, rowset_id + segments, INT64_MAX);
+        st = batch.DeleteRange(cf_meta, lower, upper);
+        if (UNLIKELY(!st.ok())) {
+            return Status::InternalError("remove delta column group failed");
+        }
     }
     return meta->write_batch(&batch);
 }
@@ -804,7 +826,8 @@ Status TabletMetaManager::rowset_iterate(DataDir* store, TTabletId tablet_id, co
 
 Status TabletMetaManager::apply_rowset_commit(DataDir* store, TTabletId tablet_id, int64_t logid,
                                               const EditVersion& version,
-                                              vector<std::pair<uint32_t, DelVectorPtr>>& delvecs) {
+                                              vector<std::pair<uint32_t, DelVectorPtr>>& delvecs,
+                                              const vector<std::pair<uint32_t, DeltaColumnGroupPtr>>& dcgs) {
     WriteBatch batch;
     auto handle = store->get_meta()->handle(META_COLUMN_FAMILY_INDEX);
     string logkey = encode_meta_log_key(tablet_id, logid);
@@ -832,6 +855,14 @@ Status TabletMetaManager::apply_rowset_commit(DataDir* store, TTabletId tablet_i
             return to_status(st);
         }
     }
+    for (auto& [rssid, dcg] : dcgs) {
+        DCHECK_EQ(version.major(), dcg->version());
+        st = batch.Put(handle, encode_delta_column_group_key(tablet_id, rssid, dcg->version()), dcg->save());
+        if (!st.ok()) {
+            LOG(WARNING) << "rowset_commit failed, rocksdb.batch.put failed";
+            return to_status(st);
+        }
+    }
 
     return store->get_meta()->write_batch(&batch);
 }
@@ -955,6 +986,32 @@ Status TabletMetaManager::delete_del_vector_range(KVStore* meta, TTabletId table
     return meta->write_batch(&batch);
 }
 
+Status TabletMetaManager::get_delta_column_groups(KVStore* meta, TTabletId tablet_id, uint32_t segment_id,
+                                                  int64_t version, DeltaColumnGroupList* dcgs) {
+    std::string lower = encode_delta_column_group_key(tablet_id, segment_id, version);
+    std::string upper = encode_delta_column_group_key(tablet_id, segment_id, 0);
+    Status st;
+    auto st_iterate = meta->iterate_range(META_COLUMN_FAMILY_INDEX, lower, upper,
+                                          [&](std::string_view key, std::string_view value) -> bool {
+                                              auto dcg = std::make_shared<DeltaColumnGroup>();
+                                              st = dcg->load(decode_del_vector_key_version(key), value.data(),
+                                                             value.size());
+                                              if (!st.ok()) {
+                                                  return false;
+                                              }
+                                              dcgs->emplace_back(std::move(dcg));
+                                              return true;
+                                          });
+    if (!st_iterate.ok()) {
+        LOG(WARNING) << "fail to iterate rocksdb delta column groups. tablet_id=" << tablet_id
+                     << " segment_id=" << segment_id << " error_code=" << st_iterate.to_string();
+        return st_iterate;
+    }
+    // stored in reverse order of version
+    std::reverse(dcgs->begin(), dcgs->end());
+    return st;
+}
+
 Status TabletMetaManager::put_rowset_meta(DataDir* store, WriteBatch* batch, TTabletId tablet_id,
                                           const RowsetMetaPB& rowset_meta) {
     auto h = store->get_meta()->handle(META_COLUMN_FAMILY_INDEX);
@@ -971,6 +1028,14 @@ Status TabletMetaManager::put_del_vector(DataDir* store, WriteBatch* batch, TTab
     return to_status(batch->Put(h, k, v));
 }
 
+Status TabletMetaManager::put_delta_column_group(DataDir* store, WriteBatch* batch, TTabletId tablet_id,
+                                                 uint32_t segment_id, const DeltaColumnGroup& dcg) {
+    auto k = encode_delta_column_group_key(tablet_id, segment_id, dcg.version());
+    auto v = dcg.save();
+    auto h = store->get_meta()->handle(META_COLUMN_FAMILY_INDEX);
+    return to_status(batch->Put(h, k, v));
+}
+
 Status TabletMetaManager::put_tablet_meta(DataDir* store, WriteBatch* batch, const TabletMetaPB& meta) {
     auto k = encode_tablet_meta_key(meta.tablet_id(), meta.schema_hash());
     auto v = meta.SerializeAsString();
@@ -999,6 +1064,13 @@ Status TabletMetaManager::clear_del_vector(DataDir* store, WriteBatch* batch, TT
     return to_status(batch->DeleteRange(h, lower, upper));
 }
 
+Status TabletMetaManager::clear_delta_column_group(DataDir* store, WriteBatch* batch, TTabletId tablet_id) {
+    auto lower = encode_delta_column_group_key(tablet_id, 0, INT64_MAX);
+    auto upper = encode_delta_column_group_key(tablet_id, UINT32_MAX, INT64_MAX);
+    auto h = store->get_meta()->handle(META_COLUMN_FAMILY_INDEX);
+    return to_status(batch->DeleteRange(h, lower, upper));
+}
+
 Status TabletMetaManager::remove_tablet_meta(DataDir* store, WriteBatch* batch, TTabletId tablet_id,
                                              TSchemaHash schema_hash) {
     auto k = encode_tablet_meta_key(tablet_id, schema_hash);
@@ -33,6 +33,9 @@ namespace starrocks {
 
 class DelVector;
 using DelVectorPtr = std::shared_ptr<DelVector>;
+class DeltaColumnGroup;
+using DeltaColumnGroupPtr = std::shared_ptr<DeltaColumnGroup>;
+using DeltaColumnGroupList = std::vector<DeltaColumnGroupPtr>;
 class EditVersion;
 class EditVersionMetaPB;
 class RowsetMetaPB;
@@ -139,12 +142,14 @@ public:
     // Remove rowset meta from |store|, leave tablet meta unchanged.
     // |rowset_id| is the value returned from `RowsetMeta::get_rowset_seg_id`.
     // |segments| is the number of segments in the rowset, i.e, `Rowset::num_segments`.
-    // All delete vectors that associated with this rowset will be deleted too.
+    // All delete vectors and delta column groups that associated with this rowset will be deleted too.
     static Status rowset_delete(DataDir* store, TTabletId tablet_id, uint32_t rowset_id, uint32_t segments);
 
     // update meta after state of a rowset commit is applied
+    // |dcgs| the delta column groups written by a column mode partial update, keyed by segment id.
     static Status apply_rowset_commit(DataDir* store, TTabletId tablet_id, int64_t logid, const EditVersion& version,
-                                      std::vector<std::pair<uint32_t, DelVectorPtr>>& delvecs);
+                                      std::vector<std::pair<uint32_t, DelVectorPtr>>& delvecs,
+                                      const std::vector<std::pair<uint32_t, DeltaColumnGroupPtr>>& dcgs = {});
 
     // traverse all the op logs for a tablet
     static Status traverse_meta_logs(DataDir* store, TTabletId tablet_id,
@@ -165,12 +170,20 @@ public:
     static Status delete_del_vector_range(KVStore* meta, TTabletId tablet_id, uint32_t segment_id,
                                           int64_t start_version, int64_t end_version);
 
+    // Get all the delta column groups of a segment whose version is not greater than |version|,
+    // ordered by version in ascending order.
+    static Status get_delta_column_groups(KVStore* meta, TTabletId tablet_id, uint32_t segment_id, int64_t version,
+                                          DeltaColumnGroupList* dcgs);
+
     static Status put_rowset_meta(DataDir* store, WriteBatch* batch, TTabletId tablet_id,
                                   const RowsetMetaPB& rowset_meta);
 
     static Status put_del_vector(DataDir* store, WriteBatch* batch, TTabletId tablet_id, uint32_t segment_id,
                                  const DelVector& delvec);
 
+    static Status put_delta_column_group(DataDir* store, WriteBatch* batch, TTabletId tablet_id, uint32_t segment_id,
+                                         const DeltaColumnGroup& dcg);
+
     static Status put_tablet_meta(DataDir* store, WriteBatch* batch, const TabletMetaPB& tablet_meta);
 
     static Status delete_pending_rowset(DataDir* store, WriteBatch* batch, TTabletId tablet_id, int64_t version);
@@ -184,6 +197,8 @@ public:
 
     static Status clear_del_vector(DataDir* store, WriteBatch* batch, TTabletId tablet_id);
 
+    static Status clear_delta_column_group(DataDir* store, WriteBatch* batch, TTabletId tablet_id);
+
     static Status remove_tablet_meta(DataDir* store, WriteBatch* batch, TTabletId tablet_id, TSchemaHash schema_hash);
 };
 
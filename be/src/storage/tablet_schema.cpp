@@ -321,6 +321,8 @@ void TabletColumn::init_from_pb(const ColumnPB& column) {
     _set_flag(kIsNullableShift, column.is_nullable());
     _set_flag(kIsBfColumnShift, column.is_bf_column());
     _set_flag(kHasBitmapIndexShift, column.has_bitmap_index());
+    _set_flag(kHasNgramBfIndexShift, column.has_ngram_bf_index());
+    _set_flag(kHasInvertedIndexShift, column.has_inverted_index());
     _set_flag(kHasPrecisionShift, column.has_precision());
     _set_flag(kHasScaleShift, column.has_frac());
 
@@ -374,6 +376,12 @@ void TabletColumn::to_schema_pb(ColumnPB* column) const {
     column->set_is_bf_column(is_bf_column());
     column->set_aggregation(get_string_by_aggregation_type(_aggregation));
     column->set_has_bitmap_index(has_bitmap_index());
+    if (has_ngram_bf_index()) {
+        column->set_has_ngram_bf_index(true);
+    }
+    if (has_inverted_index()) {
+        column->set_has_inverted_index(true);
+    }
     for (int i = 0; i < subcolumn_count(); i++) {
         subcolumn(i).to_schema_pb(column->add_children_columns());
     }
@@ -597,7 +605,8 @@ std::string TabletColumn::debug_string() const {
        << ",precision=" << (has_precision() ? std::to_string(_precision) : "N/A")
        << ",frac=" << (has_scale() ? std::to_string(_scale) : "N/A") << ",length=" << _length
        << ",index_length=" << _index_length << ",is_bf_column=" << is_bf_column()
-       << ",has_bitmap_index=" << has_bitmap_index() << ")";
+       << ",has_bitmap_index=" << has_bitmap_index() << ",has_ngram_bf_index=" << has_ngram_bf_index()
+       << ",has_inverted_index=" << has_inverted_index() << ")";
     return ss.str();
 }
 
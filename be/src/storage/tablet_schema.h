@@ -96,6 +96,12 @@ public:
     bool has_bitmap_index() const { return _check_flag(kHasBitmapIndexShift); }
     void set_has_bitmap_index(bool value) { _set_flag(kHasBitmapIndexShift, value); }
 
+    bool has_ngram_bf_index() const { return _check_flag(kHasNgramBfIndexShift); }
+    void set_has_ngram_bf_index(bool value) { _set_flag(kHasNgramBfIndexShift, value); }
+
+    bool has_inverted_index() const { return _check_flag(kHasInvertedIndexShift); }
+    void set_has_inverted_index(bool value) { _set_flag(kHasInvertedIndexShift, value); }
+
     ColumnLength length() const { return _length; }
     void set_length(ColumnLength length) { _length = length; }
 
@@ -161,6 +167,8 @@ private:
     constexpr static uint8_t kHasBitmapIndexShift = 3;
     constexpr static uint8_t kHasPrecisionShift = 4;
     constexpr static uint8_t kHasScaleShift = 5;
+    constexpr static uint8_t kHasNgramBfIndexShift = 6;
+    constexpr static uint8_t kHasInvertedIndexShift = 7;
 
     ExtraFields* _get_or_alloc_extra_fields() {
         if (_extra_fields == nullptr) {
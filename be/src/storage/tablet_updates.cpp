@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <ctime>
 #include <memory>
+#include <numeric>
 
 #include "column/datum.h"
 #include "common/status.h"
@@ -18,8 +19,10 @@
 #include "runtime/exec_env.h"
 #include "storage/compaction_utils.h"
 #include "storage/del_vector.h"
+#include "storage/delta_column_group.h"
 #include "storage/primary_key_encoder.h"
 #include "storage/rowset/default_value_column_iterator.h"
+#include "storage/rowset/delta_column_iterator.h"
 #include "storage/rowset/rowset_factory.h"
 #include "storage/rowset/rowset_meta_manager.h"
 #include "storage/rowset/rowset_writer.h"
@@ -763,10 +766,20 @@ void TabletUpdates::_apply_rowset_commit(const EditVersionInfo& version_info) {
         new_deletes[rowset_id + i] = {};
     }
     auto& upserts = state.upserts();
-    for (uint32_t i = 0; i < upserts.size(); i++) {
-        if (upserts[i] != nullptr) {
-            index.upsert(rowset_id + i, 0, *upserts[i], &new_deletes);
-            manager->index_cache().update_object_size(index_entry, index.memory_usage());
+    if (state.is_column_mode()) {
+        // the updated values are written to delta column groups of the existing segments, the rows
+        // of the new segments are only used to locate them, so delete them all.
+        for (uint32_t i = 0; i < upserts.size(); i++) {
+            auto& del_ids = new_deletes[rowset_id + i];
+            del_ids.resize(upserts[i] != nullptr ? upserts[i]->size() : 0);
+            std::iota(del_ids.begin(), del_ids.end(), 0);
+        }
+    } else {
+        for (uint32_t i = 0; i < upserts.size(); i++) {
+            if (upserts[i] != nullptr) {
+                index.upsert(rowset_id + i, 0, *upserts[i], &new_deletes);
+                manager->index_cache().update_object_size(index_entry, index.memory_usage());
+            }
         }
     }
 
@@ -775,6 +788,7 @@ void TabletUpdates::_apply_rowset_commit(const EditVersionInfo& version_info) {
         index.erase(*one_delete, &new_deletes);
     }
     manager->index_cache().update_object_size(index_entry, index.memory_usage());
+    auto delta_column_groups = state.delta_column_groups();
     // release resource
     // update state only used once, so delete it
     manager->update_state_cache().remove(state_entry);
@@ -867,7 +881,8 @@ void TabletUpdates::_apply_rowset_commit(const EditVersionInfo& version_info) {
     {
         std::lock_guard wl(_lock);
         // 4. write meta
-        st = TabletMetaManager::apply_rowset_commit(_tablet.data_dir(), tablet_id, _next_log_id, version, new_del_vecs);
+        st = TabletMetaManager::apply_rowset_commit(_tablet.data_dir(), tablet_id, _next_log_id, version, new_del_vecs,
+                                                    delta_column_groups);
         if (!st.ok()) {
             std::string msg = Substitute("_apply_rowset_commit error: write meta failed: $0 $1", st.to_string(),
                                          _debug_string(false));
@@ -875,13 +890,17 @@ void TabletUpdates::_apply_rowset_commit(const EditVersionInfo& version_info) {
             _set_error(msg);
             return;
         }
-        // put delvec in cache
+        // put delvec and delta column groups in cache
         TabletSegmentId tsid;
         tsid.tablet_id = tablet_id;
         for (auto& delvec_pair : new_del_vecs) {
             tsid.segment_id = delvec_pair.first;
             manager->set_cached_del_vec(tsid, delvec_pair.second);
         }
+        for (auto& dcg_pair : delta_column_groups) {
+            tsid.segment_id = dcg_pair.first;
+            manager->set_cached_delta_column_group(tsid, dcg_pair.second);
+        }
         // 5. apply memory
         _next_log_id++;
         _apply_version_idx++;
@@ -1453,6 +1472,9 @@ Status TabletUpdates::compaction(MemTracker* mem_tracker) {
     std::unique_ptr<CompactionInfo> info = std::make_unique<CompactionInfo>();
     vector<uint32_t> rowsets;
     {
+        // hold |_index_lock| to wait for the rowset being applied, which may have been applied in
+        // column mode before |_compaction_running| is set, see `can_apply_column_mode`.
+        std::lock_guard lg(_index_lock);
         std::lock_guard rl(_lock);
         // 1. start compaction at current apply version
         info->start_version = _edit_version_infos[_apply_version_idx]->version;
@@ -1926,6 +1948,7 @@ Status TabletUpdates::link_from(Tablet* base_tablet, int64_t request_version) {
     RETURN_IF_ERROR(TabletMetaManager::clear_rowset(data_dir, &wb, tablet_id));
     RETURN_IF_ERROR(TabletMetaManager::clear_pending_rowset(data_dir, &wb, tablet_id));
     RETURN_IF_ERROR(TabletMetaManager::clear_del_vector(data_dir, &wb, tablet_id));
+    RETURN_IF_ERROR(TabletMetaManager::clear_delta_column_group(data_dir, &wb, tablet_id));
     RETURN_IF_ERROR(TabletMetaManager::put_tablet_meta(data_dir, &wb, meta_pb));
     for (auto& info : new_rowsets) {
         RETURN_IF_ERROR(TabletMetaManager::put_rowset_meta(data_dir, &wb, tablet_id, info.rowset_meta_pb));
@@ -2078,6 +2101,7 @@ Status TabletUpdates::convert_from(const std::shared_ptr<Tablet>& base_tablet, i
     RETURN_IF_ERROR(TabletMetaManager::clear_rowset(data_dir, &wb, tablet_id));
     RETURN_IF_ERROR(TabletMetaManager::clear_pending_rowset(data_dir, &wb, tablet_id));
     RETURN_IF_ERROR(TabletMetaManager::clear_del_vector(data_dir, &wb, tablet_id));
+    RETURN_IF_ERROR(TabletMetaManager::clear_delta_column_group(data_dir, &wb, tablet_id));
     RETURN_IF_ERROR(TabletMetaManager::put_tablet_meta(data_dir, &wb, meta_pb));
     DelVector delvec;
     for (const auto& new_rowset_load_info : new_rowset_load_infos) {
@@ -2294,6 +2318,14 @@ Status TabletUpdates::load_snapshot(const SnapshotMeta& snapshot_meta) {
         for (const auto& rowset_meta_pb : snapshot_meta.rowset_metas()) {
             RETURN_IF_ERROR(check_rowset_files(rowset_meta_pb));
         }
+        for (const auto& [rssid, dcgs] : snapshot_meta.delta_column_groups()) {
+            for (const auto& dcg : dcgs) {
+                auto st = Env::Default()->path_exists(_tablet.schema_hash_path() + "/" + dcg->file_name());
+                if (!st.ok()) {
+                    return Status::InternalError("delta column file does not exist: " + st.to_string());
+                }
+            }
+        }
         // Stop apply thread.
         _stop_and_wait_apply_done();
 
@@ -2367,6 +2399,12 @@ Status TabletUpdates::load_snapshot(const SnapshotMeta& snapshot_meta) {
             auto id = rssid + _next_rowset_id;
             CHECK_FAIL(TabletMetaManager::put_del_vector(data_store, &wb, tablet_id, id, delvec));
         }
+        for (const auto& [rssid, dcgs] : snapshot_meta.delta_column_groups()) {
+            auto id = rssid + _next_rowset_id;
+            for (const auto& dcg : dcgs) {
+                CHECK_FAIL(TabletMetaManager::put_delta_column_group(data_store, &wb, tablet_id, id, *dcg));
+            }
+        }
         for (const auto& [rid, rowset] : _rowsets) {
             RowsetMetaPB meta_pb = rowset->rowset_meta()->to_rowset_pb();
             CHECK_FAIL(TabletMetaManager::put_rowset_meta(data_store, &wb, tablet_id, meta_pb));
@@ -2416,14 +2454,14 @@ Status TabletUpdates::load_snapshot(const SnapshotMeta& snapshot_meta) {
 }
 
 void TabletUpdates::_clear_rowset_del_vec_cache(const Rowset& rowset) {
-    StorageEngine::instance()->update_manager()->clear_cached_del_vec([&]() {
-        std::vector<TabletSegmentId> tsids;
-        tsids.reserve(rowset.num_segments());
-        for (auto i = 0; i < rowset.num_segments(); i++) {
-            tsids.emplace_back(TabletSegmentId{_tablet.tablet_id(), rowset.rowset_meta()->get_rowset_seg_id() + i});
-        }
-        return tsids;
-    }());
+    std::vector<TabletSegmentId> tsids;
+    tsids.reserve(rowset.num_segments());
+    for (auto i = 0; i < rowset.num_segments(); i++) {
+        tsids.emplace_back(TabletSegmentId{_tablet.tablet_id(), rowset.rowset_meta()->get_rowset_seg_id() + i});
+    }
+    auto manager = StorageEngine::instance()->update_manager();
+    manager->clear_cached_del_vec(tsids);
+    manager->clear_cached_delta_column_groups(tsids);
 }
 
 Status TabletUpdates::clear_meta() {
@@ -2445,6 +2483,7 @@ Status TabletUpdates::clear_meta() {
     TabletMetaManager::clear_pending_rowset(data_store, &wb, _tablet.tablet_id());
     TabletMetaManager::clear_rowset(data_store, &wb, _tablet.tablet_id());
     TabletMetaManager::clear_del_vector(data_store, &wb, _tablet.tablet_id());
+    TabletMetaManager::clear_delta_column_group(data_store, &wb, _tablet.tablet_id());
     TabletMetaManager::clear_log(data_store, &wb, _tablet.tablet_id());
     TabletMetaManager::remove_tablet_meta(data_store, &wb, _tablet.tablet_id(), _tablet.schema_hash());
     RETURN_IF_ERROR(meta_store->write_batch(&wb));
@@ -2535,17 +2574,66 @@ Status TabletUpdates::get_column_values(std::vector<uint32_t>& column_ids, bool
         std::unique_ptr<fs::ReadableBlock> rblock;
         RETURN_IF_ERROR(fs::fs_util::block_manager()->open_block((*segment)->file_name(), &rblock));
         iter_opts.rblock = rblock.get();
+        // the values updated by column mode partial updates
+        std::map<uint32_t, DeltaColumnValues> delta_columns;
+        TabletSegmentId tsid;
+        tsid.tablet_id = _tablet.tablet_id();
+        tsid.segment_id = rssid;
+        DeltaColumnGroupList dcgs;
+        RETURN_IF_ERROR(StorageEngine::instance()->update_manager()->get_delta_column_groups(
+                _tablet.data_dir()->get_meta(), tsid, INT64_MAX, &dcgs));
+        if (!dcgs.empty()) {
+            RETURN_IF_ERROR(load_delta_column_values(rowset->rowset_path(), _tablet.tablet_schema(), dcgs,
+                                                     column_ids, &delta_columns));
+        }
         for (auto i = 0; i < column_ids.size(); ++i) {
             ColumnIterator* col_iter_raw_ptr = nullptr;
             RETURN_IF_ERROR((*segment)->new_column_iterator(column_ids[i], &col_iter_raw_ptr));
             std::unique_ptr<ColumnIterator> col_iter(col_iter_raw_ptr);
             RETURN_IF_ERROR(col_iter->init(iter_opts));
+            auto delta = delta_columns.find(column_ids[i]);
+            if (delta != delta_columns.end()) {
+                DeltaColumnIterator delta_iter(col_iter.get(), (*segment)->num_rows(), std::move(delta->second.rowids),
+                                               std::move(delta->second.values));
+                RETURN_IF_ERROR(
+                        delta_iter.fetch_values_by_rowid(rowids.data(), rowids.size(), (*columns)[i].get()));
+                continue;
+            }
             RETURN_IF_ERROR(col_iter->fetch_values_by_rowid(rowids.data(), rowids.size(), (*columns)[i].get()));
         }
     }
     return Status::OK();
 }
 
+Status TabletUpdates::get_rowset_and_segment_idx_by_rssid(uint32_t rssid, RowsetSharedPtr* rowset,
+                                                         uint32_t* segment_idx) {
+    std::lock_guard<std::mutex> l(_rowsets_lock);
+    auto iter = _rowsets.upper_bound(rssid);
+    if (iter == _rowsets.begin()) {
+        return Status::NotFound(Substitute("rowset of rssid $0 not found", rssid));
+    }
+    --iter;
+    if (rssid >= iter->first + iter->second->num_segments()) {
+        return Status::NotFound(Substitute("rowset of rssid $0 not found", rssid));
+    }
+    *rowset = iter->second;
+    *segment_idx = rssid - iter->first;
+    return Status::OK();
+}
+
+bool TabletUpdates::can_apply_column_mode() const {
+    if (_compaction_running) {
+        return false;
+    }
+    std::lock_guard rl(_lock);
+    for (size_t i = _apply_version_idx + 1; i < _edit_version_infos.size(); i++) {
+        if (_edit_version_infos[i]->compaction) {
+            return false;
+        }
+    }
+    return true;
+}
+
 Status TabletUpdates::prepare_partial_update_states(Tablet* tablet, const std::vector<ColumnUniquePtr>& upserts,
                                                     EditVersion* read_version, uint32_t* next_rowset_id,
                                                     std::vector<std::vector<uint64_t>*>* rss_rowids) {
@@ -214,6 +214,15 @@ public:
                                          EditVersion* read_version, uint32_t* next_rowset_id,
                                          std::vector<std::vector<uint64_t>*>* rss_rowids);
 
+    // Find the rowset holding segment |rssid|, and the index of the segment in the rowset.
+    Status get_rowset_and_segment_idx_by_rssid(uint32_t rssid, RowsetSharedPtr* rowset, uint32_t* segment_idx);
+
+    // Whether a partial update can be applied in column mode now, i.e. written as delta column groups
+    // of the segments holding the updated rows. Not allowed while a compaction is running or waiting
+    // to be applied, because the output rowset of the compaction would miss the updated values.
+    // Must be called with |_index_lock| held, which is the case when applying a rowset.
+    bool can_apply_column_mode() const;
+
 private:
     friend class Tablet;
     friend class PrimaryIndex;
@@ -311,6 +320,7 @@ private:
     // REQUIRE: |_lock| is held.
     void _to_updates_pb_unlocked(TabletUpdatesPB* updates_pb) const;
 
+    // clear the cached delete vectors and delta column groups of the segments of |rowset|
     void _clear_rowset_del_vec_cache(const Rowset& rowset);
 
     void _update_total_stats(const std::vector<uint32_t>& rowsets);
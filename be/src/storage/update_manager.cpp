@@ -7,6 +7,7 @@
 
 #include "gutil/endian.h"
 #include "storage/del_vector.h"
+#include "storage/delta_column_group.h"
 #include "storage/kv_store.h"
 #include "storage/rowset_update_state.h"
 #include "storage/tablet.h"
@@ -122,6 +123,10 @@ void UpdateManager::clear_cache() {
         StarRocksMetrics::instance()->update_del_vector_num.set_value(0);
         StarRocksMetrics::instance()->update_del_vector_bytes_total.set_value(0);
     }
+    {
+        std::lock_guard<std::mutex> lg(_delta_column_group_cache_lock);
+        _delta_column_group_cache.clear();
+    }
 }
 
 void UpdateManager::clear_cached_del_vec(const std::vector<TabletSegmentId>& tsids) {
@@ -135,6 +140,13 @@ void UpdateManager::clear_cached_del_vec(const std::vector<TabletSegmentId>& tsi
     }
 }
 
+void UpdateManager::clear_cached_delta_column_groups(const std::vector<TabletSegmentId>& tsids) {
+    std::lock_guard<std::mutex> lg(_delta_column_group_cache_lock);
+    for (const auto& tsid : tsids) {
+        _delta_column_group_cache.erase(tsid);
+    }
+}
+
 void UpdateManager::expire_cache() {
     StarRocksMetrics::instance()->update_primary_index_num.set_value(_index_cache.object_size());
     StarRocksMetrics::instance()->update_primary_index_bytes_total.set_value(_index_cache.size());
@@ -245,6 +257,40 @@ Status UpdateManager::set_cached_del_vec(const TabletSegmentId& tsid, const DelV
     return Status::OK();
 }
 
+Status UpdateManager::get_delta_column_groups(KVStore* meta, const TabletSegmentId& tsid, int64_t version,
+                                              DeltaColumnGroupList* dcgs) {
+    dcgs->clear();
+    std::lock_guard<std::mutex> lg(_delta_column_group_cache_lock);
+    auto itr = _delta_column_group_cache.find(tsid);
+    if (itr == _delta_column_group_cache.end()) {
+        // load under lock, or a concurrent set_cached_delta_column_group may be lost
+        DeltaColumnGroupList all;
+        RETURN_IF_ERROR(
+                TabletMetaManager::get_delta_column_groups(meta, tsid.tablet_id, tsid.segment_id, INT64_MAX, &all));
+        itr = _delta_column_group_cache.emplace(tsid, std::move(all)).first;
+    }
+    for (const auto& dcg : itr->second) {
+        if (dcg->version() > version) {
+            break;
+        }
+        dcgs->emplace_back(dcg);
+    }
+    return Status::OK();
+}
+
+void UpdateManager::set_cached_delta_column_group(const TabletSegmentId& tsid, const DeltaColumnGroupPtr& dcg) {
+    VLOG(1) << "set_cached_delta_column_group tablet:" << tsid.tablet_id << " rss:" << tsid.segment_id << " "
+            << dcg->to_string();
+    std::lock_guard<std::mutex> lg(_delta_column_group_cache_lock);
+    auto itr = _delta_column_group_cache.find(tsid);
+    // if not cached yet, it will be loaded from meta on demand. it may have been loaded from meta
+    // already if the cache is filled after the meta is written.
+    if (itr != _delta_column_group_cache.end() &&
+        (itr->second.empty() || itr->second.back()->version() < dcg->version())) {
+        itr->second.emplace_back(dcg);
+    }
+}
+
 Status UpdateManager::on_rowset_finished(Tablet* tablet, Rowset* rowset) {
     string rowset_unique_id = rowset->rowset_id().to_string();
     VLOG(1) << "UpdateManager::on_rowset_finished start tablet:" << tablet->tablet_id()
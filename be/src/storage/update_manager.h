@@ -16,6 +16,9 @@ using std::string;
 
 class DelVector;
 using DelVectorPtr = std::shared_ptr<DelVector>;
+class DeltaColumnGroup;
+using DeltaColumnGroupPtr = std::shared_ptr<DeltaColumnGroup>;
+using DeltaColumnGroupList = std::vector<DeltaColumnGroupPtr>;
 class EditVersion;
 class MemTracker;
 class KVStore;
@@ -27,8 +30,8 @@ class Tablet;
 class TabletMeta;
 
 // UpdateManager maintain update feature related data structures, including
-// PrimaryIndexe cache, RowsetUpdateState cache, DelVector cache and
-// async apply thread pool.
+// PrimaryIndexe cache, RowsetUpdateState cache, DelVector cache, DeltaColumnGroup cache
+// and async apply thread pool.
 class UpdateManager {
 public:
     UpdateManager(MemTracker* mem_tracker);
@@ -51,6 +54,14 @@ public:
 
     Status set_cached_del_vec(const TabletSegmentId& tsid, const DelVectorPtr& delvec);
 
+    // Get the delta column groups of a segment whose versions are not greater than |version|,
+    // ordered by version in ascending order.
+    Status get_delta_column_groups(KVStore* meta, const TabletSegmentId& tsid, int64_t version,
+                                   DeltaColumnGroupList* dcgs);
+
+    // Add a newly applied delta column group of a segment to the cache.
+    void set_cached_delta_column_group(const TabletSegmentId& tsid, const DeltaColumnGroupPtr& dcg);
+
     Status on_rowset_finished(Tablet* tablet, Rowset* rowset);
 
     void on_rowset_cancel(Tablet* tablet, Rowset* rowset);
@@ -67,6 +78,8 @@ public:
 
     void clear_cached_del_vec(const std::vector<TabletSegmentId>& tsids);
 
+    void clear_cached_delta_column_groups(const std::vector<TabletSegmentId>& tsids);
+
     void expire_cache();
 
     MemTracker* mem_tracker() const { return _update_mem_tracker; }
@@ -98,6 +111,10 @@ private:
     std::unordered_map<TabletSegmentId, DelVectorPtr> _del_vec_cache;
     std::unique_ptr<MemTracker> _del_vec_cache_mem_tracker;
 
+    // all the delta column groups of a segment, empty for most of the segments
+    std::mutex _delta_column_group_cache_lock;
+    std::unordered_map<TabletSegmentId, DeltaColumnGroupList> _delta_column_group_cache;
+
     std::unique_ptr<ThreadPool> _apply_thread_pool;
 
     UpdateManager(const UpdateManager&) = delete;
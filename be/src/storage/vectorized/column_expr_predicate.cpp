@@ -3,6 +3,8 @@
 
 #include "storage/vectorized/column_expr_predicate.h"
 
+#include <algorithm>
+
 #include "column/column_helper.h"
 #include "exprs/expr.h"
 #include "exprs/expr_context.h"
@@ -11,9 +13,71 @@
 #include "runtime/descriptors.h"
 #include "runtime/primitive_type.h"
 #include "runtime/runtime_state.h"
+#include "storage/rowset/bitmap_index_reader.h"
+#include "storage/rowset/bloom_filter.h"
 #include "storage/vectorized/column_predicate.h"
+#include "util/text_tokenizer.h"
 namespace starrocks::vectorized {
 
+namespace {
+
+// Get the value of |expr| if it's a constant string.
+bool get_const_string(ExprContext* ctx, Expr* expr, std::string* value) {
+    if (!expr->is_constant() || (expr->type().type != TYPE_VARCHAR && expr->type().type != TYPE_CHAR)) {
+        return false;
+    }
+    ColumnPtr column = ctx->evaluate(expr, nullptr);
+    if (!column->is_constant() || column->only_null()) {
+        return false;
+    }
+    Slice s = ColumnHelper::get_const_value<TYPE_VARCHAR>(column);
+    value->assign(s.data, s.size);
+    return true;
+}
+
+// Get the value of |expr| if it's a constant integer.
+bool get_const_int(ExprContext* ctx, Expr* expr, int64_t* value) {
+    if (!expr->is_constant() || (expr->type().type != TYPE_INT && expr->type().type != TYPE_BIGINT)) {
+        return false;
+    }
+    ColumnPtr column = ctx->evaluate(expr, nullptr);
+    if (!column->is_constant() || column->only_null()) {
+        return false;
+    }
+    if (expr->type().type == TYPE_INT) {
+        *value = ColumnHelper::get_const_value<TYPE_INT>(column);
+    } else {
+        *value = ColumnHelper::get_const_value<TYPE_BIGINT>(column);
+    }
+    return true;
+}
+
+// Split a LIKE pattern into the literal fragments between the wildcards '%' and '_'.
+// A backslash escapes '%', '_' and itself, any other backslash ends the fragment, so that
+// the fragments are substrings of the matched values whether it's treated literally or not.
+void split_like_pattern(const std::string& pattern, std::vector<std::string>* fragments) {
+    std::string fragment;
+    for (size_t i = 0; i < pattern.size(); i++) {
+        char c = pattern[i];
+        if (c == '\\' && i + 1 < pattern.size() &&
+            (pattern[i + 1] == '%' || pattern[i + 1] == '_' || pattern[i + 1] == '\\')) {
+            fragment.push_back(pattern[++i]);
+        } else if (c == '%' || c == '_' || c == '\\') {
+            if (!fragment.empty()) {
+                fragments->emplace_back(std::move(fragment));
+                fragment.clear();
+            }
+        } else {
+            fragment.push_back(c);
+        }
+    }
+    if (!fragment.empty()) {
+        fragments->emplace_back(std::move(fragment));
+    }
+}
+
+} // namespace
+
 ColumnExprPredicate::ColumnExprPredicate(TypeInfoPtr type_info, ColumnId column_id, RuntimeState* state,
                                          ExprContext* expr_ctx, const SlotDescriptor* slot_desc)
         : ColumnPredicate(type_info, column_id), _state(state), _slot_desc(slot_desc), _monotonic(true) {
@@ -36,6 +100,71 @@ void ColumnExprPredicate::_add_expr_ctx(ExprContext* expr_ctx) {
         DCHECK_IF_ERROR(expr_ctx->clone(_state, &ctx));
         _expr_ctxs.emplace_back(ctx);
         _monotonic &= ctx->root()->is_monotonic();
+        // only the first one is from planner, the others are casts of the column.
+        if (_expr_ctxs.size() == 1) {
+            _init_ngram_substrs(ctx);
+            _init_inverted_index_terms(ctx);
+        }
+    }
+}
+
+void ColumnExprPredicate::_init_ngram_substrs(ExprContext* expr_ctx) {
+    auto is_column = [this](const Expr* expr) {
+        return _slot_desc != nullptr && expr->node_type() == TExprNodeType::SLOT_REF &&
+               down_cast<const ColumnRef*>(expr)->slot_id() == _slot_desc->id();
+    };
+    Expr* root = expr_ctx->root();
+    if (root->node_type() == TExprNodeType::FUNCTION_CALL && root->fn().name.function_name == "like") {
+        std::string pattern;
+        if (root->get_num_children() == 2 && is_column(root->get_child(0)) &&
+            get_const_string(expr_ctx, root->get_child(1), &pattern)) {
+            split_like_pattern(pattern, &_ngram_substrs);
+        }
+        return;
+    }
+
+    // the position returned by locate/instr is positive iff the substring is found
+    int64_t bound = 0;
+    if (root->node_type() != TExprNodeType::BINARY_PRED || root->get_num_children() != 2 ||
+        !get_const_int(expr_ctx, root->get_child(1), &bound)) {
+        return;
+    }
+    bool found = (root->op() == TExprOpcode::GT && bound >= 0) || (root->op() == TExprOpcode::GE && bound >= 1) ||
+                 (root->op() == TExprOpcode::NE && bound == 0);
+    Expr* call = root->get_child(0);
+    if (!found || call->node_type() != TExprNodeType::FUNCTION_CALL || call->get_num_children() != 2) {
+        return;
+    }
+    const std::string& fn_name = call->fn().name.function_name;
+    std::string substr;
+    if ((fn_name == "locate" && is_column(call->get_child(1)) &&
+         get_const_string(expr_ctx, call->get_child(0), &substr)) ||
+        (fn_name == "instr" && is_column(call->get_child(0)) &&
+         get_const_string(expr_ctx, call->get_child(1), &substr))) {
+        if (!substr.empty()) {
+            _ngram_substrs.emplace_back(std::move(substr));
+        }
+    }
+}
+
+void ColumnExprPredicate::_init_inverted_index_terms(ExprContext* expr_ctx) {
+    Expr* root = expr_ctx->root();
+    if (root->node_type() != TExprNodeType::FUNCTION_CALL || root->get_num_children() != 2) {
+        return;
+    }
+    const std::string& fn_name = root->fn().name.function_name;
+    if (fn_name != "match_all" && fn_name != "match_phrase") {
+        return;
+    }
+    const Expr* column = root->get_child(0);
+    std::string text;
+    if (_slot_desc != nullptr && column->node_type() == TExprNodeType::SLOT_REF &&
+        down_cast<const ColumnRef*>(column)->slot_id() == _slot_desc->id() &&
+        get_const_string(expr_ctx, root->get_child(1), &text)) {
+        _inverted_index_terms = TextTokenizer::tokenize(Slice(text));
+        std::sort(_inverted_index_terms.begin(), _inverted_index_terms.end());
+        _inverted_index_terms.erase(std::unique(_inverted_index_terms.begin(), _inverted_index_terms.end()),
+                                    _inverted_index_terms.end());
     }
 }
 
@@ -142,6 +271,46 @@ bool ColumnExprPredicate::zone_map_filter(const ZoneMapDetail& detail) const {
     return false;
 }
 
+bool ColumnExprPredicate::ngram_bloom_filter(const BloomFilter* bf, size_t gram_size) const {
+    for (const std::string& substr : _ngram_substrs) {
+        for (size_t i = 0; i + gram_size <= substr.size(); i++) {
+            if (!bf->test_bytes(substr.data() + i, gram_size)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// A phrase matches only if all of its terms match, so both functions select a subset of the
+// intersection of the posting lists, the order of terms is checked by evaluating the predicate.
+Status ColumnExprPredicate::seek_inverted_index(BitmapIndexIterator* iter, Roaring* rows) const {
+    if (_inverted_index_terms.empty()) {
+        return Status::Cancelled("not a term query");
+    }
+    for (size_t i = 0; i < _inverted_index_terms.size(); i++) {
+        Slice term(_inverted_index_terms[i]);
+        bool exact_match = false;
+        Status st = iter->seek_dictionary(&term, &exact_match);
+        if (st.is_not_found() || (st.ok() && !exact_match)) {
+            *rows = Roaring();
+            return Status::OK();
+        }
+        RETURN_IF_ERROR(st);
+        if (i == 0) {
+            RETURN_IF_ERROR(iter->read_bitmap(iter->current_ordinal(), rows));
+        } else {
+            Roaring postings;
+            RETURN_IF_ERROR(iter->read_bitmap(iter->current_ordinal(), &postings));
+            *rows &= postings;
+        }
+        if (rows->isEmpty()) {
+            return Status::OK();
+        }
+    }
+    return Status::OK();
+}
+
 Status ColumnExprPredicate::convert_to(const ColumnPredicate** output, const TypeInfoPtr& target_type_info,
                                        ObjectPool* obj_pool) const {
     TypeDescriptor input_type = TypeDescriptor::from_storage_type_info(target_type_info.get());
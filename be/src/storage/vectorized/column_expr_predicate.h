@@ -42,6 +42,9 @@ public:
 
     bool zone_map_filter(const ZoneMapDetail& detail) const override;
     bool support_bloom_filter() const override { return false; }
+    bool support_ngram_bloom_filter() const override { return !_ngram_substrs.empty(); }
+    bool ngram_bloom_filter(const BloomFilter* bf, size_t gram_size) const override;
+    Status seek_inverted_index(BitmapIndexIterator* iter, Roaring* rows) const override;
     PredicateType type() const override { return PredicateType::kExpr; }
     bool can_vectorized() const override { return true; }
 
@@ -53,10 +56,18 @@ public:
 
 private:
     void _add_expr_ctx(ExprContext* expr_ctx);
+    // Collect the substrings which every value selected by |expr_ctx| contains, if |expr_ctx| is
+    // `slot LIKE 'pattern'`, `locate('substr', slot) > 0` or `instr(slot, 'substr') > 0`.
+    void _init_ngram_substrs(ExprContext* expr_ctx);
+    // Collect the terms which every value selected by |expr_ctx| contains, if |expr_ctx| is
+    // `match_all(slot, 'text')` or `match_phrase(slot, 'text')`.
+    void _init_inverted_index_terms(ExprContext* expr_ctx);
     RuntimeState* _state;
     std::vector<ExprContext*> _expr_ctxs;
     const SlotDescriptor* _slot_desc;
     bool _monotonic;
+    std::vector<std::string> _ngram_substrs;
+    std::vector<std::string> _inverted_index_terms;
     mutable std::vector<uint8_t> _tmp_select;
 };
 
@@ -169,10 +169,21 @@ public:
     // Return false to filter out a data page.
     virtual bool bloom_filter(const BloomFilter* bf) const { return true; }
 
+    virtual bool support_ngram_bloom_filter() const { return false; }
+
+    // Return false to filter out a data page, |bf| contains the grams of |gram_size| bytes of the page.
+    virtual bool ngram_bloom_filter(const BloomFilter* bf, size_t gram_size) const { return true; }
+
     virtual Status seek_bitmap_dictionary(BitmapIndexIterator* iter, SparseRange* range) const {
         return Status::Cancelled("not implemented");
     }
 
+    // Set |rows| to a superset of the rows matching this predicate, |iter| iterates an inverted index.
+    // The predicate is still evaluated on the returned rows, it's not erased like the bitmap index does.
+    virtual Status seek_inverted_index(BitmapIndexIterator* iter, Roaring* rows) const {
+        return Status::Cancelled("not implemented");
+    }
+
     // Indicate whether or not the evaluate can be vectorized.
     // If this function return true, evaluate function will be vectorized and can achieve
     // good performance.
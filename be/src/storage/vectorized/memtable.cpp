@@ -3,6 +3,7 @@
 #include "storage/vectorized/memtable.h"
 
 #include <memory>
+#include <numeric>
 
 #include "column/json_column.h"
 #include "column/type_traits.h"
@@ -48,6 +49,10 @@ MemTable::MemTable(int64_t tablet_id, const TabletSchema* tablet_schema, const s
         // otherwise it will take up a lot of memory and may not be released.
         _aggregator = std::make_unique<ChunkAggregator>(&_vectorized_schema, 0, INT_MAX, 0);
     }
+    if ((_keys_type == KeysType::AGG_KEYS || _keys_type == KeysType::UNIQUE_KEYS) &&
+        config::enable_memtable_hash_aggregation) {
+        _key_index = std::make_unique<KeyIndex>();
+    }
 }
 
 MemTable::~MemTable() = default;
@@ -58,6 +63,9 @@ size_t MemTable::memory_usage() const {
     // used for sort
     size += sizeof(PermutationItem) * _permutations.size();
     size += sizeof(uint32_t) * _selective_values.size();
+    if (_key_index != nullptr) {
+        size += _key_index->memory_usage();
+    }
 
     // _result_chunk is the final result before flush
     if (_result_chunk != nullptr && _result_chunk->num_rows() > 0) {
@@ -74,7 +82,12 @@ size_t MemTable::write_buffer_size() const {
     }
 
     // _aggregator_bytes_usage is 0 if keys type is DUP_KEYS
-    return _chunk_bytes_usage + _aggregator_bytes_usage;
+    size_t size = _chunk_bytes_usage + _aggregator_bytes_usage;
+    // the key index grows with the distinct keys, which are not reduced by merges.
+    if (_key_index != nullptr) {
+        size += _key_index->memory_usage();
+    }
+    return size;
 }
 
 bool MemTable::is_full() const {
@@ -85,6 +98,7 @@ bool MemTable::insert(const Chunk& chunk, const uint32_t* indexes, uint32_t from
     if (_chunk == nullptr) {
         _chunk = ChunkHelper::new_chunk(_vectorized_schema, 0);
     }
+    const size_t old_rows = _chunk->num_rows();
 
     // For schema change, FE will construct a shadow column.
     // The shadow column is not exist in _vectorized_schema
@@ -95,6 +109,9 @@ bool MemTable::insert(const Chunk& chunk, const uint32_t* indexes, uint32_t from
         ColumnPtr& dest = _chunk->get_column_by_index(i);
         dest->append_selective(*src, indexes, from, size);
     }
+    if (_key_index != nullptr) {
+        _index_keys(old_rows);
+    }
 
     if (chunk.has_rows()) {
         _chunk_memory_usage += chunk.memory_usage() * size / chunk.num_rows();
@@ -133,31 +150,38 @@ Status MemTable::finalize() {
         SCOPED_RAW_TIMER(&duration_ns);
 
         if (_keys_type != DUP_KEYS) {
-            if (_chunk->num_rows() > 0) {
-                // merge last undo merge
+            if (_key_index != nullptr) {
+                // every hash merge aggregates all the rows, no need to perform an additional merge.
                 _merge();
-            }
-
-            if (_merge_count > 1) {
-                _chunk = _aggregator->aggregate_result();
-                _aggregator->aggregate_reset();
-
-                int64_t t1 = MonotonicMicros();
-                _sort(true);
-                int64_t t2 = MonotonicMicros();
-                _aggregate(true);
-                int64_t t3 = MonotonicMicros();
-                VLOG(1) << Substitute("memtable final sort:$0 agg:$1 total:$2", t2 - t1, t3 - t2, t3 - t1);
+                _result_chunk = std::move(_chunk);
+                _key_index.reset();
             } else {
-                // if there is only one data chunk and merge once,
-                // no need to perform an additional merge.
-                _chunk.reset();
-                _result_chunk.reset();
+                if (_chunk->num_rows() > 0) {
+                    // merge last undo merge
+                    _merge();
+                }
+
+                if (_merge_count > 1) {
+                    _chunk = _aggregator->aggregate_result();
+                    _aggregator->aggregate_reset();
+
+                    int64_t t1 = MonotonicMicros();
+                    _sort(true);
+                    int64_t t2 = MonotonicMicros();
+                    _aggregate(true);
+                    int64_t t3 = MonotonicMicros();
+                    VLOG(1) << Substitute("memtable final sort:$0 agg:$1 total:$2", t2 - t1, t3 - t2, t3 - t1);
+                } else {
+                    // if there is only one data chunk and merge once,
+                    // no need to perform an additional merge.
+                    _chunk.reset();
+                    _result_chunk.reset();
+                }
+                _result_chunk = _aggregator->aggregate_result();
             }
             _chunk_memory_usage = 0;
             _chunk_bytes_usage = 0;
 
-            _result_chunk = _aggregator->aggregate_result();
             if (_keys_type == PRIMARY_KEYS &&
                 PrimaryKeyEncoder::encode_exceed_limit(_vectorized_schema, *_result_chunk.get(), 0,
                                                        _result_chunk->num_rows(), kPrimaryKeyLimitSize)) {
@@ -209,6 +233,13 @@ void MemTable::_merge() {
     if (_chunk == nullptr || _keys_type == KeysType::DUP_KEYS) {
         return;
     }
+    if (_key_index != nullptr) {
+        int64_t t1 = MonotonicMicros();
+        _hash_merge();
+        VLOG(1) << Substitute("memtable hash merge:$0", MonotonicMicros() - t1);
+        ++_merge_count;
+        return;
+    }
 
     int64_t t1 = MonotonicMicros();
     _sort(false);
@@ -219,6 +250,105 @@ void MemTable::_merge() {
     ++_merge_count;
 }
 
+void MemTable::_index_keys(size_t from) {
+    const size_t num_keys = _tablet_schema->num_key_columns();
+    const size_t num_rows = _chunk->num_rows();
+    KeyIndex& index = *_key_index;
+    index.row_groups.reserve(num_rows);
+    for (size_t i = from; i < num_rows; i++) {
+        size_t max_size = 0;
+        for (size_t k = 0; k < num_keys; k++) {
+            max_size += _chunk->get_column_by_index(k)->serialize_size(i);
+        }
+        index.key_buffer.resize(max_size);
+        uint8_t* pos = index.key_buffer.data();
+        for (size_t k = 0; k < num_keys; k++) {
+            pos += _chunk->get_column_by_index(k)->serialize(i, pos);
+        }
+        Slice key(index.key_buffer.data(), pos - index.key_buffer.data());
+        auto iter = index.groups.lazy_emplace(key, [&](const auto& ctor) {
+            uint8_t* data = index.key_pool.allocate(key.size);
+            memcpy(data, key.data, key.size);
+            ctor(Slice(data, key.size), static_cast<uint32_t>(index.group_rows.size()));
+            index.group_rows.push_back(i);
+        });
+        index.row_groups.push_back(iter->second);
+    }
+}
+
+void MemTable::_hash_merge() {
+    KeyIndex& index = *_key_index;
+    const size_t num_rows = _chunk->num_rows();
+    const size_t num_groups = index.group_rows.size();
+    DCHECK_EQ(num_rows, index.row_groups.size());
+    if (num_rows == index.merged_rows) {
+        return;
+    }
+
+    // sort the distinct keys by the first row of each group.
+    const size_t num_keys = _tablet_schema->num_key_columns();
+    std::vector<uint32_t> sorted_groups(num_groups);
+    std::iota(sorted_groups.begin(), sorted_groups.end(), 0);
+    pdqsort(false, sorted_groups.begin(), sorted_groups.end(), [&](uint32_t l, uint32_t r) {
+        for (size_t k = 0; k < num_keys; k++) {
+            const auto& col = _chunk->get_column_by_index(k);
+            int c = col->compare_at(index.group_rows[l], index.group_rows[r], *col, -1);
+            if (c != 0) {
+                return c < 0;
+            }
+        }
+        return false;
+    });
+    std::vector<uint32_t> group_pos(num_groups);
+    for (uint32_t i = 0; i < num_groups; i++) {
+        group_pos[sorted_groups[i]] = i;
+    }
+
+    // place the rows group by group, the rows of a group are kept in the order of arrival,
+    // which is required by the REPLACE aggregation.
+    std::vector<uint32_t> offsets(num_groups + 1, 0);
+    for (uint32_t group : index.row_groups) {
+        offsets[group_pos[group] + 1]++;
+    }
+    for (size_t i = 1; i <= num_groups; i++) {
+        offsets[i] += offsets[i - 1];
+    }
+    _selective_values.resize(num_rows);
+    for (uint32_t i = 0; i < num_rows; i++) {
+        _selective_values[offsets[group_pos[index.row_groups[i]]]++] = i;
+    }
+    _result_chunk = _chunk->clone_empty_with_schema(0);
+    _result_chunk->rolling_append_selective(*_chunk, _selective_values.data(), 0, num_rows);
+    _chunk.reset();
+
+    DCHECK(_aggregator->source_exhausted());
+    _aggregator->update_source(_result_chunk);
+    _aggregator->aggregate();
+    _chunk = _aggregator->aggregate_result();
+    _aggregator->aggregate_reset();
+    _result_chunk.reset();
+
+    if (_chunk->num_rows() == num_groups) {
+        // group i is the i-th row now.
+        for (auto& [key, group] : index.groups) {
+            group = group_pos[group];
+        }
+        std::iota(index.group_rows.begin(), index.group_rows.end(), 0);
+        index.row_groups.resize(num_groups);
+        std::iota(index.row_groups.begin(), index.row_groups.end(), 0);
+    } else {
+        // the keys serialized differently are equal in comparison, rebuild the index.
+        index.groups.clear();
+        index.key_pool.clear();
+        index.group_rows.clear();
+        index.row_groups.clear();
+        _index_keys(0);
+    }
+    index.merged_rows = _chunk->num_rows();
+    _chunk_memory_usage = _chunk->memory_usage();
+    _chunk_bytes_usage = _chunk->bytes_usage();
+}
+
 void MemTable::_aggregate(bool is_final) {
     if (_result_chunk == nullptr || _result_chunk->num_rows() <= 0) {
         return;
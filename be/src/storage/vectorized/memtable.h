@@ -5,9 +5,12 @@
 #include <ostream>
 
 #include "column/chunk.h"
+#include "column/column_hash.h"
 #include "gen_cpp/olap_file.pb.h"
+#include "runtime/mem_pool.h"
 #include "storage/olap_define.h"
 #include "storage/vectorized/chunk_aggregator.h"
+#include "util/phmap/phmap.h"
 
 namespace starrocks {
 
@@ -45,6 +48,12 @@ public:
 private:
     void _merge();
 
+    // Assign the group of the key of rows [from, _chunk->num_rows()) in |_chunk|.
+    void _index_keys(size_t from);
+    // Aggregate |_chunk| by the groups of |_key_index|, only the distinct keys are sorted.
+    // Upon return, |_chunk| is sorted and aggregated, and the group of row i is i.
+    void _hash_merge();
+
     void _sort(bool is_final);
     void _sort_chunk_by_columns();
     void _sort_chunk_by_rows();
@@ -83,8 +92,28 @@ private:
     // aggregate
     std::unique_ptr<ChunkAggregator> _aggregator;
 
+    // number of the merges, the results of the merges by sort are merged again by finalize.
     uint64_t _merge_count = 0;
 
+    // Only set for aggregate and unique keys tables if enable_memtable_hash_aggregation is true.
+    // Serialized key columns to the group id, and the group id of the rows in |_chunk|.
+    struct KeyIndex {
+        phmap::flat_hash_map<Slice, uint32_t, SliceHashWithSeed<PhmapSeed1>, SliceEqual> groups;
+        // the first row of each group in |_chunk|
+        std::vector<uint32_t> group_rows;
+        std::vector<uint32_t> row_groups;
+        MemPool key_pool;
+        std::vector<uint8_t> key_buffer;
+        // rows [0, merged_rows) of |_chunk| are sorted and aggregated
+        size_t merged_rows = 0;
+
+        size_t memory_usage() const {
+            return groups.capacity() * (sizeof(Slice) + sizeof(uint32_t) + 1) + key_pool.total_reserved_bytes() +
+                   (group_rows.capacity() + row_groups.capacity()) * sizeof(uint32_t) + key_buffer.capacity();
+        }
+    };
+    std::unique_ptr<KeyIndex> _key_index;
+
     bool _has_op_slot = false;
     std::unique_ptr<Column> _deletes;
 
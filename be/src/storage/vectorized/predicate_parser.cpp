@@ -15,8 +15,12 @@
 namespace starrocks::vectorized {
 
 bool PredicateParser::can_pushdown(const ColumnPredicate* predicate) const {
-    RETURN_IF(predicate->column_id() >= _schema.num_columns(), false);
-    const TabletColumn& column = _schema.column(predicate->column_id());
+    return can_pushdown(predicate->column_id());
+}
+
+bool PredicateParser::can_pushdown(uint32_t column_id) const {
+    RETURN_IF(column_id >= _schema.num_columns(), false);
+    const TabletColumn& column = _schema.column(column_id);
     return _schema.keys_type() == KeysType::PRIMARY_KEYS ||
            column.aggregation() == FieldAggregationMethod::OLAP_FIELD_AGGREGATION_NONE;
 }
@@ -20,6 +20,9 @@ public:
 
     bool can_pushdown(const ColumnPredicate* predicate) const;
 
+    // Whether the rows could be filtered by the values of |column_id| before aggregation.
+    bool can_pushdown(uint32_t column_id) const;
+
     // Parse |condition| into a predicate that can be pushed down.
     // return nullptr if parse failed.
     ColumnPredicate* parse_thrift_cond(const TCondition& condition) const;
@@ -0,0 +1,50 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <vector>
+
+#include "common/status.h"
+#include "storage/olap_common.h"
+
+namespace starrocks {
+class ObjectPool;
+}
+
+namespace starrocks::vectorized {
+
+class Column;
+class ColumnPredicate;
+
+// RuntimeFilterPredicate is a join runtime filter on a column of the tablet, which may arrive after
+// the scan has started. SegmentIterator checks whether it has arrived at the boundaries of the chunks
+// it reads. Once arrived, the min/max of the filter is used to prune the remaining row ranges by zone
+// map, and the bloom filter is probed on the column before the other columns are late materialized.
+//
+// A RuntimeFilterPredicate is used by one reader at a time, so it isn't thread-safe.
+class RuntimeFilterPredicate {
+public:
+    explicit RuntimeFilterPredicate(ColumnId column_id) : _column_id(column_id) {}
+    virtual ~RuntimeFilterPredicate() = default;
+
+    ColumnId column_id() const { return _column_id; }
+
+    // Once true, it remains true.
+    virtual bool is_ready() const = 0;
+
+    // Create the predicates on the min and max value of the filter into |pool|, which are used to
+    // prune the data pages by zone map. Nothing is created if the filter has no min/max.
+    // Must be called after the filter is ready.
+    virtual Status get_zone_map_predicates(ObjectPool* pool, std::vector<const ColumnPredicate*>* preds) const = 0;
+
+    // Probe the bloom filter with the values of |column|, and AND the result into |selection|, whose
+    // size is |column->size()|. Must be called after the filter is ready.
+    virtual void evaluate_and(Column* column, uint8_t* selection) const = 0;
+
+private:
+    const ColumnId _column_id;
+};
+
+using RuntimeFilterPredicates = std::vector<const RuntimeFilterPredicate*>;
+
+} // namespace starrocks::vectorized
@@ -1393,6 +1393,12 @@ Status SchemaChangeHandler::_parse_request(
             } else if (new_column.has_bitmap_index() != ref_column.has_bitmap_index()) {
                 *sc_directly = true;
                 return Status::OK();
+            } else if (new_column.has_ngram_bf_index() != ref_column.has_ngram_bf_index()) {
+                *sc_directly = true;
+                return Status::OK();
+            } else if (new_column.has_inverted_index() != ref_column.has_inverted_index()) {
+                *sc_directly = true;
+                return Status::OK();
             }
         }
     }
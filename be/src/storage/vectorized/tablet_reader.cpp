@@ -41,6 +41,15 @@ TabletReader::TabletReader(TabletSharedPtr tablet, const Version& version, Schem
     DCHECK(_mask_buffer);
 }
 
+TabletReader::TabletReader(TabletSharedPtr tablet, const Version& version, Schema schema,
+                           std::vector<RowsetSplit> rowset_splits)
+        : ChunkIterator(std::move(schema)),
+          _tablet(tablet),
+          _version(version),
+          _delete_predicates_version(version),
+          _rowset_splits(std::move(rowset_splits)),
+          _is_vertical_merge(false) {}
+
 void TabletReader::close() {
     if (_collect_iter != nullptr) {
         _collect_iter->close();
@@ -50,6 +59,11 @@ void TabletReader::close() {
 }
 
 Status TabletReader::prepare() {
+    if (!_rowset_splits.empty()) {
+        // The rowsets have been captured when splitting.
+        _stats.rowsets_read_count += _rowset_splits.size();
+        return Status::OK();
+    }
     std::shared_lock l(_tablet->get_header_lock());
     auto st = _tablet->capture_consistent_rowsets(_version, &_rowsets);
     _stats.rowsets_read_count += _rowsets.size();
@@ -63,6 +77,7 @@ Status TabletReader::open(const TabletReaderParams& read_params) {
     }
     Status st = _init_collector(read_params);
     _rowsets.clear(); // unused anymore.
+    _rowset_splits.clear();
     return st;
 }
 
@@ -85,6 +100,7 @@ Status TabletReader::get_segment_iterators(const TabletReaderParams& params, std
     RETURN_IF_ERROR(_init_delete_predicates(params, &_delete_predicates));
     RETURN_IF_ERROR(_parse_seek_range(params, &rs_opts.ranges));
     rs_opts.predicates = _pushdown_predicates;
+    rs_opts.runtime_filter_preds = params.runtime_filter_preds;
     rs_opts.sorted = (keys_type != DUP_KEYS && keys_type != PRIMARY_KEYS) && !params.skip_aggregation;
     rs_opts.reader_type = params.reader_type;
     rs_opts.chunk_size = params.chunk_size;
@@ -106,6 +122,11 @@ Status TabletReader::get_segment_iterators(const TabletReaderParams& params, std
     for (auto& rowset : _rowsets) {
         RETURN_IF_ERROR(rowset->get_segment_iterators(schema(), rs_opts, iters));
     }
+    for (auto& split : _rowset_splits) {
+        rs_opts.segment_begin = split.segment_begin;
+        rs_opts.segment_end = split.segment_end;
+        RETURN_IF_ERROR(split.rowset->get_segment_iterators(schema(), rs_opts, iters));
+    }
     return Status::OK();
 }
 
@@ -23,6 +23,9 @@ public:
     TabletReader(TabletSharedPtr tablet, const Version& version, Schema schema);
     TabletReader(TabletSharedPtr tablet, const Version& version, Schema schema, bool is_key,
                  RowSourceMaskBuffer* mask_buffer);
+    // Read only the given parts of the rowsets captured in advance, instead of all the rowsets of |version|.
+    TabletReader(TabletSharedPtr tablet, const Version& version, Schema schema,
+                 std::vector<RowsetSplit> rowset_splits);
     ~TabletReader() override { close(); }
 
     Status prepare();
@@ -68,6 +71,8 @@ private:
     PredicateList _predicate_free_list;
 
     std::vector<RowsetSharedPtr> _rowsets;
+    // Non-empty if the reader only reads parts of the rowsets, and _rowsets is not used.
+    std::vector<RowsetSplit> _rowset_splits;
     std::shared_ptr<ChunkIterator> _collect_iter;
 
     OlapReaderStatistics _stats;
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -10,11 +11,14 @@
 #include "storage/olap_common.h"
 #include "storage/tuple.h"
 #include "storage/vectorized/chunk_iterator.h"
+#include "storage/vectorized/runtime_filter_predicate.h"
 
 namespace starrocks {
 
 class RuntimeProfile;
 class RuntimeState;
+class Rowset;
+using RowsetSharedPtr = std::shared_ptr<Rowset>;
 
 namespace vectorized {
 
@@ -22,6 +26,13 @@ class ColumnPredicate;
 
 static inline std::unordered_set<uint32_t> EMPTY_FILTERED_COLUMN_IDS;
 
+// A part of a rowset to read, which consists of the segments in [segment_begin, segment_end).
+struct RowsetSplit {
+    RowsetSharedPtr rowset;
+    uint32_t segment_begin = 0;
+    uint32_t segment_end = 0;
+};
+
 // Params for TabletReader
 struct TabletReaderParams {
     TabletReaderParams();
@@ -44,6 +55,9 @@ struct TabletReaderParams {
     std::vector<OlapTuple> start_key;
     std::vector<OlapTuple> end_key;
     std::vector<const ColumnPredicate*> predicates;
+    // The join runtime filters which may arrive during the scan. Only the ones on the columns
+    // which could be filtered before aggregation are allowed, as |predicates|.
+    RuntimeFilterPredicates runtime_filter_preds;
 
     RuntimeState* runtime_state = nullptr;
 
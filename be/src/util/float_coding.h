@@ -0,0 +1,438 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "common/logging.h"
+#include "util/bit_stream_utils.h"
+#include "util/bit_stream_utils.inline.h"
+#include "util/faststring.h"
+
+namespace starrocks {
+
+template <typename T>
+struct FloatCodingTraits {};
+
+template <>
+struct FloatCodingTraits<float> {
+    using UInt = uint32_t;
+    using Int = int32_t;
+    // max exponent of 10 tried by ALP
+    static constexpr int kMaxExponent = 10;
+    // integers encoded by ALP are in (-kMaxInt, kMaxInt), which are represented by float exactly
+    static constexpr float kMaxInt = 8388608.0f;
+    // adding and subtracting it rounds a float in (-kMaxInt, kMaxInt) to integer
+    static constexpr float kRoundMagic = 12582912.0f;
+    static constexpr float kPow10[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+    static constexpr float kInvPow10[] = {1e0f,  1e-1f, 1e-2f, 1e-3f, 1e-4f, 1e-5f,
+                                          1e-6f, 1e-7f, 1e-8f, 1e-9f, 1e-10f};
+
+    static int count_leading_zeros(UInt v) { return __builtin_clz(v); }
+    static int count_trailing_zeros(UInt v) { return __builtin_ctz(v); }
+};
+
+template <>
+struct FloatCodingTraits<double> {
+    using UInt = uint64_t;
+    using Int = int64_t;
+    static constexpr int kMaxExponent = 18;
+    static constexpr double kMaxInt = 4503599627370496.0;
+    static constexpr double kRoundMagic = 6755399441055744.0;
+    static constexpr double kPow10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8, 1e9,
+                                        1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18};
+    static constexpr double kInvPow10[] = {1e0,   1e-1,  1e-2,  1e-3,  1e-4,  1e-5,  1e-6,  1e-7,  1e-8, 1e-9,
+                                           1e-10, 1e-11, 1e-12, 1e-13, 1e-14, 1e-15, 1e-16, 1e-17, 1e-18};
+
+    static int count_leading_zeros(UInt v) { return __builtin_clzll(v); }
+    static int count_trailing_zeros(UInt v) { return __builtin_ctzll(v); }
+};
+
+// XOR based coding of floating point values from Gorilla, see https://www.vldb.org/pvldb/vol8/p1816-teller.pdf
+// The first value is stored as is, and each of the following values is XORed with the previous one:
+//   '0'                                               if the XOR is zero
+//   '10' + meaningful bits                            if the meaningful bits of the XOR fit in the
+//                                                     window of the last '11' value
+//   '11' + leading zeros (5 bits) + number of meaningful bits - 1 (6 bits) + meaningful bits
+// It works well for slowly changing values like gauges and counters.
+template <typename T>
+class GorillaEncoder {
+public:
+    using Traits = FloatCodingTraits<T>;
+    using UInt = typename Traits::UInt;
+    static constexpr int kBits = sizeof(T) * 8;
+
+    explicit GorillaEncoder(faststring* buffer) : _writer(buffer) {}
+
+    void add(const T* vals, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            UInt v;
+            memcpy(&v, &vals[i], sizeof(T));
+            _put(v);
+        }
+    }
+
+    // Flush the buffered bits, the encoded bytes are in the buffer afterwards.
+    void flush() { _writer.Flush(); }
+
+    void clear() {
+        _writer.Clear();
+        _count = 0;
+        _prev = 0;
+        _window_bits = 0;
+    }
+
+    size_t count() const { return _count; }
+
+    size_t bytes_written() const { return _writer.bytes_written(); }
+
+private:
+    void _put(UInt v) {
+        if (_count++ == 0) {
+            _writer.PutValue(v, kBits);
+            _prev = v;
+            return;
+        }
+        UInt x = v ^ _prev;
+        _prev = v;
+        if (x == 0) {
+            _writer.PutValue(0, 1);
+            return;
+        }
+        int leading = std::min(Traits::count_leading_zeros(x), 31);
+        int trailing = Traits::count_trailing_zeros(x);
+        if (_window_bits > 0 && leading >= _leading && trailing >= _trailing) {
+            // bits are written from the lowest one, so '1' followed by '0'
+            _writer.PutValue(1, 2);
+            _writer.PutValue(x >> _trailing, _window_bits);
+        } else {
+            int meaningful = kBits - leading - trailing;
+            _writer.PutValue(3, 2);
+            _writer.PutValue(leading, 5);
+            _writer.PutValue(meaningful - 1, 6);
+            _writer.PutValue(x >> trailing, meaningful);
+            _leading = leading;
+            _trailing = trailing;
+            _window_bits = meaningful;
+        }
+    }
+
+    BitWriter _writer;
+    size_t _count = 0;
+    UInt _prev = 0;
+    int _leading = 0;
+    int _trailing = 0;
+    int _window_bits = 0;
+};
+
+template <typename T>
+class GorillaDecoder {
+public:
+    using Traits = FloatCodingTraits<T>;
+    using UInt = typename Traits::UInt;
+    static constexpr int kBits = sizeof(T) * 8;
+
+    GorillaDecoder() = default;
+
+    void init(const uint8_t* data, size_t size, size_t count) {
+        _data = data;
+        _size = size;
+        _count = count;
+        _rewind();
+    }
+
+    size_t current_index() const { return _index; }
+
+    // Decode the next |n| values into |out|, return false if the data is broken.
+    bool next_batch(T* out, size_t n) {
+        for (size_t i = 0; i < n; i++) {
+            if (!_next()) {
+                return false;
+            }
+            memcpy(&out[i], &_prev, sizeof(T));
+        }
+        return true;
+    }
+
+    bool seek(size_t pos) {
+        if (pos < _index) {
+            _rewind();
+        }
+        while (_index < pos) {
+            if (!_next()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    void _rewind() {
+        _reader = BitReader(_data, static_cast<int>(_size));
+        _index = 0;
+        _prev = 0;
+        _window_bits = 0;
+    }
+
+    bool _next() {
+        if (_index >= _count) {
+            return false;
+        }
+        if (_index++ == 0) {
+            return _reader.GetValue(kBits, &_prev);
+        }
+        uint64_t bit = 0;
+        if (!_reader.GetValue(1, &bit)) {
+            return false;
+        }
+        if (bit == 0) {
+            return true;
+        }
+        if (!_reader.GetValue(1, &bit)) {
+            return false;
+        }
+        if (bit == 1) {
+            uint64_t leading = 0;
+            uint64_t meaningful = 0;
+            if (!_reader.GetValue(5, &leading) || !_reader.GetValue(6, &meaningful)) {
+                return false;
+            }
+            _window_bits = static_cast<int>(meaningful) + 1;
+            _trailing = kBits - static_cast<int>(leading) - _window_bits;
+            if (_trailing < 0) {
+                return false;
+            }
+        } else if (_window_bits == 0) {
+            return false;
+        }
+        uint64_t x = 0;
+        if (!_reader.GetValue(_window_bits, &x)) {
+            return false;
+        }
+        _prev ^= static_cast<UInt>(x << _trailing);
+        return true;
+    }
+
+    const uint8_t* _data = nullptr;
+    size_t _size = 0;
+    size_t _count = 0;
+    size_t _index = 0;
+    BitReader _reader;
+    UInt _prev = 0;
+    int _trailing = 0;
+    int _window_bits = 0;
+};
+
+// ALP (Adaptive Lossless floating-Point) coding, see https://dl.acm.org/doi/10.1145/3626717
+// A value v is encoded as the integer round(v * 10^e * 10^-f) if the integer multiplied by
+// 10^f and divided by 10^e gives v back exactly, it works well for decimals stored as floating point values.
+// The values can't be encoded are exceptions stored as is.
+//
+// The encoded data format is:
+//   | exponent e (1) | factor f (1) | bit width (1) | exception count (4) | reference (8) |
+//   | integer - reference, bit-packed |
+//   | exception positions (4 each) | exception values |
+// The packed integers of exceptions are 0, and the integers are packed in groups of 32, so any
+// group can be unpacked directly.
+template <typename T>
+class AlpCoding {
+public:
+    using Traits = FloatCodingTraits<T>;
+    using UInt = typename Traits::UInt;
+    using Int = typename Traits::Int;
+    static constexpr size_t kHeaderSize = 15;
+    static constexpr size_t kGroupSize = 32;
+
+    struct Params {
+        int exponent = 0;
+        int factor = 0;
+    };
+
+    // Return the integer of |v| with |params|, or false if |v| is an exception.
+    static bool encode_value(T v, const Params& params, Int* n) {
+        T scaled = v * Traits::kPow10[params.exponent] * Traits::kInvPow10[params.factor];
+        // also false for NaN
+        if (!(scaled > -Traits::kMaxInt && scaled < Traits::kMaxInt)) {
+            return false;
+        }
+        *n = static_cast<Int>(scaled + Traits::kRoundMagic - Traits::kRoundMagic);
+        T decoded = decode_value(*n, params);
+        // -0.0 is an exception
+        return memcmp(&decoded, &v, sizeof(T)) == 0;
+    }
+
+    static T decode_value(Int n, const Params& params) {
+        // dividing by the exact 10^e, instead of multiplying by the inexact 10^-e, gives back all the values
+        // converted from decimals with no more than e digits
+        return static_cast<T>(n) * Traits::kPow10[params.factor] / Traits::kPow10[params.exponent];
+    }
+
+    // Choose the exponent and factor by the estimated size of a sample of |vals|.
+    // Return the estimated bits per value.
+    static double choose_params(const T* vals, size_t count, size_t max_samples, Params* best) {
+        const size_t step = std::max<size_t>(1, count / max_samples);
+        double best_bits = std::numeric_limits<double>::max();
+        // prefer the smallest exponent among the params with the same estimated size
+        for (int e = 0; e <= Traits::kMaxExponent; e++) {
+            for (int f = 0; f <= e; f++) {
+                Params params{e, f};
+                size_t samples = 0;
+                size_t exceptions = 0;
+                Int min = std::numeric_limits<Int>::max();
+                Int max = std::numeric_limits<Int>::min();
+                for (size_t i = 0; i < count; i += step) {
+                    samples++;
+                    Int n;
+                    if (!encode_value(vals[i], params, &n)) {
+                        exceptions++;
+                        continue;
+                    }
+                    min = std::min(min, n);
+                    max = std::max(max, n);
+                }
+                int width = min <= max ? _bit_width(static_cast<uint64_t>(max) - static_cast<uint64_t>(min)) : 0;
+                double bits = (static_cast<double>(samples) * width + exceptions * (sizeof(T) + 4) * 8.0) / samples;
+                if (bits < best_bits) {
+                    best_bits = bits;
+                    *best = params;
+                }
+            }
+        }
+        return best_bits;
+    }
+
+    // Append the encoded |vals| to |buf|.
+    static void encode(const T* vals, size_t count, const Params& params, faststring* buf) {
+        std::vector<Int> ints(count);
+        std::vector<uint32_t> exception_positions;
+        std::vector<T> exceptions;
+        Int min = std::numeric_limits<Int>::max();
+        Int max = std::numeric_limits<Int>::min();
+        for (size_t i = 0; i < count; i++) {
+            if (encode_value(vals[i], params, &ints[i])) {
+                min = std::min(min, ints[i]);
+                max = std::max(max, ints[i]);
+            } else {
+                exception_positions.push_back(i);
+                exceptions.push_back(vals[i]);
+            }
+        }
+        if (min > max) {
+            min = max = 0;
+        }
+        for (uint32_t pos : exception_positions) {
+            ints[pos] = min;
+        }
+        const int width = _bit_width(static_cast<uint64_t>(max) - static_cast<uint64_t>(min));
+
+        uint8_t header[kHeaderSize];
+        header[0] = params.exponent;
+        header[1] = params.factor;
+        header[2] = width;
+        uint32_t num_exceptions = exceptions.size();
+        int64_t reference = min;
+        memcpy(header + 3, &num_exceptions, 4);
+        memcpy(header + 7, &reference, 8);
+        buf->append(header, kHeaderSize);
+
+        faststring packed;
+        BitWriter writer(&packed);
+        for (size_t i = 0; i < count && width > 0; i++) {
+            writer.PutValue(static_cast<uint64_t>(ints[i]) - static_cast<uint64_t>(min), width);
+        }
+        writer.Flush();
+        buf->append(packed.data(), _packed_size(count, width));
+        buf->append(exception_positions.data(), exception_positions.size() * sizeof(uint32_t));
+        buf->append(exceptions.data(), exceptions.size() * sizeof(T));
+    }
+
+    AlpCoding() = default;
+
+    // Parse the data encoded by `encode`, return false if the data is broken.
+    bool init(const uint8_t* data, size_t size, size_t count) {
+        if (size < kHeaderSize) {
+            return false;
+        }
+        _params.exponent = data[0];
+        _params.factor = data[1];
+        _width = data[2];
+        uint32_t num_exceptions;
+        int64_t reference;
+        memcpy(&num_exceptions, data + 3, 4);
+        memcpy(&reference, data + 7, 8);
+        _reference = reference;
+        if (_params.exponent > Traits::kMaxExponent || _params.factor > _params.exponent ||
+            _width > sizeof(T) * 8) {
+            return false;
+        }
+        _count = count;
+        _packed = data + kHeaderSize;
+        _packed_bytes = _packed_size(count, _width);
+        if (kHeaderSize + _packed_bytes + num_exceptions * (sizeof(uint32_t) + sizeof(T)) != size) {
+            return false;
+        }
+        const uint8_t* p = _packed + _packed_bytes;
+        _exception_positions.resize(num_exceptions);
+        _exceptions.resize(num_exceptions);
+        memcpy(_exception_positions.data(), p, num_exceptions * sizeof(uint32_t));
+        memcpy(_exceptions.data(), p + num_exceptions * sizeof(uint32_t), num_exceptions * sizeof(T));
+        return true;
+    }
+
+    // Decode the values in [pos, pos + n) into |out|.
+    void decode(size_t pos, size_t n, T* out) const {
+        DCHECK_LE(pos + n, _count);
+        // unpack the integers into |out| first, and then convert them in place
+        auto* ints = reinterpret_cast<UInt*>(out);
+        size_t done = 0;
+        if (pos % kGroupSize != 0 && n > 0) {
+            UInt group[kGroupSize];
+            size_t group_begin = pos - pos % kGroupSize;
+            size_t group_size = std::min(kGroupSize, _count - group_begin);
+            _unpack(group_begin, group_size, group);
+            done = std::min(n, group_begin + group_size - pos);
+            memcpy(ints, group + (pos - group_begin), done * sizeof(UInt));
+        }
+        if (done < n) {
+            _unpack(pos + done, n - done, ints + done);
+        }
+        const T f = Traits::kPow10[_params.factor];
+        const T e = Traits::kPow10[_params.exponent];
+        const UInt reference = static_cast<UInt>(_reference);
+        for (size_t i = 0; i < n; i++) {
+            UInt v;
+            memcpy(&v, &ints[i], sizeof(UInt));
+            out[i] = static_cast<T>(static_cast<Int>(v + reference)) * f / e;
+        }
+        auto iter = std::lower_bound(_exception_positions.begin(), _exception_positions.end(), pos);
+        for (; iter != _exception_positions.end() && *iter < pos + n; ++iter) {
+            out[*iter - pos] = _exceptions[iter - _exception_positions.begin()];
+        }
+    }
+
+private:
+    static int _bit_width(uint64_t v) { return v == 0 ? 0 : 64 - __builtin_clzll(v); }
+
+    static size_t _packed_size(size_t count, int width) { return (count * width + 7) / 8; }
+
+    // |pos| must be the beginning of a group
+    void _unpack(size_t pos, size_t n, UInt* out) const {
+        size_t offset = pos / 8 * _width;
+        BitPacking::UnpackValues(_width, _packed + offset, _packed_bytes - offset, n, out);
+    }
+
+    Params _params;
+    int _width = 0;
+    Int _reference = 0;
+    size_t _count = 0;
+    const uint8_t* _packed = nullptr;
+    size_t _packed_bytes = 0;
+    std::vector<uint32_t> _exception_positions;
+    std::vector<T> _exceptions;
+};
+
+} // namespace starrocks
@@ -301,9 +301,14 @@ void ForDecoder<T>::decode_current_frame(T* output) {
         return; // current frame already decoded
     }
     _current_decoded_frame = frame_index;
+    decode_frame(frame_index, output);
+}
+
+template <typename T>
+void ForDecoder<T>::decode_frame(uint32_t frame_index, T* output) {
     uint8_t current_frame_size = frame_size(frame_index);
 
-    uint32_t base_offset = _frame_offsets[_current_decoded_frame];
+    uint32_t base_offset = _frame_offsets[frame_index];
     T min = 0;
     uint32_t delta_offset = 0;
     if (sizeof(T) == 16) {
@@ -317,13 +322,13 @@ void ForDecoder<T>::decode_current_frame(T* output) {
         delta_offset = base_offset + 4;
     }
 
-    uint8_t bit_width = _bit_widths[_current_decoded_frame];
+    uint8_t bit_width = _bit_widths[frame_index];
 
-    bool is_original_value = _storage_formats[_current_decoded_frame] == 2;
+    bool is_original_value = _storage_formats[frame_index] == 2;
     if (is_original_value) {
         bit_unpack(_buffer + delta_offset, current_frame_size, bit_width, output);
     } else {
-        bool is_ascending = _storage_formats[_current_decoded_frame] == 1;
+        bool is_ascending = _storage_formats[frame_index] == 1;
         std::vector<T> delta_values(current_frame_size);
         bit_unpack(_buffer + delta_offset, current_frame_size, bit_width, delta_values.data());
         if (is_ascending) {
@@ -470,6 +475,77 @@ bool ForDecoder<T>::seek_at_or_after_value(const void* value, bool* exact_match)
     return found;
 }
 
+// Load 8 bytes from |p| as a big-endian integer, the bytes beyond |avail| are read as 0.
+static inline uint64_t load_big_endian_64(const uint8_t* p, size_t avail) {
+    uint64_t v = 0;
+    memcpy(&v, p, std::min<size_t>(avail, 8));
+    return BitUtil::big_endian_to_host(v);
+}
+
+template <typename T>
+void ForDecoder<T>::evaluate_frame_deltas(uint32_t frame_index, uint64_t lo, uint64_t hi, uint32_t from,
+                                          uint32_t to, uint8_t* selection) {
+    const int bit_width = _bit_widths[frame_index];
+    DCHECK(bit_width > 0 && bit_width <= 57);
+    const uint32_t min_value_size = sizeof(T) == 16 ? 16 : (sizeof(T) == 8 ? 8 : 4);
+    const uint8_t* deltas = _buffer + _frame_offsets[frame_index] + min_value_size;
+    const uint8_t* end = _buffer + _buffer_len;
+    // lo <= delta <= hi iff delta - lo <= hi - lo in unsigned arithmetic
+    const uint64_t span = hi - lo;
+    for (uint32_t i = from; i < to; i++) {
+        // the deltas are packed from the most significant bit, and a delta of no more than 57 bits
+        // is always in the 8 bytes starting from the byte of its first bit.
+        size_t bit_pos = static_cast<size_t>(i) * bit_width;
+        const uint8_t* p = deltas + (bit_pos >> 3);
+        uint64_t word = load_big_endian_64(p, end - p);
+        uint64_t delta = (word << (bit_pos & 7)) >> (64 - bit_width);
+        selection[i - from] = (delta - lo) <= span;
+    }
+}
+
+template <typename T>
+bool ForDecoder<T>::evaluate_range(T lo, T hi, uint32_t from, uint32_t to, uint8_t* selection) {
+    if constexpr (!std::is_integral_v<T> || sizeof(T) > 8) {
+        return false;
+    } else {
+        DCHECK_LE(to, _values_num);
+        std::vector<T> values;
+        while (from < to) {
+            uint32_t frame_index = from / _max_frame_size;
+            uint32_t frame_begin = frame_index * _max_frame_size;
+            uint32_t frame_end = std::min<uint32_t>(frame_begin + frame_size(frame_index), to);
+            uint32_t n = frame_end - from;
+            if (_storage_formats[frame_index] == 0 && _bit_widths[frame_index] <= 57) {
+                // value = min + delta, so lo <= value <= hi iff lo - min <= delta <= hi - min
+                __int128 min = decode_frame_min_value(frame_index);
+                __int128 max_delta = (static_cast<__int128>(1) << _bit_widths[frame_index]) - 1;
+                __int128 delta_lo = std::max<__int128>(lo - min, 0);
+                __int128 delta_hi = std::min<__int128>(hi - min, max_delta);
+                if (delta_lo > delta_hi) {
+                    memset(selection, 0, n);
+                } else if (delta_lo == 0 && delta_hi == max_delta) {
+                    memset(selection, 1, n);
+                } else {
+                    evaluate_frame_deltas(frame_index, static_cast<uint64_t>(delta_lo),
+                                          static_cast<uint64_t>(delta_hi), from - frame_begin,
+                                          frame_end - frame_begin, selection);
+                }
+            } else {
+                // the ascending deltas or original values, decode the frame.
+                values.resize(frame_size(frame_index));
+                decode_frame(frame_index, values.data());
+                for (uint32_t i = from; i < frame_end; i++) {
+                    T v = values[i - frame_begin];
+                    selection[i - from] = (v >= lo) & (v <= hi);
+                }
+            }
+            selection += n;
+            from = frame_end;
+        }
+        return true;
+    }
+}
+
 template class ForEncoder<int8_t>;
 template class ForEncoder<int16_t>;
 template class ForEncoder<int32_t>;
@@ -146,6 +146,13 @@ public:
 
     bool seek_at_or_after_value(const void* value, bool* exact_match);
 
+    // Set selection[i - from] to 1 if the i-th value is in [lo, hi], otherwise 0, for i in [from, to).
+    // The bit-packed deltas of each frame are compared with the bounds rebased by the frame min value,
+    // and a frame is not unpacked at all if all or none of its values are in the range.
+    // The current index is not changed.
+    // Return false if the type is not supported.
+    bool evaluate_range(T lo, T hi, uint32_t from, uint32_t to, uint8_t* selection);
+
     uint32_t current_index() const { return _current_index; }
 
     uint32_t count() const { return _values_num; }
@@ -159,6 +166,12 @@ private:
 
     void decode_current_frame(T* output);
 
+    void decode_frame(uint32_t frame_index, T* output);
+
+    // Compare the bit-packed deltas in [from, to) of the frame with [lo, hi], see `evaluate_range`.
+    void evaluate_frame_deltas(uint32_t frame_index, uint64_t lo, uint64_t hi, uint32_t from, uint32_t to,
+                               uint8_t* selection);
+
     T decode_frame_min_value(uint32_t frame_index);
 
     // Return index of the last frame which contains value < target.
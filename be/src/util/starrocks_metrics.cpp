@@ -47,6 +47,15 @@ StarRocksMetrics::StarRocksMetrics() : _metrics(_s_registry_name) {
     REGISTER_STARROCKS_METRIC(memtable_flush_total);
     REGISTER_STARROCKS_METRIC(memtable_flush_duration_us);
 
+    REGISTER_STARROCKS_METRIC(query_cache_hit_total);
+    REGISTER_STARROCKS_METRIC(query_cache_partial_hit_total);
+    REGISTER_STARROCKS_METRIC(query_cache_miss_total);
+
+    REGISTER_STARROCKS_METRIC(page_cache_lookup_total);
+    REGISTER_STARROCKS_METRIC(page_cache_memory_hit_total);
+    REGISTER_STARROCKS_METRIC(page_cache_disk_hit_total);
+    REGISTER_STARROCKS_METRIC(page_cache_disk_demote_total);
+
     REGISTER_STARROCKS_METRIC(update_rowset_commit_request_total);
     REGISTER_STARROCKS_METRIC(update_rowset_commit_request_failed);
     REGISTER_STARROCKS_METRIC(update_rowset_commit_apply_total);
@@ -58,6 +67,7 @@ StarRocksMetrics::StarRocksMetrics() : _metrics(_s_registry_name) {
     REGISTER_STARROCKS_METRIC(update_del_vector_bytes_total);
     REGISTER_STARROCKS_METRIC(update_del_vector_deletes_total);
     REGISTER_STARROCKS_METRIC(update_del_vector_deletes_new);
+    REGISTER_STARROCKS_METRIC(tablet_missing_segment_files_total);
 
     // push request
     _metrics.register_metric("push_requests_total", MetricLabels().add("status", "SUCCESS"),
@@ -150,6 +160,7 @@ StarRocksMetrics::StarRocksMetrics() : _metrics(_s_registry_name) {
 
     // Gauge
     REGISTER_STARROCKS_METRIC(memory_pool_bytes_total);
+    REGISTER_STARROCKS_METRIC(storage_load_duration_ms);
     REGISTER_STARROCKS_METRIC(process_thread_num);
     REGISTER_STARROCKS_METRIC(process_fd_num_used);
     REGISTER_STARROCKS_METRIC(process_fd_num_limit_soft);
@@ -144,6 +144,15 @@ public:
     METRIC_DEFINE_INT_COUNTER(memtable_flush_total, MetricUnit::OPERATIONS);
     METRIC_DEFINE_INT_COUNTER(memtable_flush_duration_us, MetricUnit::MICROSECONDS);
 
+    METRIC_DEFINE_INT_COUNTER(query_cache_hit_total, MetricUnit::REQUESTS);
+    METRIC_DEFINE_INT_COUNTER(query_cache_partial_hit_total, MetricUnit::REQUESTS);
+    METRIC_DEFINE_INT_COUNTER(query_cache_miss_total, MetricUnit::REQUESTS);
+
+    METRIC_DEFINE_INT_COUNTER(page_cache_lookup_total, MetricUnit::REQUESTS);
+    METRIC_DEFINE_INT_COUNTER(page_cache_memory_hit_total, MetricUnit::REQUESTS);
+    METRIC_DEFINE_INT_COUNTER(page_cache_disk_hit_total, MetricUnit::REQUESTS);
+    METRIC_DEFINE_INT_COUNTER(page_cache_disk_demote_total, MetricUnit::OPERATIONS);
+
     METRIC_DEFINE_INT_COUNTER(update_rowset_commit_request_total, MetricUnit::REQUESTS);
     METRIC_DEFINE_INT_COUNTER(update_rowset_commit_request_failed, MetricUnit::REQUESTS);
     METRIC_DEFINE_INT_COUNTER(update_rowset_commit_apply_total, MetricUnit::REQUESTS);
@@ -156,8 +165,12 @@ public:
     METRIC_DEFINE_UINT_COUNTER(update_del_vector_deletes_total, MetricUnit::NOUNIT);
     METRIC_DEFINE_UINT_COUNTER(update_del_vector_deletes_new, MetricUnit::NOUNIT);
 
+    METRIC_DEFINE_INT_COUNTER(tablet_missing_segment_files_total, MetricUnit::NOUNIT);
+
     // Gauges
     METRIC_DEFINE_INT_GAUGE(memory_pool_bytes_total, MetricUnit::BYTES);
+    // time spent on loading the tablets of all data dirs at startup
+    METRIC_DEFINE_INT_GAUGE(storage_load_duration_ms, MetricUnit::MILLISECONDS);
     METRIC_DEFINE_INT_GAUGE(process_thread_num, MetricUnit::NOUNIT);
     METRIC_DEFINE_INT_GAUGE(process_fd_num_used, MetricUnit::NOUNIT);
     METRIC_DEFINE_INT_GAUGE(process_fd_num_limit_soft, MetricUnit::NOUNIT);
@@ -214,6 +227,11 @@ public:
     METRIC_DEFINE_UINT_GAUGE(brpc_endpoint_stub_count, MetricUnit::NOUNIT);
     METRIC_DEFINE_UINT_GAUGE(tablet_writer_count, MetricUnit::NOUNIT);
 
+    METRIC_DEFINE_UINT_GAUGE(query_cache_usage_bytes, MetricUnit::BYTES);
+    METRIC_DEFINE_UINT_GAUGE(query_cache_capacity_bytes, MetricUnit::BYTES);
+
+    METRIC_DEFINE_UINT_GAUGE(page_cache_disk_usage_bytes, MetricUnit::BYTES);
+
     static StarRocksMetrics* instance() {
         static StarRocksMetrics instance;
         return &instance;
@@ -0,0 +1,45 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "util/slice.h"
+
+namespace starrocks {
+
+// Split text into the terms of inverted index and the match functions, it's the STANDARD_TOKENIZER of
+// InvertedIndexPB, so changing how the terms are split requires a new tokenizer type.
+// A term is a maximal run of ASCII letters, ASCII digits and non-ASCII bytes, so UTF-8 characters are
+// never split, and ASCII letters are lowered. Words of languages without spaces are not segmented.
+class TextTokenizer {
+public:
+    // Call |fn(const std::string& term)| for each term of |text| in order.
+    template <typename Fn>
+    static void tokenize(const Slice& text, Fn&& fn) {
+        std::string term;
+        for (size_t i = 0; i < text.size; ++i) {
+            auto c = static_cast<uint8_t>(text.data[i]);
+            if (c >= 'A' && c <= 'Z') {
+                term.push_back(static_cast<char>(c - 'A' + 'a'));
+            } else if ((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c >= 0x80) {
+                term.push_back(static_cast<char>(c));
+            } else if (!term.empty()) {
+                fn(term);
+                term.clear();
+            }
+        }
+        if (!term.empty()) {
+            fn(term);
+        }
+    }
+
+    static std::vector<std::string> tokenize(const Slice& text) {
+        std::vector<std::string> terms;
+        tokenize(text, [&terms](const std::string& term) { terms.emplace_back(term); });
+        return terms;
+    }
+};
+
+} // namespace starrocks
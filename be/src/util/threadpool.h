@@ -199,6 +199,8 @@ public:
         return _num_threads + _num_threads_pending_start;
     }
 
+    int max_threads() const { return _max_threads; }
+
 private:
     friend class ThreadPoolBuilder;
     friend class ThreadPoolToken;
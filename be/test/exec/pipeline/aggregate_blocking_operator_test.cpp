@@ -0,0 +1,275 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "column/column_helper.h"
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+#include "exec/pipeline/aggregate/aggregate_blocking_sink_operator.h"
+#include "exec/pipeline/aggregate/aggregate_blocking_source_operator.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/primitive_type.h"
+#include "runtime/runtime_state.h"
+#include "testutil/assert.h"
+
+namespace starrocks::pipeline {
+
+// select k, sum(v) from t group by k [having sum(v) > threshold]
+// The input tuple 0 has slot 0 (k) and slot 1 (v), the output tuple 1 has slot 2 (k) and slot 3 (sum(v)).
+// The result of the partitioned merge of |dop| drivers is compared with the result of a single driver, which is
+// the result of the single merge after the input is shuffled by the group by keys.
+class AggregateBlockingOperatorTest : public ::testing::Test {
+public:
+    struct AggParams {
+        size_t num_rows = 5000;
+        int32_t num_keys = 1000;
+        bool nullable_key = true;
+        // HAVING sum(v) > having_threshold if it is not negative.
+        int64_t having_threshold = -1;
+        size_t dop = 4;
+        // The input is only sent to the first |num_input_drivers| drivers, the other drivers have no input.
+        size_t num_input_drivers = 4;
+    };
+
+    void SetUp() override {
+        _query_options.batch_size = 256;
+        _state = std::make_unique<RuntimeState>(TUniqueId(), _query_options, TQueryGlobals(), nullptr);
+        _state->init_instance_mem_tracker();
+    }
+
+    static TExprNode create_slot_ref(SlotId slot_id, TupleId tuple_id, TPrimitiveType::type type, bool nullable) {
+        TExprNode node;
+        node.node_type = TExprNodeType::SLOT_REF;
+        node.type = gen_type_desc(type);
+        node.num_children = 0;
+        TSlotRef slot_ref;
+        slot_ref.slot_id = slot_id;
+        slot_ref.tuple_id = tuple_id;
+        node.__set_slot_ref(slot_ref);
+        node.use_vectorized = true;
+        node.is_nullable = nullable;
+        return node;
+    }
+
+    TPlanNode create_plan_node(const AggParams& params) {
+        TPlanNode tnode;
+        tnode.node_id = 1;
+        tnode.node_type = TPlanNodeType::AGGREGATION_NODE;
+        tnode.limit = -1;
+        tnode.agg_node.need_finalize = true;
+        tnode.agg_node.intermediate_tuple_id = 1;
+        tnode.agg_node.output_tuple_id = 1;
+
+        TExpr group_by_expr;
+        group_by_expr.nodes.emplace_back(create_slot_ref(0, 0, TPrimitiveType::INT, params.nullable_key));
+        tnode.agg_node.grouping_exprs.emplace_back(group_by_expr);
+
+        TFunction fn;
+        fn.name.function_name = "sum";
+        fn.arg_types.emplace_back(gen_type_desc(TPrimitiveType::BIGINT));
+        fn.ret_type = gen_type_desc(TPrimitiveType::BIGINT);
+        fn.aggregate_fn.intermediate_type = gen_type_desc(TPrimitiveType::BIGINT);
+        fn.binary_type = TFunctionBinaryType::BUILTIN;
+        TExprNode agg_node;
+        agg_node.node_type = TExprNodeType::AGG_EXPR;
+        agg_node.type = gen_type_desc(TPrimitiveType::BIGINT);
+        agg_node.num_children = 1;
+        agg_node.__set_fn(fn);
+        agg_node.agg_expr.is_merge_agg = false;
+        agg_node.has_nullable_child = false;
+        agg_node.is_nullable = false;
+        TExpr agg_expr;
+        agg_expr.nodes.emplace_back(agg_node);
+        agg_expr.nodes.emplace_back(create_slot_ref(1, 0, TPrimitiveType::BIGINT, false));
+        tnode.agg_node.aggregate_functions.emplace_back(agg_expr);
+
+        if (params.having_threshold >= 0) {
+            TExprNode pred;
+            pred.node_type = TExprNodeType::BINARY_PRED;
+            pred.opcode = TExprOpcode::GT;
+            pred.child_type = TPrimitiveType::BIGINT;
+            pred.num_children = 2;
+            pred.__isset.opcode = true;
+            pred.__isset.child_type = true;
+            pred.type = gen_type_desc(TPrimitiveType::BOOLEAN);
+            pred.use_vectorized = true;
+            TExprNode literal;
+            literal.node_type = TExprNodeType::INT_LITERAL;
+            literal.type = gen_type_desc(TPrimitiveType::BIGINT);
+            literal.num_children = 0;
+            TIntLiteral int_literal;
+            int_literal.value = params.having_threshold;
+            literal.__set_int_literal(int_literal);
+            literal.use_vectorized = true;
+            literal.is_nullable = false;
+            TExpr having;
+            having.nodes = {pred, create_slot_ref(3, 1, TPrimitiveType::BIGINT, false), literal};
+            tnode.conjuncts.emplace_back(having);
+        }
+        return tnode;
+    }
+
+    void create_desc_tbl(const AggParams& params) {
+        TDescriptorTableBuilder desc_tbl_builder;
+        TTupleDescriptorBuilder input_tuple;
+        input_tuple.add_slot(TSlotDescriptorBuilder().type(TYPE_INT).nullable(params.nullable_key).build());
+        input_tuple.add_slot(TSlotDescriptorBuilder().type(TYPE_BIGINT).nullable(false).build());
+        input_tuple.build(&desc_tbl_builder);
+        TTupleDescriptorBuilder output_tuple;
+        output_tuple.add_slot(TSlotDescriptorBuilder().type(TYPE_INT).nullable(params.nullable_key).build());
+        output_tuple.add_slot(TSlotDescriptorBuilder().type(TYPE_BIGINT).nullable(false).build());
+        output_tuple.build(&desc_tbl_builder);
+        DescriptorTbl* desc_tbl = nullptr;
+        ASSERT_OK(DescriptorTbl::create(&_pool, desc_tbl_builder.desc_tbl(), &desc_tbl, config::vector_chunk_size));
+        _state->set_desc_tbl(desc_tbl);
+    }
+
+    // Every 11th key is null if the key is nullable.
+    std::vector<vectorized::ChunkPtr> create_chunks(const AggParams& params) {
+        std::vector<vectorized::ChunkPtr> chunks;
+        for (size_t begin = 0; begin < params.num_rows; begin += _state->chunk_size()) {
+            size_t end = std::min<size_t>(begin + _state->chunk_size(), params.num_rows);
+            auto keys = vectorized::Int32Column::create();
+            auto null_flags = vectorized::NullColumn::create();
+            auto values = vectorized::Int64Column::create();
+            for (size_t i = begin; i < end; i++) {
+                keys->append(static_cast<int32_t>(i % params.num_keys));
+                null_flags->append(params.nullable_key && i % 11 == 0);
+                values->append(static_cast<int64_t>(i));
+            }
+            auto chunk = std::make_shared<vectorized::Chunk>();
+            if (params.nullable_key) {
+                chunk->append_column(vectorized::NullableColumn::create(keys, null_flags), 0);
+            } else {
+                chunk->append_column(keys, 0);
+            }
+            chunk->append_column(values, 1);
+            chunks.emplace_back(std::move(chunk));
+        }
+        return chunks;
+    }
+
+    static void add_rows(const vectorized::ChunkPtr& chunk, std::vector<std::string>* rows) {
+        for (size_t i = 0; i < chunk->num_rows(); i++) {
+            rows->emplace_back(chunk->get_column_by_slot_id(2)->debug_item(i) + "," +
+                               chunk->get_column_by_slot_id(3)->debug_item(i));
+        }
+    }
+
+    // The input chunks are dispatched to the first |num_input_drivers| drivers in turn.
+    std::vector<std::string> run_agg(const AggParams& params, bool partitioned_merge) {
+        std::vector<std::string> rows;
+        create_desc_tbl(params);
+        TPlanNode tnode = create_plan_node(params);
+        auto aggregator_factory = std::make_shared<AggregatorFactory>(tnode);
+        if (partitioned_merge) {
+            aggregator_factory->enable_partitioned_merge(params.dop);
+        }
+        AggregateBlockingSinkOperatorFactory sink_factory(1, 1, aggregator_factory);
+        AggregateBlockingSourceOperatorFactory source_factory(2, 1, aggregator_factory);
+        std::vector<OperatorPtr> sinks;
+        std::vector<OperatorPtr> sources;
+        for (size_t i = 0; i < params.dop; i++) {
+            sinks.emplace_back(sink_factory.create(params.dop, i));
+            sources.emplace_back(source_factory.create(params.dop, i));
+            EXPECT_OK(sinks.back()->prepare(_state.get()));
+            EXPECT_OK(sources.back()->prepare(_state.get()));
+        }
+
+        auto chunks = create_chunks(params);
+        for (size_t i = 0; i < chunks.size(); i++) {
+            EXPECT_OK(sinks[i % params.num_input_drivers]->push_chunk(_state.get(), chunks[i]));
+        }
+        for (size_t i = 0; i < params.dop; i++) {
+            // The sources can't output until all the sinks finish.
+            EXPECT_FALSE(sources[i]->has_output());
+            sinks[i]->set_finishing(_state.get());
+        }
+
+        auto aggregator = aggregator_factory->get_or_create(0);
+        if (partitioned_merge && params.num_rows > 0) {
+            // The partitioned chunks are accounted until the sources merge them.
+            EXPECT_GT(aggregator->partitioned_merge_memory_usage(), 0);
+        }
+        for (auto& source : sources) {
+            while (!source->is_finished()) {
+                EXPECT_TRUE(source->has_output());
+                auto chunk_or = source->pull_chunk(_state.get());
+                EXPECT_OK(chunk_or.status());
+                add_rows(chunk_or.value(), &rows);
+            }
+        }
+        EXPECT_EQ(0, aggregator->partitioned_merge_memory_usage());
+
+        for (size_t i = 0; i < params.dop; i++) {
+            sinks[i]->close(_state.get());
+            sources[i]->close(_state.get());
+        }
+        std::sort(rows.begin(), rows.end());
+        return rows;
+    }
+
+    void check_partitioned_merge(const AggParams& params, size_t expected_groups) {
+        AggParams single_params = params;
+        single_params.dop = 1;
+        single_params.num_input_drivers = 1;
+        std::vector<std::string> expected = run_agg(single_params, false);
+        ASSERT_EQ(expected_groups, expected.size());
+        std::vector<std::string> actual = run_agg(params, true);
+        ASSERT_EQ(expected, actual);
+    }
+
+protected:
+    ObjectPool _pool;
+    TQueryOptions _query_options;
+    std::unique_ptr<RuntimeState> _state;
+};
+
+TEST_F(AggregateBlockingOperatorTest, test_partitioned_merge) {
+    AggParams params;
+    params.nullable_key = false;
+    check_partitioned_merge(params, 1000);
+}
+
+TEST_F(AggregateBlockingOperatorTest, test_partitioned_merge_nullable_key) {
+    AggParams params;
+    // The keys of the rows multiple of 11 are null, which form one more group.
+    check_partitioned_merge(params, 1001);
+}
+
+TEST_F(AggregateBlockingOperatorTest, test_partitioned_merge_having) {
+    AggParams params;
+    // Each key has 5 rows, half of the groups have a sum greater than the sum of the middle key.
+    params.having_threshold = 12500;
+    std::vector<std::string> expected;
+    {
+        AggParams single_params = params;
+        single_params.dop = 1;
+        single_params.num_input_drivers = 1;
+        expected = run_agg(single_params, false);
+    }
+    ASSERT_GT(expected.size(), 0);
+    ASSERT_LT(expected.size(), 1000);
+    ASSERT_EQ(expected, run_agg(params, true));
+
+    // All the groups are filtered out.
+    params.having_threshold = 1L << 40;
+    check_partitioned_merge(params, 0);
+}
+
+TEST_F(AggregateBlockingOperatorTest, test_partitioned_merge_empty_partitions) {
+    AggParams params;
+    // The groups 0, 1 and null take at most 3 of the 8 partitions, and the last 3 drivers have no input.
+    params.num_keys = 2;
+    params.dop = 8;
+    params.num_input_drivers = 5;
+    check_partitioned_merge(params, 3);
+
+    // No driver has input.
+    params.num_rows = 0;
+    check_partitioned_merge(params, 0);
+}
+
+} // namespace starrocks::pipeline
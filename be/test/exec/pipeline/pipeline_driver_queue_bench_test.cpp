@@ -0,0 +1,90 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include <benchmark/benchmark.h>
+
+#include <thread>
+
+#include "exec/pipeline/pipeline_driver_queue.h"
+
+namespace starrocks::pipeline {
+
+// Each executor thread takes a driver and puts it back immediately, which simulates
+// the short-running drivers and makes the cost of the queue itself dominant.
+static constexpr int kOpsPerThread = 100'000;
+static constexpr int kDriversPerThread = 4;
+
+class MockEmptyOperator final : public Operator {
+public:
+    MockEmptyOperator(OperatorFactory* factory, int32_t id, int32_t plan_node_id)
+            : Operator(factory, id, "mock_empty_operator", plan_node_id) {}
+
+    ~MockEmptyOperator() override = default;
+
+    bool has_output() const override { return true; }
+    bool need_input() const override { return true; }
+    bool is_finished() const override { return true; }
+
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override { return nullptr; }
+    Status push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) override { return Status::OK(); }
+};
+
+static Operators gen_operators() {
+    Operators operators;
+    operators.emplace_back(std::make_shared<MockEmptyOperator>(nullptr, 1, 1));
+    return operators;
+}
+
+template <typename CreateQueue>
+static void do_bench(benchmark::State& state, CreateQueue create_queue) {
+    const int num_threads = state.range(0);
+
+    std::vector<std::shared_ptr<PipelineDriver>> drivers;
+    for (int i = 0; i < num_threads * kDriversPerThread; ++i) {
+        drivers.emplace_back(std::make_shared<PipelineDriver>(gen_operators(), nullptr, nullptr, -1, true));
+    }
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::unique_ptr<DriverQueue> queue = create_queue(num_threads);
+        for (auto& driver : drivers) {
+            queue->put_back(driver.get());
+        }
+        state.ResumeTiming();
+
+        std::vector<std::thread> threads;
+        threads.reserve(num_threads);
+        for (int worker_id = 0; worker_id < num_threads; ++worker_id) {
+            threads.emplace_back([&queue, worker_id] {
+                for (int i = 0; i < kOpsPerThread; ++i) {
+                    auto driver = queue->take(worker_id).value();
+                    queue->update_statistics(driver);
+                    queue->put_back_from_executor(driver);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        state.PauseTiming();
+        queue->close();
+        queue.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * num_threads * kOpsPerThread);
+}
+
+static void BM_query_shared_driver_queue(benchmark::State& state) {
+    do_bench(state, [](int num_threads) { return std::make_unique<QuerySharedDriverQueue>(); });
+}
+
+static void BM_work_stealing_driver_queue(benchmark::State& state) {
+    do_bench(state, [](int num_threads) { return std::make_unique<WorkStealingDriverQueue>(num_threads); });
+}
+
+BENCHMARK(BM_query_shared_driver_queue)->RangeMultiplier(2)->Range(1, 64)->UseRealTime();
+BENCHMARK(BM_work_stealing_driver_queue)->RangeMultiplier(2)->Range(1, 64)->UseRealTime();
+
+} // namespace starrocks::pipeline
+
+BENCHMARK_MAIN();
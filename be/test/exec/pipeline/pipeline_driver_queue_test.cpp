@@ -4,6 +4,7 @@
 
 #include <gtest/gtest.h>
 
+#include <set>
 #include <thread>
 
 #include "exec/pipeline/pipeline_fwd.h"
@@ -109,6 +110,101 @@ PARALLEL_TEST(QuerySharedDriverQueueTest, test_take_close) {
     consumer_thread->join();
 }
 
+PARALLEL_TEST(WorkStealingDriverQueueTest, test_basic) {
+    // With only one local queue, the order is the same as QuerySharedDriverQueue.
+    WorkStealingDriverQueue queue(1);
+
+    auto driver71 = std::make_shared<PipelineDriver>(_gen_operators(), nullptr, nullptr, -1, true);
+    _set_driver_level(driver71.get(), 7);
+    driver71->driver_acct().update_last_time_spent(5'000'000L * 1);
+
+    auto driver61 = std::make_shared<PipelineDriver>(_gen_operators(), nullptr, nullptr, -1, true);
+    _set_driver_level(driver61.get(), 6);
+    driver61->driver_acct().update_last_time_spent(30'000'000L * QuerySharedDriverQueue::RATIO_OF_ADJACENT_QUEUE);
+
+    auto driver51 = std::make_shared<PipelineDriver>(_gen_operators(), nullptr, nullptr, -1, true);
+    _set_driver_level(driver51.get(), 5);
+    driver51->driver_acct().update_last_time_spent(20'000'000L * QuerySharedDriverQueue::RATIO_OF_ADJACENT_QUEUE *
+                                                   QuerySharedDriverQueue::RATIO_OF_ADJACENT_QUEUE);
+
+    std::vector<DriverRawPtr> in_drivers = {driver71.get(), driver61.get(), driver51.get()};
+    std::vector<DriverRawPtr> out_drivers = {driver71.get(), driver51.get(), driver61.get()};
+
+    for (auto* in_driver : in_drivers) {
+        queue.update_statistics(in_driver);
+        queue.put_back(in_driver);
+    }
+    ASSERT_EQ(3, queue.size());
+
+    for (auto* out_driver : out_drivers) {
+        auto maybe_driver = queue.take(0);
+        ASSERT_TRUE(maybe_driver.ok());
+        ASSERT_EQ(out_driver, maybe_driver.value());
+    }
+    ASSERT_TRUE(queue.empty());
+}
+
+PARALLEL_TEST(WorkStealingDriverQueueTest, test_steal) {
+    WorkStealingDriverQueue queue(4);
+
+    std::vector<std::shared_ptr<PipelineDriver>> drivers;
+    std::set<DriverRawPtr> in_drivers;
+    for (int i = 0; i < 8; ++i) {
+        auto driver = std::make_shared<PipelineDriver>(_gen_operators(), nullptr, nullptr, -1, true);
+        _set_driver_level(driver.get(), 0);
+        in_drivers.emplace(driver.get());
+        drivers.emplace_back(std::move(driver));
+    }
+    // The drivers are distributed among all the local queues.
+    for (auto& driver : drivers) {
+        queue.put_back(driver.get());
+    }
+    ASSERT_EQ(8, queue.size());
+
+    // The worker of the first local queue takes all the drivers, by stealing from the others.
+    std::set<DriverRawPtr> out_drivers;
+    for (int i = 0; i < 8; ++i) {
+        auto maybe_driver = queue.take(0);
+        ASSERT_TRUE(maybe_driver.ok());
+        out_drivers.emplace(maybe_driver.value());
+    }
+    ASSERT_EQ(in_drivers, out_drivers);
+    ASSERT_TRUE(queue.empty());
+}
+
+PARALLEL_TEST(WorkStealingDriverQueueTest, test_take_block) {
+    WorkStealingDriverQueue queue(2);
+
+    auto driver1 = std::make_shared<PipelineDriver>(_gen_operators(), nullptr, nullptr, -1, true);
+    _set_driver_level(driver1.get(), 1);
+
+    auto consumer_thread = std::make_shared<std::thread>([&queue, &driver1] {
+        auto maybe_driver = queue.take(1);
+        ASSERT_TRUE(maybe_driver.ok());
+        ASSERT_EQ(driver1.get(), maybe_driver.value());
+    });
+
+    sleep(1);
+    queue.update_statistics(driver1.get());
+    queue.put_back(driver1.get());
+
+    consumer_thread->join();
+}
+
+PARALLEL_TEST(WorkStealingDriverQueueTest, test_take_close) {
+    WorkStealingDriverQueue queue(2);
+
+    auto consumer_thread = std::make_shared<std::thread>([&queue] {
+        auto maybe_driver = queue.take(0);
+        ASSERT_TRUE(maybe_driver.status().is_cancelled());
+    });
+
+    sleep(1);
+    queue.close();
+
+    consumer_thread->join();
+}
+
 class DriverQueueWithWorkGroupTest : public ::testing::Test {
 public:
     void SetUp() override {
@@ -0,0 +1,220 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include <atomic>
+#include <random>
+#include <thread>
+
+#include "exec/pipeline/fragment_context.h"
+#include "exec/pipeline/observable.h"
+#include "exec/pipeline/pipeline.h"
+#include "pipeline_test_base.h"
+#include "util/defer_op.h"
+
+namespace starrocks::pipeline {
+
+// ChunkProducer makes chunks available to EventSourceOperator from another thread, and notifies the
+// observers after each chunk, like DataStreamRecvr does when chunks arrive.
+class ChunkProducer {
+public:
+    explicit ChunkProducer(size_t num_chunks) : _num_chunks(num_chunks) {}
+    ~ChunkProducer() { join(); }
+
+    // Produce all the chunks, waiting up to |max_interval_us| before each chunk.
+    void start(int32_t max_interval_us) {
+        _thread = std::thread([this, max_interval_us]() {
+            std::default_random_engine e;
+            std::uniform_int_distribution<int32_t> u32(0, max_interval_us);
+            for (size_t i = 0; i < _num_chunks; ++i) {
+                std::this_thread::sleep_for(std::chrono::microseconds(u32(e)));
+                _num_available_chunks.fetch_add(1);
+                _observable.notify_observers();
+            }
+        });
+    }
+    void join() {
+        if (_thread.joinable()) {
+            _thread.join();
+        }
+    }
+
+    size_t num_chunks() const { return _num_chunks; }
+    size_t num_available_chunks() const { return _num_available_chunks.load(); }
+    Observable* observable() { return &_observable; }
+
+    std::atomic<size_t> num_observed_operators{0};
+    std::atomic<size_t> num_pulled_chunks{0};
+    std::atomic<bool> is_closed{false};
+
+private:
+    const size_t _num_chunks;
+    std::atomic<size_t> _num_available_chunks{0};
+    Observable _observable;
+    std::thread _thread;
+};
+
+using ChunkProducerPtr = std::shared_ptr<ChunkProducer>;
+
+class EventSourceOperator final : public SourceOperator {
+public:
+    EventSourceOperator(OperatorFactory* factory, int32_t id, int32_t plan_node_id, ChunkProducerPtr producer,
+                        bool is_observable)
+            : SourceOperator(factory, id, "event_source", plan_node_id),
+              _producer(std::move(producer)),
+              _is_observable(is_observable) {}
+    ~EventSourceOperator() override = default;
+
+    bool has_output() const override { return _index < _producer->num_available_chunks(); }
+    bool is_finished() const override { return _index == _producer->num_chunks(); }
+
+    std::vector<Observable*> observables() override {
+        if (!_is_observable) {
+            return {};
+        }
+        _producer->num_observed_operators++;
+        return {_producer->observable()};
+    }
+
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override {
+        ++_index;
+        _producer->num_pulled_chunks++;
+        return PipelineTestBase::_create_and_fill_chunk(1);
+    }
+
+    void close(RuntimeState* state) override {
+        _producer->is_closed = true;
+        SourceOperator::close(state);
+    }
+
+private:
+    ChunkProducerPtr _producer;
+    const bool _is_observable;
+    size_t _index = 0;
+};
+
+class EventSourceOperatorFactory final : public SourceOperatorFactory {
+public:
+    EventSourceOperatorFactory(int32_t id, int32_t plan_node_id, ChunkProducerPtr producer, bool is_observable)
+            : SourceOperatorFactory(id, "event_source", plan_node_id),
+              _producer(std::move(producer)),
+              _is_observable(is_observable) {}
+    ~EventSourceOperatorFactory() override = default;
+
+    OperatorPtr create(int32_t degree_of_parallelism, int32_t driver_sequence) override {
+        return std::make_shared<EventSourceOperator>(this, _id, _plan_node_id, _producer, _is_observable);
+    }
+
+private:
+    ChunkProducerPtr _producer;
+    const bool _is_observable;
+};
+
+class DiscardSinkOperator final : public Operator {
+public:
+    DiscardSinkOperator(OperatorFactory* factory, int32_t id, int32_t plan_node_id)
+            : Operator(factory, id, "discard_sink", plan_node_id) {}
+    ~DiscardSinkOperator() override = default;
+
+    bool need_input() const override { return true; }
+    bool has_output() const override { return false; }
+    bool is_finished() const override { return _is_finished; }
+    void set_finishing(RuntimeState* state) override { _is_finished = true; }
+
+    Status push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) override { return Status::OK(); }
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override {
+        return Status::InternalError("Shouldn't pull chunk from sink operator");
+    }
+
+private:
+    bool _is_finished = false;
+};
+
+class DiscardSinkOperatorFactory final : public OperatorFactory {
+public:
+    DiscardSinkOperatorFactory(int32_t id, int32_t plan_node_id) : OperatorFactory(id, "discard_sink", plan_node_id) {}
+    ~DiscardSinkOperatorFactory() override = default;
+
+    OperatorPtr create(int32_t degree_of_parallelism, int32_t driver_sequence) override {
+        return std::make_shared<DiscardSinkOperator>(this, _id, _plan_node_id);
+    }
+};
+
+class PipelineEventDrivenPollerTest : public PipelineTestBase {
+public:
+    void build_pipeline(const ChunkProducerPtr& producer, bool is_observable) {
+        _pipeline_builder = [=](RuntimeState* state) {
+            OpFactories op_factories;
+            op_factories.push_back(std::make_shared<EventSourceOperatorFactory>(
+                    next_operator_id(), next_plan_node_id(), producer, is_observable));
+            op_factories.push_back(std::make_shared<DiscardSinkOperatorFactory>(next_operator_id(),
+                                                                                next_plan_node_id()));
+            _pipelines.push_back(std::make_shared<Pipeline>(next_pipeline_id(), op_factories));
+        };
+    }
+};
+
+// The chunks become available at random moments, some of which fall between the poller checking the driver
+// and parking it. The parked drivers are never checked periodically, so a missed event hangs the fragment.
+TEST_F(PipelineEventDrivenPollerTest, test_ready_while_parking) {
+    bool enable_event_driven = config::enable_pipeline_event_driven_poller;
+    int64_t check_interval_ms = config::pipeline_poller_parked_driver_check_interval_ms;
+    config::enable_pipeline_event_driven_poller = true;
+    config::pipeline_poller_parked_driver_check_interval_ms = 3600 * 1000;
+    DeferOp op([=]() {
+        config::enable_pipeline_event_driven_poller = enable_event_driven;
+        config::pipeline_poller_parked_driver_check_interval_ms = check_interval_ms;
+    });
+
+    auto producer = std::make_shared<ChunkProducer>(2000);
+    build_pipeline(producer, true);
+    start_test();
+    producer->start(200);
+
+    ASSERT_EQ(std::future_status::ready, _fragment_future.wait_for(std::chrono::seconds(15)));
+    producer->join();
+    ASSERT_EQ(producer->num_chunks(), producer->num_pulled_chunks.load());
+    ASSERT_GT(producer->num_observed_operators.load(), 0);
+    ASSERT_TRUE(producer->is_closed.load());
+}
+
+// The fragment is canceled while its driver is parked, and no event ever arrives.
+TEST_F(PipelineEventDrivenPollerTest, test_cancel_while_blocked) {
+    bool enable_event_driven = config::enable_pipeline_event_driven_poller;
+    config::enable_pipeline_event_driven_poller = true;
+    DeferOp op([=]() { config::enable_pipeline_event_driven_poller = enable_event_driven; });
+
+    auto producer = std::make_shared<ChunkProducer>(1);
+    build_pipeline(producer, true);
+    start_test();
+
+    // The driver is registered to the observable when the poller parks it for the first time.
+    for (int i = 0; i < 1000 && producer->num_observed_operators.load() == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_GT(producer->num_observed_operators.load(), 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(config::pipeline_poller_parked_driver_check_interval_ms));
+    _fragment_ctx->cancel(Status::Cancelled("Cancelled by test"));
+
+    ASSERT_EQ(std::future_status::ready, _fragment_future.wait_for(std::chrono::seconds(15)));
+    ASSERT_EQ(0, producer->num_pulled_chunks.load());
+    ASSERT_TRUE(producer->is_closed.load());
+}
+
+// The operators without observables are still polled.
+TEST_F(PipelineEventDrivenPollerTest, test_poll_operator_without_observables) {
+    bool enable_event_driven = config::enable_pipeline_event_driven_poller;
+    config::enable_pipeline_event_driven_poller = true;
+    DeferOp op([=]() { config::enable_pipeline_event_driven_poller = enable_event_driven; });
+
+    auto producer = std::make_shared<ChunkProducer>(200);
+    build_pipeline(producer, false);
+    start_test();
+    producer->start(1000);
+
+    ASSERT_EQ(std::future_status::ready, _fragment_future.wait_for(std::chrono::seconds(15)));
+    producer->join();
+    ASSERT_EQ(producer->num_chunks(), producer->num_pulled_chunks.load());
+    ASSERT_EQ(0, producer->num_observed_operators.load());
+    ASSERT_TRUE(producer->is_closed.load());
+}
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,59 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "exec/pipeline/query_cache/query_cache.h"
+
+#include <gtest/gtest.h>
+
+#include "column/chunk.h"
+#include "column/fixed_length_column.h"
+
+namespace starrocks::pipeline {
+
+static vectorized::ChunkPtr create_chunk(int32_t num_rows) {
+    auto column = vectorized::Int32Column::create();
+    for (int32_t i = 0; i < num_rows; i++) {
+        column->append(i);
+    }
+    auto chunk = std::make_shared<vectorized::Chunk>();
+    chunk->append_column(column, 0);
+    return chunk;
+}
+
+TEST(QueryCacheTest, test_insert_and_lookup) {
+    QueryCache cache(nullptr, 1L << 30);
+    ASSERT_FALSE(cache.lookup("digest", 1).has_value());
+
+    cache.insert("digest", 1, QueryCacheValue{2, {create_chunk(10), create_chunk(20)}});
+    auto value = cache.lookup("digest", 1);
+    ASSERT_TRUE(value.has_value());
+    ASSERT_EQ(2, value->version);
+    ASSERT_EQ(2, value->chunks.size());
+    ASSERT_EQ(10, value->chunks[0]->num_rows());
+    ASSERT_EQ(20, value->chunks[1]->num_rows());
+    ASSERT_GT(cache.memory_usage(), 0);
+
+    // Keyed on both the digest and the tablet.
+    ASSERT_FALSE(cache.lookup("digest", 2).has_value());
+    ASSERT_FALSE(cache.lookup("other", 1).has_value());
+
+    // A newer version replaces the old one.
+    cache.insert("digest", 1, QueryCacheValue{3, {create_chunk(30)}});
+    value = cache.lookup("digest", 1);
+    ASSERT_TRUE(value.has_value());
+    ASSERT_EQ(3, value->version);
+    ASSERT_EQ(1, value->chunks.size());
+    ASSERT_EQ(30, value->chunks[0]->num_rows());
+}
+
+TEST(QueryCacheTest, test_evict) {
+    const size_t capacity = 1L << 20;
+    QueryCache cache(nullptr, capacity);
+    for (int64_t tablet_id = 0; tablet_id < 1024; tablet_id++) {
+        cache.insert("digest", tablet_id, QueryCacheValue{1, {create_chunk(4096)}});
+    }
+    ASSERT_LE(cache.memory_usage(), capacity);
+    // The latest one is still cached.
+    ASSERT_TRUE(cache.lookup("digest", 1023).has_value());
+}
+
+} // namespace starrocks::pipeline
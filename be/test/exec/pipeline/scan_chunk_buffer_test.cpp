@@ -0,0 +1,65 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "exec/pipeline/scan_chunk_buffer.h"
+
+#include <gtest/gtest.h>
+
+#include "column/chunk.h"
+#include "column/fixed_length_column.h"
+
+namespace starrocks::pipeline {
+
+static vectorized::ChunkPtr create_chunk(int32_t num_rows) {
+    auto column = vectorized::Int32Column::create();
+    for (int32_t i = 0; i < num_rows; i++) {
+        column->append(i);
+    }
+    auto chunk = std::make_shared<vectorized::Chunk>();
+    chunk->append_column(column, 0);
+    return chunk;
+}
+
+TEST(ScanChunkBufferTest, test_put_and_get) {
+    std::atomic<int64_t> query_bytes = 0;
+    {
+        ScanChunkBuffer buffer(2, 1L << 30, &query_bytes);
+        ASSERT_TRUE(buffer.empty());
+        ASSERT_FALSE(buffer.is_full());
+
+        buffer.put(create_chunk(10));
+        ASSERT_FALSE(buffer.is_full());
+        buffer.put(create_chunk(20));
+        ASSERT_TRUE(buffer.is_full());
+        ASSERT_EQ(2, buffer.num_chunks());
+        ASSERT_EQ(buffer.num_bytes(), query_bytes.load());
+
+        vectorized::ChunkPtr chunk;
+        ASSERT_TRUE(buffer.try_get(&chunk));
+        ASSERT_EQ(10, chunk->num_rows());
+        ASSERT_FALSE(buffer.is_full());
+        ASSERT_EQ(buffer.num_bytes(), query_bytes.load());
+
+        // The chunk left in the buffer is released on destruction.
+        ASSERT_GT(query_bytes.load(), 0);
+    }
+    ASSERT_EQ(0, query_bytes.load());
+}
+
+TEST(ScanChunkBufferTest, test_query_bytes_limit) {
+    std::atomic<int64_t> query_bytes = 0;
+    ScanChunkBuffer buffer1(100, 1, &query_bytes);
+    ScanChunkBuffer buffer2(100, 1, &query_bytes);
+
+    buffer1.put(create_chunk(10));
+    ASSERT_TRUE(buffer1.is_full());
+    // The empty buffer is never full, even if the query exceeds the limit.
+    ASSERT_FALSE(buffer2.is_full());
+
+    vectorized::ChunkPtr chunk;
+    ASSERT_FALSE(buffer2.try_get(&chunk));
+    ASSERT_TRUE(buffer1.try_get(&chunk));
+    ASSERT_EQ(0, query_bytes.load());
+    ASSERT_FALSE(buffer1.is_full());
+}
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,296 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "exec/pipeline/exchange/sink_buffer.h"
+
+#include <gtest/gtest.h>
+
+#include <fmt/format.h>
+
+#include <deque>
+#include <map>
+#include <set>
+#include <thread>
+
+#include "service/brpc.h"
+
+namespace starrocks::pipeline {
+
+// The request received by a host, with the data of its chunks split from the attachment of the RPC.
+struct ReceivedRequest {
+    std::string host;
+    PTransmitChunkParams params;
+    std::string data;
+};
+
+// RpcRecorder records the requests sent to the mocked hosts, and runs the closures of the RPCs when they are
+// completed by the test, since a closure run in the sending thread would deadlock on the mutexes of SinkBuffer.
+// The RPCs to |slow_instance| take |slow_rpc_ms| to complete, like a receiver applying back pressure.
+class RpcRecorder {
+public:
+    void record(const std::string& host, const std::vector<const PTransmitChunkParams*>& requests,
+                google::protobuf::RpcController* controller, PTransmitChunkResult* response,
+                google::protobuf::Closure* done) {
+        butil::IOBuf attachment = static_cast<brpc::Controller*>(controller)->request_attachment();
+        std::set<int64_t> instances;
+        size_t num_bytes = 0;
+        for (const auto* request : requests) {
+            // The requests are added to a batch only if the batch is smaller than max_transmit_batched_bytes.
+            max_bytes_before_last_request = std::max(max_bytes_before_last_request, num_bytes);
+            size_t data_size = 0;
+            for (const auto& chunk : request->chunks()) {
+                data_size += chunk.data_size();
+            }
+            std::string data;
+            attachment.cutn(&data, data_size);
+            num_bytes += data_size;
+            received.push_back({host, *request, std::move(data)});
+            instances.insert(request->finst_id().lo());
+        }
+        EXPECT_TRUE(attachment.empty());
+        // A batch has at most one request of each instance.
+        EXPECT_EQ(requests.size(), instances.size());
+        num_rpcs++;
+        num_batched_rpcs += requests.size() > 1;
+        bool is_slow = instances.count(slow_instance) > 0;
+        if (is_slow && requests.size() > 1 && num_slow_rpcs_completed > 0) {
+            num_batched_rpcs_after_slow_rpc++;
+        }
+        response->mutable_status()->set_status_code(0);
+        _pending_closures.push_back({done, is_slow});
+    }
+
+    size_t num_pending_rpcs() const { return _pending_closures.size(); }
+
+    // Complete the first |num| in-flight RPCs, the requests sent by their closures are not completed.
+    void complete_rpcs(size_t num) {
+        for (size_t i = 0; i < num && !_pending_closures.empty(); i++) {
+            auto [done, is_slow] = _pending_closures.front();
+            _pending_closures.pop_front();
+            if (is_slow) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(slow_rpc_ms));
+            }
+            num_slow_rpcs_completed += is_slow;
+            done->Run();
+        }
+    }
+
+    void complete_all_rpcs() {
+        while (!_pending_closures.empty()) {
+            complete_rpcs(_pending_closures.size());
+        }
+    }
+
+    std::vector<ReceivedRequest> received;
+    size_t num_rpcs = 0;
+    size_t num_batched_rpcs = 0;
+    size_t max_bytes_before_last_request = 0;
+
+    int64_t slow_instance = -1;
+    int64_t slow_rpc_ms = 0;
+    size_t num_slow_rpcs_completed = 0;
+    // The batched RPCs including |slow_instance| which are sent after an RPC to it was slow.
+    size_t num_batched_rpcs_after_slow_rpc = 0;
+
+private:
+    std::deque<std::pair<google::protobuf::Closure*, bool>> _pending_closures;
+};
+
+class MockBackendServiceStub final : public doris::PBackendService_Stub {
+public:
+    MockBackendServiceStub(std::string host, RpcRecorder* recorder)
+            : doris::PBackendService_Stub(nullptr), _host(std::move(host)), _recorder(recorder) {}
+
+    void transmit_chunk(google::protobuf::RpcController* controller, const PTransmitChunkParams* request,
+                        PTransmitChunkResult* response, google::protobuf::Closure* done) override {
+        _recorder->record(_host, {request}, controller, response, done);
+    }
+
+    void transmit_chunk_batch(google::protobuf::RpcController* controller, const PTransmitChunkBatchParams* request,
+                              PTransmitChunkResult* response, google::protobuf::Closure* done) override {
+        std::vector<const PTransmitChunkParams*> requests;
+        for (const auto& sub_request : request->requests()) {
+            requests.push_back(&sub_request);
+        }
+        _recorder->record(_host, requests, controller, response, done);
+    }
+
+private:
+    const std::string _host;
+    RpcRecorder* _recorder;
+};
+
+// The instances 1, 2 and 3 are on the host h1, and the instance 4 is on the host h2.
+class SinkBufferTest : public ::testing::Test {
+public:
+    static constexpr int64_t kQueryIdHi = 100;
+    static constexpr int32_t kNumSinkers = 2;
+    static constexpr int32_t kNumRounds = 20;
+
+protected:
+    void SetUp() override {
+        _enable_coalescing = config::enable_pipeline_sink_rpc_coalescing;
+        _brpc_dop = config::pipeline_sink_brpc_dop;
+        _max_batched_bytes = config::max_transmit_batched_bytes;
+        _back_pressure_ms = config::pipeline_sink_rpc_back_pressure_ms;
+        config::pipeline_sink_brpc_dop = 2;
+        // No RPC is regarded as back pressured unless a test sets it.
+        config::pipeline_sink_rpc_back_pressure_ms = 3600 * 1000;
+
+        _fragment_ctx = std::make_unique<FragmentContext>();
+        auto runtime_state = std::make_shared<RuntimeState>(TUniqueId(), TQueryOptions(), TQueryGlobals(), nullptr);
+        runtime_state->init_instance_mem_tracker();
+        _fragment_ctx->set_runtime_state(std::move(runtime_state));
+
+        _instance_hosts = {{1, "h1"}, {2, "h1"}, {3, "h1"}, {4, "h2"}};
+        for (const auto& [lo, host] : _instance_hosts) {
+            TPlanFragmentDestination dest;
+            dest.fragment_instance_id.hi = kQueryIdHi;
+            dest.fragment_instance_id.lo = lo;
+            dest.server.hostname = host;
+            dest.server.port = 9060;
+            TNetworkAddress brpc_server;
+            brpc_server.hostname = host;
+            brpc_server.port = 8060;
+            dest.__set_brpc_server(brpc_server);
+            _destinations.push_back(dest);
+            if (_stubs.count(host) == 0) {
+                _stubs[host] = std::make_unique<MockBackendServiceStub>(host, &_recorder);
+            }
+        }
+        // The pseudo destination of bucket shuffle join is ignored.
+        TPlanFragmentDestination pseudo_dest;
+        pseudo_dest.fragment_instance_id.hi = kQueryIdHi;
+        pseudo_dest.fragment_instance_id.lo = -1;
+        _destinations.push_back(pseudo_dest);
+    }
+
+    void TearDown() override {
+        config::enable_pipeline_sink_rpc_coalescing = _enable_coalescing;
+        config::pipeline_sink_brpc_dop = _brpc_dop;
+        config::max_transmit_batched_bytes = _max_batched_bytes;
+        config::pipeline_sink_rpc_back_pressure_ms = _back_pressure_ms;
+    }
+
+    void add_request(SinkBuffer* sink_buffer, int64_t lo, const std::string& data, bool eos) {
+        TransmitChunkInfo info;
+        info.fragment_instance_id.hi = kQueryIdHi;
+        info.fragment_instance_id.lo = lo;
+        info.brpc_stub = _stubs[_instance_hosts[lo]].get();
+        info.params = std::make_shared<PTransmitChunkParams>();
+        info.params->set_eos(eos);
+        if (!data.empty()) {
+            info.params->add_chunks()->set_data_size(data.size());
+            info.attachment.append(data);
+            _sent_data[lo].push_back(data);
+        }
+        sink_buffer->add_request(info);
+    }
+
+    // Each sinker sends |kNumRounds| chunks and an EOS to each instance, and the in-flight RPCs are completed
+    // after each round, so that the requests queued while the previous ones are in flight could be batched.
+    void run_sinkers() {
+        SinkBuffer sink_buffer(_fragment_ctx.get(), _destinations, false, kNumSinkers);
+        for (int32_t round = 0; round < kNumRounds; round++) {
+            for (int32_t sinker = 0; sinker < kNumSinkers; sinker++) {
+                for (const auto& [lo, _] : _instance_hosts) {
+                    add_request(&sink_buffer, lo, fmt::format("{}-{}-{};", lo, sinker, round), false);
+                }
+            }
+            _recorder.complete_rpcs(_recorder.num_pending_rpcs() / 2);
+        }
+        for (int32_t sinker = 0; sinker < kNumSinkers; sinker++) {
+            for (const auto& [lo, _] : _instance_hosts) {
+                // The EOS of the first sinker carries the last chunk.
+                std::string data = sinker == 0 ? fmt::format("{}-{}-eos;", lo, sinker) : "";
+                add_request(&sink_buffer, lo, data, true);
+            }
+        }
+        ASSERT_FALSE(sink_buffer.is_finished());
+        _recorder.complete_all_rpcs();
+        ASSERT_TRUE(sink_buffer.is_finished());
+    }
+
+    // Each instance receives the data in the order it's sent, with continuous sequences, from its own host,
+    // and only the last request is EOS.
+    void check_received() {
+        std::map<int64_t, std::map<int64_t, const ReceivedRequest*>> requests_by_seq;
+        for (const auto& request : _recorder.received) {
+            const auto& finst_id = request.params.finst_id();
+            ASSERT_EQ(kQueryIdHi, finst_id.hi());
+            ASSERT_EQ(1, _instance_hosts.count(finst_id.lo()));
+            ASSERT_EQ(_instance_hosts[finst_id.lo()], request.host);
+            auto [_, inserted] = requests_by_seq[finst_id.lo()].emplace(request.params.sequence(), &request);
+            ASSERT_TRUE(inserted) << "duplicated sequence " << request.params.sequence();
+        }
+        ASSERT_EQ(_instance_hosts.size(), requests_by_seq.size());
+        for (const auto& [lo, requests] : requests_by_seq) {
+            std::vector<std::string> data;
+            int64_t expected_seq = 0;
+            for (const auto& [seq, request] : requests) {
+                ASSERT_EQ(expected_seq++, seq);
+                if (!request->data.empty()) {
+                    data.push_back(request->data);
+                }
+                ASSERT_EQ(seq == requests.rbegin()->first, request->params.eos()) << "instance " << lo;
+            }
+            ASSERT_EQ(_sent_data[lo], data) << "instance " << lo;
+        }
+    }
+
+    std::unique_ptr<FragmentContext> _fragment_ctx;
+    std::vector<TPlanFragmentDestination> _destinations;
+    std::map<int64_t, std::string> _instance_hosts;
+    std::map<std::string, std::unique_ptr<MockBackendServiceStub>> _stubs;
+    std::map<int64_t, std::vector<std::string>> _sent_data;
+    RpcRecorder _recorder;
+
+    bool _enable_coalescing = false;
+    int64_t _brpc_dop = 0;
+    int64_t _max_batched_bytes = 0;
+    int64_t _back_pressure_ms = 0;
+};
+
+TEST_F(SinkBufferTest, test_rpc_coalescing) {
+    config::enable_pipeline_sink_rpc_coalescing = true;
+
+    run_sinkers();
+    check_received();
+    ASSERT_GT(_recorder.num_batched_rpcs, 0);
+    ASSERT_LT(_recorder.num_rpcs, _recorder.received.size());
+}
+
+TEST_F(SinkBufferTest, test_rpc_coalescing_disabled) {
+    config::enable_pipeline_sink_rpc_coalescing = false;
+
+    run_sinkers();
+    check_received();
+    ASSERT_EQ(0, _recorder.num_batched_rpcs);
+    ASSERT_EQ(_recorder.num_rpcs, _recorder.received.size());
+}
+
+// The requests to a host are not batched beyond max_transmit_batched_bytes.
+TEST_F(SinkBufferTest, test_rpc_coalescing_max_bytes) {
+    config::enable_pipeline_sink_rpc_coalescing = true;
+    config::max_transmit_batched_bytes = 1;
+
+    run_sinkers();
+    check_received();
+    // Only the requests following an EOS without data could be batched.
+    ASSERT_EQ(0, _recorder.max_bytes_before_last_request);
+}
+
+// The requests to an instance whose RPCs are held by the back pressure of its receiver are sent in separate RPCs,
+// so the acks of the other instances on the same host are not delayed by it.
+TEST_F(SinkBufferTest, test_rpc_coalescing_back_pressure) {
+    config::enable_pipeline_sink_rpc_coalescing = true;
+    config::pipeline_sink_rpc_back_pressure_ms = 20;
+    _recorder.slow_instance = 3;
+    _recorder.slow_rpc_ms = 30;
+
+    run_sinkers();
+    check_received();
+    ASSERT_GT(_recorder.num_slow_rpcs_completed, 0);
+    ASSERT_EQ(0, _recorder.num_batched_rpcs_after_slow_rpc);
+}
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,58 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include <gtest/gtest.h>
+
+#include "env/env_memory.h"
+#include "exec/vectorized/csv_scanner.h"
+
+namespace starrocks::vectorized {
+
+static std::vector<std::string> split(const std::string& data, size_t block_size) {
+    CSVBlockSplitter splitter(std::make_shared<StringSequentialFile>(data), '\n', block_size);
+    std::vector<std::string> blocks;
+    std::string block;
+    int64_t seq = 0;
+    Status st;
+    while ((st = splitter.next_block(&block, &seq)).ok()) {
+        EXPECT_EQ(blocks.size(), seq);
+        blocks.emplace_back(block);
+    }
+    EXPECT_TRUE(st.is_end_of_file());
+    return blocks;
+}
+
+// NOLINTNEXTLINE
+TEST(CSVBlockSplitterTest, test_split_at_record_delimiter) {
+    std::string data;
+    for (int i = 0; i < 100000; i++) {
+        data += std::to_string(i) + "," + std::string(i % 50, 'x') + "\n";
+    }
+    // The last record without record delimiter.
+    data += "last";
+
+    auto blocks = split(data, 64 * 1024);
+    ASSERT_GT(blocks.size(), 1);
+    std::string merged;
+    for (size_t i = 0; i < blocks.size(); i++) {
+        if (i + 1 < blocks.size()) {
+            // Cut at the last record delimiter of the block.
+            ASSERT_GT(blocks[i].size(), 64 * 1024 - 100);
+            ASSERT_EQ('\n', blocks[i].back());
+        }
+        merged += blocks[i];
+    }
+    ASSERT_EQ(data, merged);
+    ASSERT_EQ("last", blocks.back().substr(blocks.back().size() - 4));
+}
+
+// NOLINTNEXTLINE
+TEST(CSVBlockSplitterTest, test_record_longer_than_block) {
+    std::string data = std::string(300 * 1024, 'a') + "\n";
+    auto blocks = split(data, 1024);
+    ASSERT_EQ(1, blocks.size());
+    ASSERT_EQ(data, blocks[0]);
+
+    ASSERT_TRUE(split("", 1024).empty());
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,114 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include "formats/csv/csv_reader.h"
+
+namespace starrocks::vectorized {
+
+// Read 64K records of a wide CSV file, the number of fields of a record is the argument of the benchmarks.
+static constexpr size_t kNumRecords = 64 * 1024;
+
+class StringCSVReader : public CSVReader {
+public:
+    explicit StringCSVReader(const std::string& data) : CSVReader('\n', ","), _data(data) {}
+
+protected:
+    Status _fill_buffer() override {
+        size_t n = std::min(_buff.free_space(), _data.size() - _offset);
+        memcpy(_buff.limit(), _data.data() + _offset, n);
+        _offset += n;
+        _buff.add_limit(n);
+        return n == 0 && _buff.available() == 0 ? Status::EndOfFile("StringCSVReader") : Status::OK();
+    }
+
+private:
+    const std::string& _data;
+    size_t _offset = 0;
+};
+
+static std::string gen_csv(size_t num_fields) {
+    std::mt19937 rng(0);
+    std::string data;
+    for (size_t i = 0; i < kNumRecords; i++) {
+        for (size_t j = 0; j < num_fields; j++) {
+            if (j > 0) {
+                data += ',';
+            }
+            // integers, decimals and short strings
+            size_t len = 1 + rng() % 12;
+            for (size_t k = 0; k < len; k++) {
+                data += static_cast<char>('0' + rng() % 10);
+            }
+        }
+        data += '\n';
+    }
+    return data;
+}
+
+// The field splitting before SIMD scanning, as the baseline.
+static void scalar_split_record(const CSVReader::Record& record, char delimiter, CSVReader::Fields* fields) {
+    const char* value = record.data;
+    const char* ptr = record.data;
+    for (size_t i = 0; i < record.size; ++i, ++ptr) {
+        if (*ptr == delimiter) {
+            fields->emplace_back(value, ptr - value);
+            value = ptr + 1;
+        }
+    }
+    fields->emplace_back(value, ptr - value);
+}
+
+static void BM_scalar_split(benchmark::State& state) {
+    std::string data = gen_csv(state.range(0));
+    for (auto _ : state) {
+        StringCSVReader reader(data);
+        CSVReader::Record record;
+        CSVReader::Fields fields;
+        while (reader.next_record(&record).ok()) {
+            fields.clear();
+            scalar_split_record(record, ',', &fields);
+            benchmark::DoNotOptimize(fields.data());
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+static void BM_split_record(benchmark::State& state) {
+    std::string data = gen_csv(state.range(0));
+    for (auto _ : state) {
+        StringCSVReader reader(data);
+        CSVReader::Record record;
+        CSVReader::Fields fields;
+        while (reader.next_record(&record).ok()) {
+            fields.clear();
+            reader.split_record(record, &fields);
+            benchmark::DoNotOptimize(fields.data());
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+static void BM_next_records(benchmark::State& state) {
+    std::string data = gen_csv(state.range(0));
+    for (auto _ : state) {
+        StringCSVReader reader(data);
+        CSVReader::Records records;
+        CSVReader::Fields fields;
+        std::vector<uint32_t> field_offsets;
+        while (reader.next_records(4096, &records, &fields, &field_offsets).ok()) {
+            benchmark::DoNotOptimize(fields.data());
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+BENCHMARK(BM_scalar_split)->Arg(4)->Arg(32)->Arg(128);
+BENCHMARK(BM_split_record)->Arg(4)->Arg(32)->Arg(128);
+BENCHMARK(BM_next_records)->Arg(4)->Arg(32)->Arg(128);
+
+} // namespace starrocks::vectorized
+
+BENCHMARK_MAIN();
@@ -0,0 +1,454 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "exec/vectorized/hash_joiner.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "column/column_helper.h"
+#include "column/fixed_length_column.h"
+#include "common/config.h"
+#include "exec/pipeline/runtime_filter_types.h"
+#include "exprs/slot_ref.h"
+#include "exprs/vectorized/runtime_filter.h"
+#include "gutil/strings/substitute.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/runtime_state.h"
+#include "testutil/assert.h"
+#include "util/file_utils.h"
+#include "util/hash_util.hpp"
+
+namespace starrocks::vectorized {
+
+// The probe tuple 0 has slot 0 (key) and slot 1 (value), the build tuple 1 has slot 2 (key) and slot 3 (value).
+// Build keys are [0, 2000) and [0, 100) once more, probe keys are [1000, 3000).
+class HashJoinerTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        _dir = "./ut_dir/hash_joiner_test";
+        ASSERT_OK(FileUtils::remove_all(_dir));
+        ASSERT_OK(FileUtils::create_dir(_dir));
+
+        _query_scratch_dirs = config::query_scratch_dirs;
+        _spill_operator_min_bytes = config::spill_operator_min_bytes;
+        _spill_operator_max_bytes = config::spill_operator_max_bytes;
+        _spill_partition_num = config::spill_partition_num;
+        _parallel_join_build_merge_rows = config::pipeline_parallel_join_build_merge_rows;
+        config::query_scratch_dirs = _dir;
+        // Spill the hash table once the first build chunk is appended.
+        config::spill_operator_min_bytes = 0;
+        config::spill_operator_max_bytes = 0;
+        config::spill_partition_num = 4;
+
+        TDescriptorTableBuilder desc_tbl_builder;
+        for (int i = 0; i < 2; i++) {
+            TTupleDescriptorBuilder tuple_builder;
+            tuple_builder.add_slot(
+                    TSlotDescriptorBuilder().type(TYPE_INT).column_name("k").column_pos(0).nullable(false).build());
+            tuple_builder.add_slot(
+                    TSlotDescriptorBuilder().type(TYPE_INT).column_name("v").column_pos(1).nullable(false).build());
+            tuple_builder.build(&desc_tbl_builder);
+        }
+        ASSERT_OK(DescriptorTbl::create(&_pool, desc_tbl_builder.desc_tbl(), &_desc_tbl, config::vector_chunk_size));
+    }
+
+    void TearDown() override {
+        config::query_scratch_dirs = _query_scratch_dirs;
+        config::spill_operator_min_bytes = _spill_operator_min_bytes;
+        config::spill_operator_max_bytes = _spill_operator_max_bytes;
+        config::spill_partition_num = _spill_partition_num;
+        config::pipeline_parallel_join_build_merge_rows = _parallel_join_build_merge_rows;
+        ASSERT_OK(FileUtils::remove_all(_dir));
+    }
+
+    struct JoinResult {
+        std::vector<std::string> rows;
+        bool spilled = false;
+        // The number of spilled build and probe partitions with rows.
+        size_t build_partitions = 0;
+        size_t probe_partitions = 0;
+    };
+
+    // Each chunk carries a tuple column of its tuple if |with_tuple_columns|, with every 7th row absent.
+    static ChunkPtr create_chunk(SlotId key_slot, int32_t begin, int32_t end, int32_t value_factor,
+                                 bool with_tuple_columns) {
+        auto keys = Int32Column::create();
+        auto values = Int32Column::create();
+        auto tuple_column = BooleanColumn::create();
+        for (int32_t i = begin; i < end; i++) {
+            keys->append(i);
+            values->append(i * value_factor);
+            tuple_column->append(i % 7 != 0);
+        }
+        auto chunk = std::make_shared<Chunk>();
+        chunk->append_column(keys, key_slot);
+        chunk->append_column(values, key_slot + 1);
+        if (with_tuple_columns) {
+            chunk->append_tuple_column(tuple_column, key_slot / 2);
+        }
+        return chunk;
+    }
+
+    static std::vector<ChunkPtr> create_build_chunks(bool with_tuple_columns) {
+        std::vector<ChunkPtr> chunks;
+        for (int32_t i = 0; i < 2000; i += 300) {
+            chunks.emplace_back(create_chunk(2, i, std::min(i + 300, 2000), 10, with_tuple_columns));
+        }
+        chunks.emplace_back(create_chunk(2, 0, 100, -1, with_tuple_columns));
+        return chunks;
+    }
+
+    static std::vector<ChunkPtr> create_probe_chunks(bool with_tuple_columns) {
+        std::vector<ChunkPtr> chunks;
+        for (int32_t i = 1000; i < 3000; i += 300) {
+            chunks.emplace_back(create_chunk(0, i, std::min(i + 300, 3000), 1, with_tuple_columns));
+        }
+        return chunks;
+    }
+
+    static void add_rows(const ChunkPtr& chunk, std::vector<std::string>* rows) {
+        for (size_t i = 0; i < chunk->num_rows(); i++) {
+            std::string row;
+            for (SlotId slot_id = 0; slot_id < 4; slot_id++) {
+                if (chunk->is_slot_exist(slot_id)) {
+                    row += chunk->get_column_by_slot_id(slot_id)->debug_item(i);
+                }
+                row += ",";
+            }
+            rows->emplace_back(std::move(row));
+        }
+    }
+
+    static void probe(RuntimeState* state, HashJoiner* joiner, ChunkPtr chunk, JoinResult* result) {
+        if (joiner->is_done()) {
+            return;
+        }
+        EXPECT_TRUE(joiner->need_input());
+        EXPECT_OK(joiner->push_chunk(state, std::move(chunk)));
+        while (!joiner->need_input()) {
+            auto chunk_or = joiner->pull_chunk(state);
+            EXPECT_OK(chunk_or.status());
+            add_rows(chunk_or.value(), &result->rows);
+        }
+    }
+
+    static void post_probe(RuntimeState* state, HashJoiner* joiner, JoinResult* result) {
+        joiner->enter_post_probe_phase();
+        while (!joiner->is_done()) {
+            auto chunk_or = joiner->pull_chunk(state);
+            EXPECT_OK(chunk_or.status());
+            add_rows(chunk_or.value(), &result->rows);
+        }
+    }
+
+    void merge_runtime_filters(size_t idx, HashJoiner* joiner, bool expect_merged) {
+        if (_runtime_filter_merger == nullptr) {
+            return;
+        }
+        auto merged = _runtime_filter_merger->add_partial_filters(
+                idx, joiner->get_ht_row_count(), std::move(joiner->get_runtime_in_filters()),
+                std::move(joiner->get_runtime_bloom_filter_build_params()),
+                std::move(joiner->get_runtime_bloom_filters()));
+        EXPECT_TRUE(merged.ok());
+        EXPECT_EQ(expect_merged, merged.value());
+    }
+
+    JoinResult run_join(TJoinOp::type join_type, bool enable_spill, bool with_tuple_columns = false) {
+        JoinResult result;
+
+        TQueryOptions query_options;
+        query_options.batch_size = 256;
+        query_options.__set_enable_spilling(enable_spill);
+        RuntimeState state(TUniqueId(), query_options, TQueryGlobals(), nullptr);
+        state.init_instance_mem_tracker();
+        RuntimeProfile build_profile("build");
+        RuntimeProfile probe_profile("probe");
+
+        bool probe_nullable = join_type == TJoinOp::RIGHT_OUTER_JOIN || join_type == TJoinOp::FULL_OUTER_JOIN;
+        bool build_nullable = join_type == TJoinOp::LEFT_OUTER_JOIN || join_type == TJoinOp::FULL_OUTER_JOIN;
+        RowDescriptor probe_row_desc(*_desc_tbl, {0}, {with_tuple_columns});
+        RowDescriptor build_row_desc(*_desc_tbl, {1}, {with_tuple_columns});
+        RowDescriptor row_desc(*_desc_tbl, {0, 1}, {probe_nullable, build_nullable});
+
+        THashJoinNode hash_join_node;
+        hash_join_node.join_op = join_type;
+        hash_join_node.is_push_down = false;
+        std::vector<ExprContext*> probe_expr_ctxs{
+                _pool.add(new ExprContext(_pool.add(new SlotRef(_desc_tbl->get_slot_descriptor(0)))))};
+        std::vector<ExprContext*> build_expr_ctxs{
+                _pool.add(new ExprContext(_pool.add(new SlotRef(_desc_tbl->get_slot_descriptor(2)))))};
+        HashJoinerParam param(&_pool, hash_join_node, 1, TPlanNodeType::HASH_JOIN_NODE, {false}, build_expr_ctxs,
+                              probe_expr_ctxs, {}, {}, build_row_desc, probe_row_desc, row_desc,
+                              TPlanNodeType::OLAP_SCAN_NODE, TPlanNodeType::OLAP_SCAN_NODE, true, _runtime_filters, {},
+                              TJoinDistributionMode::PARTITIONED);
+        param._is_buildable = true;
+        std::vector<HashJoinerPtr> read_only_join_probers;
+        auto joiner = std::make_shared<HashJoiner>(param, read_only_join_probers);
+
+        EXPECT_OK(joiner->prepare_builder(&state, &build_profile));
+        EXPECT_OK(joiner->prepare_prober(&state, &probe_profile));
+        for (const auto& chunk : create_build_chunks(with_tuple_columns)) {
+            EXPECT_OK(joiner->append_chunk_to_ht(&state, chunk));
+        }
+        EXPECT_OK(joiner->build_ht(&state));
+        EXPECT_OK(joiner->create_runtime_filters(&state));
+        result.spilled = joiner->is_spilled();
+        merge_runtime_filters(0, joiner.get(), true);
+        joiner->enter_probe_phase();
+
+        for (auto& chunk : create_probe_chunks(with_tuple_columns)) {
+            probe(&state, joiner.get(), std::move(chunk), &result);
+        }
+        post_probe(&state, joiner.get(), &result);
+
+        for (int i = 0; i < config::spill_partition_num; i++) {
+            auto name = strings::Substitute("Partition$0Bytes", i);
+            auto* build_counter = build_profile.get_counter(name);
+            auto* probe_counter = probe_profile.get_counter(name);
+            result.build_partitions += build_counter != nullptr && build_counter->value() > 0;
+            result.probe_partitions += probe_counter != nullptr && probe_counter->value() > 0;
+        }
+
+        joiner->close(&state);
+        std::sort(result.rows.begin(), result.rows.end());
+        return result;
+    }
+
+    void check_spilled_join(TJoinOp::type join_type, size_t expected_rows, bool with_tuple_columns = false) {
+        JoinResult expected = run_join(join_type, false, with_tuple_columns);
+        ASSERT_FALSE(expected.spilled);
+        ASSERT_EQ(expected_rows, expected.rows.size());
+
+        JoinResult actual = run_join(join_type, true, with_tuple_columns);
+        ASSERT_TRUE(actual.spilled);
+        ASSERT_EQ(config::spill_partition_num, actual.build_partitions);
+        ASSERT_EQ(config::spill_partition_num, actual.probe_partitions);
+        ASSERT_EQ(expected.rows, actual.rows);
+    }
+
+    // The hash table of a broadcast join is built by |dop| HashJoiners in parallel, each of which builds the sub hash
+    // table of the build rows shuffled to it by the FNV hash of the join key, like the local shuffle exchange.
+    // The probe chunks are dispatched to the HashJoiners in turn.
+    JoinResult run_parallel_join(TJoinOp::type join_type, size_t dop) {
+        JoinResult result;
+
+        TQueryOptions query_options;
+        query_options.batch_size = 256;
+        RuntimeState state(TUniqueId(), query_options, TQueryGlobals(), nullptr);
+        state.init_instance_mem_tracker();
+        RuntimeProfile profile("joiner");
+
+        bool build_nullable = join_type == TJoinOp::LEFT_OUTER_JOIN;
+        RowDescriptor probe_row_desc(*_desc_tbl, {0}, {false});
+        RowDescriptor build_row_desc(*_desc_tbl, {1}, {false});
+        RowDescriptor row_desc(*_desc_tbl, {0, 1}, {false, build_nullable});
+
+        THashJoinNode hash_join_node;
+        hash_join_node.join_op = join_type;
+        hash_join_node.is_push_down = false;
+        std::vector<ExprContext*> probe_expr_ctxs{
+                _pool.add(new ExprContext(_pool.add(new SlotRef(_desc_tbl->get_slot_descriptor(0)))))};
+        std::vector<ExprContext*> build_expr_ctxs{
+                _pool.add(new ExprContext(_pool.add(new SlotRef(_desc_tbl->get_slot_descriptor(2)))))};
+        HashJoinerParam param(&_pool, hash_join_node, 1, TPlanNodeType::HASH_JOIN_NODE, {false}, build_expr_ctxs,
+                              probe_expr_ctxs, {}, {}, build_row_desc, probe_row_desc, row_desc,
+                              TPlanNodeType::OLAP_SCAN_NODE, TPlanNodeType::OLAP_SCAN_NODE, true, _runtime_filters, {},
+                              TJoinDistributionMode::BROADCAST);
+        param._is_buildable = true;
+        param._is_parallel_build = true;
+        std::vector<HashJoinerPtr> read_only_join_probers;
+        std::vector<HashJoinerPtr> joiners;
+        for (size_t i = 0; i < dop; i++) {
+            auto& joiner = joiners.emplace_back(std::make_shared<HashJoiner>(param, read_only_join_probers));
+            EXPECT_OK(joiner->prepare_builder(&state, &profile));
+            EXPECT_OK(joiner->prepare_prober(&state, &profile));
+        }
+
+        for (const auto& chunk : create_build_chunks(false)) {
+            std::vector<uint32_t> hashes(chunk->num_rows(), HashUtil::FNV_SEED);
+            chunk->get_column_by_slot_id(2)->fnv_hash(hashes.data(), 0, chunk->num_rows());
+            for (size_t p = 0; p < dop; p++) {
+                std::vector<uint32_t> indexes;
+                for (uint32_t i = 0; i < hashes.size(); i++) {
+                    if (hashes[i] % dop == p) {
+                        indexes.push_back(i);
+                    }
+                }
+                ChunkPtr part = chunk->clone_empty(indexes.size());
+                part->append_selective(*chunk, indexes.data(), 0, indexes.size());
+                EXPECT_OK(joiners[p]->append_chunk_to_ht(&state, part));
+            }
+        }
+        for (size_t i = 0; i < dop; i++) {
+            EXPECT_OK(joiners[i]->build_ht(&state));
+            EXPECT_OK(joiners[i]->create_runtime_filters(&state));
+            merge_runtime_filters(i, joiners[i].get(), i + 1 == dop);
+        }
+        HashJoiner::share_parallel_built_hash_tables(&state, joiners);
+        for (auto& joiner : joiners) {
+            joiner->enter_probe_phase();
+        }
+
+        size_t next_joiner = 0;
+        for (auto& chunk : create_probe_chunks(false)) {
+            probe(&state, joiners[next_joiner++ % dop].get(), std::move(chunk), &result);
+        }
+        for (auto& joiner : joiners) {
+            post_probe(&state, joiner.get(), &result);
+        }
+
+        for (auto& joiner : joiners) {
+            joiner->close(&state);
+        }
+        std::sort(result.rows.begin(), result.rows.end());
+        return result;
+    }
+
+    void check_parallel_join(TJoinOp::type join_type, size_t expected_rows) {
+        JoinResult expected = run_join(join_type, false);
+        ASSERT_EQ(expected_rows, expected.rows.size());
+
+        // The sub hash tables are probed separately.
+        config::pipeline_parallel_join_build_merge_rows = 0;
+        ASSERT_EQ(expected.rows, run_parallel_join(join_type, 4).rows);
+
+        // The sub hash tables are merged into one.
+        config::pipeline_parallel_join_build_merge_rows = 1000000;
+        ASSERT_EQ(expected.rows, run_parallel_join(join_type, 4).rows);
+    }
+
+    RuntimeFilterBuildDescriptor* create_runtime_filter(int32_t filter_id, bool has_remote_targets) {
+        TExprNode slot_node;
+        slot_node.node_type = TExprNodeType::SLOT_REF;
+        slot_node.type = TypeDescriptor(TYPE_INT).to_thrift();
+        slot_node.num_children = 0;
+        TSlotRef slot_ref;
+        slot_ref.slot_id = 2;
+        slot_ref.tuple_id = 1;
+        slot_node.__set_slot_ref(slot_ref);
+        slot_node.is_nullable = false;
+        TExpr expr;
+        expr.nodes.emplace_back(slot_node);
+
+        TRuntimeFilterDescription desc;
+        desc.__set_filter_id(filter_id);
+        desc.__set_build_expr(expr);
+        desc.__set_expr_order(0);
+        desc.__set_plan_node_id_to_target_expr({{0, expr}});
+        desc.__set_has_remote_targets(has_remote_targets);
+        desc.__set_build_join_mode(TRuntimeFilterBuildJoinMode::PARTITIONED);
+
+        auto* rf_desc = _pool.add(new RuntimeFilterBuildDescriptor());
+        EXPECT_OK(rf_desc->init(&_pool, desc));
+        return rf_desc;
+    }
+
+protected:
+    std::string _dir;
+    std::string _query_scratch_dirs;
+    int64_t _spill_operator_min_bytes = 0;
+    int64_t _spill_operator_max_bytes = 0;
+    int32_t _spill_partition_num = 0;
+    int64_t _parallel_join_build_merge_rows = 0;
+
+    ObjectPool _pool;
+    DescriptorTbl* _desc_tbl = nullptr;
+    std::list<RuntimeFilterBuildDescriptor*> _runtime_filters;
+    std::unique_ptr<pipeline::PartialRuntimeFilterMerger> _runtime_filter_merger;
+};
+
+TEST_F(HashJoinerTest, test_spilled_inner_join) {
+    check_spilled_join(TJoinOp::INNER_JOIN, 1000);
+}
+
+TEST_F(HashJoinerTest, test_spilled_left_outer_join) {
+    check_spilled_join(TJoinOp::LEFT_OUTER_JOIN, 2000);
+}
+
+TEST_F(HashJoinerTest, test_spilled_left_semi_join) {
+    check_spilled_join(TJoinOp::LEFT_SEMI_JOIN, 1000);
+}
+
+TEST_F(HashJoinerTest, test_spilled_left_anti_join) {
+    check_spilled_join(TJoinOp::LEFT_ANTI_JOIN, 1000);
+}
+
+// The build rows not matched by any probe row of their partition are output in POST_PROBE phase.
+TEST_F(HashJoinerTest, test_spilled_right_outer_join) {
+    check_spilled_join(TJoinOp::RIGHT_OUTER_JOIN, 1000 + 1100);
+}
+
+TEST_F(HashJoinerTest, test_spilled_right_anti_join) {
+    check_spilled_join(TJoinOp::RIGHT_ANTI_JOIN, 1100);
+}
+
+TEST_F(HashJoinerTest, test_spilled_full_outer_join) {
+    check_spilled_join(TJoinOp::FULL_OUTER_JOIN, 1000 + 1100 + 1000);
+}
+
+// The null indicators of nullable tuples are spilled along with the slots.
+TEST_F(HashJoinerTest, test_spilled_join_with_tuple_columns) {
+    check_spilled_join(TJoinOp::INNER_JOIN, 1000, true);
+    check_spilled_join(TJoinOp::FULL_OUTER_JOIN, 1000 + 1100 + 1000, true);
+}
+
+// A spilled hash table doesn't keep its build keys in memory, so neither the global nor the local runtime
+// filters are built.
+TEST_F(HashJoinerTest, test_spilled_runtime_filters) {
+    auto* global_filter = create_runtime_filter(1, true);
+    auto* local_filter = create_runtime_filter(2, false);
+    _runtime_filters = {global_filter, local_filter};
+    _runtime_filter_merger = std::make_unique<pipeline::PartialRuntimeFilterMerger>(&_pool, 1024000, 1);
+
+    JoinResult result = run_join(TJoinOp::INNER_JOIN, true);
+    ASSERT_TRUE(result.spilled);
+    ASSERT_EQ(1000, result.rows.size());
+
+    ASSERT_TRUE(local_filter->runtime_filter() == nullptr);
+    ASSERT_TRUE(global_filter->runtime_filter() == nullptr);
+}
+
+TEST_F(HashJoinerTest, test_parallel_build_inner_join) {
+    check_parallel_join(TJoinOp::INNER_JOIN, 1000);
+}
+
+TEST_F(HashJoinerTest, test_parallel_build_left_outer_join) {
+    check_parallel_join(TJoinOp::LEFT_OUTER_JOIN, 2000);
+}
+
+TEST_F(HashJoinerTest, test_parallel_build_left_semi_join) {
+    check_parallel_join(TJoinOp::LEFT_SEMI_JOIN, 1000);
+}
+
+TEST_F(HashJoinerTest, test_parallel_build_left_anti_join) {
+    check_parallel_join(TJoinOp::LEFT_ANTI_JOIN, 1000);
+}
+
+// The partial runtime filters of the sub hash tables are merged into filters covering the whole build side,
+// and the limit of local filters applies to the whole build side rather than each sub hash table.
+TEST_F(HashJoinerTest, test_parallel_build_runtime_filters) {
+    config::pipeline_parallel_join_build_merge_rows = 0;
+    auto* global_filter = create_runtime_filter(1, true);
+    auto* local_filter = create_runtime_filter(2, false);
+    _runtime_filters = {global_filter, local_filter};
+
+    _runtime_filter_merger = std::make_unique<pipeline::PartialRuntimeFilterMerger>(&_pool, 1024000, 4);
+    ASSERT_EQ(1000, run_parallel_join(TJoinOp::INNER_JOIN, 4).rows.size());
+    for (auto* filter : _runtime_filters) {
+        ASSERT_TRUE(filter->runtime_filter() != nullptr);
+        auto* bloom_filter = down_cast<RuntimeBloomFilter<TYPE_INT>*>(filter->runtime_filter());
+        for (int32_t key = 0; key < 2000; key++) {
+            ASSERT_TRUE(bloom_filter->test_data(key)) << key;
+        }
+    }
+
+    global_filter->set_runtime_filter(nullptr);
+    local_filter->set_runtime_filter(nullptr);
+    _runtime_filter_merger = std::make_unique<pipeline::PartialRuntimeFilterMerger>(&_pool, 1500, 4);
+    ASSERT_EQ(1000, run_parallel_join(TJoinOp::INNER_JOIN, 4).rows.size());
+    ASSERT_TRUE(global_filter->runtime_filter() != nullptr);
+    ASSERT_TRUE(local_filter->runtime_filter() == nullptr);
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,160 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "exec/vectorized/spiller.h"
+
+#include <gtest/gtest.h>
+
+#include <map>
+
+#include "column/binary_column.h"
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+#include "env/env.h"
+#include "testutil/assert.h"
+#include "util/file_utils.h"
+
+namespace starrocks::vectorized {
+
+class SpillerTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        _dir = "./ut_dir/spiller_test";
+        ASSERT_OK(FileUtils::remove_all(_dir));
+        ASSERT_OK(FileUtils::create_dir(_dir));
+    }
+
+    void TearDown() override { ASSERT_OK(FileUtils::remove_all(_dir)); }
+
+    // key column: int32 [begin, end), value column: nullable string "v<key>", null for every 3rd row
+    static ChunkPtr build_chunk(int32_t begin, int32_t end) {
+        auto keys = Int32Column::create();
+        auto values = NullableColumn::create(BinaryColumn::create(), NullColumn::create());
+        for (int32_t i = begin; i < end; i++) {
+            keys->append(i);
+            if (i % 3 == 0) {
+                values->append_nulls(1);
+            } else {
+                std::string v = "v" + std::to_string(i);
+                values->append_datum(Datum(Slice(v)));
+            }
+        }
+        auto chunk = std::make_shared<Chunk>();
+        chunk->append_column(keys, 0);
+        chunk->append_column(values, 1);
+        return chunk;
+    }
+
+protected:
+    std::string _dir;
+};
+
+TEST_F(SpillerTest, test_spill_file_round_trip) {
+    auto prototype = build_chunk(0, 0);
+    SpillFile file(_dir + "/file");
+    ASSERT_OK(file.append(*build_chunk(0, 1000)));
+    ASSERT_OK(file.append(*build_chunk(0, 0)));
+    ASSERT_OK(file.append(*build_chunk(1000, 1500)));
+    ASSERT_OK(file.finish());
+    ASSERT_EQ(1500, file.num_rows());
+    ASSERT_EQ(2, file.num_chunks());
+    ASSERT_GT(file.file_size(), 0);
+
+    int32_t expected = 0;
+    while (true) {
+        auto res = file.read(*prototype);
+        if (res.status().is_end_of_file()) {
+            break;
+        }
+        ASSERT_OK(res.status());
+        auto& chunk = res.value();
+        ASSERT_EQ(2, chunk->num_columns());
+        for (size_t i = 0; i < chunk->num_rows(); i++, expected++) {
+            ASSERT_EQ(expected, chunk->get_column_by_index(0)->get(i).get_int32());
+            Datum v = chunk->get_column_by_index(1)->get(i);
+            if (expected % 3 == 0) {
+                ASSERT_TRUE(v.is_null());
+            } else {
+                ASSERT_EQ("v" + std::to_string(expected), v.get_slice().to_string());
+            }
+        }
+    }
+    ASSERT_EQ(1500, expected);
+
+    ASSERT_OK(file.remove());
+    ASSERT_FALSE(Env::Default()->path_exists(_dir + "/file").ok());
+}
+
+TEST_F(SpillerTest, test_partitioned_spiller) {
+    auto prototype = build_chunk(0, 0);
+    PartitionedSpiller spiller(_dir + "/agg", 4);
+    // Spill the same keys twice, they must end up in the same partition.
+    for (int round = 0; round < 2; round++) {
+        auto chunk = build_chunk(0, 4096);
+        ASSERT_OK(spiller.spill(*chunk, {chunk->get_column_by_index(0)}));
+    }
+    ASSERT_OK(spiller.finish());
+    ASSERT_EQ(2 * 4096, spiller.spilled_rows());
+    ASSERT_GT(spiller.spilled_bytes(), 0);
+
+    std::map<int32_t, std::pair<size_t, int>> key_partitions;
+    size_t total_rows = 0;
+    for (size_t p = 0; p < spiller.num_partitions(); p++) {
+        SpillFile* file = spiller.partition(p);
+        // Rows should be distributed among all partitions.
+        ASSERT_GT(file->num_rows(), 0);
+        while (true) {
+            auto res = file->read(*prototype);
+            if (res.status().is_end_of_file()) {
+                break;
+            }
+            ASSERT_OK(res.status());
+            const auto& keys = res.value()->get_column_by_index(0);
+            for (size_t i = 0; i < keys->size(); i++) {
+                auto& entry = key_partitions[keys->get(i).get_int32()];
+                if (entry.second > 0) {
+                    ASSERT_EQ(p, entry.first);
+                }
+                entry.first = p;
+                entry.second++;
+            }
+            total_rows += keys->size();
+        }
+    }
+    ASSERT_EQ(2 * 4096, total_rows);
+    ASSERT_EQ(4096, key_partitions.size());
+    for (const auto& [key, entry] : key_partitions) {
+        ASSERT_EQ(2, entry.second) << key;
+    }
+}
+
+// The rows of a partition all land in the same partition again with the same seed, but are split with another one.
+TEST_F(SpillerTest, test_repartition_with_another_seed) {
+    auto prototype = build_chunk(0, 0);
+    PartitionedSpiller spiller(_dir + "/agg", 4);
+    auto chunk = build_chunk(0, 4096);
+    ASSERT_OK(spiller.spill(*chunk, {chunk->get_column_by_index(0)}));
+    ASSERT_OK(spiller.finish());
+
+    PartitionedSpiller same_seed_spiller(_dir + "/agg_same_seed", 4);
+    PartitionedSpiller new_seed_spiller(_dir + "/agg_new_seed", 4, HashUtil::FNV_SEED + 1);
+    SpillFile* partition = spiller.partition(0);
+    while (true) {
+        auto res = partition->read(*prototype);
+        if (res.status().is_end_of_file()) {
+            break;
+        }
+        ASSERT_OK(res.status());
+        ASSERT_OK(same_seed_spiller.spill(*res.value(), {res.value()->get_column_by_index(0)}));
+        ASSERT_OK(new_seed_spiller.spill(*res.value(), {res.value()->get_column_by_index(0)}));
+    }
+    ASSERT_OK(same_seed_spiller.finish());
+    ASSERT_OK(new_seed_spiller.finish());
+
+    ASSERT_EQ(partition->num_rows(), same_seed_spiller.partition(0)->num_rows());
+    for (size_t p = 0; p < new_seed_spiller.num_partitions(); p++) {
+        ASSERT_GT(new_seed_spiller.partition(p)->num_rows(), 0);
+        ASSERT_LT(new_seed_spiller.partition(p)->num_rows(), partition->num_rows());
+    }
+}
+
+} // namespace starrocks::vectorized
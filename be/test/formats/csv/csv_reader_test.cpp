@@ -0,0 +1,123 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "formats/csv/csv_reader.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+namespace starrocks::vectorized {
+
+class StringCSVReader : public CSVReader {
+public:
+    StringCSVReader(std::string data, char record_delimiter, std::string field_delimiter)
+            : CSVReader(record_delimiter, std::move(field_delimiter)), _data(std::move(data)) {}
+
+protected:
+    Status _fill_buffer() override {
+        // Read a few bytes at a time so that the records cross the reads.
+        size_t n = std::min({_buff.free_space(), _data.size() - _offset, static_cast<size_t>(1000)});
+        memcpy(_buff.limit(), _data.data() + _offset, n);
+        _offset += n;
+        _buff.add_limit(n);
+        if (n == 0 && _buff.available() == 0) {
+            return Status::EndOfFile("StringCSVReader");
+        } else if (n == 0 && _buff.position()[_buff.available() - 1] != _record_delimiter) {
+            _buff.append(_record_delimiter);
+        }
+        return Status::OK();
+    }
+
+private:
+    std::string _data;
+    size_t _offset = 0;
+};
+
+static std::string gen_csv(std::mt19937* rng, const std::string& field_delimiter) {
+    std::string data;
+    for (int i = 0; i < 2000; i++) {
+        int num_fields = (*rng)() % 8;
+        for (int j = 0; j < num_fields; j++) {
+            if (j > 0) {
+                data += field_delimiter;
+            }
+            // Fields both shorter and longer than a SIMD block.
+            int len = (*rng)() % (i % 2 == 0 ? 10 : 100);
+            for (int k = 0; k < len; k++) {
+                data += static_cast<char>('a' + (*rng)() % 26);
+            }
+        }
+        data += '\n';
+    }
+    data.pop_back();
+    return data;
+}
+
+// The records and fields read one by one.
+static std::vector<std::vector<std::string>> read_by_record(CSVReader* reader) {
+    std::vector<std::vector<std::string>> rows;
+    CSVReader::Record record;
+    CSVReader::Fields fields;
+    while (reader->next_record(&record).ok()) {
+        fields.clear();
+        reader->split_record(record, &fields);
+        auto& row = rows.emplace_back();
+        for (const auto& field : fields) {
+            row.emplace_back(field.to_string());
+        }
+    }
+    return rows;
+}
+
+static std::vector<std::vector<std::string>> read_by_batch(CSVReader* reader, size_t batch_size) {
+    std::vector<std::vector<std::string>> rows;
+    CSVReader::Records records;
+    CSVReader::Fields fields;
+    std::vector<uint32_t> field_offsets;
+    while (reader->next_records(batch_size, &records, &fields, &field_offsets).ok()) {
+        EXPECT_LE(records.size(), batch_size);
+        EXPECT_EQ(records.size() + 1, field_offsets.size());
+        for (size_t i = 0; i < records.size(); i++) {
+            auto& row = rows.emplace_back();
+            for (size_t j = field_offsets[i]; j < field_offsets[i + 1]; j++) {
+                row.emplace_back(fields[j].to_string());
+            }
+        }
+    }
+    return rows;
+}
+
+// NOLINTNEXTLINE
+TEST(CSVReaderTest, test_split_record) {
+    StringCSVReader reader("", '\n', ",");
+    std::string record = "a,,bcd,efghijklmnopqrstuvwxyz0123456789,";
+    CSVReader::Fields fields;
+    reader.split_record(Slice(record), &fields);
+    ASSERT_EQ(5, fields.size());
+    EXPECT_EQ("a", fields[0].to_string());
+    EXPECT_EQ("", fields[1].to_string());
+    EXPECT_EQ("bcd", fields[2].to_string());
+    EXPECT_EQ("efghijklmnopqrstuvwxyz0123456789", fields[3].to_string());
+    EXPECT_EQ("", fields[4].to_string());
+}
+
+// NOLINTNEXTLINE
+TEST(CSVReaderTest, test_next_records) {
+    std::mt19937 rng(0);
+    for (const std::string& field_delimiter : {std::string(","), std::string("||")}) {
+        std::string data = gen_csv(&rng, field_delimiter);
+        for (size_t limit : {static_cast<size_t>(0), data.size() / 3}) {
+            for (size_t batch_size : {1, 7, 4096}) {
+                StringCSVReader reader1(data, '\n', field_delimiter);
+                StringCSVReader reader2(data, '\n', field_delimiter);
+                reader1.set_limit(limit);
+                reader2.set_limit(limit);
+                auto expected = read_by_record(&reader1);
+                ASSERT_FALSE(expected.empty());
+                ASSERT_EQ(expected, read_by_batch(&reader2, batch_size));
+            }
+        }
+    }
+}
+
+} // namespace starrocks::vectorized
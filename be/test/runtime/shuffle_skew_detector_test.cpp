@@ -0,0 +1,46 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "runtime/shuffle_skew_detector.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "util/hash_util.hpp"
+
+namespace starrocks {
+
+static uint32_t hash_of(uint32_t key) {
+    return HashUtil::fnv_hash(&key, sizeof(key), HashUtil::FNV_SEED);
+}
+
+TEST(ShuffleSkewDetectorTest, uniform) {
+    ShuffleSkewDetector detector(4, 1);
+    std::vector<uint32_t> hash_values;
+    for (uint32_t i = 0; i < 4096; ++i) {
+        hash_values.push_back(hash_of(i));
+    }
+    for (int i = 0; i < 16; ++i) {
+        detector.update(hash_values.data(), hash_values.size());
+    }
+    ASSERT_EQ(0, detector.hot_keys());
+    ASSERT_EQ(0, detector.hot_key_rows());
+    ASSERT_LT(detector.skew_ratio(), 1.5);
+}
+
+TEST(ShuffleSkewDetectorTest, hot_key) {
+    ShuffleSkewDetector detector(4, 1);
+    std::vector<uint32_t> hash_values;
+    for (uint32_t i = 0; i < 4095; ++i) {
+        // Half of the rows have the same key.
+        hash_values.push_back(hash_of(i % 2 == 0 ? 0 : i));
+    }
+    for (int i = 0; i < 16; ++i) {
+        detector.update(hash_values.data(), hash_values.size());
+    }
+    ASSERT_EQ(1, detector.hot_keys());
+    ASSERT_NEAR(4095 * 16 / 2, detector.hot_key_rows(), 4095 * 16 / 10);
+    ASSERT_GT(detector.skew_ratio(), 2);
+}
+
+} // namespace starrocks
@@ -156,6 +156,36 @@ PARALLEL_TEST(ColumnArraySerdeTest, binary_column) {
     }
 }
 
+// NOLINTNEXTLINE
+PARALLEL_TEST(ColumnArraySerdeTest, encoded_column) {
+    const int encode_level = ENCODE_INTEGER | ENCODE_STRING | ENCODE_NULL;
+    auto ints = vectorized::NullableColumn::create(vectorized::Int64Column::create(), vectorized::NullColumn::create());
+    auto strings = vectorized::NullableColumn::create(vectorized::BinaryColumn::create(),
+                                                      vectorized::NullColumn::create());
+    for (int i = 0; i < 1000; i++) {
+        ints->append_datum(vectorized::Datum(static_cast<int64_t>(1000000 + i)));
+        std::string s = strings::Substitute("value_$0", i % 10);
+        strings->append_datum(vectorized::Datum(Slice(s)));
+    }
+    strings->append_nulls(10);
+
+    for (const vectorized::ColumnPtr& c1 : {vectorized::ColumnPtr(ints), vectorized::ColumnPtr(strings)}) {
+        std::vector<uint8_t> buffer;
+        buffer.resize(ColumnArraySerde::max_serialized_size(*c1, encode_level));
+        ASSERT_EQ(ColumnArraySerde::max_serialized_size(*c1) + 2, buffer.size());
+        uint8_t* end = ColumnArraySerde::serialize(*c1, buffer.data(), encode_level);
+        ASSERT_NE(nullptr, end);
+        ASSERT_LT(end - buffer.data(), ColumnArraySerde::max_serialized_size(*c1) / 4);
+
+        auto c2 = c1->clone_empty();
+        ASSERT_EQ(end, ColumnArraySerde::deserialize(buffer.data(), c2.get(), encode_level));
+        ASSERT_EQ(c1->size(), c2->size());
+        for (size_t i = 0; i < c1->size(); i++) {
+            ASSERT_EQ(0, c1->compare_at(i, i, *c2, -1));
+        }
+    }
+}
+
 // NOLINTNEXTLINE
 PARALLEL_TEST(ColumnArraySerdeTest, const_column) {
     auto create_const_column = [](int32_t value, size_t size) {
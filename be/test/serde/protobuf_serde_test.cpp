@@ -9,6 +9,8 @@
 #include "column/fixed_length_column.h"
 #include "column/schema.h"
 #include "runtime/types.h"
+#include "serde/column_array_serde.h"
+#include "serde/encode_context.h"
 #include "testutil/parallel_test.h"
 
 namespace starrocks::serde {
@@ -83,4 +85,34 @@ PARALLEL_TEST(ProtobufChunkSerde, test_serde) {
     }
 }
 
+// NOLINTNEXTLINE
+PARALLEL_TEST(ProtobufChunkSerde, test_encoded_serde) {
+    auto chunk = std::make_unique<vectorized::Chunk>(make_columns(2), make_schema(2));
+    EncodeContext context(ENCODE_INTEGER | ENCODE_STRING | ENCODE_NULL);
+
+    StatusOr<ChunkPB> res = serde::ProtobufChunkSerde::serialize_without_meta(*chunk, &context);
+    ASSERT_TRUE(res.ok()) << res.status();
+    ASSERT_LT(res->serialized_size(), serde::ProtobufChunkSerde::max_serialized_size(*chunk));
+
+    ProtobufChunkMeta meta;
+    meta.slot_id_to_index[0] = 0;
+    meta.slot_id_to_index[1] = 1;
+    meta.is_nulls.resize(2, false);
+    meta.is_consts.resize(2, false);
+    meta.types.resize(2, TypeDescriptor(PrimitiveType::TYPE_INT));
+
+    ProtobufChunkDeserializer deserializer(meta);
+    int64_t deserialized_bytes = 0;
+    auto chunk_or = deserializer.deserialize(res->data(), &deserialized_bytes);
+    ASSERT_TRUE(chunk_or.ok()) << chunk_or.status();
+    ASSERT_EQ(res->serialized_size(), deserialized_bytes);
+    vectorized::Chunk& new_chunk = *chunk_or;
+    ASSERT_EQ(new_chunk.num_rows(), chunk->num_rows());
+    for (size_t i = 0; i < chunk->columns().size(); ++i) {
+        for (size_t j = 0; j < chunk->columns()[i]->size(); ++j) {
+            ASSERT_EQ(chunk->columns()[i]->get(j).get_int32(), new_chunk.columns()[i]->get(j).get_int32());
+        }
+    }
+}
+
 } // namespace starrocks::serde
@@ -0,0 +1,162 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "storage/data_dir.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <map>
+
+#include "runtime/mem_tracker.h"
+#include "storage/kv_store.h"
+#include "storage/olap_define.h"
+#include "storage/tablet_manager.h"
+#include "storage/tablet_meta_manager.h"
+#include "storage/txn_manager.h"
+#include "testutil/assert.h"
+#include "util/defer_op.h"
+
+namespace starrocks {
+
+namespace fs = std::filesystem;
+
+// DataDir::load() loads the tablet metas of the meta store in batches, the batches are loaded concurrently if
+// load_tablet_thread_num_per_store is greater than 1. The tablets loaded concurrently must be the same as the
+// tablets loaded serially, including which of the invalid tablet metas fail to load.
+class DataDirLoadTest : public ::testing::Test {
+public:
+    // More than 4 batches of kLoadMetaBatchSize.
+    static constexpr int64_t kNumTablets = 1100;
+    static constexpr int32_t kSchemaHash = 1111;
+
+    enum TabletKind {
+        kValid = 0,
+        // The meta can't be parsed.
+        kCorrupted,
+        // The schema hash of the meta is not the one of the key.
+        kMismatchedSchemaHash,
+        // The tablet is running but has no rowset.
+        kWithoutRowset,
+        // The tablet was dropped before the restart, it's not a failure.
+        kShutdown,
+        kNumKinds,
+    };
+
+    static TabletKind tablet_kind(int64_t tablet_id) { return static_cast<TabletKind>(tablet_id % kNumKinds); }
+
+protected:
+    void SetUp() override {
+        _path = (fs::temp_directory_path() / "data_dir_load_test").string();
+        fs::remove_all(_path);
+        CHECK(fs::create_directory(_path));
+        _mem_tracker = std::make_unique<MemTracker>();
+    }
+
+    void TearDown() override { fs::remove_all(_path); }
+
+    static TabletMetaPB create_tablet_meta_pb(int64_t tablet_id, TabletKind kind) {
+        TabletMetaPB meta_pb;
+        meta_pb.set_table_id(1);
+        meta_pb.set_partition_id(2);
+        meta_pb.set_tablet_id(tablet_id);
+        meta_pb.set_schema_hash(kind == kMismatchedSchemaHash ? kSchemaHash + 1 : kSchemaHash);
+        meta_pb.set_shard_id(0);
+        meta_pb.set_creation_time(65432);
+        meta_pb.mutable_tablet_uid()->set_hi(tablet_id);
+        meta_pb.mutable_tablet_uid()->set_lo(tablet_id);
+        meta_pb.set_tablet_type(TabletTypePB::TABLET_TYPE_DISK);
+        meta_pb.set_tablet_state(kind == kShutdown ? PB_SHUTDOWN : PB_RUNNING);
+        meta_pb.mutable_schema()->set_keys_type(DUP_KEYS);
+        meta_pb.mutable_schema()->set_num_short_key_columns(1);
+        auto c0 = meta_pb.mutable_schema()->add_column();
+        c0->set_unique_id(0);
+        c0->set_name("c0");
+        c0->set_is_key(true);
+        c0->set_type("INT");
+        c0->set_index_length(4);
+        if (kind != kWithoutRowset) {
+            RowsetMetaPB* rowset_meta_pb = meta_pb.add_rs_metas();
+            RowsetId rowset_id;
+            rowset_id.init(2, tablet_id, 0, 0);
+            rowset_meta_pb->set_rowset_id(0);
+            rowset_meta_pb->set_rowset_id_v2(rowset_id.to_string());
+            rowset_meta_pb->set_tablet_id(tablet_id);
+            rowset_meta_pb->set_tablet_schema_hash(kSchemaHash);
+            rowset_meta_pb->set_rowset_type(BETA_ROWSET);
+            rowset_meta_pb->set_rowset_state(VISIBLE);
+            rowset_meta_pb->set_start_version(0);
+            rowset_meta_pb->set_end_version(1);
+            rowset_meta_pb->set_num_rows(0);
+            rowset_meta_pb->set_num_segments(0);
+            rowset_meta_pb->set_empty(true);
+            rowset_meta_pb->mutable_tablet_uid()->CopyFrom(meta_pb.tablet_uid());
+        }
+        return meta_pb;
+    }
+
+    static void save_tablet_metas(DataDir* data_dir) {
+        for (int64_t tablet_id = 1; tablet_id <= kNumTablets; tablet_id++) {
+            TabletKind kind = tablet_kind(tablet_id);
+            if (kind == kCorrupted) {
+                std::string key = "tabletmeta_" + std::to_string(tablet_id) + "_" + std::to_string(kSchemaHash);
+                ASSERT_OK(data_dir->get_meta()->put(META_COLUMN_FAMILY_INDEX, key, "corrupted tablet meta"));
+            } else {
+                ASSERT_OK(TabletMetaManager::save(data_dir, tablet_id, kSchemaHash,
+                                                  create_tablet_meta_pb(tablet_id, kind)));
+            }
+        }
+    }
+
+    // Load the tablet metas with |num_threads| threads, and return the states of the loaded tablets by tablet id.
+    std::map<int64_t, TabletState> load_tablets(int32_t num_threads) {
+        int32_t old_num_threads = config::load_tablet_thread_num_per_store;
+        bool old_ignore_failure = config::ignore_load_tablet_failure;
+        config::load_tablet_thread_num_per_store = num_threads;
+        // Otherwise the invalid tablet metas stop the process.
+        config::ignore_load_tablet_failure = true;
+        DeferOp op([&]() {
+            config::load_tablet_thread_num_per_store = old_num_threads;
+            config::ignore_load_tablet_failure = old_ignore_failure;
+        });
+
+        fs::remove_all(_path);
+        CHECK(fs::create_directory(_path));
+        auto tablet_manager = std::make_unique<TabletManager>(_mem_tracker.get(), 4);
+        TxnManager txn_manager(4, 4);
+        auto data_dir = std::make_unique<DataDir>(_path, TStorageMedium::HDD, tablet_manager.get(), &txn_manager);
+        std::map<int64_t, TabletState> tablet_states;
+        EXPECT_OK(data_dir->init());
+        save_tablet_metas(data_dir.get());
+        EXPECT_OK(data_dir->load());
+        for (int64_t tablet_id = 1; tablet_id <= kNumTablets; tablet_id++) {
+            // The shutdown tablets are not in the tablet map, but kept to be moved to trash.
+            if (auto tablet = tablet_manager->get_tablet(tablet_id, true); tablet != nullptr) {
+                tablet_states[tablet_id] = tablet->tablet_state();
+            }
+        }
+        tablet_manager.reset();
+        return tablet_states;
+    }
+
+    std::string _path;
+    std::unique_ptr<MemTracker> _mem_tracker;
+};
+
+TEST_F(DataDirLoadTest, test_parallel_load_same_as_serial) {
+    std::map<int64_t, TabletState> expected;
+    for (int64_t tablet_id = 1; tablet_id <= kNumTablets; tablet_id++) {
+        if (tablet_kind(tablet_id) == kValid) {
+            expected[tablet_id] = TABLET_RUNNING;
+        } else if (tablet_kind(tablet_id) == kShutdown) {
+            expected[tablet_id] = TABLET_SHUTDOWN;
+        }
+    }
+
+    std::map<int64_t, TabletState> serial = load_tablets(1);
+    ASSERT_EQ(expected, serial);
+    for (int32_t num_threads : {2, 8, 32}) {
+        ASSERT_EQ(serial, load_tablets(num_threads)) << "num_threads=" << num_threads;
+    }
+}
+
+} // namespace starrocks
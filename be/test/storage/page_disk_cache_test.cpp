@@ -0,0 +1,149 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "storage/page_disk_cache.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include "env/env.h"
+#include "runtime/mem_tracker.h"
+#include "storage/page_cache.h"
+#include "util/file_utils.h"
+
+namespace starrocks {
+
+class PageDiskCacheTest : public testing::Test {
+public:
+    void SetUp() override {
+        _root_path = "./ut_dir/page_disk_cache_test";
+        FileUtils::remove_all(_root_path);
+        _mem_tracker = std::make_unique<MemTracker>();
+    }
+
+    void TearDown() override { FileUtils::remove_all(_root_path); }
+
+protected:
+    static char* new_page(size_t size, char c) {
+        char* page = new char[size];
+        memset(page, c, size);
+        return page;
+    }
+
+    static void check_page(PageDiskCache* cache, const std::string& key, size_t size, char c) {
+        std::unique_ptr<char[]> page;
+        size_t page_size = 0;
+        ASSERT_TRUE(cache->lookup(key, 16, &page, &page_size)) << key;
+        ASSERT_EQ(size, page_size);
+        for (size_t i = 0; i < size; i++) {
+            ASSERT_EQ(c, page[i]);
+        }
+    }
+
+    std::string _root_path;
+    std::unique_ptr<MemTracker> _mem_tracker;
+};
+
+// NOLINTNEXTLINE
+TEST_F(PageDiskCacheTest, insert_and_lookup) {
+    PageDiskCache cache(_root_path, 64 * 1024 * 1024, _mem_tracker.get());
+    ASSERT_TRUE(cache.open().ok());
+
+    for (int i = 0; i < 10; i++) {
+        cache.insert("key" + std::to_string(i), new_page(1000 + i, 'a' + i), 1000 + i);
+    }
+    cache.flush();
+    ASSERT_EQ(10, cache.num_pages());
+    for (int i = 0; i < 10; i++) {
+        check_page(&cache, "key" + std::to_string(i), 1000 + i, 'a' + i);
+    }
+
+    std::unique_ptr<char[]> page;
+    size_t size = 0;
+    ASSERT_FALSE(cache.lookup("key10", 0, &page, &size));
+}
+
+// NOLINTNEXTLINE
+TEST_F(PageDiskCacheTest, evict_oldest_file) {
+    // 1MB data files
+    const size_t capacity = 4 * 1024 * 1024;
+    const size_t page_size = 64 * 1024;
+    PageDiskCache cache(_root_path, capacity, _mem_tracker.get());
+    ASSERT_TRUE(cache.open().ok());
+
+    for (int i = 0; i < 128; i++) {
+        cache.insert("key" + std::to_string(i), new_page(page_size, 'x'), page_size);
+        // don't drop the pages because of the write buffer limit
+        cache.flush();
+    }
+    ASSERT_LE(cache.usage(), capacity);
+
+    std::unique_ptr<char[]> page;
+    size_t size = 0;
+    ASSERT_FALSE(cache.lookup("key0", 0, &page, &size));
+    check_page(&cache, "key127", page_size, 'x');
+}
+
+// NOLINTNEXTLINE
+TEST_F(PageDiskCacheTest, reopen) {
+    const size_t capacity = 4 * 1024 * 1024;
+    const size_t page_size = 100 * 1024;
+    {
+        PageDiskCache cache(_root_path, capacity, _mem_tracker.get());
+        ASSERT_TRUE(cache.open().ok());
+        for (int i = 0; i < 20; i++) {
+            cache.insert("key" + std::to_string(i), new_page(page_size, 'a' + i), page_size);
+            cache.flush();
+        }
+    }
+    size_t num_pages = 0;
+    {
+        // load from the index files
+        PageDiskCache cache(_root_path, capacity, _mem_tracker.get());
+        ASSERT_TRUE(cache.open().ok());
+        num_pages = cache.num_pages();
+        ASSERT_EQ(20, num_pages);
+        check_page(&cache, "key0", page_size, 'a');
+        check_page(&cache, "key19", page_size, 'a' + 19);
+    }
+
+    // load by scanning the data files
+    std::vector<std::string> children;
+    ASSERT_TRUE(FileUtils::list_files(Env::Default(), _root_path, &children).ok());
+    for (const auto& name : children) {
+        if (name.find(".idx") != std::string::npos) {
+            ASSERT_TRUE(Env::Default()->delete_file(_root_path + "/" + name).ok());
+        }
+    }
+    PageDiskCache cache(_root_path, capacity, _mem_tracker.get());
+    ASSERT_TRUE(cache.open().ok());
+    ASSERT_EQ(num_pages, cache.num_pages());
+    check_page(&cache, "key10", page_size, 'a' + 10);
+}
+
+// NOLINTNEXTLINE
+TEST_F(PageDiskCacheTest, demote_and_promote) {
+    StoragePageCache cache(_mem_tracker.get(), kNumShards * 2048);
+    ASSERT_TRUE(cache.init_disk_cache(_root_path, 64 * 1024 * 1024).ok());
+
+    StoragePageCache::CacheKey key("abc", 0);
+    {
+        PageCacheHandle handle;
+        cache.insert(key, Slice(new_page(1024, 'a'), 1024), &handle, false);
+    }
+    // put too many page to eliminate first page
+    for (int i = 0; i < 10 * kNumShards; ++i) {
+        StoragePageCache::CacheKey key("bcd", i);
+        PageCacheHandle handle;
+        cache.insert(key, Slice(new_page(1024, 'b'), 1024), &handle, false);
+    }
+    cache.disk_cache()->flush();
+
+    PageCacheHandle handle;
+    ASSERT_TRUE(cache.lookup(key, &handle));
+    ASSERT_EQ(1024, handle.data().size);
+    ASSERT_EQ('a', handle.data().data[0]);
+    ASSERT_EQ('a', handle.data().data[1023]);
+}
+
+} // namespace starrocks
@@ -4,11 +4,13 @@
 
 #include <gtest/gtest.h>
 
+#include "common/config.h"
 #include "env/env_memory.h"
 #include "storage/fs/file_block_manager.h"
 #include "storage/storage_engine.h"
 #include "testutil/parallel_test.h"
 #include "util/coding.h"
+#include "util/defer_op.h"
 #include "util/faststring.h"
 #include "util/file_utils.h"
 
@@ -242,7 +244,7 @@ PARALLEL_TEST(PersistentIndexTest, test_mutable_flush_to_immutable) {
     std::unique_ptr<fs::WritableBlock> wblock;
     fs::CreateBlockOptions opts({"/index.l1.1.1"});
     ASSERT_TRUE(block_mgr->create_block(opts, &wblock).ok());
-    auto st = idx->flush_to_immutable_index(idx->size(), EditVersion(1, 1), *wblock);
+    auto st = idx->flush_to_immutable_index(idx->size(), EditVersion(1, 1), *wblock, false);
     if (!st.ok()) {
         LOG(WARNING) << st;
     }
@@ -284,4 +286,97 @@ PARALLEL_TEST(PersistentIndexTest, test_mutable_flush_to_immutable) {
     ASSERT_TRUE(idx_loaded->check_not_exist(10, check_not_exist_keys.data()).ok());
 }
 
+PARALLEL_TEST(PersistentIndexTest, test_flush_and_merge_immutable_index) {
+    Env* env = Env::Default();
+    const std::string kPersistentIndexDir = "./ut_dir/persistent_index_test_merge";
+    ASSERT_TRUE(FileUtils::remove_all(kPersistentIndexDir).ok());
+    ASSERT_TRUE(env->create_dir(kPersistentIndexDir).ok());
+    {
+        fs::BlockManager* block_mgr = fs::fs_util::block_manager();
+        std::unique_ptr<fs::WritableBlock> wblock;
+        fs::CreateBlockOptions wblock_opts({kPersistentIndexDir + "/index.l0.0.0"});
+        ASSERT_TRUE((block_mgr->create_block(wblock_opts, &wblock)).ok());
+        wblock->close();
+    }
+    int64_t old_l0_max_mem_usage = config::l0_max_mem_usage;
+    int32_t old_merge_threshold = config::persistent_index_merge_threshold;
+    // flush l0 in each commit, and merge every 2 immutable indexes
+    config::l0_max_mem_usage = 1;
+    config::persistent_index_merge_threshold = 2;
+    DeferOp reset_config([&] {
+        config::l0_max_mem_usage = old_l0_max_mem_usage;
+        config::persistent_index_merge_threshold = old_merge_threshold;
+    });
+
+    using Key = uint64_t;
+    PersistentIndexMetaPB index_meta;
+    index_meta.set_key_size(sizeof(Key));
+    index_meta.set_size(0);
+    EditVersion(0, 0).to_pb(index_meta.mutable_version());
+    EditVersion(0, 0).to_pb(index_meta.mutable_l0_meta()->mutable_snapshot()->mutable_version());
+    PersistentIndex index(kPersistentIndexDir);
+    ASSERT_TRUE(index.create(sizeof(Key), EditVersion(0, 0)).ok());
+    ASSERT_TRUE(index.load(index_meta).ok());
+
+    // each round upserts keys [round * N, round * N + 2 * N), and then erases the first N / 2 of them
+    const int N = 10000;
+    const int kRounds = 6;
+    for (int round = 0; round < kRounds; round++) {
+        vector<Key> keys;
+        vector<IndexValue> values;
+        for (int i = round * N; i < round * N + 2 * N; i++) {
+            keys.emplace_back(i);
+            values.emplace_back(i * 2 + round);
+        }
+        vector<IndexValue> old_values(keys.size());
+        ASSERT_TRUE(index.prepare(EditVersion(round + 1, 0)).ok());
+        ASSERT_TRUE(index.upsert(keys.size(), keys.data(), values.data(), old_values.data()).ok());
+        for (int i = 0; i < 2 * N; i++) {
+            Key key = keys[i];
+            if (round > 0 && key < round * N + N) {
+                ASSERT_EQ(key * 2 + round - 1, old_values[i]);
+            } else {
+                ASSERT_EQ(NullIndexValue, old_values[i]);
+            }
+        }
+        vector<Key> erase_keys(keys.begin(), keys.begin() + N / 2);
+        vector<IndexValue> erase_old_values(erase_keys.size());
+        ASSERT_TRUE(index.erase(erase_keys.size(), erase_keys.data(), erase_old_values.data()).ok());
+        ASSERT_TRUE(index.commit(&index_meta).ok());
+        ASSERT_TRUE(index.on_commited().ok());
+        ASSERT_EQ((round + 2) * N - (round + 1) * N / 2, index.size());
+    }
+    ASSERT_GT(index.l2_num(), 0);
+    ASSERT_LE(index.l1_num() + index.l2_num(), 4);
+
+    auto check = [&](PersistentIndex& idx) {
+        vector<Key> keys;
+        for (int i = 0; i < (kRounds + 1) * N; i++) {
+            keys.emplace_back(i);
+        }
+        vector<IndexValue> values(keys.size());
+        ASSERT_TRUE(idx.get(keys.size(), keys.data(), values.data()).ok());
+        for (int i = 0; i < keys.size(); i++) {
+            int round = std::min(i / N, kRounds - 1);
+            if (i % N < N / 2 && i < kRounds * N) {
+                // erased by the round upserting it last
+                ASSERT_EQ(NullIndexValue, values[i]) << i;
+            } else {
+                ASSERT_EQ(i * 2 + round, values[i]) << i;
+            }
+        }
+        ASSERT_TRUE(idx.insert(1, &keys[N + N / 2], &values[N + N / 2], true).is_already_exist());
+    };
+    check(index);
+
+    // reload from meta
+    PersistentIndex new_index(kPersistentIndexDir);
+    ASSERT_TRUE(new_index.create(sizeof(Key), EditVersion(kRounds, 0)).ok());
+    ASSERT_TRUE(new_index.load(index_meta).ok());
+    ASSERT_EQ(index.l1_num(), new_index.l1_num());
+    ASSERT_EQ(index.l2_num(), new_index.l2_num());
+    check(new_index);
+    ASSERT_TRUE(FileUtils::remove_all(kPersistentIndexDir).ok());
+}
+
 } // namespace starrocks
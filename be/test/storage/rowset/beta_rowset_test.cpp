@@ -391,4 +391,64 @@ TEST_F(BetaRowsetTest, VerticalWriteTest) {
     EXPECT_EQ(count, num_rows);
 }
 
+TEST_F(BetaRowsetTest, SegmentRangeTest) {
+    TabletSchema tablet_schema;
+    create_tablet_schema(&tablet_schema);
+    const int32_t rows_per_segment = 1024;
+    const int32_t num_segments = 3;
+
+    RowsetWriterContext writer_context(kDataFormatV2, kDataFormatV2);
+    create_rowset_writer_context(&tablet_schema, &writer_context);
+    writer_context.segments_overlap = OVERLAPPING;
+
+    std::unique_ptr<RowsetWriter> rowset_writer;
+    ASSERT_TRUE(RowsetFactory::create_rowset_writer(writer_context, &rowset_writer).ok());
+
+    auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema);
+    // The v1 of the rows in segment i is i.
+    for (int32_t seg = 0; seg < num_segments; seg++) {
+        auto chunk = vectorized::ChunkHelper::new_chunk(schema, rows_per_segment);
+        auto& cols = chunk->columns();
+        for (int32_t i = 0; i < rows_per_segment; i++) {
+            cols[0]->append_datum(vectorized::Datum(i));
+            cols[1]->append_datum(vectorized::Datum(i));
+            cols[2]->append_datum(vectorized::Datum(seg));
+        }
+        ASSERT_OK(rowset_writer->add_chunk(*chunk));
+        ASSERT_OK(rowset_writer->flush());
+    }
+    RowsetSharedPtr rowset = rowset_writer->build().value();
+    ASSERT_EQ(num_segments, rowset->rowset_meta()->num_segments());
+
+    // Read the segments in [1, 3) only.
+    vectorized::RowsetReadOptions rs_opts;
+    rs_opts.sorted = false;
+    rs_opts.stats = &_stats;
+    rs_opts.tablet_schema = &tablet_schema;
+    rs_opts.segment_begin = 1;
+    rs_opts.segment_end = num_segments;
+    std::vector<vectorized::ChunkIteratorPtr> iters;
+    ASSERT_OK(rowset->get_segment_iterators(schema, rs_opts, &iters));
+    ASSERT_EQ(num_segments - 1, iters.size());
+
+    std::vector<int32_t> rows_of_segments(num_segments, 0);
+    auto chunk = vectorized::ChunkHelper::new_chunk(schema, 100);
+    for (auto& iter : iters) {
+        while (true) {
+            chunk->reset();
+            auto st = iter->get_next(chunk.get());
+            if (st.is_end_of_file()) {
+                break;
+            }
+            ASSERT_OK(st);
+            for (size_t i = 0; i < chunk->num_rows(); i++) {
+                rows_of_segments[chunk->get(i)[2].get_int32()]++;
+            }
+        }
+    }
+    EXPECT_EQ(0, rows_of_segments[0]);
+    EXPECT_EQ(rows_per_segment, rows_of_segments[1]);
+    EXPECT_EQ(rows_per_segment, rows_of_segments[2]);
+}
+
 } // namespace starrocks
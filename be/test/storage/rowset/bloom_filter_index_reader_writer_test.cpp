@@ -287,4 +287,58 @@ TEST_F(BloomFilterIndexReaderWriterTest, test_decimal) {
     delete[] val;
 }
 
+TEST_F(BloomFilterIndexReaderWriterTest, test_ngram) {
+    std::string fname = kTestDir + "/bloom_filter_ngram";
+    // page 0 contains "apple-<i>", page 1 contains "banana-<i>" and nulls
+    std::vector<std::string> strings;
+    for (int i = 0; i < 2048; ++i) {
+        strings.emplace_back((i < 1024 ? "apple-" : "banana-") + std::to_string(i));
+    }
+    std::vector<Slice> slices(strings.begin(), strings.end());
+    ColumnIndexMetaPB meta;
+    {
+        std::unique_ptr<fs::WritableBlock> wblock;
+        fs::CreateBlockOptions opts({fname});
+        ASSERT_TRUE(_block_mgr->create_block(opts, &wblock).ok());
+
+        std::unique_ptr<BloomFilterIndexWriter> writer;
+        ASSERT_TRUE(BloomFilterIndexWriter::create_ngram(BloomFilterOptions(), get_type_info(OLAP_FIELD_TYPE_VARCHAR),
+                                                         3, &writer)
+                            .ok());
+        writer->add_values(slices.data(), 1024);
+        ASSERT_TRUE(writer->flush().ok());
+        writer->add_values(slices.data() + 1024, 1024);
+        writer->add_nulls(10);
+        ASSERT_TRUE(writer->flush().ok());
+        ASSERT_TRUE(writer->finish(wblock.get(), &meta).ok());
+        ASSERT_TRUE(wblock->close().ok());
+        ASSERT_EQ(NGRAM_BLOOM_FILTER_INDEX, meta.type());
+    }
+
+    std::unique_ptr<BloomFilterIndexReader> reader(new BloomFilterIndexReader());
+    ASSERT_TRUE(reader->load(_block_mgr, fname, &meta.ngram_bloom_filter_index(), true, false).ok());
+    ASSERT_EQ(3, reader->gram_size());
+    std::unique_ptr<BloomFilterIndexIterator> iter;
+    ASSERT_TRUE(reader->new_iterator(&iter).ok());
+
+    std::unique_ptr<BloomFilter> bf0;
+    std::unique_ptr<BloomFilter> bf1;
+    ASSERT_TRUE(iter->read_bloom_filter(0, &bf0).ok());
+    ASSERT_TRUE(iter->read_bloom_filter(1, &bf1).ok());
+    ASSERT_FALSE(bf0->has_null());
+    ASSERT_TRUE(bf1->has_null());
+    for (int i = 0; i < 2048; ++i) {
+        const BloomFilter* bf = i < 1024 ? bf0.get() : bf1.get();
+        for (size_t j = 0; j + 3 <= slices[i].size; ++j) {
+            ASSERT_TRUE(bf->test_bytes(slices[i].data + j, 3));
+        }
+    }
+    // the grams of "banana" are not in page 0 except false positives
+    int num_positives = 0;
+    for (const char* gram : {"ban", "ana", "nan"}) {
+        num_positives += bf0->test_bytes(gram, 3);
+    }
+    ASSERT_LT(num_positives, 3);
+}
+
 } // namespace starrocks
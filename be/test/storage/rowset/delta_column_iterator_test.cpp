@@ -0,0 +1,75 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "storage/rowset/delta_column_iterator.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "column/fixed_length_column.h"
+#include "storage/rowset/default_value_column_iterator.h"
+#include "storage/types.h"
+#include "storage/vectorized/range.h"
+
+namespace starrocks {
+
+class DeltaColumnIteratorTest : public testing::Test {
+protected:
+    void SetUp() override {
+        _base = std::make_unique<DefaultValueColumnIterator>(true, "0", false, get_type_info(OLAP_FIELD_TYPE_INT),
+                                                             sizeof(int32_t), kNumRows);
+        ColumnIteratorOptions opts;
+        ASSERT_TRUE(_base->init(opts).ok());
+        auto values = vectorized::Int32Column::create();
+        for (uint32_t rowid : _rowids) {
+            values->append(rowid * 10);
+        }
+        _iter = std::make_unique<DeltaColumnIterator>(_base.get(), kNumRows, _rowids, values);
+    }
+
+    static constexpr ordinal_t kNumRows = 100;
+    std::vector<rowid_t> _rowids{3, 50, 51, 99};
+    std::unique_ptr<DefaultValueColumnIterator> _base;
+    std::unique_ptr<DeltaColumnIterator> _iter;
+};
+
+// NOLINTNEXTLINE
+TEST_F(DeltaColumnIteratorTest, test_next_batch) {
+    ASSERT_TRUE(_iter->seek_to_first().ok());
+    auto column = vectorized::Int32Column::create();
+    size_t n = 10;
+    ASSERT_TRUE(_iter->next_batch(&n, column.get()).ok());
+    ASSERT_TRUE(_iter->seek_to_ordinal(48).ok());
+    n = 52;
+    ASSERT_TRUE(_iter->next_batch(&n, column.get()).ok());
+    ASSERT_EQ(62, column->size());
+    for (size_t i = 0; i < column->size(); i++) {
+        rowid_t rowid = i < 10 ? i : i - 10 + 48;
+        bool updated = std::find(_rowids.begin(), _rowids.end(), rowid) != _rowids.end();
+        ASSERT_EQ(updated ? static_cast<int32_t>(rowid * 10) : 0, column->get_data()[i]) << "rowid " << rowid;
+    }
+}
+
+// NOLINTNEXTLINE
+TEST_F(DeltaColumnIteratorTest, test_next_batch_by_range) {
+    vectorized::SparseRange range;
+    range.add(vectorized::Range(0, 4));
+    range.add(vectorized::Range(51, 60));
+    auto column = vectorized::Int32Column::create();
+    ASSERT_TRUE(_iter->next_batch(range, column.get()).ok());
+    ASSERT_EQ(13, column->size());
+    ASSERT_EQ(30, column->get_data()[3]);
+    ASSERT_EQ(510, column->get_data()[4]);
+    ASSERT_EQ(0, column->get_data()[5]);
+}
+
+// NOLINTNEXTLINE
+TEST_F(DeltaColumnIteratorTest, test_fetch_values_by_rowid) {
+    std::vector<rowid_t> rowids{2, 3, 51, 52, 99};
+    auto column = vectorized::Int32Column::create();
+    ASSERT_TRUE(_iter->fetch_values_by_rowid(rowids.data(), rowids.size(), column.get()).ok());
+    std::vector<int32_t> expected{0, 30, 510, 0, 990};
+    ASSERT_EQ(expected, column->get_data());
+}
+
+} // namespace starrocks
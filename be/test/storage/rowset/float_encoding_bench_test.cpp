@@ -0,0 +1,99 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include "column/fixed_length_column.h"
+#include "storage/rowset/alp_page.h"
+#include "storage/rowset/bitshuffle_wrapper.h"
+#include "storage/rowset/gorilla_page.h"
+#include "util/faststring.h"
+
+namespace starrocks {
+
+// Decode a page of 64K doubles into a column, the page sizes are reported by the `bytes_per_value` counter.
+static constexpr size_t kNumValues = 64 * 1024;
+
+enum DataSet { DECIMALS = 0, SLOWLY_CHANGING = 1, RANDOM = 2 };
+
+static std::vector<double> gen_values(DataSet data_set) {
+    std::mt19937_64 rng(0);
+    std::vector<double> values(kNumValues);
+    double v = 100;
+    for (size_t i = 0; i < kNumValues; i++) {
+        switch (data_set) {
+        case DECIMALS:
+            // prices with 2 decimal digits
+            values[i] = (rng() % 1000000) / 100.0;
+            break;
+        case SLOWLY_CHANGING:
+            if (rng() % 10 == 0) {
+                v *= 1.0 + (rng() % 100) / 10000.0;
+            }
+            values[i] = v;
+            break;
+        case RANDOM:
+            values[i] = std::uniform_real_distribution<double>(0, 1)(rng);
+            break;
+        }
+    }
+    return values;
+}
+
+static void BM_bitshuffle_lz4(benchmark::State& state) {
+    std::vector<double> values = gen_values(static_cast<DataSet>(state.range(0)));
+    // the number of elements must be a multiple of 8, which holds for kNumValues
+    faststring encoded;
+    encoded.resize(bitshuffle::compress_lz4_bound(kNumValues, sizeof(double), 0));
+    int64_t bytes = bitshuffle::compress_lz4(values.data(), encoded.data(), kNumValues, sizeof(double), 0);
+    CHECK_GT(bytes, 0);
+
+    vectorized::DoubleColumn column;
+    for (auto _ : state) {
+        column.resize(kNumValues);
+        bitshuffle::decompress_lz4(encoded.data(), column.get_data().data(), kNumValues, sizeof(double), 0);
+        benchmark::DoNotOptimize(column.get_data().data());
+        column.reset_column();
+    }
+    state.SetItemsProcessed(state.iterations() * kNumValues);
+    state.counters["bytes_per_value"] = static_cast<double>(bytes) / kNumValues;
+}
+
+template <class PageBuilderType, class PageDecoderType>
+static void bench_page(benchmark::State& state) {
+    std::vector<double> values = gen_values(static_cast<DataSet>(state.range(0)));
+    PageBuilderOptions builder_options;
+    builder_options.data_page_size = kNumValues * sizeof(double);
+    PageBuilderType builder(builder_options);
+    builder.add(reinterpret_cast<const uint8_t*>(values.data()), kNumValues);
+    OwnedSlice page = builder.finish()->build();
+
+    vectorized::DoubleColumn column;
+    for (auto _ : state) {
+        PageDecoderType decoder(page.slice(), PageDecoderOptions());
+        CHECK(decoder.init().ok());
+        size_t n = kNumValues;
+        CHECK(decoder.next_batch(&n, &column).ok());
+        benchmark::DoNotOptimize(column.get_data().data());
+        column.reset_column();
+    }
+    state.SetItemsProcessed(state.iterations() * kNumValues);
+    state.counters["bytes_per_value"] = static_cast<double>(page.slice().size) / kNumValues;
+}
+
+static void BM_alp(benchmark::State& state) {
+    bench_page<AlpPageBuilder<OLAP_FIELD_TYPE_DOUBLE>, AlpPageDecoder<OLAP_FIELD_TYPE_DOUBLE>>(state);
+}
+
+static void BM_gorilla(benchmark::State& state) {
+    bench_page<GorillaPageBuilder<OLAP_FIELD_TYPE_DOUBLE>, GorillaPageDecoder<OLAP_FIELD_TYPE_DOUBLE>>(state);
+}
+
+BENCHMARK(BM_bitshuffle_lz4)->DenseRange(DECIMALS, RANDOM);
+BENCHMARK(BM_alp)->DenseRange(DECIMALS, RANDOM);
+BENCHMARK(BM_gorilla)->DenseRange(DECIMALS, RANDOM);
+
+} // namespace starrocks
+
+BENCHMARK_MAIN();
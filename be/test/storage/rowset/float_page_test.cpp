@@ -0,0 +1,192 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <random>
+
+#include "runtime/mem_pool.h"
+#include "storage/rowset/alp_page.h"
+#include "storage/rowset/gorilla_page.h"
+#include "storage/rowset/options.h"
+#include "storage/vectorized/chunk_helper.h"
+
+namespace starrocks {
+
+class FloatPageTest : public testing::Test {
+public:
+    // compare the bits, so NaN and -0.0 are checked
+    template <typename T>
+    static void assert_same(T expected, T actual, size_t i) {
+        ASSERT_EQ(0, memcmp(&expected, &actual, sizeof(T)))
+                << "Fail at index " << i << " inserted=" << expected << " got=" << actual;
+    }
+
+    template <FieldType Type, class PageBuilderType, class PageDecoderType>
+    void test_encode_decode(const std::vector<typename TypeTraits<Type>::CppType>& src) {
+        typedef typename TypeTraits<Type>::CppType CppType;
+        const size_t size = src.size();
+        PageBuilderOptions builder_options;
+        builder_options.data_page_size = 256 * 1024;
+        PageBuilderType page_builder(builder_options);
+        ASSERT_EQ(size, page_builder.add(reinterpret_cast<const uint8_t*>(src.data()), size));
+        ASSERT_EQ(size, page_builder.count());
+        CppType first;
+        CppType last;
+        ASSERT_TRUE(page_builder.get_first_value(&first).ok());
+        ASSERT_TRUE(page_builder.get_last_value(&last).ok());
+        assert_same(src[0], first, 0);
+        assert_same(src[size - 1], last, size - 1);
+        OwnedSlice s = page_builder.finish()->build();
+        LOG(INFO) << "Encoded size for " << size << " values: " << s.slice().size
+                  << ", original size:" << size * sizeof(CppType);
+
+        PageDecoderOptions decoder_options;
+        PageDecoderType page_decoder(s.slice(), decoder_options);
+        ASSERT_TRUE(page_decoder.init().ok());
+        ASSERT_EQ(0, page_decoder.current_index());
+        ASSERT_EQ(size, page_decoder.count());
+
+        auto column = vectorized::ChunkHelper::column_from_field_type(Type, false);
+        size_t size_to_fetch = size;
+        ASSERT_TRUE(page_decoder.next_batch(&size_to_fetch, column.get()).ok());
+        ASSERT_EQ(size, size_to_fetch);
+        const auto* values = reinterpret_cast<const CppType*>(column->raw_data());
+        for (size_t i = 0; i < size; i++) {
+            assert_same(src[i], values[i], i);
+        }
+
+        // seek within the page, both forward and backward
+        MemPool pool;
+        std::unique_ptr<ColumnVectorBatch> cvb;
+        ColumnVectorBatch::create(1, true, get_type_info(Type), nullptr, &cvb);
+        ColumnBlock block(cvb.get(), &pool);
+        for (int i = 0; i < 100; i++) {
+            size_t seek_off = random() % size;
+            ASSERT_TRUE(page_decoder.seek_to_position_in_page(seek_off).ok());
+            ASSERT_EQ(seek_off, page_decoder.current_index());
+            ColumnBlockView column_block_view(&block);
+            size_t n = 1;
+            ASSERT_TRUE(page_decoder.next_batch(&n, &column_block_view).ok());
+            ASSERT_EQ(1, n);
+            assert_same(src[seek_off], *reinterpret_cast<const CppType*>(block.cell_ptr(0)), seek_off);
+        }
+
+        ASSERT_TRUE(page_decoder.seek_to_position_in_page(0).ok());
+        auto column1 = vectorized::ChunkHelper::column_from_field_type(Type, false);
+        vectorized::SparseRange read_range;
+        read_range.add(vectorized::Range(1, size / 3));
+        read_range.add(vectorized::Range(size / 2, (size * 2 / 3)));
+        read_range.add(vectorized::Range((size * 3 / 4), size));
+        size_t read_num = read_range.span_size();
+        ASSERT_TRUE(page_decoder.next_batch(read_range, column1.get()).ok());
+        ASSERT_EQ(read_num, column1->size());
+
+        values = reinterpret_cast<const CppType*>(column1->raw_data());
+        vectorized::SparseRangeIterator read_iter = read_range.new_iterator();
+        size_t offset = 0;
+        while (read_iter.has_more()) {
+            vectorized::Range r = read_iter.next(read_num);
+            for (size_t i = 0; i < r.span_size(); ++i) {
+                assert_same(src[r.begin() + i], values[offset + i], r.begin() + i);
+            }
+            offset += r.span_size();
+        }
+    }
+
+    template <FieldType Type>
+    void test_all_encodings(const std::vector<typename TypeTraits<Type>::CppType>& src) {
+        test_encode_decode<Type, AlpPageBuilder<Type>, AlpPageDecoder<Type>>(src);
+        test_encode_decode<Type, GorillaPageBuilder<Type>, GorillaPageDecoder<Type>>(src);
+    }
+
+    // return the mode chosen for the page of |src|
+    template <FieldType Type>
+    AlpPageMode alp_page_mode(const std::vector<typename TypeTraits<Type>::CppType>& src) {
+        PageBuilderOptions builder_options;
+        builder_options.data_page_size = 256 * 1024;
+        AlpPageBuilder<Type> page_builder(builder_options);
+        page_builder.add(reinterpret_cast<const uint8_t*>(src.data()), src.size());
+        return static_cast<AlpPageMode>(page_builder.finish()->data()[0]);
+    }
+};
+
+TEST_F(FloatPageTest, TestDoubleDecimals) {
+    std::mt19937_64 rng(0);
+    std::vector<double> values;
+    for (int i = 0; i < 10000; i++) {
+        values.push_back((rng() % 10000000) / 100.0);
+    }
+    test_all_encodings<OLAP_FIELD_TYPE_DOUBLE>(values);
+    ASSERT_EQ(AlpPageMode::ALP, alp_page_mode<OLAP_FIELD_TYPE_DOUBLE>(values));
+}
+
+TEST_F(FloatPageTest, TestDoubleRandom) {
+    std::mt19937_64 rng(0);
+    std::uniform_real_distribution<double> dist(-1e10, 1e10);
+    std::vector<double> values;
+    for (int i = 0; i < 10000; i++) {
+        values.push_back(dist(rng));
+    }
+    test_all_encodings<OLAP_FIELD_TYPE_DOUBLE>(values);
+    ASSERT_NE(AlpPageMode::ALP, alp_page_mode<OLAP_FIELD_TYPE_DOUBLE>(values));
+}
+
+TEST_F(FloatPageTest, TestDoubleSlowlyChanging) {
+    std::vector<double> values;
+    double v = 1.0 / 3;
+    for (int i = 0; i < 10000; i++) {
+        if (i % 20 == 0) {
+            v *= 1.01;
+        }
+        values.push_back(v);
+    }
+    test_all_encodings<OLAP_FIELD_TYPE_DOUBLE>(values);
+    ASSERT_EQ(AlpPageMode::GORILLA, alp_page_mode<OLAP_FIELD_TYPE_DOUBLE>(values));
+}
+
+TEST_F(FloatPageTest, TestDoubleSpecialValues) {
+    std::vector<double> values;
+    for (int i = 0; i < 1000; i++) {
+        switch (i % 10) {
+        case 0:
+            values.push_back(std::numeric_limits<double>::quiet_NaN());
+            break;
+        case 1:
+            values.push_back(-0.0);
+            break;
+        case 2:
+            values.push_back(std::numeric_limits<double>::infinity());
+            break;
+        case 3:
+            values.push_back(-std::numeric_limits<double>::infinity());
+            break;
+        case 4:
+            values.push_back(std::numeric_limits<double>::denorm_min());
+            break;
+        case 5:
+            values.push_back(std::numeric_limits<double>::max());
+            break;
+        default:
+            values.push_back(i * 0.25);
+        }
+    }
+    test_all_encodings<OLAP_FIELD_TYPE_DOUBLE>(values);
+}
+
+TEST_F(FloatPageTest, TestFloat) {
+    std::mt19937 rng(0);
+    std::vector<float> values;
+    for (int i = 0; i < 10000; i++) {
+        values.push_back(i % 7 == 0 ? std::numeric_limits<float>::quiet_NaN() : (rng() % 100000) / 10.0f);
+    }
+    test_all_encodings<OLAP_FIELD_TYPE_FLOAT>(values);
+    ASSERT_EQ(AlpPageMode::ALP, alp_page_mode<OLAP_FIELD_TYPE_FLOAT>(values));
+
+    std::vector<float> same(1000, 3.5f);
+    test_all_encodings<OLAP_FIELD_TYPE_FLOAT>(same);
+}
+
+} // namespace starrocks
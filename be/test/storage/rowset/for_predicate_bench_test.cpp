@@ -0,0 +1,75 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <random>
+
+#include "column/fixed_length_column.h"
+#include "storage/rowset/frame_of_reference_page.h"
+#include "storage/vectorized/column_predicate.h"
+
+namespace starrocks {
+
+// Evaluate `c < x` on a page of 60K INTs uniformly distributed in [0, 1000000), the selectivity in
+// per mille is the argument of the benchmarks. `ColumnPredicate::evaluate` takes up to 65535 rows.
+static constexpr size_t kNumValues = 60 * 1024;
+static constexpr int32_t kMaxValue = 1000000;
+
+static OwnedSlice build_page() {
+    std::mt19937 rng(0);
+    std::vector<int32_t> values(kNumValues);
+    for (auto& v : values) {
+        v = rng() % kMaxValue;
+    }
+    PageBuilderOptions builder_options;
+    builder_options.data_page_size = kNumValues * sizeof(int32_t);
+    FrameOfReferencePageBuilder<OLAP_FIELD_TYPE_INT> builder(builder_options);
+    builder.add(reinterpret_cast<const uint8_t*>(values.data()), kNumValues);
+    return builder.finish()->build();
+}
+
+static std::unique_ptr<vectorized::ColumnPredicate> new_predicate(benchmark::State& state) {
+    std::string operand = std::to_string(kMaxValue / 1000 * state.range(0));
+    return std::unique_ptr<vectorized::ColumnPredicate>(vectorized::new_column_cmp_predicate(
+            vectorized::PredicateType::kLT, get_type_info(OLAP_FIELD_TYPE_INT), 0, operand));
+}
+
+// Decode the page into a column and evaluate the predicate on the column.
+static void BM_decode_evaluate(benchmark::State& state) {
+    OwnedSlice page = build_page();
+    auto pred = new_predicate(state);
+    vectorized::Int32Column column;
+    std::vector<uint8_t> selection(kNumValues);
+    for (auto _ : state) {
+        FrameOfReferencePageDecoder<OLAP_FIELD_TYPE_INT> decoder(page.slice(), PageDecoderOptions());
+        CHECK(decoder.init().ok());
+        size_t n = kNumValues;
+        CHECK(decoder.next_batch(&n, &column).ok());
+        pred->evaluate(&column, selection.data(), 0, kNumValues);
+        benchmark::DoNotOptimize(selection.data());
+        column.reset_column();
+    }
+    state.SetItemsProcessed(state.iterations() * kNumValues);
+}
+
+// Evaluate the predicate on the bit-packed deltas of the page.
+static void BM_encoded_evaluate(benchmark::State& state) {
+    OwnedSlice page = build_page();
+    auto pred = new_predicate(state);
+    std::vector<uint8_t> selection(kNumValues);
+    for (auto _ : state) {
+        FrameOfReferencePageDecoder<OLAP_FIELD_TYPE_INT> decoder(page.slice(), PageDecoderOptions());
+        CHECK(decoder.init().ok());
+        CHECK(decoder.evaluate(*pred, 0, kNumValues, selection.data()).ok());
+        benchmark::DoNotOptimize(selection.data());
+    }
+    state.SetItemsProcessed(state.iterations() * kNumValues);
+}
+
+BENCHMARK(BM_decode_evaluate)->Arg(1)->Arg(10)->Arg(100)->Arg(500);
+BENCHMARK(BM_encoded_evaluate)->Arg(1)->Arg(10)->Arg(100)->Arg(500);
+
+} // namespace starrocks
+
+BENCHMARK_MAIN();
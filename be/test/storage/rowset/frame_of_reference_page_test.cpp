@@ -30,6 +30,7 @@
 #include "storage/rowset/page_builder.h"
 #include "storage/rowset/page_decoder.h"
 #include "storage/vectorized/chunk_helper.h"
+#include "storage/vectorized/column_predicate.h"
 #include "util/logging.h"
 
 using starrocks::PageBuilderOptions;
@@ -158,6 +159,56 @@ public:
             offset += r.span_size();
         }
     }
+
+    // Compare the comparisons evaluated on the encoded page with the ones evaluated on the decoded column.
+    template <FieldType Type>
+    void test_evaluate(typename TypeTraits<Type>::CppType* src, size_t size) {
+        typedef typename TypeTraits<Type>::CppType CppType;
+        PageBuilderOptions builder_options;
+        builder_options.data_page_size = 256 * 1024;
+        FrameOfReferencePageBuilder<Type> for_page_builder(builder_options);
+        size = for_page_builder.add(reinterpret_cast<const uint8_t*>(src), size);
+        OwnedSlice s = for_page_builder.finish()->build();
+
+        FrameOfReferencePageDecoder<Type> for_page_decoder(s.slice(), PageDecoderOptions());
+        ASSERT_TRUE(for_page_decoder.init().ok());
+        auto column = vectorized::ChunkHelper::column_from_field_type(Type, false);
+        size_t n = size;
+        ASSERT_TRUE(for_page_decoder.next_batch(&n, column.get()).ok());
+        ASSERT_TRUE(for_page_decoder.seek_to_position_in_page(7).ok());
+
+        // clang-format off
+        std::vector<vectorized::PredicateType> types = {
+            vectorized::PredicateType::kEQ,
+            vectorized::PredicateType::kNE,
+            vectorized::PredicateType::kGT,
+            vectorized::PredicateType::kGE,
+            vectorized::PredicateType::kLT,
+            vectorized::PredicateType::kLE
+        };
+        // clang-format on
+        std::vector<CppType> operands = {src[0], src[size / 2], src[size - 1], std::numeric_limits<CppType>::lowest(),
+                                         std::numeric_limits<CppType>::max()};
+        std::vector<uint8_t> expected(size);
+        std::vector<uint8_t> actual(size);
+        for (auto type : types) {
+            for (CppType operand : operands) {
+                std::string operand_str = std::to_string(operand);
+                std::unique_ptr<vectorized::ColumnPredicate> pred(
+                        vectorized::new_column_cmp_predicate(type, get_type_info(Type), 0, operand_str));
+                pred->evaluate(column.get(), expected.data(), 0, size);
+                for (size_t from : {size_t(0), size_t(100), size / 3}) {
+                    size_t to = std::min(size, from + size / 2 + 1);
+                    ASSERT_TRUE(for_page_decoder.evaluate(*pred, from, to, actual.data()).ok());
+                    for (size_t i = from; i < to; i++) {
+                        ASSERT_EQ(expected[i], actual[i - from]) << pred->debug_string() << " at " << i;
+                    }
+                }
+            }
+        }
+        // the position is not changed
+        ASSERT_EQ(7, for_page_decoder.current_index());
+    }
 };
 
 TEST_F(FrameOfReferencePageTest, TestInt32BlockEncoderRandom) {
@@ -311,6 +362,28 @@ TEST_F(FrameOfReferencePageTest, TestInt32NormalBlockEncoderSize) {
     ASSERT_EQ(123, s.slice().size);
 }
 
+TEST_F(FrameOfReferencePageTest, TestEvaluate) {
+    const uint32_t size = 10000;
+    std::unique_ptr<int32_t[]> ints(new int32_t[size]);
+    std::unique_ptr<int64_t[]> bigints(new int64_t[size]);
+    std::unique_ptr<int16_t[]> smallints(new int16_t[size]);
+    for (int i = 0; i < size; i++) {
+        // a sequence for the ascending frames, then the random values
+        ints.get()[i] = i < 1000 ? i - 500 : random() % 100000 - 50000;
+        bigints.get()[i] = i % 3 == 0 ? -(int64_t)random() * 1000 : i;
+        smallints.get()[i] = random() % 200;
+    }
+    test_evaluate<OLAP_FIELD_TYPE_INT>(ints.get(), size);
+    test_evaluate<OLAP_FIELD_TYPE_BIGINT>(bigints.get(), size);
+    test_evaluate<OLAP_FIELD_TYPE_SMALLINT>(smallints.get(), size);
+
+    std::unique_ptr<int32_t[]> equals(new int32_t[size]);
+    for (int i = 0; i < size; i++) {
+        equals.get()[i] = 12345;
+    }
+    test_evaluate<OLAP_FIELD_TYPE_INT>(equals.get(), size);
+}
+
 TEST_F(FrameOfReferencePageTest, TestFindBitsOfInt) {
     int8_t bits_3 = 0x06;
     ASSERT_EQ(3, bits(bits_3));
@@ -0,0 +1,97 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "env/env_memory.h"
+#include "runtime/mem_tracker.h"
+#include "storage/fs/file_block_manager.h"
+#include "storage/page_cache.h"
+#include "storage/rowset/bitmap_index_reader.h"
+#include "storage/rowset/inverted_index_writer.h"
+#include "storage/types.h"
+#include "util/text_tokenizer.h"
+
+namespace starrocks {
+
+class InvertedIndexTest : public testing::Test {
+public:
+    const std::string kTestDir = "/inverted_index_test";
+
+protected:
+    void SetUp() override {
+        StoragePageCache::create_global_cache(&_tracker, 1000000000);
+        _env = new EnvMemory();
+        _block_mgr = new fs::FileBlockManager(_env, fs::BlockManagerOptions());
+        ASSERT_TRUE(_env->create_dir(kTestDir).ok());
+    }
+    void TearDown() override {
+        StoragePageCache::release_global_cache();
+        delete _block_mgr;
+        delete _env;
+    }
+
+    void write_index_file(const std::string& filename, const std::vector<Slice>& values, size_t null_count,
+                          ColumnIndexMetaPB* meta) {
+        std::unique_ptr<fs::WritableBlock> wblock;
+        fs::CreateBlockOptions opts({filename});
+        ASSERT_TRUE(_block_mgr->create_block(opts, &wblock).ok());
+
+        std::unique_ptr<InvertedIndexWriter> writer;
+        ASSERT_TRUE(InvertedIndexWriter::create(get_type_info(OLAP_FIELD_TYPE_VARCHAR), &writer).ok());
+        writer->add_nulls(null_count);
+        writer->add_values(values.data(), values.size());
+        ASSERT_TRUE(writer->finish(wblock.get(), meta).ok());
+        ASSERT_EQ(INVERTED_INDEX, meta->type());
+        ASSERT_EQ(STANDARD_TOKENIZER, meta->inverted_index().tokenizer());
+        ASSERT_TRUE(wblock->close().ok());
+    }
+
+    EnvMemory* _env = nullptr;
+    fs::FileBlockManager* _block_mgr = nullptr;
+    MemTracker _tracker;
+};
+
+TEST_F(InvertedIndexTest, test_tokenize) {
+    std::vector<std::string> expected{"get", "index", "html", "http", "1", "1", "中文"};
+    ASSERT_EQ(expected, TextTokenizer::tokenize(Slice("GET /index.html HTTP/1.1 中文")));
+    ASSERT_TRUE(TextTokenizer::tokenize(Slice(" ,./ ")).empty());
+}
+
+TEST_F(InvertedIndexTest, test_postings) {
+    std::vector<Slice> values{Slice("GET /index.html"), Slice("POST /login"), Slice("GET /login")};
+    std::string file_name = kTestDir + "/postings";
+    ColumnIndexMetaPB meta;
+    write_index_file(file_name, values, 1, &meta);
+
+    BitmapIndexReader reader;
+    ASSERT_TRUE(reader.load(_block_mgr, file_name, &meta.inverted_index().postings(), true, false).ok());
+    BitmapIndexIterator* iter = nullptr;
+    ASSERT_TRUE(reader.new_iterator(&iter).ok());
+    std::unique_ptr<BitmapIndexIterator> iter_guard(iter);
+    ASSERT_FALSE(iter->has_null_bitmap());
+    ASSERT_EQ(5, iter->bitmap_nums());
+
+    Slice term("login");
+    bool exact_match = false;
+    ASSERT_TRUE(iter->seek_dictionary(&term, &exact_match).ok());
+    ASSERT_TRUE(exact_match);
+    ASSERT_EQ(3, iter->current_ordinal());
+    Roaring rows;
+    ASSERT_TRUE(iter->read_bitmap(iter->current_ordinal(), &rows).ok());
+    ASSERT_TRUE(Roaring::bitmapOf(2, 2, 3) == rows);
+
+    term = Slice("get");
+    ASSERT_TRUE(iter->seek_dictionary(&term, &exact_match).ok());
+    ASSERT_TRUE(exact_match);
+    ASSERT_TRUE(iter->read_bitmap(iter->current_ordinal(), &rows).ok());
+    ASSERT_TRUE(Roaring::bitmapOf(2, 1, 3) == rows);
+
+    term = Slice("head");
+    ASSERT_TRUE(iter->seek_dictionary(&term, &exact_match).ok());
+    ASSERT_FALSE(exact_match);
+}
+
+} // namespace starrocks
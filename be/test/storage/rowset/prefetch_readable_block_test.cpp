@@ -0,0 +1,88 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021-present, StarRocks Limited.
+
+#include "storage/rowset/prefetch_readable_block.h"
+
+#include <gtest/gtest.h>
+
+#include "env/env_memory.h"
+#include "storage/fs/file_block_manager.h"
+
+namespace starrocks {
+
+class PrefetchReadableBlockTest : public testing::Test {
+protected:
+    void SetUp() override {
+        _env = std::make_unique<EnvMemory>();
+        _block_mgr = std::make_unique<fs::FileBlockManager>(_env.get(), fs::BlockManagerOptions());
+        ASSERT_TRUE(_env->create_dir("/prefetch_readable_block_test").ok());
+
+        std::string fname = "/prefetch_readable_block_test/test.dat";
+        std::unique_ptr<fs::WritableBlock> wblock;
+        fs::CreateBlockOptions opts({fname});
+        ASSERT_TRUE(_block_mgr->create_block(opts, &wblock).ok());
+        _content.resize(100 * 1024);
+        for (size_t i = 0; i < _content.size(); i++) {
+            _content[i] = static_cast<char>(i * 7);
+        }
+        ASSERT_TRUE(wblock->append(Slice(_content)).ok());
+        ASSERT_TRUE(wblock->close().ok());
+        ASSERT_TRUE(_block_mgr->open_block(fname, &_rblock).ok());
+    }
+
+    void check_read(const PrefetchReadableBlock& block, uint64_t offset, size_t size) {
+        std::string buf(size, '\0');
+        ASSERT_TRUE(block.read(offset, Slice(buf)).ok());
+        ASSERT_EQ(_content.substr(offset, size), buf);
+    }
+
+    std::unique_ptr<EnvMemory> _env;
+    std::unique_ptr<fs::FileBlockManager> _block_mgr;
+    std::unique_ptr<fs::ReadableBlock> _rblock;
+    std::string _content;
+};
+
+// NOLINTNEXTLINE
+TEST_F(PrefetchReadableBlockTest, coalesce) {
+    OlapReaderStatistics stats;
+    PrefetchReadableBlock block(_rblock.get(), &stats);
+    // [0, 3000) and [3100, 6000) are merged, [50000, 51000) is left alone.
+    std::vector<PagePointer> pages{{3100, 900}, {0, 1000}, {1000, 2000}, {4000, 2000}, {50000, 1000}};
+    ASSERT_TRUE(block.prefetch(pages, 100, 1024 * 1024).ok());
+    ASSERT_EQ(1, stats.prefetch_io_count);
+    ASSERT_EQ(4, stats.prefetch_pages);
+    ASSERT_EQ(6000, stats.prefetch_bytes);
+
+    check_read(block, 1000, 2000);
+    check_read(block, 4000, 2000);
+    ASSERT_EQ(2, stats.prefetch_hit_pages);
+    ASSERT_EQ(4000, stats.prefetch_hit_bytes);
+
+    // not prefetched
+    check_read(block, 50000, 1000);
+    check_read(block, 5000, 2000);
+    ASSERT_EQ(2, stats.prefetch_hit_pages);
+
+    block.reset();
+    check_read(block, 0, 1000);
+    ASSERT_EQ(2, stats.prefetch_hit_pages);
+}
+
+// NOLINTNEXTLINE
+TEST_F(PrefetchReadableBlockTest, max_bytes) {
+    OlapReaderStatistics stats;
+    PrefetchReadableBlock block(_rblock.get(), &stats);
+    std::vector<PagePointer> pages;
+    for (int i = 0; i < 10; i++) {
+        pages.emplace_back(i * 4096, 4096);
+    }
+    ASSERT_TRUE(block.prefetch(pages, 0, 4 * 4096).ok());
+    ASSERT_EQ(1, stats.prefetch_io_count);
+    ASSERT_EQ(4, stats.prefetch_pages);
+    ASSERT_EQ(4 * 4096, stats.prefetch_bytes);
+
+    check_read(block, 3 * 4096, 4096);
+    check_read(block, 4 * 4096, 4096);
+    ASSERT_EQ(1, stats.prefetch_hit_pages);
+}
+
+} // namespace starrocks
@@ -6,6 +6,7 @@
 #include <string>
 #include <unordered_map>
 
+#include "column/fixed_length_column.h"
 #include "common/object_pool.h"
 #include "env/env_memory.h"
 #include "gtest/gtest.h"
@@ -19,6 +20,8 @@
 #include "storage/tablet_schema_helper.h"
 #include "storage/vectorized/chunk_helper.h"
 #include "storage/vectorized/chunk_iterator.h"
+#include "storage/vectorized/column_predicate.h"
+#include "storage/vectorized/runtime_filter_predicate.h"
 #include "testutil/assert.h"
 #include "util/defer_op.h"
 
@@ -55,6 +58,30 @@ public:
         return res;
     }
 
+    // The key column c0 is [0, num_rows), the value column c1 is c0 * 2.
+    std::shared_ptr<Segment> create_int_segment(const TabletSchema& tablet_schema, const std::string& file_name,
+                                                int32_t num_rows) {
+        SegmentWriterOptions opts;
+        std::unique_ptr<fs::WritableBlock> wblock;
+        fs::CreateBlockOptions wblock_opts({file_name});
+        EXPECT_OK(_block_mgr->create_block(wblock_opts, &wblock));
+        SegmentWriter writer(std::move(wblock), 0, &tablet_schema, opts);
+        EXPECT_OK(writer.init());
+
+        auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema);
+        auto chunk = vectorized::ChunkHelper::new_chunk(schema, num_rows);
+        for (int32_t i = 0; i < num_rows; ++i) {
+            chunk->columns()[0]->append_datum(vectorized::Datum(i));
+            chunk->columns()[1]->append_datum(vectorized::Datum(i * 2));
+        }
+        EXPECT_OK(writer.append_chunk(*chunk));
+        uint64_t file_size = 0;
+        uint64_t index_size = 0;
+        uint64_t footer_position = 0;
+        EXPECT_OK(writer.finalize(&file_size, &index_size, &footer_position));
+        return *Segment::open(_tablet_meta_mem_tracker.get(), _block_mgr, file_name, 0, &tablet_schema);
+    }
+
     const std::string kSegmentDir = "/segment_test";
     EnvMemory* _env = nullptr;
     fs::FileBlockManager* _block_mgr = nullptr;
@@ -319,4 +346,105 @@ TEST_F(SegmentIteratorTest, TestGlobalDictNoLocalDict) {
     res_chunk->reset();
 }
 
+// A runtime filter on the INT column |column_id| which keeps the values in [min, max] divisible by |divisor|.
+// The zone maps are pruned by [min, max], and the divisor is only checked by probing the values.
+class TestRuntimeFilterPredicate final : public vectorized::RuntimeFilterPredicate {
+public:
+    TestRuntimeFilterPredicate(ColumnId column_id, int32_t min, int32_t max, int32_t divisor)
+            : RuntimeFilterPredicate(column_id), _min(min), _max(max), _divisor(divisor) {}
+
+    void set_ready() { _is_ready = true; }
+
+    bool is_ready() const override { return _is_ready; }
+
+    Status get_zone_map_predicates(ObjectPool* pool,
+                                   std::vector<const vectorized::ColumnPredicate*>* preds) const override {
+        auto type_info = get_type_info(OLAP_FIELD_TYPE_INT);
+        std::string min = std::to_string(_min);
+        std::string max = std::to_string(_max);
+        preds->emplace_back(pool->add(vectorized::new_column_ge_predicate(type_info, column_id(), Slice(min))));
+        preds->emplace_back(pool->add(vectorized::new_column_le_predicate(type_info, column_id(), Slice(max))));
+        return Status::OK();
+    }
+
+    void evaluate_and(vectorized::Column* column, uint8_t* selection) const override {
+        const auto& values = down_cast<vectorized::Int32Column*>(column)->get_data();
+        for (size_t i = 0; i < values.size(); i++) {
+            selection[i] &= values[i] >= _min && values[i] <= _max && values[i] % _divisor == 0;
+        }
+    }
+
+private:
+    const int32_t _min;
+    const int32_t _max;
+    const int32_t _divisor;
+    bool _is_ready = false;
+};
+
+// The runtime filter arrives after the first chunk is read, the rows read since then are pruned by both
+// the zone maps and the bloom filter, while the rows already read are kept.
+TEST_F(SegmentIteratorTest, TestLateRuntimeFilter) {
+    const int32_t num_rows = 100000;
+    TabletSchema tablet_schema =
+            create_schema({create_int_key(1, false), create_int_value(2, OLAP_FIELD_AGGREGATION_NONE, false)});
+    auto segment = create_int_segment(tablet_schema, kSegmentDir + "/late_runtime_filter", num_rows);
+    ASSERT_EQ(num_rows, segment->num_rows());
+
+    for (bool arrive : {true, false}) {
+        TestRuntimeFilterPredicate rf(0, 60000, 80000, 3);
+        OlapReaderStatistics stats;
+        vectorized::SegmentReadOptions seg_opts;
+        seg_opts.block_mgr = _block_mgr;
+        seg_opts.stats = &stats;
+        seg_opts.runtime_filter_preds.emplace_back(&rf);
+
+        auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema);
+        auto chunk_iter = new_segment_iterator(segment, schema, seg_opts);
+        vectorized::ColumnIdToGlobalDictMap dict_map;
+        ASSERT_OK(chunk_iter->init_encoded_schema(dict_map));
+        ASSERT_OK(chunk_iter->init_output_schema(std::unordered_set<uint32_t>()));
+
+        auto chunk = vectorized::ChunkHelper::new_chunk(chunk_iter->output_schema(), config::vector_chunk_size);
+        ASSERT_OK(chunk_iter->get_next(chunk.get()));
+        const int32_t num_early_rows = chunk->num_rows();
+        ASSERT_GT(num_early_rows, 0);
+        ASSERT_LT(num_early_rows, 60000);
+        if (arrive) {
+            rf.set_ready();
+        }
+
+        std::vector<int32_t> keys;
+        while (true) {
+            for (size_t i = 0; i < chunk->num_rows(); i++) {
+                int32_t key = chunk->get_column_by_index(0)->get(i).get_int32();
+                ASSERT_EQ(key * 2, chunk->get_column_by_index(1)->get(i).get_int32());
+                keys.emplace_back(key);
+            }
+            chunk->reset();
+            Status status = chunk_iter->get_next(chunk.get());
+            if (status.is_end_of_file()) {
+                break;
+            }
+            ASSERT_OK(status);
+        }
+        chunk_iter->close();
+
+        std::vector<int32_t> expected;
+        for (int32_t i = 0; i < num_rows; i++) {
+            if (!arrive || i < num_early_rows || (i >= 60000 && i <= 80000 && i % 3 == 0)) {
+                expected.emplace_back(i);
+            }
+        }
+        ASSERT_EQ(expected, keys);
+        if (arrive) {
+            // The pages out of [60000, 80000] are pruned by zone map, the others are probed.
+            ASSERT_GT(stats.rows_stats_filtered, 0);
+            ASSERT_GT(stats.rows_runtime_filter_filtered, 0);
+        } else {
+            ASSERT_EQ(0, stats.rows_stats_filtered);
+            ASSERT_EQ(0, stats.rows_runtime_filter_filtered);
+        }
+    }
+}
+
 } // namespace starrocks
@@ -7,6 +7,7 @@
 #include <filesystem>
 
 #include "env/env.h"
+#include "gutil/strings/substitute.h"
 #include "util/defer_op.h"
 
 namespace starrocks {
@@ -84,6 +85,13 @@ public:
         for (uint32_t seg_id = 1; seg_id <= 7; seg_id++) {
             del_vec.emplace(seg_id, DelVector());
         }
+
+        auto& dcgs = _snapshot_meta.delta_column_groups();
+        for (int64_t version : {6, 7}) {
+            auto& dcg = dcgs[2].emplace_back(std::make_shared<DeltaColumnGroup>());
+            dcg->init(version, {1, 2}, strings::Substitute("0200000000000001_0_$0.cols", version));
+        }
+        dcgs[5].emplace_back(std::make_shared<DeltaColumnGroup>())->init(9, {3}, "0200000000000003_0_9.cols");
     }
 
 protected:
@@ -116,6 +124,15 @@ TEST_F(SnapshotMetaTest, test_serialize_and_parse) {
     ASSERT_EQ(_snapshot_meta.rowset_metas()[0].rowset_seg_id(), meta.rowset_metas()[0].rowset_seg_id());
     ASSERT_EQ(_snapshot_meta.rowset_metas()[1].rowset_seg_id(), meta.rowset_metas()[1].rowset_seg_id());
     ASSERT_EQ(_snapshot_meta.rowset_metas()[2].rowset_seg_id(), meta.rowset_metas()[2].rowset_seg_id());
+    ASSERT_EQ(_snapshot_meta.delta_column_groups().size(), meta.delta_column_groups().size());
+    for (const auto& [segment_id, dcgs] : _snapshot_meta.delta_column_groups()) {
+        ASSERT_EQ(1, meta.delta_column_groups().count(segment_id));
+        const auto& parsed_dcgs = meta.delta_column_groups().at(segment_id);
+        ASSERT_EQ(dcgs.size(), parsed_dcgs.size());
+        for (size_t i = 0; i < dcgs.size(); i++) {
+            ASSERT_EQ(dcgs[i]->to_string(), parsed_dcgs[i]->to_string());
+        }
+    }
 }
 
 } // namespace starrocks
@@ -17,6 +17,7 @@
 #include "storage/schema.h"
 #include "storage/vectorized/chunk_helper.h"
 #include "testutil/assert.h"
+#include "util/defer_op.h"
 #include "util/file_utils.h"
 
 namespace starrocks::vectorized {
@@ -310,6 +311,59 @@ TEST_F(MemTableTest, testUniqKeysInsertFlushRead) {
     ASSERT_EQ(n, pkey_read);
 }
 
+TEST_F(MemTableTest, testUniqKeysHashMerge) {
+    const string path = "./ut_dir/MemTableTest_testUniqKeysHashMerge";
+    bool old_enable_hash_aggregation = config::enable_memtable_hash_aggregation;
+    config::enable_memtable_hash_aggregation = true;
+    DeferOp op([=]() { config::enable_memtable_hash_aggregation = old_enable_hash_aggregation; });
+    MySetUp("pk int,name varchar,pv int", "pk int,name varchar,pv int", 1, KeysType::UNIQUE_KEYS, path);
+    const size_t n = 1000;
+    auto pchunk = gen_chunk(*_slots, n);
+    vector<uint32_t> indexes;
+    for (int k = 0; k < 5; k++) {
+        for (int i = 0; i < n; i++) {
+            indexes.emplace_back(i);
+        }
+    }
+    std::random_shuffle(indexes.begin(), indexes.end());
+    // merge the buffered rows on almost every insert
+    int64_t old_write_buffer_size = config::write_buffer_size;
+    config::write_buffer_size = 4096;
+    for (size_t from = 0; from < indexes.size(); from += 100) {
+        _mem_table->insert(*pchunk, indexes.data(), from, 100);
+    }
+    config::write_buffer_size = old_write_buffer_size;
+    ASSERT_TRUE(_mem_table->finalize().ok());
+    ASSERT_OK(_mem_table->flush());
+    RowsetSharedPtr rowset = *_writer->build();
+    unique_ptr<Schema> read_schema = create_schema("pk int", 1);
+    OlapReaderStatistics stats;
+    vectorized::RowsetReadOptions rs_opts;
+    rs_opts.sorted = false;
+    rs_opts.use_page_cache = false;
+    rs_opts.stats = &stats;
+    auto itr = rowset->new_iterator(*read_schema, rs_opts);
+    ASSERT_TRUE(itr.ok()) << itr.status().to_string();
+    std::shared_ptr<vectorized::Chunk> chunk = vectorized::ChunkHelper::new_chunk(*read_schema, 4096);
+    size_t pkey_read = 0;
+    int last_value = 0;
+    while (true) {
+        Status st = (*itr)->get_next(chunk.get());
+        if (st.is_end_of_file()) {
+            break;
+        }
+        auto column = chunk->get_column_by_name("pk");
+        for (size_t i = 0; i < column->size(); i++) {
+            int new_value = column->get(i).get_int32();
+            ASSERT_LT(last_value, new_value);
+            last_value = new_value;
+        }
+        pkey_read += chunk->num_rows();
+        chunk->reset();
+    }
+    ASSERT_EQ(n, pkey_read);
+}
+
 TEST_F(MemTableTest, testPrimaryKeysWithDeletes) {
     const string path = "./ut_dir/MemTableTest_testPrimaryKeysWithDeletes";
     MySetUp("pk bigint,v1 int", "pk bigint,v1 int,__op tinyint", 1, KeysType::PRIMARY_KEYS, path);
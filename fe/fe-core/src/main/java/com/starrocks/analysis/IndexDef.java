@@ -53,9 +53,10 @@ public class IndexDef {
     }
 
     public void analyze() throws AnalysisException {
-        if (indexType == IndexDef.IndexType.BITMAP) {
+        if (indexType == IndexDef.IndexType.BITMAP || indexType == IndexDef.IndexType.NGRAMBF
+                || indexType == IndexDef.IndexType.INVERTED) {
             if (columns == null || columns.size() != 1) {
-                throw new AnalysisException("bitmap index can only apply to a single column.");
+                throw new AnalysisException(indexType + " index can only apply to a single column.");
             }
             if (Strings.isNullOrEmpty(indexName)) {
                 throw new AnalysisException("index name cannot be blank.");
@@ -137,6 +138,17 @@ public class IndexDef {
                         "BITMAP index only used in columns of DUP_KEYS/PRIMARY_KEYS table or key columns of"
                                 + " UNIQUE_KEYS/AGG_KEYS table. invalid column: " + indexColName);
             }
+        } else if (indexType == IndexType.NGRAMBF || indexType == IndexType.INVERTED) {
+            String indexColName = column.getName();
+            PrimitiveType colType = column.getPrimitiveType();
+            if (!colType.isStringType()) {
+                throw new AnalysisException(colType + " is not supported in " + indexType + " index. "
+                        + "invalid column: " + indexColName);
+            } else if ((keysType == KeysType.AGG_KEYS || keysType == KeysType.UNIQUE_KEYS) && !column.isKey()) {
+                throw new AnalysisException(
+                        indexType + " index only used in columns of DUP_KEYS/PRIMARY_KEYS table or key columns of"
+                                + " UNIQUE_KEYS/AGG_KEYS table. invalid column: " + indexColName);
+            }
         } else {
             throw new AnalysisException("Unsupported index type: " + indexType);
         }
@@ -155,6 +167,17 @@ public class IndexDef {
                         "BITMAP index only used in columns of DUP_KEYS/PRIMARY_KEYS table or key columns of"
                                 + " UNIQUE_KEYS/AGG_KEYS table. invalid column: " + indexColName);
             }
+        } else if (indexType == IndexType.NGRAMBF || indexType == IndexType.INVERTED) {
+            String indexColName = column.getName();
+            PrimitiveType colType = column.getPrimitiveType();
+            if (!colType.isStringType()) {
+                throw new SemanticException(colType + " is not supported in " + indexType + " index. "
+                        + "invalid column: " + indexColName);
+            } else if ((keysType == KeysType.AGG_KEYS || keysType == KeysType.UNIQUE_KEYS) && !column.isKey()) {
+                throw new SemanticException(
+                        indexType + " index only used in columns of DUP_KEYS/PRIMARY_KEYS table or key columns of"
+                                + " UNIQUE_KEYS/AGG_KEYS table. invalid column: " + indexColName);
+            }
         } else {
             throw new SemanticException("Unsupported index type: " + indexType);
         }
@@ -162,5 +185,9 @@ public class IndexDef {
 
     public enum IndexType {
         BITMAP,
+        // bloom filter of the n-grams of a string column, used to skip pages for LIKE '%substr%'
+        NGRAMBF,
+        // term dictionary and posting lists of a tokenized string column, used by match_all/match_phrase
+        INVERTED,
     }
 }
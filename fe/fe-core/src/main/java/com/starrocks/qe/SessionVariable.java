@@ -176,6 +176,7 @@ public class SessionVariable implements Serializable, Writable, Cloneable {
     // in the case of insufficient network bandwidth, but excess CPU resources, an algorithm with a
     // higher compression ratio may be chosen to use more CPU and make the overall query time lower.
     public static final String TRANSMISSION_COMPRESSION_TYPE = "transmission_compression_type";
+    public static final String TRANSMISSION_ENCODE_LEVEL = "transmission_encode_level";
 
     public static final String RUNTIME_JOIN_FILTER_PUSH_DOWN_LIMIT = "runtime_join_filter_push_down_limit";
     public static final String ENABLE_GLOBAL_RUNTIME_FILTER = "enable_global_runtime_filter";
@@ -430,6 +431,13 @@ public class SessionVariable implements Serializable, Writable, Cloneable {
     @VariableMgr.VarAttr(name = TRANSMISSION_COMPRESSION_TYPE)
     private String transmissionCompressionType = "LZ4";
 
+    // Encodings of the columns in the exchanged chunks, a bitwise OR of
+    // 1 (integers), 2 (low-cardinality strings) and 4 (null maps), 0 disables them.
+    // The encoded chunks can't be read by the BEs without the encodings, so only enable it after all BEs
+    // are upgraded.
+    @VariableMgr.VarAttr(name = TRANSMISSION_ENCODE_LEVEL)
+    private int transmissionEncodeLevel = 0;
+
     @VariableMgr.VarAttr(name = RUNTIME_JOIN_FILTER_PUSH_DOWN_LIMIT)
     private long runtimeJoinFilterPushDownLimit = 1024000;
 
@@ -903,6 +911,7 @@ public class SessionVariable implements Serializable, Writable, Cloneable {
         if (compressionType != null) {
             tResult.setTransmission_compression_type(compressionType);
         }
+        tResult.setTransmission_encode_level(transmissionEncodeLevel);
 
         tResult.setRuntime_join_filter_pushdown_limit(runtimeJoinFilterPushDownLimit);
         final int global_runtime_filter_wait_timeout = 20;
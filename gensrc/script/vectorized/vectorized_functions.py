@@ -256,6 +256,9 @@ vectorized_functions = [
     [30410, 'parse_url', 'VARCHAR', ['VARCHAR', 'VARCHAR'], 'StringFunctions::parse_url',
      'StringFunctions::parse_url_prepare', 'StringFunctions::parse_url_close'],
 
+    [30420, 'match_all', 'BOOLEAN', ['VARCHAR', 'VARCHAR'], 'StringFunctions::match_all'],
+    [30421, 'match_phrase', 'BOOLEAN', ['VARCHAR', 'VARCHAR'], 'StringFunctions::match_phrase'],
+
     # 50xxx: timestamp functions
     [50009, 'year', 'SMALLINT', ['DATETIME'], 'TimeFunctions::yearV2'],
     [50010, 'year', 'INT', ['DATETIME'], 'TimeFunctions::year'],
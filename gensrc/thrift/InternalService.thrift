@@ -159,6 +159,9 @@ struct TQueryOptions {
   54: optional i32 pipeline_dop;
   // For pipeline query engine
   55: optional TPipelineProfileLevel pipeline_profile_level;
+  // Encodings of the columns in the exchanged chunks, a bitwise OR of
+  // 1 (integers), 2 (low-cardinality strings) and 4 (null maps), 0 disables them.
+  56: optional i32 transmission_encode_level;
 }
 
 